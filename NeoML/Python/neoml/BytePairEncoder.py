@@ -169,16 +169,16 @@ class BytePairEncoder:
 
     @property
     def cache_period(self) -> int:
-        """Returns the cache cleanup period. The cache is used for Encode calls acceleration.
-        The result of the encode call is cached and will be erased if 
-        no call with the same word will occur among next 1-2 X cachePeriod calls.
+        """Returns the cache capacity. The cache is used for Encode calls acceleration.
+        The results for no more than cache_period most recently encoded words are kept,
+        the least recently used word is erased when the cache is full.
         :rtype: int.
         """
         return self._internal.get_cache_period()
 
     @cache_period.setter
     def cache_period(self, period: int) -> None:
-        """Sets the cache cleanup period.
+        """Sets the cache capacity.
         """
         # -1 disables cache, 0 causes assert
         if period < 1:
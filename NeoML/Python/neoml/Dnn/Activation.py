@@ -578,7 +578,7 @@ class GELU(Layer):
     """
 
     def __init__(self, input_layer: tp.Union[Layer, tp.Tuple[Layer, int], PythonWrapper.GELU],
-                 calculation_mode: Literal["precise", "sigmoid_approximate"] = "sigmoid_approximate", 
+                 calculation_mode: Literal["precise", "sigmoid_approximate", "tanh_approximate"] = "sigmoid_approximate", 
                  name: str=None):
 
         if type(input_layer) is PythonWrapper.GELU:
@@ -592,15 +592,16 @@ class GELU(Layer):
         self.calculation_mode = calculation_mode
 
     @property
-    def calculation_mode(self) -> Literal["precise", "sigmoid_approximate"]:
-        """ 'precise' (calculate GELU using the error function) or 'sigmoid_approximate' (using an approximation x * sigmoid(1.702x))
+    def calculation_mode(self) -> Literal["precise", "sigmoid_approximate", "tanh_approximate"]:
+        """ 'precise' (calculate GELU using the error function), 'sigmoid_approximate' (using an approximation x * sigmoid(1.702x))
+        or 'tanh_approximate' (using an approximation x * 0.5(1 + tanh(sqrt(2/pi)(x + 0.044715x^3))))
         """
         return self._internal.get_calculation_mode()
 
     @calculation_mode.setter
-    def calculation_mode(self, value: Literal["precise", "sigmoid_approximate"]):
-        if value not in ["precise", "sigmoid_approximate"]:
-            raise ValueError("GELU. Calculation mode should be 'precise' or 'sigmoid_approximate'.")
+    def calculation_mode(self, value: Literal["precise", "sigmoid_approximate", "tanh_approximate"]):
+        if value not in ["precise", "sigmoid_approximate", "tanh_approximate"]:
+            raise ValueError("GELU. Calculation mode should be 'precise', 'sigmoid_approximate' or 'tanh_approximate'.")
         self._internal.set_calculation_mode(value)
 
 # ----------------------------------------------------------------------------------------------------------------------
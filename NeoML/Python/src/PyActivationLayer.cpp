@@ -192,6 +192,8 @@ public:
 			layer->SetCalculationMode( CGELULayer::CM_Precise );
 		} else if( mode == "sigmoid_approximate" ) {
 			layer->SetCalculationMode( CGELULayer::CM_SigmoidApproximate );
+		} else if( mode == "tanh_approximate" ) {
+			layer->SetCalculationMode( CGELULayer::CM_TanhApproximate );
 		} else {
 			NeoAssert( false );
 		}
@@ -206,6 +208,8 @@ public:
 				return "precise";
 			case CGELULayer::CM_SigmoidApproximate:
 				return "sigmoid_approximate";
+			case CGELULayer::CM_TanhApproximate:
+				return "tanh_approximate";
 			default: 
 				NeoAssert( false );
 				return{};
@@ -563,6 +563,20 @@ public:
 	void DisableLearning();
 	void EnableLearning();
 	bool IsLearningEnabled() const { return isLearningEnabled; }
+	// Sets the type used to store the weights of the fully-connected layers when learning is disabled
+	// CT_Float by default; CT_Float16 and CT_BFloat16 halve the weights memory and traffic during inference
+	// Only the fully-connected layers on CPU support 16-bit weights for now, the other parameters and activations stay float
+	// No float copy is kept, so the weights keep the 16-bit precision after learning is enabled again
+	// The setting is not serialized
+	void SetParamStorageType( TBlobType type );
+	TBlobType GetParamStorageType() const { return paramStorageType; }
+	// Algorithms autotuning (see IMathEngine::SetAutoTuningMode)
+	// Runs the network on the current input blobs in the autotuning mode
+	// so that the fastest algorithms are found for all the layers
+	void WarmUpAutoTuning();
+	// Saves and loads the autotuning results
+	// The results belong to the math engine and are shared by all the networks that use it
+	void SerializeAutoTuningCache( CArchive& archive );
 	// Checks and sets the auto-restart mode for each call to RunOnce/RunAndLearnOnce()
 	bool GetAutoRestartMode() const { return autoRestartMode; }
 	void SetAutoRestartMode(bool mode) { autoRestartMode = mode; }
@@ -649,6 +663,8 @@ private:
 	bool isBackwardPerformed = false;
 	// Indicates that learning is enabled
 	bool isLearningEnabled = true;
+	// The type of the layer parameters when learning is disabled
+	TBlobType paramStorageType = CT_Float;
 	// Indicates that the recurrent mode is on (for a sub-network of a recurrent layer)
 	bool isRecurrentMode = false;
 
@@ -139,6 +139,9 @@ public:
 	CDnnBlob* GetCopy() const;
 	// Copies the contents from another blob
 	void CopyFrom(const CDnnBlob* other);
+	// Copies the contents from another blob of the same dimensions converting the data type
+	// (e.g. float to int or float to 16-bit float)
+	void ConvertFrom( const CDnnBlob* other );
 
 	// Transfers CDnnBlob data from other thread owner to this thread.
 	// By default memory underneath each blob is associated with the thread on which its allocation has occurred.
@@ -449,6 +452,12 @@ inline T* CDnnBlob::GetBuffer( int pos, int size, bool exchange )
 		case CT_Int:
 			dataSize = sizeof( int );
 			break;
+		case CT_Float16:
+			dataSize = sizeof( CFloat16 );
+			break;
+		case CT_BFloat16:
+			dataSize = sizeof( CBFloat16 );
+			break;
 		default:
 			NeoAssert( false );
 	}
@@ -475,6 +484,12 @@ inline void CDnnBlob::SetParentPos(int pos)
 		case CT_Int:
 			data = parent->GetData<int>() + arrayPos;
 			break;
+		case CT_Float16:
+			data = parent->GetData<CFloat16>() + arrayPos;
+			break;
+		case CT_BFloat16:
+			data = parent->GetData<CBFloat16>() + arrayPos;
+			break;
 		default:
 			NeoAssert(0);
 	}
@@ -42,8 +42,18 @@ struct NEOML_API CDnnOptimizationReport final {
 	int MobileNetV3NonResidualBlocks = 0;
 	// Number of optimized MobileNetV3 blocks with residual connection
 	int MobileNetV3ResidualBlocks = 0;
+	// Number of convolutions fused with the following activation and/or residual sum
+	int ConvEpilogueFusions = 0;
+	// Number of fully-connected layers fused with the following activation and/or residual sum
+	int FullyConnectedEpilogueFusions = 0;
+	// Number of convolutions replaced with the sparse ones
+	int SparseConvLayers = 0;
+	// Number of fully-connected layers replaced with the sparse ones
+	int SparseFullyConnectedLayers = 0;
 	// Number of chains of rowwise operations
 	int RowwiseChainCount = 0;
+	// Number of pairs of the direct and the reverse GRU replaced with the bidirectional ones
+	int BidirectionalGruFusions = 0;
 
 	bool IsOptimized() const;
 };
@@ -60,7 +70,12 @@ inline bool CDnnOptimizationReport::IsOptimized() const
 		|| MobileNetV2ResidualBlocks > 0
 		|| MobileNetV3NonResidualBlocks > 0
 		|| MobileNetV3ResidualBlocks > 0
-		|| RowwiseChainCount > 0;
+		|| ConvEpilogueFusions > 0
+		|| FullyConnectedEpilogueFusions > 0
+		|| SparseConvLayers > 0
+		|| SparseFullyConnectedLayers > 0
+		|| RowwiseChainCount > 0
+		|| BidirectionalGruFusions > 0;
 }
 
 // Settings for optional optimizations
@@ -72,6 +87,16 @@ struct NEOML_API CDnnOptimizationSettings final {
 	// (After these optimizations dnn still can be launched via CUDA
 	// but they may lead to increased VRAM consumption)
 	bool AllowCpuOnlyOptimizations = true;
+	// The number of threads used by each chain of rowwise operations (see CRowwiseOperationChainLayer)
+	// 0 or less means the number of available CPU cores
+	int RowwiseThreadCount = 1;
+	// The minimum share of the zero weights for which the layer is replaced with the sparse one
+	// (see CSparseConvLayer and CSparseFullyConnectedLayer)
+	// The value greater than 1 turns this optimization off
+	float MinSparseWeightsSparsity = 0.8f;
+	// The number of threads used by each bidirectional GRU (see CBidirectionalGruLayer)
+	// 1 means the directions are calculated one after another
+	int BidirectionalGruThreadCount = 2;
 };
 
 // Optimizes inference of given CDnn at the cost of trainability
@@ -113,6 +138,32 @@ struct NEOML_API CDnnOptimizationSettings final {
 //             +------------------------------+
 //        with optimized CMobileNetV3BlockLayer
 //        ReLU and HSwish activations are supported (or trivial Linear{mul=1, ft=0}).
+//
+//     5. Epilogue fusion.
+//        Replaces the blocks of layers
+//            -+--> conv or fc -> activation ----> sum ->
+//             |                                    |
+//             +--- residual -----------------------+
+//        (the activation is optional) and the non-residual fc -> activation
+//        with CConvWithEpilogueLayer or CFullyConnectedWithEpilogueLayer
+//        which apply the activation and the residual while the result is still in cache.
+//        The activations supported by IsValidEpilogueActivation are fused.
+//
+//     6. Sparse weights.
+//        Replaces the convolutions and the fully-connected layers (including the ones with epilogue)
+//        whose share of the zero weights is at least MinSparseWeightsSparsity
+//        with CSparseConvLayer or CSparseFullyConnectedLayer which skip the zero weights.
+//        Useful after the pruning (see CDnn::FilterLayersParams).
+//
+//     7. Rowwise chains.
+//        Replaces the sequences of convolutions, poolings, activations, channel-based batch normalizations etc.
+//        with CRowwiseOperationChainLayer which calculates them row by row without allocating the intermediate blobs.
+//        The residual sum with the input of the chain (including the convolution with residual) is added to the chain.
+//        The chains may be calculated in RowwiseThreadCount threads.
+//
+//     8. Bidirectional GRU.
+//        Replaces the pairs of the direct and the reverse CGruLayer connected to the same output
+//        with CBidirectionalGruLayer which calculates the directions concurrently in BidirectionalGruThreadCount threads.
 CDnnOptimizationReport NEOML_API OptimizeDnn( CDnn& dnn,
 	const CDnnOptimizationSettings& settings = CDnnOptimizationSettings() );
 
@@ -391,9 +391,10 @@ public:
 	// Full backward compatibility
 	using TCalculationMode = CParam::TCalculationMode;
 	static const TCalculationMode DefaultCalculationMode = CParam::DefaultCalculationMode;
-	static_assert( static_cast<int>( TCalculationMode::CM_Count ) == 2, "TCalculationMode::CM_Count != 2" );
+	static_assert( static_cast<int>( TCalculationMode::CM_Count ) == 3, "TCalculationMode::CM_Count != 3" );
 	static const TCalculationMode CM_Precise = CParam::TCalculationMode::CM_Precise;
 	static const TCalculationMode CM_SigmoidApproximate = CParam::TCalculationMode::CM_SigmoidApproximate;
+	static const TCalculationMode CM_TanhApproximate = CParam::TCalculationMode::CM_TanhApproximate;
 
 	explicit CGELULayer( IMathEngine& mathEngine );
 
@@ -30,6 +30,7 @@ public:
 
 	// Sets output blob type
 	// CT_Float by default
+	// CT_Float16 and CT_BFloat16 are storage-only types: they may be converted to float but not processed
 	void SetOutputType( TBlobType type );
 	TBlobType GetOutputType() const { return outputType; }
 
@@ -0,0 +1,155 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <NeoML/NeoMLDefs.h>
+#include <NeoML/Dnn/Dnn.h>
+#include <NeoML/Dnn/Layers/ActivationLayers.h>
+
+namespace NeoML {
+
+// Checks if the activation can be used in the epilogue of CConvWithEpilogueLayer and CFullyConnectedWithEpilogueLayer
+// Supported activations: Linear, ELU, ReLU, LeakyReLU, Sigmoid, Tanh, HardTanh, HardSigmoid, HSwish, GELU
+bool NEOML_API IsValidEpilogueActivation( const CActivationDesc& desc );
+
+// This layer computes
+//     conv -> activation
+// or
+//     -+--> conv -> activation ----> sum ->
+//      |                              |
+//      +--- residual -----------------+
+// The epilogue (free term, activation and residual) is applied to the result while it's still in cache
+// The residual is connected to the second input of the layer
+//
+// This layer is faster and consumes less memory than the composite of layers but it has some restrictions:
+//     - this layer is untrainable
+//     - the layer has only one output
+//     - the activation must satisfy IsValidEpilogueActivation
+//     - free term may be nullptr
+class NEOML_API CConvWithEpilogueLayer : public CBaseLayer {
+	NEOML_DNN_LAYER( CConvWithEpilogueLayer )
+public:
+	CConvWithEpilogueLayer( IMathEngine& mathEngine, const CPtr<CDnnBlob>& filter, const CPtr<CDnnBlob>& freeTerm,
+		int paddingHeight, int paddingWidth, int strideHeight, int strideWidth, int dilationHeight, int dilationWidth,
+		const CActivationDesc& activation, bool residual );
+	explicit CConvWithEpilogueLayer( IMathEngine& mathEngine );
+	~CConvWithEpilogueLayer();
+
+	// Convolution parameters
+	CPtr<CDnnBlob> Filter() const;
+	CPtr<CDnnBlob> FreeTerm() const;
+	int PaddingHeight() const { return paddingHeight; }
+	int PaddingWidth() const { return paddingWidth; }
+	int StrideHeight() const { return strideHeight; }
+	int StrideWidth() const { return strideWidth; }
+	int DilationHeight() const { return dilationHeight; }
+	int DilationWidth() const { return dilationWidth; }
+
+	// Activation
+	CActivationDesc Activation() const { return activation; }
+
+	// Residual connection
+	bool Residual() const { return residual; }
+
+	// Serialization
+	void Serialize( CArchive& archive ) override;
+
+protected:
+	// CBaseLayer methods
+	void Reshape() override;
+	void RunOnce() override;
+	void BackwardOnce() override { NeoAssert( false ); }
+	// Specialization for transferParamsBlob
+	bool ContainsNullParamBlob( int i ) const override
+		{ return !paramBlobs[i] && i == P_FreeTerm; }
+
+private:
+	// paramBlobs indices
+	enum TParam {
+		P_Filter,
+		P_FreeTerm,
+
+		P_Count
+	};
+
+	int paddingHeight;
+	int paddingWidth;
+	int strideHeight;
+	int strideWidth;
+	int dilationHeight;
+	int dilationWidth;
+	CActivationDesc activation;
+	bool residual; // Does layer have residual connection?
+	CConvolutionDesc* convDesc = nullptr; // descriptor of convolution
+
+	void destroyConvDesc();
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+
+// This layer computes
+//     fully connected -> activation
+// or
+//     -+--> fully connected -> activation ----> sum ->
+//      |                                         |
+//      +--- residual ----------------------------+
+// The epilogue (free term, activation and residual) is applied to the result while it's still in cache
+// The residual is connected to the second input of the layer
+//
+// The restrictions are the same as in CConvWithEpilogueLayer
+class NEOML_API CFullyConnectedWithEpilogueLayer : public CBaseLayer {
+	NEOML_DNN_LAYER( CFullyConnectedWithEpilogueLayer )
+public:
+	CFullyConnectedWithEpilogueLayer( IMathEngine& mathEngine, const CPtr<CDnnBlob>& weights,
+		const CPtr<CDnnBlob>& freeTerm, const CActivationDesc& activation, bool residual );
+	explicit CFullyConnectedWithEpilogueLayer( IMathEngine& mathEngine );
+
+	// Fully connected parameters
+	CPtr<CDnnBlob> Weights() const;
+	CPtr<CDnnBlob> FreeTerm() const;
+
+	// Activation
+	CActivationDesc Activation() const { return activation; }
+
+	// Residual connection
+	bool Residual() const { return residual; }
+
+	// Serialization
+	void Serialize( CArchive& archive ) override;
+
+protected:
+	// CBaseLayer methods
+	void Reshape() override;
+	void RunOnce() override;
+	void BackwardOnce() override { NeoAssert( false ); }
+	// Specialization for transferParamsBlob
+	bool ContainsNullParamBlob( int i ) const override
+		{ return !paramBlobs[i] && i == P_FreeTerm; }
+
+private:
+	// paramBlobs indices
+	enum TParam {
+		P_Weights,
+		P_FreeTerm,
+
+		P_Count
+	};
+
+	CActivationDesc activation;
+	bool residual; // Does layer have residual connection?
+};
+
+} // namespace NeoML
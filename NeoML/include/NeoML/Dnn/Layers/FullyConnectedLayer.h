@@ -38,6 +38,8 @@ public:
 	//     weightsData.GetObjectCount() is equal to GetNumberOfElements()
 	//     weightsData.GetObjectSize() is equal to inputBlob.GetObjectSize()
 	// If the weights have not been initialized, an empty blob will be returned; pass an empty blob to reset the weights
+	// The returned blob is always float even if the weights are stored in 16-bit format (see CDnn::SetParamStorageType)
+	// In that case it is converted from the 16-bit weights
 	CPtr<CDnnBlob> GetWeightsData() const;
 	void SetWeightsData(const CDnnBlob* newWeights);
 
@@ -56,6 +58,7 @@ public:
 	bool IsZeroFreeTerm() const { return isZeroFreeTerm; }
 	void SetZeroFreeTerm(bool _isZeroFreeTerm);
 
+	// The weights blob may be CT_Float16 or CT_BFloat16 when learning is disabled (see CDnn::SetParamStorageType)
 	CPtr<CDnnBlob>& Weights() { return paramBlobs[0]; }
 	CPtr<CDnnBlob>& FreeTerms() { return paramBlobs[1]; }	// the free term matrix
 	const CPtr<CDnnBlob>& Weights() const { return paramBlobs[0]; }
@@ -79,6 +82,8 @@ protected:
 private:
 	int numberOfElements = 0; // the number of elements (neurons) of the fully-connected layer
 	bool isZeroFreeTerm = false; // indicates if the free term should be set to zero
+
+	void convertWeightsToFloat();
 };
 
 NEOML_API CLayerWrapper<CFullyConnectedLayer> FullyConnected(
@@ -28,6 +28,7 @@ class NEOML_API CGruLayer : public CRecurrentLayer {
 	NEOML_DNN_LAYER( CGruLayer )
 public:
 	explicit CGruLayer( IMathEngine& mathEngine );
+	~CGruLayer();
 
 	void Serialize( CArchive& archive ) override;
 
@@ -38,14 +39,24 @@ public:
 	CPtr<CDnnBlob> GetMainWeightsData() const { return mainLayer->GetWeightsData(); }
 	CPtr<CDnnBlob> GetMainFreeTermData() const { return mainLayer->GetFreeTermData(); }
 
-	void SetMainWeightsData(CDnnBlob* newWeights) { mainLayer->SetWeightsData(newWeights); }
-	void SetMainFreeTermData(CDnnBlob* newFreeTerm) { mainLayer->SetFreeTermData(newFreeTerm); }
+	void SetMainWeightsData(CDnnBlob* newWeights);
+	void SetMainFreeTermData(CDnnBlob* newFreeTerm);
 
 	CPtr<CDnnBlob> GetGateWeightsData() const { return gateLayer->GetWeightsData(); }
 	CPtr<CDnnBlob> GetGateFreeTermData() const { return gateLayer->GetFreeTermData(); }
 
-	void SetGateWeightsData(CDnnBlob* newWeights) { gateLayer->SetWeightsData(newWeights); }
-	void SetGateFreeTermData(CDnnBlob* newFreeTerm) { gateLayer->SetFreeTermData(newFreeTerm); }
+	void SetGateWeightsData(CDnnBlob* newWeights);
+	void SetGateFreeTermData(CDnnBlob* newFreeTerm);
+
+	void RunOnce() override;
+	void Reshape() override;
+	void BackwardOnce() override;
+	void LearnOnce() override;
+
+protected:
+	// The whole sequence calculation on CPU needs the input and the output for backward and learning
+	int BlobsForBackward() const override;
+	int BlobsForLearn() const override;
 
 private:
 	// The indices of the gates in the hidden layer output
@@ -61,9 +72,73 @@ private:
 	CPtr<CSplitChannelsLayer> splitLayer;
 	CPtr<CBackLinkLayer> mainBackLink;
 
+	// The descriptor of the whole sequence calculation used on CPU
+	CGruDesc* gruDesc;
+	// The gates saved by the whole sequence calculation for backward and learning
+	CPtr<CDnnBlob> gates;
+
 	void buildLayer();
+	bool canUseSequenceKernel() const;
+	void initDesc();
+	void freeDesc();
+	void sequenceKernelBackward();
 };
 
 NEOML_API CLayerWrapper<CGruLayer> Gru( int hiddenSize );
 
+//---------------------------------------------------------------------------------------------------------------------
+
+// Two GRUs calculated over the same input in the opposite directions
+// The first output is the result of the direct GRU, the second one is the result of the reverse GRU
+// The directions are independent so they are calculated concurrently
+//
+// This layer is created by OptimizeDnn from the pairs of CGruLayer and has some restrictions:
+//     - this layer is untrainable
+//     - there is no initial state input
+//     - only CPU is supported
+class NEOML_API CBidirectionalGruLayer : public CBaseLayer {
+	NEOML_DNN_LAYER( CBidirectionalGruLayer )
+public:
+	CBidirectionalGruLayer( IMathEngine& mathEngine, const CGruLayer& direct, const CGruLayer& reverse );
+	explicit CBidirectionalGruLayer( IMathEngine& mathEngine );
+	~CBidirectionalGruLayer();
+
+	// The number of threads used for calculation
+	// 2 by default (one thread per direction), 1 means the directions are calculated one after another
+	// More than 2 threads are never used
+	// This setting isn't serialized
+	int GetThreadCount() const { return threadCount; }
+	void SetThreadCount( int newThreadCount );
+
+	void Serialize( CArchive& archive ) override;
+
+protected:
+	void Reshape() override;
+	void RunOnce() override;
+	void BackwardOnce() override { NeoAssert( false ); }
+	// Specialization for transferParamsBlob
+	bool ContainsNullParamBlob( int i ) const override
+		{ return !paramBlobs[i] && ( i % P_Count == P_GateFreeTerm || i % P_Count == P_MainFreeTerm ); }
+
+private:
+	// paramBlobs indices of one direction
+	// the parameters of the direct GRU go first, then the parameters of the reverse one
+	enum TParam {
+		P_GateWeights,
+		P_GateFreeTerm,
+		P_MainWeights,
+		P_MainFreeTerm,
+
+		P_Count
+	};
+
+	// The descriptors of the direct and the reverse GRU
+	CGruDesc* gruDescs[2];
+	// The number of threads and the pool used for calculation (created on first run)
+	int threadCount;
+	CPtrOwner<IThreadPool> threadPool;
+
+	void freeDescs();
+};
+
 } // namespace NeoML
@@ -27,6 +27,9 @@ namespace NeoML {
 
 // The final formula is
 //  f(x) = (x - mean(x)) / sqrt(var(x) + eps) * scale + bias
+//
+// The layer may have the second input (residual) of the same size as the first one
+// In this case the sum of the inputs is normalized: f(x + residual)
 
 class NEOML_API CObjectNormalizationLayer : public CBaseInPlaceLayer {
 	NEOML_DNN_LAYER( CObjectNormalizationLayer )
@@ -85,11 +88,16 @@ private:
 	CPtr<CDnnBlob> normalizedInput;
 	CPtr<CDnnBlob> outputDiffBackup;
 
-	void runOnceImpl( const CFloatHandle& negMean, const CFloatHandle& invSqrtVar, const CFloatHandle& inputNorm );
-	void calcMean( const CFloatHandle& negMean );
-	void calcVar( const CConstFloatHandle& negMean, const CFloatHandle& invSqrtVar );
-	void normalizeInput( const CConstFloatHandle& negMean, const CConstFloatHandle& invSqrtVar, const CFloatHandle& inputNorm );
+	void runLayerNorm( const CFloatHandle& normalized, const CFloatHandle& invStdDev );
+	void runOnceImpl( const CConstFloatHandle& input, const CFloatHandle& negMean, const CFloatHandle& invSqrtVar,
+		const CFloatHandle& inputNorm );
+	void calcMean( const CConstFloatHandle& input, const CFloatHandle& negMean );
+	void calcVar( const CConstFloatHandle& input, const CConstFloatHandle& negMean, const CFloatHandle& invSqrtVar );
+	void normalizeInput( const CConstFloatHandle& input, const CConstFloatHandle& negMean,
+		const CConstFloatHandle& invSqrtVar, const CFloatHandle& inputNorm );
 	void applyScaleAndBias( const CConstFloatHandle& inputNorm );
+	void backwardOnceImpl( const CConstFloatHandle& input, const CConstFloatHandle& invSqrtVar,
+		const CConstFloatHandle& outputDiff, const CConstFloatHandle& scale, const CFloatHandle& inputDiff );
 
 	// The pointer is valid only when the desired parameters are known: either set externally or are filled in on reshape
 	CPtr<CDnnBlob>& Scale() { return paramBlobs[PN_Scale]; }
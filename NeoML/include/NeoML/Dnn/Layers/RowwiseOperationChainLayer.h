@@ -35,6 +35,13 @@ public:
 	// Adds operation to the end of the chain
 	void AddOperation( IRowwiseOperation* newOperation ) { operations.Add( newOperation ); }
 
+	// The number of threads used for calculation (the output rows are split between the threads)
+	// 1 by default, 0 or less means GetAvailableCpuCores()
+	// The chains containing image resize or MobileNetV2 block are always calculated in a single thread
+	// Only CPU supports multithreaded calculation; this setting isn't serialized
+	int GetThreadCount() const { return threadCount; }
+	void SetThreadCount( int newThreadCount );
+
 	void Serialize( CArchive& archive ) override;
 
 protected:
@@ -47,12 +54,18 @@ private:
 	CObjectArray<IRowwiseOperation> operations;
 	// MathEngine descriptors of operations in chain
 	CArray<CRowwiseOperationDesc*> operationDescs;
+	// The number of threads and the pool used for calculation (created on first run)
+	int threadCount;
+	CPtrOwner<IThreadPool> threadPool;
 
 	void deleteRowwiseDescs();
 };
 
 //=====================================================================================================================
 
-void NEOML_API OptimizeRowwiseChains( CDnn& dnn, CArray<int>& chains );
+// Replaces the sequences of rowwise layers with CRowwiseOperationChainLayer
+// Returns the number of operations in each chain
+// threadCount is set as the number of threads of each chain
+void NEOML_API OptimizeRowwiseChains( CDnn& dnn, CArray<int>& chains, int threadCount = 1 );
 
 } // namespace NeoML
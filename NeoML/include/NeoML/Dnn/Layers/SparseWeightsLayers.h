@@ -0,0 +1,147 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <NeoML/NeoMLDefs.h>
+#include <NeoML/Dnn/Dnn.h>
+#include <NeoML/Dnn/Layers/ActivationLayers.h>
+
+namespace NeoML {
+
+// Returns the share of the zero elements in the blob
+float NEOML_API GetBlobSparsity( const CDnnBlob& blob );
+
+// This layer computes the same as CConvWithEpilogueLayer
+// but the filter is stored in the sparse form and only its non-zero elements are used during the calculation
+// It's useful when most of the filter elements are zero (e.g. after CDnn::FilterLayersParams)
+//
+// The dense filter is stored in the paramBlobs and is used for serialization
+// The sparse form is built during the reshape
+//
+// The restrictions are the same as in CConvWithEpilogueLayer
+class NEOML_API CSparseConvLayer : public CBaseLayer {
+	NEOML_DNN_LAYER( CSparseConvLayer )
+public:
+	CSparseConvLayer( IMathEngine& mathEngine, const CPtr<CDnnBlob>& filter, const CPtr<CDnnBlob>& freeTerm,
+		int paddingHeight, int paddingWidth, int strideHeight, int strideWidth, int dilationHeight, int dilationWidth,
+		const CActivationDesc& activation, bool residual );
+	explicit CSparseConvLayer( IMathEngine& mathEngine );
+	~CSparseConvLayer();
+
+	// Convolution parameters
+	CPtr<CDnnBlob> Filter() const;
+	CPtr<CDnnBlob> FreeTerm() const;
+	int PaddingHeight() const { return paddingHeight; }
+	int PaddingWidth() const { return paddingWidth; }
+	int StrideHeight() const { return strideHeight; }
+	int StrideWidth() const { return strideWidth; }
+	int DilationHeight() const { return dilationHeight; }
+	int DilationWidth() const { return dilationWidth; }
+
+	// Activation
+	CActivationDesc Activation() const { return activation; }
+
+	// Residual connection
+	bool Residual() const { return residual; }
+
+	// Serialization
+	void Serialize( CArchive& archive ) override;
+
+protected:
+	// CBaseLayer methods
+	void Reshape() override;
+	void RunOnce() override;
+	void BackwardOnce() override { NeoAssert( false ); }
+	// Specialization for transferParamsBlob
+	bool ContainsNullParamBlob( int i ) const override
+		{ return !paramBlobs[i] && i == P_FreeTerm; }
+
+private:
+	// paramBlobs indices
+	enum TParam {
+		P_Filter,
+		P_FreeTerm,
+
+		P_Count
+	};
+
+	int paddingHeight;
+	int paddingWidth;
+	int strideHeight;
+	int strideWidth;
+	int dilationHeight;
+	int dilationWidth;
+	CActivationDesc activation;
+	bool residual; // Does layer have residual connection?
+	CConvolutionDesc* convDesc = nullptr; // descriptor of convolution
+	CSparseWeightsDesc* filterDesc = nullptr; // the sparse filter
+
+	void destroyDescs();
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+
+// This layer computes the same as CFullyConnectedWithEpilogueLayer
+// but the weights are stored in the sparse form and only their non-zero elements are used during the calculation
+//
+// The restrictions are the same as in CConvWithEpilogueLayer
+class NEOML_API CSparseFullyConnectedLayer : public CBaseLayer {
+	NEOML_DNN_LAYER( CSparseFullyConnectedLayer )
+public:
+	CSparseFullyConnectedLayer( IMathEngine& mathEngine, const CPtr<CDnnBlob>& weights,
+		const CPtr<CDnnBlob>& freeTerm, const CActivationDesc& activation, bool residual );
+	explicit CSparseFullyConnectedLayer( IMathEngine& mathEngine );
+	~CSparseFullyConnectedLayer();
+
+	// Fully connected parameters
+	CPtr<CDnnBlob> Weights() const;
+	CPtr<CDnnBlob> FreeTerm() const;
+
+	// Activation
+	CActivationDesc Activation() const { return activation; }
+
+	// Residual connection
+	bool Residual() const { return residual; }
+
+	// Serialization
+	void Serialize( CArchive& archive ) override;
+
+protected:
+	// CBaseLayer methods
+	void Reshape() override;
+	void RunOnce() override;
+	void BackwardOnce() override { NeoAssert( false ); }
+	// Specialization for transferParamsBlob
+	bool ContainsNullParamBlob( int i ) const override
+		{ return !paramBlobs[i] && i == P_FreeTerm; }
+
+private:
+	// paramBlobs indices
+	enum TParam {
+		P_Weights,
+		P_FreeTerm,
+
+		P_Count
+	};
+
+	CActivationDesc activation;
+	bool residual; // Does layer have residual connection?
+	CSparseWeightsDesc* weightsDesc = nullptr; // the sparse weights
+
+	void destroyWeightsDesc();
+};
+
+} // namespace NeoML
@@ -93,6 +93,9 @@ class CActivationDesc;
 // 
 // ------------------------------------------------------------
 //
+// The sums followed by the normalizations are calculated by the normalization layers
+// (CObjectNormalizationLayer with the residual input) in a single pass
+//
 // Inputs:
 //      1. input data - float blob of size:
 //          - BatchLength, Height, Width and Depth must be equal to 1
@@ -167,10 +170,10 @@ private:
 
 	CPtr<CMultiheadAttentionLayer> selfAttention;
 	CPtr<CDropoutLayer> dropoutSelfAttention;
-	CPtr<CEltwiseSumLayer> selfAttentionSum;
+	CPtr<CBaseLayer> selfAttentionSum; // the residual sum or the normalization fused with it
 	CPtr<CDropoutLayer> dropoutFc1;
 	CPtr<CDropoutLayer> dropoutFc2;
-	CPtr<CEltwiseSumLayer> feedForwardSum;
+	CPtr<CBaseLayer> feedForwardSum; // the residual sum or the normalization fused with it
 
 	bool preNorm = false; // if true place normalization before attention, else as usual
 
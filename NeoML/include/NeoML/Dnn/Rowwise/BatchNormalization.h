@@ -0,0 +1,43 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <NeoML/NeoMLDefs.h>
+#include <NeoML/Dnn/DnnBlob.h>
+#include <NeoML/Dnn/Rowwise/RowwiseOperation.h>
+
+namespace NeoML {
+
+class CBatchNormalizationLayer;
+
+// Channel-based batch normalization in inference mode
+class NEOML_API CRowwiseBatchNormalization : public IRowwiseOperation {
+public:
+	// Creates an equivalent of a channel-based batch normalization layer
+	explicit CRowwiseBatchNormalization( CBatchNormalizationLayer& batchNormLayer );
+	// Constructor for serialization
+	explicit CRowwiseBatchNormalization( IMathEngine& mathEngine );
+
+	// IRowwiseOperation implementation
+	CRowwiseOperationDesc* GetDesc() override;
+	void Serialize( CArchive& archive ) override;
+
+private:
+	IMathEngine& mathEngine; // math engine used for calculations
+	CPtr<CDnnBlob> finalParams; // the final multipliers and free terms of the channels
+};
+
+} // namespace NeoML
@@ -22,11 +22,14 @@ limitations under the License.
 namespace NeoML {
 
 class CConvLayer;
+class CConvWithEpilogueLayer;
 
 class NEOML_API CRowwiseConv : public IRowwiseOperation {
 public:
 	// Creates an equivalent of a block layer
 	explicit CRowwiseConv( const CConvLayer& convLayer );
+	// Creates an equivalent of the convolution part of the layer (without the activation and the residual)
+	explicit CRowwiseConv( const CConvWithEpilogueLayer& convLayer );
 	// Constructor for serialization
 	explicit CRowwiseConv( IMathEngine& mathEngine );
 
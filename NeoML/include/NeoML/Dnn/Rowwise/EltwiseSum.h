@@ -0,0 +1,37 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <NeoML/NeoMLDefs.h>
+#include <NeoML/Dnn/Rowwise/RowwiseOperation.h>
+
+namespace NeoML {
+
+// Adds the input of the chain to the result of the previous operations (residual connection)
+// The chain input is the saved branch of the sum so the operations before it must not change the size of the image
+class NEOML_API CRowwiseEltwiseSum : public IRowwiseOperation {
+public:
+	explicit CRowwiseEltwiseSum( IMathEngine& mathEngine ) : mathEngine( mathEngine ) {}
+
+	// IRowwiseOperation implementation
+	CRowwiseOperationDesc* GetDesc() override;
+	void Serialize( CArchive& archive ) override;
+
+private:
+	IMathEngine& mathEngine; // math engine used for calculations
+};
+
+} // namespace NeoML
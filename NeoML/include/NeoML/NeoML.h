@@ -16,6 +16,7 @@ limitations under the License.
 #pragma once
 
 #include <NeoMathEngine/NeoMathEngine.h>
+#include <NeoML/TraditionalML/CompactSparseFloatMatrix.h>
 #include <NeoML/TraditionalML/DecisionTree.h>
 #include <NeoML/TraditionalML/FeatureSelection.h>
 #include <NeoML/TraditionalML/FloatVector.h>
@@ -80,6 +81,7 @@ limitations under the License.
 #include <NeoML/Dnn/Layers/TransposeLayer.h>
 
 #ifndef NEOML_COMPACT
+#include <NeoML/TraditionalML/Calibration.h>
 #include <NeoML/TraditionalML/ClusterCenter.h>
 #include <NeoML/TraditionalML/Clustering.h>
 #include <NeoML/TraditionalML/CommonCluster.h>
@@ -87,6 +89,7 @@ limitations under the License.
 #include <NeoML/TraditionalML/FirstComeClustering.h>
 #include <NeoML/TraditionalML/GraphGenerator.h>
 #include <NeoML/TraditionalML/HierarchicalClustering.h>
+#include <NeoML/TraditionalML/HnswIndex.h>
 #include <NeoML/TraditionalML/IsoDataClustering.h>
 #include <NeoML/TraditionalML/KMeansClustering.h>
 #include <NeoML/TraditionalML/LdGraph.h>
@@ -116,6 +119,7 @@ limitations under the License.
 #include <NeoML/Dnn/Layers/DepthToSpaceLayer.h>
 #include <NeoML/Dnn/Layers/DotProductLayer.h>
 #include <NeoML/Dnn/Layers/EnumBinarizationLayer.h>
+#include <NeoML/Dnn/Layers/EpilogueLayers.h>
 #include <NeoML/Dnn/Layers/FocalLossLayer.h>
 #include <NeoML/Dnn/Layers/FullyConnectedSourceLayer.h>
 #include <NeoML/Dnn/Layers/GlobalMaxPoolingLayer.h>
@@ -141,6 +145,7 @@ limitations under the License.
 #include <NeoML/Dnn/Layers/ScatterGatherLayers.h>
 #include <NeoML/Dnn/Layers/SequenceSumLayer.h>
 #include <NeoML/Dnn/Layers/SpaceToDepthLayer.h>
+#include <NeoML/Dnn/Layers/SparseWeightsLayers.h>
 #include <NeoML/Dnn/Layers/SubSequenceLayer.h>
 #include <NeoML/Dnn/Layers/TiedEmbeddingsLayer.h>
 #include <NeoML/Dnn/Layers/TransformerLayer.h>
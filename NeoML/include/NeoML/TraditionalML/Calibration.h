@@ -0,0 +1,79 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <NeoML/NeoMLDefs.h>
+#include <NeoML/TraditionalML/PlattScalling.h>
+
+namespace NeoML {
+
+class CDnnBlob;
+
+// The calibration of the binary classifier scores into the probabilities of the positive class
+// The scores, the labels and the weights are given by the contiguous arrays of the same length
+// A label greater than 0 stands for the positive class; if the weights are null, all weights are 1
+// The blob overloads take the float scores and the float or int labels, one value per object
+
+// Calculates the sigmoid coefficients by Platt method (the same as CalcSigmoidCoefficients for IProblem)
+// The sums of the Newton method are accumulated in threadCount threads (the number of cores if not positive)
+void NEOML_API CalcSigmoidCoefficients( const float* scores, const int* labels, const float* weights, int count,
+	CSigmoid& coefficients, int threadCount = 1 );
+void NEOML_API CalcSigmoidCoefficients( const CDnnBlob& scores, const CDnnBlob& labels,
+	CSigmoid& coefficients, int threadCount = 1 );
+
+// Calculates the probabilities for the array of the scores
+void NEOML_API CalcSigmoidProbabilities( const CSigmoid& coefficients, const float* scores, float* probabilities,
+	int count );
+
+// The calibration by isotonic regression
+// The probability is the non-decreasing piecewise linear function of the score
+// which is fit by the pool adjacent violators algorithm
+class NEOML_API CIsotonicCalibration {
+public:
+	void Train( const float* scores, const int* labels, const float* weights, int count );
+	void Train( const CDnnBlob& scores, const CDnnBlob& labels );
+
+	bool IsTrained() const { return !thresholds.IsEmpty(); }
+
+	// Gets the probability of the positive class
+	// The scores out of the training range get the probability of the nearest end of the range
+	double GetProbability( double score ) const;
+	void GetProbabilities( const float* scores, float* probabilities, int count ) const;
+
+	// The points of the piecewise linear function in the ascending order of the scores
+	const CArray<float>& GetThresholds() const { return thresholds; }
+	const CArray<float>& GetValues() const { return values; }
+
+	void Serialize( CArchive& archive );
+
+private:
+	CArray<float> thresholds;
+	CArray<float> values;
+};
+
+inline CArchive& operator << ( CArchive& archive, const CIsotonicCalibration& calibration )
+{
+	const_cast<CIsotonicCalibration&>( calibration ).Serialize( archive );
+	return archive;
+}
+
+inline CArchive& operator >> ( CArchive& archive, CIsotonicCalibration& calibration )
+{
+	calibration.Serialize( archive );
+	return archive;
+}
+
+} // namespace NeoML
@@ -0,0 +1,145 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <NeoML/NeoMLDefs.h>
+#include <NeoML/TraditionalML/SparseFloatMatrix.h>
+#include <NeoML/TraditionalML/SparseFloatVector.h>
+
+namespace NeoML {
+
+// The storage type of the values of the compact sparse matrix
+enum TCompactValueType {
+	CVT_Float = 0, // 32-bit floats, the values are stored exactly
+	CVT_Half, // 16-bit floats, about 3 significant decimal digits
+	CVT_Byte, // 8-bit values quantized linearly between the minimum and the maximum of the row
+
+	CVT_Count
+};
+
+// A sparse matrix which takes less memory than CSparseFloatMatrix
+// The columns are split into the blocks of 65536, every row stores the number of its elements in each used block
+// and the 16-bit column indexes relative to the block; the values are stored in the specified type
+// The rows are decoded on the fly by CRowIterator or into the CSparseFloatVector/CSparseFloatMatrix buffers
+// The matrix can't be changed except for adding rows
+class NEOML_API CCompactSparseFloatMatrix {
+public:
+	// Iterates over the elements of a row in the order of increasing indexes
+	class NEOML_API CRowIterator {
+	public:
+		bool IsValid() const { return position < end; }
+		void Next();
+
+		int GetIndex() const { return blockStart + matrix->columns[position]; }
+		float GetValue() const { return matrix->getValue( row, position ); }
+
+	private:
+		const CCompactSparseFloatMatrix* matrix;
+		int row;
+		int position; // the current element
+		int end; // the end of the row elements
+		int block; // the current block header
+		int blockEnd; // the end of the current block elements
+		int blockStart; // the first column of the current block
+
+		CRowIterator( const CCompactSparseFloatMatrix& matrix, int row );
+		void enterBlock();
+
+		friend class CCompactSparseFloatMatrix;
+	};
+
+	explicit CCompactSparseFloatMatrix( TCompactValueType valueType = CVT_Float );
+	CCompactSparseFloatMatrix( const CFloatMatrixDesc& desc, TCompactValueType valueType );
+
+	TCompactValueType GetValueType() const { return valueType; }
+	int GetHeight() const { return rowPointers.Size() - 1; }
+	int GetWidth() const { return width; }
+	// The number of the stored elements
+	int GetElementCount() const { return columns.Size(); }
+	// The memory taken by the matrix data, in bytes
+	size_t GetDataSize() const;
+
+	// Reserves the buffers for the rows to be added
+	void SetBufferSize( int rowsBufferSize, int elementsBufferSize );
+
+	// Adds a row; zeros of the dense row are skipped
+	void AddRow( const CFloatVectorDesc& row );
+	void AddRow( const CSparseFloatVector& row ) { AddRow( row.GetDesc() ); }
+	// Adds all rows of the matrix; the buffers are grown only once
+	void AddRows( const CFloatMatrixDesc& rows );
+
+	// Iterates over the elements of the row
+	CRowIterator GetRowIterator( int index ) const { return CRowIterator( *this, index ); }
+	// Decodes the row into the vector, the vector buffer is reused
+	void GetRow( int index, CSparseFloatVector& row ) const;
+	// Decodes the rows [firstRow, firstRow + count) into the matrix
+	// Use it to pass the chunks of the matrix to the algorithms which need CFloatMatrixDesc
+	void GetRows( int firstRow, int count, CSparseFloatMatrix& rows ) const;
+
+	void Serialize( CArchive& archive );
+
+private:
+	// The columns in the block
+	static const int BlockSize = 1 << 16;
+
+	TCompactValueType valueType;
+	int width;
+	// The first element of each row and the end of the last row
+	CArray<int> rowPointers;
+	// The first block header of each row and the end of the last row
+	CArray<int> blockPointers;
+	// The block headers: the block number and the end of its elements
+	CArray<int> blockNumbers;
+	CArray<int> blockEnds;
+	// The column indexes relative to the block
+	CArray<uint16_t> columns;
+	// The values in one of the formats
+	CArray<float> floatValues;
+	CArray<uint16_t> halfValues;
+	CArray<uint8_t> byteValues;
+	// The quantization of the CVT_Byte values: value = minimum + code * step
+	CArray<float> rowMinimums;
+	CArray<float> rowSteps;
+
+	float getValue( int row, int position ) const;
+	void reserveElements( int elementCount );
+	void addElements( const CFloatVectorDesc& row );
+};
+
+inline void CCompactSparseFloatMatrix::CRowIterator::Next()
+{
+	position++;
+	if( position == blockEnd && position < end ) {
+		block++;
+		enterBlock();
+	}
+}
+
+inline CArchive& operator << ( CArchive& archive, const CCompactSparseFloatMatrix& matrix )
+{
+	NeoPresume( archive.IsStoring() );
+	const_cast<CCompactSparseFloatMatrix&>( matrix ).Serialize( archive );
+	return archive;
+}
+
+inline CArchive& operator >> ( CArchive& archive, CCompactSparseFloatMatrix& matrix )
+{
+	NeoPresume( archive.IsLoading() );
+	matrix.Serialize( archive );
+	return archive;
+}
+
+} // namespace NeoML
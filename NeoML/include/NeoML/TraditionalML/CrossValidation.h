@@ -30,17 +30,38 @@ struct NEOML_API CCrossValidationResult {
 	CArray<int> ModelIndex; // the index of the model that classified the given vector
 };
 
+// Creates the training models for the parallel cross-validation
+class NEOML_API ITrainingModelFactory {
+public:
+	virtual ~ITrainingModelFactory();
+
+	// Creates a new training model which uses no more than threadCount threads
+	// The caller takes ownership of the returned object
+	virtual ITrainingModel* CreateTrainingModel( int threadCount ) = 0;
+};
+
 // The cross-validation algorithm
 class NEOML_API CCrossValidation {
 public:
 	CCrossValidation( ITrainingModel& trainingModel, const IProblem* problem );
+	// The parts are processed in parallel in threadCount threads (the number of cores if not positive)
+	// Each part is trained by its own training model created by the factory with threadsPerPart threads
+	// The training models only read the shared problem, the subsets don't copy its data
+	CCrossValidation( ITrainingModelFactory& modelFactory, const IProblem* problem,
+		int threadCount, int threadsPerPart = 1 );
 
 	// Performs cross-validation
 	void Execute( int partsCount, TScore score, CCrossValidationResult& results, bool stratified );
 
 private:
-	ITrainingModel& trainingModel; // the base training model
+	ITrainingModel* const trainingModel; // the base training model
+	ITrainingModelFactory* const modelFactory; // the factory of the training models for the parallel mode
 	const CPtr<const IProblem> problem; // the input data
+	const int threadCount; // the number of parts processed in parallel
+	const int threadsPerPart; // the number of threads used by a training model
+
+	void executePart( ITrainingModel& model, int partsCount, int partIndex, TScore score,
+		CCrossValidationResult& results, bool stratified ) const;
 };
 
 } // namespace NeoML
@@ -25,6 +25,7 @@ namespace NeoML {
 
 class CDecisionTreeNodeBase;
 class CDecisionTreeNodeStatisticBase;
+class IThreadPool;
 
 // The node types for a decision tree
 enum TDecisionTreeNodeType {
@@ -138,6 +139,12 @@ public:
 		size_t AvailableMemory; 
 		// The algorithm used for multi-class classification
 		TMulticlassMode MulticlassMode;
+		// The number of processing threads used
+		// The features are processed in parallel while looking for the split of a node
+		// The binary classifiers of MM_OneVsAll and MM_OneVsOne modes are trained in parallel
+		// unless RandomSelectedFeaturesCount is set
+		// The result doesn't depend on the number of threads
+		int ThreadCount;
 
 		CParams() :
 			MinContinuousSubsetSize( 1 ),
@@ -151,9 +158,12 @@ public:
 			ConstNodeThreshold( 0.99 ),
 			RandomSelectedFeaturesCount( NotFound ),
 			AvailableMemory( Gigabyte ),
-			MulticlassMode( MM_SingleClassifier )
+			MulticlassMode( MM_SingleClassifier ),
+			ThreadCount( 1 )
 		{
 		}
+		CParams( const CParams& ) = default;
+		CParams( const CParams& params, int realThreadCount ) : CParams( params ) { ThreadCount = realThreadCount; }
 	};
 
 	// All features will be used
@@ -168,6 +178,7 @@ public:
 
 private:
 	static const int MaxClassifyNodesCacheSize = 10 * Megabyte; // the cache size for leaf nodes
+	IThreadPool* const threadPool; // the executors
 	CParams params; // the classification parameters
 	CRandom defRandom; // the default random numbers generator
 	CRandom& random; // the actual random numbers generator
@@ -27,6 +27,8 @@ namespace NeoML {
 // the specified function value f(X) will be the closest to the reference value.
 // The Evaluate function to calculate f(X) and compare it with the reference
 // is provided by the user.
+// The population may be evaluated in several threads; the function values may be cached
+// and the state of the optimization may be saved into an archive to continue it later.
 
 class NEOML_API CDifferentialEvolution {
 public:
@@ -54,7 +56,29 @@ public:
 	bool BuildNextGeneration();
 
 	// Runs optimization until one of the stop conditions is fulfilled
-	void RunOptimization() { while( !BuildNextGeneration() ); }
+	void RunOptimization();
+
+	// Sets the number of threads evaluating the function (1 by default, the number of cores if not positive)
+	// With more than one thread the Evaluate method for one parameter vector is called from several threads
+	// at the same time, so it must be thread-safe
+	void SetThreadCount( int count ) { threadCount = count; }
+	// Enables the steady-state mode: a trial replaces its target as soon as it is evaluated
+	// and the next trials are built from the updated population, so the threads don't wait
+	// for the slowest evaluation of the generation
+	// A generation is counted each time the number of evaluated trials reaches the population size
+	void SetSteadyState( bool enable ) { isSteadyState = enable; }
+	// Enables the cache of the function values: an already evaluated parameter vector is not evaluated again
+	// Use it only if the function is deterministic
+	void SetCacheEnabled( bool enable ) { isCacheEnabled = enable; }
+	// Gets the number of the function evaluations performed (the cached values are not counted)
+	int GetEvaluationCount() const { return evaluationCount; }
+	// Gets the number of the cached function values
+	int GetCachedValueCount() const { return cachedParams.Size(); }
+
+	// Saves or restores the state of the optimization: the population, the cache and the random generator
+	// The checkpoint can be loaded only into an object with the same function and population size
+	// The parameter traits must implement IParamTraits::Serialize
+	void Serialize( CArchive& archive );
 	
 	// Gets the resulting population
 	const CArray<CFunctionParamVector>& GetPopulation() const { return curPopulation; }
@@ -90,11 +114,28 @@ private:
 	int maxNonGrowingBestValue;	// the maximum number of generations without best value improvement
 
 	mutable CRandom random;
+
+	int threadCount; // the number of threads evaluating the function
+	bool isSteadyState; // the steady-state mode is on
+	bool isCacheEnabled; // the function values are cached
+	int evaluationCount; // the number of the function evaluations
+	int steadyStateTrialCount; // the number of the trials evaluated in the current generation of the steady-state mode
+	// The cache of the function values sorted by the parameter vectors
+	CArray<CFunctionParamVector> cachedParams;
+	CArray<CFunctionParam> cachedValues;
 	
 	CFunctionParamVector initPoint() const;
 
 	void initializeAlgo();
 	bool checkStop();
+	CFunctionParamVector buildTrial( int p );
+	bool selectTrial( int p, const CFunctionParamVector& trial, const CFunctionParam& value );
+	bool runSteadyState( bool untilStop );
+	void evaluate( const CArray<CFunctionParamVector>& params, CArray<CFunctionParam>& results );
+	int compareParams( const CFunctionParamVector& left, const CFunctionParamVector& right ) const;
+	int findCachedValue( const CFunctionParamVector& params, int& insertionPoint ) const;
+	void addCachedValue( const CFunctionParamVector& params, const CFunctionParam& value );
+	void serializeParams( CArchive& archive, CFunctionParamVector& params ) const;
 
 	CFunctionParam mutate( const IParamTraits& traits, const CFunctionParam& p,
 		const CFunctionParam& a, const CFunctionParam& b, const CFunctionParam& c,
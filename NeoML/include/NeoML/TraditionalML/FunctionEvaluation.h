@@ -93,6 +93,9 @@ public:
 	// Dumps the parameter value into a stream
 	virtual void Dump( CTextStream& stream, const CFunctionParam& value ) const = 0;
 
+	// Writes the parameter value into the archive or reads it (for the differential evolution checkpoints)
+	virtual void Serialize( CArchive& archive, CFunctionParam& value ) const;
+
 	// Writing into CTextStream
 	struct CDumper {
 		CTextStream& stream;
@@ -169,6 +172,7 @@ public:
 	virtual bool Less( const CFunctionParam& left, const CFunctionParam& right ) const;
 
 	virtual void Dump( CTextStream& stream, const CFunctionParam& value ) const { stream << Unbox( value ); }
+	virtual void Serialize( CArchive& archive, CFunctionParam& value ) const;
 };
 
 
@@ -201,6 +205,7 @@ public:
 	virtual bool Less( const CFunctionParam& left, const CFunctionParam& right ) const;
 
 	virtual void Dump( CTextStream& stream, const CFunctionParam& value ) const { stream << Unbox( value ); }
+	virtual void Serialize( CArchive& archive, CFunctionParam& value ) const;
 };
 
 //////////////////////////////////////////////////////////////////////////////////
@@ -22,6 +22,8 @@ limitations under the License.
 
 namespace NeoML {
 
+class IThreadPool;
+
 // Hierarchical clustering algorithm
 // Merges the two closest clusters on each step, 
 // until the limit to the clusters number or the distance between them is reached
@@ -45,13 +47,22 @@ public:
 		double MaxClustersDistance; // the maximum distance between two clusters that still may be merged
 		int MinClustersCount; // the minimum number of clusters in the result
 		TLinkage Linkage; // the clustering linkage
+		// The number of threads used for distance calculations
+		// If 0 or less then the number of available CPU cores is used
+		int ThreadCount;
+		// Single linkage only: build the minimum spanning tree without storing the distance matrix
+		// Takes O(N) memory instead of O(N^2), which is required for hundreds of thousands of vectors
+		bool MemoryBounded;
 
 		CParam() : DistanceType( DF_Euclid ), MaxClustersDistance( 1e32 ),
-			MinClustersCount( 1 ), Linkage( L_Centroid ) {}
+			MinClustersCount( 1 ), Linkage( L_Centroid ), ThreadCount( 1 ), MemoryBounded( false ) {}
+		CParam( const CParam& ) = default;
+		CParam( const CParam& params, int realThreadCount ) : CParam( params ) { ThreadCount = realThreadCount; }
 	};
 
 	CHierarchicalClustering( const CArray<CClusterCenter>& clusters, const CParam& params );
 	explicit CHierarchicalClustering( const CParam& clusteringParams );
+	~CHierarchicalClustering() override;
 
 	// Sets a text stream for logging processing
 	// By default logging is off (set to null to turn off)
@@ -89,6 +100,7 @@ public:
 		CArray<CMergeInfo>& dendrogram, CArray<int>& dendrogramIndices );
 
 private:
+	IThreadPool* const threadPool; // executors of the distance calculations
 	const CParam params; // the clustering parameters
 	CTextStream* log; // the logging stream
 	CArray<CClusterCenter> initialClusters; // the initial cluster centers
@@ -0,0 +1,131 @@
+/* Copyright © 2017-2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <NeoML/NeoMLDefs.h>
+#include <NeoML/TraditionalML/FloatVector.h>
+#include <NeoML/TraditionalML/SparseFloatMatrix.h>
+#include <NeoML/TraditionalML/ClusterCenter.h>
+
+namespace NeoML {
+
+// Forward declaration
+class IThreadPool;
+class CDnnBlob;
+
+// The neighbor found by the approximate nearest neighbor search
+struct CNearestNeighbor {
+	// The index of the vector in the data the index was built on
+	int Index;
+	// The distance between the query and the vector
+	float Distance;
+
+	CNearestNeighbor() : Index( NotFound ), Distance( 0.f ) {}
+	CNearestNeighbor( int index, float distance ) : Index( index ), Distance( distance ) {}
+};
+
+// Approximate nearest neighbor index based on the hierarchical navigable small world graph (Malkov, Yashunin, 2016)
+// The vectors are stored inside the index in the dense form
+class NEOML_API CHnswIndex : public IObject {
+public:
+	struct NEOML_API CParam final {
+		// The distance function
+		// DF_Euclid gives the squared Euclidean distance, DF_Cosine gives 1 - cosine similarity
+		TDistanceFunc DistanceFunc = DF_Euclid;
+		// The maximum number of links of a vector on the upper levels of the graph
+		// The bottom level allows twice as many links
+		int MaxLinks = 16;
+		// The number of candidates considered while inserting a vector into the graph
+		int ConstructionListSize = 200;
+		// The default number of candidates considered during the search (can't be less than the number of neighbors)
+		int SearchListSize = 64;
+		// The number of threads used while building the index and processing batches of queries
+		// If it's not positive then the number of cores is used
+		// The graph built with more than one thread depends on the order of the insertions
+		int ThreadCount = 1;
+		// The seed for the random levels of the vectors
+		int Seed = 42;
+
+		CParam() = default;
+		CParam( const CParam& ) = default;
+		CParam( const CParam& params, int realThreadCount ) : CParam( params ) { ThreadCount = realThreadCount; }
+	};
+
+	// Creates an empty index (to be built or serialized)
+	CHnswIndex();
+	explicit CHnswIndex( const CParam& params );
+	~CHnswIndex() override;
+
+	// Builds the index on the rows of the matrix; the previous contents is removed
+	void Build( const CFloatMatrixDesc& data );
+	// Builds the index on the objects of the blob
+	void Build( const CDnnBlob& data );
+
+	// The number of the indexed vectors
+	int GetVectorCount() const { return levels.Size(); }
+	// The length of the indexed vectors
+	int GetFeaturesCount() const { return featuresCount; }
+	const CParam& GetParams() const { return params; }
+
+	// Finds the approximate k nearest neighbors of the query sorted by the distance
+	// The listSize is the number of candidates considered during the search, params.SearchListSize by default
+	void Search( const CFloatVectorDesc& query, int k, CArray<CNearestNeighbor>& result, int listSize = 0 ) const;
+	// Processes the rows of the matrix as a batch of queries in params.ThreadCount threads
+	void Search( const CFloatMatrixDesc& queries, int k, CArray<CArray<CNearestNeighbor>>& results,
+		int listSize = 0 ) const;
+	// Processes the objects of the blob as a batch of queries
+	void Search( const CDnnBlob& queries, int k, CArray<CArray<CNearestNeighbor>>& results, int listSize = 0 ) const;
+
+	void Serialize( CArchive& archive ) override;
+
+private:
+	class CBuilder;
+	struct CSearchBuffers;
+
+	IThreadPool* const threadPool;
+	CParam params;
+	int featuresCount;
+	// The indexed vectors, normalized when the cosine distance is used
+	CArray<float> vectors;
+	// The top level of each vector
+	CArray<int> levels;
+	// Each vector has a block of links for every level from 0 to its top one
+	// A block starts with the number of links followed by the space for the maximum number of links
+	CArray<int> links;
+	// The position of the first block of links of each vector
+	CArray<int> linksOffsets;
+	// The vector on the top level of the graph where the search starts
+	int entryPoint;
+	// The buffers of the finished searches, reused by the next ones to avoid reallocating the visited marks
+	mutable CPointerArray<CSearchBuffers> searchBuffers;
+	mutable CCriticalSection searchBuffersLock;
+
+	const float* getVector( int index ) const { return vectors.GetPtr() + static_cast<size_t>( index ) * featuresCount; }
+	int maxLinks( int level ) const { return level == 0 ? 2 * params.MaxLinks : params.MaxLinks; }
+	const int* getLinks( int index, int level ) const;
+	int* getLinks( int index, int level );
+	float calcDistance( const float* first, const float* second ) const;
+	void initialize( int vectorCount, int featureCount );
+	void addVector( int index, const CFloatVectorDesc& vector );
+	CSearchBuffers* takeSearchBuffers() const;
+	void returnSearchBuffers( CSearchBuffers* buffers ) const;
+	void searchQuery( const float* query, int k, int listSize, CSearchBuffers& buffers,
+		CArray<CNearestNeighbor>& result ) const;
+	void searchLevel( const float* query, int level, int listSize, CSearchBuffers& buffers, CBuilder* builder ) const;
+	int greedySearch( const float* query, int entry, int fromLevel, int toLevel, CBuilder* builder ) const;
+};
+
+} // namespace NeoML
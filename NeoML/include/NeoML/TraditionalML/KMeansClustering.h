@@ -26,6 +26,7 @@ class CCommonCluster;
 template<class T>
 class CVariableMatrix;
 class CDnnBlob;
+class CRandom;
 
 // K-means clustering algorithm
 class NEOML_API CKMeansClustering : public IClustering {
@@ -37,6 +38,10 @@ public:
 		// Elkan argorithm
 		// If used then the distance func must support triangle inequality
 		KMA_Elkan,
+		// Mini-batch algorithm (Sculley, 2010)
+		// Centers are updated after each batch of MiniBatchSize randomly selected vectors
+		// Only dense data and Euclidean distance are supported; the data isn't copied as a whole
+		KMA_MiniBatch,
 
 		KMA_Count
 	};
@@ -47,6 +52,10 @@ public:
 		KMI_Default = 0,
 		// KMeans++ initialization
 		KMI_KMeansPlusPlus,
+		// Scalable KMeans++ initialization (KMeans||, Bahmani et al., 2012)
+		// Oversamples the candidates in a few passes over the data and then reduces them by weighted KMeans++
+		// For sparse data or non-Euclidean distance falls back to KMeans++
+		KMI_KMeansParallel,
 
 		KMI_Count
 	};
@@ -67,7 +76,15 @@ public:
 		// The maximum number of iterations
 		int MaxIterations = 1;
 		// Tolerance criterion for Elkan algorithm
+		// For mini-batch algorithm it's the limit for the squared shift of the centers after one batch
 		double Tolerance = 1e-5f;
+		// The number of vectors in one batch of mini-batch algorithm
+		int MiniBatchSize = 1024;
+		// The number of passes over the data during KMeans|| initialization
+		int KMeansParallelRounds = 5;
+		// The expected number of candidates sampled during one pass of KMeans|| is
+		// KMeansParallelOversampling * InitialClustersCount
+		double KMeansParallelOversampling = 2.;
 		// Number of threads used in KMeans
 		int ThreadCount = 1;
 		// Number of runs of algorithm
@@ -132,6 +149,12 @@ private:
 	void selectInitialClusters( const CDnnBlob& data, int seed, CDnnBlob& centers );
 	void defaultInitialization( const CDnnBlob& data, int seed, CDnnBlob& centers );
 	void kMeansPlusPlusInitialization( const CDnnBlob& data, int seed, CDnnBlob& centers );
+	void kMeansParallelInitialization( const CDnnBlob& data, int seed, CDnnBlob& centers );
+
+	// Specific case for dense data with Euclidean metrics and mini-batch algorithm
+	bool denseMiniBatchL2Clusterize( const IClusteringData* rawData, int seed, CClusteringResult& result, double& inertia );
+	bool miniBatchClusterization( const IClusteringData& rawData, CRandom& random, CDnnBlob& centers );
+	double assignAllClosest( const IClusteringData& rawData, const CDnnBlob& centers, CClusteringResult& result );
 
 	// Lloyd algorithm implementation
 	bool lloydBlobClusterization( const CDnnBlob& data, const CDnnBlob& weight,
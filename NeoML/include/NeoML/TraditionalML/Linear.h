@@ -35,6 +35,18 @@ enum TErrorFunction {
 	EF_Count, // this constant is equal to the number of function types
 };
 
+// The optimization methods of the linear model training
+enum TLinearSolver {
+	LS_TrustRegionNewton, // the trust region Newton method, every iteration processes the whole training set
+	// The stochastic methods update the weights after every vector
+	// They process the training set by chunks of vectors in several threads without locks (Hogwild)
+	LS_Sgd, // the stochastic gradient descent with the step normalized by the squared norm of the vector
+	LS_AdaGrad, // the stochastic gradient descent with the per-feature adaptive learning rates
+	LS_Ftrl, // the FTRL-proximal algorithm, gives sparse weights with the L1 regularization
+
+	LS_Count
+};
+
 DECLARE_NEOML_MODEL_NAME( LinearBinaryModelName, "FmlLinearBinaryModel" )
 
 // Trained classification model interface
@@ -60,6 +72,21 @@ public:
 	virtual CFloatVector GetPlane() const = 0;
 };
 
+// The training set which is read by chunks of vectors, for the data that doesn't fit into memory
+class NEOML_API IProblemChunkSource {
+public:
+	virtual ~IProblemChunkSource();
+
+	// The number of features
+	virtual int GetFeatureCount() const = 0;
+	// Starts reading the training set from the beginning; it's called before every pass over the set
+	virtual void Reset() = 0;
+	// Gets the next chunk of vectors with their answers and weights (null weights mean that all of them are 1)
+	// The answers are the classes (positive or not) for the binary classification and the values for the regression
+	// Returns false if there are no vectors left; the data is valid until the next call
+	virtual bool GetNextChunk( CFloatMatrixDesc& chunk, const float*& answers, const float*& weights ) = 0;
+};
+
 // Linear binary classifier training algorithm
 class NEOML_API CLinear : public ITrainingModel, public IRegressionTrainingModel {
 public:
@@ -74,6 +101,11 @@ public:
 		float L1Coeff; // the L1 regularization coefficient; set to 0 to use the L2 regularization instead
 		int ThreadCount; // the number of processing threads to be used while training the model
 		TMulticlassMode MulticlassMode; // algorithm used for multiclass classification
+		TLinearSolver Solver; // the optimization method
+		// The settings of the stochastic methods
+		double LearningRate; // the initial learning rate (the alpha parameter of FTRL)
+		int EpochCount; // the maximum number of passes over the training set
+		int BatchSize; // the number of consecutive vectors processed by one thread at once
 
 		CParams( TErrorFunction func, double errorWeight = 1, int maxIterations = 1000,
 				const CSigmoid& coefficients = CSigmoid(), double tolerance = -1, 
@@ -87,7 +119,11 @@ public:
 			NormalizeError( normalizeError ),
 			L1Coeff( l1Coeff ),
 			ThreadCount( threadCount ),
-			MulticlassMode( multiclassMode )
+			MulticlassMode( multiclassMode ),
+			Solver( LS_TrustRegionNewton ),
+			LearningRate( 0.1 ),
+			EpochCount( 10 ),
+			BatchSize( 1024 )
 		{
 			NeoPresume( errorWeight > 0 );
 			NeoPresume( threadCount >= 1 );
@@ -107,6 +143,13 @@ public:
 	// Trains IOneVersusAllModel if number of classes > 2
 	CPtr<IModel> Train( const IProblem& trainingClassificationData ) override;
 
+	// Train the models on the training set read by chunks, only the stochastic solvers support it
+	// The chunks are read once to find the feature frequencies and then once on each epoch
+	// The classification is binary; the sigmoid isn't fitted because it would need the whole training set,
+	// so SigmoidCoefficients are used if they're valid, otherwise the logistic function of the distance
+	CPtr<ILinearBinaryModel> TrainByChunks( IProblemChunkSource& data );
+	CPtr<ILinearRegressionModel> TrainRegressionByChunks( IProblemChunkSource& data );
+
 private:
 	const CParams params; // classification parameters
 	CTextStream* log; // logging stream
@@ -51,7 +51,10 @@ public:
 // One versus all classifier training interface
 class NEOML_API COneVersusAll : public ITrainingModel {
 public:
-	explicit COneVersusAll( ITrainingModel& baseBinaryClassifier );
+	// If threadCount isn't equal to 1 the binary classifiers are trained in parallel
+	// (in that case the Train method of baseBinaryClassifier must be safe to call from several threads at once)
+	// If threadCount is not positive the number of cores is used
+	explicit COneVersusAll( ITrainingModel& baseBinaryClassifier, int threadCount = 1 );
 
 	// Sets a text stream for logging processing
 	void SetLog( CTextStream* newLog ) { logStream = newLog; }
@@ -61,6 +64,7 @@ public:
 
 private:
 	ITrainingModel& baseBinaryClassifier; // the basic binary classifier used
+	const int threadCount; // the number of binary classifiers trained in parallel
 	CTextStream* logStream; // the logging stream
 };
 
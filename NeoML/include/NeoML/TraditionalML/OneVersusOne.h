@@ -27,7 +27,10 @@ DECLARE_NEOML_MODEL_NAME( OneVersusOneModelName, "NeoMLOneVersusOneModel" )
 // One versus one classifier training interface
 class NEOML_API COneVersusOne : public ITrainingModel {
 public:
-	explicit COneVersusOne( ITrainingModel& baseBinaryClassifier );
+	// If threadCount isn't equal to 1 the binary classifiers are trained in parallel
+	// (in that case the Train method of baseBinaryClassifier must be safe to call from several threads at once)
+	// If threadCount is not positive the number of cores is used
+	explicit COneVersusOne( ITrainingModel& baseBinaryClassifier, int threadCount = 1 );
 
 	// Sets a text stream for logging
 	void SetLog( CTextStream* newLog ) { log = newLog; }
@@ -37,6 +40,7 @@ public:
 
 private:
 	ITrainingModel& baseClassifier; // the basic binary classifier used
+	const int threadCount; // the number of binary classifiers trained in parallel
 	CTextStream* log; // the logging stream
 };
 
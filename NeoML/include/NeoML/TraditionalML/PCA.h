@@ -60,6 +60,28 @@ void NEOML_API RandomizedSingularValueDecomposition( const CFloatMatrixDesc& dat
 	int iterationCount = 3, int overSamples = 10, int seed = 42,
 	TRandomizedSvdNormalizer normalizer = TRandomizedSvdNormalizer::None );
 
+// The source of the matrix rows which are read by chunks, for the data that doesn't fit into memory
+class NEOML_API IFloatMatrixChunkSource {
+public:
+	virtual ~IFloatMatrixChunkSource();
+
+	// The number of the matrix columns
+	virtual int GetWidth() const = 0;
+	// Gets the next chunk of rows, the chunk may be dense or sparse
+	// Returns false if there are no rows left; the chunk is valid until the next call
+	virtual bool GetNextChunk( CFloatMatrixDesc& chunk ) = 0;
+};
+
+// Computes the `components` largest singular values and the right singular vectors of the matrix
+// reading its rows from `data` only once. `rightVectors` is of shape `components` x width.
+// The sketch of width x (`components` + `overSamples`) size is accumulated over the chunks,
+// so the memory used doesn't depend on the number of rows.
+// The left vectors aren't returned because they require the second pass: `leftVectors` = `data` * T(`rightVectors`) / `singularValues`.
+// The calculations are performed by the `mathEngine`.
+void NEOML_API RandomizedSingularValueDecomposition( IFloatMatrixChunkSource& data, IMathEngine& mathEngine,
+	CArray<float>& singularValues, CArray<float>& rightVectors, int components,
+	int overSamples = 10, int seed = 42 );
+
 // PCA algorithm implementing linear dimensionality reduction
 // using Singular Value Decomposition to project the data into
 // a lower dimensional space
@@ -142,4 +164,90 @@ private:
 	void getComponentsNum( const CArray<float>& explainedVarianceRatio, int k );
 };
 
+// Incremental PCA which updates the principal components by chunks of rows,
+// for the data that doesn't fit into memory
+// The components are found from the randomized sketch of the covariance matrix of the width x (Components + OverSamples) size,
+// so the memory used doesn't depend on the number of rows, and the sparse chunks are processed without conversion to dense
+class NEOML_API CIncrementalPca : public IObject {
+public:
+	// Incremental PCA params
+	struct CParams {
+		// The number of principal components
+		int Components;
+		// Additional number of the sketch columns to ensure proper conditioning
+		int OverSamples;
+		// The seed of the random sketch
+		int Seed;
+
+		CParams() :
+			Components( 1 ),
+			OverSamples( 10 ),
+			Seed( 42 )
+		{
+		}
+	};
+
+	// All calculations are performed by the mathEngine; it should be alive while the object is used
+	CIncrementalPca( const CParams& params, IMathEngine& mathEngine );
+	~CIncrementalPca() override;
+
+	// Updates the components by the next chunk of rows
+	// All the chunks should have the same width
+	// The components themselves are calculated when they're requested for the first time after the update
+	void PartialFit( const CFloatMatrixDesc& chunk );
+	// Updates the components by all the chunks of the source
+	void Fit( IFloatMatrixChunkSource& data );
+	// Transforms the data into shape ( samples x components )
+	// using the principal components calculated before
+	CSparseFloatMatrixDesc Transform( const CFloatMatrixDesc& data );
+
+	// The number of the processed rows
+	int GetVectorCount() const { return vectorCount; }
+	// Singular values corresponding to the principal axes
+	const CArray<float>& GetSingularValues() const { checkComponents(); return singularValues; }
+	// Variance explained by each of the principal axes
+	const CArray<float>& GetExplainedVariance() const { checkComponents(); return explainedVariance; }
+	// Percentage of variance explained by each of the principal axis
+	const CArray<float>& GetExplainedVarianceRatio() const { checkComponents(); return explainedVarianceRatio; }
+	// The mean variance not explained by the principal axes
+	float GetNoiseVariance() const { checkComponents(); return noiseVariance; }
+	// The number of principal axes
+	int GetComponentsNum() const { checkComponents(); return singularValues.Size(); }
+	// Matrix ( components x features ) with rows corresponding to the principal axes
+	CSparseFloatMatrix GetComponents();
+	// The mean of the processed rows
+	const CArray<float>& GetMean() const { checkComponents(); return mean; }
+
+	const CParams& GetParams() const { return params; }
+	// Serializes the state of the algorithm, so the training may be continued after loading
+	void Serialize( CArchive& archive ) override;
+
+private:
+	class CSketch;
+
+	CParams params;
+	IMathEngine& mathEngine;
+	CPtrOwner<CSketch> sketch;
+	int vectorCount;
+	// The point from which the rows are measured in the sketch (the mean of the first chunk)
+	CArray<float> origin;
+	// The sums and the squared sums of the features
+	CArray<double> sums;
+	CArray<double> squaredSums;
+
+	// The results below are calculated from the sketch on demand, they're out of date while this flag is set
+	mutable bool isComponentsDirty;
+	mutable CArray<float> mean;
+	mutable CArray<float> singularValues;
+	mutable CArray<float> explainedVariance;
+	mutable CArray<float> explainedVarianceRatio;
+	mutable CArray<float> componentsMatrix;
+	mutable float noiseVariance;
+	CSparseFloatMatrix transformedMatrix;
+
+	void initialize( const CFloatMatrixDesc& chunk );
+	void checkComponents() const { if( isComponentsDirty ) { updateComponents(); } }
+	void updateComponents() const;
+};
+
 } // namespace NeoML
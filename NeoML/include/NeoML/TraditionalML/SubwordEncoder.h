@@ -20,6 +20,9 @@ limitations under the License.
 
 namespace NeoML {
 
+// Forward declaration
+class IThreadPool;
+
 // An encoder tokenizes input sequence with parts of words ('subwords') as tokens.
 class NEOML_API ISubwordEncoder : virtual public IObject {
 public:
@@ -72,39 +75,63 @@ public:
 };
 
 // Subword encoder which supports caching results of 'Encode' calls.
+// The encoder may be shared between several threads: the cache is thread-safe.
 class NEOML_API ISubwordEncoderWithCache : public ISubwordEncoder {
 public:
+	// The statistics of the cache usage
+	struct CCacheStatistics {
+		// The number of the words found in the cache
+		int64_t Hits = 0;
+		// The number of the words encoded from scratch
+		int64_t Misses = 0;
+		// The current number of the words in the cache
+		int Size = 0;
+	};
+
 	void Encode( const CString& word, CArray<int>& tokenIds,
 		CArray<int>& tokenLengths ) const override final;
 
-	// Cache cleanup period
-	// The cache is used for Encode calls acceleration.
-	// The result of the encode call is cached and will be erased if 
-	// no call with the same word will occur among next 1-2 X cachePeriod calls.
+	// Encodes the words in threadCount threads (the number of cores if not positive).
+	// The results for each word are the same as the ones returned by Encode.
+	// The small batches are encoded in the calling thread.
+	void EncodeBatch( const CArray<CString>& words, CArray<CArray<int>>& tokenIds,
+		CArray<CArray<int>>& tokenLengths, int threadCount ) const;
+	// Encodes the words in the threads of the given pool, which may be reused between the calls.
+	void EncodeBatch( const CArray<CString>& words, CArray<CArray<int>>& tokenIds,
+		CArray<CArray<int>>& tokenLengths, IThreadPool& threadPool ) const;
+
+	// The cache capacity
+	// The cache keeps the results for no more than cachePeriod most recently requested words,
+	// the least recently used word is evicted when the cache is full.
 	int GetCachePeriod() const { return cache.GetCachePeriod(); }
 
-	// Sets the cache cleanup period.
+	// Sets the cache capacity.
 	// Increase in cachePeriod leads to a in increase in memory consumption.
 	// To completely switch the cache off set cachePeriod equal to -1.
 	// Value 0 is treated as invalid.
 	void SetCachePeriod( int cachePeriod ) const { cache.SetCachePeriod( cachePeriod ); }
 
-	// Clears cache.
+	// Clears cache and its statistics.
 	void ClearCache() const { cache.Clear(); }
 
+	// Gets the statistics of the cache usage since the last ClearCache call.
+	CCacheStatistics GetCacheStatistics() const { return cache.GetStatistics(); }
+
 protected:
 	// 'Internal' Encode with the same meaning.
+	// May be called from several threads at once.
 	virtual void DoEncode( const CString& word, CArray<int>& tokenIds,
 		CArray<int>& tokenLengths ) const = 0;
 
 private:
 	// Internal cache for encoding requests.
+	// The words are distributed between the shards by their hash, each shard has its own lock and LRU list.
 	class CCache {
 	public:
-		CCache() : cacheTime( 0 ), cachePeriod( 50000 ) {}
-		// Cache cleanup period
+		CCache();
+		// Cache capacity
 		int GetCachePeriod() const { return cachePeriod; }
-		// Sets the cache cleanup period
+		// Sets the cache capacity
 		void SetCachePeriod( int newPeriod );
 		// Requests data from cache.
 		bool Request( const CString& word, CArray<int>& tokenIds,
@@ -113,26 +140,52 @@ private:
 		void Add( const CString& word, const CArray<int>& tokenIds,
 			const CArray<int>& tokenLengths );
 		// Clears cache.
-		void Clear() { cacheTime = 0; wordCache.DeleteAll(); }
+		void Clear();
+		// Gets the statistics
+		CCacheStatistics GetStatistics() const;
 
 	private:
-		// Data stored in cache: token ids and their unicode lengths and the latest request time.
+		static constexpr int ShardCount = 16;
+
+		// Data stored in cache: token ids and their unicode lengths and the neighbors in the LRU list.
 		struct CCachedData {
+			CString Word;
 			CFastArray<int, 4> TokenIds;
 			CFastArray<int, 4> TokenLengths;
-			long long Time;
+			// The more recently used entry
+			int Prev;
+			// The less recently used entry
+			int Next;
 
-			CCachedData() : Time( 0 ) {}
+			CCachedData() : Prev( NotFound ), Next( NotFound ) {}
 			CCachedData( const CCachedData& other );
 			CCachedData( CCachedData&& other );
 		};
 
-		// Current cache state.
-		CMap<CString, CCachedData> wordCache;
-		// Current cache time.
-		long long cacheTime;
-		// Cache cleanup period.
-		int cachePeriod;
+		struct CShard {
+			CCriticalSection Section;
+			// Word -> index in Entries
+			CMap<CString, int> WordToEntry;
+			CArray<CCachedData> Entries;
+			// The most recently used entry
+			int First = NotFound;
+			// The least recently used entry
+			int Last = NotFound;
+
+			void MoveToFront( int entry );
+			void Unlink( int entry );
+			void Trim( int capacity );
+			void Clear();
+		};
+
+		CShard shards[ShardCount];
+		// Cache capacity.
+		std::atomic<int> cachePeriod;
+		std::atomic<int64_t> hits;
+		std::atomic<int64_t> misses;
+
+		CShard& getShard( const CString& word );
+		int shardCapacity() const;
 	};
 
 	// Cache for Encode calls.
@@ -58,6 +58,9 @@ public:
 	void SetMandatoryChars( const CArray<CString>& );
 	// 0 by default. All other tokens will have contiguous numbers from ( UnknownTokenId + 1 )
 	void SetUnknownTokenId( int value );
+	// The number of threads used for training, 1 by default. If it is not positive the number of cores is used.
+	// Unigram training processes the dictionary in parallel; the result is deterministic for the given number of threads.
+	void SetThreadCount( int value ) { threadCount = value; }
 
 	// Trains and returns a fully trained encoder.
 	// It is advisable to prune low-frequency words by calling frequencyDict.Finalize( minCount ) before training.
@@ -74,6 +77,7 @@ private:
 	TVocabPruning vocabPruning;
 	double coverage = 1.;
 	int encoderUnkTokenId = 0;
+	int threadCount = 1;
 
 	CArray<CString> mandatoryTokens;
 
@@ -41,6 +41,11 @@ public:
 
 	// Gets the free term
 	virtual double GetFreeTerm() const = 0;
+
+	// Classifies all rows of the matrix at once
+	// The kernel values against the support vectors are calculated by blocks as a matrix product
+	// The default implementation calls Classify for every row
+	virtual void ClassifyBatch( const CFloatMatrixDesc& data, CArray<CClassificationResult>& results ) const;
 };
 
 // Forward declaration
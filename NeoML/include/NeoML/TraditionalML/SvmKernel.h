@@ -44,6 +44,9 @@ public:
 	// Calculates the kernel value on given vectors
 	double Calculate( const CFloatVectorDesc& x1, const CFloatVectorDesc& x2 ) const;
 	double Calculate( const CFloatVector& x1, const CFloatVectorDesc& x2 ) const { return Calculate( x1.GetDesc(), x2 ); }
+	// Calculates the kernel value from the dot product of the vectors and their squared norms
+	// Every kernel is a function of these values, which allows computing the dot products for many vectors at once
+	double CalculateByDotProduct( double dotProduct, double squaredNorm1, double squaredNorm2 ) const;
 
 	friend CArchive& operator << ( CArchive& archive, const CSvmKernel& center );
 	friend CArchive& operator >> ( CArchive& archive, CSvmKernel& center );
@@ -73,6 +73,7 @@ limitations under the License.
 #include <NeoML/Dnn/Layers/DepthToSpaceLayer.h>
 #include <NeoML/Dnn/Layers/DotProductLayer.h>
 #include <NeoML/Dnn/Layers/EnumBinarizationLayer.h>
+#include <NeoML/Dnn/Layers/EpilogueLayers.h>
 #include <NeoML/Dnn/Layers/FocalLossLayer.h>
 #include <NeoML/Dnn/Layers/FullyConnectedSourceLayer.h>
 #include <NeoML/Dnn/Layers/GlobalMaxPoolingLayer.h>
@@ -99,6 +100,7 @@ limitations under the License.
 #include <NeoML/Dnn/Layers/ScatterGatherLayers.h>
 #include <NeoML/Dnn/Layers/SequenceSumLayer.h>
 #include <NeoML/Dnn/Layers/SpaceToDepthLayer.h>
+#include <NeoML/Dnn/Layers/SparseWeightsLayers.h>
 #include <NeoML/Dnn/Layers/SubSequenceLayer.h>
 #include <NeoML/Dnn/Layers/TiedEmbeddingsLayer.h>
 #include <NeoML/Dnn/Layers/TransformerLayer.h>
@@ -343,6 +345,7 @@ REGISTER_NEOML_LAYER( CChannelwiseWith1x1Layer, "NeoMLDnnChannelwiseWith1x1Layer
 REGISTER_NEOML_LAYER( CCompositeSinkLayer, "FmlCompositeCnnSinkLayer" )
 REGISTER_NEOML_LAYER( CCompositeSourceLayer, "FmlCnnCompositeSourceLayer" )
 REGISTER_NEOML_LAYER( CConfusionMatrixLayer, "FmlCnnConfusionMatrixLayer" )
+REGISTER_NEOML_LAYER( CConvWithEpilogueLayer, "NeoMLDnnConvWithEpilogueLayer" )
 REGISTER_NEOML_LAYER( CCrfCalculationLayer, "FmlCnnCrfCalculationLayer" )
 REGISTER_NEOML_LAYER( CCrfInternalLossLayer, "FmlCnnCrfInternalLossLayer" )
 REGISTER_NEOML_LAYER( CCrfLayer, "FmlCnnCrfLayer" )
@@ -358,6 +361,7 @@ REGISTER_NEOML_LAYER( CImageResizeLayer, "FmlCnnImageResizeLayer" )
 REGISTER_NEOML_LAYER( CImageToPixelLayer, "FmlCnnImageToPixelLayerClass" )
 REGISTER_NEOML_LAYER( CFocalLossLayer, "FmlCnnFocalLossLayer" )
 REGISTER_NEOML_LAYER( CFullyConnectedSourceLayer, "FmlCnnFullyConnectedSourceLayer" )
+REGISTER_NEOML_LAYER( CFullyConnectedWithEpilogueLayer, "NeoMLDnnFullyConnectedWithEpilogueLayer" )
 REGISTER_NEOML_LAYER( CLoraFullyConnectedLayer, "NeoMLDnnLoraFullyConnectedLayer" )
 REGISTER_NEOML_LAYER( CMaxOverTimePoolingLayer, "FmlCnnMaxOverTimePoolingLayer" )
 REGISTER_NEOML_LAYER( CMobileNetV3PreSEBlockLayer, "NeoMLDnnMobileNetV3PreSEBlockLayer" )
@@ -378,6 +382,7 @@ REGISTER_NEOML_LAYER( CUpsampling2DLayer, "FmlCnnUpsampling2DLayer" )
 
 // {{ DNN
 REGISTER_NEOML_LAYER( CBertConvLayer, "NeoMLDnnBertConvLayer" )
+REGISTER_NEOML_LAYER( CBidirectionalGruLayer, "NeoMLDnnBidirectionalGruLayer" )
 REGISTER_NEOML_LAYER( CCumSumLayer, "NeoMLDnnCumSumLayer" )
 REGISTER_NEOML_LAYER( CDepthToSpaceLayer, "NeoMLDnnDepthToSpaceLayer" )
 REGISTER_NEOML_LAYER( CEqualLayer, "NeoMLDnnEqualLayer" )
@@ -391,6 +396,8 @@ REGISTER_NEOML_LAYER( CPositionalEmbeddingLayer, "NeoMLDnnPositionalEmbeddingLay
 REGISTER_NEOML_LAYER( CRowwiseOperationChainLayer, "NeoMLDnnRowwiseOperationChainLayer" )
 REGISTER_NEOML_LAYER( CScatterNDLayer, "NeoMLDnnScatterNDLayer" )
 REGISTER_NEOML_LAYER( CSpaceToDepthLayer, "NeoMLDnnSpaceToDepthLayer" )
+REGISTER_NEOML_LAYER( CSparseConvLayer, "NeoMLDnnSparseConvLayer" )
+REGISTER_NEOML_LAYER( CSparseFullyConnectedLayer, "NeoMLDnnSparseFullyConnectedLayer" )
 REGISTER_NEOML_LAYER( CTransformerEncoderLayer, "NeoMLDnnTransformerEncoderLayer" )
 REGISTER_NEOML_LAYER( CTransformerSourceMaskLayer, "NeoMLDnnTransformerSourceMaskLayer" )
 REGISTER_NEOML_LAYER( CWhereLayer, "NeoMLDnnWhereLayer" )
@@ -566,6 +573,44 @@ void CDnn::EnableLearning()
 	RequestReshape( /*forcedReshape*/true );
 }
 
+void CDnn::SetParamStorageType( TBlobType type )
+{
+	NeoAssert( type == CT_Float || type == CT_Float16 || type == CT_BFloat16 );
+	if( paramStorageType == type ) {
+		return;
+	}
+	paramStorageType = type;
+	RequestReshape( /*forcedReshape*/true );
+}
+
+void CDnn::WarmUpAutoTuning()
+{
+	const bool wasAutoTuningMode = mathEngine.GetAutoTuningMode();
+	mathEngine.SetAutoTuningMode( true );
+	RunOnce();
+	mathEngine.SetAutoTuningMode( wasAutoTuningMode );
+}
+
+static const int AutoTuningCacheVersion = 0;
+
+void CDnn::SerializeAutoTuningCache( CArchive& archive )
+{
+	archive.SerializeVersion( AutoTuningCacheVersion );
+	CArray<char> buffer;
+	if( archive.IsStoring() ) {
+		// The cache may grow in the other threads
+		size_t size = mathEngine.SaveAutoTuningCache( nullptr, 0 );
+		do {
+			buffer.SetSize( static_cast<int>( size ) );
+			size = mathEngine.SaveAutoTuningCache( buffer.GetPtr(), buffer.Size() );
+		} while( size > static_cast<size_t>( buffer.Size() ) );
+	}
+	buffer.Serialize( archive );
+	if( archive.IsLoading() && buffer.Size() > 0 ) {
+		mathEngine.LoadAutoTuningCache( buffer.GetPtr(), buffer.Size() );
+	}
+}
+
 void CDnn::RequestReshape( bool forcedReshape )
 {
 	for( int i = 0; i < layers.Size(); i++ ) {
@@ -175,6 +175,12 @@ void CDnnBlob::initializeByPattern(TBlobType type, const CBlobDesc& pattern)
 		case CT_Int:
 			data = mathEngine.HeapAllocTyped<int>( size );
 			break;
+		case CT_Float16:
+			data = mathEngine.HeapAllocTyped<CFloat16>( size );
+			break;
+		case CT_BFloat16:
+			data = mathEngine.HeapAllocTyped<CBFloat16>( size );
+			break;
 		default:
 			NeoAssert( false );
 	}
@@ -238,21 +244,97 @@ void CDnnBlob::CopyFrom(const CDnnBlob* other)
 				CopyFrom( buffer.Ptr() );
 			}
 			break;
+		case CT_Float16:
+			if( &mathEngine == &other->GetMathEngine() ) {
+				mathEngine.VectorCopy( GetData<CFloat16>(), other->GetData<CFloat16>(), GetDataSize() );
+			} else {
+				CDnnBlobBuffer<CFloat16> buffer( const_cast<CDnnBlob&>( *other ), TDnnBlobBufferAccess::Read );
+				CopyFrom( buffer.Ptr() );
+			}
+			break;
+		case CT_BFloat16:
+			if( &mathEngine == &other->GetMathEngine() ) {
+				mathEngine.VectorCopy( GetData<CBFloat16>(), other->GetData<CBFloat16>(), GetDataSize() );
+			} else {
+				CDnnBlobBuffer<CBFloat16> buffer( const_cast<CDnnBlob&>( *other ), TDnnBlobBufferAccess::Read );
+				CopyFrom( buffer.Ptr() );
+			}
+			break;
 		default:
 			NeoAssert( false );
 	}
 }
 
+void CDnnBlob::ConvertFrom( const CDnnBlob* other )
+{
+	NeoAssert( other != nullptr );
+	NeoAssert( HasEqualDimensions( other ) );
+	NeoAssert( &mathEngine == &other->GetMathEngine() );
+
+	const TBlobType fromType = other->GetDataType();
+	const TBlobType toType = GetDataType();
+	if( fromType == toType ) {
+		CopyFrom( other );
+	} else if( fromType == CT_Float ) {
+		switch( toType ) {
+			case CT_Int:
+				mathEngine.VectorConvert( other->GetData<float>(), GetData<int>(), GetDataSize() );
+				break;
+			case CT_Float16:
+				mathEngine.VectorConvert( other->GetData<float>(), GetData<CFloat16>(), GetDataSize() );
+				break;
+			case CT_BFloat16:
+				mathEngine.VectorConvert( other->GetData<float>(), GetData<CBFloat16>(), GetDataSize() );
+				break;
+			default:
+				NeoAssert( false );
+		}
+	} else if( toType == CT_Float ) {
+		switch( fromType ) {
+			case CT_Int:
+				mathEngine.VectorConvert( other->GetData<int>(), GetData<float>(), GetDataSize() );
+				break;
+			case CT_Float16:
+				mathEngine.VectorConvert( other->GetData<CFloat16>(), GetData<float>(), GetDataSize() );
+				break;
+			case CT_BFloat16:
+				mathEngine.VectorConvert( other->GetData<CBFloat16>(), GetData<float>(), GetDataSize() );
+				break;
+			default:
+				NeoAssert( false );
+		}
+	} else {
+		// The conversion between two non-float types goes through float
+		CPtr<CDnnBlob> buffer = GetClone( CT_Float );
+		buffer->ConvertFrom( other );
+		ConvertFrom( buffer );
+	}
+}
+
 void CDnnBlob::TransferDataToThisThread()
 {
 	NeoAssert( dataOwned );
 	NeoAssert( !data.IsNull() );
 	NeoAssert( parent == nullptr );
-	NeoAssert( GetDataType() == CT_Float || GetDataType() == CT_Int );
 
-	const size_t size = GetDataSize()
-		* ( ( GetDataType() == CT_Float ) ? sizeof( float ) : sizeof( int ) );
-	mathEngine.TransferHandleToThisThread( data, size );
+	size_t elementSize = 0;
+	switch( GetDataType() ) {
+		case CT_Float:
+			elementSize = sizeof( float );
+			break;
+		case CT_Int:
+			elementSize = sizeof( int );
+			break;
+		case CT_Float16:
+			elementSize = sizeof( CFloat16 );
+			break;
+		case CT_BFloat16:
+			elementSize = sizeof( CBFloat16 );
+			break;
+		default:
+			NeoAssert( false );
+	}
+	mathEngine.TransferHandleToThisThread( data, GetDataSize() * elementSize );
 }
 
 void CDnnBlob::Add(const CDnnBlob* other)
@@ -565,6 +647,12 @@ void CDnnBlob::Serialize( CArchive& archive )
 			case CT_Int:
 				writeRawData( mathEngine, desc.BlobSize(), GetData<int>(), archive );
 				break;
+			case CT_Float16:
+				writeRawData( mathEngine, desc.BlobSize(), GetData<CFloat16>(), archive );
+				break;
+			case CT_BFloat16:
+				writeRawData( mathEngine, desc.BlobSize(), GetData<CBFloat16>(), archive );
+				break;
 			default:
 				NeoAssert( false );
 		}
@@ -586,6 +674,12 @@ void CDnnBlob::Serialize( CArchive& archive )
 			case CT_Int:
 				readRawData( mathEngine, archive, GetData<int>() );
 				break;
+			case CT_Float16:
+				readRawData( mathEngine, archive, GetData<CFloat16>() );
+				break;
+			case CT_BFloat16:
+				readRawData( mathEngine, archive, GetData<CBFloat16>() );
+				break;
 			default:
 				NeoAssert( false );
 		}
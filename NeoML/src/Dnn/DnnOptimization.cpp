@@ -19,10 +19,13 @@ limitations under the License.
 #include <NeoML/Dnn/DnnOptimization.h>
 #include <NeoML/Dnn/Optimization/Graph.h>
 #include "Optimization/BatchNormFusionOptimizer.h"
+#include "Optimization/BidirectionalGruOptimizer.h"
 #include "Optimization/ChannelwiseWith1x1Optimizer.h"
+#include "Optimization/EpilogueFusionOptimizer.h"
 #include "Optimization/MobileNetV2Optimizer.h"
 #include "Optimization/MobileNetV3Optimizer.h"
 #include "Optimization/OptimizerFunctions.h"
+#include "Optimization/SparseWeightsOptimizer.h"
 #include <NeoML/Dnn/Layers/RowwiseOperationChainLayer.h>
 #include <NeoML/Dnn/Dnn.h>
 
@@ -41,9 +44,12 @@ CDnnOptimizationReport OptimizeDnn( CDnn& dnn, const CDnnOptimizationSettings& s
 		optimization::CChannelwiseWith1x1Optimizer( graph ).Apply( report );
 		optimization::CMobileNetV2Optimizer( graph ).Apply( report );
 		optimization::CMobileNetV3Optimizer( graph ).Apply( report );
+		optimization::CEpilogueFusionOptimizer( graph ).Apply( report );
+		optimization::CSparseWeightsOptimizer( graph, settings.MinSparseWeightsSparsity ).Apply( report );
+		optimization::CBidirectionalGruOptimizer( graph, settings.BidirectionalGruThreadCount ).Apply( report );
 
 		CArray<int> chains;
-		OptimizeRowwiseChains( dnn, chains );
+		OptimizeRowwiseChains( dnn, chains, settings.RowwiseThreadCount );
 		report.RowwiseChainCount = chains.Size();
 	}
 	return report;
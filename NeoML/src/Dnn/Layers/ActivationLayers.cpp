@@ -169,6 +169,8 @@ CActivationDesc LoadActivationDesc( CArchive& archive )
 			CGELULayer::CParam param;
 			int intMode = 0;
 			archive >> intMode;
+			check( intMode >= 0 && intMode < static_cast<int>( CGELULayer::TCalculationMode::CM_Count ),
+				ERR_BAD_ARCHIVE, archive.Name() );
 			param.Mode = static_cast<CGELULayer::TCalculationMode>( intMode );
 			result.SetParam( param );
 			break;
@@ -112,6 +112,8 @@ void CBaseConvLayer::SetFilterData(const CPtr<CDnnBlob>& newFilter)
 	} else if(Filter() != 0 && GetDnn() != 0) {
 		NeoAssert(Filter()->HasEqualDimensions(newFilter));
 		Filter()->CopyFrom(newFilter);
+		// The convolution descriptors may keep the transformed filter
+		ForceReshape();
 	} else {
 		Filter() = newFilter->GetCopy();
 	}
@@ -189,6 +191,7 @@ void CBaseConvLayer::FilterLayerParams( float threshold )
 				paramBlobs[blobIndex]->GetDataSize(), threshold );
 		}
 	}
+	ForceReshape();
 }
 
 static const int BaseConvLayerVersion = 2000;
@@ -62,13 +62,7 @@ void CCastLayer::Reshape()
 
 void CCastLayer::RunOnce()
 {
-	if( outputBlobs[0]->GetDataType() == inputBlobs[0]->GetDataType() ) {
-		outputBlobs[0]->CopyFrom( inputBlobs[0] );
-	} else if( inputBlobs[0]->GetDataType() == CT_Int ) {
-		MathEngine().VectorConvert( inputBlobs[0]->GetData<int>(), outputBlobs[0]->GetData(), inputBlobs[0]->GetDataSize() );
-	} else {
-		MathEngine().VectorConvert( inputBlobs[0]->GetData(), outputBlobs[0]->GetData<int>(), inputBlobs[0]->GetDataSize() );
-	}
+	outputBlobs[0]->ConvertFrom( inputBlobs[0] );
 }
 
 void CCastLayer::BackwardOnce()
@@ -487,6 +487,7 @@ void CCompositeLayer::SetInternalDnnParams()
 	} else {
 		internalDnn->DisableLearning();
 	}
+	internalDnn->SetParamStorageType( GetDnn()->GetParamStorageType() );
 	internalDnn->SetInitializer( GetDnn()->GetInitializer() );
 }
 
@@ -21,6 +21,18 @@ limitations under the License.
 
 namespace NeoML {
 
+// Creates a copy of the blob with the given data type
+static CPtr<CDnnBlob> convertBlob( const CDnnBlob& blob, TBlobType type )
+{
+	if( blob.GetDataType() != CT_Float && type != CT_Float ) {
+		// The 16-bit formats are converted through float
+		return convertBlob( *convertBlob( blob, CT_Float ), type );
+	}
+	CPtr<CDnnBlob> result = CDnnBlob::CreateBlob( blob.GetMathEngine(), type, blob.GetDesc() );
+	result->ConvertFrom( &blob );
+	return result;
+}
+
 CFullyConnectedLayer::CFullyConnectedLayer( IMathEngine& mathEngine, const char* name ) :
 	CBaseLayer( mathEngine, name == nullptr ? "CCnnFullyConnectedLayer" : name, /*isLearnable*/true ),
 	numberOfElements( 0 ),
@@ -67,6 +79,14 @@ void CFullyConnectedLayer::Reshape()
 		outputDescs[i].SetDimSize( BD_Depth, 1 );
 		outputDescs[i].SetDimSize( BD_Channels, numberOfElements );
 	}
+
+	// The weights may be stored in 16-bit format only for inference
+	const TBlobType weightsType = ( MathEngine().GetType() == MET_Cpu && !GetDnn()->IsLearningEnabled() )
+		? GetDnn()->GetParamStorageType() : CT_Float;
+	if( Weights()->GetDataType() != weightsType ) {
+		// No float copy is kept, so the weights take half the memory
+		Weights() = convertBlob( *Weights(), weightsType );
+	}
 }
 
 void CFullyConnectedLayer::RunOnce()
@@ -75,7 +95,7 @@ void CFullyConnectedLayer::RunOnce()
 	const int secondHeight = numberOfElements;
 	const int secondWidth = Weights()->GetObjectSize();
 
-	CConstFloatHandle weightData = Weights()->GetData();
+	const TBlobType weightsType = Weights()->GetDataType();
 	CConstFloatHandle FreeTermsData = FreeTerms()->GetData();
 
 	for( int inputNumber = 0; inputNumber < inputCount; ++inputNumber ) {
@@ -88,10 +108,18 @@ void CFullyConnectedLayer::RunOnce()
 		NeoPresume( firstWidth == secondWidth );
 		NeoPresume( resultWidth == secondHeight );
 
-		MathEngine().MultiplyMatrixByTransposedMatrix(
-			/*first*/inputData, firstHeight, firstWidth, firstWidth,
-			/*second*/weightData, secondHeight, secondWidth,
-			/*result*/outputData, resultWidth, /*unused*/0 );
+		if( weightsType == CT_Float16 ) {
+			MathEngine().MultiplyMatrixByTransposedMatrix( inputData, firstHeight, firstWidth,
+				Weights()->GetData<CFloat16>(), secondHeight, outputData );
+		} else if( weightsType == CT_BFloat16 ) {
+			MathEngine().MultiplyMatrixByTransposedMatrix( inputData, firstHeight, firstWidth,
+				Weights()->GetData<CBFloat16>(), secondHeight, outputData );
+		} else {
+			MathEngine().MultiplyMatrixByTransposedMatrix(
+				/*first*/inputData, firstHeight, firstWidth, firstWidth,
+				/*second*/Weights()->GetData(), secondHeight, secondWidth,
+				/*result*/outputData, resultWidth, /*unused*/0 );
+		}
 
 		if( !isZeroFreeTerm ) {
 			MathEngine().AddVectorToMatrixRows( /*batchSize*/1, outputData,
@@ -105,7 +133,9 @@ void CFullyConnectedLayer::BackwardOnce()
 	const int outputDiffCount = outputDiffBlobs.Size();
 	const int secondWidth = Weights()->GetObjectSize();
 
-	CConstFloatHandle weightData = Weights()->GetData();
+	// The 16-bit weights are used when learning is disabled, but the backward pass is still possible
+	CPtr<CDnnBlob> weights = Weights()->GetDataType() == CT_Float ? Weights() : convertBlob( *Weights(), CT_Float );
+	CConstFloatHandle weightData = weights->GetData();
 
 	for( int outputDiffNumber = 0; outputDiffNumber < outputDiffCount; ++outputDiffNumber ) {
 		CConstFloatHandle outputDiffData = outputDiffBlobs[outputDiffNumber]->GetData();
@@ -154,6 +184,7 @@ void CFullyConnectedLayer::LearnOnce()
 
 void CFullyConnectedLayer::FilterLayerParams( float threshold )
 {
+	convertWeightsToFloat();
 	for( int blobIndex = 0; blobIndex < paramBlobs.Size(); ++blobIndex ) {
 		if( paramBlobs[blobIndex] != nullptr ) {
 			MathEngine().FilterSmallValues( paramBlobs[blobIndex]->GetData(),
@@ -173,6 +204,9 @@ CPtr<CDnnBlob> CFullyConnectedLayer::GetWeightsData() const
 	if( Weights() == nullptr ) {
 		return nullptr;
 	}
+	if( Weights()->GetDataType() != CT_Float ) {
+		return convertBlob( *Weights(), CT_Float );
+	}
 	return Weights()->GetCopy();
 }
 
@@ -184,7 +218,7 @@ void CFullyConnectedLayer::SetWeightsData( const CDnnBlob* newWeights )
 	} else if( Weights() != nullptr && GetDnn() != nullptr ) {
 		NeoAssert( Weights()->GetObjectCount() == newWeights->GetObjectCount() );
 		NeoAssert( Weights()->GetObjectSize() == newWeights->GetObjectSize() );
-		Weights()->CopyFrom( newWeights );
+		Weights()->ConvertFrom( newWeights );
 	} else {
 		Weights() = newWeights->GetCopy();
 	}
@@ -234,6 +268,7 @@ void CFullyConnectedLayer::ApplyBatchNormalization( CBatchNormalizationLayer& ba
 		return;
 	}
 	NeoAssert( params->GetObjectSize() == numberOfElements );
+	convertWeightsToFloat();
 	CConstFloatHandle gamma = params->GetObjectData( 0 );
 	CConstFloatHandle beta = params->GetObjectData( 1 );
 
@@ -248,12 +283,29 @@ void CFullyConnectedLayer::ApplyBatchNormalization( CBatchNormalizationLayer& ba
 	}
 }
 
+// Converts the weights to float (they'll be converted again on reshape if needed)
+void CFullyConnectedLayer::convertWeightsToFloat()
+{
+	if( Weights() != nullptr && Weights()->GetDataType() != CT_Float ) {
+		Weights() = convertBlob( *Weights(), CT_Float );
+		ForceReshape();
+	}
+}
+
 static const int FullyConnectedLayerVersion = 2000;
 
 void CFullyConnectedLayer::Serialize( CArchive& archive )
 {
 	archive.SerializeVersion( FullyConnectedLayerVersion, CDnn::ArchiveMinSupportedVersion );
-	CBaseLayer::Serialize( archive );
+	if( archive.IsStoring() && Weights() != nullptr && Weights()->GetDataType() != CT_Float ) {
+		// The weights are always stored in float
+		CPtr<CDnnBlob> storageWeights = Weights();
+		Weights() = convertBlob( *storageWeights, CT_Float );
+		CBaseLayer::Serialize( archive );
+		Weights() = storageWeights;
+	} else {
+		CBaseLayer::Serialize( archive );
+	}
 
 	archive.Serialize( numberOfElements );
 	archive.Serialize( isZeroFreeTerm );
@@ -29,7 +29,15 @@ static const float GELUSqrt2PiInv = 0.39894229f;
 // scale for the approximation
 static const float GELUApproximationMultiplier = 1.702f;
 
-static const int CGELULayerVersion = 1;
+static const int CGELULayerVersion = 2;
+
+// Checks if GELU and its derivative are calculated by the math engine in a single call
+// The tanh approximation has no layer-side implementation and always uses the math engine
+static bool isSinglePassGelu( const IMathEngine& mathEngine, CGELULayer::TCalculationMode mode )
+{
+	return mathEngine.GetType() == MET_Cpu || mathEngine.GetType() == MET_Cuda
+		|| mode == CGELULayer::CM_TanhApproximate;
+}
 
 CGELULayer::CGELULayer( IMathEngine& mathEngine ) :
 	CBaseLayer( mathEngine, "CGELULayer", false ),
@@ -52,6 +60,9 @@ void CGELULayer::Serialize( CArchive& archive )
 	CBaseLayer::Serialize( archive );
 	if( version >= 1 ) {
 		archive.SerializeEnum( mode );
+		// The tanh approximation appeared in version 2
+		check( mode == CM_Precise || mode == CM_SigmoidApproximate || ( version >= 2 && mode == CM_TanhApproximate ),
+			ERR_BAD_ARCHIVE, archive.Name() );
 	} else {
 		mode = CM_SigmoidApproximate;
 	}
@@ -78,7 +89,8 @@ void CGELULayer::Reshape()
 	outputDescs.SetSize( 1 );
 	outputDescs[0] = inputDesc;
 
-	if( IsBackwardPerformed() ) {
+	// The single-pass backward doesn't use the memoized values
+	if( IsBackwardPerformed() && !isSinglePassGelu( MathEngine(), mode ) ) {
 		erfMemoization = CDnnBlob::CreateBlob( MathEngine(), CT_Float, inputDesc );
 		RegisterRuntimeBlob( erfMemoization );
 	}
@@ -88,6 +100,13 @@ void CGELULayer::RunOnce()
 {
 	CheckInput1();
 
+	if( isSinglePassGelu( MathEngine(), mode ) ) {
+		// The single-pass kernel
+		MathEngine().VectorGELU( inputBlobs[0]->GetData(), outputBlobs[0]->GetData(),
+			inputBlobs[0]->GetDataSize(), mode );
+		return;
+	}
+
 	switch( mode ) {
 		case TCalculationMode::CM_Precise:
 			runPrecise();
@@ -102,6 +121,13 @@ void CGELULayer::RunOnce()
 
 void CGELULayer::BackwardOnce()
 {
+	if( isSinglePassGelu( MathEngine(), mode ) ) {
+		// The single-pass kernel
+		MathEngine().VectorGELUDiff( inputBlobs[0]->GetData(), outputDiffBlobs[0]->GetData(),
+			inputDiffBlobs[0]->GetData(), inputBlobs[0]->GetDataSize(), mode );
+		return;
+	}
+
 	switch( mode ) {
 		case TCalculationMode::CM_Precise:
 			backwardPrecise();
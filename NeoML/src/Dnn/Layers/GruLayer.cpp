@@ -21,15 +21,22 @@ limitations under the License.
 #include <NeoML/Dnn/Layers/SplitLayer.h>
 #include <NeoML/Dnn/Layers/ActivationLayers.h>
 #include <NeoML/Dnn/Layers/EltwiseLayer.h>
+#include "MobileNetBlockUtils.h"
 
 namespace NeoML {
 
 CGruLayer::CGruLayer( IMathEngine& mathEngine ) :
-	CRecurrentLayer( mathEngine, "CCnnGruLayer" )
+	CRecurrentLayer( mathEngine, "CCnnGruLayer" ),
+	gruDesc( nullptr )
 {
 	buildLayer();
 }
 
+CGruLayer::~CGruLayer()
+{
+	delete gruDesc;
+}
+
 // Builds the layer
 void CGruLayer::buildLayer()
 {
@@ -127,6 +134,30 @@ void CGruLayer::SetHiddenSize(int size)
 	mainBackLink->SetDimSize(BD_Channels, size);
 }
 
+void CGruLayer::SetMainWeightsData( CDnnBlob* newWeights )
+{
+	mainLayer->SetWeightsData( newWeights );
+	freeDesc();
+}
+
+void CGruLayer::SetMainFreeTermData( CDnnBlob* newFreeTerm )
+{
+	mainLayer->SetFreeTermData( newFreeTerm );
+	freeDesc();
+}
+
+void CGruLayer::SetGateWeightsData( CDnnBlob* newWeights )
+{
+	gateLayer->SetWeightsData( newWeights );
+	freeDesc();
+}
+
+void CGruLayer::SetGateFreeTermData( CDnnBlob* newFreeTerm )
+{
+	gateLayer->SetFreeTermData( newFreeTerm );
+	freeDesc();
+}
+
 static const int GruLayerVersion = 2000;
 
 void CGruLayer::Serialize( CArchive& archive )
@@ -142,6 +173,149 @@ void CGruLayer::Serialize( CArchive& archive )
 	}
 }
 
+void CGruLayer::RunOnce()
+{
+	gates = nullptr;
+	if( canUseSequenceKernel() ) {
+		initDesc();
+		const int sequenceLength = inputBlobs[0]->GetBatchLength();
+		const int sequenceCount = inputBlobs[0]->GetBatchWidth();
+		if( IsBackwardPerformed() || IsLearningPerformed() ) {
+			gates = CDnnBlob::CreateDataBlob( MathEngine(), CT_Float, sequenceLength, sequenceCount,
+				3 * GetHiddenSize() );
+		}
+		CConstFloatHandle inputState = inputBlobs.Size() > 1 ? inputBlobs[1]->GetData() : CConstFloatHandle();
+		MathEngine().Gru( *gruDesc, IsReverseSequence(), sequenceLength, sequenceCount, inputState,
+			inputBlobs[0]->GetData(), outputBlobs[0]->GetData(),
+			gates == nullptr ? CFloatHandle() : gates->GetData() );
+	} else {
+		freeDesc();
+		CRecurrentLayer::RunOnce();
+	}
+}
+
+void CGruLayer::Reshape()
+{
+	CRecurrentLayer::Reshape();
+	freeDesc();
+	gates = nullptr;
+}
+
+void CGruLayer::BackwardOnce()
+{
+	if( gates != nullptr ) {
+		sequenceKernelBackward();
+	} else {
+		CRecurrentLayer::BackwardOnce();
+	}
+}
+
+void CGruLayer::LearnOnce()
+{
+	if( gates != nullptr ) {
+		// The diffs of the weights are calculated in the same pass as the backward
+		if( !IsBackwardPerformed() ) {
+			sequenceKernelBackward();
+		}
+	} else {
+		CRecurrentLayer::LearnOnce();
+	}
+}
+
+int CGruLayer::BlobsForBackward() const
+{
+	return MathEngine().GetType() == MET_Cpu ? TInputBlobs | TOutputBlobs : CRecurrentLayer::BlobsForBackward();
+}
+
+int CGruLayer::BlobsForLearn() const
+{
+	return MathEngine().GetType() == MET_Cpu ? TInputBlobs | TOutputBlobs : CRecurrentLayer::BlobsForLearn();
+}
+
+// Checks if the whole sequence may be calculated by the math engine instead of the internal network
+bool CGruLayer::canUseSequenceKernel() const
+{
+	return MathEngine().GetType() == MET_Cpu
+		&& !GetDnn()->IsRecurrentMode()
+		&& GetRepeatCount() == 1
+		&& inputBlobs[0]->GetListSize() == 1
+		&& outputBlobs.Size() == 1
+		&& gateLayer->Weights()->GetDataType() == CT_Float
+		&& mainLayer->Weights()->GetDataType() == CT_Float;
+}
+
+void CGruLayer::initDesc()
+{
+	if( gruDesc == nullptr ) {
+		CConstFloatHandle gateFreeTerm = gateLayer->IsZeroFreeTerm() || gateLayer->FreeTerms() == nullptr
+			? CConstFloatHandle() : gateLayer->FreeTerms()->GetData();
+		CConstFloatHandle mainFreeTerm = mainLayer->IsZeroFreeTerm() || mainLayer->FreeTerms() == nullptr
+			? CConstFloatHandle() : mainLayer->FreeTerms()->GetData();
+		gruDesc = MathEngine().InitGru( GetHiddenSize(), inputBlobs[0]->GetObjectSize(),
+			gateLayer->Weights()->GetData(), gateFreeTerm, mainLayer->Weights()->GetData(), mainFreeTerm );
+	}
+}
+
+void CGruLayer::freeDesc()
+{
+	delete gruDesc;
+	gruDesc = nullptr;
+}
+
+// Calculates the diffs of the whole sequence calculation
+// The diffs of the weights are passed to the solver for the internal fully-connected layers
+void CGruLayer::sequenceKernelBackward()
+{
+	const bool isStateDiffNeeded = IsBackwardPerformed() && inputDiffBlobs.Size() > 1;
+	const bool isGateLearning = IsLearningPerformed() && gateLayer->IsLearningEnabled();
+	const bool isMainLearning = IsLearningPerformed() && mainLayer->IsLearningEnabled();
+	CPtr<CDnnBlob> gateWeightsDiff;
+	CPtr<CDnnBlob> gateFreeTermDiff;
+	if( isGateLearning ) {
+		gateWeightsDiff = gateLayer->Weights()->GetClone();
+		gateWeightsDiff->Clear();
+		gateFreeTermDiff = gateLayer->FreeTerms()->GetClone();
+		gateFreeTermDiff->Clear();
+	}
+	CPtr<CDnnBlob> mainWeightsDiff;
+	CPtr<CDnnBlob> mainFreeTermDiff;
+	if( isMainLearning ) {
+		mainWeightsDiff = mainLayer->Weights()->GetClone();
+		mainWeightsDiff->Clear();
+		mainFreeTermDiff = mainLayer->FreeTerms()->GetClone();
+		mainFreeTermDiff->Clear();
+	}
+
+	CConstFloatHandle inputState = inputBlobs.Size() > 1 ? inputBlobs[1]->GetData() : CConstFloatHandle();
+	MathEngine().GruBackward( *gruDesc, IsReverseSequence(), inputBlobs[0]->GetBatchLength(),
+		inputBlobs[0]->GetBatchWidth(), inputState, inputBlobs[0]->GetData(), outputBlobs[0]->GetData(),
+		gates->GetData(), outputDiffBlobs[0]->GetData(),
+		isStateDiffNeeded ? inputDiffBlobs[1]->GetData() : CFloatHandle(),
+		IsBackwardPerformed() ? inputDiffBlobs[0]->GetData() : CFloatHandle(),
+		gateWeightsDiff == nullptr ? CFloatHandle() : gateWeightsDiff->GetData(),
+		gateFreeTermDiff == nullptr || gateLayer->IsZeroFreeTerm() ? CFloatHandle() : gateFreeTermDiff->GetData(),
+		mainWeightsDiff == nullptr ? CFloatHandle() : mainWeightsDiff->GetData(),
+		mainFreeTermDiff == nullptr || mainLayer->IsZeroFreeTerm() ? CFloatHandle() : mainFreeTermDiff->GetData() );
+	gates = nullptr;
+
+	if( isGateLearning ) {
+		CObjectArray<CDnnBlob> gateDiffs;
+		gateDiffs.Add( gateWeightsDiff );
+		gateDiffs.Add( gateFreeTermDiff );
+		GetDnn()->GetSolver()->AddDiff( gateLayer, gateDiffs );
+	}
+	if( isMainLearning ) {
+		CObjectArray<CDnnBlob> mainDiffs;
+		mainDiffs.Add( mainWeightsDiff );
+		mainDiffs.Add( mainFreeTermDiff );
+		GetDnn()->GetSolver()->AddDiff( mainLayer, mainDiffs );
+	}
+	if( isGateLearning || isMainLearning ) {
+		// The weights are changed by the solver, so the descriptor is rebuilt on the next run
+		freeDesc();
+	}
+}
+
 CLayerWrapper<CGruLayer> Gru( int hiddenSize )
 {
 	return CLayerWrapper<CGruLayer>( "Gru", [=]( CGruLayer* result ) {
@@ -149,4 +323,109 @@ CLayerWrapper<CGruLayer> Gru( int hiddenSize )
 	} );
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+
+CBidirectionalGruLayer::CBidirectionalGruLayer( IMathEngine& mathEngine, const CGruLayer& direct,
+		const CGruLayer& reverse ) :
+	CBidirectionalGruLayer( mathEngine )
+{
+	const CGruLayer* grus[2] = { &direct, &reverse };
+	for( int i = 0; i < 2; ++i ) {
+		paramBlobs[i * P_Count + P_GateWeights] = MobileNetParam( grus[i]->GetGateWeightsData() );
+		paramBlobs[i * P_Count + P_GateFreeTerm] = MobileNetFreeTerm( grus[i]->GetGateFreeTermData() );
+		paramBlobs[i * P_Count + P_MainWeights] = MobileNetParam( grus[i]->GetMainWeightsData() );
+		paramBlobs[i * P_Count + P_MainFreeTerm] = MobileNetFreeTerm( grus[i]->GetMainFreeTermData() );
+	}
+}
+
+CBidirectionalGruLayer::CBidirectionalGruLayer( IMathEngine& mathEngine ) :
+	CBaseLayer( mathEngine, "BidirectionalGru", false ),
+	gruDescs{ nullptr, nullptr },
+	threadCount( 2 )
+{
+	paramBlobs.SetSize( 2 * P_Count );
+}
+
+CBidirectionalGruLayer::~CBidirectionalGruLayer()
+{
+	freeDescs();
+}
+
+void CBidirectionalGruLayer::SetThreadCount( int newThreadCount )
+{
+	NeoAssert( newThreadCount > 0 );
+	if( newThreadCount != threadCount ) {
+		threadCount = newThreadCount;
+		threadPool.Release();
+	}
+}
+
+static const int BidirectionalGruLayerVersion = 0;
+
+void CBidirectionalGruLayer::Serialize( CArchive& archive )
+{
+	archive.SerializeVersion( BidirectionalGruLayerVersion );
+	CBaseLayer::Serialize( archive );
+	if( archive.IsLoading() ) {
+		freeDescs();
+	}
+}
+
+void CBidirectionalGruLayer::Reshape()
+{
+	CheckInputs();
+	CheckLayerArchitecture( GetInputCount() == 1, "bidirectional GRU must have 1 input" );
+	CheckLayerArchitecture( GetOutputCount() == 2, "bidirectional GRU must have 2 outputs" );
+	CheckLayerArchitecture( inputDescs[0].GetDataType() == CT_Float, "input must be float" );
+	CheckLayerArchitecture( inputDescs[0].ListSize() == 1, "input list size must be 1" );
+	CheckLayerArchitecture( MathEngine().GetType() == MET_Cpu, "bidirectional GRU is supported only on CPU" );
+
+	for( int i = 0; i < 2; ++i ) {
+		const CDnnBlob* mainWeights = paramBlobs[i * P_Count + P_MainWeights];
+		const CDnnBlob* gateWeights = paramBlobs[i * P_Count + P_GateWeights];
+		NeoAssert( mainWeights != nullptr && gateWeights != nullptr );
+		const int hiddenSize = mainWeights->GetObjectCount();
+		CheckLayerArchitecture( mainWeights->GetObjectSize() == inputDescs[0].ObjectSize() + hiddenSize,
+			"weights size mismatch" );
+		CheckLayerArchitecture( gateWeights->GetObjectCount() == 2 * hiddenSize
+			&& gateWeights->GetObjectSize() == mainWeights->GetObjectSize(), "gate weights size mismatch" );
+
+		outputDescs[i] = inputDescs[0];
+		outputDescs[i].SetDimSize( BD_Height, 1 );
+		outputDescs[i].SetDimSize( BD_Width, 1 );
+		outputDescs[i].SetDimSize( BD_Depth, 1 );
+		outputDescs[i].SetDimSize( BD_Channels, hiddenSize );
+	}
+	freeDescs();
+}
+
+void CBidirectionalGruLayer::RunOnce()
+{
+	for( int i = 0; i < 2; ++i ) {
+		if( gruDescs[i] == nullptr ) {
+			const CDnnBlob* gateFreeTerm = paramBlobs[i * P_Count + P_GateFreeTerm];
+			const CDnnBlob* mainFreeTerm = paramBlobs[i * P_Count + P_MainFreeTerm];
+			gruDescs[i] = MathEngine().InitGru( outputBlobs[i]->GetChannelsCount(), inputBlobs[0]->GetObjectSize(),
+				paramBlobs[i * P_Count + P_GateWeights]->GetData(),
+				gateFreeTerm == nullptr ? CConstFloatHandle() : gateFreeTerm->GetData(),
+				paramBlobs[i * P_Count + P_MainWeights]->GetData(),
+				mainFreeTerm == nullptr ? CConstFloatHandle() : mainFreeTerm->GetData() );
+		}
+	}
+	if( threadCount > 1 && threadPool == nullptr ) {
+		threadPool = CreateThreadPool( min( threadCount, 2 ) );
+	}
+	MathEngine().BidirectionalGru( *gruDescs[0], *gruDescs[1], inputBlobs[0]->GetBatchLength(),
+		inputBlobs[0]->GetBatchWidth(), inputBlobs[0]->GetData(), outputBlobs[0]->GetData(),
+		outputBlobs[1]->GetData(), threadPool.Ptr() );
+}
+
+void CBidirectionalGruLayer::freeDescs()
+{
+	for( int i = 0; i < 2; ++i ) {
+		delete gruDescs[i];
+		gruDescs[i] = nullptr;
+	}
+}
+
 } // namespace NeoML
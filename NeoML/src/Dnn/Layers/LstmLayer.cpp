@@ -353,7 +353,9 @@ void CLstmLayer::RunOnce()
 		!isInCompatibilityMode &&
 		!IsBackwardPerformed() &&
 		!IsLearningPerformed() &&
-		recurrentActivation == AF_Sigmoid )
+		recurrentActivation == AF_Sigmoid &&
+		inputHiddenLayer->Weights()->GetDataType() == CT_Float &&
+		recurHiddenLayer->Weights()->GetDataType() == CT_Float )
 	{
 		initDesc();
 		CConstFloatHandle inputStateBackLink = inputBlobs.Size() > 1 ? inputBlobs[1]->GetData() : CConstFloatHandle();
@@ -101,8 +101,11 @@ CPtr<CDnnBlob> CObjectNormalizationLayer::GetBias() const
 
 void CObjectNormalizationLayer::OnReshaped()
 {
-	CheckLayerArchitecture( GetInputCount() == 1, "layer must have exactly 1 input" );
+	CheckLayerArchitecture( GetInputCount() == 1 || GetInputCount() == 2, "layer must have 1 or 2 inputs" );
 	CheckLayerArchitecture( GetOutputCount() == 1, "layer must have exactly 1 output" );
+	if( GetInputCount() == 2 ) {
+		CheckLayerArchitecture( inputDescs[1].HasEqualDimensions( inputDescs[0] ), "residual size mismatch" );
+	}
 
 	CBlobDesc paramDesc;
 	paramDesc.SetDimSize( BD_Channels, inputDescs[0].ObjectSize() );
@@ -161,47 +164,79 @@ void CObjectNormalizationLayer::OnReshaped()
 
 	invObjectSize->GetData().SetValue( 1.f / inputDescs[0].ObjectSize() );
 
-	inputDescs.CopyTo( outputDescs );
+	// The residual input has no corresponding output
+	outputDescs.SetSize( 1 );
+	outputDescs[0] = inputDescs[0];
 }
 
 void CObjectNormalizationLayer::RunOnce()
 {
 	const int objectCount = inputBlobs[0]->GetObjectCount();
 
+	if( MathEngine().GetType() == MET_Cpu ) {
+		// The single-pass kernel
+		if( normalizedInput == nullptr ) {
+			runLayerNorm( CFloatHandle(), CFloatHandle() );
+		} else if( internalParams == nullptr ) {
+			CFloatHandleStackVar invStdDev( MathEngine(), objectCount );
+			runLayerNorm( normalizedInput->GetData(), invStdDev.GetHandle() );
+		} else {
+			runLayerNorm( normalizedInput->GetData(), internalParams->GetObjectData( IPN_InvSqrtVariance ) );
+		}
+		return;
+	}
+
+	CConstFloatHandle input = inputBlobs[0]->GetData();
+	if( GetInputCount() > 1 ) {
+		MathEngine().VectorAdd( inputBlobs[0]->GetData(), inputBlobs[1]->GetData(), outputBlobs[0]->GetData(),
+			outputBlobs[0]->GetDataSize() );
+		input = outputBlobs[0]->GetData();
+	}
+
 	if( internalParams == nullptr ) {
 		CFloatHandleStackVar meanAndVarBuff( MathEngine(), 2 * objectCount );
-		runOnceImpl( meanAndVarBuff.GetHandle(), meanAndVarBuff.GetHandle() + objectCount,
+		runOnceImpl( input, meanAndVarBuff.GetHandle(), meanAndVarBuff.GetHandle() + objectCount,
 			normalizedInput == nullptr ? outputBlobs[0]->GetData() : normalizedInput->GetData() );
 	} else {
-		runOnceImpl( internalParams->GetObjectData( IPN_NegMean ), internalParams->GetObjectData( IPN_InvSqrtVariance ),
+		runOnceImpl( input, internalParams->GetObjectData( IPN_NegMean ),
+			internalParams->GetObjectData( IPN_InvSqrtVariance ),
 			normalizedInput == nullptr ? outputBlobs[0]->GetData() : normalizedInput->GetData() );
 	}
 }
 
-void CObjectNormalizationLayer::runOnceImpl( const CFloatHandle& negMean, const CFloatHandle& invSqrtVar,
-	const CFloatHandle& inputNorm )
+// Runs IDnnEngine::LayerNorm; normalized and invStdDev are either both null or both not null
+void CObjectNormalizationLayer::runLayerNorm( const CFloatHandle& normalized, const CFloatHandle& invStdDev )
+{
+	CConstFloatHandle residual = GetInputCount() > 1 ? inputBlobs[1]->GetData() : CConstFloatHandle();
+	MathEngine().LayerNorm( inputBlobs[0]->GetData(), residual.IsNull() ? nullptr : &residual,
+		inputBlobs[0]->GetObjectCount(), inputBlobs[0]->GetObjectSize(), GetEpsilon(), Scale()->GetData(),
+		Bias()->GetData(), outputBlobs[0]->GetData(), normalized.IsNull() ? nullptr : &normalized,
+		invStdDev.IsNull() ? nullptr : &invStdDev );
+}
+
+void CObjectNormalizationLayer::runOnceImpl( const CConstFloatHandle& input, const CFloatHandle& negMean,
+	const CFloatHandle& invSqrtVar, const CFloatHandle& inputNorm )
 {
-	calcMean( negMean );
-	calcVar( negMean, invSqrtVar );
-	normalizeInput( negMean, invSqrtVar, inputNorm );
+	calcMean( input, negMean );
+	calcVar( input, negMean, invSqrtVar );
+	normalizeInput( input, negMean, invSqrtVar, inputNorm );
 	applyScaleAndBias( inputNorm );
 }
 
-void CObjectNormalizationLayer::calcMean( const CFloatHandle& negMean )
+void CObjectNormalizationLayer::calcMean( const CConstFloatHandle& input, const CFloatHandle& negMean )
 {
-	MathEngine().SumMatrixColumns( negMean, inputBlobs[0]->GetData(),
+	MathEngine().SumMatrixColumns( negMean, input,
 		inputBlobs[0]->GetObjectCount(), inputBlobs[0]->GetObjectSize() );
 	MathEngine().VectorNegMultiply( negMean, negMean, inputBlobs[0]->GetObjectCount(),
 		invObjectSize->GetData() );
 }
 
-void CObjectNormalizationLayer::calcVar( const CConstFloatHandle& negMean, const CFloatHandle& invSqrtVar )
+void CObjectNormalizationLayer::calcVar( const CConstFloatHandle& input, const CConstFloatHandle& negMean,
+	const CFloatHandle& invSqrtVar )
 {
 	const int objectCount = inputBlobs[0]->GetObjectCount();
 	const int objectSize = inputBlobs[0]->GetObjectSize();
 
-	CConstFloatHandle input = inputBlobs[0]->GetData();
-
 	CFloatHandleStackVar temp( MathEngine(), inputBlobs[0]->GetDataSize() );
 
 	MathEngine().AddVectorToMatrixColumns( input, temp, objectCount, objectSize, negMean );
@@ -215,13 +250,12 @@ void CObjectNormalizationLayer::calcVar( const CConstFloatHandle& negMean, const
 	MathEngine().VectorInv( invSqrtVar, invSqrtVar, objectCount );
 }
 
-void CObjectNormalizationLayer::normalizeInput( const CConstFloatHandle& negMean, const CConstFloatHandle& invSqrtVar,
-	const CFloatHandle& inputNorm )
+void CObjectNormalizationLayer::normalizeInput( const CConstFloatHandle& input, const CConstFloatHandle& negMean,
+	const CConstFloatHandle& invSqrtVar, const CFloatHandle& inputNorm )
 {
 	const int objectCount = inputBlobs[0]->GetObjectCount();
 	const int objectSize = inputBlobs[0]->GetObjectSize();
 
-	CConstFloatHandle input = inputBlobs[0]->GetData();
 	const int outSize = normalizedInput == nullptr ? outputBlobs[0]->GetDataSize() : normalizedInput->GetDataSize();
 
 	MathEngine().AddVectorToMatrixColumns( input, inputNorm, objectCount, objectSize, negMean );
@@ -245,7 +279,6 @@ void CObjectNormalizationLayer::BackwardOnce()
 {
 	const int objectCount = inputDiffBlobs[0]->GetObjectCount();
 	const int objectSize = inputDiffBlobs[0]->GetObjectSize();
-	const int dataSize = objectCount * objectSize;
 
 	CConstFloatHandle input = normalizedInput->GetData();
 	CFloatHandle inputDiff = inputDiffBlobs[0]->GetData();
@@ -257,6 +290,25 @@ void CObjectNormalizationLayer::BackwardOnce()
 		MathEngine().VectorCopy( outputDiffBackup->GetData(), outputDiff, outputDiffBackup->GetDataSize() );
 	}
 
+	if( MathEngine().GetType() == MET_Cpu ) {
+		MathEngine().LayerNormBackward( input, invSqrtVar, outputDiff, objectCount, objectSize, scale, inputDiff );
+	} else {
+		backwardOnceImpl( input, invSqrtVar, outputDiff, scale, inputDiff );
+	}
+
+	// The residual has the same diff
+	if( GetInputCount() > 1 ) {
+		inputDiffBlobs[1]->CopyFrom( inputDiffBlobs[0] );
+	}
+}
+
+void CObjectNormalizationLayer::backwardOnceImpl( const CConstFloatHandle& input, const CConstFloatHandle& invSqrtVar,
+	const CConstFloatHandle& outputDiff, const CConstFloatHandle& scale, const CFloatHandle& inputDiff )
+{
+	const int objectCount = inputDiffBlobs[0]->GetObjectCount();
+	const int objectSize = inputDiffBlobs[0]->GetObjectSize();
+	const int dataSize = objectCount * objectSize;
+
 	// Average is used multiple times in RunOnce.
 	// But it is used neither in BackwardOnce nor in LearnOnce.
 	// That's why it's possible to reuse it here as a buffer.
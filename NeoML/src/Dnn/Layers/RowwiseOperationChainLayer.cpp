@@ -19,17 +19,22 @@ limitations under the License.
 #include <NeoML/Dnn/Layers/RowwiseOperationChainLayer.h>
 
 #include <NeoML/Dnn/Layers/ActivationLayers.h>
+#include <NeoML/Dnn/Layers/BatchNormalizationLayer.h>
 #include <NeoML/Dnn/Layers/ChannelwiseConvLayer.h>
 #include <NeoML/Dnn/Layers/ChannelwiseWith1x1Layer.h>
 #include <NeoML/Dnn/Layers/ConvLayer.h>
+#include <NeoML/Dnn/Layers/EltwiseLayer.h>
+#include <NeoML/Dnn/Layers/EpilogueLayers.h>
 #include <NeoML/Dnn/Layers/ImageResizeLayer.h>
 #include <NeoML/Dnn/Layers/MobileNetV2BlockLayer.h>
 #include <NeoML/Dnn/Layers/PoolingLayer.h>
 #include <NeoML/Dnn/Optimization/Graph.h>
 #include <NeoML/Dnn/Rowwise/Activation.h>
+#include <NeoML/Dnn/Rowwise/BatchNormalization.h>
 #include <NeoML/Dnn/Rowwise/ChannelwiseConv.h>
 #include <NeoML/Dnn/Rowwise/ChannelwiseWith1x1.h>
 #include <NeoML/Dnn/Rowwise/Conv.h>
+#include <NeoML/Dnn/Rowwise/EltwiseSum.h>
 #include <NeoML/Dnn/Rowwise/ImageResize.h>
 #include <NeoML/Dnn/Rowwise/MobileNetV2.h>
 #include <NeoML/Dnn/Rowwise/Pooling.h>
@@ -37,10 +42,22 @@ limitations under the License.
 namespace NeoML {
 
 CRowwiseOperationChainLayer::CRowwiseOperationChainLayer( IMathEngine& mathEngine ) :
-	CBaseLayer( mathEngine, "CRowwiseOperationChainLayer", false )
+	CBaseLayer( mathEngine, "CRowwiseOperationChainLayer", false ),
+	threadCount( 1 )
 {
 }
 
+void CRowwiseOperationChainLayer::SetThreadCount( int newThreadCount )
+{
+	if( newThreadCount <= 0 ) {
+		newThreadCount = GetAvailableCpuCores();
+	}
+	if( newThreadCount != threadCount ) {
+		threadCount = newThreadCount;
+		threadPool.Release();
+	}
+}
+
 CRowwiseOperationChainLayer::~CRowwiseOperationChainLayer()
 {
 	deleteRowwiseDescs();
@@ -100,8 +117,11 @@ void CRowwiseOperationChainLayer::Reshape()
 
 void CRowwiseOperationChainLayer::RunOnce()
 {
+	if( threadCount > 1 && threadPool == nullptr && MathEngine().GetType() == MET_Cpu ) {
+		threadPool = CreateThreadPool( threadCount );
+	}
 	MathEngine().RowwiseExecute( inputBlobs[0]->GetDesc(), operationDescs.GetPtr(), operations.Size(),
-		inputBlobs[0]->GetData(), outputBlobs[0]->GetData() );
+		inputBlobs[0]->GetData(), outputBlobs[0]->GetData(), threadPool.Ptr() );
 }
 
 void CRowwiseOperationChainLayer::BackwardOnce()
@@ -139,54 +159,164 @@ static bool isChainLayer( const CBaseLayer* layer )
 	return IsOneOf<CRowwiseOperationChainLayer>::f( layer );
 }
 
+// The activations supported by the rowwise activation operation
+static bool isRowwiseActivation( const CActivationDesc& activation )
+{
+	return activation.GetType() != AF_GELU;
+}
+
+// Checks if the layer with one input can be replaced with rowwise operations
 static bool isRowwiseOpLayer( const CBaseLayer* layer )
 {
-	return IsOneOf<CChannelwiseWith1x1Layer, CChannelwiseConvLayer, CConvLayer, CELULayer, CHardSigmoidLayer,
+	if( IsOneOf<CChannelwiseWith1x1Layer, CChannelwiseConvLayer, CConvLayer, CELULayer, CHardSigmoidLayer,
 		CHardTanhLayer, CHSwishLayer, CImageResizeLayer, CLeakyReLULayer, CLinearLayer, CMaxPoolingLayer,
-		CMeanPoolingLayer, CMobileNetV2BlockLayer, CReLULayer, CSigmoidLayer, CTanhLayer>::f( layer );
+		CMeanPoolingLayer, CMobileNetV2BlockLayer, CReLULayer, CSigmoidLayer, CTanhLayer>::f( layer ) )
+	{
+		return true;
+	}
+	auto batchNorm = dynamic_cast<const CBatchNormalizationLayer*>( layer );
+	if( batchNorm != nullptr ) {
+		return batchNorm->IsChannelBased()
+			&& const_cast<CBatchNormalizationLayer*>( batchNorm )->GetFinalParams() != nullptr;
+	}
+	auto convWithEpilogue = dynamic_cast<const CConvWithEpilogueLayer*>( layer );
+	if( convWithEpilogue != nullptr ) {
+		return !convWithEpilogue->Residual() && isRowwiseActivation( convWithEpilogue->Activation() );
+	}
+	return false;
 }
 
-static CPtr<IRowwiseOperation> createRowwiseOp( const CBaseLayer* layer )
+// Linear( 1, 0 ) activation does nothing
+static bool isTrivialActivation( const CActivationDesc& activation )
+{
+	return activation.GetType() == AF_Linear
+		&& activation.GetParam<CLinearActivationParam>().Multiplier == 1.f
+		&& activation.GetParam<CLinearActivationParam>().FreeTerm == 0.f;
+}
+
+// Adds the operations equivalent to the layer to the end of the chain
+static void addRowwiseOps( CBaseLayer* layer, CRowwiseOperationChainLayer& chain )
 {
 	auto channelwiseWith1x1 = dynamic_cast<const CChannelwiseWith1x1Layer*>( layer );
 	if( channelwiseWith1x1 != nullptr ) {
-		return new CRowwiseChWith1x1( *channelwiseWith1x1 );
+		chain.AddOperation( new CRowwiseChWith1x1( *channelwiseWith1x1 ) );
+		return;
 	}
 	auto conv = dynamic_cast<const CConvLayer*>( layer );
 	if( conv != nullptr ) {
-		return new CRowwiseConv( *conv );
+		chain.AddOperation( new CRowwiseConv( *conv ) );
+		return;
+	}
+	auto convWithEpilogue = dynamic_cast<const CConvWithEpilogueLayer*>( layer );
+	if( convWithEpilogue != nullptr ) {
+		// conv -> activation -> sum with the chain input
+		chain.AddOperation( new CRowwiseConv( *convWithEpilogue ) );
+		if( !isTrivialActivation( convWithEpilogue->Activation() ) ) {
+			chain.AddOperation( new CRowwiseActivation( layer->MathEngine(), convWithEpilogue->Activation() ) );
+		}
+		if( convWithEpilogue->Residual() ) {
+			chain.AddOperation( new CRowwiseEltwiseSum( layer->MathEngine() ) );
+		}
+		return;
 	}
 	auto chConv = dynamic_cast<const CChannelwiseConvLayer*>( layer );
 	if( chConv != nullptr ) {
-		return new CRowwiseChConv( *chConv );
+		chain.AddOperation( new CRowwiseChConv( *chConv ) );
+		return;
 	}
 	auto imageResize = dynamic_cast<const CImageResizeLayer*>( layer );
 	if( imageResize != nullptr ) {
-		return new CRowwiseImageResize( *imageResize );
+		chain.AddOperation( new CRowwiseImageResize( *imageResize ) );
+		return;
 	}
 	auto maxPooling = dynamic_cast<const CMaxPoolingLayer*>( layer );
 	if( maxPooling != nullptr ) {
-		return new CRowwise2DPooling( *maxPooling );
+		chain.AddOperation( new CRowwise2DPooling( *maxPooling ) );
+		return;
 	}
 	auto meanPooling = dynamic_cast<const CMeanPoolingLayer*>( layer );
 	if( meanPooling != nullptr ) {
-		return new CRowwise2DPooling( *meanPooling );
+		chain.AddOperation( new CRowwise2DPooling( *meanPooling ) );
+		return;
+	}
+	auto batchNorm = dynamic_cast<CBatchNormalizationLayer*>( layer );
+	if( batchNorm != nullptr ) {
+		chain.AddOperation( new CRowwiseBatchNormalization( *batchNorm ) );
+		return;
 	}
 	if( IsOneOf<CELULayer, CHardSigmoidLayer, CHardTanhLayer, CHSwishLayer, CLeakyReLULayer, CLinearLayer,
 		CReLULayer, CSigmoidLayer, CTanhLayer>::f( layer ) )
 	{
-		return new CRowwiseActivation( layer->MathEngine(),
-			dynamic_cast<const IActivationLayer*>( layer )->GetDesc() );
+		chain.AddOperation( new CRowwiseActivation( layer->MathEngine(),
+			dynamic_cast<const IActivationLayer*>( layer )->GetDesc() ) );
+		return;
 	}
 	auto mobileNetV2 = dynamic_cast<const CMobileNetV2BlockLayer*>( layer );
 	if( mobileNetV2 != nullptr ) {
-		return new CRowwiseMobileNetV2( *mobileNetV2 );
+		chain.AddOperation( new CRowwiseMobileNetV2( *mobileNetV2 ) );
+		return;
 	}
 	NeoAssert( false );
-	return nullptr;
 }
 
-void OptimizeRowwiseChains( CDnn& dnn, CArray<int>& chains )
+// The eltwise sum operation adds the input of the chain
+// That's why no operations can be added to the beginning of the chain containing it
+static bool hasRowwiseSum( const CRowwiseOperationChainLayer& chain )
+{
+	for( int i = 0; i < chain.OperationCount(); ++i ) {
+		if( dynamic_cast<const CRowwiseEltwiseSum*>( chain.GetOperation( i ) ) != nullptr ) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// Tries to add the layer with the saved branch (2-input eltwise sum or convolution with residual) to the chain
+//     -+--> chain --> [conv with residual] or [sum] -->
+//      |                 |
+//      +-----------------+
+// The saved branch must be the input of the chain and the chain output must be used only by this layer
+static bool mergeSavedBranchLayer( CDnn& dnn, optimization::CGraph& graph, CBaseLayer& layer )
+{
+	auto convWithEpilogue = dynamic_cast<CConvWithEpilogueLayer*>( &layer );
+	const bool isSum = dynamic_cast<CEltwiseSumLayer*>( &layer ) != nullptr;
+	if( ( convWithEpilogue == nullptr && !isSum ) || graph.GetInputCount( layer ) != 2 ) {
+		return false;
+	}
+	if( convWithEpilogue != nullptr
+		&& ( !convWithEpilogue->Residual() || !isRowwiseActivation( convWithEpilogue->Activation() ) ) )
+	{
+		return false;
+	}
+
+	// The convolution has the residual connected to the second input
+	// the sum may have the chain connected to any of its inputs
+	for( int mainInput = 0; mainInput < ( isSum ? 2 : 1 ); ++mainInput ) {
+		optimization::CLayerOutput<> main = graph.GetConnectedOutput( layer, mainInput );
+		optimization::CLayerOutput<> savedBranch = graph.GetConnectedOutput( layer, 1 - mainInput );
+		if( !isChainLayer( main.Layer ) || graph.GetInputCount( *main.Layer ) != 1
+			|| graph.GetConnectedInputsCount( *main.Layer, 0 ) != 1
+			|| graph.GetConnectedOutput( *main.Layer, 0 ) != savedBranch )
+		{
+			continue;
+		}
+
+		CRowwiseOperationChainLayer* chain = dynamic_cast<CRowwiseOperationChainLayer*>( main.Layer );
+		graph.ClearSelection();
+		if( isSum ) {
+			chain->AddOperation( new CRowwiseEltwiseSum( dnn.GetMathEngine() ) );
+		} else {
+			addRowwiseOps( &layer, *chain );
+		}
+		graph.SwitchOutputs( layer, 0, *chain, 0 );
+		graph.SelectLayer( layer );
+		graph.DeleteSelectedLayers();
+		return true;
+	}
+	return false;
+}
+
+void OptimizeRowwiseChains( CDnn& dnn, CArray<int>& chains, int threadCount )
 {
 	chains.DeleteAll();
 	optimization::CGraph graph( dnn );
@@ -202,15 +332,15 @@ void OptimizeRowwiseChains( CDnn& dnn, CArray<int>& chains )
 			CBaseLayer* prevLayer = graph.SelectTheOnlyConnectedOutput<CBaseLayer>( *layer, true );
 			if( isChainLayer( prevLayer ) ) {
 				// Append current op to an existing chain
-				dynamic_cast<CRowwiseOperationChainLayer*>( prevLayer )->AddOperation( createRowwiseOp( layer ) );
+				addRowwiseOps( layer, *dynamic_cast<CRowwiseOperationChainLayer*>( prevLayer ) );
 				graph.SwitchOutputs( *layer, 0, *prevLayer, 0 );
 				graph.DeleteLayer( *layer );
 			} else if( isRowwiseOpLayer( prevLayer ) ) {
 				// Merge 2 rowwise ops into chain
 				CPtr<CRowwiseOperationChainLayer> chainLayer = new CRowwiseOperationChainLayer( dnn.GetMathEngine() );
 				chainLayer->SetName( graph.GetUniqueName( "RowwiseChain" ) );
-				chainLayer->AddOperation( createRowwiseOp( prevLayer ) );
-				chainLayer->AddOperation( createRowwiseOp( layer ) );
+				addRowwiseOps( prevLayer, *chainLayer );
+				addRowwiseOps( layer, *chainLayer );
 				graph.AddLayer( *chainLayer );
 				optimization::CLayerOutput<> chainInput = graph.GetConnectedOutput( *prevLayer, 0 );
 				graph.Connect( *chainLayer, 0, *chainInput.Layer, chainInput.Index );
@@ -219,6 +349,9 @@ void OptimizeRowwiseChains( CDnn& dnn, CArray<int>& chains )
 			}
 		} else if( isChainLayer( layer ) ) {
 			CRowwiseOperationChainLayer* currChain = dynamic_cast<CRowwiseOperationChainLayer*>( layer );
+			if( hasRowwiseSum( *currChain ) ) {
+				continue;
+			}
 			CBaseLayer* prevLayer = graph.SelectTheOnlyConnectedOutput<CBaseLayer>( *layer, true );
 			if( isChainLayer( prevLayer ) ) {
 				// Move operations from currChain into prevChain and delete currChain
@@ -232,7 +365,7 @@ void OptimizeRowwiseChains( CDnn& dnn, CArray<int>& chains )
 				// Create new chain which starts with operation from prevLayer and then does all the ops from currChain
 				CPtr<CRowwiseOperationChainLayer> newChain = new CRowwiseOperationChainLayer( dnn.GetMathEngine() );
 				newChain->SetName( graph.GetUniqueName( "RowwiseChain" ) );
-				newChain->AddOperation( createRowwiseOp( prevLayer ) );
+				addRowwiseOps( prevLayer, *newChain );
 				for( int i = 0; i < currChain->OperationCount(); ++i ) {
 					newChain->AddOperation( currChain->GetOperation( i ) );
 				}
@@ -242,6 +375,8 @@ void OptimizeRowwiseChains( CDnn& dnn, CArray<int>& chains )
 				graph.SwitchOutputs( *currChain, 0, *newChain, 0 );
 				graph.DeleteSelectedLayers();
 			}
+		} else {
+			( void ) mergeSavedBranchLayer( dnn, graph, *layer );
 		}
 	}
 
@@ -250,7 +385,9 @@ void OptimizeRowwiseChains( CDnn& dnn, CArray<int>& chains )
 	graph.GetLayers( layers );
 	for( CBaseLayer* layer : layers ) {
 		if( isChainLayer( layer ) ) {
-			chains.Add( dynamic_cast<const CRowwiseOperationChainLayer*>( layer )->OperationCount() );
+			CRowwiseOperationChainLayer* chain = dynamic_cast<CRowwiseOperationChainLayer*>( layer );
+			chain->SetThreadCount( threadCount );
+			chains.Add( chain->OperationCount() );
 		}
 	}
 }
@@ -0,0 +1,299 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#include <common.h>
+#pragma hdrstop
+
+#include <NeoML/Dnn/Layers/SparseWeightsLayers.h>
+#include <NeoML/Dnn/Layers/EpilogueLayers.h>
+#include "MobileNetBlockUtils.h"
+
+namespace NeoML {
+
+float GetBlobSparsity( const CDnnBlob& blob )
+{
+	NeoAssert( blob.GetDataType() == CT_Float );
+	const int size = blob.GetDataSize();
+	CArray<float> data;
+	data.SetSize( size );
+	blob.CopyTo( data.GetPtr() );
+
+	int zeroCount = 0;
+	for( int i = 0; i < size; ++i ) {
+		if( data[i] == 0.f ) {
+			++zeroCount;
+		}
+	}
+	return size == 0 ? 0.f : static_cast<float>( zeroCount ) / size;
+}
+
+// Returns the pointer to the residual data or nullptr if the layer has no residual connection
+static const CConstFloatHandle* sparseWeightsResidual( const CObjectArray<CDnnBlob>& inputBlobs, bool residual,
+	CConstFloatHandle& residualData )
+{
+	if( !residual ) {
+		return nullptr;
+	}
+	residualData = inputBlobs[1]->GetData();
+	return &residualData;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+CSparseConvLayer::CSparseConvLayer( IMathEngine& mathEngine, const CPtr<CDnnBlob>& filter,
+		const CPtr<CDnnBlob>& freeTerm, int paddingHeight, int paddingWidth, int strideHeight, int strideWidth,
+		int dilationHeight, int dilationWidth, const CActivationDesc& activation, bool residual ) :
+	CBaseLayer( mathEngine, "SparseConv", false ),
+	paddingHeight( paddingHeight ),
+	paddingWidth( paddingWidth ),
+	strideHeight( strideHeight ),
+	strideWidth( strideWidth ),
+	dilationHeight( dilationHeight ),
+	dilationWidth( dilationWidth ),
+	activation( activation ),
+	residual( residual )
+{
+	NeoAssert( IsValidEpilogueActivation( activation ) );
+	paramBlobs.SetSize( P_Count );
+	paramBlobs[P_Filter] = MobileNetParam( filter );
+	paramBlobs[P_FreeTerm] = MobileNetFreeTerm( freeTerm );
+}
+
+CSparseConvLayer::CSparseConvLayer( IMathEngine& mathEngine ) :
+	CBaseLayer( mathEngine, "SparseConv", false ),
+	paddingHeight( 0 ),
+	paddingWidth( 0 ),
+	strideHeight( 1 ),
+	strideWidth( 1 ),
+	dilationHeight( 1 ),
+	dilationWidth( 1 ),
+	activation( AF_Linear ),
+	residual( false )
+{
+	paramBlobs.SetSize( P_Count );
+}
+
+CSparseConvLayer::~CSparseConvLayer()
+{
+	destroyDescs();
+}
+
+CPtr<CDnnBlob> CSparseConvLayer::Filter() const
+{
+	return MobileNetParam( paramBlobs[P_Filter] );
+}
+
+CPtr<CDnnBlob> CSparseConvLayer::FreeTerm() const
+{
+	return MobileNetParam( paramBlobs[P_FreeTerm] );
+}
+
+static const int SparseConvLayerVersion = 0;
+
+void CSparseConvLayer::Serialize( CArchive& archive )
+{
+	archive.SerializeVersion( SparseConvLayerVersion );
+	CBaseLayer::Serialize( archive );
+
+	archive.Serialize( paddingHeight );
+	archive.Serialize( paddingWidth );
+	archive.Serialize( strideHeight );
+	archive.Serialize( strideWidth );
+	archive.Serialize( dilationHeight );
+	archive.Serialize( dilationWidth );
+	archive.Serialize( residual );
+
+	if( archive.IsLoading() ) {
+		activation = LoadActivationDesc( archive );
+		check( IsValidEpilogueActivation( activation ), ERR_BAD_ARCHIVE, archive.Name() );
+	} else {
+		StoreActivationDesc( activation, archive );
+	}
+}
+
+void CSparseConvLayer::Reshape()
+{
+	CheckInputs();
+	CheckLayerArchitecture( GetInputCount() == ( residual ? 2 : 1 ), "wrong number of inputs" );
+	CheckLayerArchitecture( GetOutputCount() == 1, "sparse conv must have 1 output" );
+	CheckLayerArchitecture( inputDescs[0].GetDataType() == CT_Float, "input must be float" );
+
+	NeoAssert( paramBlobs[P_Filter] != nullptr );
+	const CDnnBlob& filter = *paramBlobs[P_Filter];
+	CheckLayerArchitecture( filter.GetDepth() == inputDescs[0].Depth()
+		&& filter.GetChannelsCount() == inputDescs[0].Channels(), "filter size mismatch" );
+	CheckLayerArchitecture( paddingHeight < filter.GetHeight() * dilationHeight
+		&& paddingWidth < filter.GetWidth() * dilationWidth, "padding is more or equal to receptive field size" );
+	CheckLayerArchitecture( filter.GetHeight() <= inputDescs[0].Height() + 2 * paddingHeight
+		&& filter.GetWidth() <= inputDescs[0].Width() + 2 * paddingWidth, "filter is bigger than input" );
+	if( paramBlobs[P_FreeTerm] != nullptr ) {
+		CheckLayerArchitecture( paramBlobs[P_FreeTerm]->GetDataSize() == filter.GetObjectCount(),
+			"number of free members in convolution is not equal to number of filters" );
+	}
+
+	outputDescs[0] = inputDescs[0];
+	outputDescs[0].SetDimSize( BD_Height, 1 + ( inputDescs[0].Height() - ( filter.GetHeight() - 1 ) * dilationHeight
+		+ 2 * paddingHeight - 1 ) / strideHeight );
+	outputDescs[0].SetDimSize( BD_Width, 1 + ( inputDescs[0].Width() - ( filter.GetWidth() - 1 ) * dilationWidth
+		+ 2 * paddingWidth - 1 ) / strideWidth );
+	outputDescs[0].SetDimSize( BD_Depth, 1 );
+	outputDescs[0].SetDimSize( BD_Channels, filter.GetObjectCount() );
+
+	if( residual ) {
+		CheckLayerArchitecture( inputDescs[1].HasEqualDimensions( outputDescs[0] ),
+			"residual size mismatch" );
+	}
+
+	destroyDescs();
+	convDesc = MathEngine().InitBlobConvolution( inputDescs[0], paddingHeight, paddingWidth,
+		strideHeight, strideWidth, dilationHeight, dilationWidth, filter.GetDesc(), outputDescs[0] );
+	filterDesc = MathEngine().InitSparseWeights( filter.GetObjectCount(), filter.GetObjectSize(), filter.GetData() );
+}
+
+void CSparseConvLayer::RunOnce()
+{
+	NeoPresume( convDesc != nullptr );
+	NeoPresume( filterDesc != nullptr );
+
+	CConstFloatHandle freeTermData;
+	if( paramBlobs[P_FreeTerm] != nullptr ) {
+		freeTermData = paramBlobs[P_FreeTerm]->GetData();
+	}
+	CConstFloatHandle residualData;
+	MathEngine().BlobConvolutionWithSparseFilter( *convDesc, inputBlobs[0]->GetData(), *filterDesc,
+		freeTermData.IsNull() ? nullptr : &freeTermData, activation,
+		sparseWeightsResidual( inputBlobs, residual, residualData ), outputBlobs[0]->GetData() );
+}
+
+void CSparseConvLayer::destroyDescs()
+{
+	if( convDesc != nullptr ) {
+		delete convDesc;
+		convDesc = nullptr;
+	}
+	if( filterDesc != nullptr ) {
+		delete filterDesc;
+		filterDesc = nullptr;
+	}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+CSparseFullyConnectedLayer::CSparseFullyConnectedLayer( IMathEngine& mathEngine, const CPtr<CDnnBlob>& weights,
+		const CPtr<CDnnBlob>& freeTerm, const CActivationDesc& activation, bool residual ) :
+	CBaseLayer( mathEngine, "SparseFullyConnected", false ),
+	activation( activation ),
+	residual( residual )
+{
+	NeoAssert( IsValidEpilogueActivation( activation ) );
+	paramBlobs.SetSize( P_Count );
+	paramBlobs[P_Weights] = MobileNetParam( weights );
+	paramBlobs[P_FreeTerm] = MobileNetFreeTerm( freeTerm );
+}
+
+CSparseFullyConnectedLayer::CSparseFullyConnectedLayer( IMathEngine& mathEngine ) :
+	CBaseLayer( mathEngine, "SparseFullyConnected", false ),
+	activation( AF_Linear ),
+	residual( false )
+{
+	paramBlobs.SetSize( P_Count );
+}
+
+CSparseFullyConnectedLayer::~CSparseFullyConnectedLayer()
+{
+	destroyWeightsDesc();
+}
+
+CPtr<CDnnBlob> CSparseFullyConnectedLayer::Weights() const
+{
+	return MobileNetParam( paramBlobs[P_Weights] );
+}
+
+CPtr<CDnnBlob> CSparseFullyConnectedLayer::FreeTerm() const
+{
+	return MobileNetParam( paramBlobs[P_FreeTerm] );
+}
+
+static const int SparseFullyConnectedLayerVersion = 0;
+
+void CSparseFullyConnectedLayer::Serialize( CArchive& archive )
+{
+	archive.SerializeVersion( SparseFullyConnectedLayerVersion );
+	CBaseLayer::Serialize( archive );
+
+	archive.Serialize( residual );
+
+	if( archive.IsLoading() ) {
+		activation = LoadActivationDesc( archive );
+		check( IsValidEpilogueActivation( activation ), ERR_BAD_ARCHIVE, archive.Name() );
+	} else {
+		StoreActivationDesc( activation, archive );
+	}
+}
+
+void CSparseFullyConnectedLayer::Reshape()
+{
+	CheckInputs();
+	CheckLayerArchitecture( GetInputCount() == ( residual ? 2 : 1 ), "wrong number of inputs" );
+	CheckLayerArchitecture( GetOutputCount() == 1, "sparse fully connected must have 1 output" );
+	CheckLayerArchitecture( inputDescs[0].GetDataType() == CT_Float, "input must be float" );
+
+	NeoAssert( paramBlobs[P_Weights] != nullptr );
+	const CDnnBlob& weights = *paramBlobs[P_Weights];
+	const int numberOfElements = weights.GetObjectCount();
+	CheckLayerArchitecture( weights.GetObjectSize() == inputDescs[0].ObjectSize(), "weights size mismatch" );
+	if( paramBlobs[P_FreeTerm] != nullptr ) {
+		CheckLayerArchitecture( paramBlobs[P_FreeTerm]->GetDataSize() == numberOfElements,
+			"free terms num is not equal to number of elements" );
+	}
+
+	outputDescs[0] = inputDescs[0];
+	outputDescs[0].SetDimSize( BD_Height, 1 );
+	outputDescs[0].SetDimSize( BD_Width, 1 );
+	outputDescs[0].SetDimSize( BD_Depth, 1 );
+	outputDescs[0].SetDimSize( BD_Channels, numberOfElements );
+
+	if( residual ) {
+		CheckLayerArchitecture( inputDescs[1].HasEqualDimensions( outputDescs[0] ),
+			"residual size mismatch" );
+	}
+
+	destroyWeightsDesc();
+	weightsDesc = MathEngine().InitSparseWeights( numberOfElements, weights.GetObjectSize(), weights.GetData() );
+}
+
+void CSparseFullyConnectedLayer::RunOnce()
+{
+	NeoPresume( weightsDesc != nullptr );
+
+	CConstFloatHandle freeTermData;
+	if( paramBlobs[P_FreeTerm] != nullptr ) {
+		freeTermData = paramBlobs[P_FreeTerm]->GetData();
+	}
+	CConstFloatHandle residualData;
+	MathEngine().MultiplyMatrixBySparseWeightsWithEpilogue( inputBlobs[0]->GetData(),
+		inputBlobs[0]->GetObjectCount(), *weightsDesc, freeTermData.IsNull() ? nullptr : &freeTermData, activation,
+		sparseWeightsResidual( inputBlobs, residual, residualData ), outputBlobs[0]->GetData() );
+}
+
+void CSparseFullyConnectedLayer::destroyWeightsDesc()
+{
+	if( weightsDesc != nullptr ) {
+		delete weightsDesc;
+		weightsDesc = nullptr;
+	}
+}
+
+} // namespace NeoML
@@ -32,6 +32,7 @@ static const char* const dropoutFc1Name = "DropoutFc1";
 static const char* const fc2Name = "FullyConnected2";
 static const char* const dropoutFc2Name = "DropoutFc2";
 static const char* const feedForwardSumName = "FeedForwardSum";
+static const char* const feedForwardNormName = "FeedForwardNorm";
 
 static CPtr<CDropoutLayer> getOptionalDropout( CDnnLayerGraph& dnn, const char* name )
 {
@@ -79,10 +80,11 @@ void CTransformerEncoderLayer::Serialize( CArchive& archive )
 	if( archive.IsLoading() ) {
 		selfAttention = CheckCast<CMultiheadAttentionLayer>( GetLayer( selfAttentionName ) );
 		dropoutSelfAttention = getOptionalDropout( *this, dropoutSelfAttentionName );
-		selfAttentionSum = CheckCast<CEltwiseSumLayer>( GetLayer( selfAttentionSumName ) );
+		// The residual sums may be fused into the normalizations
+		selfAttentionSum = GetLayer( HasLayer( selfAttentionSumName ) ? selfAttentionSumName : selfAttentionNormName );
 		dropoutFc1 = getOptionalDropout( *this, dropoutFc1Name );
 		dropoutFc2 = getOptionalDropout( *this, dropoutFc2Name );
-		feedForwardSum = CheckCast<CEltwiseSumLayer>( GetLayer( feedForwardSumName ) );
+		feedForwardSum = GetLayer( HasLayer( feedForwardSumName ) ? feedForwardSumName : feedForwardNormName );
 		if( version == 1 ) {
 			archive.Serialize( preNorm );
 		} else {
@@ -257,12 +259,7 @@ void CTransformerEncoderLayer::buildLayer()
 	selfAttention->SetOutputSize( 1 );
 	AddLayer( *selfAttention );
 
-	// Sum attention result with the original input
-	selfAttentionSum = FINE_DEBUG_NEW CEltwiseSumLayer( MathEngine() );
-	selfAttentionSum->SetName( selfAttentionSumName );
-	AddLayer( *selfAttentionSum );
-
-	// Normalize the sum
+	// Normalize the sum of the attention result and the original input (or the original input if preNorm)
 	CPtr<CObjectNormalizationLayer> selfAttentionNorm = FINE_DEBUG_NEW CObjectNormalizationLayer( MathEngine() );
 	selfAttentionNorm->SetName( selfAttentionNormName );
 	AddLayer( *selfAttentionNorm );
@@ -284,15 +281,12 @@ void CTransformerEncoderLayer::buildLayer()
 	CheckCast<CFullyConnectedLayer>( fc2 )->SetNumberOfElements( 1 );
 	AddLayer( *fc2 );
 
-	// Sum normalized attention with the feed-forward result
-	feedForwardSum = FINE_DEBUG_NEW CEltwiseSumLayer( MathEngine() );
-	feedForwardSum->SetName( feedForwardSumName );
-	AddLayer( *feedForwardSum );
-
-	// Normalize output
+	// Normalize the sum of the feed-forward result and its input
+	// The normalization with 2 inputs adds the residual itself in the same pass
 	CPtr<CObjectNormalizationLayer> feedForwardNorm = FINE_DEBUG_NEW CObjectNormalizationLayer( MathEngine() );
-	feedForwardNorm->SetName( "FeedForwardNorm" );
+	feedForwardNorm->SetName( feedForwardNormName );
 	AddLayer( *feedForwardNorm );
+	feedForwardSum = feedForwardNorm;
 
 	CBaseLayer* feedForwardInput = nullptr;
 	if( preNorm ) {
@@ -302,6 +296,12 @@ void CTransformerEncoderLayer::buildLayer()
 		selfAttention->Connect( 1, *selfAttentionNorm );
 		selfAttention->Connect( 2, *selfAttentionNorm );
 
+		// Sum attention result with the original input
+		// The sum is used twice so it can't be fused with the normalization
+		selfAttentionSum = FINE_DEBUG_NEW CEltwiseSumLayer( MathEngine() );
+		selfAttentionSum->SetName( selfAttentionSumName );
+		AddLayer( *selfAttentionSum );
+
 		SetInputMapping( I_Sequence, *selfAttentionSum, 0 );
 		selfAttentionSum->Connect( 1, *selfAttention );
 
@@ -311,11 +311,10 @@ void CTransformerEncoderLayer::buildLayer()
 		SetInputMapping( I_Sequence, *selfAttention, 1 );
 		SetInputMapping( I_Sequence, *selfAttention, 2 );
 
+		selfAttentionSum = selfAttentionNorm;
 		SetInputMapping( I_Sequence, *selfAttentionSum, 0 );
 		selfAttentionSum->Connect( 1, *selfAttention );
 
-		selfAttentionNorm->Connect( *selfAttentionSum );
-
 		feedForwardInput = selfAttentionNorm;
 	}
 	fc1->Connect( *feedForwardInput );
@@ -323,7 +322,6 @@ void CTransformerEncoderLayer::buildLayer()
 	fc2->Connect( *activation );
 	feedForwardSum->Connect( 0, *fc2 );
 	feedForwardSum->Connect( 1, *feedForwardInput );
-	feedForwardNorm->Connect( *feedForwardSum );
 
 	SetOutputMapping( *feedForwardNorm );
 }
@@ -0,0 +1,92 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#include <common.h>
+#pragma hdrstop
+
+#include "BidirectionalGruOptimizer.h"
+#include <NeoML/Dnn/Optimization/Graph.h>
+#include <NeoML/Dnn/DnnOptimization.h>
+#include <NeoML/Dnn/Layers/GruLayer.h>
+
+namespace NeoML {
+
+namespace optimization {
+
+void CBidirectionalGruOptimizer::Apply( CDnnOptimizationReport& report )
+{
+	CArray<CBaseLayer*> layers;
+	graph.GetLayers( layers );
+
+	for( CBaseLayer* layer : layers ) {
+		if( !graph.HasLayer( layer ) ) {
+			// Layer has already been deleted from the graph
+			continue;
+		}
+		CGruLayer* direct = dynamic_cast<CGruLayer*>( layer );
+		if( direct == nullptr || direct->IsReverseSequence() || !isValidGru( *direct ) ) {
+			continue;
+		}
+		const CLayerOutput<> input = graph.GetConnectedOutput<>( *direct, 0 );
+
+		// Looking for the reverse GRU over the same input
+		CGruLayer* reverse = nullptr;
+		for( CBaseLayer* otherLayer : layers ) {
+			CGruLayer* gru = graph.HasLayer( otherLayer ) ? dynamic_cast<CGruLayer*>( otherLayer ) : nullptr;
+			if( gru != nullptr && gru->IsReverseSequence() && isValidGru( *gru )
+				&& graph.GetConnectedOutput<>( *gru, 0 ) == input )
+			{
+				reverse = gru;
+				break;
+			}
+		}
+		if( reverse == nullptr ) {
+			continue;
+		}
+
+		CPtr<CBidirectionalGruLayer> bidirectional = new CBidirectionalGruLayer( graph.MathEngine(),
+			*direct, *reverse );
+		bidirectional->SetName( graph.GetUniqueName( "BidirectionalGru" ) );
+		bidirectional->SetThreadCount( threadCount );
+		graph.AddLayer( *bidirectional );
+		graph.Connect( *bidirectional, 0, *input.Layer, input.Index );
+		graph.SwitchOutputs( *direct, 0, *bidirectional, 0 );
+		graph.SwitchOutputs( *reverse, 0, *bidirectional, 1 );
+
+		graph.ClearSelection();
+		graph.SelectLayer( *direct );
+		graph.SelectLayer( *reverse );
+		graph.DeleteSelectedLayers();
+		report.BidirectionalGruFusions++;
+	}
+
+	graph.ClearSelection();
+}
+
+// Checks that the GRU can be calculated by CBidirectionalGruLayer
+bool CBidirectionalGruOptimizer::isValidGru( CGruLayer& gru ) const
+{
+	if( graph.GetInputCount( gru ) != 1 || graph.GetOutputCount( gru ) != 1 || gru.GetRepeatCount() != 1 ) {
+		return false;
+	}
+	CPtr<CDnnBlob> gateWeights = gru.GetGateWeightsData();
+	CPtr<CDnnBlob> mainWeights = gru.GetMainWeightsData();
+	return gateWeights != nullptr && gateWeights->GetDataType() == CT_Float
+		&& mainWeights != nullptr && mainWeights->GetDataType() == CT_Float;
+}
+
+} // namespace optimization
+
+} // namespace NeoML
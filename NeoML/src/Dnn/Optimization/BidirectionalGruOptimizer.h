@@ -0,0 +1,54 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#pragma once
+
+namespace NeoML {
+
+// Forward declaration(s)
+class CGruLayer;
+struct CDnnOptimizationReport;
+
+namespace optimization {
+
+// Forward declaration(s)
+class CGraph;
+
+// Replaces the pairs of the direct and the reverse GRU over the same input
+//     -+--> gru ----------->
+//      |
+//      +--> reverse gru --->
+// with CBidirectionalGruLayer which calculates both directions concurrently
+class CBidirectionalGruOptimizer {
+public:
+	CBidirectionalGruOptimizer( CGraph& graph, int threadCount ) :
+		graph( graph ),
+		threadCount( threadCount )
+	{
+	}
+
+	// Optimizes the graph and writes the result to the report
+	void Apply( CDnnOptimizationReport& report );
+
+private:
+	CGraph& graph;
+	const int threadCount;
+
+	bool isValidGru( CGruLayer& gru ) const;
+};
+
+} // namespace optimization
+
+} // namespace NeoML
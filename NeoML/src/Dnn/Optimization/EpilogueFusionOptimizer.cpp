@@ -0,0 +1,173 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#include <common.h>
+#pragma hdrstop
+
+#include "EpilogueFusionOptimizer.h"
+#include <NeoML/Dnn/Optimization/Graph.h>
+#include <NeoML/Dnn/DnnOptimization.h>
+#include <NeoML/Dnn/Layers/ConvLayer.h>
+#include <NeoML/Dnn/Layers/EltwiseLayer.h>
+#include <NeoML/Dnn/Layers/EpilogueLayers.h>
+#include <NeoML/Dnn/Layers/FullyConnectedLayer.h>
+
+namespace NeoML {
+
+namespace optimization {
+
+void CEpilogueFusionOptimizer::Apply( CDnnOptimizationReport& report )
+{
+	// Step 1: fuse the blocks with the residual sum
+	fuseResidualBlocks( report );
+	// Step 2: fuse the remaining fully-connected layers with their activations
+	fuseFullyConnectedActivations( report );
+}
+
+// Replaces (conv or fc) -> activation -> sum constructions
+void CEpilogueFusionOptimizer::fuseResidualBlocks( CDnnOptimizationReport& report )
+{
+	CArray<CBaseLayer*> layers;
+	graph.GetLayers( layers );
+
+	for( CBaseLayer* layer : layers ) {
+		if( !graph.HasLayer( layer ) ) {
+			// Layer has already been deleted from the graph
+			continue;
+		}
+
+		CEltwiseSumLayer* sum = dynamic_cast<CEltwiseSumLayer*>( layer );
+		if( sum == nullptr || graph.GetInputCount( *sum ) != 2 || graph.GetOutputCount( *sum ) != 1 ) {
+			continue;
+		}
+
+		for( int i = 0; i < 2; ++i ) {
+			graph.ClearSelection();
+			graph.SelectLayer( *sum );
+
+			CBaseLayer* activation = graph.SelectConnectedOutput<>( *sum, i, true ).Layer;
+			if( activation == nullptr ) {
+				continue;
+			}
+
+			CBaseLayer* operation = nullptr;
+			CActivationDesc activationDesc( AF_Linear, CLinearLayer::CParam{ 1.f, 0.f } );
+			if( isValidActivation( *activation ) ) {
+				activationDesc = dynamic_cast<IActivationLayer*>( activation )->GetDesc();
+				operation = graph.SelectConnectedOutput<>( *activation, 0, true ).Layer;
+			} else {
+				operation = activation;
+			}
+
+			if( operation == nullptr || !isValidLayer( *operation ) ) {
+				continue;
+			}
+
+			CLayerOutput<> residual = graph.GetConnectedOutput<>( *sum, 1 - i );
+			if( graph.IsLayerSelected( *residual.Layer ) ) {
+				// Both inputs of the sum are connected to the same output
+				continue;
+			}
+
+			fuseLayer( *operation, activationDesc, *sum, residual.Layer, residual.Index, report );
+			break;
+		}
+	}
+
+	graph.ClearSelection();
+}
+
+// Replaces fc -> activation constructions
+void CEpilogueFusionOptimizer::fuseFullyConnectedActivations( CDnnOptimizationReport& report )
+{
+	CArray<CBaseLayer*> layers;
+	graph.GetLayers( layers );
+
+	for( CBaseLayer* layer : layers ) {
+		graph.ClearSelection();
+
+		if( !graph.HasLayer( layer ) || !isValidActivation( *layer ) ) {
+			continue;
+		}
+		graph.SelectLayer( *layer );
+
+		CFullyConnectedLayer* fc = graph.SelectConnectedOutput<CFullyConnectedLayer>( *layer, 0, true ).Layer;
+		if( fc == nullptr || !isValidLayer( *fc ) ) {
+			continue;
+		}
+
+		fuseLayer( *fc, dynamic_cast<IActivationLayer*>( layer )->GetDesc(), *layer, nullptr, NotFound, report );
+	}
+
+	graph.ClearSelection();
+}
+
+// Replaces the selected layers with the layer with the epilogue
+// The output of the lastLayer is replaced with the output of the new layer
+void CEpilogueFusionOptimizer::fuseLayer( CBaseLayer& layer, const CActivationDesc& activation,
+	CBaseLayer& lastLayer, CBaseLayer* residualLayer, int residualOutput, CDnnOptimizationReport& report )
+{
+	const bool hasResidual = residualLayer != nullptr;
+	CPtr<CBaseLayer> fusedLayer;
+	if( CConvLayer* conv = dynamic_cast<CConvLayer*>( &layer ) ) {
+		fusedLayer = new CConvWithEpilogueLayer( graph.MathEngine(), conv->GetFilterData(), conv->GetFreeTermData(),
+			conv->GetPaddingHeight(), conv->GetPaddingWidth(), conv->GetStrideHeight(), conv->GetStrideWidth(),
+			conv->GetDilationHeight(), conv->GetDilationWidth(), activation, hasResidual );
+		fusedLayer->SetName( graph.GetUniqueName( "ConvWithEpilogue" ) );
+		report.ConvEpilogueFusions++;
+	} else {
+		CFullyConnectedLayer* fc = dynamic_cast<CFullyConnectedLayer*>( &layer );
+		NeoAssert( fc != nullptr );
+		fusedLayer = new CFullyConnectedWithEpilogueLayer( graph.MathEngine(), fc->GetWeightsData(),
+			fc->IsZeroFreeTerm() ? nullptr : fc->GetFreeTermData(), activation, hasResidual );
+		fusedLayer->SetName( graph.GetUniqueName( "FullyConnectedWithEpilogue" ) );
+		report.FullyConnectedEpilogueFusions++;
+	}
+
+	CLayerOutput<> layerData = graph.GetConnectedOutput<>( layer, 0 );
+	graph.AddLayer( *fusedLayer );
+	graph.Connect( *fusedLayer, 0, *layerData.Layer, layerData.Index );
+	if( hasResidual ) {
+		graph.Connect( *fusedLayer, 1, *residualLayer, residualOutput );
+	}
+	graph.SwitchOutputs( lastLayer, 0, *fusedLayer, 0 );
+	graph.DeleteSelectedLayers();
+}
+
+// Checks that the layer is an activation which can be fused
+bool CEpilogueFusionOptimizer::isValidActivation( CBaseLayer& layer ) const
+{
+	IActivationLayer* activation = dynamic_cast<IActivationLayer*>( &layer );
+	return activation != nullptr && graph.GetInputCount( layer ) == 1 && graph.GetOutputCount( layer ) == 1
+		&& IsValidEpilogueActivation( activation->GetDesc() );
+}
+
+// Checks that the layer is a convolution or fully-connected layer which can be fused
+bool CEpilogueFusionOptimizer::isValidLayer( CBaseLayer& layer ) const
+{
+	if( graph.GetInputCount( layer ) != 1 || graph.GetOutputCount( layer ) != 1 ) {
+		return false;
+	}
+	CConvLayer* conv = dynamic_cast<CConvLayer*>( &layer );
+	if( conv != nullptr ) {
+		return conv->GetFilterData() != nullptr;
+	}
+	CFullyConnectedLayer* fc = dynamic_cast<CFullyConnectedLayer*>( &layer );
+	return fc != nullptr && fc->GetWeightsData() != nullptr;
+}
+
+} // namespace optimization
+
+} // namespace NeoML
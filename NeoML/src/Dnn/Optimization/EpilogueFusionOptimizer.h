@@ -0,0 +1,61 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#pragma once
+
+namespace NeoML {
+
+// Forward declaration(s)
+class CBaseLayer;
+class CActivationDesc;
+struct CDnnOptimizationReport;
+
+namespace optimization {
+
+// Forward declaration(s)
+class CGraph;
+
+// Fuses the activation and the residual sum into the preceding convolution or fully-connected layer
+//     -+--> conv or fc -> activation ----> sum ->
+//      |                                    |
+//      +--- residual -----------------------+
+// The activation is optional
+// If there is no residual sum only the fully-connected layers are fused with the activation
+// (the convolutions with activations are handled by the rowwise chains)
+class CEpilogueFusionOptimizer {
+public:
+	explicit CEpilogueFusionOptimizer( CGraph& graph ) :
+		graph( graph )
+	{
+	}
+
+	// Optimizes the graph and writes the result to the report
+	void Apply( CDnnOptimizationReport& report );
+
+private:
+	CGraph& graph;
+
+	void fuseResidualBlocks( CDnnOptimizationReport& report );
+	void fuseFullyConnectedActivations( CDnnOptimizationReport& report );
+
+	void fuseLayer( CBaseLayer& layer, const CActivationDesc& activation, CBaseLayer& lastLayer,
+		CBaseLayer* residualLayer, int residualOutput, CDnnOptimizationReport& report );
+	bool isValidActivation( CBaseLayer& layer ) const;
+	bool isValidLayer( CBaseLayer& layer ) const;
+};
+
+} // namespace optimization
+
+} // namespace NeoML
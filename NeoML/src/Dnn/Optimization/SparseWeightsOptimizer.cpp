@@ -0,0 +1,112 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#include <common.h>
+#pragma hdrstop
+
+#include "SparseWeightsOptimizer.h"
+#include <NeoML/Dnn/Optimization/Graph.h>
+#include <NeoML/Dnn/DnnOptimization.h>
+#include <NeoML/Dnn/Layers/ConvLayer.h>
+#include <NeoML/Dnn/Layers/EpilogueLayers.h>
+#include <NeoML/Dnn/Layers/FullyConnectedLayer.h>
+#include <NeoML/Dnn/Layers/SparseWeightsLayers.h>
+
+namespace NeoML {
+
+namespace optimization {
+
+void CSparseWeightsOptimizer::Apply( CDnnOptimizationReport& report )
+{
+	CArray<CBaseLayer*> layers;
+	graph.GetLayers( layers );
+
+	for( CBaseLayer* layer : layers ) {
+		if( graph.GetOutputCount( *layer ) != 1 ) {
+			continue;
+		}
+		CPtr<CBaseLayer> sparseLayer = createSparseLayer( *layer, report );
+		if( sparseLayer != nullptr ) {
+			replaceLayer( *layer, *sparseLayer );
+		}
+	}
+}
+
+// Creates the sparse analogue of the layer or returns nullptr if the layer can't be replaced
+CPtr<CBaseLayer> CSparseWeightsOptimizer::createSparseLayer( CBaseLayer& layer,
+	CDnnOptimizationReport& report ) const
+{
+	const CActivationDesc noActivation( AF_Linear, CLinearLayer::CParam{ 1.f, 0.f } );
+	const bool isSingleInput = graph.GetInputCount( layer ) == 1;
+	CPtr<CBaseLayer> sparseLayer;
+
+	if( CConvLayer* conv = dynamic_cast<CConvLayer*>( &layer ) ) {
+		if( !isSingleInput || !isSparse( conv->GetFilterData() ) ) {
+			return nullptr;
+		}
+		sparseLayer = new CSparseConvLayer( graph.MathEngine(), conv->GetFilterData(),
+			conv->IsZeroFreeTerm() ? nullptr : conv->GetFreeTermData(), conv->GetPaddingHeight(),
+			conv->GetPaddingWidth(), conv->GetStrideHeight(), conv->GetStrideWidth(), conv->GetDilationHeight(),
+			conv->GetDilationWidth(), noActivation, false );
+	} else if( CConvWithEpilogueLayer* conv = dynamic_cast<CConvWithEpilogueLayer*>( &layer ) ) {
+		if( !isSparse( conv->Filter() ) ) {
+			return nullptr;
+		}
+		sparseLayer = new CSparseConvLayer( graph.MathEngine(), conv->Filter(), conv->FreeTerm(),
+			conv->PaddingHeight(), conv->PaddingWidth(), conv->StrideHeight(), conv->StrideWidth(),
+			conv->DilationHeight(), conv->DilationWidth(), conv->Activation(), conv->Residual() );
+	} else if( CFullyConnectedLayer* fc = dynamic_cast<CFullyConnectedLayer*>( &layer ) ) {
+		if( !isSingleInput || !isSparse( fc->GetWeightsData() ) ) {
+			return nullptr;
+		}
+		sparseLayer = new CSparseFullyConnectedLayer( graph.MathEngine(), fc->GetWeightsData(),
+			fc->IsZeroFreeTerm() ? nullptr : fc->GetFreeTermData(), noActivation, false );
+	} else if( CFullyConnectedWithEpilogueLayer* fc = dynamic_cast<CFullyConnectedWithEpilogueLayer*>( &layer ) ) {
+		if( !isSparse( fc->Weights() ) ) {
+			return nullptr;
+		}
+		sparseLayer = new CSparseFullyConnectedLayer( graph.MathEngine(), fc->Weights(), fc->FreeTerm(),
+			fc->Activation(), fc->Residual() );
+	} else {
+		return nullptr;
+	}
+
+	const bool isConv = dynamic_cast<CSparseConvLayer*>( sparseLayer.Ptr() ) != nullptr;
+	sparseLayer->SetName( graph.GetUniqueName( isConv ? "SparseConv" : "SparseFullyConnected" ) );
+	( isConv ? report.SparseConvLayers : report.SparseFullyConnectedLayers )++;
+	return sparseLayer;
+}
+
+// Checks that the share of the zero weights is large enough
+bool CSparseWeightsOptimizer::isSparse( const CPtr<CDnnBlob>& weights ) const
+{
+	return weights != nullptr && GetBlobSparsity( *weights ) >= minSparsity;
+}
+
+// Replaces the layer with the sparse layer connected to the same inputs and outputs
+void CSparseWeightsOptimizer::replaceLayer( CBaseLayer& layer, CBaseLayer& sparseLayer )
+{
+	graph.AddLayer( sparseLayer );
+	for( int i = 0; i < graph.GetInputCount( layer ); ++i ) {
+		CLayerOutput<> input = graph.GetConnectedOutput<>( layer, i );
+		graph.Connect( sparseLayer, i, *input.Layer, input.Index );
+	}
+	graph.SwitchOutputs( layer, 0, sparseLayer, 0 );
+	graph.DeleteLayer( layer );
+}
+
+} // namespace optimization
+
+} // namespace NeoML
@@ -0,0 +1,56 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <NeoML/NeoMLDefs.h>
+
+namespace NeoML {
+
+// Forward declaration(s)
+class CBaseLayer;
+class CDnnBlob;
+struct CDnnOptimizationReport;
+
+namespace optimization {
+
+// Forward declaration(s)
+class CGraph;
+
+// Replaces the convolutions and the fully-connected layers (including the ones with epilogue)
+// whose share of the zero weights is at least minSparsity with CSparseConvLayer and CSparseFullyConnectedLayer
+class CSparseWeightsOptimizer {
+public:
+	CSparseWeightsOptimizer( CGraph& graph, float minSparsity ) :
+		graph( graph ),
+		minSparsity( minSparsity )
+	{
+	}
+
+	// Optimizes the graph and writes the result to the report
+	void Apply( CDnnOptimizationReport& report );
+
+private:
+	CGraph& graph;
+	const float minSparsity;
+
+	CPtr<CBaseLayer> createSparseLayer( CBaseLayer& layer, CDnnOptimizationReport& report ) const;
+	bool isSparse( const CPtr<CDnnBlob>& weights ) const;
+	void replaceLayer( CBaseLayer& layer, CBaseLayer& sparseLayer );
+};
+
+} // namespace optimization
+
+} // namespace NeoML
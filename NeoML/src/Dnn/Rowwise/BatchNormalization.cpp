@@ -0,0 +1,51 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#include <common.h>
+#pragma hdrstop
+
+#include <NeoML/Dnn/Rowwise/BatchNormalization.h>
+#include <NeoML/Dnn/Layers/BatchNormalizationLayer.h>
+
+namespace NeoML {
+
+CRowwiseBatchNormalization::CRowwiseBatchNormalization( CBatchNormalizationLayer& batchNormLayer ) :
+	mathEngine( batchNormLayer.MathEngine() ),
+	finalParams( batchNormLayer.GetFinalParams() )
+{
+	NeoAssert( batchNormLayer.IsChannelBased() );
+	NeoAssert( finalParams != nullptr );
+}
+
+CRowwiseBatchNormalization::CRowwiseBatchNormalization( IMathEngine& mathEngine ) :
+	mathEngine( mathEngine )
+{
+}
+
+CRowwiseOperationDesc* CRowwiseBatchNormalization::GetDesc()
+{
+	return mathEngine.InitRowwiseBatchNormalization( finalParams->GetObjectSize(),
+		finalParams->GetObjectData( 0 ), finalParams->GetObjectData( 1 ) );
+}
+
+void CRowwiseBatchNormalization::Serialize( CArchive& archive )
+{
+	(void) archive.SerializeVersion( 0 ); // version
+	SerializeBlob( mathEngine, archive, finalParams );
+}
+
+REGISTER_NEOML_ROWWISE_OPERATION( CRowwiseBatchNormalization, "RowwiseBatchNormalizationOperation" )
+
+} // namespace NeoML
@@ -18,6 +18,7 @@ limitations under the License.
 
 #include <NeoML/Dnn/Rowwise/Conv.h>
 #include <NeoML/Dnn/Layers/ConvLayer.h>
+#include <NeoML/Dnn/Layers/EpilogueLayers.h>
 
 namespace NeoML {
 
@@ -34,6 +35,19 @@ CRowwiseConv::CRowwiseConv( const CConvLayer& convLayer ) :
 {
 }
 
+CRowwiseConv::CRowwiseConv( const CConvWithEpilogueLayer& convLayer ) :
+	mathEngine( convLayer.MathEngine() ),
+	paddingHeight( convLayer.PaddingHeight() ),
+	paddingWidth( convLayer.PaddingWidth() ),
+	strideHeight( convLayer.StrideHeight() ),
+	strideWidth( convLayer.StrideWidth() ),
+	dilationHeight( convLayer.DilationHeight() ),
+	dilationWidth( convLayer.DilationWidth() ),
+	filter( convLayer.Filter() ),
+	freeTerm( convLayer.FreeTerm() )
+{
+}
+
 CRowwiseConv::CRowwiseConv( IMathEngine& mathEngine ) :
 	mathEngine( mathEngine ),
 	paddingHeight( 0 ),
@@ -39,15 +39,19 @@ void CBytePairEncoder::InitializeUnsafe( const CBPEDictionary& _tokens )
 		NeoAssert( !tokenToId.Has( token ) );
 		tokenToId.Add( token, tokenToId.Size() );
 	}
+	buildMergeTables();
 }
 
 void CBytePairEncoder::Decode( const CArray<int>& tokenIds, CArray<CString>& words ) const
 {
 	NeoAssert( IsInitialized() );
-	if( decoder == nullptr ) {
-		CMap<int, CString> idToToken;
-		GetIdToTokenMapping( idToToken );
-		decoder = MakeCPtrOwner<CSubwordDecoder>( params, std::move( idToToken ) );
+	{
+		CCriticalSectionLock lock( decoderSection );
+		if( decoder == nullptr ) {
+			CMap<int, CString> idToToken;
+			GetIdToTokenMapping( idToToken );
+			decoder = MakeCPtrOwner<CSubwordDecoder>( params, std::move( idToToken ) );
+		}
 	}
 	decoder->Decode( tokenIds, words );
 }
@@ -84,6 +88,7 @@ void CBytePairEncoder::Serialize( CArchive& archive )
 		for( int i = 0; i < tokens.Size(); i++ ) {
 			tokenToId.Add( tokens[i], i );
 		}
+		buildMergeTables();
 	}
 }
 
@@ -133,7 +138,7 @@ void CBytePairEncoder::Initialize( const CBPEDictionary& _tokens, const CParams&
 // Checks that token is a letter, auxiliary or a combination of 2 other tokens
 bool CBytePairEncoder::isValidToken( const CString& token, const CArray<CString>& auxTokens ) const
 {
-	const int charLength = UseRawBytes() ? 1 : GetUtf8CharLength( token[0] );
+	const int charLength = getCharLength( token );
 	if( charLength == token.Length() ) {
 		// ok, single letter
 		return true;
@@ -157,91 +162,166 @@ bool CBytePairEncoder::isValidToken( const CString& token, const CArray<CString>
 	return false;
 }
 
-void CBytePairEncoder::DoEncode( const CString& word, CArray<int>& tokenIds,
-	CArray<int>& tokenLengths ) const
+// A symbol of the word being encoded
+// The symbols form a doubly linked list, the merged symbols are removed from it
+struct CBytePairEncoder::CSymbol {
+	// Unshifted token id or NotFound for an unknown symbol
+	int Id;
+	// The length of the symbol in the original word
+	int Length;
+	int Prev;
+	int Next;
+};
+
+// A pair of adjacent symbols which may be merged
+struct CBytePairEncoder::CMergeCandidate {
+	// The rank of the merge in the high bits and the position of the left symbol in the low ones
+	int64_t Key;
+	int Left;
+	int Right;
+	// The ids of the symbols when the candidate was found
+	// The candidate is outdated if any of the symbols has been merged since then
+	int LeftId;
+	int RightId;
+	int MergedId;
+};
+
+int CBytePairEncoder::CTokenPair::HashKey() const
 {
-	NeoAssert( IsInitialized() );
-
-	CArray<CString> wordTokens;
-	CArray<int> wordTokenLengths;
-	splitWordIntoInitialTokens( word, wordTokens, &wordTokenLengths );
-
-	while( true ) {
-		int bestPairIndex = getShiftedTokenIndex( tokens.Last() ) + 1;
-		int bestMergePos = NotFound;
-		for( int i = 0; i < wordTokens.Size() - 1; i++ ) {
-			const CString pair = ( wordTokens[i] + wordTokens[i + 1] );
-			const int pairIndex = getShiftedTokenIndex( pair );
-			if( pairIndex != UnknownTokenId() && pairIndex < bestPairIndex ) {
-				bestPairIndex = pairIndex;
-				bestMergePos = i;
-			}
-		}
-
-		if( bestMergePos == NotFound ) {
-			break;
-		}
-
-		wordTokens[bestMergePos] += wordTokens[bestMergePos + 1];
-		wordTokenLengths[bestMergePos] += wordTokenLengths[bestMergePos + 1];
-
-		wordTokens.DeleteAt( bestMergePos + 1 );
-		wordTokenLengths.DeleteAt( bestMergePos + 1 );
-	}
+	int result = Left;
+	AddToHashKey( Right, result );
+	return result;
+}
 
-	NeoAssert( wordTokens.Size() == wordTokenLengths.Size() );
-	tokenIds.SetBufferSize( tokenIds.Size() + wordTokens.Size() );
-	for( int i = 0; i < wordTokens.Size(); i++ ) {
-		tokenIds.Add( getShiftedTokenIndex( wordTokens[i] ) );
+// Packs the bytes of a single character into an integer key
+static unsigned int getBpeCharKey( const char* str, int charLength )
+{
+	unsigned int key = 0;
+	for( int i = 0; i < charLength; ++i ) {
+		key = ( key << 8 ) | static_cast<unsigned char>( str[i] );
 	}
-	tokenLengths.Add( wordTokenLengths );
+	return key;
 }
 
-// Returns index of token for encoding.
-int CBytePairEncoder::getShiftedTokenIndex( const CString& token ) const
+// Fills the tables used while encoding from 'tokens' and 'tokenToId'
+void CBytePairEncoder::buildMergeTables()
 {
-	int tokenIndex = NotFound;
-	if( tokenToId.Lookup( token, tokenIndex ) ) {
-		return tokenIndex + UnknownTokenId() + 1;
-	} else {
-		// Unknown token
-		return UnknownTokenId();
+	pairToToken.DeleteAll();
+	charToId.DeleteAll();
+	pairToToken.SetHashTableSize( tokens.Size() );
+
+	for( int i = 0; i < tokens.Size(); ++i ) {
+		const CString& token = tokens[i];
+		const int charLength = getCharLength( token );
+		if( charLength == token.Length() && charLength <= static_cast<int>( sizeof( unsigned int ) ) ) {
+			charToId.Add( getBpeCharKey( token, charLength ), i );
+		}
+		// Every split of the token into two known tokens leads to the same merge
+		for( int j = 1; j < token.Length(); ++j ) {
+			int leftId = NotFound;
+			int rightId = NotFound;
+			if( tokenToId.Lookup( token.Mid( 0, j ), leftId ) && tokenToId.Lookup( token.Mid( j, token.Length() - j ), rightId ) ) {
+				pairToToken.Add( CTokenPair{ leftId, rightId }, i );
+			}
+		}
 	}
 }
 
-// Splits a word into initial tokens: single unicode characters + special tokens (optional).
-void CBytePairEncoder::splitWordIntoInitialTokens( const CString& word,
-	CArray<CString>& initialTokens, CArray<int>* initialTokensLength ) const
+void CBytePairEncoder::DoEncode( const CString& word, CArray<int>& tokenIds,
+	CArray<int>& tokenLengths ) const
 {
+	NeoAssert( IsInitialized() );
 	NeoAssert( !word.IsEmpty() );
 
-	initialTokens.SetBufferSize( word.Length() + 2 );
+	// Split the word into initial symbols: single characters + special tokens (optional)
+	CFastArray<CSymbol, 32> symbols;
 	if( UseStartOfWordToken() ) {
-		initialTokens.Add( params.StartOfWordToken );
+		symbols.Add( CSymbol{ getAuxTokenId( params.StartOfWordToken ), 0, NotFound, NotFound } );
 	}
-
 	for( int curPos = 0; curPos < word.Length(); ) {
-		const int charLength = UseRawBytes() ? 1 : GetUtf8CharLength( word[curPos] );
+		const int charLength = getCharLength( static_cast<const char*>( word ) + curPos );
 		NeoAssert( charLength > 0 );
 		NeoAssert( curPos + charLength <= word.Length() );
-		initialTokens.Add( CString( (const char*)word + curPos, charLength ) );
+		symbols.Add( CSymbol{ getCharTokenId( static_cast<const char*>( word ) + curPos, charLength ),
+			1, NotFound, NotFound } );
 		curPos += charLength;
 	}
-
 	if( UseEndOfWordToken() ) {
-		initialTokens.Add( params.EndOfWordToken );
+		symbols.Add( CSymbol{ getAuxTokenId( params.EndOfWordToken ), 0, NotFound, NotFound } );
+	}
+	for( int i = 0; i < symbols.Size(); ++i ) {
+		symbols[i].Prev = i - 1;
+		symbols[i].Next = i + 1 < symbols.Size() ? i + 1 : NotFound;
 	}
 
-	if( initialTokensLength != nullptr ) {
-		NeoAssert( initialTokensLength->IsEmpty() );
-		initialTokensLength->Add( 1, initialTokens.Size() );
-		if( UseStartOfWordToken() ) {
-			initialTokensLength->First() = 0;
+	// The pairs with the lowest rank are merged first, the leftmost one among the equal
+	CPriorityQueue<CFastArray<CMergeCandidate, 32>,
+		DescendingByMember<CMergeCandidate, int64_t, &CMergeCandidate::Key>> queue;
+	auto addCandidate = [&]( int left, int right ) {
+		if( left == NotFound || right == NotFound
+			|| symbols[left].Id == NotFound || symbols[right].Id == NotFound )
+		{
+			return;
 		}
-		if( UseEndOfWordToken() ) {
-			initialTokensLength->Last() = 0;
+		int mergedId = NotFound;
+		if( pairToToken.Lookup( CTokenPair{ symbols[left].Id, symbols[right].Id }, mergedId ) ) {
+			queue.Push( CMergeCandidate{ ( static_cast<int64_t>( mergedId ) << 32 ) | left,
+				left, right, symbols[left].Id, symbols[right].Id, mergedId } );
 		}
+	};
+	for( int i = 0; i < symbols.Size() - 1; ++i ) {
+		addCandidate( i, i + 1 );
+	}
+
+	CMergeCandidate candidate;
+	while( queue.Pop( candidate ) ) {
+		CSymbol& left = symbols[candidate.Left];
+		CSymbol& right = symbols[candidate.Right];
+		if( left.Next != candidate.Right || left.Id != candidate.LeftId || right.Id != candidate.RightId ) {
+			continue;
+		}
+
+		left.Id = candidate.MergedId;
+		left.Length += right.Length;
+		left.Next = right.Next;
+		if( right.Next != NotFound ) {
+			symbols[right.Next].Prev = candidate.Left;
+		}
+		right.Next = NotFound;
+
+		addCandidate( left.Prev, candidate.Left );
+		addCandidate( candidate.Left, left.Next );
+	}
+
+	for( int i = 0; i != NotFound; i = symbols[i].Next ) {
+		const CSymbol& symbol = symbols[i];
+		tokenIds.Add( symbol.Id == NotFound ? UnknownTokenId() : symbol.Id + UnknownTokenId() + 1 );
+		tokenLengths.Add( symbol.Length );
 	}
 }
 
+// Returns the length of the character the string starts with
+int CBytePairEncoder::getCharLength( const char* str ) const
+{
+	return UseRawBytes() ? 1 : GetUtf8CharLength( str[0] );
+}
+
+// Returns unshifted id of the single character token or NotFound
+int CBytePairEncoder::getCharTokenId( const char* str, int charLength ) const
+{
+	int tokenId = NotFound;
+	if( charLength <= static_cast<int>( sizeof( unsigned int ) ) ) {
+		charToId.Lookup( getBpeCharKey( str, charLength ), tokenId );
+	}
+	return tokenId;
+}
+
+// Returns unshifted id of the start-of-word or end-of-word token
+int CBytePairEncoder::getAuxTokenId( const CString& token ) const
+{
+	int tokenId = NotFound;
+	tokenToId.Lookup( token, tokenId );
+	return tokenId;
+}
+
 } // namespace NeoML
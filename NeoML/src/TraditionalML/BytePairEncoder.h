@@ -54,19 +54,37 @@ protected:
 	void DoEncode( const CString& word, CArray<int>& tokenIds, CArray<int>& tokenLengths ) const override;
 
 private:
+	// A pair of adjacent tokens (unshifted ids)
+	struct CTokenPair {
+		int Left;
+		int Right;
+
+		int HashKey() const;
+		bool operator==( const CTokenPair& other ) const { return Left == other.Left && Right == other.Right; }
+	};
+	struct CSymbol;
+	struct CMergeCandidate;
+
 	// Index map Id -> Token. Note that the ids are being shifted by UnknownTokenId() + 1 while encoding.
 	CBPEDictionary tokens;
 	// Reverse Map: Token -> Id. It is an unshifted index (matches 'tokens' array).
 	CMap<CString, int> tokenToId;
+	// Merge table: pair of tokens -> the token made of them (unshifted ids).
+	// The id of the merged token is also its rank: the pair with the lowest rank is merged first.
+	CMap<CTokenPair, int> pairToToken;
+	// Single characters -> unshifted ids. The key is made of the bytes of the character.
+	CMap<unsigned int, int> charToId;
 	// Encoder parameters
 	CParams params;
 	// Lazy-initialized mechanism for Decode() function
 	mutable CPtrOwner<CSubwordDecoder> decoder;
+	mutable CCriticalSection decoderSection;
 
 	bool isValidToken( const CString& token, const CArray<CString>& auxTokens ) const;
-	int getShiftedTokenIndex( const CString& token ) const;
-	void splitWordIntoInitialTokens( const CString& word, 
-		CArray<CString>& initialTokens, CArray<int>* initialTokensLength = nullptr ) const;
+	void buildMergeTables();
+	int getCharLength( const char* str ) const;
+	int getCharTokenId( const char* str, int charLength ) const;
+	int getAuxTokenId( const CString& token ) const;
 };
 
 } // namespace NeoML
@@ -0,0 +1,362 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#include <common.h>
+#pragma hdrstop
+
+#include <NeoML/TraditionalML/Calibration.h>
+#include <NeoML/Dnn/DnnBlob.h>
+#include <NeoMathEngine/ThreadPool.h>
+
+namespace NeoML {
+
+// The sums over the vectors for the likelihood function of Platt method
+struct CPlattSums {
+	double Value = 0;
+	double Gradient0 = 0;
+	double Gradient1 = 0;
+	double Hessian00 = 0;
+	double Hessian10 = 0;
+	double Hessian11 = 0;
+
+	void Add( const CPlattSums& other );
+};
+
+void CPlattSums::Add( const CPlattSums& other )
+{
+	Value += other.Value;
+	Gradient0 += other.Gradient0;
+	Gradient1 += other.Gradient1;
+	Hessian00 += other.Hessian00;
+	Hessian10 += other.Hessian10;
+	Hessian11 += other.Hessian11;
+}
+
+// The likelihood function of Platt method over the arrays of the scores and the labels
+// The function is the same as in PlattScalling.cpp, but the arrays are not copied,
+// each vector needs only one exponent and the sums are accumulated in parallel
+class CPlattLikelihood {
+public:
+	CPlattLikelihood( const float* scores, const int* labels, const float* weights, int count,
+		double tPositive, double tNegative, int threadCount );
+	~CPlattLikelihood() { delete threadPool; }
+
+	// Calculates the function value and, if required, its gradient and hessian
+	CPlattSums Calculate( const CSigmoid& coefficients, bool withDerivatives ) const;
+
+private:
+	const float* const scores;
+	const int* const labels;
+	const float* const weights;
+	const int count;
+	const double tPositive;
+	const double tNegative;
+	IThreadPool* const threadPool;
+
+	CPlattSums calculate( const CSigmoid& coefficients, bool withDerivatives, int first, int end ) const;
+};
+
+CPlattLikelihood::CPlattLikelihood( const float* _scores, const int* _labels, const float* _weights, int _count,
+		double _tPositive, double _tNegative, int threadCount ) :
+	scores( _scores ),
+	labels( _labels ),
+	weights( _weights ),
+	count( _count ),
+	tPositive( _tPositive ),
+	tNegative( _tNegative ),
+	threadPool( CreateThreadPool( threadCount ) )
+{
+	NeoAssert( threadPool != nullptr );
+}
+
+CPlattSums CPlattLikelihood::Calculate( const CSigmoid& coefficients, bool withDerivatives ) const
+{
+	struct CTask {
+		const CPlattLikelihood& Function;
+		const CSigmoid& Coefficients;
+		const bool WithDerivatives;
+		CArray<CPlattSums> Sums;
+	} task{ *this, coefficients, withDerivatives, {} };
+	task.Sums.SetSize( threadPool->Size() );
+
+	NEOML_NUM_THREADS( *threadPool, &task, []( int threadIndex, void* ptr ) {
+		CTask& task = *static_cast<CTask*>( ptr );
+		int index = 0;
+		int count = 0;
+		if( GetTaskIndexAndCount( task.Sums.Size(), threadIndex, task.Function.count, 1, index, count ) ) {
+			task.Sums[threadIndex] = task.Function.calculate( task.Coefficients, task.WithDerivatives,
+				index, index + count );
+		}
+	} );
+
+	// The sums are added in the same order to make the result deterministic
+	CPlattSums result;
+	for( int i = 0; i < task.Sums.Size(); i++ ) {
+		result.Add( task.Sums[i] );
+	}
+	return result;
+}
+
+CPlattSums CPlattLikelihood::calculate( const CSigmoid& coefficients, bool withDerivatives, int first, int end ) const
+{
+	CPlattSums sums;
+	for( int i = first; i < end; i++ ) {
+		const double weight = weights == nullptr ? 1. : weights[i];
+		const double t = labels[i] > 0 ? tPositive : tNegative;
+		const double score = scores[i];
+		const double temp = score * coefficients.A + coefficients.B;
+		// The exponent of the non-positive argument doesn't overflow
+		const double exponent = exp( -fabs( temp ) );
+		sums.Value += weight * ( ( temp >= 0 ? t : t - 1 ) * temp + log1p( exponent ) );
+		if( withDerivatives ) {
+			const double p = ( temp >= 0 ? exponent : 1. ) / ( 1. + exponent );
+			const double pq = weight * p * ( 1. - p );
+			sums.Hessian00 += score * score * pq;
+			sums.Hessian10 += score * pq;
+			sums.Hessian11 += pq;
+			sums.Gradient0 += weight * score * ( t - p );
+			sums.Gradient1 += weight * ( t - p );
+		}
+	}
+	return sums;
+}
+
+void CalcSigmoidCoefficients( const float* scores, const int* labels, const float* weights, int count,
+	CSigmoid& coefficients, int threadCount )
+{
+	NeoAssert( count >= 0 );
+	NeoAssert( count == 0 || ( scores != nullptr && labels != nullptr ) );
+
+	double posCount = 0;
+	double negCount = 0;
+	for( int i = 0; i < count; i++ ) {
+		const double weight = weights == nullptr ? 1. : weights[i];
+		if( labels[i] > 0 ) {
+			posCount += weight;
+		} else {
+			negCount += weight;
+		}
+	}
+
+	// Use the Newton method with backtracking
+	const double eps = 1e-5;
+
+	coefficients.A = 0.0;
+	coefficients.B = log( ( negCount + 1.0 ) / ( posCount + 1.0 ) );
+
+	CPlattLikelihood function( scores, labels, weights, count,
+		( posCount + 1.0 ) / ( posCount + 2.0 ), 1 / ( negCount + 2.0 ), threadCount );
+
+	for( int i = 0; i < 100; i++ ) {
+		const CPlattSums sums = function.Calculate( coefficients, true );
+		const double g0 = sums.Gradient0;
+		const double g1 = sums.Gradient1;
+		if( fabs( g0 ) < eps && fabs( g1 ) < eps ) {
+			break;
+		}
+
+		const double hessian00 = sums.Hessian00 + 1e-12;
+		const double hessian11 = sums.Hessian11 + 1e-12;
+		const double det = hessian00 * hessian11 - sums.Hessian10 * sums.Hessian10;
+		const double h0 = -( hessian11 * g0 - sums.Hessian10 * g1 ) / det;
+		const double h1 = -( -sums.Hessian10 * g0 + hessian00 * g1 ) / det;
+		const double length = g0 * h0 + g1 * h1;
+
+		double step = 1;
+		while( step >= 1e-10 ) {
+			CSigmoid newCoefficients = coefficients;
+			newCoefficients.A += h0 * step;
+			newCoefficients.B += h1 * step;
+			const double newValue = function.Calculate( newCoefficients, false ).Value;
+
+			if( newValue < sums.Value + 0.0001 * step * length ) {
+				coefficients = newCoefficients;
+				break;
+			}
+
+			step = step / 2;
+		}
+	}
+
+	if( !coefficients.IsValid() ) {
+		// The Platt method should not dramatically change the classification results; if that is the case, ignore it
+		coefficients.A = -1.;
+		coefficients.B = 0.;
+	}
+}
+
+// Copies the scores and the labels of the blobs
+static void getCalibrationData( const CDnnBlob& scoresBlob, const CDnnBlob& labelsBlob,
+	CArray<float>& scores, CArray<int>& labels )
+{
+	NeoAssert( scoresBlob.GetDataType() == CT_Float );
+	NeoAssert( scoresBlob.GetDataSize() == labelsBlob.GetDataSize() );
+
+	scores.SetSize( scoresBlob.GetDataSize() );
+	scoresBlob.CopyTo( scores.GetPtr() );
+	labels.SetSize( labelsBlob.GetDataSize() );
+	if( labelsBlob.GetDataType() == CT_Int ) {
+		labelsBlob.CopyTo( labels.GetPtr() );
+	} else {
+		CArray<float> floatLabels;
+		floatLabels.SetSize( labelsBlob.GetDataSize() );
+		labelsBlob.CopyTo( floatLabels.GetPtr() );
+		for( int i = 0; i < labels.Size(); i++ ) {
+			labels[i] = floatLabels[i] > 0 ? 1 : 0;
+		}
+	}
+}
+
+void CalcSigmoidCoefficients( const CDnnBlob& scoresBlob, const CDnnBlob& labelsBlob,
+	CSigmoid& coefficients, int threadCount )
+{
+	CArray<float> scores;
+	CArray<int> labels;
+	getCalibrationData( scoresBlob, labelsBlob, scores, labels );
+	CalcSigmoidCoefficients( scores.GetPtr(), labels.GetPtr(), nullptr, scores.Size(), coefficients, threadCount );
+}
+
+void CalcSigmoidProbabilities( const CSigmoid& coefficients, const float* scores, float* probabilities, int count )
+{
+	NeoAssert( coefficients.IsValid() );
+	for( int i = 0; i < count; i++ ) {
+		const double value = coefficients.A * scores[i] + coefficients.B;
+		if( MaxExpArgument < value ) {
+			probabilities[i] = 0.f;
+		} else if( value < -MaxExpArgument ) {
+			probabilities[i] = 1.f;
+		} else {
+			probabilities[i] = static_cast<float>( 1 / ( 1 + exp( value ) ) );
+		}
+	}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+// A block of the pool adjacent violators algorithm
+struct CIsotonicBlock {
+	float MinScore;
+	float MaxScore;
+	double Weight;
+	double PositiveWeight;
+
+	double Value() const { return PositiveWeight / Weight; }
+	void Merge( const CIsotonicBlock& next );
+};
+
+void CIsotonicBlock::Merge( const CIsotonicBlock& next )
+{
+	MaxScore = next.MaxScore;
+	Weight += next.Weight;
+	PositiveWeight += next.PositiveWeight;
+}
+
+void CIsotonicCalibration::Train( const float* scores, const int* labels, const float* weights, int count )
+{
+	NeoAssert( count >= 0 );
+	NeoAssert( count == 0 || ( scores != nullptr && labels != nullptr ) );
+
+	CArray<CIsotonicBlock> points;
+	points.SetBufferSize( count );
+	for( int i = 0; i < count; i++ ) {
+		const double weight = weights == nullptr ? 1. : weights[i];
+		if( weight > 0 ) {
+			points.Add( { scores[i], scores[i], weight, labels[i] > 0 ? weight : 0. } );
+		}
+	}
+	NeoAssert( !points.IsEmpty() );
+	points.QuickSort<AscendingByMember<CIsotonicBlock, float, &CIsotonicBlock::MinScore>>();
+
+	// The blocks are built in place of the sorted points
+	int blockCount = 0;
+	for( int i = 0; i < points.Size(); i++ ) {
+		if( blockCount > 0 && points[blockCount - 1].MaxScore == points[i].MinScore ) {
+			// The vectors with the same score always get the same probability
+			points[blockCount - 1].Merge( points[i] );
+		} else {
+			points[blockCount++] = points[i];
+		}
+		// Merge the blocks which violate the monotonicity
+		while( blockCount > 1 && points[blockCount - 2].Value() >= points[blockCount - 1].Value() ) {
+			points[blockCount - 2].Merge( points[blockCount - 1] );
+			blockCount--;
+		}
+	}
+
+	thresholds.DeleteAll();
+	values.DeleteAll();
+	for( int i = 0; i < blockCount; i++ ) {
+		const float value = static_cast<float>( points[i].Value() );
+		thresholds.Add( points[i].MinScore );
+		values.Add( value );
+		if( points[i].MaxScore > points[i].MinScore ) {
+			thresholds.Add( points[i].MaxScore );
+			values.Add( value );
+		}
+	}
+}
+
+void CIsotonicCalibration::Train( const CDnnBlob& scoresBlob, const CDnnBlob& labelsBlob )
+{
+	CArray<float> scores;
+	CArray<int> labels;
+	getCalibrationData( scoresBlob, labelsBlob, scores, labels );
+	Train( scores.GetPtr(), labels.GetPtr(), nullptr, scores.Size() );
+}
+
+double CIsotonicCalibration::GetProbability( double score ) const
+{
+	NeoAssert( IsTrained() );
+	if( score <= thresholds.First() ) {
+		return values.First();
+	}
+	if( score >= thresholds.Last() ) {
+		return values.Last();
+	}
+	// Find the segment thresholds[first] <= score < thresholds[first + 1]
+	int first = 0;
+	int last = thresholds.Size() - 1;
+	while( last - first > 1 ) {
+		const int middle = ( first + last ) / 2;
+		if( thresholds[middle] <= score ) {
+			first = middle;
+		} else {
+			last = middle;
+		}
+	}
+	const double ratio = ( score - thresholds[first] ) / ( thresholds[last] - thresholds[first] );
+	return values[first] + ratio * ( values[last] - values[first] );
+}
+
+void CIsotonicCalibration::GetProbabilities( const float* scores, float* probabilities, int count ) const
+{
+	for( int i = 0; i < count; i++ ) {
+		probabilities[i] = static_cast<float>( GetProbability( scores[i] ) );
+	}
+}
+
+static const int IsotonicCalibrationVersion = 0;
+
+void CIsotonicCalibration::Serialize( CArchive& archive )
+{
+	archive.SerializeVersion( IsotonicCalibrationVersion );
+	thresholds.Serialize( archive );
+	values.Serialize( archive );
+	if( archive.IsLoading() ) {
+		check( thresholds.Size() == values.Size(), ERR_BAD_ARCHIVE, archive.Name() );
+	}
+}
+
+} // namespace NeoML
@@ -0,0 +1,328 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#include <common.h>
+#pragma hdrstop
+
+#include <NeoML/TraditionalML/CompactSparseFloatMatrix.h>
+#include <float.h>
+#include <cstring>
+
+namespace NeoML {
+
+// Converts the float into the IEEE 754 half precision number, rounding to the nearest even
+static uint16_t compactFloatToHalf( float value )
+{
+	uint32_t bits = 0;
+	::memcpy( &bits, &value, sizeof( bits ) );
+	const uint16_t sign = static_cast<uint16_t>( ( bits >> 16 ) & 0x8000 );
+	bits &= 0x7fffffff;
+
+	if( bits >= 0x7f800000 ) {
+		// Infinity or NaN
+		return sign | 0x7c00 | ( bits > 0x7f800000 ? 0x200 : 0 );
+	}
+	if( bits >= 0x477ff000 ) {
+		// Rounds to infinity
+		return sign | 0x7c00;
+	}
+	if( bits < 0x38800000 ) {
+		// Subnormal half
+		if( bits < 0x33000000 ) {
+			return sign;
+		}
+		const int shift = 126 - static_cast<int>( bits >> 23 );
+		const uint32_t mantissa = ( bits & 0x7fffff ) | 0x800000;
+		uint32_t result = mantissa >> shift;
+		const uint32_t remainder = mantissa & ( ( 1u << shift ) - 1 );
+		const uint32_t halfway = 1u << ( shift - 1 );
+		if( remainder > halfway || ( remainder == halfway && ( result & 1 ) != 0 ) ) {
+			result++;
+		}
+		return sign | static_cast<uint16_t>( result );
+	}
+	// The carry of the rounding correctly moves into the exponent
+	uint32_t result = ( bits - 0x38000000 ) >> 13;
+	const uint32_t remainder = bits & 0x1fff;
+	if( remainder > 0x1000 || ( remainder == 0x1000 && ( result & 1 ) != 0 ) ) {
+		result++;
+	}
+	return sign | static_cast<uint16_t>( result );
+}
+
+static float compactHalfToFloat( uint16_t half )
+{
+	const uint32_t sign = static_cast<uint32_t>( half & 0x8000 ) << 16;
+	const uint32_t exponent = ( half >> 10 ) & 0x1f;
+	const uint32_t mantissa = half & 0x3ff;
+
+	uint32_t bits = 0;
+	if( exponent == 0 ) {
+		if( mantissa == 0 ) {
+			bits = sign;
+		} else {
+			// Subnormal half is mantissa * 2^-24
+			const float result = mantissa * 5.9604644775390625e-8f;
+			return sign == 0 ? result : -result;
+		}
+	} else if( exponent == 0x1f ) {
+		bits = sign | 0x7f800000 | ( mantissa << 13 );
+	} else {
+		bits = sign | ( ( exponent + 112 ) << 23 ) | ( mantissa << 13 );
+	}
+	float result = 0;
+	::memcpy( &result, &bits, sizeof( result ) );
+	return result;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+CCompactSparseFloatMatrix::CRowIterator::CRowIterator( const CCompactSparseFloatMatrix& _matrix, int _row ) :
+	matrix( &_matrix ),
+	row( _row ),
+	position( 0 ),
+	end( 0 ),
+	block( 0 ),
+	blockEnd( 0 ),
+	blockStart( 0 )
+{
+	NeoAssert( 0 <= row && row < matrix->GetHeight() );
+	position = matrix->rowPointers[row];
+	end = matrix->rowPointers[row + 1];
+	block = matrix->blockPointers[row];
+	if( position < end ) {
+		enterBlock();
+	}
+}
+
+void CCompactSparseFloatMatrix::CRowIterator::enterBlock()
+{
+	blockEnd = matrix->blockEnds[block];
+	blockStart = matrix->blockNumbers[block] * BlockSize;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+CCompactSparseFloatMatrix::CCompactSparseFloatMatrix( TCompactValueType _valueType ) :
+	valueType( _valueType ),
+	width( 0 )
+{
+	NeoAssert( 0 <= valueType && valueType < CVT_Count );
+	rowPointers.Add( 0 );
+	blockPointers.Add( 0 );
+}
+
+CCompactSparseFloatMatrix::CCompactSparseFloatMatrix( const CFloatMatrixDesc& desc, TCompactValueType _valueType ) :
+	CCompactSparseFloatMatrix( _valueType )
+{
+	AddRows( desc );
+}
+
+size_t CCompactSparseFloatMatrix::GetDataSize() const
+{
+	return ( rowPointers.Size() + blockPointers.Size() + blockNumbers.Size() + blockEnds.Size() ) * sizeof( int )
+		+ columns.Size() * sizeof( uint16_t )
+		+ floatValues.Size() * sizeof( float )
+		+ halfValues.Size() * sizeof( uint16_t )
+		+ byteValues.Size() * sizeof( uint8_t )
+		+ ( rowMinimums.Size() + rowSteps.Size() ) * sizeof( float );
+}
+
+void CCompactSparseFloatMatrix::SetBufferSize( int rowsBufferSize, int elementsBufferSize )
+{
+	NeoAssert( rowsBufferSize >= 0 && elementsBufferSize >= 0 );
+
+	rowPointers.SetBufferSize( rowsBufferSize + 1 );
+	blockPointers.SetBufferSize( rowsBufferSize + 1 );
+	if( valueType == CVT_Byte ) {
+		rowMinimums.SetBufferSize( rowsBufferSize );
+		rowSteps.SetBufferSize( rowsBufferSize );
+	}
+	reserveElements( elementsBufferSize );
+}
+
+void CCompactSparseFloatMatrix::AddRow( const CFloatVectorDesc& row )
+{
+	addElements( row );
+	rowPointers.Add( columns.Size() );
+	blockPointers.Add( blockNumbers.Size() );
+}
+
+void CCompactSparseFloatMatrix::AddRows( const CFloatMatrixDesc& rows )
+{
+	int elementCount = 0;
+	if( rows.Columns == nullptr ) {
+		// The zeros of the dense rows are skipped, so this is the upper bound
+		elementCount = rows.Height * rows.Width;
+	} else {
+		for( int i = 0; i < rows.Height; i++ ) {
+			elementCount += rows.PointerE[i] - rows.PointerB[i];
+		}
+	}
+	SetBufferSize( GetHeight() + rows.Height, GetElementCount() + elementCount );
+
+	CFloatVectorDesc row;
+	for( int i = 0; i < rows.Height; i++ ) {
+		rows.GetRow( i, row );
+		AddRow( row );
+	}
+	width = max( width, rows.Width );
+}
+
+void CCompactSparseFloatMatrix::GetRow( int index, CSparseFloatVector& row ) const
+{
+	row.Nullify();
+	for( CRowIterator it = GetRowIterator( index ); it.IsValid(); it.Next() ) {
+		row.SetAt( it.GetIndex(), it.GetValue() );
+	}
+}
+
+void CCompactSparseFloatMatrix::GetRows( int firstRow, int count, CSparseFloatMatrix& rows ) const
+{
+	NeoAssert( 0 <= firstRow && 0 <= count && firstRow + count <= GetHeight() );
+
+	rows = CSparseFloatMatrix( width, count, rowPointers[firstRow + count] - rowPointers[firstRow] );
+	CSparseFloatVector row;
+	for( int i = firstRow; i < firstRow + count; i++ ) {
+		GetRow( i, row );
+		rows.AddRow( row );
+	}
+}
+
+static const int CompactSparseFloatMatrixVersion = 0;
+
+void CCompactSparseFloatMatrix::Serialize( CArchive& archive )
+{
+	archive.SerializeVersion( CompactSparseFloatMatrixVersion );
+
+	int valueTypeInt = static_cast<int>( valueType );
+	archive.Serialize( valueTypeInt );
+	if( archive.IsLoading() ) {
+		check( 0 <= valueTypeInt && valueTypeInt < CVT_Count, ERR_BAD_ARCHIVE, archive.Name() );
+		valueType = static_cast<TCompactValueType>( valueTypeInt );
+	}
+	archive.Serialize( width );
+	rowPointers.Serialize( archive );
+	blockPointers.Serialize( archive );
+	blockNumbers.Serialize( archive );
+	blockEnds.Serialize( archive );
+	columns.Serialize( archive );
+	floatValues.Serialize( archive );
+	halfValues.Serialize( archive );
+	byteValues.Serialize( archive );
+	rowMinimums.Serialize( archive );
+	rowSteps.Serialize( archive );
+
+	if( archive.IsLoading() ) {
+		check( !rowPointers.IsEmpty() && rowPointers.Size() == blockPointers.Size()
+			&& blockNumbers.Size() == blockEnds.Size(), ERR_BAD_ARCHIVE, archive.Name() );
+	}
+}
+
+float CCompactSparseFloatMatrix::getValue( int row, int position ) const
+{
+	switch( valueType ) {
+		case CVT_Float:
+			return floatValues[position];
+		case CVT_Half:
+			return compactHalfToFloat( halfValues[position] );
+		case CVT_Byte:
+			return rowMinimums[row] + byteValues[position] * rowSteps[row];
+		default:
+			NeoAssert( false );
+	}
+	return 0;
+}
+
+void CCompactSparseFloatMatrix::reserveElements( int elementCount )
+{
+	columns.SetBufferSize( elementCount );
+	switch( valueType ) {
+		case CVT_Float:
+			floatValues.SetBufferSize( elementCount );
+			break;
+		case CVT_Half:
+			halfValues.SetBufferSize( elementCount );
+			break;
+		case CVT_Byte:
+			byteValues.SetBufferSize( elementCount );
+			break;
+		default:
+			NeoAssert( false );
+	}
+}
+
+// Appends the elements of the row and their block headers
+void CCompactSparseFloatMatrix::addElements( const CFloatVectorDesc& row )
+{
+	const bool isDense = row.Indexes == nullptr;
+
+	float minimum = FLT_MAX;
+	float maximum = -FLT_MAX;
+	if( valueType == CVT_Byte ) {
+		for( int i = 0; i < row.Size; i++ ) {
+			if( !isDense || row.Values[i] != 0 ) {
+				minimum = min( minimum, row.Values[i] );
+				maximum = max( maximum, row.Values[i] );
+			}
+		}
+		if( minimum > maximum ) {
+			minimum = maximum = 0;
+		}
+		rowMinimums.Add( minimum );
+		rowSteps.Add( ( maximum - minimum ) / 255 );
+	}
+	const float step = valueType == CVT_Byte ? rowSteps.Last() : 0.f;
+
+	const int firstBlock = blockNumbers.Size();
+	int lastIndex = -1;
+	for( int i = 0; i < row.Size; i++ ) {
+		const float value = row.Values[i];
+		if( isDense && value == 0 ) {
+			continue;
+		}
+		const int index = isDense ? i : row.Indexes[i];
+		NeoAssert( index > lastIndex );
+		lastIndex = index;
+
+		const int blockNumber = index / BlockSize;
+		if( blockNumbers.Size() == firstBlock || blockNumbers.Last() != blockNumber ) {
+			blockNumbers.Add( blockNumber );
+			blockEnds.Add( columns.Size() );
+		}
+		columns.Add( static_cast<uint16_t>( index % BlockSize ) );
+		blockEnds.Last() = columns.Size();
+
+		switch( valueType ) {
+			case CVT_Float:
+				floatValues.Add( value );
+				break;
+			case CVT_Half:
+				halfValues.Add( compactFloatToHalf( value ) );
+				break;
+			case CVT_Byte:
+			{
+				const int code = step > 0 ? static_cast<int>( ( value - minimum ) / step + 0.5f ) : 0;
+				byteValues.Add( static_cast<uint8_t>( min( max( code, 0 ), 255 ) ) );
+				break;
+			}
+			default:
+				NeoAssert( false );
+		}
+	}
+	width = max( width, isDense ? row.Size : lastIndex + 1 );
+}
+
+} // namespace NeoML
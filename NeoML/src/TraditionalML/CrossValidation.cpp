@@ -19,16 +19,36 @@ limitations under the License.
 #include <NeoML/TraditionalML/CrossValidation.h>
 #include <NeoML/TraditionalML/CrossValidationSubProblem.h>
 #include <NeoML/TraditionalML/StratifiedCrossValidationSubProblem.h>
+#include <NeoMathEngine/ThreadPool.h>
 
 namespace NeoML {
 
+ITrainingModelFactory::~ITrainingModelFactory() = default;
+
+//---------------------------------------------------------------------------------------------------------------------
+
 CCrossValidation::CCrossValidation( ITrainingModel& _trainingModel, const IProblem* _problem ) :
-	trainingModel( _trainingModel ),
-	problem( _problem )
+	trainingModel( &_trainingModel ),
+	modelFactory( nullptr ),
+	problem( _problem ),
+	threadCount( 1 ),
+	threadsPerPart( 1 )
 {
 	NeoAssert( problem != 0 );
 }
 
+CCrossValidation::CCrossValidation( ITrainingModelFactory& _modelFactory, const IProblem* _problem,
+		int _threadCount, int _threadsPerPart ) :
+	trainingModel( nullptr ),
+	modelFactory( &_modelFactory ),
+	problem( _problem ),
+	threadCount( _threadCount ),
+	threadsPerPart( _threadsPerPart )
+{
+	NeoAssert( problem != 0 );
+	NeoAssert( threadsPerPart > 0 );
+}
+
 void CCrossValidation::Execute( int partsCount, TScore score, CCrossValidationResult& result, bool stratified )
 {
 	NeoAssert( partsCount > 0 );
@@ -36,49 +56,80 @@ void CCrossValidation::Execute( int partsCount, TScore score, CCrossValidationRe
 
 	result.Problem = problem;
 	result.Models.Empty();
+	result.Models.SetSize( partsCount );
 	result.Results.Empty();
 	result.Results.SetSize( problem->GetVectorCount() );
 	result.ModelIndex.Empty();
 	result.ModelIndex.SetSize( problem->GetVectorCount() );
 	result.Success.Empty();
+	result.Success.SetSize( partsCount );
 
-	for( int i = 0; i < partsCount; i++ ) {
-		// Choose the training subset
-		CPtr<ISubProblem> trainSubProblem;
-		if( stratified ) {
-			trainSubProblem = FINE_DEBUG_NEW CStratifiedCrossValidationSubProblem( problem, partsCount, i, false );
-		} else {
-			trainSubProblem = FINE_DEBUG_NEW CCrossValidationSubProblem( problem, partsCount, i, false );
+	if( modelFactory == nullptr ) {
+		for( int i = 0; i < partsCount; i++ ) {
+			executePart( *trainingModel, partsCount, i, score, result, stratified );
 		}
+		return;
+	}
 
-		// Train the model
-		CPtr<IModel> model = trainingModel.Train( *trainSubProblem );
-		result.Models.Add( model );
-
-		// Choose the testing subset
-		CPtr<ISubProblem> testSubProblem;
-		if( stratified ) {
-			testSubProblem = FINE_DEBUG_NEW CStratifiedCrossValidationSubProblem( problem, partsCount, i, true );
-		} else {
-			testSubProblem = FINE_DEBUG_NEW CCrossValidationSubProblem( problem, partsCount, i, true );
+	// The parts write into the disjoint positions of the result
+	CPtrOwner<IThreadPool> threadPool( CreateThreadPool( threadCount ) );
+	struct CTask {
+		const CCrossValidation& CrossValidation;
+		int PartsCount;
+		TScore Score;
+		CCrossValidationResult& Result;
+		bool Stratified;
+		int ThreadCount;
+	} task{ *this, partsCount, score, result, stratified, threadPool->Size() };
+	NEOML_NUM_THREADS( *threadPool, &task, []( int threadIndex, void* ptr ) {
+		CTask& task = *static_cast<CTask*>( ptr );
+		for( int i = threadIndex; i < task.PartsCount; i += task.ThreadCount ) {
+			CPtrOwner<ITrainingModel> model( task.CrossValidation.modelFactory->CreateTrainingModel(
+				task.CrossValidation.threadsPerPart ) );
+			task.CrossValidation.executePart( *model, task.PartsCount, i, task.Score, task.Result, task.Stratified );
 		}
+	} );
+}
 
-		CFloatMatrixDesc testSubProblemMatrix = testSubProblem->GetMatrix();
-		
-		// Current model classification result to calculate the loss function
-		CArray<CClassificationResult> classificationResults;
+// Trains the model on all parts except the given one and tests it on the given part
+void CCrossValidation::executePart( ITrainingModel& model, int partsCount, int partIndex, TScore score,
+	CCrossValidationResult& result, bool stratified ) const
+{
+	// Choose the training subset
+	CPtr<ISubProblem> trainSubProblem;
+	if( stratified ) {
+		trainSubProblem = FINE_DEBUG_NEW CStratifiedCrossValidationSubProblem( problem, partsCount, partIndex, false );
+	} else {
+		trainSubProblem = FINE_DEBUG_NEW CCrossValidationSubProblem( problem, partsCount, partIndex, false );
+	}
 
-		for( int j = 0; j < testSubProblem->GetVectorCount(); j++ ) {
-			CFloatVectorDesc vector;
-			testSubProblemMatrix.GetRow( j, vector );
-			model->Classify( vector, result.Results[testSubProblem->GetOriginalIndex( j )] );
-			classificationResults.Add( result.Results[testSubProblem->GetOriginalIndex( j )] );
+	// Train the model
+	CPtr<IModel> trainedModel = model.Train( *trainSubProblem );
+	result.Models[partIndex] = trainedModel;
 
-			result.ModelIndex[testSubProblem->GetOriginalIndex( j )] = i;
-		}
+	// Choose the testing subset
+	CPtr<ISubProblem> testSubProblem;
+	if( stratified ) {
+		testSubProblem = FINE_DEBUG_NEW CStratifiedCrossValidationSubProblem( problem, partsCount, partIndex, true );
+	} else {
+		testSubProblem = FINE_DEBUG_NEW CCrossValidationSubProblem( problem, partsCount, partIndex, true );
+	}
 
-		result.Success.Add( score( classificationResults, testSubProblem ) );
+	CFloatMatrixDesc testSubProblemMatrix = testSubProblem->GetMatrix();
+
+	// Current model classification result to calculate the loss function
+	CArray<CClassificationResult> classificationResults;
+
+	for( int j = 0; j < testSubProblem->GetVectorCount(); j++ ) {
+		CFloatVectorDesc vector;
+		testSubProblemMatrix.GetRow( j, vector );
+		trainedModel->Classify( vector, result.Results[testSubProblem->GetOriginalIndex( j )] );
+		classificationResults.Add( result.Results[testSubProblem->GetOriginalIndex( j )] );
+
+		result.ModelIndex[testSubProblem->GetOriginalIndex( j )] = partIndex;
 	}
+
+	result.Success[partIndex] = score( classificationResults, testSubProblem );
 }
 
 } // namespace NeoML
@@ -22,6 +22,7 @@ limitations under the License.
 #include <DecisionTreeNodeBase.h>
 #include <DecisionTreeClassificationModel.h>
 #include <DecisionTreeNodeClassificationStatistic.h>
+#include <NeoMathEngine/ThreadPool.h>
 #include <float.h>
 
 namespace NeoML {
@@ -32,10 +33,29 @@ IDecisionTreeModel::~IDecisionTreeModel()
 
 //---------------------------------------------------------------------------------------------------------
 
+namespace {
+
+// Trains every binary subproblem of one-versus-all or one-versus-one by a separate decision tree
+// Can be called from several threads at once
+class CDecisionTreeBinaryTrainer : public ITrainingModel {
+public:
+	explicit CDecisionTreeBinaryTrainer( const CDecisionTree::CParams& _params ) : params( _params, 1 ) {}
+
+	CPtr<IModel> Train( const IProblem& problem ) override { return CDecisionTree( params ).Train( problem ); }
+
+private:
+	const CDecisionTree::CParams params;
+};
+
+} // namespace
+
+//---------------------------------------------------------------------------------------------------------
+
 const int CDecisionTree::MaxClassifyNodesCacheSize;
 
 CDecisionTree::CDecisionTree( const CParams& _params, CRandom* _random ) :
-	params( _params ),
+	threadPool( CreateThreadPool( _params.ThreadCount ) ),
+	params( _params, threadPool->Size() ),
 	random( _random != nullptr ? *_random : defRandom ),
 	logStream( 0 ),
 	nodesCount( 0 ),
@@ -51,10 +71,12 @@ CDecisionTree::CDecisionTree( const CParams& _params, CRandom* _random ) :
 	NeoAssert( params.MaxTreeDepth > 0 );
 	NeoAssert( params.MaxNodesCount > 1 );
 	NeoAssert( 0.00 <= params.ConstNodeThreshold && params.ConstNodeThreshold <= 1.0 );
+	NeoAssert( threadPool != nullptr );
 }
 
 CDecisionTree::~CDecisionTree()
 {
+	delete threadPool;
 }
 
 CPtr<IModel> CDecisionTree::Train( const IProblem& problem )
@@ -63,9 +85,21 @@ CPtr<IModel> CDecisionTree::Train( const IProblem& problem )
 	NeoAssert( problem.GetClassCount() > 0 );
 	NeoAssert( problem.GetFeatureCount() > 0 );
 
-	if( problem.GetClassCount() > 2 && params.MulticlassMode == MM_OneVsAll ) {
-		return COneVersusAll( *this ).Train( problem );
-	} else if( problem.GetClassCount() > 2 && params.MulticlassMode == MM_OneVsOne ) {
+	if( problem.GetClassCount() > 2
+		&& ( params.MulticlassMode == MM_OneVsAll || params.MulticlassMode == MM_OneVsOne ) )
+	{
+		if( params.ThreadCount > 1 && params.RandomSelectedFeaturesCount == NotFound ) {
+			// The subproblems are independent and can be trained in parallel
+			// (the random features selection would make the result depend on the order of training)
+			CDecisionTreeBinaryTrainer binaryTrainer( params );
+			if( params.MulticlassMode == MM_OneVsAll ) {
+				return COneVersusAll( binaryTrainer, params.ThreadCount ).Train( problem );
+			}
+			return COneVersusOne( binaryTrainer, params.ThreadCount ).Train( problem );
+		}
+		if( params.MulticlassMode == MM_OneVsAll ) {
+			return COneVersusAll( *this ).Train( problem );
+		}
 		return COneVersusOne( *this ).Train( problem );
 	}
 
@@ -341,7 +375,7 @@ CDecisionTreeNodeStatisticBase* CDecisionTree::createStatistic( CDecisionTreeNod
 {
 	CArray<int> features;
 	generateUsedFeatures( params.RandomSelectedFeaturesCount, classificationProblem->GetFeatureCount(), features );
-	return FINE_DEBUG_NEW CClassificationStatistics( node, *classificationProblem, features );
+	return FINE_DEBUG_NEW CClassificationStatistics( node, *classificationProblem, features, *threadPool );
 }
 
 } // namespace NeoML
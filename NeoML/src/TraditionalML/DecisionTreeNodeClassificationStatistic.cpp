@@ -17,6 +17,7 @@ limitations under the License.
 #pragma hdrstop
 
 #include <DecisionTreeNodeClassificationStatistic.h>
+#include <NeoMathEngine/ThreadPool.h>
 
 namespace NeoML {
 
@@ -24,10 +25,15 @@ namespace NeoML {
 const int SmallCoef = 4;
 const int BigCoef = 10;
 
-CClassificationStatistics::CClassificationStatistics( CDecisionTreeNodeBase* _node, const IProblem& _problem, const CArray<int>& _usedFeatures ) :
+// The minimum number of feature values per thread which is worth running in parallel
+static const int64_t MinDecisionTreeParallelComplexity = 32768;
+
+CClassificationStatistics::CClassificationStatistics( CDecisionTreeNodeBase* _node, const IProblem& _problem,
+		const CArray<int>& _usedFeatures, IThreadPool& _threadPool ) :
 	classCount( _problem.GetClassCount() ),
 	node( _node ),
 	problem( &_problem ),
+	threadPool( _threadPool ),
 	totalStatistics( _problem.GetClassCount() )
 {
 	_usedFeatures.CopyTo( usedFeatures );
@@ -41,31 +47,79 @@ CClassificationStatistics::CClassificationStatistics( CDecisionTreeNodeBase* _no
 	discretizationIntervals.SetSize( usedFeatures.Size() );
 }
 
-void CClassificationStatistics::AddVector( int index, const CFloatVectorDesc& vector )
+void CClassificationStatistics::AddVector( int index, const CFloatVectorDesc& )
 {
 	NeoAssert( problem != 0 );
-	const double weight = problem->GetVectorWeight( index );
-	const int classIndex = problem->GetClass( index );
-	for( int i = 0; i < vector.Size; i++ ) {
-		if( vector.Values[i] != 0.0 ) {
-			const int index = vector.Indexes == nullptr ? i : vector.Indexes[i];
-			if( usedFeatureNumber[index] != NotFound ) {
-				addValue( usedFeatureNumber[index], vector.Values[i], 1, classIndex, weight );
-				featureStatistics[usedFeatureNumber[index]].AddVectorSet( 1, classIndex, weight );
-			}
-		}
+	// The values are added feature by feature when the statistics are finished
+	vectorIndices.Add( index );
+	totalStatistics.AddVectorSet( 1, problem->GetClass( index ), problem->GetVectorWeight( index ) );
+}
+
+void CClassificationStatistics::Finish()
+{
+	// Every feature is processed independently, so the result doesn't depend on the number of threads
+	const int threadCount = getThreadCount( static_cast<int64_t>( vectorIndices.Size() ) * usedFeatures.Size() );
+	if( threadCount == 1 ) {
+		finishFeatures( 0, 1 );
+	} else {
+		NEOML_NUM_THREADS( threadPool, this, []( int threadIndex, void* ptr ) {
+			CClassificationStatistics& statistics = *static_cast<CClassificationStatistics*>( ptr );
+			statistics.finishFeatures( threadIndex, statistics.threadPool.Size() );
+		} );
 	}
+	vectorIndices.FreeBuffer();
+}
 
-	totalStatistics.AddVectorSet( 1, classIndex, weight );
+// Returns the number of threads worth using for the task
+int CClassificationStatistics::getThreadCount( int64_t complexity ) const
+{
+	if( threadPool.Size() == 1 || usedFeatures.Size() < 2 || complexity < 2 * MinDecisionTreeParallelComplexity ) {
+		return 1;
+	}
+	return threadPool.Size();
 }
 
-void CClassificationStatistics::Finish()
+// Accumulates the values of the features processed by the thread
+void CClassificationStatistics::finishFeatures( int threadIndex, int threadCount )
 {
+	int firstFeature = 0;
+	int featureCount = 0;
+	if( !GetTaskIndexAndCount( threadCount, threadIndex, usedFeatures.Size(), firstFeature, featureCount ) ) {
+		return;
+	}
+	const int lastFeature = firstFeature + featureCount;
+
+	const CFloatMatrixDesc matrix = problem->GetMatrix();
+	CFloatVectorDesc vector;
+	for( int i = 0; i < vectorIndices.Size(); i++ ) {
+		const int index = vectorIndices[i];
+		const double weight = problem->GetVectorWeight( index );
+		const int classIndex = problem->GetClass( index );
+		matrix.GetRow( index, vector );
+		if( vector.Indexes == nullptr ) {
+			for( int j = firstFeature; j < lastFeature; j++ ) {
+				const int feature = usedFeatures[j];
+				if( feature < vector.Size && vector.Values[feature] != 0.0 ) {
+					addValue( j, vector.Values[feature], 1, classIndex, weight );
+					featureStatistics[j].AddVectorSet( 1, classIndex, weight );
+				}
+			}
+		} else {
+			for( int j = 0; j < vector.Size; j++ ) {
+				const int featureNumber = usedFeatureNumber[vector.Indexes[j]];
+				if( vector.Values[j] != 0.0 && firstFeature <= featureNumber && featureNumber < lastFeature ) {
+					addValue( featureNumber, vector.Values[j], 1, classIndex, weight );
+					featureStatistics[featureNumber].AddVectorSet( 1, classIndex, weight );
+				}
+			}
+		}
+	}
+
 	// We need also to add zero values for the features
 	const CArray<double>& totalWeights = totalStatistics.Weights();
 	const CArray<int>& totalCounts = totalStatistics.Counts();
 
-	for( int i = 0; i < usedFeatures.Size(); i++ ) {
+	for( int i = firstFeature; i < lastFeature; i++ ) {
 		const CArray<double>& weights = featureStatistics[i].Weights();
 		const CArray<int>& counts = featureStatistics[i].Counts();
 
@@ -98,28 +152,69 @@ bool CClassificationStatistics::GetSplit( CDecisionTree::CParams param,
 {
 	// Choose the feature so that splitting by it will give the smallest criterion value
 	// If that is smaller than the whole subset criterion value, splitting is successful
+	int64_t complexity = 0;
+	for( int i = 0; i < discretizationIntervals.Size(); i++ ) {
+		complexity += discretizationIntervals[i].Size();
+	}
+	const int threadCount = getThreadCount( complexity * classCount );
+
+	// Each thread finds the best split among its range of features
+	CArray<CSplit> splits;
+	splits.SetSize( threadCount );
+	if( threadCount == 1 ) {
+		getFeaturesSplit( 0, 1, param, splits[0] );
+	} else {
+		struct CTask {
+			const CClassificationStatistics& Statistics;
+			const CDecisionTree::CParams& Param;
+			CArray<CSplit>& Splits;
+		} task{ *this, param, splits };
+		NEOML_NUM_THREADS( threadPool, &task, []( int threadIndex, void* ptr ) {
+			CTask& task = *static_cast<CTask*>( ptr );
+			task.Statistics.getFeaturesSplit( threadIndex, task.Splits.Size(), task.Param, task.Splits[threadIndex] );
+		} );
+	}
+
+	// The ranges are ordered, so the first of the equal splits is chosen as in the sequential search
 	criterionValue = totalStatistics.CalcCriterion( param.SplitCriterion );
 	featureIndex = NotFound;
+	for( int i = 0; i < splits.Size(); i++ ) {
+		if( splits[i].FeatureNumber != NotFound && criterionValue > splits[i].CriterionValue ) {
+			criterionValue = splits[i].CriterionValue;
+			featureIndex = usedFeatures[splits[i].FeatureNumber];
+			isDiscrete = problem->IsDiscreteFeature( featureIndex );
+			splits[i].Values.CopyTo( values );
+		}
+	}
+
+	return ( featureIndex != NotFound );
+}
+
+// Finds the best split among the features processed by the thread
+void CClassificationStatistics::getFeaturesSplit( int threadIndex, int threadCount, const CDecisionTree::CParams& param,
+	CSplit& split ) const
+{
+	int firstFeature = 0;
+	int featureCount = 0;
+	if( !GetTaskIndexAndCount( threadCount, threadIndex, discretizationIntervals.Size(), firstFeature, featureCount ) ) {
+		return;
+	}
 
 	CArray<double> splitValues;
-	for( int i = 0; i < discretizationIntervals.Size(); i++ ) {
+	for( int i = firstFeature; i < firstFeature + featureCount; i++ ) {
 		double splitCriterionValue = 0;
-		const bool isDiscreteFeature = problem->IsDiscreteFeature( usedFeatures[i] );
-		if( isDiscreteFeature ) { 
+		if( problem->IsDiscreteFeature( usedFeatures[i] ) ) {
 			splitCriterionValue = calcDiscreteSplitCriterion( param, discretizationIntervals[i], totalStatistics, splitValues );
 		} else {
 			splitCriterionValue = calcContinuousSplitCriterion( param, discretizationIntervals[i], totalStatistics, splitValues );
 		}
 
-		if( criterionValue > splitCriterionValue ) { // the split with a better criterion value is found
-			criterionValue = splitCriterionValue;
-			featureIndex = usedFeatures[i];
-			isDiscrete = isDiscreteFeature;
-			splitValues.CopyTo( values );
+		if( split.CriterionValue > splitCriterionValue ) { // the split with a better criterion value is found
+			split.CriterionValue = splitCriterionValue;
+			split.FeatureNumber = i;
+			splitValues.CopyTo( split.Values );
 		}
 	}
-
-	return ( featureIndex != NotFound );
 }
 
 double CClassificationStatistics::GetPredictions( CArray<double>& probabilities ) const
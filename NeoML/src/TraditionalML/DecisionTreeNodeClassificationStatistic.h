@@ -18,9 +18,12 @@ limitations under the License.
 #include <NeoML/TraditionalML/DecisionTree.h>
 #include <DecisionTreeNodeStatisticBase.h>
 #include <DecisionTreeNodeBase.h>
+#include <float.h>
 
 namespace NeoML {
 
+class IThreadPool;
+
 // The statistics for a vector set
 class CVectorSetClassificationStatistic {
 public:
@@ -132,7 +135,8 @@ inline double CVectorSetClassificationStatistic::CalcCriterion( CDecisionTree::T
 // The statistics accumulated in a node
 class CClassificationStatistics : public CDecisionTreeNodeStatisticBase {
 public:
-	explicit CClassificationStatistics( CDecisionTreeNodeBase* node, const IProblem& problem, const CArray<int>& usedFeatures );
+	CClassificationStatistics( CDecisionTreeNodeBase* node, const IProblem& problem, const CArray<int>& usedFeatures,
+		IThreadPool& threadPool );
 
 	// CDecisionTreeNodeStatisticBase interface methods
 	void AddVector( int index, const CFloatVectorDesc& vector ) override;
@@ -156,15 +160,27 @@ private:
 
 	typedef CFastArray<CInterval, 20> CIntervalArray; // 20 is used for binary classification
 
+	// The best split found among the range of features
+	struct CSplit {
+		double CriterionValue = DBL_MAX;
+		int FeatureNumber = NotFound;
+		CArray<double> Values;
+	};
+
 	const int classCount; // the number of classes
 	const CPtr<CDecisionTreeNodeBase> node; // the node for which statistics are accumulated
 	const CPtr<const IProblem> problem; // the problem
+	IThreadPool& threadPool; // the executors processing the features in parallel
+	CArray<int> vectorIndices; // the vectors added to the node (until the statistics are finished)
 	CArray<int> usedFeatures; // the features used
 	CArray<int> usedFeatureNumber; // the number of the current feature
 	CVectorSetClassificationStatistic totalStatistics; // the whole subset statistics
 	CArray<CVectorSetClassificationStatistic> featureStatistics; // the statistics for each feature
 	CArray<CIntervalArray> discretizationIntervals; // the sampling intervals
 
+	int getThreadCount( int64_t complexity ) const;
+	void finishFeatures( int threadIndex, int threadCount );
+	void getFeaturesSplit( int threadIndex, int threadCount, const CDecisionTree::CParams& param, CSplit& split ) const;
 	void addValue( int index, double value, int count, int classIndex, double weight );
 	void mergeIntervals( int discretizationValue, CIntervalArray& intervals );
 	void mergeOverlappingIntervals( CIntervalArray& intervals );
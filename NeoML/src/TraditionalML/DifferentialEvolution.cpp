@@ -18,7 +18,9 @@ limitations under the License.
 
 #include <NeoML/TraditionalML/DifferentialEvolution.h>
 #include <NeoML/TraditionalML/Shuffler.h>
+#include <NeoMathEngine/ThreadPool.h>
 #include <float.h>
+#include <atomic>
 
 namespace NeoML {
 
@@ -31,7 +33,12 @@ CDifferentialEvolution::CDifferentialEvolution( IFunctionEvaluation& _func, doub
 	maxGenerationCount( -1 ),
 	generationNum( 0 ),
 	lastBestGenerationNum( 0 ),
-	maxNonGrowingBestValue( -1 )
+	maxNonGrowingBestValue( -1 ),
+	threadCount( 1 ),
+	isSteadyState( false ),
+	isCacheEnabled( false ),
+	evaluationCount( 0 ),
+	steadyStateTrialCount( 0 )
 {
 	NeoAssert( fluctuation > 0. && fluctuation < 1. );
 	NeoAssert( crossProbability > 0. && crossProbability < 1. );
@@ -100,7 +107,7 @@ void CDifferentialEvolution::initializeAlgo()
 	}
 	// Calculate the quality of the initial generation
 	if( funcValues.Size() == 0 ) {
-		func.Evaluate( curPopulation, funcValues );
+		evaluate( curPopulation, funcValues );
 	}
 	NeoAssert( funcValues.Size() == curPopulation.Size() );
 
@@ -119,52 +126,27 @@ bool CDifferentialEvolution::BuildNextGeneration()
 	if( generationNum == 0 ) {
 		initializeAlgo();
 	}
+	if( isSteadyState ) {
+		return runSteadyState( false );
+	}
 	generationNum += 1;
 
 	////////////// Mutate the current generation ////////////////
 	CArray<CFunctionParamVector> trials; // trials[i] is the mutation of curPopulation[i]
 	trials.SetBufferSize( curPopulation.Size() );
 	for( int p = 0; p < curPopulation.Size(); ++p ) {
-		// Choose three random elements from the current generation
-		CShuffler shuffler( random, curPopulation.Size() );
-		shuffler.SetNext( p );
-
-		int a = shuffler.Next();
-		NeoAssert( a >= 0 && a < curPopulation.Size() );
-
-		int b = shuffler.Next();
-		NeoAssert( b >= 0 && b < curPopulation.Size() );
-
-		int c = shuffler.Next();
-		NeoAssert( c >= 0 && c < curPopulation.Size() );
-
-		// Add the mutated parameters vector
-		CFunctionParamVector trialAdd( func.NumberOfDimensions() );
-		CArray<CFunctionParam>& trialAddArr = trialAdd.CopyOnWrite();
-		for( int i = 0; i < trialAdd.Size(); ++i ) {
-			trialAddArr[i] = mutate( func.GetParamTraits( i ), curPopulation[p][i],
-				curPopulation[a][i], curPopulation[b][i], curPopulation[c][i],
-				func.GetMinConstraint( i ), func.GetMaxConstraint( i ) );
-		}
-		trials.Add( trialAdd );
+		trials.Add( buildTrial( p ) );
 	}
 
 	////////////// Evaluate the function on the mutated elements ////////////////
 	CArray<CFunctionParam> trialFuncValues;
-	func.Evaluate( trials, trialFuncValues );
+	evaluate( trials, trialFuncValues );
 
 	////////////// Create the next generation ////////////////
-	const IParamTraits& traits = func.GetResultTraits();
 	for( int p = 0; p < curPopulation.Size(); ++p ) {
 		// If the function value improved on this parameter set, remember it
-		if( traits.Less( trialFuncValues[p], funcValues[p] ) ) {
-			funcValues[p] = trialFuncValues[p];
+		if( selectTrial( p, trials[p], trialFuncValues[p] ) ) {
 			nextPopulation[p] = trials[p];
-
-			if( traits.Less( trialFuncValues[p], lastBestValue ) ) {
-				lastBestValue = trialFuncValues[p];
-				lastBestGenerationNum = generationNum;
-			}
 		} else { // Otherwise keep the previous generation element
 			nextPopulation[p] = curPopulation[p];
 		}
@@ -178,6 +160,236 @@ bool CDifferentialEvolution::BuildNextGeneration()
 	return checkStop();
 }
 
+void CDifferentialEvolution::RunOptimization()
+{
+	if( isSteadyState ) {
+		if( generationNum == 0 ) {
+			initializeAlgo();
+		}
+		runSteadyState( true );
+	} else {
+		while( !BuildNextGeneration() );
+	}
+}
+
+// Builds the mutation of the p-th element of the current generation
+CFunctionParamVector CDifferentialEvolution::buildTrial( int p )
+{
+	// Choose three random elements from the current generation
+	CShuffler shuffler( random, curPopulation.Size() );
+	shuffler.SetNext( p );
+
+	int a = shuffler.Next();
+	NeoAssert( a >= 0 && a < curPopulation.Size() );
+
+	int b = shuffler.Next();
+	NeoAssert( b >= 0 && b < curPopulation.Size() );
+
+	int c = shuffler.Next();
+	NeoAssert( c >= 0 && c < curPopulation.Size() );
+
+	CFunctionParamVector trial( func.NumberOfDimensions() );
+	CArray<CFunctionParam>& trialArr = trial.CopyOnWrite();
+	for( int i = 0; i < trial.Size(); ++i ) {
+		trialArr[i] = mutate( func.GetParamTraits( i ), curPopulation[p][i],
+			curPopulation[a][i], curPopulation[b][i], curPopulation[c][i],
+			func.GetMinConstraint( i ), func.GetMaxConstraint( i ) );
+	}
+	return trial;
+}
+
+// Checks if the trial is better than the p-th element and updates the best value
+// In the steady-state mode the trial replaces the element at once
+bool CDifferentialEvolution::selectTrial( int p, const CFunctionParamVector& trial, const CFunctionParam& value )
+{
+	const IParamTraits& traits = func.GetResultTraits();
+	if( !traits.Less( value, funcValues[p] ) ) {
+		return false;
+	}
+
+	funcValues[p] = value;
+	if( isSteadyState ) {
+		curPopulation[p] = trial;
+	}
+	if( traits.Less( value, lastBestValue ) ) {
+		lastBestValue = value;
+		// In the steady-state mode the generation in progress is not counted yet
+		lastBestGenerationNum = isSteadyState ? generationNum + 1 : generationNum;
+	}
+	return true;
+}
+
+// Evaluates the trials in the steady-state mode
+// Each thread builds a trial, evaluates it and puts it into the population without waiting for the other threads
+// Stops after the current generation or when one of the stop conditions is fulfilled
+bool CDifferentialEvolution::runSteadyState( bool untilStop )
+{
+	CPtrOwner<IThreadPool> threadPool( CreateThreadPool( threadCount ) );
+	struct CTask {
+		CDifferentialEvolution& Evolution;
+		const bool UntilStop;
+		CCriticalSection Section;
+		int NextTarget;
+		bool IsDone;
+		bool Result;
+	} task{ *this, untilStop, {}, 0, false, false };
+
+	NEOML_NUM_THREADS( *threadPool, &task, []( int, void* ptr ) {
+		CTask& task = *static_cast<CTask*>( ptr );
+		CDifferentialEvolution& evolution = task.Evolution;
+		CCriticalSectionLock lock( task.Section );
+		while( !task.IsDone ) {
+			const int p = task.NextTarget;
+			task.NextTarget = ( task.NextTarget + 1 ) % evolution.curPopulation.Size();
+			const CFunctionParamVector trial = evolution.buildTrial( p );
+
+			CFunctionParam value;
+			int insertionPoint = 0;
+			const int cached = evolution.isCacheEnabled ? evolution.findCachedValue( trial, insertionPoint ) : NotFound;
+			if( cached != NotFound ) {
+				value = evolution.cachedValues[cached];
+			} else {
+				lock.Unlock();
+				value = evolution.func.Evaluate( trial );
+				lock.Lock();
+				evolution.evaluationCount++;
+				if( evolution.isCacheEnabled ) {
+					evolution.addCachedValue( trial, value );
+				}
+			}
+			evolution.selectTrial( p, trial, value );
+
+			evolution.steadyStateTrialCount++;
+			if( evolution.steadyStateTrialCount >= evolution.curPopulation.Size() && !task.IsDone ) {
+				evolution.steadyStateTrialCount = 0;
+				evolution.generationNum++;
+				task.Result = evolution.checkStop();
+				task.IsDone = task.Result || !task.UntilStop;
+			}
+		}
+	} );
+
+	return task.Result;
+}
+
+// Evaluates the function on the parameter vectors
+// The cached values are not evaluated again, the rest are evaluated in parallel
+void CDifferentialEvolution::evaluate( const CArray<CFunctionParamVector>& params, CArray<CFunctionParam>& results )
+{
+	results.DeleteAll();
+	results.SetSize( params.Size() );
+
+	// The vectors to be evaluated, each one only once
+	CArray<CFunctionParamVector> newParams;
+	// The index of each vector in newParams or NotFound if the value is cached
+	CArray<int> newParamIndexes;
+	newParamIndexes.SetSize( params.Size() );
+	for( int i = 0; i < params.Size(); ++i ) {
+		if( isCacheEnabled ) {
+			int insertionPoint = 0;
+			const int cached = findCachedValue( params[i], insertionPoint );
+			if( cached != NotFound ) {
+				results[i] = cachedValues[cached];
+				newParamIndexes[i] = NotFound;
+				continue;
+			}
+			int j = 0;
+			while( j < newParams.Size() && compareParams( newParams[j], params[i] ) != 0 ) {
+				j++;
+			}
+			newParamIndexes[i] = j;
+			if( j == newParams.Size() ) {
+				newParams.Add( params[i] );
+			}
+		} else {
+			newParamIndexes[i] = newParams.Size();
+			newParams.Add( params[i] );
+		}
+	}
+
+	CArray<CFunctionParam> newResults;
+	if( threadCount == 1 ) {
+		if( !newParams.IsEmpty() ) {
+			func.Evaluate( newParams, newResults );
+		}
+	} else {
+		newResults.SetSize( newParams.Size() );
+		CPtrOwner<IThreadPool> threadPool( CreateThreadPool( threadCount ) );
+		struct CTask {
+			IFunctionEvaluation& Func;
+			const CArray<CFunctionParamVector>& Params;
+			CArray<CFunctionParam>& Results;
+			std::atomic<int> Next;
+		} task{ func, newParams, newResults, { 0 } };
+		// The evaluation time may differ much, so the threads take the vectors one by one
+		NEOML_NUM_THREADS( *threadPool, &task, []( int, void* ptr ) {
+			CTask& task = *static_cast<CTask*>( ptr );
+			for( int i = task.Next++; i < task.Params.Size(); i = task.Next++ ) {
+				task.Results[i] = task.Func.Evaluate( task.Params[i] );
+			}
+		} );
+	}
+	NeoAssert( newResults.Size() == newParams.Size() );
+	evaluationCount += newParams.Size();
+
+	for( int i = 0; i < params.Size(); ++i ) {
+		if( newParamIndexes[i] != NotFound ) {
+			results[i] = newResults[newParamIndexes[i]];
+		}
+	}
+	if( isCacheEnabled ) {
+		for( int i = 0; i < newParams.Size(); ++i ) {
+			addCachedValue( newParams[i], newResults[i] );
+		}
+	}
+}
+
+// Compares the parameter vectors lexicographically; returns -1, 0 or 1
+int CDifferentialEvolution::compareParams( const CFunctionParamVector& left, const CFunctionParamVector& right ) const
+{
+	for( int i = 0; i < left.Size(); ++i ) {
+		const IParamTraits& traits = func.GetParamTraits( i );
+		if( traits.Less( left[i], right[i] ) ) {
+			return -1;
+		}
+		if( traits.Less( right[i], left[i] ) ) {
+			return 1;
+		}
+	}
+	return 0;
+}
+
+// Looks for the vector in the cache; returns its index or NotFound and the position to insert it
+int CDifferentialEvolution::findCachedValue( const CFunctionParamVector& params, int& insertionPoint ) const
+{
+	int first = 0;
+	int last = cachedParams.Size();
+	while( first < last ) {
+		const int middle = ( first + last ) / 2;
+		const int comparison = compareParams( cachedParams[middle], params );
+		if( comparison == 0 ) {
+			insertionPoint = middle;
+			return middle;
+		}
+		if( comparison < 0 ) {
+			first = middle + 1;
+		} else {
+			last = middle;
+		}
+	}
+	insertionPoint = first;
+	return NotFound;
+}
+
+void CDifferentialEvolution::addCachedValue( const CFunctionParamVector& params, const CFunctionParam& value )
+{
+	int insertionPoint = 0;
+	if( findCachedValue( params, insertionPoint ) == NotFound ) {
+		cachedParams.InsertAt( params, insertionPoint );
+		cachedValues.InsertAt( value, insertionPoint );
+	}
+}
+
 bool CDifferentialEvolution::checkStop()
 {
 	// The maximum number of generations is reached
@@ -259,4 +471,72 @@ void CDifferentialEvolution::LogPopulation()
 	*log << "<<<<<<<<DiffEvolution<<<<<<<<--------\n";
 }
 
+static const int DifferentialEvolutionVersion = 0;
+
+void CDifferentialEvolution::Serialize( CArchive& archive )
+{
+	archive.SerializeVersion( DifferentialEvolutionVersion );
+
+	int populationSize = population;
+	int dimensions = func.NumberOfDimensions();
+	archive.Serialize( populationSize );
+	archive.Serialize( dimensions );
+	check( populationSize == population && dimensions == func.NumberOfDimensions(), ERR_BAD_ARCHIVE, archive.Name() );
+
+	archive.Serialize( generationNum );
+	archive.Serialize( lastBestGenerationNum );
+	archive.Serialize( steadyStateTrialCount );
+	archive.Serialize( evaluationCount );
+	if( archive.IsStoring() ) {
+		archive << random;
+	} else {
+		archive >> random;
+	}
+
+	int size = curPopulation.Size();
+	archive.Serialize( size );
+	check( 0 <= size && size <= population, ERR_BAD_ARCHIVE, archive.Name() );
+	curPopulation.SetSize( size );
+	for( int i = 0; i < size; ++i ) {
+		serializeParams( archive, curPopulation[i] );
+	}
+	size = funcValues.Size();
+	archive.Serialize( size );
+	check( size == 0 || size == curPopulation.Size(), ERR_BAD_ARCHIVE, archive.Name() );
+	funcValues.SetSize( size );
+	for( int i = 0; i < size; ++i ) {
+		func.GetResultTraits().Serialize( archive, funcValues[i] );
+	}
+	bool hasBestValue = lastBestValue != nullptr;
+	archive.Serialize( hasBestValue );
+	if( hasBestValue ) {
+		func.GetResultTraits().Serialize( archive, lastBestValue );
+	}
+
+	size = cachedParams.Size();
+	archive.Serialize( size );
+	check( size >= 0, ERR_BAD_ARCHIVE, archive.Name() );
+	cachedParams.SetSize( size );
+	cachedValues.SetSize( size );
+	for( int i = 0; i < size; ++i ) {
+		serializeParams( archive, cachedParams[i] );
+		func.GetResultTraits().Serialize( archive, cachedValues[i] );
+	}
+
+	if( archive.IsLoading() ) {
+		curPopulation.CopyTo( nextPopulation );
+	}
+}
+
+void CDifferentialEvolution::serializeParams( CArchive& archive, CFunctionParamVector& params ) const
+{
+	if( archive.IsLoading() ) {
+		params = CFunctionParamVector( func.NumberOfDimensions() );
+	}
+	CArray<CFunctionParam>& paramsArr = params.CopyOnWrite();
+	for( int i = 0; i < paramsArr.Size(); ++i ) {
+		func.GetParamTraits( i ).Serialize( archive, paramsArr[i] );
+	}
+}
+
 } // namespace NeoML
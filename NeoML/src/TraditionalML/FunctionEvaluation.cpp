@@ -37,6 +37,11 @@ CFunctionParam IParamTraits::Mutate( CRandom&, const CFunctionParam&,
 	return 0;
 }
 
+void IParamTraits::Serialize( CArchive&, CFunctionParam& ) const
+{
+	NeoAssert(0);
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////////////////////////////
 // IFunctionEvaluation
@@ -101,6 +106,17 @@ bool CDoubleTraits::Less( const CFunctionParam& _left, const CFunctionParam& _ri
 	return Unbox( _left ) < Unbox( _right );
 }
 
+void CDoubleTraits::Serialize( CArchive& archive, CFunctionParam& value ) const
+{
+	if( archive.IsStoring() ) {
+		archive << Unbox( value );
+	} else {
+		double unboxed = 0;
+		archive >> unboxed;
+		value = Box( unboxed );
+	}
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////////////////////////////
 // CIntTraits
@@ -138,6 +154,17 @@ bool CIntTraits::Less( const CFunctionParam& _left, const CFunctionParam& _right
 	return Unbox( _left ) < Unbox( _right );
 }
 
+void CIntTraits::Serialize( CArchive& archive, CFunctionParam& value ) const
+{
+	if( archive.IsStoring() ) {
+		archive << Unbox( value );
+	} else {
+		int unboxed = 0;
+		archive >> unboxed;
+		value = Box( unboxed );
+	}
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////////////////////////////
 // CFunctionEvaluation
@@ -19,26 +19,34 @@ limitations under the License.
 #include <NeoML/TraditionalML/HierarchicalClustering.h>
 #include <NaiveHierarchicalClustering.h>
 #include <NnChainHierarchicalClustering.h>
+#include <NeoMathEngine/ThreadPool.h>
 
 namespace NeoML {
 
 // --------------------------------------------------------------------------------------------------------------------
 
 CHierarchicalClustering::CHierarchicalClustering( const CArray<CClusterCenter>& clustersCenters, const CParam& _params ) :
-	params( _params ),
-	log( 0 )
+	CHierarchicalClustering( _params )
 {
-	NeoAssert( params.MinClustersCount > 0 );
 	// Initial cluster centers are supported only for centroid
 	NeoAssert( params.Linkage == L_Centroid );
 	clustersCenters.CopyTo( initialClusters );
 }
 
 CHierarchicalClustering::CHierarchicalClustering( const CParam& _params ) :
-	params( _params ),
+	threadPool( CreateThreadPool( _params.ThreadCount ) ),
+	params( _params, threadPool->Size() ),
 	log( 0 )
 {
+	NeoAssert( threadPool != nullptr );
 	NeoAssert( params.MinClustersCount > 0 );
+	// Memory bounded mode is supported only for single linkage
+	NeoAssert( !params.MemoryBounded || params.Linkage == L_Single );
+}
+
+CHierarchicalClustering::~CHierarchicalClustering()
+{
+	delete threadPool;
 }
 
 bool CHierarchicalClustering::Clusterize( const IClusteringData* input, CClusteringResult& result )
@@ -108,7 +116,7 @@ bool CHierarchicalClustering::clusterizeImpl( const IClusteringData* data, CClus
 bool CHierarchicalClustering::naiveAlgo( const CFloatMatrixDesc& matrix, const CArray<double>& weights,
 	CClusteringResult& result, CArray<CMergeInfo>* dendrogram, CArray<int>* dendrogramIndices ) const
 {
-	CNaiveHierarchicalClustering naiveClustering( params, initialClusters, log );
+	CNaiveHierarchicalClustering naiveClustering( params, initialClusters, *threadPool, log );
 	return naiveClustering.Clusterize( matrix, weights, result, dendrogram, dendrogramIndices );
 }
 
@@ -118,7 +126,7 @@ bool CHierarchicalClustering::nnChainAlgo(const CFloatMatrixDesc& matrix, const
 {
 	NeoAssert( params.Linkage != L_Centroid );
 	NeoAssert( initialClusters.IsEmpty() );
-	CNnChainHierarchicalClustering nnChainClustering( params, log );
+	CNnChainHierarchicalClustering nnChainClustering( params, *threadPool, log );
 	return nnChainClustering.Clusterize( matrix, weights, result, dendrogram, dendrogramIndices );
 }
 
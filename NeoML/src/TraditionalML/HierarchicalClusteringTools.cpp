@@ -0,0 +1,108 @@
+/* Copyright © 2017-2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#include <common.h>
+#pragma hdrstop
+
+#include <HierarchicalClusteringTools.h>
+#include <NeoMathEngine/ThreadPool.h>
+
+namespace NeoML {
+
+// The minimum number of operations which is worth running in parallel
+static constexpr int64_t HierarchicalClusteringMinParallelComplexity = 32768;
+
+int IHierarchicalClusteringThreadTask::ThreadCount() const
+{
+	return ThreadPool.Size();
+}
+
+void IHierarchicalClusteringThreadTask::ParallelRun()
+{
+	if( ThreadCount() == 1 || ParallelizeSize() < 2 || Complexity() < HierarchicalClusteringMinParallelComplexity ) {
+		// Run in a single thread
+		for( int index = 0; index < ParallelizeSize(); ++index ) {
+			RunOnElement( /*threadIndex*/0, index );
+		}
+		OnThreadFinished( /*threadIndex*/0 );
+		return;
+	}
+	// Run in parallel
+	NEOML_NUM_THREADS( ThreadPool, this, []( int threadIndex, void* ptr ) {
+		( ( IHierarchicalClusteringThreadTask* )ptr )->runSplittedByThreads( threadIndex );
+	} );
+}
+
+void IHierarchicalClusteringThreadTask::runSplittedByThreads( int threadIndex )
+{
+	if( IsInterleaved() ) {
+		for( int index = threadIndex; index < ParallelizeSize(); index += ThreadCount() ) {
+			RunOnElement( threadIndex, index );
+		}
+	} else {
+		int start = 0;
+		int count = 0;
+		if( GetTaskIndexAndCount( ThreadCount(), threadIndex, ParallelizeSize(), start, count ) ) {
+			for( int index = start; index < start + count; ++index ) {
+				RunOnElement( threadIndex, index );
+			}
+		}
+	}
+	OnThreadFinished( threadIndex );
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+double CalcClusterToVectorDistance( const CClusterCenter& cluster, const CFloatVectorDesc& element, TDistanceFunc distanceFunc )
+{
+	const int size = cluster.Mean.Size();
+	if( element.Indexes != nullptr || element.Size != size ) {
+		// Sparse or incomplete vector
+		return CalcDistance( cluster, element, distanceFunc );
+	}
+
+	// The formulas are the same as in ClusterCenter.cpp so that dense and sparse data give equal results
+	const float* mean = cluster.Mean.GetPtr();
+	const float* values = element.Values;
+	double result = 0;
+	switch( distanceFunc ) {
+		case DF_Euclid:
+			for( int i = 0; i < size; ++i ) {
+				const double diff = mean[i] - values[i];
+				result += diff * diff;
+			}
+			break;
+		case DF_Machalanobis:
+		{
+			const float* disp = cluster.Disp.GetPtr();
+			for( int i = 0; i < size; ++i ) {
+				const double diff = mean[i] - values[i];
+				result += diff * diff / disp[i];
+			}
+			break;
+		}
+		case DF_Cosine:
+		{
+			const double dotProduct = DotProduct( cluster.Mean.GetDesc(), element );
+			result = 1. - dotProduct * fabs( dotProduct ) / DotProduct( element, element ) / cluster.Norm;
+			break;
+		}
+		default:
+			NeoAssert( false );
+	}
+	return result;
+}
+
+} // namespace NeoML
@@ -0,0 +1,60 @@
+/* Copyright © 2017-2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <NeoML/TraditionalML/ClusterCenter.h>
+
+namespace NeoML {
+
+// Forward declaration
+class IThreadPool;
+
+// Task of hierarchical clustering which processes a set of independent elements in multiple threads
+struct IHierarchicalClusteringThreadTask {
+	virtual ~IHierarchicalClusteringThreadTask() {}
+	// Runs in a single thread if the task is too small, otherwise in parallel
+	void ParallelRun();
+
+protected:
+	explicit IHierarchicalClusteringThreadTask( IThreadPool& threadPool ) : ThreadPool( threadPool ) {}
+
+	// The number of separate executors
+	int ThreadCount() const;
+	// The size of parallelization, max number of elements to perform
+	virtual int ParallelizeSize() const = 0;
+	// Total complexity used to decide whether to run this task in one thread or in parallel
+	virtual int64_t Complexity() const { return ParallelizeSize(); }
+	// If true the elements are distributed between threads in a round-robin manner
+	// Used when the complexity of elements decreases along with the index (e.g. rows of a triangular matrix)
+	virtual bool IsInterleaved() const { return false; }
+	// Processes the element
+	virtual void RunOnElement( int threadIndex, int index ) = 0;
+	// Called once per thread after all of its elements are processed
+	virtual void OnThreadFinished( int /*threadIndex*/ ) {}
+
+	IThreadPool& ThreadPool; // executors
+
+private:
+	void runSplittedByThreads( int threadIndex );
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+
+// Calculates the distance between the cluster center and the element
+// Gives the same result as CalcDistance, but doesn't allocate memory when the element is dense
+double CalcClusterToVectorDistance( const CClusterCenter& cluster, const CFloatVectorDesc& element, TDistanceFunc distanceFunc );
+
+} // namespace NeoML
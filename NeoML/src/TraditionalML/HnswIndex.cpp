@@ -0,0 +1,649 @@
+/* Copyright © 2017-2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#include <common.h>
+#pragma hdrstop
+
+#include <NeoML/TraditionalML/HnswIndex.h>
+#include <NeoML/Random.h>
+#include <NeoML/Dnn/DnnBlob.h>
+#include <NeoMathEngine/ThreadPool.h>
+#include <float.h>
+#include <memory>
+
+namespace NeoML {
+
+// The maximum level of a vector in the graph
+static constexpr int HnswMaxLevel = 32;
+
+// Squared Euclidean distance between dense vectors
+// Independent accumulators let the compiler vectorize the loop
+static inline float hnswSquaredL2( const float* first, const float* second, int size )
+{
+	float sum0 = 0.f;
+	float sum1 = 0.f;
+	float sum2 = 0.f;
+	float sum3 = 0.f;
+	int i = 0;
+	for( ; i + 4 <= size; i += 4 ) {
+		const float diff0 = first[i] - second[i];
+		const float diff1 = first[i + 1] - second[i + 1];
+		const float diff2 = first[i + 2] - second[i + 2];
+		const float diff3 = first[i + 3] - second[i + 3];
+		sum0 += diff0 * diff0;
+		sum1 += diff1 * diff1;
+		sum2 += diff2 * diff2;
+		sum3 += diff3 * diff3;
+	}
+	for( ; i < size; ++i ) {
+		const float diff = first[i] - second[i];
+		sum0 += diff * diff;
+	}
+	return ( sum0 + sum1 ) + ( sum2 + sum3 );
+}
+
+// Dot product of dense vectors
+static inline float hnswDotProduct( const float* first, const float* second, int size )
+{
+	float sum0 = 0.f;
+	float sum1 = 0.f;
+	float sum2 = 0.f;
+	float sum3 = 0.f;
+	int i = 0;
+	for( ; i + 4 <= size; i += 4 ) {
+		sum0 += first[i] * second[i];
+		sum1 += first[i + 1] * second[i + 1];
+		sum2 += first[i + 2] * second[i + 2];
+		sum3 += first[i + 3] * second[i + 3];
+	}
+	for( ; i < size; ++i ) {
+		sum0 += first[i] * second[i];
+	}
+	return ( sum0 + sum1 ) + ( sum2 + sum3 );
+}
+
+// Writes the vector to the dense buffer; normalizes it if necessary
+static void hnswCopyVector( const CFloatVectorDesc& vector, int featureCount, bool normalize, float* result )
+{
+	if( vector.Indexes == nullptr ) {
+		NeoAssert( vector.Size <= featureCount );
+		::memcpy( result, vector.Values, vector.Size * sizeof( float ) );
+		::memset( result + vector.Size, 0, ( featureCount - vector.Size ) * sizeof( float ) );
+	} else {
+		::memset( result, 0, featureCount * sizeof( float ) );
+		for( int i = 0; i < vector.Size; ++i ) {
+			NeoAssert( 0 <= vector.Indexes[i] && vector.Indexes[i] < featureCount );
+			result[vector.Indexes[i]] = vector.Values[i];
+		}
+	}
+
+	if( normalize ) {
+		const float norm = sqrtf( hnswDotProduct( result, result, featureCount ) );
+		if( norm > 0 ) {
+			for( int i = 0; i < featureCount; ++i ) {
+				result[i] /= norm;
+			}
+		}
+	}
+}
+
+// Creates the descriptor of the dense matrix with the data of the blob
+static CFloatMatrixDesc hnswGetBlobMatrix( const CDnnBlob& blob, CArray<float>& values, CArray<int>& pointers )
+{
+	NeoAssert( blob.GetDataType() == CT_Float );
+	const int height = blob.GetObjectCount();
+	const int width = blob.GetObjectSize();
+	values.SetSize( blob.GetDataSize() );
+	blob.CopyTo( values.GetPtr() );
+	pointers.SetSize( height + 1 );
+	for( int i = 0; i <= height; ++i ) {
+		pointers[i] = i * width;
+	}
+
+	CFloatMatrixDesc desc;
+	desc.Height = height;
+	desc.Width = width;
+	desc.Values = values.GetPtr();
+	desc.PointerB = pointers.GetPtr();
+	desc.PointerE = pointers.GetPtr() + 1;
+	return desc;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+// The buffers used by a single thread during the search
+struct CHnswIndex::CSearchBuffers {
+	// The dense copy of the query
+	CArray<float> Query;
+	// The copy of the links of the vector being processed
+	CArray<int> Links;
+	// The neighbors of the vector being processed
+	CArray<CNearestNeighbor> Neighbors;
+	// The vectors whose tag is equal to VisitedTag have been visited during the current search
+	CArray<unsigned int> Visited;
+	unsigned int VisitedTag = 0;
+	// The candidates to be processed, the closest one at the top
+	CPriorityQueue<CArray<CNearestNeighbor>,
+		DescendingByMember<CNearestNeighbor, float, &CNearestNeighbor::Distance>> Candidates;
+	// The closest vectors found, the farthest one at the top
+	CPriorityQueue<CArray<CNearestNeighbor>,
+		AscendingByMember<CNearestNeighbor, float, &CNearestNeighbor::Distance>> Found;
+
+	// Resets the buffers before the search on the specified level
+	void Start( int vectorCount );
+	// Checks if the vector has already been visited and marks it as visited
+	bool Visit( int index );
+};
+
+void CHnswIndex::CSearchBuffers::Start( int vectorCount )
+{
+	if( Visited.Size() < vectorCount ) {
+		Visited.Add( 0, vectorCount - Visited.Size() );
+	}
+	++VisitedTag;
+	if( VisitedTag == 0 ) {
+		// Overflow
+		for( int i = 0; i < Visited.Size(); ++i ) {
+			Visited[i] = 0;
+		}
+		VisitedTag = 1;
+	}
+	Candidates.Reset();
+	Found.Reset();
+}
+
+bool CHnswIndex::CSearchBuffers::Visit( int index )
+{
+	if( Visited[index] == VisitedTag ) {
+		return false;
+	}
+	Visited[index] = VisitedTag;
+	return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+// Inserts the vectors into the graph in multiple threads
+// The links of every vector are protected by its own lock
+class CHnswIndex::CBuilder {
+public:
+	explicit CBuilder( CHnswIndex& index );
+
+	// Inserts all the vectors into the graph
+	void Run();
+	// Copies the links of the vector on the level
+	void CopyLinks( int index, int level, CArray<int>& result );
+
+private:
+	CHnswIndex& index;
+	std::unique_ptr<CCriticalSection[]> locks;
+	// Protects the entry point of the graph
+	CCriticalSection entryPointLock;
+	CPointerArray<CSearchBuffers> buffers;
+
+	void insert( int vectorIndex, CSearchBuffers& threadBuffers );
+	void selectNeighbors( const CArray<CNearestNeighbor>& sorted, int maxCount, CArray<int>& result ) const;
+	void addLink( int from, int to, int level, CSearchBuffers& threadBuffers );
+};
+
+CHnswIndex::CBuilder::CBuilder( CHnswIndex& _index ) :
+	index( _index ),
+	locks( new CCriticalSection[index.GetVectorCount()] )
+{
+	for( int i = 0; i < index.threadPool->Size(); ++i ) {
+		buffers.Add( FINE_DEBUG_NEW CSearchBuffers() );
+	}
+}
+
+void CHnswIndex::CBuilder::Run()
+{
+	const int vectorCount = index.GetVectorCount();
+	if( vectorCount == 0 ) {
+		return;
+	}
+	index.entryPoint = 0;
+	if( vectorCount == 1 ) {
+		return;
+	}
+
+	const int threadCount = index.threadPool->Size();
+	if( threadCount == 1 ) {
+		for( int i = 1; i < vectorCount; ++i ) {
+			insert( i, *buffers[0] );
+		}
+		return;
+	}
+
+	// The vectors are distributed in the round-robin manner so that the graph grows evenly
+	NEOML_NUM_THREADS( *index.threadPool, this, []( int threadIndex, void* ptr ) {
+		CBuilder& builder = *static_cast<CBuilder*>( ptr );
+		const int count = builder.index.GetVectorCount();
+		const int step = builder.index.threadPool->Size();
+		for( int i = 1 + threadIndex; i < count; i += step ) {
+			builder.insert( i, *builder.buffers[threadIndex] );
+		}
+	} );
+}
+
+void CHnswIndex::CBuilder::CopyLinks( int vectorIndex, int level, CArray<int>& result )
+{
+	CCriticalSectionLock lock( locks[vectorIndex] );
+	const int* vectorLinks = index.getLinks( vectorIndex, level );
+	result.SetSize( vectorLinks[0] );
+	for( int i = 0; i < vectorLinks[0]; ++i ) {
+		result[i] = vectorLinks[i + 1];
+	}
+}
+
+void CHnswIndex::CBuilder::insert( int vectorIndex, CSearchBuffers& threadBuffers )
+{
+	const int level = index.levels[vectorIndex];
+	const float* vector = index.getVector( vectorIndex );
+
+	// The lock is held during the whole insertion if the vector becomes the new entry point
+	CCriticalSectionLock entryLock( entryPointLock );
+	const int entry = index.entryPoint;
+	const int maxLevel = index.levels[entry];
+	if( level <= maxLevel ) {
+		entryLock.Unlock();
+	}
+
+	int closest = index.greedySearch( vector, entry, maxLevel, level, this );
+	for( int currLevel = min( level, maxLevel ); currLevel >= 0; --currLevel ) {
+		threadBuffers.Start( index.GetVectorCount() );
+		threadBuffers.Visit( closest );
+		threadBuffers.Found.Push( CNearestNeighbor( closest, index.calcDistance( vector, index.getVector( closest ) ) ) );
+		index.searchLevel( vector, currLevel, index.params.ConstructionListSize, threadBuffers, this );
+
+		CArray<CNearestNeighbor> sorted;
+		threadBuffers.Found.DetachAndSort( sorted );
+		closest = sorted[0].Index;
+
+		CArray<int> neighbors;
+		selectNeighbors( sorted, index.params.MaxLinks, neighbors );
+		{
+			CCriticalSectionLock lock( locks[vectorIndex] );
+			int* vectorLinks = index.getLinks( vectorIndex, currLevel );
+			vectorLinks[0] = neighbors.Size();
+			for( int i = 0; i < neighbors.Size(); ++i ) {
+				vectorLinks[i + 1] = neighbors[i];
+			}
+		}
+		for( int i = 0; i < neighbors.Size(); ++i ) {
+			addLink( neighbors[i], vectorIndex, currLevel, threadBuffers );
+		}
+	}
+
+	if( level > maxLevel ) {
+		index.entryPoint = vectorIndex;
+	}
+}
+
+// Selects the neighbors by the heuristic from the original paper:
+// the candidate is skipped if it's closer to one of the already selected neighbors than to the vector
+// The remaining space is filled with the skipped candidates
+void CHnswIndex::CBuilder::selectNeighbors( const CArray<CNearestNeighbor>& sorted, int maxCount,
+	CArray<int>& result ) const
+{
+	result.Empty();
+	if( sorted.Size() <= maxCount ) {
+		for( int i = 0; i < sorted.Size(); ++i ) {
+			result.Add( sorted[i].Index );
+		}
+		return;
+	}
+
+	CArray<int> skipped;
+	for( int i = 0; i < sorted.Size() && result.Size() < maxCount; ++i ) {
+		const float* candidate = index.getVector( sorted[i].Index );
+		bool isGood = true;
+		for( int j = 0; j < result.Size(); ++j ) {
+			if( index.calcDistance( candidate, index.getVector( result[j] ) ) < sorted[i].Distance ) {
+				isGood = false;
+				break;
+			}
+		}
+		if( isGood ) {
+			result.Add( sorted[i].Index );
+		} else {
+			skipped.Add( sorted[i].Index );
+		}
+	}
+	for( int i = 0; i < skipped.Size() && result.Size() < maxCount; ++i ) {
+		result.Add( skipped[i] );
+	}
+}
+
+// Adds the link to the vector; reselects its neighbors if there are too many of them
+void CHnswIndex::CBuilder::addLink( int from, int to, int level, CSearchBuffers& threadBuffers )
+{
+	CCriticalSectionLock lock( locks[from] );
+	int* fromLinks = index.getLinks( from, level );
+	const int maxCount = index.maxLinks( level );
+	if( fromLinks[0] < maxCount ) {
+		fromLinks[++fromLinks[0]] = to;
+		return;
+	}
+
+	const float* fromVector = index.getVector( from );
+	CArray<CNearestNeighbor>& candidates = threadBuffers.Neighbors;
+	candidates.Empty();
+	for( int i = 1; i <= fromLinks[0]; ++i ) {
+		candidates.Add( CNearestNeighbor( fromLinks[i], index.calcDistance( fromVector, index.getVector( fromLinks[i] ) ) ) );
+	}
+	candidates.Add( CNearestNeighbor( to, index.calcDistance( fromVector, index.getVector( to ) ) ) );
+	candidates.QuickSort<AscendingByMember<CNearestNeighbor, float, &CNearestNeighbor::Distance>>();
+
+	CArray<int> neighbors;
+	selectNeighbors( candidates, maxCount, neighbors );
+	fromLinks[0] = neighbors.Size();
+	for( int i = 0; i < neighbors.Size(); ++i ) {
+		fromLinks[i + 1] = neighbors[i];
+	}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+CHnswIndex::CHnswIndex() :
+	CHnswIndex( CParam() )
+{
+}
+
+CHnswIndex::CHnswIndex( const CParam& _params ) :
+	threadPool( CreateThreadPool( _params.ThreadCount ) ),
+	params( _params, threadPool->Size() ),
+	featuresCount( 0 ),
+	entryPoint( NotFound )
+{
+	NeoAssert( threadPool != nullptr );
+	NeoAssert( params.DistanceFunc == DF_Euclid || params.DistanceFunc == DF_Cosine );
+	NeoAssert( params.MaxLinks > 1 );
+	NeoAssert( params.ConstructionListSize > 0 );
+	NeoAssert( params.SearchListSize > 0 );
+}
+
+CHnswIndex::~CHnswIndex()
+{
+	delete threadPool;
+}
+
+void CHnswIndex::Build( const CFloatMatrixDesc& data )
+{
+	initialize( data.Height, data.Width );
+	for( int i = 0; i < data.Height; ++i ) {
+		addVector( i, data.GetRow( i ) );
+	}
+	CBuilder( *this ).Run();
+}
+
+void CHnswIndex::Build( const CDnnBlob& data )
+{
+	CArray<float> values;
+	CArray<int> pointers;
+	Build( hnswGetBlobMatrix( data, values, pointers ) );
+}
+
+void CHnswIndex::Search( const CFloatVectorDesc& query, int k, CArray<CNearestNeighbor>& result, int listSize ) const
+{
+	CSearchBuffers* buffers = takeSearchBuffers();
+	hnswCopyVector( query, featuresCount, params.DistanceFunc == DF_Cosine, buffers->Query.GetPtr() );
+	searchQuery( buffers->Query.GetPtr(), k, listSize, *buffers, result );
+	returnSearchBuffers( buffers );
+}
+
+void CHnswIndex::Search( const CFloatMatrixDesc& queries, int k, CArray<CArray<CNearestNeighbor>>& results,
+	int listSize ) const
+{
+	NeoAssert( queries.Width <= featuresCount );
+	results.DeleteAll();
+	results.SetSize( queries.Height );
+
+	const int threadCount = threadPool->Size();
+	CArray<CSearchBuffers*> buffers;
+	for( int i = 0; i < threadCount; ++i ) {
+		buffers.Add( takeSearchBuffers() );
+	}
+
+	auto searchRange = [&]( int threadIndex ) {
+		int start = 0;
+		int count = 0;
+		if( GetTaskIndexAndCount( threadCount, threadIndex, queries.Height, start, count ) ) {
+			CSearchBuffers& threadBuffers = *buffers[threadIndex];
+			for( int i = start; i < start + count; ++i ) {
+				hnswCopyVector( queries.GetRow( i ), featuresCount, params.DistanceFunc == DF_Cosine,
+					threadBuffers.Query.GetPtr() );
+				searchQuery( threadBuffers.Query.GetPtr(), k, listSize, threadBuffers, results[i] );
+			}
+		}
+	};
+	if( threadCount == 1 || queries.Height < 2 ) {
+		searchRange( 0 );
+	} else {
+		NEOML_NUM_THREADS( *threadPool, &searchRange, []( int threadIndex, void* ptr ) {
+			( *static_cast<decltype( searchRange )*>( ptr ) )( threadIndex );
+		} );
+	}
+	for( int i = 0; i < buffers.Size(); ++i ) {
+		returnSearchBuffers( buffers[i] );
+	}
+}
+
+void CHnswIndex::Search( const CDnnBlob& queries, int k, CArray<CArray<CNearestNeighbor>>& results,
+	int listSize ) const
+{
+	CArray<float> values;
+	CArray<int> pointers;
+	Search( hnswGetBlobMatrix( queries, values, pointers ), k, results, listSize );
+}
+
+static const int HnswIndexVersion = 0;
+
+void CHnswIndex::Serialize( CArchive& archive )
+{
+	archive.SerializeVersion( HnswIndexVersion );
+	if( archive.IsStoring() ) {
+		archive << static_cast<int>( params.DistanceFunc );
+		archive << params.MaxLinks << params.ConstructionListSize << params.SearchListSize << params.Seed;
+		archive << featuresCount << entryPoint;
+		archive << levels << linksOffsets << links << vectors;
+	} else if( archive.IsLoading() ) {
+		int distanceFunc = 0;
+		archive >> distanceFunc;
+		params.DistanceFunc = static_cast<TDistanceFunc>( distanceFunc );
+		archive >> params.MaxLinks >> params.ConstructionListSize >> params.SearchListSize >> params.Seed;
+		archive >> featuresCount >> entryPoint;
+		archive >> levels >> linksOffsets >> links >> vectors;
+		check( vectors.Size() == levels.Size() * featuresCount && linksOffsets.Size() == levels.Size(),
+			ERR_BAD_ARCHIVE, archive.Name() );
+	} else {
+		NeoAssert( false );
+	}
+}
+
+const int* CHnswIndex::getLinks( int index, int level ) const
+{
+	NeoPresume( level <= levels[index] );
+	const int offset = linksOffsets[index] + ( level == 0 ? 0 : 2 * params.MaxLinks + 1 + ( level - 1 ) * ( params.MaxLinks + 1 ) );
+	return links.GetPtr() + offset;
+}
+
+int* CHnswIndex::getLinks( int index, int level )
+{
+	return const_cast<int*>( static_cast<const CHnswIndex*>( this )->getLinks( index, level ) );
+}
+
+float CHnswIndex::calcDistance( const float* first, const float* second ) const
+{
+	if( params.DistanceFunc == DF_Cosine ) {
+		return 1.f - hnswDotProduct( first, second, featuresCount );
+	}
+	return hnswSquaredL2( first, second, featuresCount );
+}
+
+// Allocates the storage and selects the random levels of the vectors
+void CHnswIndex::initialize( int vectorCount, int featureCount )
+{
+	NeoAssert( vectorCount >= 0 );
+	NeoAssert( featureCount > 0 );
+	featuresCount = featureCount;
+	entryPoint = NotFound;
+	searchBuffers.DeleteAll();
+	vectors.SetSize( vectorCount * featuresCount );
+
+	CRandom random( params.Seed );
+	const double levelMultiplier = 1. / log( static_cast<double>( params.MaxLinks ) );
+	levels.SetSize( vectorCount );
+	linksOffsets.SetSize( vectorCount );
+	int linksSize = 0;
+	for( int i = 0; i < vectorCount; ++i ) {
+		const double uniform = max( random.Uniform( 0, 1 ), DBL_MIN );
+		levels[i] = min( HnswMaxLevel, static_cast<int>( -log( uniform ) * levelMultiplier ) );
+		linksOffsets[i] = linksSize;
+		linksSize += 2 * params.MaxLinks + 1 + levels[i] * ( params.MaxLinks + 1 );
+	}
+	links.DeleteAll();
+	links.Add( 0, linksSize );
+}
+
+void CHnswIndex::addVector( int index, const CFloatVectorDesc& vector )
+{
+	hnswCopyVector( vector, featuresCount, params.DistanceFunc == DF_Cosine,
+		vectors.GetPtr() + static_cast<size_t>( index ) * featuresCount );
+}
+
+// Takes the buffers left by a previous search or creates new ones
+// The visited marks are kept, so a search does not have to allocate and clear them for every query
+CHnswIndex::CSearchBuffers* CHnswIndex::takeSearchBuffers() const
+{
+	CSearchBuffers* buffers = nullptr;
+	{
+		CCriticalSectionLock lock( searchBuffersLock );
+		if( !searchBuffers.IsEmpty() ) {
+			buffers = searchBuffers.DetachAt( searchBuffers.Size() - 1 );
+		}
+	}
+	if( buffers == nullptr ) {
+		buffers = FINE_DEBUG_NEW CSearchBuffers();
+	}
+	buffers->Query.SetSize( featuresCount );
+	return buffers;
+}
+
+void CHnswIndex::returnSearchBuffers( CSearchBuffers* buffers ) const
+{
+	CCriticalSectionLock lock( searchBuffersLock );
+	searchBuffers.Add( buffers );
+}
+
+void CHnswIndex::searchQuery( const float* query, int k, int listSize, CSearchBuffers& buffers,
+	CArray<CNearestNeighbor>& result ) const
+{
+	NeoAssert( k > 0 );
+	result.Empty();
+	if( entryPoint == NotFound ) {
+		return;
+	}
+
+	const int closest = greedySearch( query, entryPoint, levels[entryPoint], 0, nullptr );
+	buffers.Start( GetVectorCount() );
+	buffers.Visit( closest );
+	buffers.Found.Push( CNearestNeighbor( closest, calcDistance( query, getVector( closest ) ) ) );
+	searchLevel( query, 0, max( k, listSize > 0 ? listSize : params.SearchListSize ), buffers, nullptr );
+
+	buffers.Found.DetachAndSort( result );
+	if( result.Size() > k ) {
+		result.SetSize( k );
+	}
+}
+
+// Searches for the closest vectors on the level starting from the vectors in buffers.Found
+// The result is stored in buffers.Found
+void CHnswIndex::searchLevel( const float* query, int level, int listSize, CSearchBuffers& buffers,
+	CBuilder* builder ) const
+{
+	for( int i = 0; i < buffers.Found.GetBuffer().Size(); ++i ) {
+		buffers.Candidates.Push( buffers.Found.GetBuffer()[i] );
+	}
+
+	CNearestNeighbor candidate;
+	while( buffers.Candidates.Pop( candidate ) ) {
+		if( buffers.Found.Size() >= listSize && candidate.Distance > buffers.Found.Peek().Distance ) {
+			break;
+		}
+
+		const int* candidateLinks = nullptr;
+		int linksCount = 0;
+		if( builder != nullptr ) {
+			builder->CopyLinks( candidate.Index, level, buffers.Links );
+			candidateLinks = buffers.Links.GetPtr();
+			linksCount = buffers.Links.Size();
+		} else {
+			candidateLinks = getLinks( candidate.Index, level );
+			linksCount = *candidateLinks++;
+		}
+
+		for( int i = 0; i < linksCount; ++i ) {
+			const int neighbor = candidateLinks[i];
+			if( !buffers.Visit( neighbor ) ) {
+				continue;
+			}
+			const float distance = calcDistance( query, getVector( neighbor ) );
+			if( buffers.Found.Size() < listSize || distance < buffers.Found.Peek().Distance ) {
+				buffers.Candidates.Push( CNearestNeighbor( neighbor, distance ) );
+				buffers.Found.Push( CNearestNeighbor( neighbor, distance ) );
+				if( buffers.Found.Size() > listSize ) {
+					buffers.Found.Pop();
+				}
+			}
+		}
+	}
+	buffers.Candidates.Reset();
+}
+
+// Goes down from the fromLevel to the level above the toLevel, each time moving to the closest neighbor
+// Returns the closest vector found
+int CHnswIndex::greedySearch( const float* query, int entry, int fromLevel, int toLevel, CBuilder* builder ) const
+{
+	int closest = entry;
+	float closestDistance = calcDistance( query, getVector( closest ) );
+	CArray<int> linksCopy;
+	for( int level = fromLevel; level > toLevel; --level ) {
+		bool isChanged = true;
+		while( isChanged ) {
+			isChanged = false;
+			const int* closestLinks = nullptr;
+			int linksCount = 0;
+			if( builder != nullptr ) {
+				builder->CopyLinks( closest, level, linksCopy );
+				closestLinks = linksCopy.GetPtr();
+				linksCount = linksCopy.Size();
+			} else {
+				closestLinks = getLinks( closest, level );
+				linksCount = *closestLinks++;
+			}
+			for( int i = 0; i < linksCount; ++i ) {
+				const float distance = calcDistance( query, getVector( closestLinks[i] ) );
+				if( distance < closestDistance ) {
+					closestDistance = distance;
+					closest = closestLinks[i];
+					isChanged = true;
+				}
+			}
+		}
+	}
+	return closest;
+}
+
+} // namespace NeoML
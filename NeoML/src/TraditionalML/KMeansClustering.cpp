@@ -811,6 +811,13 @@ bool CKMeansClustering::runClusterization( const IClusteringData* input, int see
 		*log << "\nK-means clustering started:\n";
 	}
 
+	// Mini-batch algorithm (uses MathEngine, doesn't copy the whole data)
+	if( params.Algo == KMA_MiniBatch ) {
+		NeoAssert( matrix.Columns == nullptr );
+		NeoAssert( params.DistanceFunc == DF_Euclid );
+		return denseMiniBatchL2Clusterize( input, seed, result, inertia );
+	}
+
 	// Specific optimized case (uses MathEngine)
 	if( matrix.Columns == nullptr && params.DistanceFunc == DF_Euclid && params.Algo == KMA_Lloyd ) {
 		return denseLloydL2Clusterize( input, seed, result, inertia );
@@ -878,11 +885,13 @@ bool CKMeansClustering::denseLloydL2Clusterize( const IClusteringData* rawData,
 	CPtr<CDnnBlob> sizes = CDnnBlob::CreateVector( *mathEngine, CT_Float, clusterCount ); // no threads
 	CPtr<CDnnBlob> labels = CDnnBlob::CreateVector( *mathEngine, CT_Int, vectorCount ); // no threads
 
-	static_assert( KMA_Count == 2, "KMA_Count != 2" );
+	static_assert( KMA_Count == 3, "KMA_Count != 3" );
 	switch( params.Algo ) {
 		case KMA_Lloyd:
 			success = lloydBlobClusterization( *data, *weight, *centers, *sizes, *labels, inertia );
 			break;
+		case KMA_MiniBatch:
+			// Mini-batch algorithm is processed by denseMiniBatchL2Clusterize
 		case KMA_Elkan:
 			// Only Lloyd algorithm is supported for dense data
 		default:
@@ -943,7 +952,8 @@ void CKMeansClustering::selectInitialClusters( const CFloatMatrixDesc& matrix, i
 
 	if( params.Initialization == KMI_Default ) {
 		defaultInitialization( matrix, seed );
-	} else if( params.Initialization == KMI_KMeansPlusPlus ) {
+	} else if( params.Initialization == KMI_KMeansPlusPlus || params.Initialization == KMI_KMeansParallel ) {
+		// KMeans|| is implemented only for dense data in Euclidean space
 		kMeansPlusPlusInitialization( matrix, seed );
 	} else {
 		NeoAssert( false );
@@ -1140,7 +1150,7 @@ void CKMeansClustering::selectInitialClusters( const CDnnBlob& data, int seed, C
 		return;
 	}
 
-	static_assert( KMI_Count == 2, "KMI_Count != 2" );
+	static_assert( KMI_Count == 3, "KMI_Count != 3" );
 	switch( params.Initialization ) {
 		case KMI_Default:
 			defaultInitialization( data, seed, centers );
@@ -1148,6 +1158,9 @@ void CKMeansClustering::selectInitialClusters( const CDnnBlob& data, int seed, C
 		case KMI_KMeansPlusPlus:
 			kMeansPlusPlusInitialization( data, seed, centers );
 			break;
+		case KMI_KMeansParallel:
+			kMeansParallelInitialization( data, seed, centers );
+			break;
 		default:
 			NeoAssert( false );
 	}
@@ -1415,4 +1428,382 @@ void CKMeansClustering::calcClusterVariances( const CDnnBlob& data, const CDnnBl
 	}
 }
 
+// Copies the given rows of dense data into the blob
+static void copyRowsToBlob( const CFloatMatrixDesc& data, const CArray<int>& rows, CDnnBlob& blob )
+{
+	NeoAssert( data.Columns == nullptr );
+	NeoAssert( blob.GetObjectCount() == rows.Size() );
+	NeoAssert( blob.GetObjectSize() == data.Width );
+	const int featureCount = data.Width;
+	CDnnBlobBuffer<float> buffer( blob, TDnnBlobBufferAccess::Write );
+	float* currPtr = buffer;
+	for( int i = 0; i < rows.Size(); ++i ) {
+		::memcpy( currPtr, data.Values + data.PointerB[rows[i]], featureCount * sizeof( float ) );
+		currPtr += featureCount;
+	}
+	buffer.Close();
+}
+
+// Selects initial centers by using K-Means|| algo from dense data
+void CKMeansClustering::kMeansParallelInitialization( const CDnnBlob& data, int seed, CDnnBlob& centers )
+{
+	const int vectorCount = data.GetObjectCount();
+	const int featureCount = data.GetObjectSize();
+	const int clusterCount = params.InitialClustersCount;
+	NeoAssert( vectorCount >= clusterCount );
+	IMathEngine& mathEngine = data.GetMathEngine();
+
+	CPtr<CDnnBlob> squaredData = CDnnBlob::CreateVector( mathEngine, CT_Float, vectorCount ); // no threads
+	mathEngine.RowMultiplyMatrixByMatrix( data.GetData(), data.GetData(), vectorCount, featureCount, // no threads
+		squaredData->GetData() );
+
+	CFloatHandleStackVar stackBuff( mathEngine, 2 * vectorCount );
+	CFloatHandle minDists = stackBuff;
+	CFloatHandle currDists = stackBuff + vectorCount;
+	CPtr<CDnnBlob> labels = CDnnBlob::CreateVector( mathEngine, CT_Int, vectorCount ); // no threads
+	CIntHandle labelsHandle = labels->GetData<int>();
+
+	// The first candidate is chosen uniformly
+	CRandom random( seed );
+	CArray<int> candidates;
+	candidates.Add( random.UniformInt( 0, vectorCount - 1 ) );
+	mathEngine.MatrixRowsToVectorSquaredL2Distance( data.GetData(), vectorCount, featureCount, // no threads
+		data.GetObjectData( candidates[0] ), minDists );
+
+	// Each round samples every vector with the probability proportional to its distance to the candidates
+	const double oversampling = params.KMeansParallelOversampling * clusterCount;
+	CArray<float> dists;
+	dists.SetSize( vectorCount );
+	for( int round = 0; round < params.KMeansParallelRounds; ++round ) {
+		mathEngine.DataExchangeTyped<float>( dists.GetPtr(), minDists, vectorCount ); // no threads
+		double sum = 0;
+		for( int i = 0; i < vectorCount; ++i ) {
+			sum += dists[i];
+		}
+		if( sum <= 0 ) {
+			// Every vector coincides with one of the candidates
+			break;
+		}
+
+		CArray<int> newCandidates;
+		for( int i = 0; i < vectorCount; ++i ) {
+			if( dists[i] > 0 && random.Uniform( 0, 1 ) < oversampling * dists[i] / sum ) {
+				newCandidates.Add( i );
+			}
+		}
+		if( newCandidates.IsEmpty() ) {
+			continue;
+		}
+
+		CPtr<CDnnBlob> newCenters = CDnnBlob::CreateDataBlob( mathEngine, CT_Float, 1, newCandidates.Size(), featureCount ); // no threads
+		for( int i = 0; i < newCandidates.Size(); ++i ) {
+			CKMeansVectorCopyThreadTask( *threadPool, mathEngine, featureCount,
+				newCenters->GetObjectData( i ), data.GetObjectData( newCandidates[i] ) ).ParallelRun();
+		}
+		calcClosestDistances( *threadPool, data, *squaredData, *newCenters, currDists, labelsHandle );
+		mathEngine.VectorEltwiseMin( currDists, minDists, minDists, vectorCount ); // no threads
+		candidates.Add( newCandidates );
+	}
+
+	// Fill in the remaining centers with random vectors if there are not enough candidates
+	if( candidates.Size() < clusterCount ) {
+		CHashTable<int> used;
+		for( int i = 0; i < candidates.Size(); ++i ) {
+			used.Add( candidates[i] );
+		}
+		while( candidates.Size() < clusterCount ) {
+			const int next = random.UniformInt( 0, vectorCount - 1 );
+			if( !used.Has( next ) ) {
+				used.Add( next );
+				candidates.Add( next );
+			}
+		}
+	}
+
+	const int candidateCount = candidates.Size();
+	CPtr<CDnnBlob> candidateCenters = CDnnBlob::CreateDataBlob( mathEngine, CT_Float, 1, candidateCount, featureCount ); // no threads
+	for( int i = 0; i < candidateCount; ++i ) {
+		CKMeansVectorCopyThreadTask( *threadPool, mathEngine, featureCount,
+			candidateCenters->GetObjectData( i ), data.GetObjectData( candidates[i] ) ).ParallelRun();
+	}
+	if( candidateCount == clusterCount ) {
+		mathEngine.VectorCopy( centers.GetData(), candidateCenters->GetData(), centers.GetDataSize() ); // no threads
+		return;
+	}
+
+	// Weight every candidate by the number of vectors which are closer to it than to the others
+	calcClosestDistances( *threadPool, data, *squaredData, *candidateCenters, currDists, labelsHandle );
+	CArray<int> assignments;
+	assignments.SetSize( vectorCount );
+	labels->CopyTo( assignments.GetPtr() );
+	CArray<double> candidateWeights;
+	candidateWeights.Add( 0., candidateCount );
+	for( int i = 0; i < vectorCount; ++i ) {
+		candidateWeights[assignments[i]] += 1;
+	}
+
+	// Reduce the candidates to the final centers by weighted K-Means++
+	CArray<float> candidateData;
+	candidateData.SetSize( candidateCount * featureCount );
+	candidateCenters->CopyTo( candidateData.GetPtr() );
+	CArray<double> candidateDists;
+	candidateDists.Add( DBL_MAX, candidateCount );
+	CArray<int> chosen;
+	int lastChosen = random.UniformInt( 0, candidateCount - 1 );
+	chosen.Add( lastChosen );
+	while( chosen.Size() < clusterCount ) {
+		const float* lastCenter = candidateData.GetPtr() + lastChosen * featureCount;
+		double sum = 0;
+		for( int i = 0; i < candidateCount; ++i ) {
+			const float* candidate = candidateData.GetPtr() + i * featureCount;
+			double dist = 0;
+			for( int j = 0; j < featureCount; ++j ) {
+				const double diff = candidate[j] - lastCenter[j];
+				dist += diff * diff;
+			}
+			candidateDists[i] = min( candidateDists[i], dist );
+			sum += candidateWeights[i] * candidateDists[i];
+		}
+
+		lastChosen = NotFound;
+		if( sum > 0 ) {
+			const double scaledSum = random.Uniform( 0, 1 ) * sum;
+			double prefixSum = 0;
+			for( int i = 0; i < candidateCount; ++i ) {
+				prefixSum += candidateWeights[i] * candidateDists[i];
+				if( candidateDists[i] > 0 && prefixSum >= scaledSum ) {
+					lastChosen = i;
+					break;
+				}
+			}
+		}
+		if( lastChosen == NotFound ) {
+			// All the weighted distances are zero: take any candidate which hasn't been chosen yet
+			for( int i = 0; i < candidateCount && lastChosen == NotFound; ++i ) {
+				if( chosen.Find( i ) == NotFound ) {
+					lastChosen = i;
+				}
+			}
+		}
+		NeoAssert( lastChosen != NotFound );
+		chosen.Add( lastChosen );
+	}
+
+	for( int i = 0; i < clusterCount; ++i ) {
+		mathEngine.VectorCopy( centers.GetObjectData( i ), candidateCenters->GetObjectData( chosen[i] ), featureCount ); // no threads
+	}
+}
+
+// Clusterizes dense data by using mini-batch algorithm
+// Only the initialization sample and one batch of the data are copied to the blobs at a time
+bool CKMeansClustering::denseMiniBatchL2Clusterize( const IClusteringData* rawData, int seed, CClusteringResult& result,
+	double& inertia )
+{
+	NeoAssert( params.DistanceFunc == DF_Euclid );
+	NeoAssert( params.Algo == KMA_MiniBatch );
+	NeoAssert( params.MiniBatchSize > 0 );
+	NeoAssert( rawData->GetVectorCount() > params.InitialClustersCount );
+	const CFloatMatrixDesc matrix = rawData->GetMatrix();
+	const int vectorCount = rawData->GetVectorCount();
+	const int featureCount = rawData->GetFeaturesCount();
+	const int clusterCount = params.InitialClustersCount;
+
+	std::unique_ptr<IMathEngine> mathEngine( CreateCpuMathEngine( /*memoryLimit*/0u ) );
+	CPtr<CDnnBlob> centers = CDnnBlob::CreateDataBlob( *mathEngine, CT_Float, 1, clusterCount, featureCount ); // no threads
+
+	// The initial centers are selected from the random sample of the data
+	CRandom random( seed );
+	{
+		const int sampleSize = min( vectorCount, max( params.MiniBatchSize, 3 * clusterCount ) );
+		CArray<int> rows;
+		rows.SetSize( vectorCount );
+		for( int i = 0; i < vectorCount; ++i ) {
+			rows[i] = i;
+		}
+		for( int i = 0; i < sampleSize; ++i ) {
+			const int j = random.UniformInt( i, vectorCount - 1 );
+			swap( rows[i], rows[j] );
+		}
+		rows.SetSize( sampleSize );
+		CPtr<CDnnBlob> sample = CDnnBlob::CreateDataBlob( *mathEngine, CT_Float, 1, sampleSize, featureCount ); // no threads
+		copyRowsToBlob( matrix, rows, *sample );
+		selectInitialClusters( *sample, seed, *centers );
+	}
+
+	const bool success = miniBatchClusterization( *rawData, random, *centers );
+	inertia = assignAllClosest( *rawData, *centers, result );
+
+	if( log != 0 ) {
+		*log << "\nMini-batch clustering " << ( success ? "converged" : "needs more iterations" )
+			<< ", inertia: " << inertia << "\n";
+	}
+	return success;
+}
+
+// Updates the centers with the batches of randomly selected vectors
+bool CKMeansClustering::miniBatchClusterization( const IClusteringData& rawData, CRandom& random, CDnnBlob& centers )
+{
+	const CFloatMatrixDesc matrix = rawData.GetMatrix();
+	const int vectorCount = rawData.GetVectorCount();
+	const int featureCount = rawData.GetFeaturesCount();
+	const int clusterCount = params.InitialClustersCount;
+	const int batchSize = params.MiniBatchSize;
+	IMathEngine& mathEngine = centers.GetMathEngine();
+
+	CPtr<CDnnBlob> batch = CDnnBlob::CreateDataBlob( mathEngine, CT_Float, 1, batchSize, featureCount ); // no threads
+	CPtr<CDnnBlob> squaredBatch = CDnnBlob::CreateVector( mathEngine, CT_Float, batchSize ); // no threads
+	CPtr<CDnnBlob> batchLabels = CDnnBlob::CreateVector( mathEngine, CT_Int, batchSize ); // no threads
+	CPtr<CDnnBlob> batchDists = CDnnBlob::CreateVector( mathEngine, CT_Float, batchSize ); // no threads
+	CFloatHandle batchDistsHandle = batchDists->GetData();
+	CIntHandle batchLabelsHandle = batchLabels->GetData<int>();
+
+	CArray<int> rows;
+	rows.SetSize( batchSize );
+	CArray<int> labels;
+	labels.SetSize( batchSize );
+	CArray<float> centersData;
+	centersData.SetSize( clusterCount * featureCount );
+	CArray<float> oldCentersData;
+	CArray<bool> isMoved;
+	// The total weight of the vectors assigned to each center during all the iterations
+	CArray<double> counts;
+	counts.Add( 0., clusterCount );
+
+	for( int iter = 0; iter < params.MaxIterations; ++iter ) {
+		for( int i = 0; i < batchSize; ++i ) {
+			rows[i] = random.UniformInt( 0, vectorCount - 1 );
+		}
+		copyRowsToBlob( matrix, rows, *batch );
+		mathEngine.RowMultiplyMatrixByMatrix( batch->GetData(), batch->GetData(), batchSize, featureCount, // no threads
+			squaredBatch->GetData() );
+		calcClosestDistances( *threadPool, *batch, *squaredBatch, centers, batchDistsHandle, batchLabelsHandle );
+		batchLabels->CopyTo( labels.GetPtr() );
+
+		// Move every center towards its vectors with the per-center learning rate 1 / count
+		centers.CopyTo( centersData.GetPtr() );
+		centersData.CopyTo( oldCentersData );
+		isMoved.DeleteAll();
+		isMoved.Add( false, clusterCount );
+		for( int i = 0; i < batchSize; ++i ) {
+			const double weight = rawData.GetVectorWeight( rows[i] );
+			if( weight <= 0 ) {
+				continue;
+			}
+			const int label = labels[i];
+			counts[label] += weight;
+			const float rate = static_cast<float>( weight / counts[label] );
+			float* center = centersData.GetPtr() + label * featureCount;
+			const float* vector = matrix.Values + matrix.PointerB[rows[i]];
+			for( int j = 0; j < featureCount; ++j ) {
+				center[j] += rate * ( vector[j] - center[j] );
+			}
+			isMoved[label] = true;
+		}
+		double shift = 0;
+		for( int c = 0; c < clusterCount; ++c ) {
+			if( !isMoved[c] ) {
+				continue;
+			}
+			const float* center = centersData.GetPtr() + c * featureCount;
+			const float* oldCenter = oldCentersData.GetPtr() + c * featureCount;
+			for( int j = 0; j < featureCount; ++j ) {
+				const double diff = center[j] - oldCenter[j];
+				shift += diff * diff;
+			}
+		}
+		centers.CopyFrom( centersData.GetPtr() );
+
+		if( log != 0 ) {
+			*log << L"Batch " << iter << L" centers shift: " << shift << L"\n";
+		}
+		if( shift <= params.Tolerance ) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// Assigns every vector to its closest center and calculates the clusters' statistics
+// Returns the inertia
+double CKMeansClustering::assignAllClosest( const IClusteringData& rawData, const CDnnBlob& centers,
+	CClusteringResult& result )
+{
+	const CFloatMatrixDesc matrix = rawData.GetMatrix();
+	const int vectorCount = rawData.GetVectorCount();
+	const int featureCount = rawData.GetFeaturesCount();
+	const int clusterCount = params.InitialClustersCount;
+	IMathEngine& mathEngine = centers.GetMathEngine();
+
+	CArray<float> centersData;
+	centersData.SetSize( clusterCount * featureCount );
+	centers.CopyTo( centersData.GetPtr() );
+	CArray<double> sizes;
+	sizes.Add( 0., clusterCount );
+	CArray<double> sumOfSquares;
+	sumOfSquares.Add( 0., clusterCount * featureCount );
+
+	result.Data.SetSize( vectorCount );
+	double inertia = 0;
+
+	// The data is processed in chunks in order to limit the memory usage
+	const int chunkSize = min( vectorCount, max( params.MiniBatchSize,
+		static_cast<int>( DistanceBufferSize / ( sizeof( float ) * featureCount ) ) ) );
+	CArray<int> rows;
+	CArray<float> dists;
+	for( int chunkStart = 0; chunkStart < vectorCount; chunkStart += chunkSize ) {
+		const int currSize = min( chunkSize, vectorCount - chunkStart );
+		rows.SetSize( currSize );
+		for( int i = 0; i < currSize; ++i ) {
+			rows[i] = chunkStart + i;
+		}
+		CPtr<CDnnBlob> chunk = CDnnBlob::CreateDataBlob( mathEngine, CT_Float, 1, currSize, featureCount ); // no threads
+		copyRowsToBlob( matrix, rows, *chunk );
+		CPtr<CDnnBlob> squaredChunk = CDnnBlob::CreateVector( mathEngine, CT_Float, currSize ); // no threads
+		mathEngine.RowMultiplyMatrixByMatrix( chunk->GetData(), chunk->GetData(), currSize, featureCount, // no threads
+			squaredChunk->GetData() );
+		CPtr<CDnnBlob> chunkDists = CDnnBlob::CreateVector( mathEngine, CT_Float, currSize ); // no threads
+		CPtr<CDnnBlob> chunkLabels = CDnnBlob::CreateVector( mathEngine, CT_Int, currSize ); // no threads
+		CFloatHandle chunkDistsHandle = chunkDists->GetData();
+		CIntHandle chunkLabelsHandle = chunkLabels->GetData<int>();
+		calcClosestDistances( *threadPool, *chunk, *squaredChunk, centers, chunkDistsHandle, chunkLabelsHandle );
+
+		chunkLabels->CopyTo( result.Data.GetPtr() + chunkStart );
+		dists.SetSize( currSize );
+		chunkDists->CopyTo( dists.GetPtr() );
+		for( int i = 0; i < currSize; ++i ) {
+			const int label = result.Data[chunkStart + i];
+			const double weight = rawData.GetVectorWeight( chunkStart + i );
+			inertia += weight * max( 0.f, dists[i] );
+			sizes[label] += weight;
+			const float* center = centersData.GetPtr() + label * featureCount;
+			const float* vector = matrix.Values + matrix.PointerB[chunkStart + i];
+			double* sumOfSquaresPtr = sumOfSquares.GetPtr() + label * featureCount;
+			for( int j = 0; j < featureCount; ++j ) {
+				const double diff = vector[j] - center[j];
+				sumOfSquaresPtr[j] += weight * diff * diff;
+			}
+		}
+	}
+
+	result.ClusterCount = clusterCount;
+	result.Clusters.DeleteAll();
+	result.Clusters.SetBufferSize( clusterCount );
+	for( int i = 0; i < clusterCount; ++i ) {
+		CFloatVector center( featureCount );
+		CFloatVector variance( featureCount );
+		::memcpy( center.CopyOnWrite(), centersData.GetPtr() + i * featureCount, featureCount * sizeof( float ) );
+		const double sizeInv = sizes[i] > 0 ? 1. / sizes[i] : 1.;
+		for( int j = 0; j < featureCount; ++j ) {
+			variance.SetAt( j, static_cast<float>( sumOfSquares[i * featureCount + j] * sizeInv ) );
+		}
+
+		CClusterCenter& currentCenter = result.Clusters.Append();
+		currentCenter.Mean = center;
+		currentCenter.Disp = variance;
+		currentCenter.Norm = DotProduct( currentCenter.Mean, currentCenter.Mean );
+		currentCenter.Weight = 0;
+	}
+	return inertia;
+}
+
 } // namespace NeoML
@@ -21,12 +21,15 @@ limitations under the License.
 #include <NeoML/TraditionalML/OneVersusOne.h>
 #include <NeoML/TraditionalML/TrustRegionNewtonOptimizer.h>
 #include <LinearBinaryModel.h>
+#include <LinearStochasticSolver.h>
 #include <NeoML/TraditionalML/PlattScalling.h>
 
 namespace NeoML {
 
 ILinearBinaryModel::~ILinearBinaryModel() = default;
 
+IProblemChunkSource::~IProblemChunkSource() = default;
+
 // Normalizes the error weight
 static double normalizeErrorWeight( const CLinear::CParams& param, const IProblem& trainingClassificationData )
 {
@@ -72,6 +75,27 @@ static CFunctionWithHessian* createOptimizedFunction( const CLinear::CParams& pa
 	};
 }
 
+// Creates the classification model with the given plane
+static CPtr<IModel> createLinearBinaryModel( const CLinear::CParams& param, const CFloatVector& plane,
+	const IProblem& trainingClassificationData )
+{
+	CSigmoid sigmoidCoefficients;
+	if( param.SigmoidCoefficients.IsValid() ) {
+		sigmoidCoefficients = param.SigmoidCoefficients;
+	} else {
+		CFloatMatrixDesc matrix = trainingClassificationData.GetMatrix();
+		CFloatVectorDesc vector;
+		CArray<double> distances;
+		for( int i = 0; i < trainingClassificationData.GetVectorCount(); i++ ) {
+			matrix.GetRow( i, vector );
+			distances.Add( LinearFunction( plane, vector ) );
+		}
+		CalcSigmoidCoefficients( trainingClassificationData, distances, sigmoidCoefficients );
+	}
+
+	return FINE_DEBUG_NEW CLinearBinaryModel( plane, sigmoidCoefficients );
+}
+
 //---------------------------------------------------------------------------------------------------------
 
 CLinear::CLinear( const CParams& _params ) :
@@ -92,9 +116,15 @@ CPtr<IRegressionModel> CLinear::TrainRegression( const IRegressionProblem& probl
 {
 	if( function != 0 ) {
 		delete function; // delete the old loss function
+		function = 0;
 	}
 	const double errorWeight = params.NormalizeError ? normalizeErrorWeight( params, problem ) : params.ErrorWeight;
 	NeoAssert( params.Function == EF_L2_Regression );
+	if( params.Solver != LS_TrustRegionNewton ) {
+		CLinearStochasticSolver solver( params, errorWeight );
+		solver.SetLog( log );
+		return FINE_DEBUG_NEW CLinearBinaryModel( solver.Train( problem ), CSigmoid() );
+	}
 	function = FINE_DEBUG_NEW CL2Regression( problem, errorWeight, 1e-6, params.L1Coeff, params.ThreadCount );
 	const double tolerance = max( 1e-6, params.Tolerance );
 
@@ -127,6 +157,14 @@ CPtr<IModel> CLinear::Train( const IProblem& trainingClassificationData )
 
 	if( function != 0 ) {
 		delete function; // delete the old loss function
+		function = 0;
+	}
+	if( params.Solver != LS_TrustRegionNewton ) {
+		const double errorWeight = params.NormalizeError ? normalizeErrorWeight( params, trainingClassificationData )
+			: params.ErrorWeight;
+		CLinearStochasticSolver solver( params, errorWeight );
+		solver.SetLog( log );
+		return createLinearBinaryModel( params, solver.Train( trainingClassificationData ), trainingClassificationData );
 	}
 	function = createOptimizedFunction( params, trainingClassificationData );
 	const int vectorsCount = trainingClassificationData.GetVectorCount();
@@ -152,22 +190,32 @@ CPtr<IModel> CLinear::Train( const IProblem& trainingClassificationData )
 	optimizer.SetInitialArgument( initialPlane );
 	optimizer.Optimize();
 
-	CFloatVector plane = optimizer.GetOptimalArgument();
-	CSigmoid sigmoidCoefficients;
-	if( params.SigmoidCoefficients.IsValid() ) {
-		sigmoidCoefficients = params.SigmoidCoefficients;
-	} else {
-		CFloatMatrixDesc matrix = trainingClassificationData.GetMatrix();
-		CFloatVectorDesc vector;
-		CArray<double> distances;
-		for( int i = 0; i < vectorsCount; i++ ) {
-			matrix.GetRow( i, vector );
-			distances.Add( LinearFunction( plane, vector ) );
-		}
-		CalcSigmoidCoefficients( trainingClassificationData, distances, sigmoidCoefficients );
-	}
+	return createLinearBinaryModel( params, optimizer.GetOptimalArgument(), trainingClassificationData );
+}
 
+CPtr<ILinearBinaryModel> CLinear::TrainByChunks( IProblemChunkSource& data )
+{
+	NeoAssert( params.Solver != LS_TrustRegionNewton );
+	NeoAssert( params.Function != EF_L2_Regression );
+	CLinearStochasticSolver solver( params, params.ErrorWeight );
+	solver.SetLog( log );
+	const CFloatVector plane = solver.Train( data );
+
+	CSigmoid sigmoidCoefficients = params.SigmoidCoefficients;
+	if( !sigmoidCoefficients.IsValid() ) {
+		sigmoidCoefficients.A = -1.;
+		sigmoidCoefficients.B = 0.;
+	}
 	return FINE_DEBUG_NEW CLinearBinaryModel( plane, sigmoidCoefficients );
 }
 
+CPtr<ILinearRegressionModel> CLinear::TrainRegressionByChunks( IProblemChunkSource& data )
+{
+	NeoAssert( params.Solver != LS_TrustRegionNewton );
+	NeoAssert( params.Function == EF_L2_Regression );
+	CLinearStochasticSolver solver( params, params.ErrorWeight );
+	solver.SetLog( log );
+	return FINE_DEBUG_NEW CLinearBinaryModel( solver.Train( data ), CSigmoid() );
+}
+
 } // namespace NeoML
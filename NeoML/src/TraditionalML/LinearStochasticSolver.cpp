@@ -0,0 +1,401 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#include <common.h>
+#pragma hdrstop
+
+#include <LinearStochasticSolver.h>
+#include <NeoMathEngine/ThreadPool.h>
+
+namespace NeoML {
+
+// The dead zone of the L2 regression error, the same as in CLinear::TrainRegression
+static constexpr double StochasticRegressionDeadZone = 1e-6;
+
+static double getStochasticAnswer( const IProblem& problem, int index )
+{
+	return problem.GetBinaryClass( index );
+}
+
+static double getStochasticAnswer( const IRegressionProblem& problem, int index )
+{
+	return problem.GetValue( index );
+}
+
+// The chunk read from IProblemChunkSource, with the same methods as the problems have
+struct CStochasticChunk {
+	CFloatMatrixDesc Matrix;
+	const float* Answers;
+	const float* Weights;
+	bool IsRegression;
+
+	CFloatMatrixDesc GetMatrix() const { return Matrix; }
+	double GetVectorWeight( int index ) const { return Weights == nullptr ? 1. : Weights[index]; }
+};
+
+static double getStochasticAnswer( const CStochasticChunk& chunk, int index )
+{
+	if( chunk.IsRegression ) {
+		return chunk.Answers[index];
+	}
+	return chunk.Answers[index] > 0 ? 1. : -1.;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+CLinearStochasticSolver::CLinearStochasticSolver( const CLinear::CParams& _params, double _errorWeight ) :
+	params( _params ),
+	errorWeight( _errorWeight ),
+	threadPool( CreateThreadPool( _params.ThreadCount ) ),
+	log( nullptr ),
+	featureCount( 0 )
+{
+	NeoAssert( threadPool != nullptr );
+	NeoAssert( params.Solver == LS_Sgd || params.Solver == LS_AdaGrad || params.Solver == LS_Ftrl );
+	NeoAssert( params.LearningRate > 0 );
+	NeoAssert( params.BatchSize > 0 );
+}
+
+CLinearStochasticSolver::~CLinearStochasticSolver()
+{
+	delete threadPool;
+}
+
+CFloatVector CLinearStochasticSolver::Train( const IProblem& problem )
+{
+	return train( problem );
+}
+
+CFloatVector CLinearStochasticSolver::Train( const IRegressionProblem& problem )
+{
+	NeoAssert( params.Function == EF_L2_Regression );
+	return train( problem );
+}
+
+CFloatVector CLinearStochasticSolver::Train( IProblemChunkSource& data )
+{
+	initialize( data.GetFeatureCount() );
+	CArray<int> frequencies;
+	frequencies.Add( 0, featureCount );
+	double totalWeight = 0;
+	CStochasticChunk chunk{ CFloatMatrixDesc(), nullptr, nullptr, params.Function == EF_L2_Regression };
+	data.Reset();
+	while( data.GetNextChunk( chunk.Matrix, chunk.Answers, chunk.Weights ) ) {
+		countFrequencies( chunk.Matrix, frequencies );
+		for( int i = 0; i < chunk.Matrix.Height; ++i ) {
+			totalWeight += chunk.GetVectorWeight( i );
+		}
+	}
+	if( params.NormalizeError && totalWeight > 0 ) {
+		errorWeight = params.ErrorWeight / totalWeight;
+	}
+	initializeRegularization( frequencies );
+
+	return runEpochs( [&]( int epoch, double& loss, double& epochWeight ) {
+		// The chunks are read in the order of the source, only the batches inside them are shuffled
+		CRandom random( epoch + 1 );
+		data.Reset();
+		while( data.GetNextChunk( chunk.Matrix, chunk.Answers, chunk.Weights ) ) {
+			processChunk( chunk, epoch, random, loss, epochWeight );
+		}
+	} );
+}
+
+template<class TProblem>
+CFloatVector CLinearStochasticSolver::train( const TProblem& problem )
+{
+	const CFloatMatrixDesc matrix = problem.GetMatrix();
+	initialize( matrix.Width );
+	CArray<int> frequencies;
+	frequencies.Add( 0, featureCount );
+	countFrequencies( matrix, frequencies );
+	initializeRegularization( frequencies );
+
+	return runEpochs( [&]( int epoch, double& loss, double& totalWeight ) {
+		CRandom random( epoch + 1 );
+		processChunk( problem, epoch, random, loss, totalWeight );
+	} );
+}
+
+// Runs the epochs until the error stops decreasing
+// runEpoch( epoch, loss, totalWeight ) processes the training set once adding the errors and the weights of the vectors
+template<class TRunEpoch>
+CFloatVector CLinearStochasticSolver::runEpochs( const TRunEpoch& runEpoch )
+{
+	double prevLoss = 0;
+	for( int epoch = 0; epoch < params.EpochCount; ++epoch ) {
+		double loss = 0;
+		double totalWeight = 0;
+		runEpoch( epoch, loss, totalWeight );
+		loss = totalWeight > 0 ? loss / totalWeight : 0.;
+		if( log != nullptr ) {
+			*log << "Epoch " << epoch << ": loss = " << loss << "\n";
+		}
+		if( epoch > 0 && params.Tolerance > 0 && prevLoss - loss < params.Tolerance * prevLoss ) {
+			break;
+		}
+		prevLoss = loss;
+	}
+
+	CFloatVector plane( featureCount + 1 );
+	for( int i = 0; i <= featureCount; ++i ) {
+		plane.SetAt( i, static_cast<float>( getWeight( i ) ) );
+	}
+	return plane;
+}
+
+// Processes the batches of the chunk in a random order in all threads
+// Adds the errors on the vectors before their update and the weights of the vectors
+template<class TProblem>
+void CLinearStochasticSolver::processChunk( const TProblem& problem, int epoch, CRandom& random,
+	double& loss, double& totalWeight )
+{
+	const CFloatMatrixDesc matrix = problem.GetMatrix();
+	const int batchCount = ( matrix.Height + params.BatchSize - 1 ) / params.BatchSize;
+	CArray<int> batchOrder;
+	batchOrder.SetSize( batchCount );
+	for( int i = 0; i < batchCount; ++i ) {
+		batchOrder[i] = i;
+	}
+	for( int i = batchCount - 1; i > 0; --i ) {
+		swap( batchOrder[i], batchOrder[random.UniformInt( 0, i )] );
+	}
+
+	struct CTask {
+		CLinearStochasticSolver& Solver;
+		const TProblem& Problem;
+		const CFloatMatrixDesc& Matrix;
+		const CArray<int>& BatchOrder;
+		const int Epoch;
+		const int ThreadCount;
+		CArray<double> Losses;
+		CArray<double> Weights;
+	} task{ *this, problem, matrix, batchOrder, epoch, threadPool->Size(), {}, {} };
+	task.Losses.Add( 0., task.ThreadCount );
+	task.Weights.Add( 0., task.ThreadCount );
+
+	NEOML_NUM_THREADS( *threadPool, &task, []( int threadIndex, void* ptr ) {
+		CTask& task = *static_cast<CTask*>( ptr );
+		const int batchSize = task.Solver.params.BatchSize;
+		for( int batch = threadIndex; batch < task.BatchOrder.Size(); batch += task.ThreadCount ) {
+			const int start = task.BatchOrder[batch] * batchSize;
+			const int end = min( start + batchSize, task.Matrix.Height );
+			for( int i = start; i < end; ++i ) {
+				const double weight = task.Problem.GetVectorWeight( i );
+				task.Losses[threadIndex] += task.Solver.processVector( task.Matrix.GetRow( i ),
+					getStochasticAnswer( task.Problem, i ), weight, task.Epoch );
+				task.Weights[threadIndex] += weight;
+			}
+		}
+	} );
+
+	for( int i = 0; i < task.ThreadCount; ++i ) {
+		loss += task.Losses[i];
+		totalWeight += task.Weights[i];
+	}
+}
+
+// Resets the state
+void CLinearStochasticSolver::initialize( int _featureCount )
+{
+	featureCount = _featureCount;
+	weights.reset( new std::atomic<double>[featureCount + 1] );
+	squaredGradients.reset( new std::atomic<double>[featureCount + 1] );
+	for( int i = 0; i <= featureCount; ++i ) {
+		weights[i].store( 0., std::memory_order_relaxed );
+		squaredGradients[i].store( 0., std::memory_order_relaxed );
+	}
+	appliedRegularization.reset();
+	if( params.Solver == LS_Ftrl ) {
+		appliedRegularization.reset( new std::atomic<double>[featureCount + 1] );
+		for( int i = 0; i <= featureCount; ++i ) {
+			appliedRegularization[i].store( 0., std::memory_order_relaxed );
+		}
+	}
+}
+
+// Adds the number of the vectors with each feature
+void CLinearStochasticSolver::countFrequencies( const CFloatMatrixDesc& matrix, CArray<int>& frequencies ) const
+{
+	for( int i = 0; i < matrix.Height; ++i ) {
+		const CFloatVectorDesc desc = matrix.GetRow( i );
+		for( int j = 0; j < desc.Size; ++j ) {
+			const int index = desc.Indexes == nullptr ? j : desc.Indexes[j];
+			if( index < featureCount && desc.Values[j] != 0.f ) {
+				++frequencies[index];
+			}
+		}
+	}
+}
+
+// Calculates the regularization coefficients by the frequencies of the features
+void CLinearStochasticSolver::initializeRegularization( const CArray<int>& frequencies )
+{
+	// The free term isn't regularized
+	regularization.SetSize( featureCount + 1 );
+	for( int i = 0; i < featureCount; ++i ) {
+		regularization[i] = frequencies[i] > 0 ? 1. / ( errorWeight * frequencies[i] ) : 0.;
+	}
+	regularization[featureCount] = 0;
+}
+
+// Updates the weights by one vector, returns its weighted error before the update
+double CLinearStochasticSolver::processVector( const CFloatVectorDesc& desc, double answer, double weight, int epoch )
+{
+	double value = getWeight( featureCount );
+	double squaredNorm = 1; // the free term is the feature equal to 1
+	for( int j = 0; j < desc.Size; ++j ) {
+		const int index = desc.Indexes == nullptr ? j : desc.Indexes[j];
+		if( index < featureCount ) {
+			value += getWeight( index ) * desc.Values[j];
+			squaredNorm += desc.Values[j] * desc.Values[j];
+		}
+	}
+
+	double loss = 0;
+	const double derivative = weight * calcLossDerivative( value, answer, loss );
+	// The SGD step is normalized by the vector norm so that it doesn't depend on the scale of the features
+	const double learningRate = params.Solver == LS_Sgd ?
+		params.LearningRate / ( sqrt( epoch + 1. ) * squaredNorm ) : params.LearningRate;
+	for( int j = 0; j < desc.Size; ++j ) {
+		const int index = desc.Indexes == nullptr ? j : desc.Indexes[j];
+		if( index < featureCount && desc.Values[j] != 0.f ) {
+			updateWeight( index, derivative * desc.Values[j], learningRate );
+		}
+	}
+	updateWeight( featureCount, derivative, learningRate );
+	return weight * loss;
+}
+
+// Calculates the error and its derivative by the value of the linear function
+double CLinearStochasticSolver::calcLossDerivative( double value, double answer, double& loss ) const
+{
+	static_assert( EF_Count == 4, "EF_Count != 4" );
+	switch( params.Function ) {
+		case EF_SquaredHinge:
+		{
+			const double diff = 1 - answer * value;
+			if( diff <= 0 ) {
+				loss = 0;
+				return 0;
+			}
+			loss = diff * diff;
+			return -2 * answer * diff;
+		}
+		case EF_LogReg:
+		{
+			// The error is measured in bits as in CLogRegression
+			const double margin = answer * value;
+			const double logNormalizer = 1. / ::log( 2. );
+			double probability = 0; // the probability of the wrong answer
+			if( margin > 0 ) {
+				const double expCoeff = exp( -margin );
+				loss = log1p( expCoeff ) * logNormalizer;
+				probability = expCoeff / ( 1 + expCoeff );
+			} else {
+				const double expCoeff = exp( margin );
+				loss = ( log1p( expCoeff ) - margin ) * logNormalizer;
+				probability = 1 / ( 1 + expCoeff );
+			}
+			return -answer * probability * logNormalizer;
+		}
+		case EF_SmoothedHinge:
+		{
+			const double diff = answer * value - 1;
+			if( diff >= 0 ) {
+				loss = 0;
+				return 0;
+			}
+			const double sqrtValue = sqrt( diff * diff + 1 );
+			loss = sqrtValue - 1;
+			return answer * diff / sqrtValue;
+		}
+		case EF_L2_Regression:
+		{
+			const double diff = value - answer;
+			if( diff < -StochasticRegressionDeadZone ) {
+				loss = ( diff + StochasticRegressionDeadZone ) * ( diff + StochasticRegressionDeadZone );
+				return 2 * ( diff + StochasticRegressionDeadZone );
+			} else if( diff > StochasticRegressionDeadZone ) {
+				loss = ( diff - StochasticRegressionDeadZone ) * ( diff - StochasticRegressionDeadZone );
+				return 2 * ( diff - StochasticRegressionDeadZone );
+			}
+			loss = 0;
+			return 0;
+		}
+		default:
+			NeoAssert( false );
+			return 0;
+	}
+}
+
+// Gets the current weight of the feature
+double CLinearStochasticSolver::getWeight( int index ) const
+{
+	const double weight = weights[index].load( std::memory_order_relaxed );
+	if( params.Solver != LS_Ftrl ) {
+		return weight;
+	}
+
+	// FTRL optimizes the sum of the errors over all processed vectors,
+	// so the regularization of the feature is accumulated by its occurrences
+	const double applied = appliedRegularization[index].load( std::memory_order_relaxed );
+	const double l1 = params.L1Coeff > 0 ? params.L1Coeff * applied : 0.;
+	const double l2 = params.L1Coeff > 0 ? 0. : applied;
+	if( fabs( weight ) <= l1 ) {
+		return 0;
+	}
+	const double squaredGradient = squaredGradients[index].load( std::memory_order_relaxed );
+	return -( weight - ( weight > 0 ? l1 : -l1 ) ) / ( ( 1 + sqrt( squaredGradient ) ) / params.LearningRate + l2 );
+}
+
+// Updates the feature by its gradient on one vector
+// The load and store are not atomic together, so a concurrent update may be lost as in Hogwild
+void CLinearStochasticSolver::updateWeight( int index, double gradient, double learningRate )
+{
+	std::atomic<double>& weight = weights[index];
+	std::atomic<double>& squaredGradient = squaredGradients[index];
+	if( params.Solver == LS_Ftrl ) {
+		std::atomic<double>& applied = appliedRegularization[index];
+		applied.store( applied.load( std::memory_order_relaxed ) + regularization[index], std::memory_order_relaxed );
+		const double oldWeight = getWeight( index );
+		const double oldSquaredGradient = squaredGradient.load( std::memory_order_relaxed );
+		const double newSquaredGradient = oldSquaredGradient + gradient * gradient;
+		const double sigma = ( sqrt( newSquaredGradient ) - sqrt( oldSquaredGradient ) ) / learningRate;
+		weight.store( weight.load( std::memory_order_relaxed ) + gradient - sigma * oldWeight, std::memory_order_relaxed );
+		squaredGradient.store( newSquaredGradient, std::memory_order_relaxed );
+		return;
+	}
+
+	double value = weight.load( std::memory_order_relaxed );
+	if( params.L1Coeff <= 0 ) {
+		gradient += regularization[index] * value;
+	}
+	double step = learningRate;
+	if( params.Solver == LS_AdaGrad ) {
+		const double newSquaredGradient = squaredGradient.load( std::memory_order_relaxed ) + gradient * gradient;
+		squaredGradient.store( newSquaredGradient, std::memory_order_relaxed );
+		step = learningRate / ( 1 + sqrt( newSquaredGradient ) );
+	}
+	value -= step * gradient;
+	if( params.L1Coeff > 0 ) {
+		// The proximal step of the L1 regularization
+		const double threshold = step * params.L1Coeff * regularization[index];
+		value = value > threshold ? value - threshold : ( value < -threshold ? value + threshold : 0. );
+	}
+	weight.store( value, std::memory_order_relaxed );
+}
+
+} // namespace NeoML
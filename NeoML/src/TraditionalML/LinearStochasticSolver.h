@@ -0,0 +1,81 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <NeoML/TraditionalML/Linear.h>
+#include <NeoML/TraditionalML/Problem.h>
+#include <NeoML/Random.h>
+#include <atomic>
+#include <memory>
+
+namespace NeoML {
+
+class IThreadPool;
+
+// Finds the plane of the linear model by one of the stochastic methods (LS_Sgd, LS_AdaGrad, LS_Ftrl)
+// The optimized function is the same as for the trust region Newton method:
+// the sum of the weighted errors on the vectors plus the regularization divided by the error weight
+// The regularization is applied only to the features present in the processed vector
+// and is scaled by the feature frequency so that one epoch applies it once in total
+// FTRL accumulates the regularization of each feature in the same way
+class CLinearStochasticSolver {
+public:
+	CLinearStochasticSolver( const CLinear::CParams& params, double errorWeight );
+	~CLinearStochasticSolver();
+
+	// Sets the text stream for logging the loss on each epoch
+	void SetLog( CTextStream* newLog ) { log = newLog; }
+
+	// Returns the plane with the free term in the last element
+	CFloatVector Train( const IProblem& problem );
+	CFloatVector Train( const IRegressionProblem& problem );
+	// The source is read once to find the feature frequencies and then once on each epoch
+	// The error weight is normalized here if the parameters ask for it
+	CFloatVector Train( IProblemChunkSource& data );
+
+private:
+	const CLinear::CParams params;
+	double errorWeight;
+	IThreadPool* const threadPool;
+	CTextStream* log;
+
+	int featureCount;
+	// The state is shared by the threads and updated without locks
+	// SGD and AdaGrad store the weights, FTRL stores its z values
+	std::unique_ptr<std::atomic<double>[]> weights;
+	// AdaGrad and FTRL store the sums of the squared gradients
+	std::unique_ptr<std::atomic<double>[]> squaredGradients;
+	// FTRL stores the regularization accumulated by the features
+	std::unique_ptr<std::atomic<double>[]> appliedRegularization;
+	// The regularization coefficients of the features, inversely proportional to their frequency
+	CArray<double> regularization;
+
+	template<class TProblem>
+	CFloatVector train( const TProblem& problem );
+	template<class TRunEpoch>
+	CFloatVector runEpochs( const TRunEpoch& runEpoch );
+	template<class TProblem>
+	void processChunk( const TProblem& problem, int epoch, CRandom& random, double& loss, double& totalWeight );
+	void initialize( int featureCount );
+	void countFrequencies( const CFloatMatrixDesc& matrix, CArray<int>& frequencies ) const;
+	void initializeRegularization( const CArray<int>& frequencies );
+	double processVector( const CFloatVectorDesc& desc, double answer, double weight, int epoch );
+	double calcLossDerivative( double value, double answer, double& loss ) const;
+	double getWeight( int index ) const;
+	void updateWeight( int index, double gradient, double learningRate );
+};
+
+} // namespace NeoML
@@ -72,6 +72,44 @@ void CDistanceMatrixRow::synchronize() const
 
 // --------------------------------------------------------------------------------------------------------------------
 
+namespace {
+
+// Fills the rows of the initial distance matrix
+class CNaiveInitDistancesThreadTask : public IHierarchicalClusteringThreadTask {
+public:
+	CNaiveInitDistancesThreadTask( IThreadPool& threadPool, const CObjectArray<CCommonCluster>& clusters,
+			TDistanceFunc distanceFunc, CArray<CDistanceMatrixRow>& distances ) :
+		IHierarchicalClusteringThreadTask( threadPool ),
+		Clusters( clusters ),
+		DistanceFunc( distanceFunc ),
+		Distances( distances )
+	{}
+
+protected:
+	int ParallelizeSize() const override { return Clusters.Size(); }
+	int64_t Complexity() const override
+		{ return static_cast<int64_t>( Clusters.Size() ) * Clusters.Size() * Clusters[0]->GetCenter().Mean.Size() / 2; }
+	// The rows of the upper triangular matrix become shorter along with the index
+	bool IsInterleaved() const override { return true; }
+	void RunOnElement( int threadIndex, int index ) override;
+
+	const CObjectArray<CCommonCluster>& Clusters;
+	const TDistanceFunc DistanceFunc;
+	CArray<CDistanceMatrixRow>& Distances;
+};
+
+void CNaiveInitDistancesThreadTask::RunOnElement( int /*threadIndex*/, int i )
+{
+	for( int j = i + 1; j < Clusters.Size(); j++ ) {
+		const float currDist = static_cast< float >( Clusters[i]->CalcDistance( *Clusters[j], DistanceFunc ) );
+		Distances[i].SetAt( j, currDist );
+	}
+}
+
+} // namespace
+
+// --------------------------------------------------------------------------------------------------------------------
+
 bool CNaiveHierarchicalClustering::Clusterize( const CFloatMatrixDesc& matrix, const CArray<double>& weights,
 	CClusteringResult& result, CArray<CMergeInfo>* dendrogram, CArray<int>* dendrogramIndices )
 {
@@ -186,12 +224,7 @@ void CNaiveHierarchicalClustering::initialize( const CFloatMatrixDesc& matrix, c
 	// Initialize the cluster distance matrix
 	distances.DeleteAll();
 	distances.SetSize( clusters.Size() );
-	for( int i = 0; i < clusters.Size(); i++ ) {
-		for( int j = i + 1; j < clusters.Size(); j++ ) {
-			const float currDist = static_cast< float >( clusters[i]->CalcDistance( *clusters[j], params.DistanceType ) );
-			distances[i].SetAt( j, currDist );
-		}
-	}
+	CNaiveInitDistancesThreadTask( threadPool, clusters, params.DistanceType, distances ).ParallelRun();
 }
 
 // Finds the two closest clusters
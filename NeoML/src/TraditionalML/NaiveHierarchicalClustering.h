@@ -16,6 +16,7 @@ limitations under the License.
 #pragma once
 
 #include <NeoML/TraditionalML/HierarchicalClustering.h>
+#include <HierarchicalClusteringTools.h>
 
 #include <cfloat>
 
@@ -78,8 +79,9 @@ class CNaiveHierarchicalClustering {
 	typedef CHierarchicalClustering::CMergeInfo CMergeInfo;
 
 public:
-	CNaiveHierarchicalClustering( const CParam& params, const CArray<CClusterCenter>& initialClusters, CTextStream* log )
-		: params( params ), initialClusters( initialClusters ), log( log ) {}
+	CNaiveHierarchicalClustering( const CParam& params, const CArray<CClusterCenter>& initialClusters,
+			IThreadPool& threadPool, CTextStream* log ) :
+		params( params ), initialClusters( initialClusters ), threadPool( threadPool ), log( log ) {}
 
 	bool Clusterize( const CFloatMatrixDesc& matrix, const CArray<double>& weights,
 		CClusteringResult& result, CArray<CMergeInfo>* dendrogram, CArray<int>* dendrogramIndices );
@@ -87,6 +89,7 @@ public:
 private:
 	const CParam& params; // the clustering parameters
 	const CArray<CClusterCenter>& initialClusters; // the initial cluster centers
+	IThreadPool& threadPool; // executors of the distance calculations
 	CTextStream* log; // the logging stream
 	CObjectArray<CCommonCluster> clusters; // the current clusters
 	CArray<int> clusterIndices; // the current clusters indices in the dendrogram
@@ -106,11 +106,223 @@ void CUnionFind::Merge( int first, int second, int newRoot )
 
 // --------------------------------------------------------------------------------------------------------------------
 
+namespace {
+
+// Fills the rows of the condensed distance matrix between the vectors
+class CNnChainInitDistancesThreadTask : public IHierarchicalClusteringThreadTask {
+public:
+	CNnChainInitDistancesThreadTask( IThreadPool& threadPool, const CFloatMatrixDesc& matrix,
+			TDistanceFunc distanceFunc, CArray<CArray<float>>& distances ) :
+		IHierarchicalClusteringThreadTask( threadPool ),
+		Matrix( matrix ),
+		DistanceFunc( distanceFunc ),
+		Distances( distances )
+	{}
+
+protected:
+	int ParallelizeSize() const override { return Matrix.Height; }
+	int64_t Complexity() const override
+		{ return static_cast<int64_t>( Matrix.Height ) * Matrix.Height * Matrix.Width / 2; }
+	// The rows of the condensed matrix become shorter along with the index
+	bool IsInterleaved() const override { return true; }
+	void RunOnElement( int threadIndex, int index ) override;
+
+	const CFloatMatrixDesc& Matrix;
+	const TDistanceFunc DistanceFunc;
+	CArray<CArray<float>>& Distances;
+};
+
+void CNnChainInitDistancesThreadTask::RunOnElement( int /*threadIndex*/, int i )
+{
+	CArray<float>& row = Distances[i];
+	row.SetSize( Matrix.Height - i - 1 );
+	const CClusterCenter currObject( CFloatVector( Matrix.Width, Matrix.GetRow( i ) ) );
+	for( int j = i + 1; j < Matrix.Height; j++ ) {
+		row[j - i - 1] = static_cast<float>( CalcClusterToVectorDistance( currObject, Matrix.GetRow( j ), DistanceFunc ) );
+	}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+// The closest element
+struct CNnChainClosest final {
+	float Distance = FLT_MAX;
+	int Index = NotFound;
+
+	// Keeps the first of the equally close elements
+	void Update( float distance, int index ) { if( distance < Distance ) { Distance = distance; Index = index; } }
+};
+
+// Base class for the tasks searching for the closest element
+// Every thread processes a contiguous range of elements and the per-thread results are combined in thread order,
+// so the result is the same as the single-threaded one regardless of the number of threads
+class INnChainSearchThreadTask : public IHierarchicalClusteringThreadTask {
+public:
+	// Runs the task and returns the closest element (or initial if nothing closer has been found)
+	CNnChainClosest Search( const CNnChainClosest& initial );
+
+protected:
+	explicit INnChainSearchThreadTask( IThreadPool& threadPool ) :
+		IHierarchicalClusteringThreadTask( threadPool )
+	{ ThreadResults.SetSize( ThreadCount() ); }
+
+	CArray<CNnChainClosest> ThreadResults;
+};
+
+CNnChainClosest INnChainSearchThreadTask::Search( const CNnChainClosest& initial )
+{
+	for( int t = 0; t < ThreadResults.Size(); ++t ) {
+		ThreadResults[t] = CNnChainClosest();
+	}
+	ParallelRun();
+	CNnChainClosest result = initial;
+	for( int t = 0; t < ThreadResults.Size(); ++t ) {
+		result.Update( ThreadResults[t].Distance, ThreadResults[t].Index );
+	}
+	return result;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+// Searches for the nearest neighbor of the cluster
+class CNnChainNearestClusterThreadTask : public INnChainSearchThreadTask {
+public:
+
+	CNnChainNearestClusterThreadTask( IThreadPool& threadPool, const CArray<int>& clusterSizes,
+			const CArray<CArray<float>>& distances, int first ) :
+		INnChainSearchThreadTask( threadPool ),
+		ClusterSizes( clusterSizes ),
+		Distances( distances ),
+		First( first )
+	{}
+
+protected:
+	int ParallelizeSize() const override { return ClusterSizes.Size(); }
+	void RunOnElement( int threadIndex, int candidate ) override;
+
+	const CArray<int>& ClusterSizes;
+	const CArray<CArray<float>>& Distances;
+	const int First;
+};
+
+void CNnChainNearestClusterThreadTask::RunOnElement( int threadIndex, int candidate )
+{
+	if( candidate == First || ClusterSizes[candidate] == 0 ) {
+		return;
+	}
+	const float currDistance = candidate < First ? Distances[candidate][First - candidate - 1]
+		: Distances[First][candidate - First - 1];
+	ThreadResults[threadIndex].Update( currDistance, candidate );
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+// Updates the distances to the vectors which aren't in the minimum spanning tree yet
+// and finds the closest one of them
+class CNnChainSpanningTreeThreadTask : public INnChainSearchThreadTask {
+public:
+	CNnChainSpanningTreeThreadTask( IThreadPool& threadPool, const CFloatMatrixDesc& matrix, TDistanceFunc distanceFunc,
+			const CArray<bool>& isInTree, CArray<float>& treeDistances, CArray<int>& treeParents ) :
+		INnChainSearchThreadTask( threadPool ),
+		Matrix( matrix ),
+		DistanceFunc( distanceFunc ),
+		IsInTree( isInTree ),
+		TreeDistances( treeDistances ),
+		TreeParents( treeParents ),
+		Added( NotFound )
+	{}
+
+	// Sets the vector which has just been added to the tree
+	void SetAdded( int added ) { Added = added; AddedCenter = CClusterCenter( CFloatVector( Matrix.Width, Matrix.GetRow( added ) ) ); }
+
+protected:
+	int ParallelizeSize() const override { return Matrix.Height; }
+	int64_t Complexity() const override { return static_cast<int64_t>( Matrix.Height ) * Matrix.Width; }
+	void RunOnElement( int threadIndex, int index ) override;
+
+	const CFloatMatrixDesc& Matrix;
+	const TDistanceFunc DistanceFunc;
+	const CArray<bool>& IsInTree;
+	CArray<float>& TreeDistances;
+	CArray<int>& TreeParents;
+	int Added;
+	CClusterCenter AddedCenter;
+};
+
+void CNnChainSpanningTreeThreadTask::RunOnElement( int threadIndex, int index )
+{
+	if( IsInTree[index] ) {
+		return;
+	}
+	const float distance = static_cast<float>( CalcClusterToVectorDistance( AddedCenter, Matrix.GetRow( index ), DistanceFunc ) );
+	if( distance < TreeDistances[index] ) {
+		TreeDistances[index] = distance;
+		TreeParents[index] = Added;
+	}
+	ThreadResults[threadIndex].Update( TreeDistances[index], index );
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+// Recalculates the distances to the cluster which is the result of the merge
+class CNnChainMergeThreadTask : public IHierarchicalClusteringThreadTask {
+public:
+	CNnChainMergeThreadTask( IThreadPool& threadPool, const CHierarchicalClustering::CParam& params,
+			const CArray<int>& clusterSizes, CArray<CArray<float>>& distances,
+			int first, int second, int firstSize, int secondSize, float mergeDistance ) :
+		IHierarchicalClusteringThreadTask( threadPool ),
+		Params( params ),
+		ClusterSizes( clusterSizes ),
+		Distances( distances ),
+		First( first ),
+		Second( second ),
+		FirstSize( firstSize ),
+		SecondSize( secondSize ),
+		MergeDistance( mergeDistance )
+	{}
+
+protected:
+	int ParallelizeSize() const override { return ClusterSizes.Size(); }
+	void RunOnElement( int threadIndex, int index ) override;
+
+	float& distance( int first, int second ) const
+		{ return first < second ? Distances[first][second - first - 1] : Distances[second][first - second - 1]; }
+
+	const CHierarchicalClustering::CParam& Params;
+	const CArray<int>& ClusterSizes;
+	CArray<CArray<float>>& Distances;
+	const int First;
+	const int Second;
+	const int FirstSize;
+	const int SecondSize;
+	const float MergeDistance;
+};
+
+void CNnChainMergeThreadTask::RunOnElement( int /*threadIndex*/, int i )
+{
+	if( i == Second || ClusterSizes[i] == 0 ) {
+		return;
+	}
+	// We can pass ref to any cluster here because linkage isn't centroid
+	distance( i, Second ) = recalcDistance( Params.Linkage, Params.DistanceType, FirstSize,
+		SecondSize, ClusterSizes[i], distance( i, First ), distance( i, Second ), MergeDistance );
+}
+
+} // namespace
+
+// --------------------------------------------------------------------------------------------------------------------
+
 bool CNnChainHierarchicalClustering::Clusterize( const CFloatMatrixDesc& matrix, const CArray<double>& weights,
 	CClusteringResult& result, CArray<CMergeInfo>* dendrogram, CArray<int>* dendrogramIndices )
 {
-	initialize( matrix );
-	buildFullDendrogram( matrix );
+	if( params.MemoryBounded ) {
+		// Single linkage dendrogram is equivalent to the minimum spanning tree
+		NeoAssert( params.Linkage == CHierarchicalClustering::L_Single );
+		buildMinimumSpanningTree( matrix );
+	} else {
+		initialize( matrix );
+		buildFullDendrogram( matrix );
+	}
 	sortDendrogram();
 	return buildResult( matrix, weights, result, dendrogram, dendrogramIndices );
 }
@@ -119,21 +331,14 @@ bool CNnChainHierarchicalClustering::Clusterize( const CFloatMatrixDesc& matrix,
 void CNnChainHierarchicalClustering::initialize( const CFloatMatrixDesc& matrix )
 {
 	const int vectorCount = matrix.Height;
-	const int featureCount = matrix.Width;
 
 	clusterSizes.Empty();
 	clusterSizes.Add( 1, vectorCount );
 
 	// Initialize the cluster distance matrix
 	distances.DeleteAll();
-	distances.Add( CFloatVector( vectorCount ), vectorCount );
-
-	for( int i = 0; i < vectorCount; i++ ) {
-		CClusterCenter currObject( CFloatVector( featureCount, matrix.GetRow( i ) ) );
-		for( int j = i + 1; j < vectorCount; j++ ) {
-			distances[i].SetAt( j, static_cast<float>( CalcDistance( currObject, matrix.GetRow( j ), params.DistanceType ) ) );
-		}
-	}
+	distances.SetSize( vectorCount );
+	CNnChainInitDistancesThreadTask( threadPool, matrix, params.DistanceType, distances ).ParallelRun();
 }
 
 // Builds full dendrogram
@@ -158,21 +363,7 @@ void CNnChainHierarchicalClustering::buildFullDendrogram( const CFloatMatrixDesc
 
 		while( true ) {
 			const int first = chain[chainSize - 1];
-			int second = chainSize == 1 ? NotFound : chain[chainSize - 2];
-			float minDistance = second == NotFound ? FLT_MAX
-				: ( first < second ? distances[first][second] : distances[second][first] );
-
-			for( int candidate = 0; candidate < clusterSizes.Size(); ++candidate ) {
-				if( candidate == first || clusterSizes[candidate] == 0 ) {
-					continue;
-				}
-
-				const float currDistance = candidate < first ? distances[candidate][first] : distances[first][candidate];
-				if( currDistance < minDistance ) {
-					minDistance = currDistance;
-					second = candidate;
-				}
-			}
+			const int second = findNearestCluster( first, chainSize == 1 ? NotFound : chain[chainSize - 2] );
 
 			if( chainSize > 1 && chain[chainSize - 2] == second ) {
 				break;
@@ -187,6 +378,18 @@ void CNnChainHierarchicalClustering::buildFullDendrogram( const CFloatMatrixDesc
 	}
 }
 
+// Finds the nearest neighbor of the first cluster
+// The previous element of the chain is preferred if there are several nearest neighbors
+int CNnChainHierarchicalClustering::findNearestCluster( int first, int prev ) const
+{
+	CNnChainClosest initial;
+	if( prev != NotFound ) {
+		initial.Distance = distance( first, prev );
+		initial.Index = prev;
+	}
+	return CNnChainNearestClusterThreadTask( threadPool, clusterSizes, distances, first ).Search( initial ).Index;
+}
+
 // Merges 2 clusters during NnChain algorithm and adds merge result to the full dendrogram
 void CNnChainHierarchicalClustering::mergeClusters( int first, int second )
 {
@@ -196,7 +399,7 @@ void CNnChainHierarchicalClustering::mergeClusters( int first, int second )
 
 	const int firstSize = clusterSizes[first];
 	const int secondSize = clusterSizes[second];
-	const float mergeDistance = distances[first][second];
+	const float mergeDistance = distance( first, second );
 
 	CMergeInfo& newMerge = fullDendrogram.Append();
 	newMerge.First = first;
@@ -206,21 +409,40 @@ void CNnChainHierarchicalClustering::mergeClusters( int first, int second )
 	clusterSizes[first] = 0;
 	clusterSizes[second] = firstSize + secondSize;
 
-	for( int i = 0; i < clusterSizes.Size(); i++ ) {
-		if( i == second || clusterSizes[i] == 0 ) {
-			continue;
-		}
-		// We can pass ref to any cluster here because linkage isn't centroid
-		const float distance = recalcDistance( params.Linkage, params.DistanceType, firstSize, 
-			secondSize, clusterSizes[i],
-			i < first ? distances[i][first] : distances[first][i],
-			i < second ? distances[i][second] : distances[second][i],
-			mergeDistance );
-		if( i < second ) {
-			distances[i].SetAt( second, distance );
-		} else {
-			distances[second].SetAt( i, distance );
-		}
+	CNnChainMergeThreadTask( threadPool, params, clusterSizes, distances,
+		first, second, firstSize, secondSize, mergeDistance ).ParallelRun();
+	// The distances of the first cluster are not needed anymore
+	distances[first].FreeBuffer();
+}
+
+// Builds full single linkage dendrogram as the minimum spanning tree (Prim's algorithm)
+// Takes O(N^2) time and O(N) memory, distances are calculated on the fly
+void CNnChainHierarchicalClustering::buildMinimumSpanningTree( const CFloatMatrixDesc& matrix )
+{
+	const int vectorCount = matrix.Height;
+	fullDendrogram.Empty();
+	fullDendrogram.SetBufferSize( vectorCount - 1 );
+
+	CArray<bool> isInTree;
+	isInTree.Add( false, vectorCount );
+	CArray<float> treeDistances;
+	treeDistances.Add( FLT_MAX, vectorCount );
+	CArray<int> treeParents;
+	treeParents.Add( NotFound, vectorCount );
+
+	CNnChainSpanningTreeThreadTask task( threadPool, matrix, params.DistanceType, isInTree, treeDistances, treeParents );
+	int added = 0;
+	for( int step = 0; step < vectorCount - 1; ++step ) {
+		isInTree[added] = true;
+		task.SetAdded( added );
+		const int closest = task.Search( CNnChainClosest() ).Index;
+		NeoAssert( closest != NotFound );
+
+		CMergeInfo& newMerge = fullDendrogram.Append();
+		newMerge.First = treeParents[closest];
+		newMerge.Second = closest;
+		newMerge.Distance = treeDistances[closest];
+		added = closest;
 	}
 }
 
@@ -16,6 +16,7 @@ limitations under the License.
 #pragma once
 
 #include <NeoML/TraditionalML/HierarchicalClustering.h>
+#include <HierarchicalClusteringTools.h>
 
 namespace NeoML {
 
@@ -25,25 +26,39 @@ class CNnChainHierarchicalClustering {
 	typedef CHierarchicalClustering::CMergeInfo CMergeInfo;
 
 public:
-	CNnChainHierarchicalClustering( const CParam& params, CTextStream* log ) : params( params ), log( log ) {}
+	CNnChainHierarchicalClustering( const CParam& params, IThreadPool& threadPool, CTextStream* log ) :
+		params( params ), threadPool( threadPool ), log( log ) {}
 
 	bool Clusterize( const CFloatMatrixDesc& matrix, const CArray<double>& weights,
 		CClusteringResult& result, CArray<CMergeInfo>* dendrogram, CArray<int>* dendrogramIndices );
 
 private:
 	const CParam& params; // the clustering parameters
+	IThreadPool& threadPool; // executors of the distance calculations
 	CTextStream* log; // the logging stream
-	CFloatVectorArray distances; // the matrix containing distances between clusters
+	// The condensed upper triangular matrix containing distances between clusters
+	// The i'th row contains distances between i'th cluster and clusters (i + 1), (i + 2), ..., (N - 1)
+	CArray<CArray<float>> distances;
 	CArray<int> clusterSizes; // sizes of current clusters
 	CArray<CMergeInfo> fullDendrogram; // dendrogram of the whole tree
 	CArray<int> sortedDendrogram; // indices of full dendrogram nodes in distance-increasing order
 
+	float distance( int first, int second ) const;
+
 	void initialize( const CFloatMatrixDesc& matrix );
 	void buildFullDendrogram( const CFloatMatrixDesc& matrix );
+	int findNearestCluster( int first, int prev ) const;
 	void mergeClusters( int first, int second );
+	void buildMinimumSpanningTree( const CFloatMatrixDesc& matrix );
 	void sortDendrogram();
 	bool buildResult( const CFloatMatrixDesc& matrix, const CArray<double>& weights,
 		CClusteringResult& result, CArray<CMergeInfo>* dendrogram, CArray<int>* dendrogramIndices ) const;
 };
 
+inline float CNnChainHierarchicalClustering::distance( int first, int second ) const
+{
+	NeoPresume( first != second );
+	return first < second ? distances[first][second - first - 1] : distances[second][first - second - 1];
+}
+
 } // namespace NeoML
@@ -18,6 +18,7 @@ limitations under the License.
 
 #include <NeoML/TraditionalML/OneVersusAll.h>
 #include <OneVersusAllModel.h>
+#include <NeoMathEngine/ThreadPool.h>
 
 namespace NeoML {
 
@@ -52,8 +53,9 @@ inline COneVersusAllTrainingData::COneVersusAllTrainingData( const IProblem* _da
 
 //---------------------------------------------------------------------------------------------------------
 
-COneVersusAll::COneVersusAll( ITrainingModel& _baseBinaryClassifier ) :
+COneVersusAll::COneVersusAll( ITrainingModel& _baseBinaryClassifier, int _threadCount ) :
 	baseBinaryClassifier( _baseBinaryClassifier ),
+	threadCount( _threadCount ),
 	logStream( 0 )
 {
 }
@@ -64,10 +66,30 @@ CPtr<IModel> COneVersusAll::Train( const IProblem& trainingClassificationData )
 		*logStream << "\nOne versus all training started:\n";
 	}
 
+	const int classCount = trainingClassificationData.GetClassCount();
 	CObjectArray<IModel> etalons;
-	for( int i = 0; i < trainingClassificationData.GetClassCount(); i++ ) {
-		CPtr<IProblem> trainingData = FINE_DEBUG_NEW COneVersusAllTrainingData( &trainingClassificationData, i );
-		etalons.Add( baseBinaryClassifier.Train( *trainingData ) );
+	if( threadCount == 1 ) {
+		for( int i = 0; i < classCount; i++ ) {
+			CPtr<IProblem> trainingData = FINE_DEBUG_NEW COneVersusAllTrainingData( &trainingClassificationData, i );
+			etalons.Add( baseBinaryClassifier.Train( *trainingData ) );
+		}
+	} else {
+		// Each model is stored at the index of its class so the result doesn't depend on the order of training
+		etalons.SetSize( classCount );
+		CPtrOwner<IThreadPool> threadPool( CreateThreadPool( threadCount ) );
+		struct CTask {
+			ITrainingModel& Classifier;
+			const IProblem& Problem;
+			CObjectArray<IModel>& Models;
+			int ThreadCount;
+		} task{ baseBinaryClassifier, trainingClassificationData, etalons, threadPool->Size() };
+		NEOML_NUM_THREADS( *threadPool, &task, []( int threadIndex, void* ptr ) {
+			CTask& task = *static_cast<CTask*>( ptr );
+			for( int i = threadIndex; i < task.Models.Size(); i += task.ThreadCount ) {
+				CPtr<IProblem> trainingData = FINE_DEBUG_NEW COneVersusAllTrainingData( &task.Problem, i );
+				task.Models[i] = task.Classifier.Train( *trainingData );
+			}
+		} );
 	}
 
 	if( logStream != 0 ) {
@@ -18,6 +18,7 @@ limitations under the License.
 
 #include <NeoML/TraditionalML/OneVersusOne.h>
 #include <OneVersusOneModel.h>
+#include <NeoMathEngine/ThreadPool.h>
 
 namespace NeoML {
 
@@ -79,8 +80,9 @@ int COneVersusOneTrainingData::GetClass( int index ) const
 
 //---------------------------------------------------------------------------------------------------------
 
-COneVersusOne::COneVersusOne( ITrainingModel& _baseClassifier ) :
+COneVersusOne::COneVersusOne( ITrainingModel& _baseClassifier, int _threadCount ) :
 	baseClassifier( _baseClassifier ),
+	threadCount( _threadCount ),
 	log( nullptr )
 {
 }
@@ -93,11 +95,42 @@ CPtr<IModel> COneVersusOne::Train( const IProblem& trainingData )
 
 	CObjectArray<IModel> classifiers;
 	const int classCount = trainingData.GetClassCount();
-	for( int firstClass = 0; firstClass < classCount - 1; ++firstClass ) {
-		for( int secondClass = firstClass + 1; secondClass < classCount; ++secondClass ) {
-			CPtr<IProblem> subproblem = FINE_DEBUG_NEW COneVersusOneTrainingData( trainingData, firstClass, secondClass );
-			classifiers.Add( baseClassifier.Train( *subproblem ) );
+	if( threadCount == 1 ) {
+		for( int firstClass = 0; firstClass < classCount - 1; ++firstClass ) {
+			for( int secondClass = firstClass + 1; secondClass < classCount; ++secondClass ) {
+				CPtr<IProblem> subproblem = FINE_DEBUG_NEW COneVersusOneTrainingData( trainingData, firstClass, secondClass );
+				classifiers.Add( baseClassifier.Train( *subproblem ) );
+			}
 		}
+	} else {
+		// The pairs of classes are enumerated in the same order as in the sequential case
+		CArray<int> firstClasses;
+		CArray<int> secondClasses;
+		for( int firstClass = 0; firstClass < classCount - 1; ++firstClass ) {
+			for( int secondClass = firstClass + 1; secondClass < classCount; ++secondClass ) {
+				firstClasses.Add( firstClass );
+				secondClasses.Add( secondClass );
+			}
+		}
+		classifiers.SetSize( firstClasses.Size() );
+
+		CPtrOwner<IThreadPool> threadPool( CreateThreadPool( threadCount ) );
+		struct CTask {
+			ITrainingModel& Classifier;
+			const IProblem& Problem;
+			const CArray<int>& FirstClasses;
+			const CArray<int>& SecondClasses;
+			CObjectArray<IModel>& Models;
+			int ThreadCount;
+		} task{ baseClassifier, trainingData, firstClasses, secondClasses, classifiers, threadPool->Size() };
+		NEOML_NUM_THREADS( *threadPool, &task, []( int threadIndex, void* ptr ) {
+			CTask& task = *static_cast<CTask*>( ptr );
+			for( int i = threadIndex; i < task.Models.Size(); i += task.ThreadCount ) {
+				CPtr<IProblem> subproblem = FINE_DEBUG_NEW COneVersusOneTrainingData( task.Problem,
+					task.FirstClasses[i], task.SecondClasses[i] );
+				task.Models[i] = task.Classifier.Train( *subproblem );
+			}
+		} );
 	}
 
 	if( log != nullptr ) {
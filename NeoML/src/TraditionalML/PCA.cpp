@@ -200,6 +200,427 @@ static CSparseFloatMatrix transform( const CFloatMatrixDesc& data, const CArray<
 	return transformedResult;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+
+// The chunk of the matrix rows copied into the math engine memory
+// The dense chunks are stored as the dense matrix, the sparse ones in the CSR form without conversion
+class CPcaChunk {
+public:
+	CPcaChunk( IMathEngine& mathEngine, const CFloatMatrixDesc& data, int width );
+
+	// result = chunk * second, `second` is of shape width x secondWidth
+	void Multiply( const CConstFloatHandle& second, int secondWidth, const CFloatHandle& result ) const;
+	// result = chunk * T(second), `second` is of shape secondHeight x width
+	void MultiplyByTransposed( const CConstFloatHandle& second, int secondHeight, const CFloatHandle& result ) const;
+	// result = result + T(first) * chunk, `first` is of shape height x firstWidth
+	void AddTransposedProduct( const CConstFloatHandle& first, int firstWidth, const CFloatHandle& result ) const;
+
+private:
+	IMathEngine& mathEngine;
+	const int height;
+	const int width;
+	const bool isSparse;
+	int elementCount;
+	CPtr<CDnnBlob> values;
+	CPtr<CDnnBlob> columns;
+	CPtr<CDnnBlob> rows;
+
+	CSparseMatrixDesc sparseDesc() const
+		{ return CSparseMatrixDesc( elementCount, rows->GetData<int>(), columns->GetData<int>(), values->GetData() ); }
+};
+
+CPcaChunk::CPcaChunk( IMathEngine& _mathEngine, const CFloatMatrixDesc& data, int _width ) :
+	mathEngine( _mathEngine ),
+	height( data.Height ),
+	width( _width ),
+	isSparse( data.Columns != nullptr ),
+	elementCount( 0 )
+{
+	NeoAssert( height > 0 );
+	NeoAssert( data.Width <= width );
+
+	if( isSparse ) {
+		CArray<int> rowsData;
+		CArray<int> columnsData;
+		CArray<float> valuesData;
+		rowsData.SetBufferSize( height + 1 );
+		rowsData.Add( 0 );
+		for( int i = 0; i < height; i++ ) {
+			const CFloatVectorDesc row = data.GetRow( i );
+			for( int j = 0; j < row.Size; j++ ) {
+				columnsData.Add( row.Indexes[j] );
+				valuesData.Add( row.Values[j] );
+			}
+			rowsData.Add( columnsData.Size() );
+		}
+		elementCount = valuesData.Size();
+		rows = CDnnBlob::CreateVector( mathEngine, CT_Int, rowsData.Size() );
+		rows->CopyFrom( rowsData.GetPtr() );
+		columns = CDnnBlob::CreateVector( mathEngine, CT_Int, max( elementCount, 1 ) );
+		values = CDnnBlob::CreateVector( mathEngine, CT_Float, max( elementCount, 1 ) );
+		if( elementCount > 0 ) {
+			mathEngine.DataExchangeTyped( columns->GetData<int>(), columnsData.GetPtr(), elementCount );
+			mathEngine.DataExchangeTyped( values->GetData(), valuesData.GetPtr(), elementCount );
+		}
+	} else {
+		CArray<float> valuesData;
+		valuesData.Add( 0.f, height * width );
+		for( int i = 0; i < height; i++ ) {
+			const CFloatVectorDesc row = data.GetRow( i );
+			::memcpy( valuesData.GetPtr() + i * width, row.Values, row.Size * sizeof( float ) );
+		}
+		values = CDnnBlob::CreateDataBlob( mathEngine, CT_Float, 1, height, width );
+		values->CopyFrom( valuesData.GetPtr() );
+	}
+}
+
+void CPcaChunk::Multiply( const CConstFloatHandle& second, int secondWidth, const CFloatHandle& result ) const
+{
+	if( isSparse ) {
+		mathEngine.MultiplySparseMatrixByMatrix( height, width, secondWidth, sparseDesc(), second, result );
+	} else {
+		mathEngine.MultiplyMatrixByMatrix( 1, values->GetData(), height, width, second, secondWidth,
+			result, height * secondWidth );
+	}
+}
+
+void CPcaChunk::MultiplyByTransposed( const CConstFloatHandle& second, int secondHeight, const CFloatHandle& result ) const
+{
+	if( isSparse ) {
+		mathEngine.VectorFill( result, 0.f, height * secondHeight );
+		mathEngine.MultiplySparseMatrixByTransposedMatrix( height, width, secondHeight, sparseDesc(), second, result );
+	} else {
+		mathEngine.MultiplyMatrixByTransposedMatrix( values->GetData(), height, width, width,
+			second, secondHeight, width, result, secondHeight, height * secondHeight );
+	}
+}
+
+void CPcaChunk::AddTransposedProduct( const CConstFloatHandle& first, int firstWidth, const CFloatHandle& result ) const
+{
+	if( isSparse ) {
+		mathEngine.MultiplyTransposedMatrixBySparseMatrixAndAdd( height, firstWidth, width, first, sparseDesc(), result );
+	} else {
+		mathEngine.MultiplyTransposedMatrixByMatrixAndAdd( first, height, firstWidth, firstWidth,
+			values->GetData(), width, width, result, width, firstWidth * width );
+	}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+// Finds the eigen values (in the descending order) and the eigen vectors of the symmetric size x size matrix
+// by the cyclic Jacobi method; the i-th eigen vector is written into the i-th row of `vectors`
+// The matrix is destroyed
+static void calculateSymmetricEigen( CArray<double>& matrix, int size, CArray<double>& values, CArray<double>& vectors )
+{
+	const int maxSweepCount = 100;
+	CArray<double> rotation;
+	rotation.Add( 0., size * size );
+	for( int i = 0; i < size; i++ ) {
+		rotation[i * size + i] = 1.;
+	}
+
+	for( int sweep = 0; sweep < maxSweepCount; sweep++ ) {
+		double diagonalNorm = 0;
+		double offDiagonalNorm = 0;
+		for( int p = 0; p < size; p++ ) {
+			diagonalNorm += matrix[p * size + p] * matrix[p * size + p];
+			for( int q = p + 1; q < size; q++ ) {
+				offDiagonalNorm += matrix[p * size + q] * matrix[p * size + q];
+			}
+		}
+		if( offDiagonalNorm <= 1e-30 * diagonalNorm || offDiagonalNorm == 0 ) {
+			break;
+		}
+
+		for( int p = 0; p < size; p++ ) {
+			for( int q = p + 1; q < size; q++ ) {
+				const double apq = matrix[p * size + q];
+				if( apq == 0 ) {
+					continue;
+				}
+				// The rotation that zeroes the (p, q) element
+				const double theta = ( matrix[q * size + q] - matrix[p * size + p] ) / ( 2 * apq );
+				const double t = ( theta >= 0 ? 1. : -1. ) / ( fabs( theta ) + sqrt( theta * theta + 1 ) );
+				const double c = 1 / sqrt( t * t + 1 );
+				const double s = t * c;
+				for( int k = 0; k < size; k++ ) {
+					const double akp = matrix[k * size + p];
+					const double akq = matrix[k * size + q];
+					matrix[k * size + p] = c * akp - s * akq;
+					matrix[k * size + q] = s * akp + c * akq;
+				}
+				for( int k = 0; k < size; k++ ) {
+					const double apk = matrix[p * size + k];
+					const double aqk = matrix[q * size + k];
+					matrix[p * size + k] = c * apk - s * aqk;
+					matrix[q * size + k] = s * apk + c * aqk;
+				}
+				for( int k = 0; k < size; k++ ) {
+					const double vkp = rotation[k * size + p];
+					const double vkq = rotation[k * size + q];
+					rotation[k * size + p] = c * vkp - s * vkq;
+					rotation[k * size + q] = s * vkp + c * vkq;
+				}
+			}
+		}
+	}
+
+	CArray<int> order;
+	for( int i = 0; i < size; i++ ) {
+		order.Add( i );
+	}
+	for( int i = 0; i < size; i++ ) {
+		int best = i;
+		for( int j = i + 1; j < size; j++ ) {
+			if( matrix[order[j] * size + order[j]] > matrix[order[best] * size + order[best]] ) {
+				best = j;
+			}
+		}
+		swap( order[i], order[best] );
+	}
+
+	values.SetSize( size );
+	vectors.SetSize( size * size );
+	for( int i = 0; i < size; i++ ) {
+		values[i] = matrix[order[i] * size + order[i]];
+		for( int k = 0; k < size; k++ ) {
+			vectors[i * size + k] = rotation[k * size + order[i]];
+		}
+	}
+}
+
+// The randomized sketch of the matrix G = T(A) * A, where the rows of A are added by chunks
+// The sketch is Z = T(Omega) * G of the reducedSide x width size, Omega is the random width x reducedSide matrix
+// The largest eigen values and vectors of G are found by the Nystrom approximation G ~ T(Z) * inverse(Z * Omega) * Z,
+// they are the squared singular values and the right singular vectors of A
+class CCovarianceSketch {
+public:
+	CCovarianceSketch( IMathEngine& mathEngine, int width, int reducedSide, int seed );
+	virtual ~CCovarianceSketch() = default;
+
+	int Width() const { return width; }
+
+	// Sets the point the rows are measured from, the rows of A are the added rows minus the origin
+	// Should be called before adding the rows
+	void SetOrigin( const CArray<float>& origin );
+	// Adds the rows of the chunk to A
+	void Add( const CFloatMatrixDesc& chunk );
+	// Calculates the largest singular values and the right singular vectors of the matrix
+	// A - 1 * T(shift) where the A height is count; the shift may be empty
+	void Calculate( const CArray<double>& shift, double count, int components,
+		CArray<float>& singularValues, CArray<float>& rightVectors ) const;
+
+	// The sketch data, for serialization
+	void GetData( CArray<float>& data ) const;
+	void SetData( const CArray<float>& data );
+
+private:
+	// The relative eigen value of Z * Omega below which the direction is considered to be noise
+	static constexpr double minRelativeEigenValue = 1e-6;
+
+	IMathEngine& mathEngine;
+	const int width;
+	const int reducedSide;
+	CArray<float> omegaData;
+	CPtr<CDnnBlob> omega;
+	CPtr<CDnnBlob> sketch;
+	// -origin and -T(origin) * Omega
+	CPtr<CDnnBlob> negatedOrigin;
+	CPtr<CDnnBlob> negatedOriginProjection;
+};
+
+CCovarianceSketch::CCovarianceSketch( IMathEngine& _mathEngine, int _width, int _reducedSide, int seed ) :
+	mathEngine( _mathEngine ),
+	width( _width ),
+	reducedSide( _reducedSide )
+{
+	NeoAssert( width > 0 );
+	NeoAssert( 0 < reducedSide && reducedSide <= width );
+
+	CRandom random( seed );
+	omegaData.SetSize( width * reducedSide );
+	for( int i = 0; i < omegaData.Size(); i++ ) {
+		omegaData[i] = static_cast<float>( random.Normal( 0., 1. ) );
+	}
+	omega = CDnnBlob::CreateDataBlob( mathEngine, CT_Float, 1, width, reducedSide );
+	omega->CopyFrom( omegaData.GetPtr() );
+	sketch = CDnnBlob::CreateDataBlob( mathEngine, CT_Float, 1, reducedSide, width );
+	sketch->Clear();
+}
+
+void CCovarianceSketch::SetOrigin( const CArray<float>& origin )
+{
+	NeoAssert( origin.Size() == width );
+
+	CArray<float> data;
+	data.SetSize( width );
+	for( int j = 0; j < width; j++ ) {
+		data[j] = -origin[j];
+	}
+	negatedOrigin = CDnnBlob::CreateVector( mathEngine, CT_Float, width );
+	negatedOrigin->CopyFrom( data.GetPtr() );
+
+	data.Empty();
+	data.Add( 0.f, reducedSide );
+	for( int j = 0; j < width; j++ ) {
+		for( int r = 0; r < reducedSide; r++ ) {
+			data[r] -= origin[j] * omegaData[j * reducedSide + r];
+		}
+	}
+	negatedOriginProjection = CDnnBlob::CreateVector( mathEngine, CT_Float, reducedSide );
+	negatedOriginProjection->CopyFrom( data.GetPtr() );
+}
+
+void CCovarianceSketch::Add( const CFloatMatrixDesc& chunk )
+{
+	const CPcaChunk data( mathEngine, chunk, width );
+	const int height = chunk.Height;
+
+	// Y = ( A - 1 * T(origin) ) * Omega
+	CPtr<CDnnBlob> projection = CDnnBlob::CreateDataBlob( mathEngine, CT_Float, 1, height, reducedSide );
+	data.Multiply( omega->GetData(), reducedSide, projection->GetData() );
+	if( negatedOrigin != nullptr ) {
+		mathEngine.AddVectorToMatrixRows( 1, projection->GetData(), projection->GetData(), height, reducedSide,
+			negatedOriginProjection->GetData() );
+	}
+
+	// Z = Z + T(Y) * ( A - 1 * T(origin) )
+	data.AddTransposedProduct( projection->GetData(), reducedSide, sketch->GetData() );
+	if( negatedOrigin != nullptr ) {
+		CPtr<CDnnBlob> projectionSums = CDnnBlob::CreateVector( mathEngine, CT_Float, reducedSide );
+		mathEngine.SumMatrixRows( 1, projectionSums->GetData(), projection->GetData(), height, reducedSide );
+		mathEngine.MultiplyTransposedMatrixByMatrixAndAdd( projectionSums->GetData(), 1, reducedSide, reducedSide,
+			negatedOrigin->GetData(), width, width, sketch->GetData(), width, reducedSide * width );
+	}
+}
+
+void CCovarianceSketch::Calculate( const CArray<double>& shift, double count, int components,
+	CArray<float>& singularValues, CArray<float>& rightVectors ) const
+{
+	NeoAssert( 0 < components && components <= reducedSide );
+	NeoAssert( shift.IsEmpty() || shift.Size() == width );
+
+	// The small matrices are decomposed in double precision on CPU
+	CArray<float> sketchData;
+	GetData( sketchData );
+	CArray<double> z;
+	z.SetSize( reducedSide * width );
+	for( int i = 0; i < z.Size(); i++ ) {
+		z[i] = sketchData[i];
+	}
+	if( !shift.IsEmpty() ) {
+		// Z = Z - count * T(Omega) * shift * T(shift)
+		for( int r = 0; r < reducedSide; r++ ) {
+			double projection = 0;
+			for( int j = 0; j < width; j++ ) {
+				projection += omegaData[j * reducedSide + r] * shift[j];
+			}
+			projection *= count;
+			for( int j = 0; j < width; j++ ) {
+				z[r * width + j] -= projection * shift[j];
+			}
+		}
+	}
+
+	// M = Z * Omega
+	CArray<double> m;
+	m.Add( 0., reducedSide * reducedSide );
+	for( int r = 0; r < reducedSide; r++ ) {
+		for( int j = 0; j < width; j++ ) {
+			const double value = z[r * width + j];
+			for( int c = 0; c < reducedSide; c++ ) {
+				m[r * reducedSide + c] += value * omegaData[j * reducedSide + c];
+			}
+		}
+	}
+	for( int r = 0; r < reducedSide; r++ ) {
+		for( int c = r + 1; c < reducedSide; c++ ) {
+			const double value = ( m[r * reducedSide + c] + m[c * reducedSide + r] ) / 2;
+			m[r * reducedSide + c] = value;
+			m[c * reducedSide + r] = value;
+		}
+	}
+	CArray<double> mValues;
+	CArray<double> mVectors;
+	calculateSymmetricEigen( m, reducedSide, mValues, mVectors );
+	int rank = 0;
+	while( rank < reducedSide && mValues[rank] > minRelativeEigenValue * mValues[0] ) {
+		rank++;
+	}
+
+	// G ~ F * T(F), where T(F) = D^(-1/2) * T(P) * Z and P * D * T(P) is the decomposition of M
+	CArray<double> f;
+	f.Add( 0., rank * width );
+	for( int i = 0; i < rank; i++ ) {
+		const double scale = 1 / sqrt( mValues[i] );
+		for( int r = 0; r < reducedSide; r++ ) {
+			const double coeff = scale * mVectors[i * reducedSide + r];
+			for( int j = 0; j < width; j++ ) {
+				f[i * width + j] += coeff * z[r * width + j];
+			}
+		}
+	}
+
+	// The eigen vectors of G are F * W * L^(-1/2) where W * L * T(W) is the decomposition of T(F) * F
+	CArray<double> s;
+	s.Add( 0., rank * rank );
+	for( int i = 0; i < rank; i++ ) {
+		for( int k = i; k < rank; k++ ) {
+			double value = 0;
+			for( int j = 0; j < width; j++ ) {
+				value += f[i * width + j] * f[k * width + j];
+			}
+			s[i * rank + k] = value;
+			s[k * rank + i] = value;
+		}
+	}
+	CArray<double> sValues;
+	CArray<double> sVectors;
+	calculateSymmetricEigen( s, rank, sValues, sVectors );
+
+	singularValues.SetSize( components );
+	rightVectors.SetSize( components * width );
+	CArray<double> vector;
+	for( int i = 0; i < components; i++ ) {
+		vector.Empty();
+		vector.Add( 0., width );
+		singularValues[i] = 0;
+		if( i < rank && sValues[i] > 0 ) {
+			const double singularValue = sqrt( sValues[i] );
+			singularValues[i] = static_cast<float>( singularValue );
+			for( int k = 0; k < rank; k++ ) {
+				const double coeff = sVectors[i * rank + k] / singularValue;
+				for( int j = 0; j < width; j++ ) {
+					vector[j] += coeff * f[k * width + j];
+				}
+			}
+		}
+		// Flip the sign so that the largest element is positive to obtain deterministic result
+		int maxIndex = 0;
+		for( int j = 1; j < width; j++ ) {
+			if( fabs( vector[j] ) > fabs( vector[maxIndex] ) ) {
+				maxIndex = j;
+			}
+		}
+		const double sign = vector[maxIndex] < 0 ? -1. : 1.;
+		for( int j = 0; j < width; j++ ) {
+			rightVectors[i * width + j] = static_cast<float>( sign * vector[j] );
+		}
+	}
+}
+
+void CCovarianceSketch::GetData( CArray<float>& data ) const
+{
+	data.SetSize( reducedSide * width );
+	sketch->CopyTo( data.GetPtr() );
+}
+
+void CCovarianceSketch::SetData( const CArray<float>& data )
+{
+	NeoAssert( data.Size() == reducedSide * width );
+	sketch->CopyFrom( data.GetPtr() );
+}
+
 namespace NeoML {
 
 static void normalize( TRandomizedSvdNormalizer type, int height, int width, const CFloatHandle& matrix)
@@ -318,6 +739,25 @@ void RandomizedSingularValueDecomposition( const CFloatMatrixDesc& data,
 	}
 }
 
+IFloatMatrixChunkSource::~IFloatMatrixChunkSource() = default;
+
+void RandomizedSingularValueDecomposition( IFloatMatrixChunkSource& data, IMathEngine& mathEngine,
+	CArray<float>& singularValues, CArray<float>& rightVectors, int components, int overSamples, int seed )
+{
+	NeoAssert( components > 0 );
+	NeoAssert( components <= data.GetWidth() );
+	NeoAssert( overSamples >= 0 );
+
+	CCovarianceSketch sketch( mathEngine, data.GetWidth(), min( components + overSamples, data.GetWidth() ), seed );
+	CFloatMatrixDesc chunk;
+	while( data.GetNextChunk( chunk ) ) {
+		if( chunk.Height > 0 ) {
+			sketch.Add( chunk );
+		}
+	}
+	sketch.Calculate( CArray<double>(), 0, components, singularValues, rightVectors );
+}
+
 void SingularValueDecomposition( const CFloatMatrixDesc& data,
 	CArray<float>& leftVectors_, CArray<float>& singularValues_, CArray<float>& rightVectors_,
 	bool returnLeftVectors, bool returnRightVectors, int resultComponents )
@@ -543,3 +983,202 @@ void CPca::Serialize( CArchive& archive )
 		NeoAssert( false );
 	}
 }
+
+//---------------------------------------------------------------------------------------------------------------------
+
+class CIncrementalPca::CSketch : public CCovarianceSketch {
+public:
+	using CCovarianceSketch::CCovarianceSketch;
+};
+
+CIncrementalPca::CIncrementalPca( const CParams& _params, IMathEngine& _mathEngine ) :
+	params( _params ),
+	mathEngine( _mathEngine ),
+	vectorCount( 0 ),
+	isComponentsDirty( false ),
+	noiseVariance( 0 )
+{
+	NeoAssert( params.Components > 0 );
+	NeoAssert( params.OverSamples >= 0 );
+}
+
+CIncrementalPca::~CIncrementalPca() = default;
+
+void CIncrementalPca::PartialFit( const CFloatMatrixDesc& chunk )
+{
+	if( chunk.Height == 0 ) {
+		return;
+	}
+	if( sketch == nullptr ) {
+		initialize( chunk );
+	}
+	NeoAssert( chunk.Width <= sketch->Width() );
+
+	for( int i = 0; i < chunk.Height; i++ ) {
+		const CFloatVectorDesc row = chunk.GetRow( i );
+		for( int j = 0; j < row.Size; j++ ) {
+			const int index = row.Indexes == nullptr ? j : row.Indexes[j];
+			sums[index] += row.Values[j];
+			squaredSums[index] += static_cast<double>( row.Values[j] ) * row.Values[j];
+		}
+	}
+	sketch->Add( chunk );
+	vectorCount += chunk.Height;
+	// The decomposition of the sketch is much slower than adding a chunk, so it's postponed until the results are needed
+	isComponentsDirty = true;
+}
+
+void CIncrementalPca::Fit( IFloatMatrixChunkSource& data )
+{
+	CFloatMatrixDesc chunk;
+	while( data.GetNextChunk( chunk ) ) {
+		PartialFit( chunk );
+	}
+}
+
+CSparseFloatMatrixDesc CIncrementalPca::Transform( const CFloatMatrixDesc& data )
+{
+	NeoAssert( sketch != nullptr );
+	const int width = sketch->Width();
+	const int components = GetComponentsNum();
+	transformedMatrix = CSparseFloatMatrix( components, data.Height );
+	if( data.Height == 0 ) {
+		return transformedMatrix.GetDesc();
+	}
+
+	// ( data - 1 * T(mean) ) * T(components) = data * T(components) - 1 * T(components * mean)
+	const CPcaChunk chunk( mathEngine, data, width );
+	CPtr<CDnnBlob> componentsBlob = CDnnBlob::CreateDataBlob( mathEngine, CT_Float, 1, components, width );
+	componentsBlob->CopyFrom( componentsMatrix.GetPtr() );
+	CPtr<CDnnBlob> transformed = CDnnBlob::CreateDataBlob( mathEngine, CT_Float, 1, data.Height, components );
+	chunk.MultiplyByTransposed( componentsBlob->GetData(), components, transformed->GetData() );
+
+	CArray<float> meanProjection;
+	meanProjection.Add( 0.f, components );
+	for( int i = 0; i < components; i++ ) {
+		for( int j = 0; j < width; j++ ) {
+			meanProjection[i] += componentsMatrix[i * width + j] * mean[j];
+		}
+	}
+	CArray<float> result;
+	result.SetSize( data.Height * components );
+	transformed->CopyTo( result.GetPtr() );
+	for( int i = 0; i < data.Height; i++ ) {
+		for( int j = 0; j < components; j++ ) {
+			result[i * components + j] -= meanProjection[j];
+		}
+	}
+	convertToMatrix( result.GetPtr(), transformedMatrix, data.Height, components, components );
+	return transformedMatrix.GetDesc();
+}
+
+CSparseFloatMatrix CIncrementalPca::GetComponents()
+{
+	const int components = GetComponentsNum();
+	const int width = components == 0 ? 0 : componentsMatrix.Size() / components;
+	CSparseFloatMatrix matrix( width, components );
+	convertToMatrix( componentsMatrix.GetPtr(), matrix, components, width, width );
+	return matrix;
+}
+
+void CIncrementalPca::Serialize( CArchive& archive )
+{
+	archive.SerializeVersion( 0 );
+	if( archive.IsStoring() ) {
+		archive << params.Components << params.OverSamples << params.Seed;
+		archive << vectorCount;
+		if( vectorCount > 0 ) {
+			archive << origin << sums << squaredSums;
+			CArray<float> sketchData;
+			sketch->GetData( sketchData );
+			archive << sketchData;
+		}
+	} else if( archive.IsLoading() ) {
+		archive >> params.Components >> params.OverSamples >> params.Seed;
+		archive >> vectorCount;
+		sketch.Release();
+		origin.Empty();
+		sums.Empty();
+		squaredSums.Empty();
+		mean.Empty();
+		singularValues.Empty();
+		explainedVariance.Empty();
+		explainedVarianceRatio.Empty();
+		componentsMatrix.Empty();
+		noiseVariance = 0;
+		isComponentsDirty = false;
+		if( vectorCount > 0 ) {
+			archive >> origin >> sums >> squaredSums;
+			CArray<float> sketchData;
+			archive >> sketchData;
+			const int width = origin.Size();
+			sketch = FINE_DEBUG_NEW CSketch( mathEngine, width, min( params.Components + params.OverSamples, width ),
+				params.Seed );
+			sketch->SetOrigin( origin );
+			sketch->SetData( sketchData );
+			isComponentsDirty = true;
+		}
+	} else {
+		NeoAssert( false );
+	}
+}
+
+// Creates the sketch with the origin in the mean of the first chunk
+void CIncrementalPca::initialize( const CFloatMatrixDesc& chunk )
+{
+	const int width = chunk.Width;
+	NeoAssert( params.Components <= width );
+
+	origin.Empty();
+	origin.Add( 0.f, width );
+	for( int i = 0; i < chunk.Height; i++ ) {
+		const CFloatVectorDesc row = chunk.GetRow( i );
+		for( int j = 0; j < row.Size; j++ ) {
+			origin[row.Indexes == nullptr ? j : row.Indexes[j]] += row.Values[j];
+		}
+	}
+	for( int j = 0; j < width; j++ ) {
+		origin[j] /= chunk.Height;
+	}
+	sums.Empty();
+	sums.Add( 0., width );
+	squaredSums.Empty();
+	squaredSums.Add( 0., width );
+
+	sketch = FINE_DEBUG_NEW CSketch( mathEngine, width, min( params.Components + params.OverSamples, width ), params.Seed );
+	sketch->SetOrigin( origin );
+}
+
+// Finds the components and their variance by the current state
+void CIncrementalPca::updateComponents() const
+{
+	const int width = sketch->Width();
+	const double count = vectorCount;
+
+	mean.SetSize( width );
+	CArray<double> shift;
+	shift.SetSize( width );
+	double totalVariance = 0;
+	for( int j = 0; j < width; j++ ) {
+		const double featureMean = sums[j] / count;
+		mean[j] = static_cast<float>( featureMean );
+		shift[j] = featureMean - origin[j];
+		totalVariance += max( 0., squaredSums[j] - sums[j] * featureMean );
+	}
+	totalVariance = vectorCount > 1 ? totalVariance / ( count - 1 ) : 0.;
+
+	sketch->Calculate( shift, count, params.Components, singularValues, componentsMatrix );
+
+	const int components = singularValues.Size();
+	explainedVariance.SetSize( components );
+	explainedVarianceRatio.SetSize( components );
+	double explainedTotal = 0;
+	for( int i = 0; i < components; i++ ) {
+		const double variance = vectorCount > 1 ? singularValues[i] * singularValues[i] / ( count - 1 ) : 0.;
+		explainedVariance[i] = static_cast<float>( variance );
+		explainedVarianceRatio[i] = totalVariance > 0 ? static_cast<float>( variance / totalVariance ) : 0.f;
+		explainedTotal += variance;
+	}
+	noiseVariance = static_cast<float>( max( 0., totalVariance - explainedTotal ) / max( 1, width - components ) );
+	isComponentsDirty = false;
+}
@@ -23,12 +23,18 @@ limitations under the License.
 #pragma hdrstop
 
 #include <SMOptimizer.h>
+#include <NeoMathEngine/ThreadPool.h>
 
 namespace NeoML {
 
 const double CSMOptimizer::Inf = HUGE_VAL;
 const double CSMOptimizer::Tau = 1e-12;
 
+// The minimum number of the kernel matrix column operations which is worth running in parallel
+static constexpr int64_t KernelMatrixMinParallelComplexity = 32768;
+// The minimum number of the vectors which is worth processing in parallel on each iteration
+static constexpr int SMOptimizerMinParallelSize = 8192;
+
 // Kernel cache
 //
 // matrixSize is the matrix size 
@@ -187,7 +193,7 @@ void CKernelCache::SwapIndices( int i, int j )
 // The kernel matrix CKernelMatrix(i, j) = K(i, j) * y_i * y_j
 class CKernelMatrix {
 public:
-	CKernelMatrix( const IProblem& data, const CSvmKernel& kernel, int cacheSize );
+	CKernelMatrix( const IProblem& data, const CSvmKernel& kernel, IThreadPool& threadPool, int cacheSize );
 
 	// Gets the pointer to a column
 	const float* GetColumn( int i, int len ) const;
@@ -200,6 +206,7 @@ public:
 
 private:
 	CSvmKernel kernel; // the SVM kernel
+	IThreadPool& threadPool; // the executors for the columns calculation
 	mutable CKernelCache cache; // the columns cache
 	CArray<CFloatVectorDesc> matrix; // the problem data
 	CFloatVectorDesc* x; // raw pointer to data
@@ -207,10 +214,13 @@ private:
 	float* y; // raw pointer to binary classes
 	CArray<double> diagonal; // the matrix diagonal
 	double* d; // raw pointer to diagonal
+
+	void calculateColumn( int i, int start, int end, float* column ) const;
 };
 
-CKernelMatrix::CKernelMatrix( const IProblem& data, const CSvmKernel& kernel, int cacheSize ) :
+CKernelMatrix::CKernelMatrix( const IProblem& data, const CSvmKernel& kernel, IThreadPool& threadPool, int cacheSize ) :
 	kernel(kernel), 
+	threadPool( threadPool ),
 	cache( data.GetVectorCount(), cacheSize * (1<<20) )
 {
 	matrix.SetSize( data.GetVectorCount() );
@@ -231,37 +241,55 @@ CKernelMatrix::CKernelMatrix( const IProblem& data, const CSvmKernel& kernel, in
 const float* CKernelMatrix::GetColumn( int i, int len ) const
 {
 	float* column;
-	int start = cache.GetColumn( i, column, len );
-	if( start < len ) {
-		float y_i = y[i];
-		auto x_i = x[i];
-		auto calcData = [&]( int j ) {
-			// the cache matrix is symmetrical so col[i][j] == col[j][i]
-			int jColLen;
-			float* jColData = cache.GetColumn( j, jColLen );
-			if( jColLen > i ) {
-				column[j] = jColData[i];
-			} else {
-				column[j] = static_cast<float>( y_i * y[j] * kernel.Calculate( x_i, x[j] ) );
-			}
-		};
+	const int start = cache.GetColumn( i, column, len );
+	if( start >= len ) {
+		return column;
+	}
+
+	const int64_t complexity = static_cast<int64_t>( len - start ) * max( x[i].Size, 1 );
+	if( threadPool.Size() == 1 || complexity < KernelMatrixMinParallelComplexity ) {
+		calculateColumn( i, start, len, column );
+		return column;
+	}
+
+	// The column parts are calculated in parallel, the cache isn't modified meanwhile
+	struct CTask {
+		const CKernelMatrix& Matrix;
+		int I;
+		int Start;
+		int Len;
+		float* Column;
+	} task{ *this, i, start, len, column };
+	NEOML_NUM_THREADS( threadPool, &task, []( int threadIndex, void* ptr ) {
+		const CTask& task = *static_cast<CTask*>( ptr );
+		int index = 0;
+		int count = 0;
+		if( GetTaskIndexAndCount( task.Matrix.threadPool.Size(), threadIndex, task.Len - task.Start, index, count ) ) {
+			task.Matrix.calculateColumn( task.I, task.Start + index, task.Start + index + count, task.Column );
+		}
+	} );
+	return column;
+}
 
-		// set diagonal element if it's needed
-		if( i >= start && i < len ) {
-			for( int j = start; j < i; ++j ) {
-				calcData( j );
-			}
-			column[i] = static_cast<float>( d[i] );
-			for( int j = i+1; j < len; ++j ) {
-				calcData( j );
-			}
+// Calculates the column elements [start, end)
+void CKernelMatrix::calculateColumn( int i, int start, int end, float* column ) const
+{
+	const float y_i = y[i];
+	const CFloatVectorDesc& x_i = x[i];
+	for( int j = start; j < end; ++j ) {
+		if( j == i ) {
+			column[j] = static_cast<float>( d[i] );
+			continue;
+		}
+		// the cache matrix is symmetrical so col[i][j] == col[j][i]
+		int jColLen;
+		const float* jColData = cache.GetColumn( j, jColLen );
+		if( jColLen > i ) {
+			column[j] = jColData[i];
 		} else {
-			for( int j = start; j < len; ++j ) {
-				calcData( j );
-			}
+			column[j] = static_cast<float>( y_i * y[j] * kernel.Calculate( x_i, x[j] ) );
 		}
 	}
-	return column;
 }
 
 void CKernelMatrix::SwapIndices( int i, int j )
@@ -274,14 +302,15 @@ void CKernelMatrix::SwapIndices( int i, int j )
 
 //---------------------------------------------------------------------------------------------------
 
-CSMOptimizer::CSMOptimizer(const CSvmKernel& kernel, const IProblem& _data,
+CSMOptimizer::CSMOptimizer(const CSvmKernel& kernel, const IProblem& _data, IThreadPool& _threadPool,
 		int _maxIter, double _errorWeight, double _tolerance, bool _doShrinking, int cacheSize) :
 	data( &_data ),
+	threadPool( _threadPool ),
 	maxIter( _maxIter ),
 	errorWeight( _errorWeight ),
 	tolerance( _tolerance ),
 	doShrinking( _doShrinking ),
-	kernelMatrix( FINE_DEBUG_NEW CKernelMatrix( _data, kernel, cacheSize ) ),
+	kernelMatrix( FINE_DEBUG_NEW CKernelMatrix( _data, kernel, _threadPool, cacheSize ) ),
 	log( nullptr ),
 	vectorCount( data->GetVectorCount() ),
 	y( kernelMatrix->GetBinaryClasses() ),
@@ -380,6 +409,31 @@ void CSMOptimizer::Optimize( CArray<double>& _alpha, float& freeTerm )
 	}
 }
 
+// Calls func( threadIndex, start, end ) on the parts of [0, size)
+// The parts are processed in parallel only if there are enough vectors to pay off the synchronization
+template<class TFunc>
+void CSMOptimizer::parallelRun( int size, const TFunc& func ) const
+{
+	if( threadPool.Size() == 1 || size < SMOptimizerMinParallelSize ) {
+		func( 0, 0, size );
+		return;
+	}
+
+	struct CTask {
+		const TFunc& Func;
+		int Size;
+		int ThreadCount;
+	} task{ func, size, threadPool.Size() };
+	NEOML_NUM_THREADS( threadPool, &task, []( int threadIndex, void* ptr ) {
+		const CTask& task = *static_cast<CTask*>( ptr );
+		int start = 0;
+		int count = 0;
+		if( GetTaskIndexAndCount( task.ThreadCount, threadIndex, task.Size, start, count ) ) {
+			task.Func( threadIndex, start, start + count );
+		}
+	} );
+}
+
 // return `false` if already optimal, return `true` otherwise
 // i: maximizes -y_i * grad(f)_i, i in I_up(\alpha)
 // j: minimizes the decrease of obj value
@@ -387,25 +441,44 @@ void CSMOptimizer::Optimize( CArray<double>& _alpha, float& freeTerm )
 //  -y_j*grad(f)_j < -y_i*grad(f)_i, j in I_low(\alpha)
 bool CSMOptimizer::findMaxViolatingIndices( int& outI, int& outJ ) const
 {
-	double gMax = -Inf;
-	double gMax2 = -Inf;
-	int gMaxIdx = -1;
-	int gMinIdx = -1;
-	double objDiffMin = Inf;
-
-	for( int i = 0; i < activeSize; ++i) {
-		if( y[i] == 1 ) {
-			if( alphaStatus[i] != AS_UpperBound ) {
-				if( -g[i] >= gMax ) {
-					gMax = -g[i];
+	// The best candidates of each part of the active set
+	// The parts are merged in order so the result is the same as of the sequential search
+	struct CCandidates {
+		double GMax = -Inf;
+		double GMax2 = -Inf;
+		int GMaxIdx = -1;
+		int GMinIdx = -1;
+		double ObjDiffMin = Inf;
+	};
+	CFastArray<CCandidates, 16> candidates;
+	candidates.Add( CCandidates(), threadPool.Size() );
+
+	parallelRun( activeSize, [&]( int threadIndex, int start, int end ) {
+		double& gMax = candidates[threadIndex].GMax;
+		int& gMaxIdx = candidates[threadIndex].GMaxIdx;
+		for( int i = start; i < end; ++i ) {
+			if( y[i] == 1 ) {
+				if( alphaStatus[i] != AS_UpperBound ) {
+					if( -g[i] >= gMax ) {
+						gMax = -g[i];
+						gMaxIdx = i;
+					}
+				}
+			} else if( alphaStatus[i] != AS_LowerBound ) {
+				if(g[i] >= gMax) {
+					gMax = g[i];
 					gMaxIdx = i;
 				}
 			}
-		} else if( alphaStatus[i] != AS_LowerBound ) {
-			if(g[i] >= gMax) {
-				gMax = g[i];
-				gMaxIdx = i;
-			}
+		}
+	} );
+
+	double gMax = -Inf;
+	int gMaxIdx = -1;
+	for( int t = 0; t < candidates.Size(); ++t ) {
+		if( candidates[t].GMaxIdx != -1 && candidates[t].GMax >= gMax ) {
+			gMax = candidates[t].GMax;
+			gMaxIdx = candidates[t].GMaxIdx;
 		}
 	}
 
@@ -414,35 +487,49 @@ bool CSMOptimizer::findMaxViolatingIndices( int& outI, int& outJ ) const
 	}
 
 	const float* q_i = kernelMatrix->GetColumn( gMaxIdx, activeSize );
-	double y_i = y[gMaxIdx];
-	double qD_i = matrixDiagonal[gMaxIdx];
-	auto updateMinParams = [&]( double gradDiff, double multiplier, int j ) {
-		if( gradDiff > 0) {
-			double quadCoef = qD_i + matrixDiagonal[j] + multiplier * y_i * q_i[j];
-			if( quadCoef <= 0 ) {
-				quadCoef = Tau;
-			}
-			double objDiff = -( gradDiff * gradDiff ) / quadCoef;
-			if( objDiff <= objDiffMin ) {
-				gMinIdx = j;
-				objDiffMin = objDiff;
+	const double y_i = y[gMaxIdx];
+	const double qD_i = matrixDiagonal[gMaxIdx];
+	parallelRun( activeSize, [&]( int threadIndex, int start, int end ) {
+		CCandidates& part = candidates[threadIndex];
+		auto updateMinParams = [&]( double gradDiff, double multiplier, int j ) {
+			if( gradDiff > 0) {
+				double quadCoef = qD_i + matrixDiagonal[j] + multiplier * y_i * q_i[j];
+				if( quadCoef <= 0 ) {
+					quadCoef = Tau;
+				}
+				double objDiff = -( gradDiff * gradDiff ) / quadCoef;
+				if( objDiff <= part.ObjDiffMin ) {
+					part.GMinIdx = j;
+					part.ObjDiffMin = objDiff;
+				}
 			}
-		}
-	};
+		};
 
-	for( int j = 0; j < activeSize; ++j ) {
-		if( y[j] == 1 ) {
-			if( alphaStatus[j] != AS_LowerBound ) {
-				updateMinParams( gMax + g[j], -2, j );
-				if( g[j] >= gMax2 ) {
-					gMax2 = g[j];
+		for( int j = start; j < end; ++j ) {
+			if( y[j] == 1 ) {
+				if( alphaStatus[j] != AS_LowerBound ) {
+					updateMinParams( gMax + g[j], -2, j );
+					if( g[j] >= part.GMax2 ) {
+						part.GMax2 = g[j];
+					}
+				}
+			} else if( alphaStatus[j] != AS_UpperBound ) {
+				updateMinParams( gMax - g[j], 2, j );
+				if( -g[j] >= part.GMax2 ) {
+					part.GMax2 = -g[j];
 				}
 			}
-		} else if( alphaStatus[j] != AS_UpperBound ) {
-			updateMinParams( gMax - g[j], 2, j );
-			if( -g[j] >= gMax2 ) {
-				gMax2 = -g[j];
-			}
+		}
+	} );
+
+	double gMax2 = -Inf;
+	int gMinIdx = -1;
+	double objDiffMin = Inf;
+	for( int t = 0; t < candidates.Size(); ++t ) {
+		gMax2 = max( gMax2, candidates[t].GMax2 );
+		if( candidates[t].GMinIdx != -1 && candidates[t].ObjDiffMin <= objDiffMin ) {
+			gMinIdx = candidates[t].GMinIdx;
+			objDiffMin = candidates[t].ObjDiffMin;
 		}
 	}
 
@@ -532,11 +619,13 @@ void CSMOptimizer::optimizeIndices( int i, int j )
 	}
 	
 	// Modify the g
-	double deltaAlpha_i = alpha[i] - oldAlpha_i;
-	double deltaAlpha_j = alpha[j] - oldAlpha_j;
-	for(int k = 0; k < activeSize; k++) {
-		g[k] += q_i[k] * deltaAlpha_i + q_j[k] * deltaAlpha_j;
-	}
+	const double deltaAlpha_i = alpha[i] - oldAlpha_i;
+	const double deltaAlpha_j = alpha[j] - oldAlpha_j;
+	parallelRun( activeSize, [&]( int /*threadIndex*/, int start, int end ) {
+		for( int k = start; k < end; k++ ) {
+			g[k] += q_i[k] * deltaAlpha_i + q_j[k] * deltaAlpha_j;
+		}
+	} );
 }
 
 void CSMOptimizer::updateAlphaStatusAndGradient0( int i )
@@ -555,15 +644,12 @@ void CSMOptimizer::updateAlphaStatusAndGradient0( int i )
 	bool isUB = alphaStatus[i] == AS_UpperBound;
 	if( wasUB != isUB ) {
 		auto q_i = kernelMatrix->GetColumn( i, vectorCount );
-		if( wasUB ) {
-			for( int j = 0; j < vectorCount; ++j ) {
-				g0[j] -= c_i * q_i[j];
-			}
-		} else {
-			for( int j = 0; j < vectorCount; ++j ) {
-				g0[j] += c_i * q_i[j];
+		const double delta = wasUB ? -c_i : c_i;
+		parallelRun( vectorCount, [&]( int /*threadIndex*/, int start, int end ) {
+			for( int j = start; j < end; ++j ) {
+				g0[j] += delta * q_i[j];
 			}
-		}
+		} );
 	}
 }
 
@@ -603,10 +689,12 @@ void CSMOptimizer::reconstructGradient()
 		for( int i = 0; i < activeSize; ++i ) {
 			if( alphaStatus[i] == AS_Free ) {
 				auto q_i = kernelMatrix->GetColumn( i, vectorCount );
-				double alpha_i = alpha[i];
-				for( int j = activeSize; j < vectorCount; ++j ) {
-					g[j] += alpha_i * q_i[j];
-				}
+				const double alpha_i = alpha[i];
+				parallelRun( vectorCount - activeSize, [&]( int /*threadIndex*/, int start, int end ) {
+					for( int j = activeSize + start; j < activeSize + end; ++j ) {
+						g[j] += alpha_i * q_i[j];
+					}
+				} );
 			}
 		}
 	}
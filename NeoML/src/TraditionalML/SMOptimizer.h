@@ -24,6 +24,7 @@ limitations under the License.
 namespace NeoML {
 
 class CKernelMatrix;
+class IThreadPool;
 
 // The classification rule:
 //
@@ -43,10 +44,11 @@ class CSMOptimizer {
 public:
 	// kernel is the SVM kernel function
 	// data contains the training set
+	// threadPool calculates the kernel matrix columns and updates the gradients
 	// tolerance is the required precision
 	// cacheSize is the cache size in MB
-	CSMOptimizer(const CSvmKernel& kernel, const IProblem& data, int maxIter, double errorWeight, double tolerance,
-		bool doShrinking, int cacheSize = 200);
+	CSMOptimizer(const CSvmKernel& kernel, const IProblem& data, IThreadPool& threadPool, int maxIter,
+		double errorWeight, double tolerance, bool doShrinking, int cacheSize = 200);
 	~CSMOptimizer();
 
 	// Calculates the optimal multipliers for the support vectors
@@ -67,6 +69,7 @@ private:
 	static const double Tau; // infinitesimal number
 
 	const CPtr<const IProblem> data; // the training set
+	IThreadPool& threadPool; // the parallel executors
 	int maxIter; // maximal iteration
 	const double errorWeight; // the error weight relative to the regularizer (the relative weight of the data set)
 	const double tolerance; // the stop criterion
@@ -94,6 +97,8 @@ private:
 	int activeSize; // number of vector that are being optimized in this moment
 	bool isShrunk; // whether the problem was shrunk or not
 
+	template<class TFunc>
+	void parallelRun( int size, const TFunc& func ) const;
 	bool findMaxViolatingIndices( int& outI, int& outJ ) const;
 	void optimizeIndices( int i, int j );
 	void updateAlphaStatusAndGradient0( int i );
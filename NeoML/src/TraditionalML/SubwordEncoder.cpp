@@ -17,6 +17,7 @@ limitations under the License.
 #pragma hdrstop
 
 #include <NeoML/TraditionalML/SubwordEncoder.h>
+#include <NeoMathEngine/ThreadPool.h>
 
 namespace NeoML {
 
@@ -34,14 +35,18 @@ void ISubwordEncoder::CParams::Serialize( CArchive& archive )
 //////////////////////////////////////
 
 ISubwordEncoderWithCache::CCache::CCachedData::CCachedData( const CCachedData& other ) :
-	Time( other.Time )
+	Word( other.Word ),
+	Prev( other.Prev ),
+	Next( other.Next )
 {
 	other.TokenIds.CopyTo( TokenIds );
 	other.TokenLengths.CopyTo( TokenLengths );
 }
 
 ISubwordEncoderWithCache::CCache::CCachedData::CCachedData( CCachedData&& other ) :
-	Time( other.Time )
+	Word( std::move( other.Word ) ),
+	Prev( other.Prev ),
+	Next( other.Next )
 {
 	other.TokenIds.MoveTo( TokenIds );
 	other.TokenLengths.MoveTo( TokenLengths );
@@ -49,12 +54,102 @@ ISubwordEncoderWithCache::CCache::CCachedData::CCachedData( CCachedData&& other
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// Makes the entry the most recently used one
+void ISubwordEncoderWithCache::CCache::CShard::MoveToFront( int entry )
+{
+	if( First == entry ) {
+		return;
+	}
+	if( Entries[entry].Prev != NotFound || Last == entry ) {
+		Unlink( entry );
+	}
+	Entries[entry].Next = First;
+	if( First != NotFound ) {
+		Entries[First].Prev = entry;
+	}
+	First = entry;
+	if( Last == NotFound ) {
+		Last = entry;
+	}
+}
+
+// Removes the entry from the LRU list
+void ISubwordEncoderWithCache::CCache::CShard::Unlink( int entry )
+{
+	CCachedData& data = Entries[entry];
+	if( data.Prev != NotFound ) {
+		Entries[data.Prev].Next = data.Next;
+	} else {
+		First = data.Next;
+	}
+	if( data.Next != NotFound ) {
+		Entries[data.Next].Prev = data.Prev;
+	} else {
+		Last = data.Prev;
+	}
+	data.Prev = NotFound;
+	data.Next = NotFound;
+}
+
+// Evicts the least recently used entries until no more than capacity entries remain
+// The last entry of the array takes the place of the evicted one
+void ISubwordEncoderWithCache::CCache::CShard::Trim( int capacity )
+{
+	while( Entries.Size() > capacity ) {
+		const int evicted = Last;
+		Unlink( evicted );
+		WordToEntry.Delete( Entries[evicted].Word );
+
+		const int moved = Entries.Size() - 1;
+		if( moved != evicted ) {
+			CCachedData& data = Entries[moved];
+			if( data.Prev != NotFound ) {
+				Entries[data.Prev].Next = evicted;
+			} else {
+				First = evicted;
+			}
+			if( data.Next != NotFound ) {
+				Entries[data.Next].Prev = evicted;
+			} else {
+				Last = evicted;
+			}
+			WordToEntry.Get( data.Word ) = evicted;
+			Entries.ReplaceAt( std::move( data ), evicted );
+		}
+		Entries.DeleteLast();
+	}
+}
+
+void ISubwordEncoderWithCache::CCache::CShard::Clear()
+{
+	WordToEntry.DeleteAll();
+	Entries.DeleteAll();
+	First = NotFound;
+	Last = NotFound;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+ISubwordEncoderWithCache::CCache::CCache() :
+	cachePeriod( 50000 ),
+	hits( 0 ),
+	misses( 0 )
+{
+}
+
 void ISubwordEncoderWithCache::CCache::SetCachePeriod( int newPeriod )
 {
 	NeoAssert( newPeriod == NotFound || newPeriod > 0 );
 	cachePeriod = newPeriod;
 	if( cachePeriod == NotFound ) {
 		Clear();
+		return;
+	}
+
+	const int capacity = shardCapacity();
+	for( CShard& shard : shards ) {
+		CCriticalSectionLock lock( shard.Section );
+		shard.Trim( capacity );
 	}
 }
 
@@ -65,40 +160,24 @@ bool ISubwordEncoderWithCache::CCache::Request( const CString& word,
 		return false;
 	}
 
-	cacheTime++;
-	bool success = false;
-	if( wordCache.Has( word ) ) {
-		CCachedData& wordData = wordCache.Get( word );
-		tokenIds.SetBufferSize( wordData.TokenIds.Size() );
-		tokenLengths.SetBufferSize( wordData.TokenLengths.Size() );
-
-		for( int i = 0; i < wordData.TokenIds.Size(); i++ ) {
-			tokenIds.Add( wordData.TokenIds[i] );
-			tokenLengths.Add( wordData.TokenLengths[i] );
-		}
-		wordData.Time = cacheTime;
-		success = true;
+	CShard& shard = getShard( word );
+	CCriticalSectionLock lock( shard.Section );
+	int entry = NotFound;
+	if( !shard.WordToEntry.Lookup( word, entry ) ) {
+		misses++;
+		return false;
 	}
 
-	// Removes items from cache.
-	// The item is erased if there has not been a request with the same word since the previous cleanup. 
-	if( cacheTime % cachePeriod == 0 ) {
-		CArray<CString> wordsToDelete;
-		for( TMapPosition pos = wordCache.GetFirstPosition(); pos != NotFound;
-			pos = wordCache.GetNextPosition( pos ) )
-		{
-			const CCachedData& wordData = wordCache.GetValue( pos );
-			if( cacheTime - wordData.Time >= cachePeriod ) {
-				wordsToDelete.Add( wordCache.GetKey( pos ) );
-			}
-		}
-
-		for( int i = 0; i < wordsToDelete.Size(); i++ ) {
-			wordCache.Delete( wordsToDelete[i] );
-		}
+	const CCachedData& wordData = shard.Entries[entry];
+	tokenIds.SetBufferSize( tokenIds.Size() + wordData.TokenIds.Size() );
+	tokenLengths.SetBufferSize( tokenLengths.Size() + wordData.TokenLengths.Size() );
+	for( int i = 0; i < wordData.TokenIds.Size(); i++ ) {
+		tokenIds.Add( wordData.TokenIds[i] );
+		tokenLengths.Add( wordData.TokenLengths[i] );
 	}
-
-	return success;
+	shard.MoveToFront( entry );
+	hits++;
+	return true;
 }
 
 void ISubwordEncoderWithCache::CCache::Add( const CString& word,
@@ -109,16 +188,64 @@ void ISubwordEncoderWithCache::CCache::Add( const CString& word,
 		return;
 	}
 
-	NeoAssert( !wordCache.Has( word ) );
 	NeoAssert( tokenIds.Size() == tokenLengths.Size() );
 
-	CCachedData wordData;
-	wordData.Time = cacheTime;
+	CShard& shard = getShard( word );
+	CCriticalSectionLock lock( shard.Section );
+	int entry = NotFound;
+	if( shard.WordToEntry.Lookup( word, entry ) ) {
+		// The word has been encoded by another thread
+		shard.MoveToFront( entry );
+		return;
+	}
+
+	shard.Trim( shardCapacity() - 1 );
+	entry = shard.Entries.Size();
+	CCachedData& wordData = shard.Entries.Append();
+	wordData.Word = word;
+	wordData.TokenIds.SetBufferSize( tokenIds.Size() );
+	wordData.TokenLengths.SetBufferSize( tokenLengths.Size() );
 	for( int i = 0; i < tokenIds.Size(); i++ ) {
 		wordData.TokenIds.Add( tokenIds[i] );
 		wordData.TokenLengths.Add( tokenLengths[i] );
 	}
-	wordCache.Add( word, wordData );
+	shard.WordToEntry.Add( word, entry );
+	shard.MoveToFront( entry );
+}
+
+void ISubwordEncoderWithCache::CCache::Clear()
+{
+	for( CShard& shard : shards ) {
+		CCriticalSectionLock lock( shard.Section );
+		shard.Clear();
+	}
+	hits = 0;
+	misses = 0;
+}
+
+ISubwordEncoderWithCache::CCacheStatistics ISubwordEncoderWithCache::CCache::GetStatistics() const
+{
+	CCacheStatistics statistics;
+	statistics.Hits = hits;
+	statistics.Misses = misses;
+	for( const CShard& shard : shards ) {
+		CCriticalSectionLock lock( const_cast<CCriticalSection&>( shard.Section ) );
+		statistics.Size += shard.Entries.Size();
+	}
+	return statistics;
+}
+
+ISubwordEncoderWithCache::CCache::CShard& ISubwordEncoderWithCache::CCache::getShard( const CString& word )
+{
+	// The high bits of the hash are used, the low ones choose the bucket of the shard map
+	const unsigned int hash = static_cast<unsigned int>( GetDefaultHash( word ) ) * 2654435761u;
+	return shards[( hash >> 16 ) % ShardCount];
+}
+
+// The maximum number of the words in a shard
+int ISubwordEncoderWithCache::CCache::shardCapacity() const
+{
+	return max( 1, ( cachePeriod + ShardCount - 1 ) / ShardCount );
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -139,4 +266,68 @@ void ISubwordEncoderWithCache::Encode( const CString& word, CArray<int>& tokenId
 
 	cache.Add( word, wordTokenIds, wordTokenLengths );
 }
+
+// The minimum number of the words encoded by a thread of EncodeBatch
+static constexpr int EncodeBatchMinWordsPerThread = 64;
+
+void ISubwordEncoderWithCache::EncodeBatch( const CArray<CString>& words, CArray<CArray<int>>& tokenIds,
+	CArray<CArray<int>>& tokenLengths, int threadCount ) const
+{
+	if( threadCount <= 0 ) {
+		threadCount = GetAvailableCpuCores();
+	}
+	if( words.Size() < 2 * EncodeBatchMinWordsPerThread || threadCount == 1 ) {
+		tokenIds.DeleteAll();
+		tokenIds.SetSize( words.Size() );
+		tokenLengths.DeleteAll();
+		tokenLengths.SetSize( words.Size() );
+		for( int i = 0; i < words.Size(); ++i ) {
+			Encode( words[i], tokenIds[i], tokenLengths[i] );
+		}
+		return;
+	}
+
+	CPtrOwner<IThreadPool> threadPool( CreateThreadPool(
+		min( threadCount, words.Size() / EncodeBatchMinWordsPerThread ) ) );
+	EncodeBatch( words, tokenIds, tokenLengths, *threadPool );
+}
+
+void ISubwordEncoderWithCache::EncodeBatch( const CArray<CString>& words, CArray<CArray<int>>& tokenIds,
+	CArray<CArray<int>>& tokenLengths, IThreadPool& threadPool ) const
+{
+	tokenIds.DeleteAll();
+	tokenIds.SetSize( words.Size() );
+	tokenLengths.DeleteAll();
+	tokenLengths.SetSize( words.Size() );
+	if( words.IsEmpty() ) {
+		return;
+	}
+
+	struct CTask {
+		const ISubwordEncoderWithCache& Encoder;
+		const CArray<CString>& Words;
+		CArray<CArray<int>>& TokenIds;
+		CArray<CArray<int>>& TokenLengths;
+		int ThreadCount;
+	} task{ *this, words, tokenIds, tokenLengths,
+		min( threadPool.Size(), max( 1, words.Size() / EncodeBatchMinWordsPerThread ) ) };
+	auto encodeRange = []( int threadIndex, void* ptr ) {
+		CTask& task = *static_cast<CTask*>( ptr );
+		int start = 0;
+		int count = 0;
+		if( threadIndex < task.ThreadCount
+			&& GetTaskIndexAndCount( task.ThreadCount, threadIndex, task.Words.Size(), start, count ) )
+		{
+			for( int i = start; i < start + count; ++i ) {
+				task.Encoder.Encode( task.Words[i], task.TokenIds[i], task.TokenLengths[i] );
+			}
+		}
+	};
+	if( task.ThreadCount == 1 ) {
+		encodeRange( 0, &task );
+		return;
+	}
+	NEOML_NUM_THREADS( threadPool, &task, encodeRange );
+}
+
 } // namespace NeoML
@@ -71,7 +71,8 @@ CPtr<ISubwordEncoder> CSubwordEncoderTrainer::Train( const CWordDictionary& freq
 		CBpeTrainer trainer( desiredVocabSize, borderHandling, vocabPruning == TVocabPruning::ByteBPE, encoderUnkTokenId );
 		return trainer.Train( frequencyDict, charDict ).Ptr();
 	} else {
-		CUnigramTrainer trainer( desiredVocabSize, borderHandling, vocabPruning == TVocabPruning::ByteBPE, encoderUnkTokenId );
+		CUnigramTrainer trainer( desiredVocabSize, borderHandling, vocabPruning == TVocabPruning::ByteBPE, encoderUnkTokenId,
+			threadCount );
 		return trainer.Train( frequencyDict, charDict ).Ptr();
 	}
 }
@@ -183,7 +183,7 @@ CPtr<IModel> CSvm::Train( const IProblem& problem )
 
 	const CSvmKernel kernel( params.KernelType, params.Degree, params.Gamma, params.Coeff0 );
 
-	CSMOptimizer optimizer( kernel, problem, params.MaxIterations,
+	CSMOptimizer optimizer( kernel, problem, *threadPool, params.MaxIterations,
 		params.ErrorWeight, params.Tolerance, params.DoShrinking );
 	if( log != nullptr ) {
 		optimizer.SetLog( log );
@@ -17,11 +17,22 @@ limitations under the License.
 #pragma hdrstop
 
 #include <SvmBinaryModel.h>
+#include <SvmBlockKernel.h>
 
 namespace NeoML {
 
 ISvmBinaryModel::~ISvmBinaryModel() = default;
 
+void ISvmBinaryModel::ClassifyBatch( const CFloatMatrixDesc& data, CArray<CClassificationResult>& results ) const
+{
+	results.SetSize( data.Height );
+	CFloatVectorDesc row;
+	for( int i = 0; i < data.Height; i++ ) {
+		data.GetRow( i, row );
+		Classify( row, results[i] );
+	}
+}
+
 //---------------------------------------------------------------------
 
 REGISTER_NEOML_MODEL( CSvmBinaryModel, SvmBinaryModelName )
@@ -54,6 +65,8 @@ CSvmBinaryModel::CSvmBinaryModel( const CSvmKernel& _kernel,
 	}
 }
 
+CSvmBinaryModel::~CSvmBinaryModel() = default;
+
 bool CSvmBinaryModel::Classify( const CFloatVectorDesc& data, CClassificationResult& result ) const
 {
 	CFloatVectorDesc desc;
@@ -62,7 +75,41 @@ bool CSvmBinaryModel::Classify( const CFloatVectorDesc& data, CClassificationRes
 		matrix.GetRow( i, desc );
 		value += alpha[i] * kernel.Calculate( data, desc );
 	}
+	fillResult( value, result );
+	return true;
+}
+
+void CSvmBinaryModel::ClassifyBatch( const CFloatMatrixDesc& data, CArray<CClassificationResult>& results ) const
+{
+	results.SetSize( data.Height );
+	if( alpha.IsEmpty() ) {
+		for( int i = 0; i < data.Height; i++ ) {
+			fillResult( freeTerm, results[i] );
+		}
+		return;
+	}
+
+	CArray<float> kernelValues;
+	{
+		CCriticalSectionLock lock( blockKernelSection );
+		if( blockKernel == nullptr ) {
+			blockKernel.reset( new CSvmBlockKernel( kernel, matrix.GetDesc() ) );
+		}
+		blockKernel->Calculate( data, kernelValues );
+	}
+	for( int i = 0; i < data.Height; i++ ) {
+		const float* row = kernelValues.GetPtr() + i * alpha.Size();
+		double value = freeTerm;
+		for( int j = 0; j < alpha.Size(); j++ ) {
+			value += alpha[j] * row[j];
+		}
+		fillResult( value, results[i] );
+	}
+}
 
+// Converts the decision function value into the classification result
+void CSvmBinaryModel::fillResult( double value, CClassificationResult& result )
+{
 	const double probability = 1 / ( 1 + exp( value ) );
 	result.ExceptionProbability = CClassificationProbability( 0 );
 	result.Probabilities.SetSize( 2 );
@@ -74,12 +121,15 @@ bool CSvmBinaryModel::Classify( const CFloatVectorDesc& data, CClassificationRes
 	} else {
 		result.PreferredClass = 1;
 	}
-	return true;
 }
 
 void CSvmBinaryModel::Serialize( CArchive& archive )
 {
 	const int version = archive.SerializeVersion( 1 );
+	if( archive.IsLoading() ) {
+		CCriticalSectionLock lock( blockKernelSection );
+		blockKernel.reset();
+	}
 
 	if( archive.IsStoring() ) {
 		archive << kernel;
@@ -16,9 +16,12 @@ limitations under the License.
 #pragma once
 
 #include <NeoML/TraditionalML/Svm.h>
+#include <memory>
 
 namespace NeoML {
 
+class CSvmBlockKernel;
+
 // The binary SVM classifier
 class CSvmBinaryModel : public ISvmBinaryModel {
 public:
@@ -38,15 +41,22 @@ public:
 	CSparseFloatMatrix GetVectors() const override { return matrix; }
 	const CArray<double>& GetAlphas() const override { return alpha; }
 	double GetFreeTerm() const override { return freeTerm; }
+	void ClassifyBatch( const CFloatMatrixDesc& data, CArray<CClassificationResult>& results ) const override;
 
 protected:
-	~CSvmBinaryModel() override = default; // delete prohibited
+	~CSvmBinaryModel() override; // delete prohibited
 
 private:
 	CSvmKernel kernel{}; // the kernel
 	double freeTerm{}; // the free term
 	CSparseFloatMatrix matrix{}; // the support vectors
 	CArray<double> alpha{}; // the coefficients
+	// The kernel of the support vectors used by ClassifyBatch
+	// It's created on the first call and reset on loading; its math engine is used under the lock
+	mutable std::unique_ptr<CSvmBlockKernel> blockKernel;
+	mutable CCriticalSection blockKernelSection;
+
+	static void fillResult( double value, CClassificationResult& result );
 };
 
 } // namespace NeoML
@@ -0,0 +1,194 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#include <common.h>
+#pragma hdrstop
+
+#include <SvmBlockKernel.h>
+
+namespace NeoML {
+
+// Writes the vector into the zero-filled dense row of the given width
+// The features out of the width don't affect the dot products with the fixed vectors
+static void fillSvmDenseRow( const CFloatVectorDesc& desc, int width, float* row )
+{
+	if( desc.Indexes == nullptr ) {
+		::memcpy( row, desc.Values, min( desc.Size, width ) * sizeof( float ) );
+	} else {
+		for( int i = 0; i < desc.Size && desc.Indexes[i] < width; ++i ) {
+			row[desc.Indexes[i]] = desc.Values[i];
+		}
+	}
+}
+
+// Appends the features of the vector within the given width to the CSR arrays
+static void addSvmSparseRow( const CFloatVectorDesc& desc, int width, CArray<int>& columns, CArray<float>& values )
+{
+	if( desc.Indexes == nullptr ) {
+		for( int i = 0; i < min( desc.Size, width ); ++i ) {
+			if( desc.Values[i] != 0.f ) {
+				columns.Add( i );
+				values.Add( desc.Values[i] );
+			}
+		}
+	} else {
+		for( int i = 0; i < desc.Size && desc.Indexes[i] < width; ++i ) {
+			columns.Add( desc.Indexes[i] );
+			values.Add( desc.Values[i] );
+		}
+	}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+CSvmBlockKernel::CSvmBlockKernel( const CSvmKernel& _kernel, const CFloatMatrixDesc& vectors ) :
+	kernel( _kernel ),
+	width( max( vectors.Width, 1 ) ),
+	mathEngine( CreateCpuMathEngine( /*memoryLimit*/0u ) ),
+	isSparse( false ),
+	elementCount( 0 )
+{
+	NeoAssert( vectors.Height > 0 );
+
+	int64_t totalSize = 0;
+	squaredNorms.SetBufferSize( vectors.Height );
+	for( int i = 0; i < vectors.Height; ++i ) {
+		const CFloatVectorDesc desc = vectors.GetRow( i );
+		squaredNorms.Add( DotProduct( desc, desc ) );
+		totalSize += desc.Size;
+	}
+	// The sparse product is faster only if the most of the matrix is zero
+	isSparse = totalSize * 2 < static_cast<int64_t>( vectors.Height ) * width;
+
+	if( isSparse ) {
+		CArray<int> rowsData;
+		CArray<int> columnsData;
+		CArray<float> valuesData;
+		rowsData.Add( 0 );
+		for( int i = 0; i < vectors.Height; ++i ) {
+			addSvmSparseRow( vectors.GetRow( i ), width, columnsData, valuesData );
+			rowsData.Add( columnsData.Size() );
+		}
+		elementCount = valuesData.Size();
+		rows = CDnnBlob::CreateVector( *mathEngine, CT_Int, rowsData.Size() );
+		rows->CopyFrom( rowsData.GetPtr() );
+		columns = CDnnBlob::CreateVector( *mathEngine, CT_Int, max( columnsData.Size(), 1 ) );
+		values = CDnnBlob::CreateVector( *mathEngine, CT_Float, max( valuesData.Size(), 1 ) );
+		if( !valuesData.IsEmpty() ) {
+			mathEngine->DataExchangeTyped( columns->GetData<int>(), columnsData.GetPtr(), columnsData.Size() );
+			mathEngine->DataExchangeTyped( values->GetData(), valuesData.GetPtr(), valuesData.Size() );
+		}
+	} else {
+		CArray<float> valuesData;
+		valuesData.Add( 0.f, vectors.Height * width );
+		for( int i = 0; i < vectors.Height; ++i ) {
+			fillSvmDenseRow( vectors.GetRow( i ), width, valuesData.GetPtr() + i * width );
+		}
+		values = CDnnBlob::CreateDataBlob( *mathEngine, CT_Float, 1, vectors.Height, width );
+		values->CopyFrom( valuesData.GetPtr() );
+	}
+}
+
+void CSvmBlockKernel::Calculate( const CFloatMatrixDesc& queries, CArray<float>& result )
+{
+	const int vectorCount = VectorCount();
+	result.SetSize( queries.Height * vectorCount );
+	if( queries.Height == 0 ) {
+		return;
+	}
+
+	const int blockSize = max( 1, min( queries.Height, MaxBlockBufferSize / max( width, vectorCount ) ) );
+	CPtr<CDnnBlob> queryBlock = CDnnBlob::CreateDataBlob( *mathEngine, CT_Float, 1, blockSize, width );
+	CPtr<CDnnBlob> productBlock = CDnnBlob::CreateDataBlob( *mathEngine, CT_Float, 1, blockSize, vectorCount );
+	for( int start = 0; start < queries.Height; start += blockSize ) {
+		const int count = min( blockSize, queries.Height - start );
+		calculateBlock( queries, start, count, *queryBlock, *productBlock, result.GetPtr() + start * vectorCount );
+	}
+}
+
+// Calculates the kernel values for the queries [start, start + count)
+void CSvmBlockKernel::calculateBlock( const CFloatMatrixDesc& queries, int start, int count,
+	CDnnBlob& queryBlock, CDnnBlob& productBlock, float* result )
+{
+	const int vectorCount = VectorCount();
+	CArray<float> products;
+	products.SetSize( count * vectorCount );
+
+	if( isSparse ) {
+		// The product of the sparse fixed vectors and the dense queries is transposed
+		CArray<float> queryData;
+		queryData.Add( 0.f, count * width );
+		for( int i = 0; i < count; ++i ) {
+			fillSvmDenseRow( queries.GetRow( start + i ), width, queryData.GetPtr() + i * width );
+		}
+		mathEngine->DataExchangeTyped( queryBlock.GetData(), queryData.GetPtr(), queryData.Size() );
+		const CSparseMatrixDesc desc( elementCount, rows->GetData<int>(), columns->GetData<int>(), values->GetData() );
+		mathEngine->MultiplySparseMatrixByTransposedMatrix( vectorCount, width, count, desc,
+			queryBlock.GetData(), productBlock.GetData() );
+		CArray<float> transposed;
+		transposed.SetSize( count * vectorCount );
+		mathEngine->DataExchangeTyped( transposed.GetPtr(), CConstFloatHandle( productBlock.GetData() ), transposed.Size() );
+		for( int j = 0; j < vectorCount; ++j ) {
+			for( int i = 0; i < count; ++i ) {
+				products[i * vectorCount + j] = transposed[j * count + i];
+			}
+		}
+	} else if( queries.Columns != nullptr ) {
+		// The product of the sparse queries and the dense fixed vectors
+		CArray<int> rowsData;
+		CArray<int> columnsData;
+		CArray<float> valuesData;
+		rowsData.Add( 0 );
+		for( int i = 0; i < count; ++i ) {
+			addSvmSparseRow( queries.GetRow( start + i ), width, columnsData, valuesData );
+			rowsData.Add( columnsData.Size() );
+		}
+		CPtr<CDnnBlob> queryRows = CDnnBlob::CreateVector( *mathEngine, CT_Int, rowsData.Size() );
+		queryRows->CopyFrom( rowsData.GetPtr() );
+		CPtr<CDnnBlob> queryColumns = CDnnBlob::CreateVector( *mathEngine, CT_Int, max( columnsData.Size(), 1 ) );
+		CPtr<CDnnBlob> queryValues = CDnnBlob::CreateVector( *mathEngine, CT_Float, max( valuesData.Size(), 1 ) );
+		if( !valuesData.IsEmpty() ) {
+			mathEngine->DataExchangeTyped( queryColumns->GetData<int>(), columnsData.GetPtr(), columnsData.Size() );
+			mathEngine->DataExchangeTyped( queryValues->GetData(), valuesData.GetPtr(), valuesData.Size() );
+		}
+		const CSparseMatrixDesc desc( valuesData.Size(), queryRows->GetData<int>(),
+			queryColumns->GetData<int>(), queryValues->GetData() );
+		mathEngine->MultiplySparseMatrixByTransposedMatrix( count, width, vectorCount, desc,
+			values->GetData(), productBlock.GetData() );
+		mathEngine->DataExchangeTyped( products.GetPtr(), CConstFloatHandle( productBlock.GetData() ), products.Size() );
+	} else {
+		// The dense product
+		CArray<float> queryData;
+		queryData.Add( 0.f, count * width );
+		for( int i = 0; i < count; ++i ) {
+			fillSvmDenseRow( queries.GetRow( start + i ), width, queryData.GetPtr() + i * width );
+		}
+		mathEngine->DataExchangeTyped( queryBlock.GetData(), queryData.GetPtr(), queryData.Size() );
+		mathEngine->MultiplyMatrixByTransposedMatrix( queryBlock.GetData(), count, width, width,
+			values->GetData(), vectorCount, width, productBlock.GetData(), vectorCount, /*resultBufferSize*/0 );
+		mathEngine->DataExchangeTyped( products.GetPtr(), CConstFloatHandle( productBlock.GetData() ), products.Size() );
+	}
+
+	for( int i = 0; i < count; ++i ) {
+		const CFloatVectorDesc query = queries.GetRow( start + i );
+		const double queryNorm = DotProduct( query, query );
+		for( int j = 0; j < vectorCount; ++j ) {
+			result[i * vectorCount + j] = static_cast<float>(
+				kernel.CalculateByDotProduct( products[i * vectorCount + j], queryNorm, squaredNorms[j] ) );
+		}
+	}
+}
+
+} // namespace NeoML
@@ -0,0 +1,58 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <NeoML/NeoMLDefs.h>
+#include <NeoML/TraditionalML/SvmKernel.h>
+#include <NeoML/Dnn/DnnBlob.h>
+#include <memory>
+
+namespace NeoML {
+
+// Evaluates the SVM kernel of a block of queries against a fixed set of vectors
+// The dot products of all pairs are calculated by one matrix product of the math engine
+// and then turned into the kernel values elementwise (see CSvmKernel::CalculateByDotProduct)
+class CSvmBlockKernel {
+public:
+	CSvmBlockKernel( const CSvmKernel& kernel, const CFloatMatrixDesc& vectors );
+
+	// The number of the fixed vectors
+	int VectorCount() const { return squaredNorms.Size(); }
+
+	// Calculates the kernel values of every query against every fixed vector
+	// The result is the queries.Height x VectorCount() matrix
+	void Calculate( const CFloatMatrixDesc& queries, CArray<float>& result );
+
+private:
+	// The maximum number of elements in the buffers of one block of queries
+	static const int MaxBlockBufferSize = 1 << 20;
+
+	const CSvmKernel kernel;
+	const int width; // the number of features of the fixed vectors
+	std::unique_ptr<IMathEngine> mathEngine;
+	CArray<double> squaredNorms; // the squared norms of the fixed vectors
+	// The fixed vectors are stored in the dense form if they are filled enough, otherwise in the CSR form
+	bool isSparse;
+	int elementCount; // the number of elements in the CSR form
+	CPtr<CDnnBlob> values;
+	CPtr<CDnnBlob> columns;
+	CPtr<CDnnBlob> rows;
+
+	void calculateBlock( const CFloatMatrixDesc& queries, int start, int count,
+		CDnnBlob& queryBlock, CDnnBlob& productBlock, float* result );
+};
+
+} // namespace NeoML
@@ -92,6 +92,24 @@ double CSvmKernel::Calculate( const CFloatVectorDesc& x1, const CFloatVectorDesc
 	}
 }
 
+double CSvmKernel::CalculateByDotProduct( double dotProduct, double squaredNorm1, double squaredNorm2 ) const
+{
+	switch( kernelType ) {
+		case KT_Linear:
+			return dotProduct;
+		case KT_Poly:
+			return power( gamma * dotProduct + coef0, degree );
+		case KT_RBF:
+			// The rounding errors may make the squared distance slightly negative
+			return exp( -gamma * max( squaredNorm1 + squaredNorm2 - 2 * dotProduct, 0. ) );
+		case KT_Sigmoid:
+			return tanh( gamma * dotProduct + coef0 );
+		default:
+			NeoAssert( false );
+			return 0;
+	}
+}
+
 double CSvmKernel::rbfDenseBySparse( const CFloatVectorDesc& x1, const CFloatVectorDesc& x2 ) const
 {
 	double square = 0;
@@ -45,10 +45,13 @@ CArchive& operator<<( CArchive& archive, IUnigramEncoder::CSubword& token )
 void CUnigramEncoder::Decode( const CArray<int>& tokenIds, CArray<CString>& words ) const
 {
 	NeoAssert( IsInitialized() );
-	if( decoder == nullptr ) {
-		CMap<int, CString> idToTokenOut;
-		GetIdToTokenMapping( idToTokenOut );
-		decoder = std::make_unique<CSubwordDecoder>( params, std::move( idToTokenOut ) );
+	{
+		CCriticalSectionLock lock( decoderSection );
+		if( decoder == nullptr ) {
+			CMap<int, CString> idToTokenOut;
+			GetIdToTokenMapping( idToTokenOut );
+			decoder = std::make_unique<CSubwordDecoder>( params, std::move( idToTokenOut ) );
+		}
 	}
 	decoder->Decode( tokenIds, words );
 }
@@ -59,6 +59,7 @@ private:
 	CTrieNode<CSubword*> tokenTrie;
 	// Lazy-initialized mechanism for Decode() function
 	mutable std::unique_ptr<CSubwordDecoder> decoder = nullptr;
+	mutable CCriticalSection decoderSection;
 
 	int getTokenIndex( const CString& token ) const;
 };
@@ -19,6 +19,7 @@ limitations under the License.
 #include <UnigramTrainer.h>
 #include <Utf8Tools.h>
 #include <NeoML/TraditionalML/GraphGenerator.h>
+#include <NeoMathEngine/ThreadPool.h>
 
 namespace NeoML {
 // Start-of-Word token for the internal dictionary
@@ -87,7 +88,9 @@ struct CUnigramTrainer::CTokenLoss {
 
 //----------
 
-CUnigramTrainer::CUnigramTrainer( int vocabSize, TBorderHandling b, bool useByteBpe, int unknownTokenId ) :
+CUnigramTrainer::CUnigramTrainer( int vocabSize, TBorderHandling b, bool useByteBpe, int unknownTokenId,
+		int threadCount ) :
+	threadPool( CreateThreadPool( threadCount ) ),
 	desiredVocabSize( vocabSize )
 {
 	const bool addBow = b == TBorderHandling::BeginOfWord || b == TBorderHandling::BeginAndEndOfWord;
@@ -102,6 +105,11 @@ CUnigramTrainer::CUnigramTrainer( int vocabSize, TBorderHandling b, bool useByte
 	NeoAssert( vocabSize < initialVocabSize );
 }
 
+CUnigramTrainer::~CUnigramTrainer()
+{
+	delete threadPool;
+}
+
 CPtr<IUnigramEncoder> CUnigramTrainer::Train( const CWordDictionary& frequencyDict, const CWordDictionary& charVocab )
 {
 	candidatesTrie.DeleteAll();
@@ -304,6 +312,7 @@ bool CUnigramTrainer::trainStep()
 
 	CArray<CTokenLoss> losses;
 	dfsGetLosses( &candidatesTrie, losses );
+	calcLosses( losses );
 
 	using TLossSorter = CompositeComparer<CTokenLoss,
 		DescendingByMember<CTokenLoss, bool, &CTokenLoss::AlwaysKeep>,
@@ -325,9 +334,34 @@ bool CUnigramTrainer::trainStep()
 
 void CUnigramTrainer::runEmIteration()
 {
-	CMap<CString, double> probs;
-	for( int i = 0; i < trainDict.Size(); ++i ) {
-		calcProbsInWord( trainDict.GetWord( i ), trainDict.GetWordUseCount( i ), probs );
+	// E-step: each thread processes a contiguous part of the dictionary
+	// The statistics of the threads are summed up in the order of the parts
+	const int threadCount = threadPool->Size();
+	CArray<CMap<CString, double>> threadProbs;
+	threadProbs.SetSize( threadCount );
+	struct CTask {
+		const CUnigramTrainer& Trainer;
+		CArray<CMap<CString, double>>& Probs;
+	} task{ *this, threadProbs };
+	NEOML_NUM_THREADS( *threadPool, &task, []( int threadIndex, void* ptr ) {
+		CTask& task = *static_cast<CTask*>( ptr );
+		const CWordDictionary& trainDict = task.Trainer.trainDict;
+		int start = 0;
+		int count = 0;
+		if( GetTaskIndexAndCount( task.Probs.Size(), threadIndex, trainDict.Size(), start, count ) ) {
+			for( int i = start; i < start + count; ++i ) {
+				task.Trainer.calcProbsInWord( trainDict.GetWord( i ), trainDict.GetWordUseCount( i ),
+					task.Probs[threadIndex] );
+			}
+		}
+	} );
+
+	CMap<CString, double> probs( std::move( threadProbs[0] ) );
+	for( int t = 1; t < threadCount; ++t ) {
+		for( auto p = threadProbs[t].GetFirstPosition(); p != NotFound; p = threadProbs[t].GetNextPosition( p ) ) {
+			probs.GetOrCreateValue( threadProbs[t].GetKey( p ), 0.0 ) += threadProbs[t].GetValue( p );
+		}
+		threadProbs[t].DeleteAll();
 	}
 	double sum = 0.0;
 	for( auto p = probs.GetFirstPosition(); p != NotFound; p = probs.GetNextPosition( p ) ) {
@@ -408,7 +442,6 @@ void CUnigramTrainer::dfsGetLosses( const CTokenTrie* node, CArray<CTokenLoss>&
 	const auto* subword = node->Get();
 	if( subword != nullptr ) {
 		losses.Add( CTokenLoss( subword ) );
-		getTokenLoss( subword->Score, subword->Count, losses.Last() );
 	}
 
 	for( auto p = node->GetFirstChildPos(); p != NotFound; p = node->GetNextChildPos( p ) ) {
@@ -416,6 +449,27 @@ void CUnigramTrainer::dfsGetLosses( const CTokenTrie* node, CArray<CTokenLoss>&
 	}
 }
 
+// Calculates the losses of the collected tokens in parallel
+void CUnigramTrainer::calcLosses( CArray<CTokenLoss>& losses ) const
+{
+	struct CTask {
+		const CUnigramTrainer& Trainer;
+		CArray<CTokenLoss>& Losses;
+		int ThreadCount;
+	} task{ *this, losses, threadPool->Size() };
+	NEOML_NUM_THREADS( *threadPool, &task, []( int threadIndex, void* ptr ) {
+		CTask& task = *static_cast<CTask*>( ptr );
+		int start = 0;
+		int count = 0;
+		if( GetTaskIndexAndCount( task.ThreadCount, threadIndex, task.Losses.Size(), start, count ) ) {
+			for( int i = start; i < start + count; ++i ) {
+				CTokenLoss& loss = task.Losses[i];
+				task.Trainer.getTokenLoss( loss.Token->Score, loss.Token->Count, loss );
+			}
+		}
+	} );
+}
+
 // Calc penalty for deleting this token
 void CUnigramTrainer::getTokenLoss( double tokenScore, int64_t tokenCount, CTokenLoss& tokenLoss ) const
 {
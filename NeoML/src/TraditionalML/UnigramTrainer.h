@@ -19,9 +19,13 @@ limitations under the License.
 #include <UnigramEncoder.h>
 
 namespace NeoML {
+class IThreadPool;
+
 class CUnigramTrainer {
 public:
-	CUnigramTrainer( int vocabSize, CSubwordEncoderTrainer::TBorderHandling, bool useByteBpe, int unknownTokenId );
+	CUnigramTrainer( int vocabSize, CSubwordEncoderTrainer::TBorderHandling, bool useByteBpe, int unknownTokenId,
+		int threadCount );
+	~CUnigramTrainer();
 
 	// Trains and returns a fully trained encoder.
 	CPtr<IUnigramEncoder> Train( const CWordDictionary& frequencyDict, const CWordDictionary& charVocab );
@@ -58,6 +62,8 @@ private:
 	// Small number to prevent equal scores of forcibly added chars
 	static constexpr double scoreEps = 0.0001;
 
+	// the executors of the EM-algorithm and of the losses calculation
+	IThreadPool* const threadPool;
 	// train data
 	CWordDictionary trainDict;
 	// encoder parameters
@@ -78,6 +84,7 @@ private:
 	void calcProbsInWord( const CString& word, int64_t count, CMap<CString, double>& probs ) const;
 	void dfsUpdateTrieProbs( CTokenTrie* node, const CMap<CString, double>& probs );
 	void dfsGetLosses( const CTokenTrie* node, CArray<CTokenLoss>& losses ) const;
+	void calcLosses( CArray<CTokenLoss>& losses ) const;
 	void getTokenLoss( double tokenScore, int64_t tokenCount, CTokenLoss& tokenLoss ) const;
 	static void dfsTrieToArray( CTokenTrie* node, CArray<IUnigramEncoder::CSubword>& output );
 	void addChars( CArray<IUnigramEncoder::CSubword>& output ) const;
@@ -343,6 +343,187 @@ TEST_F( CBpeTest, SaveLoadDictionary )
 	}
 }
 
+// Straightforward BPE encoding: merges the pair of the adjacent tokens with the lowest id until there is none
+static void encodeBpeNaive( const CString& word, const ISubwordEncoder& encoder, const CString& eowToken,
+	CArray<int>& tokenIds )
+{
+	CMap<CString, int> tokenToId;
+	encoder.GetTokenToIdMapping( tokenToId );
+
+	CArray<CString> tokens;
+	for( int i = 0; i < word.Length(); ++i ) {
+		tokens.Add( CString( static_cast<const char*>( word ) + i, 1 ) );
+	}
+	if( encoder.UseEndOfWordToken() ) {
+		tokens.Add( eowToken );
+	}
+
+	while( true ) {
+		int bestId = INT_MAX;
+		int bestPos = NotFound;
+		for( int i = 0; i < tokens.Size() - 1; ++i ) {
+			int id = NotFound;
+			if( tokenToId.Lookup( tokens[i] + tokens[i + 1], id ) && id < bestId ) {
+				bestId = id;
+				bestPos = i;
+			}
+		}
+		if( bestPos == NotFound ) {
+			break;
+		}
+		tokens[bestPos] += tokens[bestPos + 1];
+		tokens.DeleteAt( bestPos + 1 );
+	}
+
+	tokenIds.DeleteAll();
+	for( int i = 0; i < tokens.Size(); ++i ) {
+		int id = encoder.UnknownTokenId();
+		tokenToId.Lookup( tokens[i], id );
+		tokenIds.Add( id );
+	}
+}
+
+TEST_F( CBpeTest, MergeOrder )
+{
+	CString trainText = "lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor"
+		" incididunt ut labore et dolore magna aliqua ut enim ad minim veniam quis nostrud exercitation ullamco laboris nisi ut aliquip ex"
+		" ea commodo consequat duis aute irure dolor in reprehenderit in voluptate velit esse cillum dolore eu fugiat nulla pariatur excepteur"
+		" sint occaecat cupidatat non proident sunt in culpa qui officia deserunt mollit anim id est laborum .";
+	CString testText = "mattis pellentesque id nibh tortor id aliquet . tincidunt ornare massa eget egestas purus ."
+		" orci phasellus egestas tellus rutrum tellus pellentesque eu tincidunt tortor . et malesuada fames ac turpis ."
+		" et netus et malesuada fames . quis ipsum suspendisse ultrices gravida dictum . dictumst quisque sagittis purus sit ."
+		" turpis tincidunt id aliquet risus feugiat in ante metus dictum . aaaaaaa lllllll zzz";
+	auto dictionary = fillDictionary( trainText, 100 );
+	CArray<CString> words;
+	splitString( testText, words );
+
+	CSubwordEncoderTrainer trainer( 150, TAlgorithm::BPE, TBorderHandling::None );
+	CPtr<ISubwordEncoder> tokenizer = trainer.Train( dictionary );
+	for( int i = 0; i < words.Size(); ++i ) {
+		CArray<int> tokenIds, tokenLengths;
+		tokenizer->Encode( words[i], tokenIds, tokenLengths );
+		CArray<int> expectedIds;
+		encodeBpeNaive( words[i], *tokenizer, CString(), expectedIds );
+		EXPECT_EQ( expectedIds, tokenIds ) << words[i];
+	}
+
+	// Tokens which may be merged in several ways
+	CPtr<IBytePairEncoder> tokenizerEow = CheckCast<IBytePairEncoder>( CreateModel( BytePairEncoderModelName ) );
+	IBytePairEncoder::CBPEDictionary dictionaryEow = { "a", "b", "@", "ab", "ba", "aa", "ab@", "bab", "aab@", "baa" };
+	ISubwordEncoder::CParams params;
+	params.EndOfWordToken = "@";
+	tokenizerEow->Initialize( dictionaryEow, params );
+	for( const char* word : { "abab", "baab", "aaaab", "bbbaaa", "ababab", "bacab" } ) {
+		CArray<int> tokenIds, tokenLengths;
+		tokenizerEow->Encode( word, tokenIds, tokenLengths );
+		CArray<int> expectedIds;
+		encodeBpeNaive( word, *tokenizerEow, params.EndOfWordToken, expectedIds );
+		EXPECT_EQ( expectedIds, tokenIds ) << word;
+	}
+}
+
+TEST_F( CBpeTest, EncodeBatch )
+{
+	CString trainText = "lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor"
+		" incididunt ut labore et dolore magna aliqua ut enim ad minim veniam quis nostrud exercitation ullamco laboris nisi ut aliquip ex"
+		" ea commodo consequat duis aute irure dolor in reprehenderit in voluptate velit esse cillum dolore eu fugiat nulla pariatur excepteur"
+		" sint occaecat cupidatat non proident sunt in culpa qui officia deserunt mollit anim id est laborum .";
+	auto dictionary = fillDictionary( trainText, 100 );
+	CArray<CString> text;
+	splitString( trainText, text );
+	// Many repeated words
+	CArray<CString> words;
+	for( int i = 0; i < 5; ++i ) {
+		words.Add( text );
+	}
+
+	for( TAlgorithm algorithm : { TAlgorithm::BPE, TAlgorithm::Unigram } ) {
+		CSubwordEncoderTrainer trainer( 100, algorithm, TBorderHandling::EndOfWord );
+		CPtr<ISubwordEncoder> tokenizer = trainer.Train( dictionary );
+		ISubwordEncoderWithCache* cachedTokenizer = dynamic_cast<ISubwordEncoderWithCache*>( tokenizer.Ptr() );
+		ASSERT_TRUE( cachedTokenizer != nullptr );
+
+		CArray<CArray<int>> expectedIds;
+		CArray<CArray<int>> expectedLengths;
+		cachedTokenizer->SetCachePeriod( -1 );
+		for( int i = 0; i < words.Size(); ++i ) {
+			tokenizer->Encode( words[i], expectedIds.Append(), expectedLengths.Append() );
+		}
+
+		for( int cachePeriod : { 50000, 16 } ) {
+			cachedTokenizer->SetCachePeriod( cachePeriod );
+			cachedTokenizer->ClearCache();
+
+			CArray<CArray<int>> tokenIds;
+			CArray<CArray<int>> tokenLengths;
+			cachedTokenizer->EncodeBatch( words, tokenIds, tokenLengths, 4 );
+			ASSERT_EQ( words.Size(), tokenIds.Size() );
+			ASSERT_EQ( words.Size(), tokenLengths.Size() );
+			for( int i = 0; i < words.Size(); ++i ) {
+				EXPECT_EQ( expectedIds[i], tokenIds[i] );
+				EXPECT_EQ( expectedLengths[i], tokenLengths[i] );
+			}
+
+			CPtrOwner<IThreadPool> threadPool( CreateThreadPool( 4 ) );
+			cachedTokenizer->EncodeBatch( words, tokenIds, tokenLengths, *threadPool );
+			ASSERT_EQ( words.Size(), tokenIds.Size() );
+			for( int i = 0; i < words.Size(); ++i ) {
+				EXPECT_EQ( expectedIds[i], tokenIds[i] );
+			}
+
+			// The small batch is encoded in the calling thread
+			cachedTokenizer->EncodeBatch( text, tokenIds, tokenLengths, 4 );
+			ASSERT_EQ( text.Size(), tokenIds.Size() );
+			for( int i = 0; i < text.Size(); ++i ) {
+				EXPECT_EQ( expectedIds[i], tokenIds[i] );
+			}
+			cachedTokenizer->ClearCache();
+			cachedTokenizer->EncodeBatch( words, tokenIds, tokenLengths, 4 );
+
+			const ISubwordEncoderWithCache::CCacheStatistics statistics = cachedTokenizer->GetCacheStatistics();
+			EXPECT_EQ( words.Size(), statistics.Hits + statistics.Misses );
+			EXPECT_LE( statistics.Size, cachePeriod + 16 );
+			if( cachePeriod > words.Size() ) {
+				EXPECT_GT( statistics.Hits, 0 );
+			}
+		}
+	}
+}
+
+TEST_F( CBpeTest, UnigramMultithreaded )
+{
+	CString trainText = "lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor"
+		" incididunt ut labore et dolore magna aliqua ut enim ad minim veniam quis nostrud exercitation ullamco laboris nisi ut aliquip ex"
+		" ea commodo consequat duis aute irure dolor in reprehenderit in voluptate velit esse cillum dolore eu fugiat nulla pariatur excepteur"
+		" sint occaecat cupidatat non proident sunt in culpa qui officia deserunt mollit anim id est laborum .";
+	auto dictionary = fillDictionary( trainText, 100 );
+	CArray<CString> words;
+	splitString( trainText, words );
+
+	CArray<IUnigramEncoder::CUnigramDictionary> vocabs;
+	for( int run = 0; run < 2; ++run ) {
+		CSubwordEncoderTrainer trainer( 80, TAlgorithm::Unigram, TBorderHandling::BeginAndEndOfWord );
+		trainer.SetThreadCount( 4 );
+		CPtr<IUnigramEncoder> tokenizer = CheckCast<IUnigramEncoder>( trainer.Train( dictionary ) );
+		tokenizer->GetDictionary( vocabs.Append() );
+
+		CArray<int> tokenIds, tokenLengths;
+		for( int i = 0; i < words.Size(); ++i ) {
+			tokenizer->Encode( words[i], tokenIds, tokenLengths );
+		}
+		CArray<CString> decoded;
+		tokenizer->Decode( tokenIds, decoded );
+		EXPECT_EQ( words, decoded );
+	}
+
+	// The result is the same for the same number of threads
+	ASSERT_EQ( vocabs[0].Size(), vocabs[1].Size() );
+	for( int i = 0; i < vocabs[0].Size(); ++i ) {
+		EXPECT_EQ( vocabs[0][i].Text, vocabs[1][i].Text );
+		EXPECT_EQ( vocabs[0][i].Score, vocabs[1][i].Score );
+	}
+}
+
 TEST_F( CBpeTest, RawBytes )
 {
 	CSubwordEncoderTrainer trainer( 100500, TAlgorithm::BPE, TBorderHandling::None, TVocabPruning::ByteBPE );
@@ -304,6 +304,152 @@ TEST_F( RandomBinaryClassification4000x20, Linear )
 	TestBinaryClassificationResult();
 }
 
+// Reads the matrix with the answers and the weights by chunks of the given size
+class CTestProblemChunkSource : public IProblemChunkSource {
+public:
+	CTestProblemChunkSource( const CFloatMatrixDesc& _matrix, int _chunkSize ) :
+		matrix( _matrix ), chunkSize( _chunkSize ), position( 0 ) {}
+
+	CArray<float> Answers;
+	CArray<float> Weights;
+
+	int GetFeatureCount() const override { return matrix.Width; }
+	void Reset() override { position = 0; }
+	bool GetNextChunk( CFloatMatrixDesc& chunk, const float*& answers, const float*& weights ) override
+	{
+		if( position >= matrix.Height ) {
+			return false;
+		}
+		chunk = matrix;
+		chunk.Height = min( chunkSize, matrix.Height - position );
+		chunk.PointerB = matrix.PointerB + position;
+		chunk.PointerE = matrix.PointerE + position;
+		answers = Answers.GetPtr() + position;
+		weights = Weights.IsEmpty() ? nullptr : Weights.GetPtr() + position;
+		position += chunk.Height;
+		return true;
+	}
+
+private:
+	const CFloatMatrixDesc matrix;
+	const int chunkSize;
+	int position;
+};
+
+TEST_F( RandomBinaryClassification4000x20, LinearStochastic )
+{
+	for( TLinearSolver solver : { LS_Sgd, LS_AdaGrad, LS_Ftrl } ) {
+		CLinear::CParams params( EF_LogReg );
+		params.Solver = solver;
+		params.BatchSize = 256;
+		CLinear linear( params );
+		TrainBinary( linear );
+		TestBinaryClassificationResult();
+	}
+}
+
+TEST( LinearTest, StochasticSolvers )
+{
+	const int vectorCount = 5000;
+	const int testVectorCount = 1000;
+	const int featureCount = 100;
+	const int nonZeroCount = 10;
+	CRandom random( 0x5e6f );
+	CFloatVector plane( featureCount );
+	for( int j = 0; j < featureCount; ++j ) {
+		plane.SetAt( j, static_cast<float>( random.Uniform( -1, 1 ) ) );
+	}
+	CPtr<CMemoryProblem> problem = new CMemoryProblem( featureCount, 2 );
+	CPtr<CMemoryProblem> testProblem = new CMemoryProblem( featureCount, 2 );
+	for( int i = 0; i < vectorCount + testVectorCount; ++i ) {
+		CSparseFloatVector vector;
+		for( int j = 0; j < nonZeroCount; ++j ) {
+			vector.SetAt( random.UniformInt( 0, featureCount - 1 ), static_cast<float>( random.Uniform( -1, 1 ) ) );
+		}
+		const int label = DotProduct( plane, vector.GetDesc() ) > 0 ? 1 : 0;
+		( i < vectorCount ? problem : testProblem )->Add( vector, label );
+	}
+
+	for( TLinearSolver solver : { LS_Sgd, LS_AdaGrad, LS_Ftrl } ) {
+		for( float l1Coeff : { 0.f, 0.01f } ) {
+			for( int threadCount : { 1, 4 } ) {
+				CLinear::CParams params( EF_LogReg, /*errorWeight*/10. );
+				params.Solver = solver;
+				params.L1Coeff = l1Coeff;
+				params.ThreadCount = threadCount;
+				params.BatchSize = 128;
+				CPtr<IModel> model = CLinear( params ).Train( *problem );
+				ASSERT_TRUE( model != nullptr );
+
+				int correct = 0;
+				for( int i = 0; i < testVectorCount; ++i ) {
+					CClassificationResult result;
+					ASSERT_TRUE( model->Classify( testProblem->GetVector( i ), result ) );
+					if( result.PreferredClass == testProblem->GetClass( i ) ) {
+						++correct;
+					}
+				}
+				GTEST_LOG_( INFO ) << "Solver " << solver << ", L1 " << l1Coeff << ", threads " << threadCount
+					<< ": accuracy " << correct / static_cast<double>( testVectorCount );
+				EXPECT_GT( correct, 0.9 * testVectorCount );
+			}
+		}
+	}
+}
+
+TEST( LinearTest, StochasticSolversByChunks )
+{
+	const int vectorCount = 5000;
+	const int testVectorCount = 1000;
+	const int featureCount = 100;
+	const int nonZeroCount = 10;
+	CRandom random( 0x7a8b );
+	CFloatVector plane( featureCount );
+	for( int j = 0; j < featureCount; ++j ) {
+		plane.SetAt( j, static_cast<float>( random.Uniform( -1, 1 ) ) );
+	}
+	CSparseFloatMatrix matrix( featureCount );
+	CSparseFloatMatrix testMatrix( featureCount );
+	CArray<float> answers;
+	CArray<float> testAnswers;
+	for( int i = 0; i < vectorCount + testVectorCount; ++i ) {
+		CSparseFloatVector vector;
+		for( int j = 0; j < nonZeroCount; ++j ) {
+			vector.SetAt( random.UniformInt( 0, featureCount - 1 ), static_cast<float>( random.Uniform( -1, 1 ) ) );
+		}
+		const float answer = DotProduct( plane, vector.GetDesc() ) > 0 ? 1.f : -1.f;
+		( i < vectorCount ? matrix : testMatrix ).AddRow( vector );
+		( i < vectorCount ? answers : testAnswers ).Add( answer );
+	}
+
+	for( TLinearSolver solver : { LS_Sgd, LS_AdaGrad, LS_Ftrl } ) {
+		for( float l1Coeff : { 0.f, 0.01f } ) {
+			CTestProblemChunkSource source( matrix.GetDesc(), /*chunkSize*/700 );
+			answers.CopyTo( source.Answers );
+			CLinear::CParams params( EF_LogReg, /*errorWeight*/10. );
+			params.Solver = solver;
+			params.L1Coeff = l1Coeff;
+			params.ThreadCount = 4;
+			params.BatchSize = 128;
+			CPtr<ILinearBinaryModel> model = CLinear( params ).TrainByChunks( source );
+			ASSERT_TRUE( model != nullptr );
+
+			int correct = 0;
+			for( int i = 0; i < testVectorCount; ++i ) {
+				CClassificationResult result;
+				ASSERT_TRUE( model->Classify( testMatrix.GetRow( i ), result ) );
+				ASSERT_TRUE( std::isfinite( result.Probabilities[1].GetValue() ) );
+				if( ( result.PreferredClass == 1 ) == ( testAnswers[i] > 0 ) ) {
+					++correct;
+				}
+			}
+			GTEST_LOG_( INFO ) << "Solver " << solver << ", L1 " << l1Coeff
+				<< ": accuracy " << correct / static_cast<double>( testVectorCount );
+			EXPECT_GT( correct, 0.9 * testVectorCount );
+		}
+	}
+}
+
 TEST_F( RandomBinaryClassification4000x20, SvmLinear )
 {
 	CSvm::CParams params( CSvmKernel::KT_Linear );
@@ -320,6 +466,121 @@ TEST_F( RandomBinaryClassification4000x20, SvmRbf )
 	TestBinaryClassificationResult();
 }
 
+TEST( SvmBinaryModelTest, ClassifyBatch )
+{
+	const int vectorCount = 1000;
+	const int featureCount = 40;
+	CRandom random( 0x1f2e );
+	// The dense training set makes the support vectors stored densely, the sparse one in the CSR form
+	for( int nonZeroCount : { featureCount, 4 } ) {
+		CPtr<CMemoryProblem> problem = new CMemoryProblem( featureCount, 2 );
+		CArray<float> denseValues;
+		denseValues.Add( 0.f, vectorCount * featureCount );
+		CArray<int> densePointers;
+		for( int i = 0; i < vectorCount; ++i ) {
+			CSparseFloatVector vector;
+			for( int j = 0; j < nonZeroCount; ++j ) {
+				const int index = nonZeroCount == featureCount ? j : random.UniformInt( 0, featureCount - 1 );
+				vector.SetAt( index, static_cast<float>( random.Uniform( -1, 1 ) ) );
+			}
+			for( int j = 0; j < vector.NumberOfElements(); ++j ) {
+				denseValues[i * featureCount + vector.GetDesc().Indexes[j]] = vector.GetDesc().Values[j];
+			}
+			densePointers.Add( i * featureCount );
+			problem->Add( vector, DotProduct( vector, vector ) > 0.1 * nonZeroCount ? 1 : 0 );
+		}
+		densePointers.Add( vectorCount * featureCount );
+
+		CFloatMatrixDesc dense;
+		dense.Height = vectorCount;
+		dense.Width = featureCount;
+		dense.Values = denseValues.GetPtr();
+		dense.PointerB = densePointers.GetPtr();
+		dense.PointerE = densePointers.GetPtr() + 1;
+
+		CPtr<ISvmBinaryModel> previousModel;
+		for( CSvmKernel::TKernelType kernelType : { CSvmKernel::KT_Poly, CSvmKernel::KT_RBF, CSvmKernel::KT_Sigmoid } ) {
+			CSvm::CParams params( kernelType, 1., 10000, /*degree*/2, /*gamma*/0.1 );
+			CPtr<ISvmBinaryModel> model = CheckCast<ISvmBinaryModel>( CSvm( params ).Train( *problem ) );
+
+			// The kernel columns calculated in parallel give the same model
+			params.ThreadCount = 4;
+			CPtr<ISvmBinaryModel> parallelModel = CheckCast<ISvmBinaryModel>( CSvm( params ).Train( *problem ) );
+			ASSERT_EQ( model->GetAlphas().Size(), parallelModel->GetAlphas().Size() );
+			for( int i = 0; i < model->GetAlphas().Size(); ++i ) {
+				EXPECT_EQ( model->GetAlphas()[i], parallelModel->GetAlphas()[i] );
+			}
+			EXPECT_EQ( model->GetFreeTerm(), parallelModel->GetFreeTerm() );
+
+			CArray<CClassificationResult> denseResults;
+			model->ClassifyBatch( dense, denseResults );
+			CArray<CClassificationResult> sparseResults;
+			model->ClassifyBatch( problem->GetMatrix(), sparseResults );
+			ASSERT_EQ( vectorCount, denseResults.Size() );
+			ASSERT_EQ( vectorCount, sparseResults.Size() );
+			for( int i = 0; i < vectorCount; ++i ) {
+				CClassificationResult expected;
+				ASSERT_TRUE( model->Classify( problem->GetVector( i ), expected ) );
+				EXPECT_NEAR( expected.Probabilities[0].GetValue(), denseResults[i].Probabilities[0].GetValue(), 1e-4 );
+				EXPECT_NEAR( expected.Probabilities[0].GetValue(), sparseResults[i].Probabilities[0].GetValue(), 1e-4 );
+			}
+			// The kernel cached by the second call is the same
+			CArray<CClassificationResult> secondResults;
+			model->ClassifyBatch( dense, secondResults );
+			for( int i = 0; i < vectorCount; ++i ) {
+				EXPECT_EQ( denseResults[i].Probabilities[0].GetValue(), secondResults[i].Probabilities[0].GetValue() );
+			}
+
+			// The kernel cached by the previous model is rebuilt when another model is loaded in its place
+			if( previousModel != nullptr ) {
+				CMemoryFile file;
+				{
+					CArchive archive( &file, CArchive::store );
+					model->Serialize( archive );
+				}
+				file.Seek( 0, CBaseFile::begin );
+				{
+					CArchive archive( &file, CArchive::load );
+					previousModel->Serialize( archive );
+				}
+				CArray<CClassificationResult> loadedResults;
+				previousModel->ClassifyBatch( dense, loadedResults );
+				for( int i = 0; i < vectorCount; ++i ) {
+					EXPECT_NEAR( denseResults[i].Probabilities[0].GetValue(),
+						loadedResults[i].Probabilities[0].GetValue(), 1e-6 );
+				}
+			}
+			previousModel = model;
+		}
+	}
+}
+
+TEST( SvmTest, MultithreadedTraining )
+{
+	// The training set is large enough for the gradient updates to run in parallel
+	const int vectorCount = 10000;
+	CRandom random( 0x3c4d );
+	CPtr<CMemoryProblem> problem = new CMemoryProblem( 2, 2 );
+	for( int i = 0; i < vectorCount; ++i ) {
+		CFloatVector vector( 2 );
+		vector.SetAt( 0, static_cast<float>( random.Uniform( -1, 1 ) ) );
+		vector.SetAt( 1, static_cast<float>( random.Uniform( -1, 1 ) ) );
+		problem->Add( vector.GetDesc(), vector[0] * vector[0] + vector[1] * vector[1] < 0.5 ? 1 : 0 );
+	}
+
+	CSvm::CParams params( CSvmKernel::KT_RBF );
+	CPtr<ISvmBinaryModel> model = CheckCast<ISvmBinaryModel>( CSvm( params ).Train( *problem ) );
+	params.ThreadCount = 4;
+	CPtr<ISvmBinaryModel> parallelModel = CheckCast<ISvmBinaryModel>( CSvm( params ).Train( *problem ) );
+
+	// The parts are merged in order so the working set selection and the model are the same
+	ASSERT_EQ( model->GetAlphas().Size(), parallelModel->GetAlphas().Size() );
+	for( int i = 0; i < model->GetAlphas().Size(); ++i ) {
+		EXPECT_EQ( model->GetAlphas()[i], parallelModel->GetAlphas()[i] );
+	}
+	EXPECT_EQ( model->GetFreeTerm(), parallelModel->GetFreeTerm() );
+}
+
 TEST_F( RandomBinaryClassification4000x20, DecisionTree )
 {
 	CDecisionTree::CParams param;
@@ -328,6 +589,22 @@ TEST_F( RandomBinaryClassification4000x20, DecisionTree )
 	TestBinaryClassificationResult();
 }
 
+TEST_F( RandomBinaryClassification4000x20, DecisionTreeMultithreaded )
+{
+	CDecisionTree::CParams param;
+	CDecisionTree decisionTree( param );
+	TrainBinary( decisionTree );
+
+	GTEST_LOG_( INFO ) << "Train in several threads and compare";
+	param.ThreadCount = 4;
+	CDecisionTree decisionTreeMt( param );
+	CPtr<IModel> modelMtDense;
+	CPtr<IModel> modelMtSparse;
+	Train( decisionTreeMt, *DenseRandomBinaryProblem, *SparseRandomBinaryProblem, modelMtDense, modelMtSparse );
+	TestClassificationResult( ModelDense, modelMtDense, DenseBinaryTestData, SparseBinaryTestData );
+	TestClassificationResult( ModelSparse, modelMtSparse, DenseBinaryTestData, SparseBinaryTestData );
+}
+
 TEST_F( RandomMultiClassification2000x20, GBTB_Full )
 {
 	CRandom random( 0 );
@@ -512,6 +789,25 @@ TEST_F( RandomMultiClassification2000x20, OneVsOneDecisionTree )
 	TestClassificationResult( ModelSparse, modelImplicitSparse, DenseMultiTestData, SparseMultiTestData );
 }
 
+TEST_F( RandomMultiClassification2000x20, DecisionTreeMultithreaded )
+{
+	for( TMulticlassMode mode : { MM_SingleClassifier, MM_OneVsAll, MM_OneVsOne } ) {
+		CDecisionTree::CParams param;
+		param.MulticlassMode = mode;
+		CDecisionTree decisionTree( param );
+		TrainMulti( decisionTree );
+
+		GTEST_LOG_( INFO ) << "Train in several threads and compare, mode " << mode;
+		param.ThreadCount = 4;
+		CDecisionTree decisionTreeMt( param );
+		CPtr<IModel> modelMtDense;
+		CPtr<IModel> modelMtSparse;
+		Train( decisionTreeMt, *DenseRandomMultiProblem, *SparseRandomMultiProblem, modelMtDense, modelMtSparse );
+		TestClassificationResult( ModelDense, modelMtDense, DenseMultiTestData, SparseMultiTestData );
+		TestClassificationResult( ModelSparse, modelMtSparse, DenseMultiTestData, SparseMultiTestData );
+	}
+}
+
 TEST_F( RandomBinaryClassification4000x20, CrossValidationLinear )
 {
 	CLinear linear( EF_SquaredHinge );
@@ -537,6 +833,50 @@ TEST_F( RandomBinaryClassification4000x20, CrossValidationDecisionTree )
 	CrossValidate( 10, decisionTree, DenseRandomBinaryProblem, SparseRandomBinaryProblem );
 }
 
+namespace NeoMLTest {
+
+// Creates the decision trees with the given number of threads
+class CDecisionTreeFactory : public ITrainingModelFactory {
+public:
+	explicit CDecisionTreeFactory( const CDecisionTree::CParams& _params ) : params( _params ) {}
+
+	ITrainingModel* CreateTrainingModel( int threadCount ) override
+	{ return new CDecisionTree( CDecisionTree::CParams( params, threadCount ) ); }
+
+private:
+	const CDecisionTree::CParams params;
+};
+
+} // namespace NeoMLTest
+
+TEST_F( RandomBinaryClassification4000x20, CrossValidationParallel )
+{
+	CDecisionTree::CParams param;
+	CDecisionTree decisionTree( param );
+	CDecisionTreeFactory factory( param );
+
+	for( bool stratified : { false, true } ) {
+		CCrossValidation crossValidation( decisionTree, DenseRandomBinaryProblem );
+		CCrossValidationResult expected;
+		crossValidation.Execute( 10, AccuracyScore, expected, stratified );
+
+		CCrossValidation parallelCrossValidation( factory, DenseRandomBinaryProblem, 4, 2 );
+		CCrossValidationResult result;
+		parallelCrossValidation.Execute( 10, AccuracyScore, result, stratified );
+
+		ASSERT_EQ( expected.Models.Size(), result.Models.Size() );
+		ASSERT_EQ( expected.Success.Size(), result.Success.Size() );
+		for( int i = 0; i < expected.Success.Size(); ++i ) {
+			EXPECT_EQ( expected.Success[i], result.Success[i] );
+		}
+		ASSERT_EQ( expected.Results.Size(), result.Results.Size() );
+		for( int i = 0; i < expected.Results.Size(); ++i ) {
+			EXPECT_EQ( expected.Results[i].PreferredClass, result.Results[i].PreferredClass );
+			EXPECT_EQ( expected.ModelIndex[i], result.ModelIndex[i] );
+		}
+	}
+}
+
 // Test regression
 TEST_F( RandomBinaryRegression4000x20, Linear )
 {
@@ -571,6 +911,69 @@ TEST_F( RandomBinaryRegression4000x20, Linear )
 	}
 }
 
+// The mean squared error of the model on the problem
+static double calcMeanSquaredError( const IRegressionModel& model, const CRegressionRandomProblem& problem )
+{
+	double error = 0;
+	for( int i = 0; i < problem.GetVectorCount(); i++ ) {
+		const double diff = model.Predict( problem.GetVector( i ) ) - problem.GetValue( i );
+		error += diff * diff;
+	}
+	return error / problem.GetVectorCount();
+}
+
+TEST_F( RandomBinaryRegression4000x20, LinearStochastic )
+{
+	CRandom rand( 0 );
+	auto denseRandomBinaryProblem = CRegressionRandomProblem::Random( rand, 4000, 20, 2 );
+	auto denseBinaryTestData = CRegressionRandomProblem::Random( rand, 1000, 20, 2 );
+	auto sparseRandomBinaryProblem = denseRandomBinaryProblem->CreateSparse();
+	auto sparseBinaryTestData = denseBinaryTestData->CreateSparse();
+
+	// The stochastic methods optimize the same function, so their error should be close to the Newton method one
+	auto newtonModel = CLinear( CLinear::CParams( EF_L2_Regression ) ).TrainRegression( *denseRandomBinaryProblem );
+	const double newtonTrainError = calcMeanSquaredError( *newtonModel, *denseRandomBinaryProblem );
+	const double newtonTestError = calcMeanSquaredError( *newtonModel, *denseBinaryTestData );
+
+	for( TLinearSolver solver : { LS_Sgd, LS_AdaGrad, LS_Ftrl } ) {
+		CLinear::CParams params( EF_L2_Regression );
+		params.Solver = solver;
+		CLinear linear( params );
+
+		auto model = linear.TrainRegression( *denseRandomBinaryProblem );
+		ASSERT_TRUE( model != nullptr );
+		auto model2 = linear.TrainRegression( *sparseRandomBinaryProblem );
+		ASSERT_TRUE( model2 != nullptr );
+
+		for( int i = 0; i < sparseBinaryTestData->GetVectorCount(); i++ ) {
+			double result1 = model->Predict( denseBinaryTestData->GetVector( i ) );
+			double result2 = model->Predict( sparseBinaryTestData->GetVector( i ) );
+			double result3 = model2->Predict( sparseBinaryTestData->GetVector( i ) );
+			ASSERT_TRUE( std::isfinite( result1 ) );
+			ASSERT_DOUBLE_EQ( result1, result2 );
+			ASSERT_DOUBLE_EQ( result1, result3 );
+		}
+
+		// The same training set read by chunks
+		CTestProblemChunkSource source( sparseRandomBinaryProblem->GetMatrix(), /*chunkSize*/1000 );
+		for( int i = 0; i < sparseRandomBinaryProblem->GetVectorCount(); i++ ) {
+			source.Answers.Add( static_cast<float>( sparseRandomBinaryProblem->GetValue( i ) ) );
+			source.Weights.Add( static_cast<float>( sparseRandomBinaryProblem->GetVectorWeight( i ) ) );
+		}
+		CPtr<ILinearRegressionModel> chunkModel = linear.TrainRegressionByChunks( source );
+		ASSERT_TRUE( chunkModel != nullptr );
+
+		const double trainError = calcMeanSquaredError( *model, *denseRandomBinaryProblem );
+		const double testError = calcMeanSquaredError( *model, *denseBinaryTestData );
+		const double chunkTestError = calcMeanSquaredError( *chunkModel, *denseBinaryTestData );
+		GTEST_LOG_( INFO ) << "Solver " << solver << ": train error " << trainError << " (" << newtonTrainError
+			<< "), test error " << testError << " (" << newtonTestError << "), by chunks " << chunkTestError;
+		EXPECT_LT( trainError, 1.2 * newtonTrainError );
+		EXPECT_LT( testError, 1.2 * newtonTestError );
+		EXPECT_LT( chunkTestError, 1.2 * newtonTestError );
+	}
+}
+
 // GB binary tree builders
 TEST_F( RandomBinaryGBRegression4000x20, Full )
 {
@@ -713,3 +1116,115 @@ TEST( FunctionSetArgumentTest, InitialGradient )
 	testImpl( CLogRegression( *classProblem, 1, 0.001f, 16 ) );
 	testImpl( CSmoothedHinge( *classProblem, 1, 0.001f, 16 ) );
 }
+
+TEST( CalibrationTest, PlattScaling )
+{
+	const int count = 5000;
+	CRandom rand( 17 );
+	CArray<float> scores;
+	CArray<int> labels;
+	CArray<float> weights;
+	CArray<double> output;
+	CPtr<CMemoryProblem> problem = new CMemoryProblem( 1, 2 );
+	for( int i = 0; i < count; ++i ) {
+		labels.Add( rand.UniformInt( 0, 1 ) );
+		scores.Add( static_cast<float>( rand.Normal( labels.Last() == 1 ? 0.7 : -0.5, 1. ) ) );
+		weights.Add( static_cast<float>( rand.Uniform( 0.5, 2. ) ) );
+		output.Add( scores.Last() );
+		CSparseFloatVector vector;
+		vector.SetAt( 0, scores.Last() );
+		problem->Add( vector, weights.Last(), labels.Last() );
+	}
+
+	CSigmoid expected;
+	CalcSigmoidCoefficients( *problem, output, expected );
+	ASSERT_TRUE( expected.IsValid() );
+
+	for( int threadCount = 1; threadCount <= 4; threadCount += 3 ) {
+		CSigmoid actual;
+		CalcSigmoidCoefficients( scores.GetPtr(), labels.GetPtr(), weights.GetPtr(), count, actual, threadCount );
+		EXPECT_NEAR( expected.A, actual.A, 1e-6 );
+		EXPECT_NEAR( expected.B, actual.B, 1e-6 );
+	}
+
+	// The blobs with the float labels, all weights are 1
+	CPtr<CDnnBlob> scoresBlob = CDnnBlob::CreateVector( MathEngine(), CT_Float, count );
+	scoresBlob->CopyFrom( scores.GetPtr() );
+	CPtr<CDnnBlob> labelsBlob = CDnnBlob::CreateVector( MathEngine(), CT_Float, count );
+	CArray<float> floatLabels;
+	for( int i = 0; i < count; ++i ) {
+		floatLabels.Add( static_cast<float>( labels[i] ) );
+	}
+	labelsBlob->CopyFrom( floatLabels.GetPtr() );
+	CSigmoid unweighted;
+	CalcSigmoidCoefficients( scores.GetPtr(), labels.GetPtr(), nullptr, count, unweighted );
+	CSigmoid fromBlobs;
+	CalcSigmoidCoefficients( *scoresBlob, *labelsBlob, fromBlobs, 4 );
+	EXPECT_NEAR( unweighted.A, fromBlobs.A, 1e-6 );
+	EXPECT_NEAR( unweighted.B, fromBlobs.B, 1e-6 );
+
+	CArray<float> probabilities;
+	probabilities.SetSize( count );
+	CalcSigmoidProbabilities( expected, scores.GetPtr(), probabilities.GetPtr(), count );
+	for( int i = 0; i < count; ++i ) {
+		ASSERT_NEAR( expected.DistanceToProbability( scores[i] ), probabilities[i], 1e-6 );
+	}
+}
+
+TEST( CalibrationTest, IsotonicRegression )
+{
+	// The second and the third points violate the order and are pooled
+	const float scores[] = { 4.f, 1.f, 3.f, 2.f };
+	const int labels[] = { 1, 0, 0, 1 };
+	CIsotonicCalibration calibration;
+	calibration.Train( scores, labels, nullptr, 4 );
+	ASSERT_EQ( 4, calibration.GetThresholds().Size() );
+	EXPECT_EQ( 0., calibration.GetProbability( 0. ) );
+	EXPECT_EQ( 0.25, calibration.GetProbability( 1.5 ) );
+	EXPECT_EQ( 0.5, calibration.GetProbability( 2.5 ) );
+	EXPECT_EQ( 0.75, calibration.GetProbability( 3.5 ) );
+	EXPECT_EQ( 1., calibration.GetProbability( 10. ) );
+
+	// The result is non-decreasing and close to the true probabilities
+	const int count = 20000;
+	CRandom rand( 3 );
+	CArray<float> randomScores;
+	CArray<int> randomLabels;
+	CArray<float> weights;
+	for( int i = 0; i < count; ++i ) {
+		randomScores.Add( static_cast<float>( rand.Uniform( -3, 3 ) ) );
+		const double probability = 1 / ( 1 + exp( -2 * randomScores.Last() ) );
+		randomLabels.Add( rand.Uniform( 0, 1 ) < probability ? 1 : 0 );
+		weights.Add( static_cast<float>( rand.Uniform( 0.5, 1.5 ) ) );
+	}
+	calibration.Train( randomScores.GetPtr(), randomLabels.GetPtr(), weights.GetPtr(), count );
+	const CArray<float>& values = calibration.GetValues();
+	for( int i = 1; i < values.Size(); ++i ) {
+		ASSERT_LE( values[i - 1], values[i] );
+		ASSERT_LE( calibration.GetThresholds()[i - 1], calibration.GetThresholds()[i] );
+	}
+	for( double score = -2.5; score < 2.5; score += 0.5 ) {
+		EXPECT_NEAR( 1 / ( 1 + exp( -2 * score ) ), calibration.GetProbability( score ), 0.1 );
+	}
+
+	CMemoryFile file;
+	{
+		CArchive archive( &file, CArchive::store );
+		archive << calibration;
+	}
+	file.Seek( 0, CBaseFile::begin );
+	CIsotonicCalibration loaded;
+	{
+		CArchive archive( &file, CArchive::load );
+		archive >> loaded;
+	}
+	CArray<float> expected;
+	expected.SetSize( count );
+	calibration.GetProbabilities( randomScores.GetPtr(), expected.GetPtr(), count );
+	CArray<float> actual;
+	actual.SetSize( count );
+	loaded.GetProbabilities( randomScores.GetPtr(), actual.GetPtr(), count );
+	for( int i = 0; i < count; ++i ) {
+		ASSERT_EQ( expected[i], actual[i] );
+	}
+}
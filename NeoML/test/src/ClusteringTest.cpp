@@ -200,6 +200,34 @@ static void hierarchicalClustering( const IClusteringData* data, CClusteringResu
 	}
 }
 
+template<CHierarchicalClustering::TLinkage LINKAGE>
+static void hierarchicalMultithreadClustering( const IClusteringData* data, CClusteringResult& result )
+{
+	CHierarchicalClustering::CParam params;
+	params.Linkage = LINKAGE;
+	params.DistanceType = DF_Euclid;
+	params.MinClustersCount = 2;
+	params.MaxClustersDistance = 10;
+	params.ThreadCount = 4;
+
+	CHierarchicalClustering hierarchical( params );
+	hierarchical.Clusterize( data, result );
+}
+
+static void hierarchicalMemoryBoundedClustering( const IClusteringData* data, CClusteringResult& result )
+{
+	CHierarchicalClustering::CParam params;
+	params.Linkage = CHierarchicalClustering::L_Single;
+	params.DistanceType = DF_Euclid;
+	params.MinClustersCount = 2;
+	params.MaxClustersDistance = 10;
+	params.ThreadCount = 4;
+	params.MemoryBounded = true;
+
+	CHierarchicalClustering hierarchical( params );
+	hierarchical.Clusterize( data, result );
+}
+
 static void isoDataClustering( const IClusteringData* data, CClusteringResult& result )
 {
 	CIsoDataClustering::CParam params;
@@ -243,6 +271,35 @@ static void kmeansElkanClustering( const IClusteringData* data, CClusteringResul
 	kMeans.Clusterize( data, result );
 }
 
+static void kmeansMiniBatchClustering( const IClusteringData* data, CClusteringResult& result )
+{
+	CKMeansClustering::CParam params;
+	params.DistanceFunc = DF_Euclid;
+	params.InitialClustersCount = 2;
+	params.MaxIterations = 50;
+	params.Algo = CKMeansClustering::KMA_MiniBatch;
+	params.Initialization = CKMeansClustering::KMI_KMeansParallel;
+	params.MiniBatchSize = 64;
+	params.ThreadCount = -1;
+
+	CKMeansClustering kMeans( params );
+	kMeans.Clusterize( data, result );
+}
+
+static void kmeansParallelInitClustering( const IClusteringData* data, CClusteringResult& result )
+{
+	CKMeansClustering::CParam params;
+	params.DistanceFunc = DF_Euclid;
+	params.InitialClustersCount = 2;
+	params.MaxIterations = 50;
+	params.Algo = CKMeansClustering::KMA_Lloyd;
+	params.Initialization = CKMeansClustering::KMI_KMeansParallel;
+	params.ThreadCount = -1;
+
+	CKMeansClustering kMeans( params );
+	kMeans.Clusterize( data, result );
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 
 // Result check functions
@@ -511,6 +568,78 @@ TEST_F( CClusteringTest, PrecalcKmeans )
 	precalcTestImpl( kmeansElkanDefaultInitClustering, expectedResult );
 }
 
+// The result of hierarchical clustering must not depend on the number of threads
+TEST_F( CClusteringTest, HierarchicalMultithread )
+{
+	CPtr<IClusteringData> sparseData = nullptr;
+	CPtr<IClusteringData> denseData = nullptr;
+	generateData( 512, 32, 0x1984, sparseData, denseData );
+
+	const TClusteringFunction singleThread[] = {
+		hierarchicalClustering<CHierarchicalClustering::L_Single>,
+		hierarchicalClustering<CHierarchicalClustering::L_Average>,
+		hierarchicalClustering<CHierarchicalClustering::L_Complete>,
+		hierarchicalClustering<CHierarchicalClustering::L_Ward>,
+		hierarchicalClustering<CHierarchicalClustering::L_Single>
+	};
+	const TClusteringFunction multiThread[] = {
+		hierarchicalMultithreadClustering<CHierarchicalClustering::L_Single>,
+		hierarchicalMultithreadClustering<CHierarchicalClustering::L_Average>,
+		hierarchicalMultithreadClustering<CHierarchicalClustering::L_Complete>,
+		hierarchicalMultithreadClustering<CHierarchicalClustering::L_Ward>,
+		hierarchicalMemoryBoundedClustering
+	};
+
+	for( int i = 0; i < static_cast<int>( sizeof( singleThread ) / sizeof( singleThread[0] ) ); ++i ) {
+		CClusteringResult expected;
+		singleThread[i]( denseData, expected );
+
+		CClusteringResult actual;
+		multiThread[i]( denseData, actual );
+		EXPECT_TRUE( isEqual( expected, actual ) );
+		ASSERT_EQ( expected.Data.Size(), actual.Data.Size() );
+		for( int j = 0; j < expected.Data.Size(); ++j ) {
+			EXPECT_EQ( expected.Data[j], actual.Data[j] );
+		}
+	}
+}
+
+// Mini-batch algorithm and KMeans|| initialization support only dense data
+TEST_F( CClusteringTest, KMeansMiniBatch )
+{
+	CPtr<IClusteringData> sparseData = nullptr;
+	CPtr<IClusteringData> denseData = nullptr;
+
+	getSampleData( sparseData, denseData );
+	CClusteringResult sampleResult;
+	kmeansMiniBatchClustering( denseData, sampleResult );
+	EXPECT_TRUE( isCorrectSampleResult( sampleResult ) );
+	kmeansParallelInitClustering( denseData, sampleResult );
+	EXPECT_TRUE( isCorrectSampleResult( sampleResult ) );
+
+	// Mini-batch and full batch algorithms must split the generated data in the same way
+	generateData( 512, 32, 0x1984, sparseData, denseData );
+	CClusteringResult expected;
+	kmeansLloydClustering( denseData, expected );
+	CClusteringResult actual;
+	kmeansMiniBatchClustering( denseData, actual );
+	ASSERT_EQ( expected.ClusterCount, actual.ClusterCount );
+	ASSERT_EQ( expected.Data.Size(), actual.Data.Size() );
+	const bool isSwapped = expected.Data[0] != actual.Data[0];
+	int mismatchCount = 0;
+	for( int i = 0; i < expected.Data.Size(); ++i ) {
+		if( ( expected.Data[i] != actual.Data[i] ) != isSwapped ) {
+			++mismatchCount;
+		}
+	}
+	EXPECT_LE( mismatchCount, expected.Data.Size() / 100 );
+
+	// The sparse data falls back to KMeans++ initialization
+	CClusteringResult sparseResult;
+	kmeansParallelInitClustering( sparseData, sparseResult );
+	EXPECT_EQ( 2, sparseResult.ClusterCount );
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 
 // Check on trivial sample
@@ -561,6 +690,7 @@ INSTANTIATE_TEST_CASE_P( CClusteringTestInstantiation, CClusteringTest,
 		hierarchicalClustering<CHierarchicalClustering::L_Average>,
 		hierarchicalClustering<CHierarchicalClustering::L_Complete>,
 		hierarchicalClustering<CHierarchicalClustering::L_Ward>,
+		hierarchicalMemoryBoundedClustering,
 		isoDataClustering,
 		kmeansElkanClustering,
 		kmeansLloydClustering
@@ -0,0 +1,178 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#include <common.h>
+#pragma hdrstop
+
+#include <TestFixture.h>
+#include <atomic>
+
+using namespace NeoML;
+using namespace NeoMLTest;
+
+namespace NeoMLTest {
+
+// f(x, n) = (x - 1.5)^2 + (n - 3)^2, x is double in [-5, 5], n is int in [-10, 10]
+class CTestFunctionEvaluation : public IFunctionEvaluation {
+public:
+	CTestFunctionEvaluation() : callCount( 0 ) {}
+
+	int GetCallCount() const { return callCount; }
+
+	int NumberOfDimensions() const override { return 2; }
+	const IParamTraits& GetParamTraits( int index ) const override
+	{
+		return index == 0 ? static_cast<const IParamTraits&>( CDoubleTraits::GetInstance() ) : CIntTraits::GetInstance();
+	}
+	const IParamTraits& GetResultTraits() const override { return CDoubleTraits::GetInstance(); }
+	CFunctionParam GetMinConstraint( int index ) const override
+	{
+		return index == 0 ? CDoubleTraits::Box( -5 ) : CIntTraits::Box( -10 );
+	}
+	CFunctionParam GetMaxConstraint( int index ) const override
+	{
+		return index == 0 ? CDoubleTraits::Box( 5 ) : CIntTraits::Box( 10 );
+	}
+
+	CFunctionParam Evaluate( const CFunctionParamVector& param ) override
+	{
+		callCount++;
+		const double x = CDoubleTraits::Unbox( param[0] ) - 1.5;
+		const double n = CIntTraits::Unbox( param[1] ) - 3;
+		return CDoubleTraits::Box( x * x + n * n );
+	}
+
+private:
+	std::atomic<int> callCount;
+};
+
+} // namespace NeoMLTest
+
+static void checkSamePopulation( const CDifferentialEvolution& expected, const CDifferentialEvolution& actual )
+{
+	ASSERT_EQ( expected.GetPopulation().Size(), actual.GetPopulation().Size() );
+	for( int i = 0; i < expected.GetPopulation().Size(); ++i ) {
+		EXPECT_EQ( CDoubleTraits::Unbox( expected.GetPopulation()[i][0] ), CDoubleTraits::Unbox( actual.GetPopulation()[i][0] ) );
+		EXPECT_EQ( CIntTraits::Unbox( expected.GetPopulation()[i][1] ), CIntTraits::Unbox( actual.GetPopulation()[i][1] ) );
+		EXPECT_EQ( CDoubleTraits::Unbox( expected.GetPopulationFuncValues()[i] ),
+			CDoubleTraits::Unbox( actual.GetPopulationFuncValues()[i] ) );
+	}
+}
+
+static void checkOptimum( const CDifferentialEvolution& evolution, double tolerance )
+{
+	const CFunctionParamVector optimum = evolution.GetOptimalVector();
+	EXPECT_NEAR( 1.5, CDoubleTraits::Unbox( optimum[0] ), tolerance );
+	EXPECT_EQ( 3, CIntTraits::Unbox( optimum[1] ) );
+}
+
+TEST( CDifferentialEvolutionTest, ParallelEvaluation )
+{
+	CTestFunctionEvaluation sequentialFunc;
+	CDifferentialEvolution sequential( sequentialFunc, 0.5, 0.5, 20 );
+	sequential.SetMaxGenerationCount( 50 );
+	sequential.RunOptimization();
+	checkOptimum( sequential, 1e-2 );
+	EXPECT_EQ( sequentialFunc.GetCallCount(), sequential.GetEvaluationCount() );
+
+	// The trials are built in the same order, so the result doesn't depend on the number of threads
+	CTestFunctionEvaluation parallelFunc;
+	CDifferentialEvolution parallel( parallelFunc, 0.5, 0.5, 20 );
+	parallel.SetMaxGenerationCount( 50 );
+	parallel.SetThreadCount( 4 );
+	parallel.RunOptimization();
+	checkSamePopulation( sequential, parallel );
+	EXPECT_EQ( sequentialFunc.GetCallCount(), parallelFunc.GetCallCount() );
+}
+
+TEST( CDifferentialEvolutionTest, Cache )
+{
+	CTestFunctionEvaluation func;
+	CDifferentialEvolution evolution( func, 0.5, 0.5, 20 );
+	evolution.SetMaxGenerationCount( 50 );
+	evolution.RunOptimization();
+
+	for( int threadCount = 1; threadCount <= 4; threadCount += 3 ) {
+		CTestFunctionEvaluation cachedFunc;
+		CDifferentialEvolution cached( cachedFunc, 0.5, 0.5, 20 );
+		cached.SetMaxGenerationCount( 50 );
+		cached.SetThreadCount( threadCount );
+		cached.SetCacheEnabled( true );
+		cached.RunOptimization();
+
+		// The function is deterministic, so the cache doesn't change the result
+		checkSamePopulation( evolution, cached );
+		EXPECT_EQ( cachedFunc.GetCallCount(), cached.GetEvaluationCount() );
+		EXPECT_EQ( cached.GetEvaluationCount(), cached.GetCachedValueCount() );
+		EXPECT_LT( cached.GetEvaluationCount(), evolution.GetEvaluationCount() );
+	}
+}
+
+TEST( CDifferentialEvolutionTest, SteadyState )
+{
+	for( int threadCount = 1; threadCount <= 4; threadCount += 3 ) {
+		CTestFunctionEvaluation func;
+		CDifferentialEvolution evolution( func, 0.5, 0.5, 20 );
+		evolution.SetMaxGenerationCount( 50 );
+		evolution.SetThreadCount( threadCount );
+		evolution.SetSteadyState( true );
+		evolution.SetCacheEnabled( true );
+		evolution.RunOptimization();
+		checkOptimum( evolution, 1e-2 );
+		EXPECT_EQ( func.GetCallCount(), evolution.GetEvaluationCount() );
+
+		// Build one more generation
+		const int evaluationCount = evolution.GetEvaluationCount();
+		EXPECT_TRUE( evolution.BuildNextGeneration() );
+		EXPECT_LE( evolution.GetEvaluationCount() - evaluationCount, 20 + threadCount - 1 );
+	}
+}
+
+TEST( CDifferentialEvolutionTest, Checkpoint )
+{
+	CTestFunctionEvaluation func;
+	CDifferentialEvolution uninterrupted( func, 0.5, 0.5, 20 );
+	uninterrupted.SetCacheEnabled( true );
+	for( int i = 0; i < 20; ++i ) {
+		uninterrupted.BuildNextGeneration();
+	}
+
+	CMemoryFile file;
+	{
+		CDifferentialEvolution first( func, 0.5, 0.5, 20 );
+		first.SetCacheEnabled( true );
+		for( int i = 0; i < 10; ++i ) {
+			first.BuildNextGeneration();
+		}
+		CArchive archive( &file, CArchive::store );
+		first.Serialize( archive );
+	}
+
+	file.Seek( 0, CBaseFile::begin );
+	CDifferentialEvolution resumed( func, 0.5, 0.5, 20 );
+	resumed.SetCacheEnabled( true );
+	{
+		CArchive archive( &file, CArchive::load );
+		resumed.Serialize( archive );
+	}
+	EXPECT_GT( resumed.GetCachedValueCount(), 0 );
+	for( int i = 0; i < 10; ++i ) {
+		resumed.BuildNextGeneration();
+	}
+
+	checkSamePopulation( uninterrupted, resumed );
+	EXPECT_EQ( uninterrupted.GetEvaluationCount(), resumed.GetEvaluationCount() );
+	EXPECT_EQ( uninterrupted.GetCachedValueCount(), resumed.GetCachedValueCount() );
+}
@@ -92,6 +92,64 @@ TEST( CDnnBlobTest, BufferTest )
     EXPECT_TRUE( CompareBlobs( *check, *blob ) ); // same data
 }
 
+TEST( CDnnBlobTest, ConvertFromHalfTest )
+{
+    const auto met = MathEngine().GetType();
+    if( met != MET_Cpu ) {
+        NEOML_HILIGHT( GTEST_LOG_( INFO ) ) << "Skipped rest of test for MathEngine type=" << met << " because no implementation.\n";
+        return;
+    }
+
+    CRandom random( 0x3A1 );
+    CREATE_FILL_FLOAT_ARRAY( data, -10.f, 10.f, 64, random );
+    CPtr<CDnnBlob> blob = CDnnBlob::CreateDataBlob( MathEngine(), CT_Float, 4, 2, 8 );
+    blob->CopyFrom( data.GetPtr() );
+
+    for( TBlobType type : { CT_Float16, CT_BFloat16 } ) {
+        // The relative precision of the 16-bit formats (half of the last mantissa bit)
+        const float precision = type == CT_Float16 ? 1.f / 2048 : 1.f / 256;
+
+        CPtr<CDnnBlob> half = CDnnBlob::CreateBlob( MathEngine(), type, blob->GetDesc() );
+        half->ConvertFrom( blob );
+        EXPECT_EQ( type, half->GetDataType() );
+
+        // Serialization keeps the 16-bit data as is
+        CMemoryFile file;
+        {
+            CArchive archive( &file, CArchive::store );
+            SerializeBlob( MathEngine(), archive, half );
+        }
+        file.SeekToBegin();
+        CPtr<CDnnBlob> loaded;
+        {
+            CArchive archive( &file, CArchive::load );
+            SerializeBlob( MathEngine(), archive, loaded );
+        }
+        ASSERT_EQ( type, loaded->GetDataType() );
+        EXPECT_TRUE( loaded->HasEqualDimensions( blob ) );
+
+        CPtr<CDnnBlob> result = blob->GetClone();
+        result->ConvertFrom( loaded );
+        CDnnBlobBuffer<float> buffer( *result, TDnnBlobBufferAccess::Read );
+        for( int i = 0; i < buffer.Size(); ++i ) {
+            EXPECT_NEAR( data[i], buffer[i], precision * fabsf( data[i] ) ) << i;
+        }
+    }
+
+    // Conversion between the 16-bit formats goes through float
+    CPtr<CDnnBlob> float16 = CDnnBlob::CreateBlob( MathEngine(), CT_Float16, blob->GetDesc() );
+    float16->ConvertFrom( blob );
+    CPtr<CDnnBlob> bfloat16 = CDnnBlob::CreateBlob( MathEngine(), CT_BFloat16, blob->GetDesc() );
+    bfloat16->ConvertFrom( float16 );
+    CPtr<CDnnBlob> expected = CDnnBlob::CreateBlob( MathEngine(), CT_BFloat16, blob->GetDesc() );
+    expected->ConvertFrom( blob );
+    CDnnBlobBuffer<CBFloat16> bfloat16Buffer( *bfloat16, TDnnBlobBufferAccess::Read );
+    CDnnBlobBuffer<CBFloat16> expectedBuffer( *expected, TDnnBlobBufferAccess::Read );
+    for( int i = 0; i < bfloat16Buffer.Size(); ++i ) {
+        EXPECT_NEAR( expectedBuffer[i].ToFloat(), bfloat16Buffer[i].ToFloat(), fabsf( data[i] ) / 128 ) << i;
+    }
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 
 TEST( CDnnBlobTest, BufferMemoryThresholdTest )
@@ -0,0 +1,217 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#include <common.h>
+#pragma hdrstop
+
+#include <TestFixture.h>
+
+using namespace NeoML;
+using namespace NeoMLTest;
+
+static std::initializer_list<CActivationDesc> epilogueActivations = {
+	CActivationDesc( AF_ReLU, CReLULayer::CParam{ 0.f } ),
+	CActivationDesc( AF_ReLU, CReLULayer::CParam{ 0.5f } ),
+	CActivationDesc( AF_ELU, CELULayer::CParam{ 0.3f } ),
+	CActivationDesc( AF_LeakyReLU, CLeakyReLULayer::CParam{ 0.1f } ),
+	CActivationDesc( AF_Sigmoid ),
+	CActivationDesc( AF_Tanh ),
+	CActivationDesc( AF_HardTanh ),
+	CActivationDesc( AF_HardSigmoid, CHardSigmoidLayer::CParam{ 0.2f, 0.4f } ),
+	CActivationDesc( AF_HSwish ),
+	CActivationDesc( AF_Linear, CLinearLayer::CParam{ 2.f, -0.5f } ),
+	CActivationDesc( AF_GELU, CGELULayer::CParam{ CGELULayer::CM_SigmoidApproximate } ),
+	CActivationDesc( AF_GELU, CGELULayer::CParam{ CGELULayer::CM_Precise } ),
+	CActivationDesc( AF_GELU, CGELULayer::CParam{ CGELULayer::CM_TanhApproximate } ) };
+
+static CPtr<CDnnBlob> epilogueFusionData( CRandom& random, int height, int width, int channels, int batch = 3 )
+{
+	CREATE_FILL_FLOAT_ARRAY( dataArr, -1.f, 1.f, batch * height * width * channels, random );
+	CPtr<CDnnBlob> dataBlob = CDnnBlob::Create2DImageBlob( MathEngine(), CT_Float, 1, batch,
+		height, width, channels );
+	dataBlob->CopyFrom( dataArr.GetPtr() );
+	return dataBlob;
+}
+
+static CBaseLayer* addEpilogueActivation( const CActivationDesc& desc, CBaseLayer& input )
+{
+	CPtr<CBaseLayer> activation = CreateActivationLayer( input.MathEngine(), desc );
+	activation->SetName( "activation" );
+	activation->Connect( input );
+	input.GetDnn()->AddLayer( *activation );
+	return activation;
+}
+
+// Fills the free terms with non-zero values (by default they're zero and the layers with epilogue ignore them)
+template<class TLayer>
+static void setRandomFreeTerm( TLayer& layer, CRandom& random )
+{
+	CPtr<CDnnBlob> freeTerm = layer.GetFreeTermData();
+	CDnnBlobBuffer<> buffer( *freeTerm, TDnnBlobBufferAccess::Write );
+	for( int i = 0; i < buffer.Size(); ++i ) {
+		buffer[i] = static_cast<float>( random.Uniform( -1, 1 ) );
+	}
+	buffer.Close();
+	layer.SetFreeTermData( freeTerm );
+}
+
+static void checkEpilogueFusion( CDnn& dnn, CSinkLayer* sink, int expectedConvFusions, int expectedFcFusions )
+{
+	dnn.RunOnce();
+	CPtr<CDnnBlob> expected = sink->GetBlob()->GetCopy();
+
+	CDnnOptimizationReport report = OptimizeDnn( dnn );
+	EXPECT_EQ( expectedConvFusions, report.ConvEpilogueFusions );
+	EXPECT_EQ( expectedFcFusions, report.FullyConnectedEpilogueFusions );
+	dnn.RunOnce();
+	CPtr<CDnnBlob> actual = sink->GetBlob()->GetCopy();
+	EXPECT_TRUE( CompareBlobs( *expected, *actual, 1e-4f ) );
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+TEST( EpilogueFusionOptimizerTest, ConvResidual )
+{
+	const auto met = MathEngine().GetType();
+	if( met != MET_Cpu && met != MET_Cuda ) {
+		NEOML_HILIGHT( GTEST_LOG_( INFO ) ) << "Skipped rest of test for MathEngine type=" << met << " because no implementation.\n";
+		// BlobConvolutionWithEpilogue
+		return;
+	}
+
+	CRandom random( 0x654 );
+	for( int channels : { 6, 16 } ) {
+		for( int filterSize : { 1, 3 } ) {
+			for( const CActivationDesc& activation : epilogueActivations ) {
+				CDnn dnn( random, MathEngine() );
+				CSourceLayer* data = Source( dnn, "data" );
+				CConvLayer* conv = Conv( channels, CConvAxisParams( filterSize, filterSize / 2 ),
+					CConvAxisParams( filterSize, filterSize / 2 ) )( "conv", data );
+				CBaseLayer* lastLayer = addEpilogueActivation( activation, *conv );
+				lastLayer = Sum()( "residual", data, lastLayer );
+				CSinkLayer* sink = Sink( lastLayer, "sink" );
+
+				data->SetBlob( epilogueFusionData( random, 7, 9, channels ) );
+				dnn.RunOnce();
+				setRandomFreeTerm( *conv, random );
+				checkEpilogueFusion( dnn, sink, 1, 0 );
+				EXPECT_EQ( 3, dnn.GetLayerCount() );
+			}
+		}
+	}
+}
+
+TEST( EpilogueFusionOptimizerTest, ConvResidualWithoutActivation )
+{
+	const auto met = MathEngine().GetType();
+	if( met != MET_Cpu && met != MET_Cuda ) {
+		NEOML_HILIGHT( GTEST_LOG_( INFO ) ) << "Skipped rest of test for MathEngine type=" << met << " because no implementation.\n";
+		// BlobConvolutionWithEpilogue
+		return;
+	}
+
+	CRandom random( 0x654 );
+	CDnn dnn( random, MathEngine() );
+	CSourceLayer* data = Source( dnn, "data" );
+	CBaseLayer* lastLayer = Conv( 5, CConvAxisParams( 3, 2, 1, 2 ), CConvAxisParams( 3, 2, 1, 2 ) )( "conv", data );
+	lastLayer = Sum()( "residual", lastLayer, data );
+	CSinkLayer* sink = Sink( lastLayer, "sink" );
+
+	data->SetBlob( epilogueFusionData( random, 6, 5, 5 ) );
+	checkEpilogueFusion( dnn, sink, 1, 0 );
+	EXPECT_EQ( 3, dnn.GetLayerCount() );
+}
+
+TEST( EpilogueFusionOptimizerTest, FullyConnected )
+{
+	const auto met = MathEngine().GetType();
+	if( met != MET_Cpu && met != MET_Cuda ) {
+		NEOML_HILIGHT( GTEST_LOG_( INFO ) ) << "Skipped rest of test for MathEngine type=" << met << " because no implementation.\n";
+		// MultiplyMatrixByTransposedMatrixWithEpilogue
+		return;
+	}
+
+	CRandom random( 0x654 );
+	for( bool residual : { false, true } ) {
+		for( const CActivationDesc& activation : epilogueActivations ) {
+			CDnn dnn( random, MathEngine() );
+			CSourceLayer* data = Source( dnn, "data" );
+			CFullyConnectedLayer* fc = FullyConnected( 24 )( "fc", data );
+			CBaseLayer* lastLayer = addEpilogueActivation( activation, *fc );
+			if( residual ) {
+				lastLayer = Sum()( "residual", lastLayer, data );
+			}
+			CSinkLayer* sink = Sink( lastLayer, "sink" );
+
+			data->SetBlob( epilogueFusionData( random, 1, 1, 24 ) );
+			dnn.RunOnce();
+			setRandomFreeTerm( *fc, random );
+			checkEpilogueFusion( dnn, sink, 0, 1 );
+			EXPECT_EQ( 3, dnn.GetLayerCount() );
+		}
+	}
+}
+
+TEST( EpilogueFusionOptimizerTest, FullyConnectedLargeBatch )
+{
+	const auto met = MathEngine().GetType();
+	if( met != MET_Cpu && met != MET_Cuda ) {
+		NEOML_HILIGHT( GTEST_LOG_( INFO ) ) << "Skipped rest of test for MathEngine type=" << met << " because no implementation.\n";
+		// MultiplyMatrixByTransposedMatrixWithEpilogue
+		return;
+	}
+
+	// The result is too large to be calculated at once, so the epilogue is applied to it by parts
+	CRandom random( 0x655 );
+	for( const CActivationDesc& activation : epilogueActivations ) {
+		CDnn dnn( random, MathEngine() );
+		CSourceLayer* data = Source( dnn, "data" );
+		CFullyConnectedLayer* fc = FullyConnected( 24 )( "fc", data );
+		CBaseLayer* lastLayer = addEpilogueActivation( activation, *fc );
+		lastLayer = Sum()( "residual", lastLayer, data );
+		CSinkLayer* sink = Sink( lastLayer, "sink" );
+
+		data->SetBlob( epilogueFusionData( random, 1, 1, 24, 5000 ) );
+		dnn.RunOnce();
+		setRandomFreeTerm( *fc, random );
+		checkEpilogueFusion( dnn, sink, 0, 1 );
+	}
+}
+
+TEST( EpilogueFusionOptimizerTest, SharedOutputs )
+{
+	CRandom random( 0x654 );
+	CDnn dnn( random, MathEngine() );
+	CSourceLayer* data = Source( dnn, "data" );
+	// The output of the convolution is used twice
+	CConvLayer* conv = Conv( 4, CConvAxisParams( 3, 1 ), CConvAxisParams( 3, 1 ) )( "conv", data );
+	CBaseLayer* relu = Relu()( "relu", conv );
+	Sink( conv, "convSink" );
+	Sink( Sum()( "residual", relu, data ), "sink" );
+	// The output of the fully-connected layer is used twice
+	CFullyConnectedLayer* fc = FullyConnected( 8 )( "fc", data );
+	Sink( Sigmoid()( "sigmoid", fc ), "sigmoidSink" );
+	Sink( Tanh()( "tanh", fc ), "tanhSink" );
+	// Both inputs of the sum are connected to the same layer
+	CFullyConnectedLayer* secondFc = FullyConnected( 4 )( "secondFc", data );
+	Sink( Sum()( "doubleSum", secondFc, secondFc ), "doubleSink" );
+	// Not supported activation
+	CFullyConnectedLayer* thirdFc = FullyConnected( 4 )( "thirdFc", data );
+	Sink( Abs()( "abs", thirdFc ), "absSink" );
+
+	CDnnOptimizationReport report = OptimizeDnn( dnn );
+	EXPECT_EQ( 0, report.ConvEpilogueFusions );
+	EXPECT_EQ( 0, report.FullyConnectedEpilogueFusions );
+}
@@ -1265,6 +1265,46 @@ GTEST_TEST( SerializeFromFile, GruLayerSerialization )
 
 // ====================================================================================================================
 
+// CBidirectionalGruLayer
+
+#ifdef GENERATE_SERIALIZATION_FILES
+
+GTEST_TEST( SerializeToFile, BidirectionalGruLayerSerialization )
+{
+	CRandom random;
+	CDnn dnn( random, MathEngine() );
+
+	CPtr<CGruLayer> grus[2] = { new CGruLayer( MathEngine() ), new CGruLayer( MathEngine() ) };
+	for( CPtr<CGruLayer>& gru : grus ) {
+		setSpecificParams( *gru );
+	}
+
+	CPtr<CBidirectionalGruLayer> layerPtr = new CBidirectionalGruLayer( MathEngine(), *grus[0], *grus[1] );
+	setBaseParams( *layerPtr );
+	layerPtr->SetName( LayerName );
+	dnn.AddLayer( *layerPtr );
+
+	CArchiveFile file( getFileName( "NeoMLDnnBidirectionalGruLayer" ), CArchive::store );
+	CArchive archive( &file, CArchive::store );
+	archive.Serialize( dnn );
+}
+
+#endif // GENERATE_SERIALIZATION_FILES
+
+template<>
+inline void checkSpecificParams<CBidirectionalGruLayer>( CBidirectionalGruLayer& layer )
+{
+	// The thread count isn't serialized
+	EXPECT_EQ( 2, layer.GetThreadCount() );
+}
+
+GTEST_TEST( SerializeFromFile, BidirectionalGruLayerSerialization )
+{
+	checkSerializeLayer<CBidirectionalGruLayer>( "NeoMLDnnBidirectionalGruLayer" );
+}
+
+// ====================================================================================================================
+
 // CMaxOverTimePoolingLayer
 
 template<>
@@ -3275,6 +3315,203 @@ GTEST_TEST( SerializeFromFile, ChannelwiseWith1x1LayerSerialization )
 
 // ====================================================================================================================
 
+// CConvWithEpilogueLayer
+
+#ifdef GENERATE_SERIALIZATION_FILES
+
+GTEST_TEST( SerializeToFile, ConvWithEpilogueLayerSerialization )
+{
+	const int inputChannels = 4;
+	const int outputChannels = 3;
+
+	CRandom random;
+	CDnn dnn( random, MathEngine() );
+
+	CPtr<CConvWithEpilogueLayer> layerPtr = new CConvWithEpilogueLayer( MathEngine(),
+		/*filter*/generateBlob( outputChannels, 3, 3, 1, inputChannels ),
+		/*freeTerm*/generateBlob( 1, 1, 1, 1, outputChannels ),
+		/*padding*/1, 2, /*stride*/1, 1, /*dilation*/1, 2,
+		/*activation*/CActivationDesc( AF_LeakyReLU, CLeakyReLULayer::CParam{ 0.25f } ),
+		/*residual*/true );
+
+	setBaseParams( *layerPtr );
+	layerPtr->SetName( LayerName );
+	dnn.AddLayer( *layerPtr );
+
+	CArchiveFile file( getFileName( "NeoMLDnnConvWithEpilogueLayer" ), CArchive::store );
+	CArchive archive( &file, CArchive::store );
+	archive.Serialize( dnn );
+}
+
+#endif // GENERATE_SERIALIZATION_FILES
+
+template<>
+inline void checkSpecificParams<CConvWithEpilogueLayer>( CConvWithEpilogueLayer& layer )
+{
+	const int inputChannels = 4;
+	const int outputChannels = 3;
+
+	checkBlob( *layer.Filter(), outputChannels * 3 * 3 * inputChannels );
+	checkBlob( *layer.FreeTerm(), outputChannels );
+	EXPECT_EQ( 1, layer.PaddingHeight() );
+	EXPECT_EQ( 2, layer.PaddingWidth() );
+	EXPECT_EQ( 1, layer.StrideHeight() );
+	EXPECT_EQ( 1, layer.StrideWidth() );
+	EXPECT_EQ( 1, layer.DilationHeight() );
+	EXPECT_EQ( 2, layer.DilationWidth() );
+	EXPECT_EQ( AF_LeakyReLU, layer.Activation().GetType() );
+	EXPECT_FLOAT_EQ( 0.25f, layer.Activation().GetParam<CLeakyReLULayer::CParam>().Alpha );
+	EXPECT_TRUE( layer.Residual() );
+}
+
+GTEST_TEST( SerializeFromFile, ConvWithEpilogueLayerSerialization )
+{
+	checkSerializeLayer<CConvWithEpilogueLayer>( "NeoMLDnnConvWithEpilogueLayer" );
+}
+
+// ====================================================================================================================
+
+// CFullyConnectedWithEpilogueLayer
+
+#ifdef GENERATE_SERIALIZATION_FILES
+
+GTEST_TEST( SerializeToFile, FullyConnectedWithEpilogueLayerSerialization )
+{
+	CRandom random;
+	CDnn dnn( random, MathEngine() );
+
+	CPtr<CFullyConnectedWithEpilogueLayer> layerPtr = new CFullyConnectedWithEpilogueLayer( MathEngine(),
+		/*weights*/generateBlob( TestSize, 1, 1, 1, 2 * TestSize ),
+		/*freeTerm*/nullptr,
+		/*activation*/CActivationDesc( AF_GELU, CGELULayer::CParam{ CGELULayer::CM_Precise } ),
+		/*residual*/false );
+
+	setBaseParams( *layerPtr );
+	layerPtr->SetName( LayerName );
+	dnn.AddLayer( *layerPtr );
+
+	CArchiveFile file( getFileName( "NeoMLDnnFullyConnectedWithEpilogueLayer" ), CArchive::store );
+	CArchive archive( &file, CArchive::store );
+	archive.Serialize( dnn );
+}
+
+#endif // GENERATE_SERIALIZATION_FILES
+
+template<>
+inline void checkSpecificParams<CFullyConnectedWithEpilogueLayer>( CFullyConnectedWithEpilogueLayer& layer )
+{
+	checkBlob( *layer.Weights(), 2 * TestSize * TestSize );
+	EXPECT_EQ( nullptr, layer.FreeTerm() );
+	EXPECT_EQ( AF_GELU, layer.Activation().GetType() );
+	EXPECT_EQ( CGELULayer::TCalculationMode::CM_Precise, layer.Activation().GetParam<CGELULayer::CParam>().Mode );
+	EXPECT_FALSE( layer.Residual() );
+}
+
+GTEST_TEST( SerializeFromFile, FullyConnectedWithEpilogueLayerSerialization )
+{
+	checkSerializeLayer<CFullyConnectedWithEpilogueLayer>( "NeoMLDnnFullyConnectedWithEpilogueLayer" );
+}
+
+// ====================================================================================================================
+
+// CSparseConvLayer
+
+#ifdef GENERATE_SERIALIZATION_FILES
+
+GTEST_TEST( SerializeToFile, SparseConvLayerSerialization )
+{
+	const int inputChannels = 5;
+	const int outputChannels = 2;
+
+	CRandom random;
+	CDnn dnn( random, MathEngine() );
+
+	CPtr<CSparseConvLayer> layerPtr = new CSparseConvLayer( MathEngine(),
+		/*filter*/generateBlob( outputChannels, 3, 1, 1, inputChannels ),
+		/*freeTerm*/generateBlob( 1, 1, 1, 1, outputChannels ),
+		/*padding*/1, 0, /*stride*/2, 1, /*dilation*/1, 1,
+		/*activation*/CActivationDesc( AF_ReLU, CReLULayer::CParam{ 6.f } ),
+		/*residual*/false );
+
+	setBaseParams( *layerPtr );
+	layerPtr->SetName( LayerName );
+	dnn.AddLayer( *layerPtr );
+
+	CArchiveFile file( getFileName( "NeoMLDnnSparseConvLayer" ), CArchive::store );
+	CArchive archive( &file, CArchive::store );
+	archive.Serialize( dnn );
+}
+
+#endif // GENERATE_SERIALIZATION_FILES
+
+template<>
+inline void checkSpecificParams<CSparseConvLayer>( CSparseConvLayer& layer )
+{
+	const int inputChannels = 5;
+	const int outputChannels = 2;
+
+	checkBlob( *layer.Filter(), outputChannels * 3 * 1 * inputChannels );
+	checkBlob( *layer.FreeTerm(), outputChannels );
+	EXPECT_EQ( 1, layer.PaddingHeight() );
+	EXPECT_EQ( 0, layer.PaddingWidth() );
+	EXPECT_EQ( 2, layer.StrideHeight() );
+	EXPECT_EQ( 1, layer.StrideWidth() );
+	EXPECT_EQ( 1, layer.DilationHeight() );
+	EXPECT_EQ( 1, layer.DilationWidth() );
+	EXPECT_EQ( AF_ReLU, layer.Activation().GetType() );
+	EXPECT_FLOAT_EQ( 6.f, layer.Activation().GetParam<CReLULayer::CParam>().UpperThreshold );
+	EXPECT_FALSE( layer.Residual() );
+}
+
+GTEST_TEST( SerializeFromFile, SparseConvLayerSerialization )
+{
+	checkSerializeLayer<CSparseConvLayer>( "NeoMLDnnSparseConvLayer" );
+}
+
+// ====================================================================================================================
+
+// CSparseFullyConnectedLayer
+
+#ifdef GENERATE_SERIALIZATION_FILES
+
+GTEST_TEST( SerializeToFile, SparseFullyConnectedLayerSerialization )
+{
+	CRandom random;
+	CDnn dnn( random, MathEngine() );
+
+	CPtr<CSparseFullyConnectedLayer> layerPtr = new CSparseFullyConnectedLayer( MathEngine(),
+		/*weights*/generateBlob( TestSize, 1, 1, 1, TestSize ),
+		/*freeTerm*/generateBlob( 1, 1, 1, 1, TestSize ),
+		/*activation*/CActivationDesc( AF_HSwish ),
+		/*residual*/true );
+
+	setBaseParams( *layerPtr );
+	layerPtr->SetName( LayerName );
+	dnn.AddLayer( *layerPtr );
+
+	CArchiveFile file( getFileName( "NeoMLDnnSparseFullyConnectedLayer" ), CArchive::store );
+	CArchive archive( &file, CArchive::store );
+	archive.Serialize( dnn );
+}
+
+#endif // GENERATE_SERIALIZATION_FILES
+
+template<>
+inline void checkSpecificParams<CSparseFullyConnectedLayer>( CSparseFullyConnectedLayer& layer )
+{
+	checkBlob( *layer.Weights(), TestSize * TestSize );
+	checkBlob( *layer.FreeTerm(), TestSize );
+	EXPECT_EQ( AF_HSwish, layer.Activation().GetType() );
+	EXPECT_TRUE( layer.Residual() );
+}
+
+GTEST_TEST( SerializeFromFile, SparseFullyConnectedLayerSerialization )
+{
+	checkSerializeLayer<CSparseFullyConnectedLayer>( "NeoMLDnnSparseFullyConnectedLayer" );
+}
+
+// ====================================================================================================================
+
 // CRowwiseOperationChainLayer
 
 #ifdef GENERATE_SERIALIZATION_FILES
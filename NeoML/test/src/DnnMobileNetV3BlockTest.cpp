@@ -368,7 +368,9 @@ TEST( MobileNetV3OptimizerTest, SimpleNonResidual )
 						CDnnOptimizationReport report = OptimizeDnn( dnn );
 						EXPECT_EQ( 1, report.MobileNetV3NonResidualBlocks );
 						EXPECT_EQ( 0, report.MobileNetV3ResidualBlocks );
-						EXPECT_EQ( 9, dnn.GetLayerCount() );
+						// Both fully-connected layers of SE are fused with their activations
+						EXPECT_EQ( 2, report.FullyConnectedEpilogueFusions );
+						EXPECT_EQ( 7, dnn.GetLayerCount() );
 					}
 				}
 			}
@@ -398,7 +400,7 @@ TEST( MobileNetV3OptimizerTest, SimpleResidual )
 	CDnnOptimizationReport report = OptimizeDnn( dnn );
 	EXPECT_EQ( 0, report.MobileNetV3NonResidualBlocks );
 	EXPECT_EQ( 1, report.MobileNetV3ResidualBlocks );
-	EXPECT_EQ( 9, dnn.GetLayerCount() );
+	EXPECT_EQ( 7, dnn.GetLayerCount() );
 }
 
 TEST( MobileNetV3OptimizerTest, ResidualResidual )
@@ -425,7 +427,7 @@ TEST( MobileNetV3OptimizerTest, ResidualResidual )
 	CDnnOptimizationReport report = OptimizeDnn( dnn );
 	EXPECT_EQ( 0, report.MobileNetV3NonResidualBlocks );
 	EXPECT_EQ( 1, report.MobileNetV3ResidualBlocks );
-	EXPECT_EQ( 11, dnn.GetLayerCount() );
+	EXPECT_EQ( 9, dnn.GetLayerCount() );
 }
 
 TEST( MobileNetV3OptimizerTest, NeighboringResiduals )
@@ -452,7 +454,7 @@ TEST( MobileNetV3OptimizerTest, NeighboringResiduals )
 	CDnnOptimizationReport report = OptimizeDnn( dnn );
 	EXPECT_EQ( 1, report.MobileNetV3NonResidualBlocks );
 	EXPECT_EQ( 0, report.MobileNetV3ResidualBlocks );
-	EXPECT_EQ( 12, dnn.GetLayerCount() );
+	EXPECT_EQ( 10, dnn.GetLayerCount() );
 }
 
 TEST( MobileNetV3OptimizerTest, SinkFromTheMiddle )
@@ -520,6 +522,6 @@ TEST( MobileNetV3OptimizerTest, SinkDisablesResidual )
 	CDnnOptimizationReport report = OptimizeDnn( dnn );
 	EXPECT_EQ( 1, report.MobileNetV3NonResidualBlocks );
 	EXPECT_EQ( 0, report.MobileNetV3ResidualBlocks );
-	EXPECT_EQ( 11, dnn.GetLayerCount() );
+	EXPECT_EQ( 9, dnn.GetLayerCount() );
 }
 
@@ -19,6 +19,7 @@ limitations under the License.
 #include <TestFixture.h>
 
 #include <NeoML/Dnn/Rowwise/Activation.h>
+#include <NeoML/Dnn/Layers/BatchNormalizationLayer.h>
 
 using namespace NeoML;
 using namespace NeoMLTest;
@@ -37,7 +38,7 @@ static CPtr<CDnnBlob> rowwiseSampleInput( CRandom& random )
 
 typedef CBaseLayer* ( *TChainBuilder )( CSourceLayer* source );
 
-static void rowwiseTestImpl( TChainBuilder buildChain, int seed )
+static void rowwiseTestImpl( TChainBuilder buildChain, int seed, int threadCount = 1 )
 {
 	CRandom random( seed );
 	CDnn dnn( random, MathEngine() );
@@ -56,7 +57,9 @@ static void rowwiseTestImpl( TChainBuilder buildChain, int seed )
 	// Let's check that layers didn't overwrite input data
 	EXPECT_TRUE( CompareBlobs( *originalInput, *source->GetBlob() ) );
 
-	CDnnOptimizationReport report = OptimizeDnn( dnn );
+	CDnnOptimizationSettings settings;
+	settings.RowwiseThreadCount = threadCount;
+	CDnnOptimizationReport report = OptimizeDnn( dnn, settings );
 	EXPECT_EQ( 1, report.RowwiseChainCount );
 	EXPECT_EQ( 3, dnn.GetLayerCount() );
 
@@ -245,3 +248,74 @@ TEST( RowwiseTest, OptimizeOpInFrontOfChain )
 	};
 	rowwiseTestImpl( buildChain, 0xBEE );
 }
+
+TEST( RowwiseTest, BatchNormalizationOp )
+{
+	const auto met = MathEngine().GetType();
+	if(met != MET_Cpu && met != MET_Cuda) {
+		NEOML_HILIGHT( GTEST_LOG_( INFO ) ) << "Skipped rest of test for MathEngine type=" << met << " because no implementation.\n";
+		return;
+	}
+
+	auto buildChain = [] ( CSourceLayer* source ) -> CBaseLayer* {
+		CBaseLayer* curr = source;
+		curr = MaxPooling( 3, 3 )( curr );
+		curr = BatchNormalization( true )( curr );
+
+		CPtr<CDnnBlob> finalParams = CDnnBlob::CreateDataBlob( source->MathEngine(), CT_Float, 1, 2, RowwiseTestChannels );
+		CRandom random( 0xB47C );
+		CDnnBlobBuffer<float> buffer( *finalParams, TDnnBlobBufferAccess::Write );
+		for( int i = 0; i < buffer.Size(); ++i ) {
+			buffer[i] = static_cast<float>( random.Uniform( -2., 2. ) );
+		}
+		buffer.Close();
+		dynamic_cast<CBatchNormalizationLayer*>( curr )->SetFinalParams( finalParams );
+
+		curr = Relu()( curr );
+		return curr;
+	};
+	rowwiseTestImpl( buildChain, 0xBA7C4 );
+}
+
+TEST( RowwiseTest, ResidualSum )
+{
+	const auto met = MathEngine().GetType();
+	if(met != MET_Cpu && met != MET_Cuda) {
+		NEOML_HILIGHT( GTEST_LOG_( INFO ) ) << "Skipped rest of test for MathEngine type=" << met << " because no implementation.\n";
+		return;
+	}
+
+	auto buildChain = [] ( CSourceLayer* source ) -> CBaseLayer* {
+		CBaseLayer* curr = source;
+		curr = Conv( RowwiseTestChannels, CConvAxisParams( 3, 1 ), CConvAxisParams( 3, 1 ), true )( curr );
+		curr = Relu()( curr );
+		curr = Conv( RowwiseTestChannels, CConvAxisParams( 3, 1 ), CConvAxisParams( 3, 1 ), true )( curr );
+		curr = Sum()( source, curr );
+		return curr;
+	};
+	rowwiseTestImpl( buildChain, 0x5E5 );
+}
+
+TEST( RowwiseTest, MultithreadedChain )
+{
+	const auto met = MathEngine().GetType();
+	if(met != MET_Cpu && met != MET_Cuda) {
+		NEOML_HILIGHT( GTEST_LOG_( INFO ) ) << "Skipped rest of test for MathEngine type=" << met << " because no implementation.\n";
+		return;
+	}
+
+	auto buildChain = [] ( CSourceLayer* source ) -> CBaseLayer* {
+		CBaseLayer* curr = source;
+		curr = ChannelwiseConv( RowwiseTestChannels, CConvAxisParams( 3, 1 ), CConvAxisParams( 3, 1 ), true )( curr );
+		curr = HSwish()( curr );
+		curr = Conv( RowwiseTestChannels, CConvAxisParams( 5, 2, 1, 1 ), CConvAxisParams( 3, 1 ), true )( curr );
+		curr = Sum()( source, curr );
+		curr = MaxPooling( 3, 3, 2, 2 )( curr );
+		curr = ChannelwiseConv( RowwiseTestChannels, CConvAxisParams( 7, 3, 2 ), CConvAxisParams( 3, 1, 1 ), false )( curr );
+		curr = Conv( 23, CConvAxisParams( 1 ), CConvAxisParams( 1 ), true )( curr );
+		curr = MeanPooling( 2, 2 )( curr );
+		curr = Sigmoid()( curr );
+		return curr;
+	};
+	rowwiseTestImpl( buildChain, 0x7EAD, 4 );
+}
@@ -860,6 +860,469 @@ TEST_F( CDnnSimpleTest, SoftmaxTest )
 	performSoftmaxTest( createTransposedBlob32, CSoftmaxLayer::NA_BatchLength );
 }
 
+TEST_F( CDnnSimpleTest, HalfPrecisionWeightsTest )
+{
+	const auto met = MathEngine().GetType();
+	if( met != MET_Cpu ) {
+		NEOML_HILIGHT( GTEST_LOG_( INFO ) ) << "Skipped rest of test for MathEngine type=" << met << " because no implementation.\n";
+		// MultiplyMatrixByTransposedMatrix with 16-bit weights
+		return;
+	}
+
+	CRandom random( 0x7D3 );
+	CDnn dnn( random, MathEngine() );
+	CSourceLayer* data = Source( dnn, "data" );
+	CFullyConnectedLayer* fc = FullyConnected( 32 )( "fc", data );
+	CSinkLayer* sink = Sink( fc, "sink" );
+	// The activations may be stored in 16-bit format too
+	CSinkLayer* castSink = Sink( Cast( CT_Float )( "fromHalf", Cast( CT_Float16 )( "toHalf", fc ) ), "castSink" );
+
+	CREATE_FILL_FLOAT_ARRAY( dataArr, -1.f, 1.f, 5 * 48, random );
+	CPtr<CDnnBlob> dataBlob = CDnnBlob::CreateDataBlob( MathEngine(), CT_Float, 1, 5, 48 );
+	dataBlob->CopyFrom( dataArr.GetPtr() );
+	data->SetBlob( dataBlob );
+
+	dnn.RunOnce();
+	CPtr<CDnnBlob> expected = sink->GetBlob()->GetCopy();
+	EXPECT_TRUE( CompareBlobs( *expected, *castSink->GetBlob(), 1e-2f ) );
+
+	CPtr<CDnnBlob> floatWeights = fc->GetWeightsData();
+	dnn.DisableLearning();
+	for( TBlobType type : { CT_Float16, CT_BFloat16 } ) {
+		dnn.SetParamStorageType( type );
+		dnn.RunOnce();
+		EXPECT_EQ( type, fc->Weights()->GetDataType() );
+		EXPECT_EQ( CT_Float, fc->GetWeightsData()->GetDataType() );
+		EXPECT_TRUE( CompareBlobs( *floatWeights, *fc->GetWeightsData(), 1e-2f ) );
+		EXPECT_TRUE( CompareBlobs( *expected, *sink->GetBlob(), type == CT_Float16 ? 1e-2f : 5e-2f ) );
+	}
+
+	// The 16-bit weights are serialized in float
+	CPtr<CDnnBlob> halfWeights = fc->GetWeightsData();
+	CMemoryFile file;
+	{
+		CArchive archive( &file, CArchive::store );
+		fc->Serialize( archive );
+	}
+	EXPECT_EQ( CT_BFloat16, fc->Weights()->GetDataType() );
+	file.SeekToBegin();
+	{
+		CPtr<CFullyConnectedLayer> loaded = new CFullyConnectedLayer( MathEngine() );
+		CArchive archive( &file, CArchive::load );
+		loaded->Serialize( archive );
+		ASSERT_EQ( CT_Float, loaded->Weights()->GetDataType() );
+		EXPECT_TRUE( CompareBlobs( *halfWeights, *loaded->Weights() ) );
+	}
+
+	// The weights are converted to float when learning is enabled
+	dnn.EnableLearning();
+	dnn.RunOnce();
+	EXPECT_EQ( CT_Float, fc->Weights()->GetDataType() );
+	EXPECT_TRUE( CompareBlobs( *halfWeights, *fc->Weights() ) );
+	EXPECT_TRUE( CompareBlobs( *expected, *sink->GetBlob(), 5e-2f ) );
+}
+
+// The convolution descriptor may keep the transformed filter, it must follow the filter changes
+TEST_F( CDnnSimpleTest, ConvFilterChangeTest )
+{
+	CRandom random( 0x5A2 );
+	CDnn dnn( random, MathEngine() );
+	CSourceLayer* data = Source( dnn, "data" );
+	// The shape is suitable for the Winograd algorithm on CPU
+	CConvLayer* conv = Conv( 19, CConvAxisParams( 3, 1 ), CConvAxisParams( 3, 1 ) )( "conv", data );
+	CSinkLayer* sink = Sink( conv, "sink" );
+	EuclideanLoss()( "loss", conv, Source( dnn, "target" ) );
+
+	// The reference network gets the filter through SetFilterData
+	CDnn referenceDnn( random, MathEngine() );
+	CSourceLayer* referenceData = Source( referenceDnn, "data" );
+	CConvLayer* reference = Conv( 19, CConvAxisParams( 3, 1 ), CConvAxisParams( 3, 1 ) )( "conv", referenceData );
+	CSinkLayer* referenceSink = Sink( reference, "sink" );
+
+	CREATE_FILL_FLOAT_ARRAY( dataArr, -1.f, 1.f, 2 * 20 * 20 * 17, random );
+	CPtr<CDnnBlob> dataBlob = CDnnBlob::Create2DImageBlob( MathEngine(), CT_Float, 1, 2, 20, 20, 17 );
+	dataBlob->CopyFrom( dataArr.GetPtr() );
+	data->SetBlob( dataBlob );
+	referenceData->SetBlob( dataBlob );
+	CPtr<CDnnBlob> targetBlob = CDnnBlob::Create2DImageBlob( MathEngine(), CT_Float, 1, 2, 20, 20, 19 );
+	targetBlob->Fill( 0.5f );
+	CheckCast<CSourceLayer>( dnn.GetLayer( "target" ) )->SetBlob( targetBlob );
+
+	dnn.RunAndLearnOnce();
+	referenceDnn.RunOnce();
+	for( int i = 0; i < 3; ++i ) {
+		reference->SetFilterData( conv->GetFilterData() );
+		reference->SetFreeTermData( conv->GetFreeTermData() );
+		referenceDnn.RunOnce();
+		// The forward pass uses the filter changed by the previous learning step without reshape
+		dnn.RunAndLearnOnce();
+		EXPECT_TRUE( CompareBlobs( *referenceSink->GetBlob(), *sink->GetBlob(), 1e-4f ) );
+	}
+}
+
+TEST_F( CDnnSimpleTest, AutoTuningTest )
+{
+	const auto met = MathEngine().GetType();
+	if( met != MET_Cpu ) {
+		NEOML_HILIGHT( GTEST_LOG_( INFO ) ) << "Skipped rest of test for MathEngine type=" << met << " because no implementation.\n";
+		// Only the CPU math engine chooses the algorithms by measurements
+		return;
+	}
+
+	CRandom random( 0x5A1 );
+	CDnn dnn( random, MathEngine() );
+	CSourceLayer* data = Source( dnn, "data" );
+	CConvLayer* conv = Conv( 24, CConvAxisParams( 3, 1 ), CConvAxisParams( 3, 1 ) )( "conv", data );
+	CSinkLayer* sink = Sink( Conv( 16, CConvAxisParams( 1 ), CConvAxisParams( 1 ) )( "conv1x1", conv ), "sink" );
+
+	CREATE_FILL_FLOAT_ARRAY( dataArr, -1.f, 1.f, 2 * 20 * 20 * 16, random );
+	CPtr<CDnnBlob> dataBlob = CDnnBlob::Create2DImageBlob( MathEngine(), CT_Float, 1, 2, 20, 20, 16 );
+	dataBlob->CopyFrom( dataArr.GetPtr() );
+	data->SetBlob( dataBlob );
+
+	dnn.RunOnce();
+	CPtr<CDnnBlob> expected = sink->GetBlob()->GetCopy();
+
+	dnn.WarmUpAutoTuning();
+	EXPECT_FALSE( MathEngine().GetAutoTuningMode() );
+	EXPECT_TRUE( CompareBlobs( *expected, *sink->GetBlob(), 1e-3f ) );
+
+	CMemoryFile file;
+	{
+		CArchive archive( &file, CArchive::store );
+		dnn.SerializeAutoTuningCache( archive );
+	}
+	EXPECT_LT( 0, file.GetLength() );
+	file.SeekToBegin();
+	{
+		CArchive archive( &file, CArchive::load );
+		dnn.SerializeAutoTuningCache( archive );
+	}
+
+	dnn.RunOnce();
+	EXPECT_TRUE( CompareBlobs( *expected, *sink->GetBlob(), 1e-3f ) );
+}
+
+// Checks that the whole sequence calculation used for inference is equivalent to the step by step calculation
+template<class TLayer>
+static void checkRecurrentSequenceKernel( const std::function<TLayer*( CDnn&, CSourceLayer*, CSourceLayer* )>& build )
+{
+	const int sequenceLength = 50;
+	const int sequenceCount = 3;
+	const int objectSize = 12;
+	const int hiddenSize = 20;
+	for( bool reverse : { false, true } ) {
+		for( bool hasInitialState : { false, true } ) {
+			CRandom random( 0x6E2 );
+			CDnn dnn( random, MathEngine() );
+			CSourceLayer* data = Source( dnn, "data" );
+			CSourceLayer* state = hasInitialState ? Source( dnn, "state" ) : nullptr;
+			TLayer* recurrent = build( dnn, data, state );
+			recurrent->SetReverseSequence( reverse );
+			CSinkLayer* sink = Sink( recurrent, "sink" );
+			EuclideanLoss()( "loss", recurrent, Source( dnn, "target" ) );
+
+			CREATE_FILL_FLOAT_ARRAY( dataArr, -1.f, 1.f, sequenceLength * sequenceCount * objectSize, random );
+			CPtr<CDnnBlob> dataBlob = CDnnBlob::CreateDataBlob( MathEngine(), CT_Float,
+				sequenceLength, sequenceCount, objectSize );
+			dataBlob->CopyFrom( dataArr.GetPtr() );
+			data->SetBlob( dataBlob );
+			if( state != nullptr ) {
+				CREATE_FILL_FLOAT_ARRAY( stateArr, -1.f, 1.f, sequenceCount * hiddenSize, random );
+				CPtr<CDnnBlob> stateBlob = CDnnBlob::CreateDataBlob( MathEngine(), CT_Float, 1, sequenceCount,
+					hiddenSize );
+				stateBlob->CopyFrom( stateArr.GetPtr() );
+				state->SetBlob( stateBlob );
+			}
+			CPtr<CDnnBlob> targetBlob = CDnnBlob::CreateDataBlob( MathEngine(), CT_Float,
+				sequenceLength, sequenceCount, hiddenSize );
+			targetBlob->Fill( 0.5f );
+			CheckCast<CSourceLayer>( dnn.GetLayer( "target" ) )->SetBlob( targetBlob );
+
+			// LSTM calculates the backward step by step
+			// (GRU has the whole sequence backward, it's checked in GruSequenceKernelBackwardTest)
+			dnn.RunAndBackwardOnce();
+			CPtr<CDnnBlob> expected = sink->GetBlob()->GetCopy();
+
+			dnn.RunOnce();
+			EXPECT_TRUE( CompareBlobs( *expected, *sink->GetBlob(), 1e-4f ) );
+		}
+	}
+}
+
+TEST_F( CDnnSimpleTest, GruSequenceKernelTest )
+{
+	const auto met = MathEngine().GetType();
+	if( met != MET_Cpu ) {
+		NEOML_HILIGHT( GTEST_LOG_( INFO ) ) << "Skipped rest of test for MathEngine type=" << met << " because no implementation.\n";
+		// Gru
+		return;
+	}
+
+	checkRecurrentSequenceKernel<CGruLayer>( []( CDnn&, CSourceLayer* data, CSourceLayer* state ) {
+		return state == nullptr ? Gru( 20 )( "gru", data ) : Gru( 20 )( "gru", data, state );
+	} );
+}
+
+TEST_F( CDnnSimpleTest, GruSequenceKernelSetWeightsTest )
+{
+	const auto met = MathEngine().GetType();
+	if( met != MET_Cpu ) {
+		NEOML_HILIGHT( GTEST_LOG_( INFO ) ) << "Skipped rest of test for MathEngine type=" << met << " because no implementation.\n";
+		// Gru
+		return;
+	}
+
+	CRandom random( 0x6E3 );
+	CDnn dnn( random, MathEngine() );
+	CSourceLayer* data = Source( dnn, "data" );
+	CGruLayer* gru = Gru( 16 )( "gru", data );
+	CGruLayer* copy = Gru( 16 )( "copy", data );
+	CSinkLayer* sink = Sink( gru, "sink" );
+	CSinkLayer* copySink = Sink( copy, "copySink" );
+
+	CREATE_FILL_FLOAT_ARRAY( dataArr, -1.f, 1.f, 10 * 2 * 8, random );
+	CPtr<CDnnBlob> dataBlob = CDnnBlob::CreateDataBlob( MathEngine(), CT_Float, 10, 2, 8 );
+	dataBlob->CopyFrom( dataArr.GetPtr() );
+	data->SetBlob( dataBlob );
+	dnn.RunOnce();
+	EXPECT_FALSE( CompareBlobs( *sink->GetBlob(), *copySink->GetBlob(), 1e-4f ) );
+
+	// The sequence descriptor of the copy has been created, it must be rebuilt with the new weights
+	copy->SetMainWeightsData( gru->GetMainWeightsData() );
+	copy->SetMainFreeTermData( gru->GetMainFreeTermData() );
+	copy->SetGateWeightsData( gru->GetGateWeightsData() );
+	copy->SetGateFreeTermData( gru->GetGateFreeTermData() );
+	dnn.RunOnce();
+	EXPECT_TRUE( CompareBlobs( *sink->GetBlob(), *copySink->GetBlob(), 1e-5f ) );
+}
+
+// Builds the network for the GRU backward check: the fully-connected layers before GRU are trained by its input diffs
+// If isStepByStep the GRU is placed into the outer recurrent layer, so it's calculated by its internal network
+static CGruLayer* buildGruBackwardNet( CDnn& dnn, bool isStepByStep, bool reverse, bool hasInitialState )
+{
+	const int hiddenSize = 20;
+	CDnnSimpleGradientSolver* solver = new CDnnSimpleGradientSolver( MathEngine() );
+	solver->SetLearningRate( 0.1f );
+	solver->SetMomentDecayRate( 0.f );
+	dnn.SetSolver( solver );
+
+	CFullyConnectedLayer* fc = FullyConnected( 12 )( "fc", Source( dnn, "data" ) );
+	CFullyConnectedLayer* stateFc = hasInitialState
+		? FullyConnected( hiddenSize )( "stateFc", Source( dnn, "state" ) ) : nullptr;
+
+	CPtr<CGruLayer> gru = new CGruLayer( MathEngine() );
+	gru->SetName( "gru" );
+	gru->SetHiddenSize( hiddenSize );
+	CPtr<CBaseLayer> output = gru.Ptr();
+	if( isStepByStep ) {
+		CPtr<CRecurrentLayer> outer = new CRecurrentLayer( MathEngine() );
+		outer->SetName( "outer" );
+		outer->AddLayer( *gru );
+		outer->SetInputMapping( *gru );
+		if( hasInitialState ) {
+			outer->SetInputMapping( 1, *gru, 1 );
+		}
+		outer->SetOutputMapping( *gru );
+		outer->SetReverseSequence( reverse );
+		output = outer.Ptr();
+	} else {
+		gru->SetReverseSequence( reverse );
+	}
+	output->Connect( 0, *fc );
+	if( hasInitialState ) {
+		output->Connect( 1, *stateFc );
+	}
+	dnn.AddLayer( *output );
+
+	Sink( output.Ptr(), "sink" );
+	EuclideanLoss()( "loss", output.Ptr(), Source( dnn, "target" ) );
+	return gru;
+}
+
+// Copies the parameters of the layer with the same name
+static void copyGruBackwardNetWeights( CDnn& from, CGruLayer& fromGru, CDnn& to, CGruLayer& toGru )
+{
+	for( const char* name : { "fc", "stateFc" } ) {
+		if( from.HasLayer( name ) ) {
+			CFullyConnectedLayer* fromFc = CheckCast<CFullyConnectedLayer>( from.GetLayer( name ) );
+			CFullyConnectedLayer* toFc = CheckCast<CFullyConnectedLayer>( to.GetLayer( name ) );
+			toFc->SetWeightsData( fromFc->GetWeightsData() );
+			toFc->SetFreeTermData( fromFc->GetFreeTermData() );
+		}
+	}
+	toGru.SetMainWeightsData( fromGru.GetMainWeightsData() );
+	toGru.SetMainFreeTermData( fromGru.GetMainFreeTermData() );
+	toGru.SetGateWeightsData( fromGru.GetGateWeightsData() );
+	toGru.SetGateFreeTermData( fromGru.GetGateFreeTermData() );
+}
+
+TEST_F( CDnnSimpleTest, GruSequenceKernelBackwardTest )
+{
+	const auto met = MathEngine().GetType();
+	if( met != MET_Cpu ) {
+		NEOML_HILIGHT( GTEST_LOG_( INFO ) ) << "Skipped rest of test for MathEngine type=" << met << " because no implementation.\n";
+		// GruBackward
+		return;
+	}
+
+	const int sequenceLength = 30;
+	const int sequenceCount = 3;
+	const int objectSize = 8;
+	const int hiddenSize = 20;
+	for( bool reverse : { false, true } ) {
+		for( bool hasInitialState : { false, true } ) {
+			CRandom random( 0x6E4 );
+			CDnn dnn( random, MathEngine() );
+			CGruLayer* gru = buildGruBackwardNet( dnn, false, reverse, hasInitialState );
+			CDnn expectedDnn( random, MathEngine() );
+			CGruLayer* expectedGru = buildGruBackwardNet( expectedDnn, true, reverse, hasInitialState );
+
+			CREATE_FILL_FLOAT_ARRAY( dataArr, -1.f, 1.f, sequenceLength * sequenceCount * objectSize, random );
+			CPtr<CDnnBlob> dataBlob = CDnnBlob::CreateDataBlob( MathEngine(), CT_Float,
+				sequenceLength, sequenceCount, objectSize );
+			dataBlob->CopyFrom( dataArr.GetPtr() );
+			CREATE_FILL_FLOAT_ARRAY( stateArr, -1.f, 1.f, sequenceCount * hiddenSize, random );
+			CPtr<CDnnBlob> stateBlob = CDnnBlob::CreateDataBlob( MathEngine(), CT_Float, 1, sequenceCount, hiddenSize );
+			stateBlob->CopyFrom( stateArr.GetPtr() );
+			CPtr<CDnnBlob> targetBlob = CDnnBlob::CreateDataBlob( MathEngine(), CT_Float,
+				sequenceLength, sequenceCount, hiddenSize );
+			targetBlob->Fill( 0.5f );
+			for( CDnn* net : { &dnn, &expectedDnn } ) {
+				CheckCast<CSourceLayer>( net->GetLayer( "data" ) )->SetBlob( dataBlob );
+				if( hasInitialState ) {
+					CheckCast<CSourceLayer>( net->GetLayer( "state" ) )->SetBlob( stateBlob );
+				}
+				CheckCast<CSourceLayer>( net->GetLayer( "target" ) )->SetBlob( targetBlob );
+				net->RunOnce();
+			}
+			copyGruBackwardNetWeights( dnn, *gru, expectedDnn, *expectedGru );
+
+			// The weights after several training steps depend on the diffs of all the parameters and the inputs
+			for( int i = 0; i < 3; ++i ) {
+				dnn.RunAndLearnOnce();
+				expectedDnn.RunAndLearnOnce();
+				EXPECT_TRUE( CompareBlobs( *CheckCast<CSinkLayer>( expectedDnn.GetLayer( "sink" ) )->GetBlob(),
+					*CheckCast<CSinkLayer>( dnn.GetLayer( "sink" ) )->GetBlob(), 1e-4f ) );
+			}
+			EXPECT_TRUE( CompareBlobs( *expectedGru->GetGateWeightsData(), *gru->GetGateWeightsData(), 1e-4f ) );
+			EXPECT_TRUE( CompareBlobs( *expectedGru->GetGateFreeTermData(), *gru->GetGateFreeTermData(), 1e-4f ) );
+			EXPECT_TRUE( CompareBlobs( *expectedGru->GetMainWeightsData(), *gru->GetMainWeightsData(), 1e-4f ) );
+			EXPECT_TRUE( CompareBlobs( *expectedGru->GetMainFreeTermData(), *gru->GetMainFreeTermData(), 1e-4f ) );
+			for( const char* name : { "fc", "stateFc" } ) {
+				if( dnn.HasLayer( name ) ) {
+					EXPECT_TRUE( CompareBlobs(
+						*CheckCast<CFullyConnectedLayer>( expectedDnn.GetLayer( name ) )->GetWeightsData(),
+						*CheckCast<CFullyConnectedLayer>( dnn.GetLayer( name ) )->GetWeightsData(), 1e-4f ) );
+				}
+			}
+		}
+	}
+}
+
+TEST_F( CDnnSimpleTest, BidirectionalGruOptimizationTest )
+{
+	const auto met = MathEngine().GetType();
+	if( met != MET_Cpu ) {
+		NEOML_HILIGHT( GTEST_LOG_( INFO ) ) << "Skipped rest of test for MathEngine type=" << met << " because no implementation.\n";
+		// BidirectionalGru
+		return;
+	}
+
+	for( int threadCount : { 1, 2 } ) {
+		CRandom random( 0x6E4 );
+		CDnn dnn( random, MathEngine() );
+		CSourceLayer* data = Source( dnn, "data" );
+		CGruLayer* direct = Gru( 16 )( "direct", data );
+		CGruLayer* reverse = Gru( 12 )( "reverse", data );
+		reverse->SetReverseSequence( true );
+		Sink( ConcatChannels()( "concat", direct, reverse ), "sink" );
+
+		CREATE_FILL_FLOAT_ARRAY( dataArr, -1.f, 1.f, 30 * 4 * 10, random );
+		CPtr<CDnnBlob> dataBlob = CDnnBlob::CreateDataBlob( MathEngine(), CT_Float, 30, 4, 10 );
+		dataBlob->CopyFrom( dataArr.GetPtr() );
+		data->SetBlob( dataBlob );
+		dnn.RunOnce();
+		for( CGruLayer* gru : { direct, reverse } ) {
+			CPtr<CDnnBlob> freeTerm = gru->GetGateFreeTermData();
+			freeTerm->Fill( 0.3f );
+			gru->SetGateFreeTermData( freeTerm );
+		}
+		dnn.RunOnce();
+		CPtr<CDnnBlob> expected = CheckCast<CSinkLayer>( dnn.GetLayer( "sink" ) )->GetBlob()->GetCopy();
+
+		CDnnOptimizationSettings settings;
+		settings.BidirectionalGruThreadCount = threadCount;
+		CDnnOptimizationReport report = OptimizeDnn( dnn, settings );
+		EXPECT_EQ( 1, report.BidirectionalGruFusions );
+		EXPECT_EQ( 4, dnn.GetLayerCount() );
+		dnn.RunOnce();
+		EXPECT_TRUE( CompareBlobs( *expected, *CheckCast<CSinkLayer>( dnn.GetLayer( "sink" ) )->GetBlob(), 1e-5f ) );
+
+		CMemoryFile file;
+		CArchive storing( &file, CArchive::SD_Storing );
+		dnn.Serialize( storing );
+		storing.Close();
+		file.SeekToBegin();
+		CArchive loading( &file, CArchive::SD_Loading );
+		CDnn loaded( random, MathEngine() );
+		loaded.Serialize( loading );
+		loading.Close();
+		CheckCast<CSourceLayer>( loaded.GetLayer( "data" ) )->SetBlob( dataBlob );
+		loaded.RunOnce();
+		EXPECT_TRUE( CompareBlobs( *expected, *CheckCast<CSinkLayer>( loaded.GetLayer( "sink" ) )->GetBlob(), 1e-5f ) );
+	}
+}
+
+TEST_F( CDnnSimpleTest, LstmSequenceKernelTest )
+{
+	const auto met = MathEngine().GetType();
+	if( met != MET_Cpu ) {
+		NEOML_HILIGHT( GTEST_LOG_( INFO ) ) << "Skipped rest of test for MathEngine type=" << met << " because no implementation.\n";
+		// Lstm
+		return;
+	}
+
+	checkRecurrentSequenceKernel<CLstmLayer>( []( CDnn&, CSourceLayer* data, CSourceLayer* state ) {
+		return state == nullptr ? Lstm( 20, 0.f )( "lstm", data ) : Lstm( 20, 0.f )( "lstm", data, state );
+	} );
+}
+
+// The normalization with the residual input is equivalent to the sum followed by the normalization
+TEST_F( CDnnSimpleTest, ObjectNormalizationResidualTest )
+{
+	CRandom random( 0x5E1 );
+	CDnn dnn( random, MathEngine() );
+	CSourceLayer* data = Source( dnn, "data" );
+	CSourceLayer* target = Source( dnn, "target" );
+	CFullyConnectedLayer* fc = FullyConnected( 40 )( "fc", data );
+	CFullyConnectedLayer* fusedFc = FullyConnected( 40 )( "fusedFc", data );
+	CBaseLayer* norm = ObjectNormalization()( "norm", Sum()( "sum", fc, data ) );
+	CBaseLayer* fusedNorm = ObjectNormalization()( "fusedNorm", fusedFc, data );
+	CSinkLayer* sink = Sink( norm, "sink" );
+	CSinkLayer* fusedSink = Sink( fusedNorm, "fusedSink" );
+	EuclideanLoss()( "loss", norm, target );
+	EuclideanLoss()( "fusedLoss", fusedNorm, target );
+
+	CREATE_FILL_FLOAT_ARRAY( dataArr, -1.f, 1.f, 6 * 40, random );
+	CPtr<CDnnBlob> dataBlob = CDnnBlob::CreateDataBlob( MathEngine(), CT_Float, 1, 6, 40 );
+	dataBlob->CopyFrom( dataArr.GetPtr() );
+	data->SetBlob( dataBlob );
+	CREATE_FILL_FLOAT_ARRAY( targetArr, -1.f, 1.f, 6 * 40, random );
+	CPtr<CDnnBlob> targetBlob = dataBlob->GetClone();
+	targetBlob->CopyFrom( targetArr.GetPtr() );
+	target->SetBlob( targetBlob );
+
+	dnn.RunOnce();
+	fusedFc->SetWeightsData( fc->GetWeightsData() );
+	fusedFc->SetFreeTermData( fc->GetFreeTermData() );
+	for( int i = 0; i < 3; ++i ) {
+		dnn.RunAndLearnOnce();
+		EXPECT_TRUE( CompareBlobs( *sink->GetBlob(), *fusedSink->GetBlob(), 1e-4f ) );
+		EXPECT_TRUE( CompareBlobs( *fc->GetWeightsData(), *fusedFc->GetWeightsData(), 1e-4f ) );
+	}
+}
+
 TEST_F( CDnnSimpleTest, DropSmallValuesTest )
 {
 	const auto met = MathEngine().GetType();
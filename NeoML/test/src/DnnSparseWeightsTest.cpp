@@ -0,0 +1,172 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#include <common.h>
+#pragma hdrstop
+
+#include <TestFixture.h>
+
+using namespace NeoML;
+using namespace NeoMLTest;
+
+static CPtr<CDnnBlob> sparseWeightsData( CRandom& random, int height, int width, int channels )
+{
+	const int batch = 5;
+	CREATE_FILL_FLOAT_ARRAY( dataArr, -1.f, 1.f, batch * height * width * channels, random );
+	CPtr<CDnnBlob> dataBlob = CDnnBlob::Create2DImageBlob( MathEngine(), CT_Float, 1, batch,
+		height, width, channels );
+	dataBlob->CopyFrom( dataArr.GetPtr() );
+	return dataBlob;
+}
+
+// Fills the weights with random values and sets the given share of them to zero
+static CPtr<CDnnBlob> pruneWeights( const CPtr<CDnnBlob>& weights, CRandom& random, float sparsity )
+{
+	CPtr<CDnnBlob> result = weights->GetCopy();
+	CDnnBlobBuffer<> buffer( *result, TDnnBlobBufferAccess::Write );
+	for( int i = 0; i < buffer.Size(); ++i ) {
+		buffer[i] = random.Uniform( 0, 1 ) < sparsity ? 0.f : static_cast<float>( random.Uniform( -1, 1 ) );
+	}
+	buffer.Close();
+	return result;
+}
+
+static void checkSparseWeights( CDnn& dnn, CSinkLayer* sink, const CDnnOptimizationSettings& settings,
+	int expectedConvs, int expectedFcs )
+{
+	dnn.RunOnce();
+	CPtr<CDnnBlob> expected = sink->GetBlob()->GetCopy();
+
+	CDnnOptimizationReport report = OptimizeDnn( dnn, settings );
+	EXPECT_EQ( expectedConvs, report.SparseConvLayers );
+	EXPECT_EQ( expectedFcs, report.SparseFullyConnectedLayers );
+	dnn.RunOnce();
+	CPtr<CDnnBlob> actual = sink->GetBlob()->GetCopy();
+	EXPECT_TRUE( CompareBlobs( *expected, *actual, 1e-4f ) );
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+TEST( SparseWeightsOptimizerTest, Conv )
+{
+	const auto met = MathEngine().GetType();
+	if( met != MET_Cpu && met != MET_Cuda ) {
+		NEOML_HILIGHT( GTEST_LOG_( INFO ) ) << "Skipped rest of test for MathEngine type=" << met << " because no implementation.\n";
+		// BlobConvolutionWithSparseFilter
+		return;
+	}
+
+	CRandom random( 0x2a1 );
+	for( int filterSize : { 1, 3 } ) {
+		for( int stride : { 1, 2 } ) {
+			CDnn dnn( random, MathEngine() );
+			CSourceLayer* data = Source( dnn, "data" );
+			CConvLayer* conv = Conv( 12, CConvAxisParams( filterSize, filterSize / 2, stride ),
+				CConvAxisParams( filterSize, filterSize / 2, stride ) )( "conv", data );
+			CSinkLayer* sink = Sink( Relu()( "relu", conv ), "sink" );
+
+			data->SetBlob( sparseWeightsData( random, 9, 7, 16 ) );
+			dnn.RunOnce();
+			conv->SetFilterData( pruneWeights( conv->GetFilterData(), random, 0.9f ) );
+			conv->SetFreeTermData( pruneWeights( conv->GetFreeTermData(), random, 0.f ) );
+
+			checkSparseWeights( dnn, sink, CDnnOptimizationSettings(), 1, 0 );
+		}
+	}
+}
+
+TEST( SparseWeightsOptimizerTest, ConvWithEpilogue )
+{
+	const auto met = MathEngine().GetType();
+	if( met != MET_Cpu && met != MET_Cuda ) {
+		NEOML_HILIGHT( GTEST_LOG_( INFO ) ) << "Skipped rest of test for MathEngine type=" << met << " because no implementation.\n";
+		// BlobConvolutionWithSparseFilter
+		return;
+	}
+
+	CRandom random( 0x2a1 );
+	CDnn dnn( random, MathEngine() );
+	CSourceLayer* data = Source( dnn, "data" );
+	CConvLayer* conv = Conv( 8, CConvAxisParams( 3, 1 ), CConvAxisParams( 3, 1 ) )( "conv", data );
+	CSinkLayer* sink = Sink( Sum()( "residual", HSwish()( "hswish", conv ), data ), "sink" );
+
+	data->SetBlob( sparseWeightsData( random, 6, 11, 8 ) );
+	dnn.RunOnce();
+	conv->SetFilterData( pruneWeights( conv->GetFilterData(), random, 0.85f ) );
+
+	checkSparseWeights( dnn, sink, CDnnOptimizationSettings(), 1, 0 );
+	EXPECT_EQ( 3, dnn.GetLayerCount() );
+}
+
+TEST( SparseWeightsOptimizerTest, FullyConnected )
+{
+	const auto met = MathEngine().GetType();
+	if( met != MET_Cpu && met != MET_Cuda ) {
+		NEOML_HILIGHT( GTEST_LOG_( INFO ) ) << "Skipped rest of test for MathEngine type=" << met << " because no implementation.\n";
+		// MultiplyMatrixBySparseWeightsWithEpilogue
+		return;
+	}
+
+	CRandom random( 0x2a1 );
+	for( bool residual : { false, true } ) {
+		CDnn dnn( random, MathEngine() );
+		CSourceLayer* data = Source( dnn, "data" );
+		CFullyConnectedLayer* fc = FullyConnected( 40 )( "fc", data );
+		CBaseLayer* lastLayer = Sigmoid()( "sigmoid", fc );
+		if( residual ) {
+			lastLayer = Sum()( "residual", lastLayer, data );
+		}
+		// Without activation
+		CFullyConnectedLayer* secondFc = FullyConnected( 17, true )( "secondFc", lastLayer );
+		CSinkLayer* sink = Sink( secondFc, "sink" );
+
+		data->SetBlob( sparseWeightsData( random, 1, 1, 40 ) );
+		dnn.RunOnce();
+		fc->SetWeightsData( pruneWeights( fc->GetWeightsData(), random, 0.9f ) );
+		fc->SetFreeTermData( pruneWeights( fc->GetFreeTermData(), random, 0.f ) );
+		secondFc->SetWeightsData( pruneWeights( secondFc->GetWeightsData(), random, 0.95f ) );
+
+		checkSparseWeights( dnn, sink, CDnnOptimizationSettings(), 0, 2 );
+		EXPECT_EQ( 4, dnn.GetLayerCount() );
+	}
+}
+
+TEST( SparseWeightsOptimizerTest, Threshold )
+{
+	CRandom random( 0x2a1 );
+	CDnn dnn( random, MathEngine() );
+	CSourceLayer* data = Source( dnn, "data" );
+	CFullyConnectedLayer* fc = FullyConnected( 16 )( "fc", data );
+	Sink( fc, "sink" );
+
+	data->SetBlob( sparseWeightsData( random, 3, 3, 8 ) );
+	dnn.RunOnce();
+	fc->SetWeightsData( pruneWeights( fc->GetWeightsData(), random, 0.5f ) );
+	EXPECT_NEAR( 0.5f, GetBlobSparsity( *fc->GetWeightsData() ), 0.1f );
+
+	// The weights aren't sparse enough for the default settings
+	CDnnOptimizationReport report = OptimizeDnn( dnn );
+	EXPECT_EQ( 0, report.SparseFullyConnectedLayers );
+
+	// The optimization is turned off
+	CDnnOptimizationSettings settings;
+	settings.MinSparseWeightsSparsity = 1.1f;
+	report = OptimizeDnn( dnn, settings );
+	EXPECT_EQ( 0, report.SparseFullyConnectedLayers );
+
+	settings.MinSparseWeightsSparsity = 0.4f;
+	report = OptimizeDnn( dnn, settings );
+	EXPECT_EQ( 1, report.SparseFullyConnectedLayers );
+}
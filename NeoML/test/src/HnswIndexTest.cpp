@@ -0,0 +1,190 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#include <common.h>
+#pragma hdrstop
+
+#include <TestFixture.h>
+
+using namespace NeoML;
+using namespace NeoMLTest;
+
+namespace NeoMLTest {
+
+// Generates dense data grouped around a few random centers
+static void generateHnswData( int vectorCount, int featureCount, int seed, CArray<float>& values,
+	CArray<int>& pointers, CFloatMatrixDesc& desc )
+{
+	CRandom random( seed );
+	const int centerCount = 10;
+	CArray<float> centers;
+	for( int i = 0; i < centerCount * featureCount; ++i ) {
+		centers.Add( static_cast<float>( random.Uniform( -5, 5 ) ) );
+	}
+
+	values.SetSize( vectorCount * featureCount );
+	pointers.SetSize( vectorCount + 1 );
+	for( int i = 0; i < vectorCount; ++i ) {
+		const int center = random.UniformInt( 0, centerCount - 1 );
+		for( int j = 0; j < featureCount; ++j ) {
+			values[i * featureCount + j] = centers[center * featureCount + j] + static_cast<float>( random.Normal( 0, 1 ) );
+		}
+		pointers[i] = i * featureCount;
+	}
+	pointers[vectorCount] = vectorCount * featureCount;
+
+	desc.Height = vectorCount;
+	desc.Width = featureCount;
+	desc.Values = values.GetPtr();
+	desc.PointerB = pointers.GetPtr();
+	desc.PointerE = pointers.GetPtr() + 1;
+}
+
+// Calculates the share of the exact k nearest neighbors found by the index
+static double calcHnswRecall( const CFloatMatrixDesc& data, const CFloatMatrixDesc& queries, int k,
+	const CArray<CArray<CNearestNeighbor>>& found )
+{
+	int hitCount = 0;
+	for( int q = 0; q < queries.Height; ++q ) {
+		const CFloatVectorDesc query = queries.GetRow( q );
+		CArray<CNearestNeighbor> exact;
+		for( int i = 0; i < data.Height; ++i ) {
+			const CFloatVectorDesc row = data.GetRow( i );
+			float distance = 0;
+			for( int j = 0; j < data.Width; ++j ) {
+				distance += ( row.Values[j] - query.Values[j] ) * ( row.Values[j] - query.Values[j] );
+			}
+			exact.Add( CNearestNeighbor( i, distance ) );
+		}
+		exact.QuickSort<AscendingByMember<CNearestNeighbor, float, &CNearestNeighbor::Distance>>();
+
+		for( int i = 0; i < found[q].Size(); ++i ) {
+			for( int j = 0; j < k; ++j ) {
+				if( exact[j].Index == found[q][i].Index ) {
+					++hitCount;
+					break;
+				}
+			}
+		}
+	}
+	return static_cast<double>( hitCount ) / ( queries.Height * k );
+}
+
+} // namespace NeoMLTest
+
+//---------------------------------------------------------------------------------------------------------------------
+
+TEST( CHnswIndexTest, Recall )
+{
+	CArray<float> values;
+	CArray<int> pointers;
+	CFloatMatrixDesc data;
+	generateHnswData( 2000, 16, 0x1234, values, pointers, data );
+
+	CArray<float> queryValues;
+	CArray<int> queryPointers;
+	CFloatMatrixDesc queries;
+	generateHnswData( 100, 16, 0x4321, queryValues, queryPointers, queries );
+
+	const int k = 10;
+	for( int threadCount : { 1, 4 } ) {
+		CHnswIndex::CParam params;
+		params.ThreadCount = threadCount;
+		CHnswIndex index( params );
+		index.Build( data );
+		EXPECT_EQ( data.Height, index.GetVectorCount() );
+
+		CArray<CArray<CNearestNeighbor>> found;
+		index.Search( queries, k, found );
+		ASSERT_EQ( queries.Height, found.Size() );
+		for( int q = 0; q < found.Size(); ++q ) {
+			ASSERT_EQ( k, found[q].Size() );
+			for( int i = 1; i < k; ++i ) {
+				EXPECT_LE( found[q][i - 1].Distance, found[q][i].Distance );
+			}
+		}
+		EXPECT_GE( calcHnswRecall( data, queries, k, found ), 0.95 );
+
+		// The single query gives the same result as the batch
+		CArray<CNearestNeighbor> single;
+		index.Search( queries.GetRow( 0 ), k, single );
+		ASSERT_EQ( k, single.Size() );
+		for( int i = 0; i < k; ++i ) {
+			EXPECT_EQ( found[0][i].Index, single[i].Index );
+		}
+	}
+}
+
+TEST( CHnswIndexTest, Cosine )
+{
+	CArray<float> values;
+	CArray<int> pointers;
+	CFloatMatrixDesc data;
+	generateHnswData( 500, 8, 0x5678, values, pointers, data );
+
+	CHnswIndex::CParam params;
+	params.DistanceFunc = DF_Cosine;
+	CHnswIndex index( params );
+	index.Build( data );
+
+	// Every vector is the closest to itself
+	for( int i = 0; i < data.Height; i += 50 ) {
+		CArray<CNearestNeighbor> found;
+		index.Search( data.GetRow( i ), 1, found );
+		ASSERT_EQ( 1, found.Size() );
+		EXPECT_NEAR( 0.f, found[0].Distance, 1e-5f );
+	}
+}
+
+TEST( CHnswIndexTest, Serialization )
+{
+	CArray<float> values;
+	CArray<int> pointers;
+	CFloatMatrixDesc data;
+	generateHnswData( 500, 8, 0x9abc, values, pointers, data );
+
+	CHnswIndex index;
+	index.Build( data );
+
+	CMemoryFile file;
+	{
+		CArchive archive( &file, CArchive::SD_Storing );
+		index.Serialize( archive );
+	}
+	file.SeekToBegin();
+	CHnswIndex loaded;
+	{
+		CArchive archive( &file, CArchive::SD_Loading );
+		loaded.Serialize( archive );
+	}
+	EXPECT_EQ( index.GetVectorCount(), loaded.GetVectorCount() );
+	EXPECT_EQ( index.GetFeaturesCount(), loaded.GetFeaturesCount() );
+
+	CPtr<CDnnBlob> queries = CDnnBlob::CreateDataBlob( MathEngine(), CT_Float, 1, 20, data.Width );
+	queries->CopyFrom( data.Values );
+	CArray<CArray<CNearestNeighbor>> expected;
+	index.Search( *queries, 5, expected );
+	CArray<CArray<CNearestNeighbor>> actual;
+	loaded.Search( *queries, 5, actual );
+	ASSERT_EQ( expected.Size(), actual.Size() );
+	for( int q = 0; q < expected.Size(); ++q ) {
+		ASSERT_EQ( expected[q].Size(), actual[q].Size() );
+		for( int i = 0; i < expected[q].Size(); ++i ) {
+			EXPECT_EQ( expected[q][i].Index, actual[q][i].Index );
+			EXPECT_EQ( expected[q][i].Distance, actual[q][i].Distance );
+		}
+		EXPECT_EQ( q, expected[q][0].Index );
+	}
+}
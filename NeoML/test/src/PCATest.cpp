@@ -294,5 +294,209 @@ TEST( CPCATest, PCASerializationTest )
 	ASSERT_NEAR( expectedNoiseVariance, pcaSerialized->GetNoiseVariance(), 5e-3 );
 }
 
+// Reads the rows of the matrix by chunks of the given size
+class CMatrixChunkSource : public IFloatMatrixChunkSource {
+public:
+	CMatrixChunkSource( const CFloatMatrixDesc& _matrix, int _chunkSize ) :
+		matrix( _matrix ), chunkSize( _chunkSize ), position( 0 ) {}
+
+	int GetWidth() const override { return matrix.Width; }
+	bool GetNextChunk( CFloatMatrixDesc& chunk ) override
+	{
+		if( position >= matrix.Height ) {
+			return false;
+		}
+		chunk = matrix;
+		chunk.Height = min( chunkSize, matrix.Height - position );
+		chunk.PointerB = matrix.PointerB + position;
+		chunk.PointerE = matrix.PointerE + position;
+		position += chunk.Height;
+		return true;
+	}
+
+private:
+	const CFloatMatrixDesc matrix;
+	const int chunkSize;
+	int position;
+};
+
+// The dense descriptor of the row-major matrix
+static CFloatMatrixDesc getDenseDesc( int samples, int features, CArray<float>& values, CArray<int>& pointers )
+{
+	pointers.Empty();
+	for( int i = 0; i <= samples; i++ ) {
+		pointers.Add( i * features );
+	}
+	CFloatMatrixDesc desc;
+	desc.Height = samples;
+	desc.Width = features;
+	desc.Values = values.GetPtr();
+	desc.PointerB = pointers.GetPtr();
+	desc.PointerE = pointers.GetPtr() + 1;
+	return desc;
+}
+
+TEST( CSVDTest, StreamingRandomizedSVDTest )
+{
+	std::unique_ptr<IMathEngine> mathEngine( CreateCpuMathEngine( /*memoryLimit*/0u ) );
+	CArray<float> data = { 1.8f, 1.3f, 8.0f, 8.5f, 9.6f, 5.4f, 0.0f, 2.6f, 1.8f, 3.2f, 6.1f, 6.4f, 9.2f, 1.3f, 6.5f };
+	const CSparseFloatMatrix matrix = generateMatrix( 3, 5, data );
+	const CArray<float> expectedSingularValues = { 20.4914f, 7.3685f };
+	const CArray<float> expectedRightVectors = { 0.3315f, 0.2487f, 0.6033f, 0.3571f, 0.5802f,
+		-0.5150f, -0.4721f, -0.1468f, 0.6558f, 0.2456f };
+	CArray<int> pointers;
+	const CFloatMatrixDesc dense = getDenseDesc( 3, 5, data, pointers );
+
+	for( int chunkSize : { 1, 2, 3 } ) {
+		for( const CFloatMatrixDesc& desc : { matrix.GetDesc(), dense } ) {
+			CMatrixChunkSource source( desc, chunkSize );
+			CArray<float> singularValues;
+			CArray<float> rightVectors;
+			RandomizedSingularValueDecomposition( source, *mathEngine, singularValues, rightVectors, 2 );
+			ASSERT_EQ( 2, singularValues.Size() );
+			ASSERT_EQ( 10, rightVectors.Size() );
+			checkArraysEqual( expectedSingularValues, singularValues.GetPtr() );
+			checkArraysEqual( expectedRightVectors, rightVectors.GetPtr() );
+		}
+	}
+}
+
+static void incrementalPcaTestExample( int samples, int features, int components, CArray<float> data,
+	CArray<float> expectedSingularValues, CArray<float> expectedVariance, CArray<float> expectedVarianceRatio,
+	float expectedNoiseVariance, CArray<float> expectedComponents, CArray<float> expectedTransform )
+{
+	std::unique_ptr<IMathEngine> mathEngine( CreateCpuMathEngine( /*memoryLimit*/0u ) );
+	CIncrementalPca::CParams params;
+	params.Components = components;
+
+	const CSparseFloatMatrix matrix = generateMatrix( samples, features, data );
+	CArray<int> pointers;
+	const CFloatMatrixDesc dense = getDenseDesc( samples, features, data, pointers );
+	for( int chunkSize = 1; chunkSize <= samples; chunkSize++ ) {
+		for( const CFloatMatrixDesc& desc : { matrix.GetDesc(), dense } ) {
+			CIncrementalPca pca( params, *mathEngine );
+			CMatrixChunkSource source( desc, chunkSize );
+			pca.Fit( source );
+			ASSERT_EQ( samples, pca.GetVectorCount() );
+
+			const CFloatMatrixDesc transformed = pca.Transform( desc );
+			ASSERT_EQ( samples, transformed.Height );
+			ASSERT_EQ( components, transformed.Width );
+			checkArraysEqual( expectedTransform, transformed.Values );
+
+			CSparseFloatMatrix componentsMatrix = pca.GetComponents();
+			ASSERT_EQ( components, componentsMatrix.GetHeight() );
+			ASSERT_EQ( features, componentsMatrix.GetWidth() );
+			checkArraysEqual( expectedComponents, componentsMatrix.GetDesc().Values );
+
+			ASSERT_EQ( components, pca.GetSingularValues().Size() );
+			checkArraysEqual( expectedSingularValues, pca.GetSingularValues().GetPtr() );
+			checkArraysEqual( expectedVariance, pca.GetExplainedVariance().GetPtr() );
+			checkArraysEqual( expectedVarianceRatio, pca.GetExplainedVarianceRatio().GetPtr() );
+			ASSERT_NEAR( expectedNoiseVariance, pca.GetNoiseVariance(), 5e-3 );
+		}
+	}
+}
+
+TEST( CPCATest, IncrementalPCAExamplesTest )
+{
+	// The sketch is exact if the number of features is not greater than components + oversamples
+	incrementalPcaTestExample( 4, 4, 2, { 2, 1, 3, 2, 2, 4, 4, 1, 2, 4, 1, 1, 4, 4, 3, 4 },
+		{ 3.0407f, 2.6677f }, { 3.0819f, 2.3722f }, { 0.451f, 0.3472f }, 0.6896f,
+		{ 0.5649f, 0.2846f, 0.1827f, 0.7525f, -0.0238f, -0.8853f, 0.3850f, 0.2592f },
+		{ -0.8772f, 2.1003f, -0.5931f, -0.4300f, -1.1413f, -1.5853f, 2.6118f, -0.0849f } );
+
+	incrementalPcaTestExample( 3, 5, 2, { 5, 4, 7, 5, 3, 5, 7, 8, 6, 7, 6, 4, 4, 6, 2 },
+		{ 5.1339f, 1.9084f }, { 13.1789f, 1.8210f }, { 0.8786f, 0.1214f }, 0,
+		{ -0.1196f, 0.4516f, 0.5095f, 0.0309f, 0.7218f, -0.2818f, -0.4135f, 0.7076f, -0.4196f, -0.2695f },
+		{ -0.8146f, 1.5285f, 3.9683f, -0.5020f, -3.1537f, -1.0265f } );
+
+	incrementalPcaTestExample( 5, 3, 3, { 4, 4, 8, 4, 5, 8, 5, 6, 8, 7, 5, 4, 2, 3, 3 },
+		{ 5.2416f, 3.8275f, 1.0369f }, { 6.8686f, 3.6624954f, 0.2688f }, { 0.6359f, 0.3391f, 0.0248f }, 0,
+		{ -0.2345f, -0.3243f, -0.9164f, 0.8866f, 0.3150f, -0.3384f, 0.3984f, -0.8919f, 0.2137f },
+		{ -1.3611f, -1.1528f, 0.7605f, -1.6854f, -0.8378f, -0.1314f, -2.2443f, 0.3639f, -0.6249f,
+		  1.2766f, 3.1759f, 0.2090f, 4.0142f, -1.5491f, -0.2131f } );
+}
+
+TEST( CPCATest, IncrementalPCASparseTest )
+{
+	// Three principal axes on the disjoint groups of features, the last features are always zero
+	const int samples = 3000;
+	const int features = 50;
+	const int groupSize = 10;
+	const float deviations[] = { 10.f, 5.f, 2.f };
+	CRandom random( 0x4a5b );
+	CSparseFloatMatrix matrix( features );
+	for( int i = 0; i < samples; i++ ) {
+		CSparseFloatVector row;
+		for( int group = 0; group < 3; group++ ) {
+			const double value = random.Normal( 0., deviations[group] ) / sqrt( static_cast<double>( groupSize ) );
+			for( int j = group * groupSize; j < ( group + 1 ) * groupSize; j++ ) {
+				row.SetAt( j, static_cast<float>( 3. + value + random.Normal( 0., 0.01 ) ) );
+			}
+		}
+		matrix.AddRow( row );
+	}
+
+	std::unique_ptr<IMathEngine> mathEngine( CreateCpuMathEngine( /*memoryLimit*/0u ) );
+	CIncrementalPca::CParams params;
+	params.Components = 3;
+	CIncrementalPca pca( params, *mathEngine );
+	CIncrementalPca continuedPca( params, *mathEngine );
+	const int chunkSize = 256;
+	CMatrixChunkSource source( matrix.GetDesc(), chunkSize );
+	CFloatMatrixDesc chunk;
+	for( int i = 0; source.GetNextChunk( chunk ); i++ ) {
+		pca.PartialFit( chunk );
+		if( i == 2 ) {
+			// The intermediate results don't affect the training
+			ASSERT_EQ( 3, pca.GetComponentsNum() );
+		} else if( i == 5 ) {
+			// The training is continued after serialization
+			CMemoryFile file;
+			{
+				CArchive archive( &file, CArchive::SD_Storing );
+				pca.Serialize( archive );
+			}
+			file.SeekToBegin();
+			CArchive archive( &file, CArchive::SD_Loading );
+			continuedPca.Serialize( archive );
+		} else if( i > 5 ) {
+			continuedPca.PartialFit( chunk );
+		}
+	}
+
+	ASSERT_EQ( samples, pca.GetVectorCount() );
+	ASSERT_EQ( samples, continuedPca.GetVectorCount() );
+	ASSERT_EQ( 3, pca.GetComponentsNum() );
+	const CSparseFloatMatrix components = pca.GetComponents();
+	for( int group = 0; group < 3; group++ ) {
+		const CFloatVectorDesc component = components.GetRow( group );
+		for( int j = 0; j < features; j++ ) {
+			const float expected = j / groupSize == group ? 1.f / sqrtf( static_cast<float>( groupSize ) ) : 0.f;
+			EXPECT_NEAR( expected, fabsf( GetValue( component, j ) ), 1e-2 );
+		}
+		const float variance = deviations[group] * deviations[group];
+		EXPECT_NEAR( variance, pca.GetExplainedVariance()[group], 0.1 * variance );
+		EXPECT_NEAR( 3.f, pca.GetMean()[group * groupSize], 0.5f );
+		EXPECT_EQ( pca.GetSingularValues()[group], continuedPca.GetSingularValues()[group] );
+	}
+	EXPECT_NEAR( 1.f, pca.GetExplainedVarianceRatio()[0] + pca.GetExplainedVarianceRatio()[1]
+		+ pca.GetExplainedVarianceRatio()[2], 1e-3 );
+	EXPECT_NEAR( 0.f, pca.GetNoiseVariance(), 1e-3 );
+
+	// The transformed data has the explained variance
+	const CFloatMatrixDesc transformed = pca.Transform( matrix.GetDesc() );
+	ASSERT_EQ( samples, transformed.Height );
+	for( int group = 0; group < 3; group++ ) {
+		double squaredSum = 0;
+		for( int i = 0; i < samples; i++ ) {
+			const float value = GetValue( transformed.GetRow( i ), group );
+			squaredSum += value * value;
+		}
+		EXPECT_NEAR( pca.GetExplainedVariance()[group], squaredSum / ( samples - 1 ), 1e-2 * pca.GetExplainedVariance()[group] );
+	}
+}
+
 #endif //FINE_ARCHITECTURE( FINE_X86 ) || FINE_ARCHITECTURE( FINE_X64 )
 
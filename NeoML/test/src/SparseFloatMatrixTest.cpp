@@ -348,3 +348,161 @@ TEST_F( CSparseFloatMatrixTest, ZeroElemsSerialization )
 	testSparseFloatMatrixSerialization( original );
 }
 
+
+//---------------------------------------------------------------------------------------------------------------------
+
+// Checks that the compact matrix stores the same rows with the value error not greater than the tolerance
+static void compareCompactSparseFloatMatrix( const CSparseFloatMatrix& expected, const CCompactSparseFloatMatrix& actual,
+	float tolerance )
+{
+	ASSERT_EQ( expected.GetHeight(), actual.GetHeight() );
+	ASSERT_EQ( expected.GetWidth(), actual.GetWidth() );
+	CSparseFloatVector actualRow;
+	for( int rowIndex = 0; rowIndex < expected.GetHeight(); ++rowIndex ) {
+		CFloatVectorDesc expectedRow = expected.GetRow( rowIndex );
+		float rowTolerance = 0;
+		for( int elemIndex = 0; elemIndex < expectedRow.Size; ++elemIndex ) {
+			rowTolerance = max( rowTolerance, tolerance * fabsf( expectedRow.Values[elemIndex] ) );
+		}
+
+		int elemIndex = 0;
+		for( CCompactSparseFloatMatrix::CRowIterator it = actual.GetRowIterator( rowIndex ); it.IsValid(); it.Next() ) {
+			ASSERT_LT( elemIndex, expectedRow.Size );
+			ASSERT_EQ( expectedRow.Indexes[elemIndex], it.GetIndex() );
+			ASSERT_NEAR( expectedRow.Values[elemIndex], it.GetValue(), rowTolerance );
+			elemIndex++;
+		}
+		ASSERT_EQ( expectedRow.Size, elemIndex );
+
+		actual.GetRow( rowIndex, actualRow );
+		ASSERT_EQ( expectedRow.Size, actualRow.NumberOfElements() );
+		for( elemIndex = 0; elemIndex < expectedRow.Size; ++elemIndex ) {
+			ASSERT_EQ( expectedRow.Indexes[elemIndex], actualRow.GetDesc().Indexes[elemIndex] );
+			ASSERT_NEAR( expectedRow.Values[elemIndex], actualRow.GetDesc().Values[elemIndex], rowTolerance );
+		}
+	}
+}
+
+TEST_F( CSparseFloatMatrixTest, CompactAddRows )
+{
+	const int h = 200;
+	const int w = 300;
+	CRandom rand( 0 );
+	CSparseFloatMatrix original( w );
+	for( int i = 0; i < h; ++i ) {
+		original.AddRow( generateRandomVector( rand, w ) );
+	}
+	original.AddRow( CFloatVectorDesc::Empty );
+
+	// The tolerances are relative to the maximum absolute value of the row
+	const float tolerances[CVT_Count] = { 0.f, 1.f / 1024, 1.f / 255 };
+	for( int type = 0; type < CVT_Count; ++type ) {
+		CCompactSparseFloatMatrix fromRows( static_cast<TCompactValueType>( type ) );
+		for( int i = 0; i < original.GetHeight(); ++i ) {
+			fromRows.AddRow( original.GetRow( i ) );
+		}
+		compareCompactSparseFloatMatrix( original, fromRows, tolerances[type] );
+
+		CCompactSparseFloatMatrix fromDesc( original.GetDesc(), static_cast<TCompactValueType>( type ) );
+		compareCompactSparseFloatMatrix( original, fromDesc, tolerances[type] );
+		EXPECT_EQ( fromRows.GetDataSize(), fromDesc.GetDataSize() );
+		EXPECT_LT( fromDesc.GetDataSize(), static_cast<size_t>( original.GetDesc().PointerE[h] * 2 * sizeof( float ) ) );
+
+		CSparseFloatMatrix decoded;
+		fromDesc.GetRows( 10, 50, decoded );
+		ASSERT_EQ( 50, decoded.GetHeight() );
+		for( int i = 0; i < decoded.GetHeight(); ++i ) {
+			CFloatVectorDesc expectedRow = original.GetRow( 10 + i );
+			CFloatVectorDesc actualRow = decoded.GetRow( i );
+			ASSERT_EQ( expectedRow.Size, actualRow.Size );
+			if( type == CVT_Float ) {
+				for( int j = 0; j < expectedRow.Size; ++j ) {
+					ASSERT_EQ( expectedRow.Values[j], actualRow.Values[j] );
+				}
+			}
+		}
+	}
+}
+
+TEST_F( CSparseFloatMatrixTest, CompactDenseAndWideRows )
+{
+	// The dense rows skip zeros, the sparse rows span several blocks of columns
+	const float dense[] = { 0.f, 1.5f, 0.f, -2.f, 1e-6f, 65504.f, 0.f };
+	CFloatVectorDesc denseDesc;
+	denseDesc.Size = 7;
+	denseDesc.Values = const_cast<float*>( dense );
+
+	CSparseFloatVector wide;
+	wide.SetAt( 3, 1.f );
+	wide.SetAt( 65535, 2.f );
+	wide.SetAt( 65536, 3.f );
+	wide.SetAt( 200000, 4.f );
+	wide.SetAt( 1000000, -5.f );
+
+	CSparseFloatMatrix expected;
+	expected.AddRow( denseDesc );
+	expected.AddRow( wide );
+
+	for( int type = 0; type < CVT_Count; ++type ) {
+		CCompactSparseFloatMatrix matrix( static_cast<TCompactValueType>( type ) );
+		matrix.AddRow( denseDesc );
+		matrix.AddRow( wide );
+		ASSERT_EQ( 1000001, matrix.GetWidth() );
+		ASSERT_EQ( 9, matrix.GetElementCount() );
+		compareCompactSparseFloatMatrix( expected, matrix, type == CVT_Byte ? 1.f / 255 : 1.f / 1024 );
+	}
+
+	// The half values are rounded to the nearest even and keep the special values
+	CSparseFloatVector special;
+	special.SetAt( 0, 1.f + 1.f / 2048 );
+	special.SetAt( 1, 1.f + 3.f / 2048 );
+	special.SetAt( 2, 1e9f );
+	special.SetAt( 3, -6e-8f );
+	CCompactSparseFloatMatrix halfMatrix( CVT_Half );
+	halfMatrix.AddRow( special );
+	CCompactSparseFloatMatrix::CRowIterator it = halfMatrix.GetRowIterator( 0 );
+	EXPECT_EQ( 1.f, it.GetValue() );
+	it.Next();
+	EXPECT_EQ( 1.f + 2.f / 1024, it.GetValue() );
+	it.Next();
+	EXPECT_TRUE( std::isinf( it.GetValue() ) );
+	it.Next();
+	EXPECT_EQ( -5.9604644775390625e-8f, it.GetValue() );
+}
+
+TEST_F( CSparseFloatMatrixTest, CompactSerialization )
+{
+	CRandom rand( 0 );
+	for( int type = 0; type < CVT_Count; ++type ) {
+		CCompactSparseFloatMatrix original( static_cast<TCompactValueType>( type ) );
+		for( int i = 0; i < 20; ++i ) {
+			original.AddRow( generateRandomVector( rand, 100 ) );
+		}
+
+		CMemoryFile memoryFile;
+		{
+			CArchive archive( &memoryFile, CArchive::store );
+			archive << original;
+		}
+		memoryFile.Seek( 0, CBaseFile::begin );
+		CCompactSparseFloatMatrix loaded;
+		{
+			CArchive archive( &memoryFile, CArchive::load );
+			archive >> loaded;
+		}
+
+		ASSERT_EQ( original.GetValueType(), loaded.GetValueType() );
+		ASSERT_EQ( original.GetHeight(), loaded.GetHeight() );
+		ASSERT_EQ( original.GetWidth(), loaded.GetWidth() );
+		for( int i = 0; i < original.GetHeight(); ++i ) {
+			CCompactSparseFloatMatrix::CRowIterator expectedIt = original.GetRowIterator( i );
+			CCompactSparseFloatMatrix::CRowIterator actualIt = loaded.GetRowIterator( i );
+			for( ; expectedIt.IsValid(); expectedIt.Next(), actualIt.Next() ) {
+				ASSERT_TRUE( actualIt.IsValid() );
+				ASSERT_EQ( expectedIt.GetIndex(), actualIt.GetIndex() );
+				ASSERT_EQ( expectedIt.GetValue(), actualIt.GetValue() );
+			}
+			ASSERT_FALSE( actualIt.IsValid() );
+		}
+	}
+}
@@ -84,13 +84,15 @@ struct NEOMATHENGINE_API CPowerActivationParam final {
 
 // Parameters of GELU activation
 struct NEOMATHENGINE_API CGELUActivationParam final {
-	// CDF can be calculated using the error function (slow) or using an approximation.
-	// The approximate method is used by default.
+	// CDF can be calculated using the error function (slow) or using one of the approximations.
+	// The sigmoid approximation is used by default.
 	enum class TCalculationMode {
 		// x * 0.5( 1 + erf( x / sqrt(2) ) )
 		CM_Precise,
 		// x * sigmoid(1.702x)
 		CM_SigmoidApproximate,
+		// x * 0.5( 1 + tanh( sqrt(2/pi)( x + 0.044715x^3 ) ) )
+		CM_TanhApproximate,
 
 		CM_Count
 	};
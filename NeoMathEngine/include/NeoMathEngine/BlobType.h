@@ -15,6 +15,9 @@ limitations under the License.
 
 #pragma once
 
+#include <cstdint>
+#include <cstring>
+
 namespace NeoML {
 
 // MathEngine blob data types
@@ -22,6 +25,27 @@ enum TBlobType {
 	CT_Invalid = 0,
 	CT_Float,
 	CT_Int,
+	CT_Float16, // IEEE 754 half precision float, storage only
+	CT_BFloat16, // bfloat16 (the upper half of the float), storage only
+};
+
+// 16-bit float types are used only for storing the data (e.g. the weights of the layers)
+// All the calculations are performed in float, the conversion from float is rounded to the nearest even
+
+// IEEE 754 half precision float: 1 sign bit, 5 exponent bits, 10 mantissa bits
+struct CFloat16 {
+	uint16_t Bits;
+
+	static CFloat16 FromFloat( float value );
+	float ToFloat() const;
+};
+
+// bfloat16: 1 sign bit, 8 exponent bits, 7 mantissa bits
+struct CBFloat16 {
+	uint16_t Bits;
+
+	static CBFloat16 FromFloat( float value );
+	float ToFloat() const;
 };
 
 // Data types used in MathEngine
@@ -72,4 +96,131 @@ struct CBlobType<const int> {
 	static TBlobType GetType() { return CT_Int; }
 };
 
+// The 16-bit float data types description
+template<>
+struct CBlobType<CFloat16> {
+	// typedef for the base data type used in Math Engine
+	typedef CFloat16 TDataType;
+
+	// Gets the blob data type
+	static TBlobType GetType() { return CT_Float16; }
+};
+
+template<>
+struct CBlobType<const CFloat16> {
+	// typedef for the base data type used in Math Engine
+	typedef CFloat16 TDataType;
+
+	// Gets the blob data type
+	static TBlobType GetType() { return CT_Float16; }
+};
+
+template<>
+struct CBlobType<CBFloat16> {
+	// typedef for the base data type used in Math Engine
+	typedef CBFloat16 TDataType;
+
+	// Gets the blob data type
+	static TBlobType GetType() { return CT_BFloat16; }
+};
+
+template<>
+struct CBlobType<const CBFloat16> {
+	// typedef for the base data type used in Math Engine
+	typedef CBFloat16 TDataType;
+
+	// Gets the blob data type
+	static TBlobType GetType() { return CT_BFloat16; }
+};
+
+//------------------------------------------------------------------------------------------------------------
+
+inline CFloat16 CFloat16::FromFloat( float value )
+{
+	uint32_t bits = 0;
+	::memcpy( &bits, &value, sizeof( bits ) );
+	const uint16_t sign = static_cast<uint16_t>( ( bits >> 16 ) & 0x8000 );
+	bits &= 0x7fffffff;
+
+	CFloat16 result;
+	if( bits >= 0x7f800000 ) {
+		// Infinity or NaN
+		result.Bits = sign | 0x7c00 | ( bits > 0x7f800000 ? 0x200 : 0 );
+	} else if( bits >= 0x477ff000 ) {
+		// Rounds to infinity
+		result.Bits = sign | 0x7c00;
+	} else if( bits < 0x33000000 ) {
+		// Rounds to zero
+		result.Bits = sign;
+	} else if( bits < 0x38800000 ) {
+		// Subnormal half
+		const int shift = 126 - static_cast<int>( bits >> 23 );
+		const uint32_t mantissa = ( bits & 0x7fffff ) | 0x800000;
+		uint32_t half = mantissa >> shift;
+		const uint32_t remainder = mantissa & ( ( 1u << shift ) - 1 );
+		const uint32_t halfway = 1u << ( shift - 1 );
+		if( remainder > halfway || ( remainder == halfway && ( half & 1 ) != 0 ) ) {
+			half++;
+		}
+		result.Bits = sign | static_cast<uint16_t>( half );
+	} else {
+		// The carry of the rounding correctly moves into the exponent
+		uint32_t half = ( bits - 0x38000000 ) >> 13;
+		const uint32_t remainder = bits & 0x1fff;
+		if( remainder > 0x1000 || ( remainder == 0x1000 && ( half & 1 ) != 0 ) ) {
+			half++;
+		}
+		result.Bits = sign | static_cast<uint16_t>( half );
+	}
+	return result;
+}
+
+inline float CFloat16::ToFloat() const
+{
+	const uint32_t sign = static_cast<uint32_t>( Bits & 0x8000 ) << 16;
+	const uint32_t exponent = ( Bits >> 10 ) & 0x1f;
+	const uint32_t mantissa = Bits & 0x3ff;
+
+	uint32_t bits = 0;
+	if( exponent == 0 ) {
+		if( mantissa != 0 ) {
+			// Subnormal half is mantissa * 2^-24
+			const float result = mantissa * 5.9604644775390625e-8f;
+			return sign == 0 ? result : -result;
+		}
+		bits = sign;
+	} else if( exponent == 0x1f ) {
+		bits = sign | 0x7f800000 | ( mantissa << 13 );
+	} else {
+		bits = sign | ( ( exponent + 112 ) << 23 ) | ( mantissa << 13 );
+	}
+	float result = 0;
+	::memcpy( &result, &bits, sizeof( result ) );
+	return result;
+}
+
+inline CBFloat16 CBFloat16::FromFloat( float value )
+{
+	uint32_t bits = 0;
+	::memcpy( &bits, &value, sizeof( bits ) );
+
+	CBFloat16 result;
+	if( ( bits & 0x7fffffff ) > 0x7f800000 ) {
+		// NaN stays quiet NaN
+		result.Bits = static_cast<uint16_t>( ( bits >> 16 ) | 0x40 );
+	} else {
+		// The carry of the rounding correctly moves into the exponent (up to infinity)
+		result.Bits = static_cast<uint16_t>( ( bits + 0x7fff + ( ( bits >> 16 ) & 1 ) ) >> 16 );
+	}
+	return result;
+}
+
+inline float CBFloat16::ToFloat() const
+{
+	const uint32_t bits = static_cast<uint32_t>( Bits ) << 16;
+	float result = 0;
+	::memcpy( &result, &bits, sizeof( result ) );
+	return result;
+}
+
 } // namespace NeoML
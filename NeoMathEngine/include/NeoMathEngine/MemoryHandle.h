@@ -23,6 +23,8 @@ namespace NeoML {
 
 class IMathEngine;
 class CMemoryHandleInternal;
+struct CFloat16;
+struct CBFloat16;
 
 // Wraps the pointer to memory allocated by a math engine
 // IMPORTANT: Do not use pointers to CMemoryHandle for children classes with fields, because of the non virtual dtor.
@@ -209,6 +211,12 @@ typedef CTypedMemoryHandle<const float> CConstFloatHandle;
 typedef CTypedMemoryHandle<int> CIntHandle;
 typedef CTypedMemoryHandle<const int> CConstIntHandle;
 
+typedef CTypedMemoryHandle<CFloat16> CFloat16Handle;
+typedef CTypedMemoryHandle<const CFloat16> CConstFloat16Handle;
+
+typedef CTypedMemoryHandle<CBFloat16> CBFloat16Handle;
+typedef CTypedMemoryHandle<const CBFloat16> CConstBFloat16Handle;
+
 typedef CMemoryHandleVar<float> CFloatHandleVar;
 typedef CMemoryHandleVar<int> CIntHandleVar;
 
@@ -72,6 +72,8 @@ public:
 	// Copying the second vector values into the first
 	virtual void VectorCopy(const CFloatHandle& first, const CConstFloatHandle& second, int vectorSize) = 0;
 	virtual void VectorCopy(const CIntHandle& first, const CConstIntHandle& second, int vectorSize) = 0;
+	virtual void VectorCopy(const CFloat16Handle& first, const CConstFloat16Handle& second, int vectorSize) = 0;
+	virtual void VectorCopy(const CBFloat16Handle& first, const CConstBFloat16Handle& second, int vectorSize) = 0;
 	// Broadcasting the copy to new shape
 	// additionalWidth = 1 means broadcasting from fromDesc to toDesc
 	// additionalWidth != 1 means broadcasting from (*fromDesc, additionalWidth) to (*toDesc, additionalWidth)
@@ -93,6 +95,11 @@ public:
 	// Converting data type
 	virtual void VectorConvert(const CConstFloatHandle& from, const CIntHandle& to, int vectorSize) = 0;
 	virtual void VectorConvert(const CConstIntHandle& from, const CFloatHandle& to, int vectorSize) = 0;
+	// Converting to and from the 16-bit float storage types (the float is rounded to the nearest even)
+	virtual void VectorConvert(const CConstFloatHandle& from, const CFloat16Handle& to, int vectorSize) = 0;
+	virtual void VectorConvert(const CConstFloat16Handle& from, const CFloatHandle& to, int vectorSize) = 0;
+	virtual void VectorConvert(const CConstFloatHandle& from, const CBFloat16Handle& to, int vectorSize) = 0;
+	virtual void VectorConvert(const CConstBFloat16Handle& from, const CFloatHandle& to, int vectorSize) = 0;
 
 	// Filling a vector using the Bernoulli distribution with p being the probability of 1
 	// The elements for which the distribution gives 1 are set to the specified value
@@ -164,6 +171,22 @@ public:
 	virtual void VectorHSwishDiff( const CConstFloatHandle& firstHandle, const CConstFloatHandle& secondHandle,
 		const CFloatHandle& resultHandle, int vectorSize ) = 0;
 
+	// GELU. f(x) = x * 0.5( 1 + erf( x / sqrt(2) ) ) or one of its approximations:
+	// x * sigmoid(1.702x) or x * 0.5( 1 + tanh( sqrt(2/pi)( x + 0.044715x^3 ) ) )
+	// The whole function is calculated in a single pass on CPU and CUDA, Vulkan and Metal use several vector operations
+	virtual void VectorGELU( const CConstFloatHandle& firstHandle, const CFloatHandle& resultHandle,
+		int vectorSize, CGELUActivationParam::TCalculationMode mode ) = 0;
+	// result = second * f'(first), where second is the output diff
+	virtual void VectorGELUDiff( const CConstFloatHandle& firstHandle, const CConstFloatHandle& secondHandle,
+		const CFloatHandle& resultHandle, int vectorSize, CGELUActivationParam::TCalculationMode mode ) = 0;
+
+	// SiLU (Swish with beta = 1). f(x) = x * sigmoid(x)
+	virtual void VectorSiLU( const CConstFloatHandle& firstHandle, const CFloatHandle& resultHandle,
+		int vectorSize ) = 0;
+	// result = second * f'(first), where second is the output diff
+	virtual void VectorSiLUDiff( const CConstFloatHandle& firstHandle, const CConstFloatHandle& secondHandle,
+		const CFloatHandle& resultHandle, int vectorSize ) = 0;
+
 	// max/min value
 	// result = max(first, second)
 	virtual void VectorEltwiseMax(const CConstFloatHandle& firstHandle,
@@ -533,6 +556,13 @@ public:
 	virtual void MultiplyMatrixByTransposedMatrix( int batchSize, const CConstFloatHandle& firstHandle, int firstHeight,
 		int firstWidth, const CConstFloatHandle& secondHandle, int secondHeight, const CFloatHandle& resultHandle,
 		int resultBufferSize ) = 0;
+	// Multiplies a matrix by another matrix, transposed, stored in 16-bit floats
+	// The second matrix is of secondHeight * firstWidth size, the result will be of firstHeight * secondHeight size
+	// The products are accumulated in float
+	virtual void MultiplyMatrixByTransposedMatrix( const CConstFloatHandle& firstHandle, int firstHeight,
+		int firstWidth, const CConstFloat16Handle& secondHandle, int secondHeight, const CFloatHandle& resultHandle ) = 0;
+	virtual void MultiplyMatrixByTransposedMatrix( const CConstFloatHandle& firstHandle, int firstHeight,
+		int firstWidth, const CConstBFloat16Handle& secondHandle, int secondHeight, const CFloatHandle& resultHandle ) = 0;
 
 	// Operations on sparse matrices
 
@@ -659,7 +689,9 @@ struct NEOMATHENGINE_API CGlobalMaxOverTimePoolingDesc : public CCrtAllocatedObj
 struct NEOMATHENGINE_API CMaxOverTimePoolingDesc : public CCrtAllocatedObject { public: virtual ~CMaxOverTimePoolingDesc(); };
 struct NEOMATHENGINE_API CLrnDesc : public CCrtAllocatedObject { public: virtual ~CLrnDesc(); };
 struct NEOMATHENGINE_API CLstmDesc : public CCrtAllocatedObject { public: virtual ~CLstmDesc(); };
+struct NEOMATHENGINE_API CGruDesc : public CCrtAllocatedObject { public: virtual ~CGruDesc(); };
 struct NEOMATHENGINE_API CRowwiseOperationDesc : public CCrtAllocatedObject { public: virtual ~CRowwiseOperationDesc(); };
+struct NEOMATHENGINE_API CSparseWeightsDesc : public CCrtAllocatedObject { public: virtual ~CSparseWeightsDesc(); };
 
 //------------------------------------------------------------------------------------------------------------
 // RLE format
@@ -748,6 +780,8 @@ public:
 
 	// Convolution
 	// The descriptor should be destroyed using the standard delete operator after use.
+	// The descriptor may keep the filter prepared for the chosen algorithm; it is reset by BlobConvolutionLearnAdd,
+	// otherwise the descriptor should be recreated when the filter changes.
 	virtual CConvolutionDesc* InitBlobConvolution( const CBlobDesc& input, int paddingHeight, int paddingWidth,
 		int strideHeight, int strideWidth, int dilationHeight, int dilationWidth, const CBlobDesc& filter,
 		const CBlobDesc& output ) = 0;
@@ -760,6 +794,35 @@ public:
 		const CConstFloatHandle& outputDiff, const CFloatHandle& filterDiff,
 		const CFloatHandle* freeTermDiff, bool isFreeTermDiffFromInput ) = 0;
 
+	// Convolution and fully-connected operations with the epilogue:
+	//     result = activation( operation( source ) + freeTerm ) + residual
+	// Where the kernel calculates the result by parts, the epilogue is applied to each part right after it (while it's in cache);
+	// otherwise (e.g. the matrix product on GEMM backends other than MLAS on CPU) it's applied as a separate pass over the result
+	// You can pass 0 for the freeTerm and residual parameters; the residual is of the result size
+	// Supported activations: Linear, ELU, ReLU, LeakyReLU, Sigmoid, Tanh, HardTanh, HardSigmoid, HSwish, GELU
+	virtual void BlobConvolutionWithEpilogue( const CConvolutionDesc& desc, const CConstFloatHandle& source,
+		const CConstFloatHandle& filter, const CConstFloatHandle* freeTerm, const CActivationDesc& activation,
+		const CConstFloatHandle* residual, const CFloatHandle& result ) = 0;
+	// The operation is first * T(second), the free term is added to each row of the result
+	virtual void MultiplyMatrixByTransposedMatrixWithEpilogue( const CConstFloatHandle& first, int firstHeight,
+		int firstWidth, const CConstFloatHandle& second, int secondHeight, const CConstFloatHandle* freeTerm,
+		const CActivationDesc& activation, const CConstFloatHandle* residual, const CFloatHandle& result ) = 0;
+
+	// Operations with the sparse (pruned) weights
+	// Creates the descriptor of the height * width weights matrix in which most of the elements are zeros
+	// Only the non-zero elements are kept, the descriptor doesn't refer to the weights after it's created
+	virtual CSparseWeightsDesc* InitSparseWeights( int height, int width, const CConstFloatHandle& weights ) = 0;
+	// The same as MultiplyMatrixByTransposedMatrixWithEpilogue with the sparse second matrix
+	// The first matrix is firstHeight * (weights width), the result is firstHeight * (weights height)
+	virtual void MultiplyMatrixBySparseWeightsWithEpilogue( const CConstFloatHandle& first, int firstHeight,
+		const CSparseWeightsDesc& weights, const CConstFloatHandle* freeTerm, const CActivationDesc& activation,
+		const CConstFloatHandle* residual, const CFloatHandle& result ) = 0;
+	// The same as BlobConvolutionWithEpilogue with the sparse filter
+	// The filter is the (filter count) * (filter object size) matrix
+	virtual void BlobConvolutionWithSparseFilter( const CConvolutionDesc& desc, const CConstFloatHandle& source,
+		const CSparseWeightsDesc& filter, const CConstFloatHandle* freeTerm, const CActivationDesc& activation,
+		const CConstFloatHandle* residual, const CFloatHandle& result ) = 0;
+
 	// Calculates channelwise convolution
 	// You can pass 0 for the freeTerm parameter, and the free terms will be 0
 	// The descriptor should be destroyed using the standard delete operator after use.
@@ -1001,6 +1064,22 @@ public:
 		const CConstFloatHandle& outputDiff, const CConstFloatHandle& invSum, const CConstFloatHandle& invSumBeta,
 		const CFloatHandle& inputDiff ) = 0;
 
+	// Layer normalization of each row of the matrix (height x width)
+	//     result = ( input + residual - mean ) / sqrt( variance + epsilon ) * scale + bias
+	// The mean and the variance of each row are calculated in a single pass (Welford's algorithm)
+	// You can pass 0 for the residual parameter; if present it is of the input size
+	// The result may be the same as the input
+	// normalized (of the input size) and invStdDev (of the height size) are required only for backward
+	// If you're not gonna use backward, you may pass 0
+	virtual void LayerNorm( const CConstFloatHandle& input, const CConstFloatHandle* residual, int height, int width,
+		float epsilon, const CConstFloatHandle& scale, const CConstFloatHandle& bias, const CFloatHandle& result,
+		const CFloatHandle* normalized, const CFloatHandle* invStdDev ) = 0;
+	// Calculates the input diff of the layer normalization from the values saved by LayerNorm
+	// The inputDiff may be the same as the outputDiff
+	virtual void LayerNormBackward( const CConstFloatHandle& normalized, const CConstFloatHandle& invStdDev,
+		const CConstFloatHandle& outputDiff, int height, int width, const CConstFloatHandle& scale,
+		const CFloatHandle& inputDiff ) = 0;
+
 	// Creates descriptor of LSTM with given weights be created.
 	virtual CLstmDesc* InitLstm( int hiddenSize, int objectSize,
 		const CConstFloatHandle& inputWeights, const CConstFloatHandle& inputFreeTerm,
@@ -1010,6 +1089,43 @@ public:
 		const CConstFloatHandle& input, const CFloatHandle& outputStateBackLink,
 		const CFloatHandle& outputMainBackLink ) = 0;
 
+	// Creates descriptor of GRU with given weights
+	// The weights are stored as in the fully-connected layers of the recurrent implementation:
+	//     gateWeights - (2 * hiddenSize) x (objectSize + hiddenSize), the update gate rows followed by the reset gate rows
+	//     mainWeights - hiddenSize x (objectSize + hiddenSize)
+	// The input columns go first, then the hidden state columns
+	// The free terms may be null
+	virtual CGruDesc* InitGru( int hiddenSize, int objectSize,
+		const CConstFloatHandle& gateWeights, const CConstFloatHandle& gateFreeTerm,
+		const CConstFloatHandle& mainWeights, const CConstFloatHandle& mainFreeTerm ) = 0;
+	// Calculates GRU over the whole sequences (sequenceLength x sequenceCount x objectSize)
+	// The projections of the input are calculated by large matrix multiplications for several steps at once,
+	// only the multiplications by the recurrent weights are done step by step
+	// The inputState (sequenceCount x hiddenSize) may be null, in this case zeros are used
+	// The output is sequenceLength x sequenceCount x hiddenSize
+	// The gates (sequenceLength x sequenceCount x 3 * hiddenSize) are required only for backward
+	// If you're not gonna use backward, you may pass CFloatHandle()
+	virtual void Gru( CGruDesc& desc, bool reverse, int sequenceLength, int sequenceCount,
+		const CConstFloatHandle& inputState, const CConstFloatHandle& input, const CFloatHandle& output,
+		const CFloatHandle& gates ) = 0;
+	// Calculates the diffs of Gru from the gates saved by it
+	// The inputState, input and output are the same as in Gru
+	// The inputStateDiff and inputDiff are calculated if not null
+	// The weights diffs are added to gateWeightsDiff, gateFreeTermDiff, mainWeightsDiff, mainFreeTermDiff
+	// of the same layout as in InitGru; if learning isn't needed they may be null
+	virtual void GruBackward( CGruDesc& desc, bool reverse, int sequenceLength, int sequenceCount,
+		const CConstFloatHandle& inputState, const CConstFloatHandle& input, const CConstFloatHandle& output,
+		const CConstFloatHandle& gates, const CConstFloatHandle& outputDiff,
+		const CFloatHandle& inputStateDiff, const CFloatHandle& inputDiff,
+		const CFloatHandle& gateWeightsDiff, const CFloatHandle& gateFreeTermDiff,
+		const CFloatHandle& mainWeightsDiff, const CFloatHandle& mainFreeTermDiff ) = 0;
+	// Calculates two GRUs over the same input (no input state) in the opposite directions, see Gru
+	// The directDesc is calculated from the first step to the last one and the reverseDesc is calculated backwards
+	// If the threadPool isn't null the directions are calculated concurrently in its threads
+	virtual void BidirectionalGru( CGruDesc& directDesc, CGruDesc& reverseDesc, int sequenceLength, int sequenceCount,
+		const CConstFloatHandle& input, const CFloatHandle& directOutput, const CFloatHandle& reverseOutput,
+		IThreadPool* threadPool = nullptr ) = 0;
+
 	// CTC
 
 	// Calculates CTC loss (and gradient if needed)
@@ -1103,11 +1219,20 @@ public:
 		int strideHeight, int strideWidth ) = 0;
 	virtual CRowwiseOperationDesc* InitRowwiseResizeImage( TBlobResizePadding padding, float defaultValue,
 		int deltaLeft, int deltaRight, int deltaTop, int deltaBottom ) = 0;
+	// Channel-based batch normalization in inference mode: output = input * multiplier + freeTerm
+	// multiplier and freeTerm contain channels elements
+	virtual CRowwiseOperationDesc* InitRowwiseBatchNormalization( int channels, const CConstFloatHandle& multiplier,
+		const CConstFloatHandle& freeTerm ) = 0;
+	// Adds the input of the whole chain to the result of the previous operations (residual connection)
+	// The input of this operation must be of the same size as the input of the chain
+	virtual CRowwiseOperationDesc* InitRowwiseEltwiseSum() = 0;
 
 	virtual CBlobDesc RowwiseReshape( CRowwiseOperationDesc** operations, int operationCount,
 		const CBlobDesc& input ) = 0;
+	// If threadPool is not null the calculation may be split between its threads
+	// (some math engines or operations may ignore it)
 	virtual void RowwiseExecute( const CBlobDesc& inputDesc, CRowwiseOperationDesc** operations, int operationCount,
-		const CFloatHandle& input, const CFloatHandle& output ) = 0;
+		const CFloatHandle& input, const CFloatHandle& output, IThreadPool* threadPool = nullptr ) = 0;
 };
 
 //------------------------------------------------------------------------------------------------------------
@@ -1234,6 +1359,20 @@ public:
 	// This object should be destroyed using the standard delete operator after use.
 	virtual IPerformanceCounters* CreatePerformanceCounters( bool isTimeOnly = false ) const = 0;
 
+	// Algorithms autotuning (only the CPU math engine supports it for now)
+	// In this mode the first run of a convolution with a new shape measures the time of all the suitable algorithms
+	// and the fastest one is used for this shape afterwards
+	// The results are kept in the math engine cache and used even when the mode is turned off
+	virtual void SetAutoTuningMode( bool /*enable*/ ) {}
+	virtual bool GetAutoTuningMode() const { return false; }
+	// Writes the autotuning results to the buffer and returns their size in bytes
+	// Nothing is written if the buffer is too small (use null buffer to get the size)
+	virtual size_t SaveAutoTuningCache( void* /*buffer*/, size_t /*bufferSize*/ ) const { return 0; }
+	// Adds the results written by SaveAutoTuningCache to the cache
+	// The results are stored with the CPU model and the matrix multiplication library,
+	// only the results for the current ones are used
+	virtual void LoadAutoTuningCache( const void* /*buffer*/, size_t /*bufferSize*/ ) {}
+
 	// For Distributed only
 	virtual CMathEngineDistributedInfo GetDistributedInfo() { return CMathEngineDistributedInfo(); }
 	virtual void AllReduce( const CFloatHandle& handle, int size ) = 0;
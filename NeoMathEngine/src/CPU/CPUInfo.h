@@ -26,6 +26,7 @@ limitations under the License.
 #endif // !FINE_ARCHITECTURE( FINE_ARM64 )
 
 #include <cstring>
+#include <string>
 
 
 // The structure with CPU information
@@ -148,6 +149,8 @@ struct CCPUInfo {
 	}
 
 	static const bool HasAvxAndFma;
+	static const bool HasF16c;
+	static const bool HasAvx512Bf16;
 	static const bool IsNotIntel;
 
 	static bool IsAvxAndFmaAvailable()
@@ -176,8 +179,67 @@ struct CCPUInfo {
 
 		// Check avx512_f bit in EBX ( any CPU with AVX512 has this bit )
 		bool AnyAvx512IsAvailable = regs.ebx & ( 1 << 16 );
+		if( !AnyAvx512IsAvailable ) {
+			return false;
+		}
+
+		// Check that OS keeps the opmask and zmm registers when switching contexts (OSXSAVE and XCR0 bits 1, 2, 5-7)
+		callCpuId( regs, 1 );
+		const unsigned int osxsaveBit = ( 1 << 27 );
+		if( ( regs.ecx & osxsaveBit ) != osxsaveBit ) {
+			return false;
+		}
+		const unsigned long long ZmmStateMask = 0xe6;
+		return ( getXcr0() & ZmmStateMask ) == ZmmStateMask;
+	}
+
+	static bool IsF16cAvailable()
+	{
+		Regs regs;
+		callCpuId( regs, 1 );
+
+		// f16c, avx and osxsave
+		const unsigned int f16cFlag = ( 1 << 29 ) + ( 1 << 28 ) + ( 1 << 27 );
+		return ( regs.ecx & f16cFlag ) == f16cFlag;
+	}
+
+	static bool IsAvx512Bf16Available()
+	{
+		if( !IsAvx512Available() ) {
+			return false;
+		}
+
+		// The maximum subleaf of the leaf 7 is in EAX
+		Regs regs;
+		callCpuIdEx( regs, 7, 0 );
+		if( regs.eax < 1 ) {
+			return false;
+		}
+
+		// Check avx512_bf16 bit in EAX of the subleaf 1
+		callCpuIdEx( regs, 7, 1 );
+		const unsigned int avx512Bf16Bit = ( 1 << 5 );
+		return ( regs.eax & avx512Bf16Bit ) == avx512Bf16Bit;
+	}
 
-		return AnyAvx512IsAvailable;
+	// Gets the processor brand string (empty if it isn't available)
+	static std::string GetCpuModel()
+	{
+		Regs regs;
+		callCpuId( regs, 0x80000000 );
+		if( static_cast<unsigned int>( regs.eax ) < 0x80000004 ) {
+			return std::string();
+		}
+
+		// The brand string is returned in EAX, EBX, ECX, EDX of the leaves 0x80000002-0x80000004
+		char brand[3 * sizeof( Regs ) + 1] = {};
+		for( int i = 0; i < 3; ++i ) {
+			callCpuId( regs, 0x80000002 + i );
+			::memcpy( brand + i * sizeof( Regs ), &regs, sizeof( Regs ) );
+		}
+		std::string model( brand );
+		const size_t first = model.find_first_not_of( ' ' );
+		return first == std::string::npos ? std::string() : model.substr( first, model.find_last_not_of( ' ' ) - first + 1 );
 	}
 
 private:
@@ -209,6 +271,23 @@ private:
 #endif // !FINE_ARCHITECTURE( FINE_ARM64 )
 	}
 
+	static unsigned long long getXcr0() {
+#if !FINE_ARCHITECTURE( FINE_ARM64 ) && !FINE_ARCHITECTURE( FINE_ARM )
+#if FINE_PLATFORM( FINE_WINDOWS )
+		return _xgetbv( 0 );
+#elif FINE_PLATFORM( FINE_LINUX ) || FINE_PLATFORM( FINE_DARWIN )
+		unsigned int eax = 0;
+		unsigned int edx = 0;
+		__asm__ volatile( "xgetbv" : "=a"( eax ), "=d"( edx ) : "c"( 0 ) );
+		return ( static_cast<unsigned long long>( edx ) << 32 ) | eax;
+#else
+		return 0;
+#endif
+#else
+		return 0;
+#endif // !FINE_ARCHITECTURE( FINE_ARM64 )
+	}
+
 	static void callCpuIdEx( Regs& outRegs, const RegType& eax, const RegType& ecx ) {
 		outRegs = { 0, 0, 0, 0 };
 #if !FINE_ARCHITECTURE( FINE_ARM64 ) && !FINE_ARCHITECTURE( FINE_ARM )
@@ -0,0 +1,164 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#include <common.h>
+#pragma hdrstop
+
+#include <CpuAutoTuningCache.h>
+#include <CPUInfo.h>
+#include <NeoMathEngine/NeoMathEngineException.h>
+#include <cstring>
+
+namespace NeoML {
+
+// The data format version
+// Version 2: the convolution algorithm also stores the matrix multiplication used by its kernel
+static const int AutoTuningCacheVersion = 2;
+
+// Writes the data to the buffer (if it isn't null) and moves the position
+static void writeAutoTuningData( const void* data, size_t size, char* buffer, size_t& pos )
+{
+	if( buffer != nullptr ) {
+		::memcpy( buffer + pos, data, size );
+	}
+	pos += size;
+}
+
+static void readAutoTuningData( const char* buffer, size_t bufferSize, size_t& pos, void* data, size_t size )
+{
+	ASSERT_EXPR( size <= bufferSize - pos );
+	::memcpy( data, buffer + pos, size );
+	pos += size;
+}
+
+static int readAutoTuningInt( const char* buffer, size_t bufferSize, size_t& pos )
+{
+	int value = 0;
+	readAutoTuningData( buffer, bufferSize, pos, &value, sizeof( value ) );
+	return value;
+}
+
+// Checks that the array of the given length read from the buffer fits in its rest
+// The check is done before the memory for the array is allocated
+static void checkAutoTuningLength( size_t bufferSize, size_t pos, int length, size_t elementSize )
+{
+	ASSERT_EXPR( length >= 0 && static_cast<size_t>( length ) <= ( bufferSize - pos ) / elementSize );
+}
+
+//------------------------------------------------------------------------------------------------------------
+
+CCpuAutoTuningCache::CCpuAutoTuningCache() :
+	cpuModel( CCPUInfo::GetCpuModel() ),
+	generation( 0 )
+{
+}
+
+CCpuAutoTuningCache::TKey CCpuAutoTuningCache::createKey( TAutoTuningOperation operation,
+	const std::vector<int>& shape ) const
+{
+	TKey key( cpuModel, std::vector<int>() );
+	key.second.reserve( shape.size() + 1 );
+	key.second.push_back( static_cast<int>( operation ) );
+	key.second.insert( key.second.end(), shape.begin(), shape.end() );
+	return key;
+}
+
+bool CCpuAutoTuningCache::Find( TAutoTuningOperation operation, const std::vector<int>& shape, int& algo ) const
+{
+	const TKey key = createKey( operation, shape );
+	std::lock_guard<std::mutex> lock( mutex );
+	auto entry = algos.find( key );
+	if( entry == algos.end() ) {
+		return false;
+	}
+	algo = entry->second;
+	return true;
+}
+
+void CCpuAutoTuningCache::Add( TAutoTuningOperation operation, const std::vector<int>& shape, int algo )
+{
+	const TKey key = createKey( operation, shape );
+	std::lock_guard<std::mutex> lock( mutex );
+	algos[key] = algo;
+	++generation;
+}
+
+size_t CCpuAutoTuningCache::Save( void* buffer, size_t bufferSize ) const
+{
+	std::lock_guard<std::mutex> lock( mutex );
+	const size_t size = write( nullptr );
+	if( buffer != nullptr && size <= bufferSize ) {
+		write( static_cast<char*>( buffer ) );
+	}
+	return size;
+}
+
+void CCpuAutoTuningCache::Load( const void* buffer, size_t bufferSize )
+{
+	ASSERT_EXPR( buffer != nullptr || bufferSize == 0 );
+	const char* data = static_cast<const char*>( buffer );
+	size_t pos = 0;
+	const int version = readAutoTuningInt( data, bufferSize, pos );
+	ASSERT_EXPR( version > 0 && version <= AutoTuningCacheVersion );
+	if( version < AutoTuningCacheVersion ) {
+		// The algorithms of the older versions mean something else, they'll be tuned again
+		return;
+	}
+	const int count = readAutoTuningInt( data, bufferSize, pos );
+	ASSERT_EXPR( count >= 0 );
+
+	std::map<TKey, int> loaded;
+	for( int i = 0; i < count; ++i ) {
+		TKey key;
+		const int modelLength = readAutoTuningInt( data, bufferSize, pos );
+		checkAutoTuningLength( bufferSize, pos, modelLength, sizeof( char ) );
+		key.first.resize( modelLength );
+		readAutoTuningData( data, bufferSize, pos, &key.first[0], modelLength );
+		const int shapeLength = readAutoTuningInt( data, bufferSize, pos );
+		ASSERT_EXPR( shapeLength > 0 );
+		checkAutoTuningLength( bufferSize, pos, shapeLength, sizeof( int ) );
+		key.second.resize( shapeLength );
+		readAutoTuningData( data, bufferSize, pos, key.second.data(), shapeLength * sizeof( int ) );
+		loaded[key] = readAutoTuningInt( data, bufferSize, pos );
+	}
+
+	std::lock_guard<std::mutex> lock( mutex );
+	for( const auto& entry : loaded ) {
+		algos[entry.first] = entry.second;
+	}
+	++generation;
+}
+
+// The format: version, entry count, then for each entry
+// the CPU model length and characters, the shape length and elements, the algorithm
+size_t CCpuAutoTuningCache::write( char* buffer ) const
+{
+	size_t pos = 0;
+	writeAutoTuningData( &AutoTuningCacheVersion, sizeof( int ), buffer, pos );
+	const int count = static_cast<int>( algos.size() );
+	writeAutoTuningData( &count, sizeof( int ), buffer, pos );
+	for( const auto& entry : algos ) {
+		const int modelLength = static_cast<int>( entry.first.first.size() );
+		writeAutoTuningData( &modelLength, sizeof( int ), buffer, pos );
+		writeAutoTuningData( entry.first.first.data(), modelLength, buffer, pos );
+		const int shapeLength = static_cast<int>( entry.first.second.size() );
+		writeAutoTuningData( &shapeLength, sizeof( int ), buffer, pos );
+		writeAutoTuningData( entry.first.second.data(), shapeLength * sizeof( int ), buffer, pos );
+		writeAutoTuningData( &entry.second, sizeof( int ), buffer, pos );
+	}
+	return pos;
+}
+
+} // namespace NeoML
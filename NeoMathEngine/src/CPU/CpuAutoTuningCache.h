@@ -0,0 +1,82 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace NeoML {
+
+// The operations that may be autotuned
+// The values are stored in the cache, so they must not be changed
+enum TAutoTuningOperation {
+	ATO_BlobConvolution = 1
+};
+
+// The matrix multiplication implementations, chosen at runtime by the CPU math engine
+// The fastest algorithm depends on the one in use, so it's a part of the operation shape
+// The values are stored in the cache, so they must not be changed
+enum TAutoTuningGemm {
+	ATG_Own = 0, // the NeoML interleaved kernels
+	ATG_Jit = 1, // the JIT kernels of the SIMD math engine
+	ATG_Mkl = 2,
+	ATG_Mlas = 3
+};
+
+// The results of the algorithms autotuning: the fastest algorithm for each operation shape on each CPU model
+// The results for the other CPU models are only kept to be saved again
+class CCpuAutoTuningCache {
+public:
+	CCpuAutoTuningCache();
+
+	CCpuAutoTuningCache( const CCpuAutoTuningCache& ) = delete;
+	CCpuAutoTuningCache& operator=( const CCpuAutoTuningCache& ) = delete;
+
+	// Finds the algorithm chosen for the shape on the current CPU model
+	// Returns false if the shape hasn't been tuned yet
+	bool Find( TAutoTuningOperation operation, const std::vector<int>& shape, int& algo ) const;
+	// Stores the algorithm chosen for the shape on the current CPU model
+	void Add( TAutoTuningOperation operation, const std::vector<int>& shape, int algo );
+
+	// The number of the changes of the cache
+	// The operations that haven't found their shapes should look for them again when it changes
+	int Generation() const { return generation; }
+
+	// Writes the cache to the buffer and returns the size of the data
+	// Nothing is written if the buffer is too small
+	size_t Save( void* buffer, size_t bufferSize ) const;
+	// Adds the entries from the buffer written by Save to the cache
+	// The buffers of the older format versions are skipped
+	void Load( const void* buffer, size_t bufferSize );
+
+private:
+	// The CPU model and the operation shape (the operation itself is the first element)
+	typedef std::pair<std::string, std::vector<int>> TKey;
+
+	const std::string cpuModel;
+	mutable std::mutex mutex;
+	std::map<TKey, int> algos;
+	std::atomic<int> generation;
+
+	TKey createKey( TAutoTuningOperation operation, const std::vector<int>& shape ) const;
+	size_t write( char* buffer ) const;
+};
+
+} // namespace NeoML
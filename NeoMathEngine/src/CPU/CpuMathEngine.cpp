@@ -42,6 +42,8 @@ limitations under the License.
 #endif // NEOML_USE_MKL
 
 const bool CCPUInfo::HasAvxAndFma = CCPUInfo::IsAvxAndFmaAvailable();
+const bool CCPUInfo::HasF16c = CCPUInfo::IsF16cAvailable();
+const bool CCPUInfo::HasAvx512Bf16 = CCPUInfo::IsAvx512Bf16Available();
 const bool CCPUInfo::IsNotIntel = CCPUInfo::GetCpuArch() != CCPUInfo::TCpuArch::Intel;
 
 namespace NeoML {
@@ -61,10 +63,9 @@ CCpuMathEngine::CCpuMathEngine( size_t _memoryLimit,
 #ifdef NEOML_USE_AVX
 	if( dllLoader.IsLoaded( CDllLoader::AVX_DLL ) ) {
 		simdMathEngine = std::unique_ptr<ISimdMathEngine>( CDllLoader::avxDll->CreateSimdMathEngine( this ) );
-		// Don't use custom sgemm function when we are compiled with MKL or MLAS.
-#if !defined( NEOML_USE_MKL ) && !defined( NEOML_USE_MLAS )
+		// The custom sgemm function is used by default only when we aren't compiled with MKL or MLAS
+		// (see getGemmBackend), otherwise the autotuning may choose it
 		customSgemmFunction = simdMathEngine->GetSgemmFunction();
-#endif // !defined( NEOML_USE_MKL ) && !defined( NEOML_USE_MLAS )
 	}
 #else  // !NEOML_USE_AVX
 	// warning fix
@@ -80,6 +81,62 @@ CCpuMathEngine::~CCpuMathEngine()
 	CleanUp();
 }
 
+// The matrix multiplication chosen for the current thread by CGemmBackendScope, -1 if none
+static thread_local int scopeGemmBackend = -1;
+
+CCpuMathEngine::CGemmBackendScope::CGemmBackendScope( TAutoTuningGemm backend ) :
+	previousBackend( scopeGemmBackend )
+{
+	scopeGemmBackend = static_cast<int>( backend );
+}
+
+CCpuMathEngine::CGemmBackendScope::~CGemmBackendScope()
+{
+	scopeGemmBackend = previousBackend;
+}
+
+// The matrix multiplication used by the engine (see multiplyMatrixByMatrix)
+TAutoTuningGemm CCpuMathEngine::getGemmBackend() const
+{
+	if( scopeGemmBackend >= 0 ) {
+		return static_cast<TAutoTuningGemm>( scopeGemmBackend );
+	}
+#if defined( NEOML_USE_MKL ) && defined( NEOML_USE_MLAS )
+	return CCPUInfo::IsNotIntel ? ATG_Mlas : ATG_Mkl;
+#elif defined( NEOML_USE_MKL )
+	return ATG_Mkl;
+#elif defined( NEOML_USE_MLAS )
+	return ATG_Mlas;
+#else
+	return customSgemmFunction != nullptr ? ATG_Jit : ATG_Own;
+#endif
+}
+
+// All the matrix multiplications available to the engine, the default one goes first
+void CCpuMathEngine::getGemmBackends( std::vector<TAutoTuningGemm>& backends ) const
+{
+	backends.assign( 1, getGemmBackend() );
+#ifdef NEOML_USE_SSE
+	auto addBackend = [&backends]( TAutoTuningGemm backend )
+	{
+		if( backend != backends[0] ) {
+			backends.push_back( backend );
+		}
+	};
+	if( customSgemmFunction != nullptr ) {
+		addBackend( ATG_Jit );
+	}
+#ifdef NEOML_USE_MKL
+	addBackend( ATG_Mkl );
+#else
+	addBackend( ATG_Own );
+#endif
+#ifdef NEOML_USE_MLAS
+	addBackend( ATG_Mlas );
+#endif
+#endif // NEOML_USE_SSE
+}
+
 void CCpuMathEngine::CleanUpSpecial()
 {
 #ifdef NEOML_USE_MKL
@@ -21,10 +21,12 @@ limitations under the License.
 #include <DllLoader.h>
 #include <memory>
 #include <CpuMathEngineDnnDistributed.h>
+#include <CpuAutoTuningCache.h>
 
 namespace NeoML {
 
 struct CCpuConvolutionDesc;
+enum TConvForwardKernel : int;
 struct CCommon2DPoolingDesc;
 struct CCommonMaxPoolingDesc;
 struct CCommon3dConvolutionDesc;
@@ -55,10 +57,16 @@ public:
 	void VectorFill( const CIntHandle& result, int vectorSize, const CConstIntHandle& value ) override;
 	void VectorConvert( const CConstFloatHandle& from, const CIntHandle& to, int vectorSize ) override;
 	void VectorConvert( const CConstIntHandle& from, const CFloatHandle& to, int vectorSize ) override;
+	void VectorConvert( const CConstFloatHandle& from, const CFloat16Handle& to, int vectorSize ) override;
+	void VectorConvert( const CConstFloat16Handle& from, const CFloatHandle& to, int vectorSize ) override;
+	void VectorConvert( const CConstFloatHandle& from, const CBFloat16Handle& to, int vectorSize ) override;
+	void VectorConvert( const CConstBFloat16Handle& from, const CFloatHandle& to, int vectorSize ) override;
 	void VectorFillBernoulli( const CFloatHandle& result, float p, int vectorSize, float value, int seed ) override;
 	void FilterSmallValues( const CFloatHandle& data, int dataSize, float threshold ) override;
 	void VectorCopy( const CFloatHandle& first, const CConstFloatHandle& second, int vectorSize ) override;
 	void VectorCopy( const CIntHandle& first, const CConstIntHandle& second, int vectorSize ) override;
+	void VectorCopy( const CFloat16Handle& first, const CConstFloat16Handle& second, int vectorSize ) override;
+	void VectorCopy( const CBFloat16Handle& first, const CConstBFloat16Handle& second, int vectorSize ) override;
 	void BroadcastCopy( const CIntHandle& toHandle, const CConstIntHandle& fromHandle,
 		const CBlobDesc& toDesc, const CBlobDesc& fromDesc, int additionalWidth ) override;
 	void BroadcastCopy( const CFloatHandle& toHandle, const CConstFloatHandle& fromHandle,
@@ -107,6 +115,14 @@ public:
 		int vectorSize ) override;
 	void VectorHSwishDiff( const CConstFloatHandle& firstHandle, const CConstFloatHandle& secondHandle,
 		const CFloatHandle& resultHandle, int vectorSize ) override;
+	void VectorGELU( const CConstFloatHandle& firstHandle, const CFloatHandle& resultHandle,
+		int vectorSize, CGELUActivationParam::TCalculationMode mode ) override;
+	void VectorGELUDiff( const CConstFloatHandle& firstHandle, const CConstFloatHandle& secondHandle,
+		const CFloatHandle& resultHandle, int vectorSize, CGELUActivationParam::TCalculationMode mode ) override;
+	void VectorSiLU( const CConstFloatHandle& firstHandle, const CFloatHandle& resultHandle,
+		int vectorSize ) override;
+	void VectorSiLUDiff( const CConstFloatHandle& firstHandle, const CConstFloatHandle& secondHandle,
+		const CFloatHandle& resultHandle, int vectorSize ) override;
 	void VectorEltwiseMax( const CConstFloatHandle& firstHandle,
 		const CConstFloatHandle& secondHandle, const CFloatHandle& resultHandle, int vectorSize ) override;
 	void VectorEltwiseMin( const CConstFloatHandle& firstHandle, const CConstFloatHandle& secondHandle,
@@ -332,6 +348,10 @@ public:
 		const CFloatHandle& resultHandle, int resultRowSize, int resultBufferSize ) override;
 	void MultiplyMatrixByTransposedMatrix( int batchSize, const CConstFloatHandle& firstHandle, int firstHeight, int firstWidth,
 		const CConstFloatHandle& secondHandle, int secondHeight, const CFloatHandle& resultHandle, int resultBufferSize ) override;
+	void MultiplyMatrixByTransposedMatrix( const CConstFloatHandle& firstHandle, int firstHeight, int firstWidth,
+		const CConstFloat16Handle& secondHandle, int secondHeight, const CFloatHandle& resultHandle ) override;
+	void MultiplyMatrixByTransposedMatrix( const CConstFloatHandle& firstHandle, int firstHeight, int firstWidth,
+		const CConstBFloat16Handle& secondHandle, int secondHeight, const CFloatHandle& resultHandle ) override;
 	void MultiplySparseMatrixByTransposedMatrix( int firstHeight, int firstWidth, int secondHeight,
 		const CSparseMatrixDesc& firstDesc, const CConstFloatHandle& secondHandle, const CFloatHandle& resultHandle ) override;
 	void MultiplyTransposedMatrixBySparseMatrix( int firstHeight, int firstWidth, int secondWidth,
@@ -424,6 +444,19 @@ public:
 	void BlobConvolutionLearnAdd( const CConvolutionDesc& desc,
 		const CConstFloatHandle& input, const CConstFloatHandle& outputDiff, const CFloatHandle& filterDiff,
 		const CFloatHandle* freeTermDiff, bool isFreeTermDiffFromInput ) override;
+	void BlobConvolutionWithEpilogue( const CConvolutionDesc& desc, const CConstFloatHandle& source,
+		const CConstFloatHandle& filter, const CConstFloatHandle* freeTerm, const CActivationDesc& activation,
+		const CConstFloatHandle* residual, const CFloatHandle& result ) override;
+	void MultiplyMatrixByTransposedMatrixWithEpilogue( const CConstFloatHandle& first, int firstHeight,
+		int firstWidth, const CConstFloatHandle& second, int secondHeight, const CConstFloatHandle* freeTerm,
+		const CActivationDesc& activation, const CConstFloatHandle* residual, const CFloatHandle& result ) override;
+	CSparseWeightsDesc* InitSparseWeights( int height, int width, const CConstFloatHandle& weights ) override;
+	void MultiplyMatrixBySparseWeightsWithEpilogue( const CConstFloatHandle& first, int firstHeight,
+		const CSparseWeightsDesc& weights, const CConstFloatHandle* freeTerm, const CActivationDesc& activation,
+		const CConstFloatHandle* residual, const CFloatHandle& result ) override;
+	void BlobConvolutionWithSparseFilter( const CConvolutionDesc& desc, const CConstFloatHandle& source,
+		const CSparseWeightsDesc& filter, const CConstFloatHandle* freeTerm, const CActivationDesc& activation,
+		const CConstFloatHandle* residual, const CFloatHandle& result ) override;
 	CChannelwiseConvolutionDesc* InitBlobChannelwiseConvolution( const CBlobDesc& input,
 		int paddingHeight, int paddingWidth, int strideHeight, int strideWidth,
 		const CBlobDesc& filter, const CBlobDesc* freeTerm, const CBlobDesc& output ) override;
@@ -539,6 +572,12 @@ public:
 	void LrnBackward( const CLrnDesc& desc, const CConstFloatHandle& input, const CConstFloatHandle& output,
 		const CConstFloatHandle& outputDiff, const CConstFloatHandle& invSum, const CConstFloatHandle& invSumBeta,
 		const CFloatHandle& inputDiff ) override;
+	void LayerNorm( const CConstFloatHandle& input, const CConstFloatHandle* residual, int height, int width,
+		float epsilon, const CConstFloatHandle& scale, const CConstFloatHandle& bias, const CFloatHandle& result,
+		const CFloatHandle* normalized, const CFloatHandle* invStdDev ) override;
+	void LayerNormBackward( const CConstFloatHandle& normalized, const CConstFloatHandle& invStdDev,
+		const CConstFloatHandle& outputDiff, int height, int width, const CConstFloatHandle& scale,
+		const CFloatHandle& inputDiff ) override;
 	void CtcLossForward( int resultLen, int batchSize, int classCount, int labelLen, int blankLabel, bool skipBlanks,
 		const CConstFloatHandle& result, const CConstIntHandle& labels,
 		const CConstIntHandle& labelLens, const CConstIntHandle& resultLens, const CConstFloatHandle& labelWeights,
@@ -555,6 +594,21 @@ public:
 		const CConstFloatHandle& inputStateBackLink, const CConstFloatHandle& inputMainBackLink,
 		const CConstFloatHandle& input, const CFloatHandle& outputStateBackLink,
 		const CFloatHandle& outputMainBackLink ) override;
+	CGruDesc* InitGru( int hiddenSize, int objectSize,
+		const CConstFloatHandle& gateWeights, const CConstFloatHandle& gateFreeTerm,
+		const CConstFloatHandle& mainWeights, const CConstFloatHandle& mainFreeTerm ) override;
+	void Gru( CGruDesc& desc, bool reverse, int sequenceLength, int sequenceCount,
+		const CConstFloatHandle& inputState, const CConstFloatHandle& input, const CFloatHandle& output,
+		const CFloatHandle& gates ) override;
+	void GruBackward( CGruDesc& desc, bool reverse, int sequenceLength, int sequenceCount,
+		const CConstFloatHandle& inputState, const CConstFloatHandle& input, const CConstFloatHandle& output,
+		const CConstFloatHandle& gates, const CConstFloatHandle& outputDiff,
+		const CFloatHandle& inputStateDiff, const CFloatHandle& inputDiff,
+		const CFloatHandle& gateWeightsDiff, const CFloatHandle& gateFreeTermDiff,
+		const CFloatHandle& mainWeightsDiff, const CFloatHandle& mainFreeTermDiff ) override;
+	void BidirectionalGru( CGruDesc& directDesc, CGruDesc& reverseDesc, int sequenceLength, int sequenceCount,
+		const CConstFloatHandle& input, const CFloatHandle& directOutput, const CFloatHandle& reverseOutput,
+		IThreadPool* threadPool ) override;
 	void LinearInterpolation( const CConstFloatHandle& dataHandle, const CFloatHandle& resultHandle,
 		TInterpolationCoords coords, TInterpolationRound round, int objectCount, int scaledAxis,
 		int objectSize, float scale ) override;
@@ -601,10 +655,13 @@ public:
 		int outputChannels, bool residual ) override;
 	CRowwiseOperationDesc* InitRowwise2DPooling( bool isMax, int filterHeight, int filterWidth,
 		int strideHeight, int strideWidth ) override;
+	CRowwiseOperationDesc* InitRowwiseBatchNormalization( int channels, const CConstFloatHandle& multiplier,
+		const CConstFloatHandle& freeTerm ) override;
+	CRowwiseOperationDesc* InitRowwiseEltwiseSum() override;
 	CBlobDesc RowwiseReshape( CRowwiseOperationDesc** operations, int operationCount,
 		const CBlobDesc& input ) override;
 	void RowwiseExecute( const CBlobDesc& inputDesc, CRowwiseOperationDesc** operations, int operationCount,
-		const CFloatHandle& input, const CFloatHandle& output ) override;
+		const CFloatHandle& input, const CFloatHandle& output, IThreadPool* threadPool ) override;
 
 	IPerformanceCounters* CreatePerformanceCounters( bool isOnlyTime ) const override;
 	// For Distributed only
@@ -613,6 +670,12 @@ public:
 	void AbortDistributed() override;
 	CMathEngineDistributedInfo GetDistributedInfo() override { return distributedInfo; }
 	bool IsDistributed() const override { return distributedInfo.Threads > 1; }
+	void SetAutoTuningMode( bool enable ) override { isAutoTuningMode = enable; }
+	bool GetAutoTuningMode() const override { return isAutoTuningMode; }
+	size_t SaveAutoTuningCache( void* buffer, size_t bufferSize ) const override
+		{ return autoTuningCache.Save( buffer, bufferSize ); }
+	void LoadAutoTuningCache( const void* buffer, size_t bufferSize ) override
+		{ autoTuningCache.Load( buffer, bufferSize ); }
 
 protected:
 	// IRawMemoryManager interface methods
@@ -629,8 +692,25 @@ private:
 	CDllLoader dllLoader; // loading library for simd instructions
 	std::unique_ptr<ISimdMathEngine> simdMathEngine; // interface for using simd instructions
 	SgemmFunc customSgemmFunction = nullptr; // Used when it is availabled and is faster then default sgemm
+	bool isAutoTuningMode = false; // the algorithms are measured for the new shapes
+	CCpuAutoTuningCache autoTuningCache; // the fastest algorithms for the shapes
 
 	IMathEngine& mathEngine() { IMathEngine* engine = this; return *engine; }
+	TAutoTuningGemm getGemmBackend() const;
+	void getGemmBackends( std::vector<TAutoTuningGemm>& backends ) const;
+
+	// Replaces the matrix multiplication backend of the current thread while the object exists
+	class CGemmBackendScope final {
+	public:
+		explicit CGemmBackendScope( TAutoTuningGemm backend );
+		~CGemmBackendScope();
+
+		CGemmBackendScope( const CGemmBackendScope& ) = delete;
+		CGemmBackendScope& operator=( const CGemmBackendScope& ) = delete;
+
+	private:
+		const int previousBackend;
+	};
 
 	void blob3dConvolution1x1x1( const CBlobDesc& source, const CBlobDesc& result,
 		int strideHeight, int strideWidth, int strideDepth,
@@ -678,10 +758,17 @@ private:
 		int firstWidth, const CConstFloatHandle& secondHandle, int secondHeight, const CFloatHandle& resultHandle );
 	void multiplyMatrixByTransposedMatrixAndAdd( const float* first, int firstHeight, int firstWidth, int firstRowSize,
 		const float* second, int secondHeight, int secondRowSize, float* result, int resultRowSize );
+	template<class T>
+	void multiplyMatrixByTransposedHalfMatrix( const float* first, int firstHeight, int firstWidth,
+		const T* second, int secondHeight, float* result );
 	void multiplyMatrixByDiagMatrix( const float* first, int firstHeight, int firstWidth,
 		const float* second, float* result );
 	void multiplyMatrixByTransposedWithFreeTerm( const float* first, int firstHeight,
 		int firstWidth, const float* second, int secondHeight, const float* freeTerm, float* result );
+	void multiplyMatrixByTransposedWithEpilogue( const float* first, int firstHeight, int firstWidth,
+		const float* second, int secondHeight, const float* freeTerm, const CActivationDesc& activation,
+		const float* residual, float* result );
+	void applyEpilogue( const CActivationDesc& activation, const float* residual, float* data, int dataSize );
 
 	template<class T>
 	void blobMergeByDimCommon( int dimNum, const CBlobDesc* from, const CTypedMemoryHandle<T>* fromData,
@@ -717,10 +804,24 @@ private:
 	void transposeResult( const CCpuConvolutionDesc& desc, const float* outputTransposedData,
 		int batch, int resultStart, int resultCount, float* result );
 	void fillTempData( const float* sourceData, float* filterData, const CCpuConvolutionDesc& desc, int start, int count );
+	void blobConvolution( const CCpuConvolutionDesc& desc, const float* sourceData, const float* filterData,
+		const CConstFloatHandle* freeTermData, const CActivationDesc* activation, const float* residualData,
+		float* resultData );
 	void blobConvolutionForwardAlgo0( const CCpuConvolutionDesc& desc, const float* sourceData,
-		const float* filterData, const CConstFloatHandle* freeTermData, float* resultData );
+		const float* filterData, const CConstFloatHandle* freeTermData, const CActivationDesc* activation,
+		const float* residualData, float* resultData );
 	void blobConvolutionForwardAlgo1( const CCpuConvolutionDesc& desc, const float* sourceData,
-		const float* filterData, const CConstFloatHandle* freeTermData, float* resultData );
+		const float* filterData, const CConstFloatHandle* freeTermData, const CActivationDesc* activation,
+		const float* residualData, float* resultData );
+	void blobConvolutionWinograd( const CCpuConvolutionDesc& desc, const float* sourceData,
+		const float* filterData, const float* freeTermData, const CActivationDesc* activation,
+		const float* residualData, float* resultData );
+	void tuneBlobConvolution( const CCpuConvolutionDesc& desc, const float* sourceData,
+		const float* filterData, const CConstFloatHandle* freeTermData, const CActivationDesc* activation,
+		const float* residualData, float* resultData );
+	void runBlobConvolutionKernel( const CCpuConvolutionDesc& desc, TConvForwardKernel kernel, TAutoTuningGemm gemm,
+		const float* sourceData, const float* filterData, const CConstFloatHandle* freeTermData,
+		const CActivationDesc* activation, const float* residualData, float* resultData );
 	void blobConvolutionBackwardAlgo1( const CCpuConvolutionDesc& desc,
 		const CConstFloatHandle& sourceData, const CConstFloatHandle& filterData, const CConstFloatHandle* freeTerm,
 		const CFloatHandle& resultData );
@@ -754,6 +855,9 @@ private:
 		const CConstFloatHandle& resultLogProb, const CConstIntHandle& resultLens, const CConstIntHandle& labelLens,
 		const CFloatHandle& logBeta );
 
+	void gru( const CGruDesc& desc, bool reverse, int sequenceLength, int sequenceCount, const float* inputState,
+		const float* input, float* output, int blockLength, float* projection, float* stateBuffer );
+
 	class CCpuRowwiseConv;
 	class CCpuRowwiseChConvWith1x1;
 	class CCpuRowwiseMobileNetV2;
@@ -937,6 +937,53 @@ void CCpuMathEngine::MultiplyMatrixByTransposedMatrix( int batchSize, const CCon
 	}
 }
 
+// The number of the 16-bit matrix elements converted to float at once (the buffer should fit into L2 cache)
+static constexpr int HalfPrecisionTileSize = 256 * 1024;
+// The minimum number of the rows in a converted panel, so that the GEMM gets the panels wide enough
+static constexpr int HalfPrecisionMinTileHeight = 128;
+
+template<class T>
+void CCpuMathEngine::multiplyMatrixByTransposedHalfMatrix( const float* first, int firstHeight, int firstWidth,
+	const T* second, int secondHeight, float* result )
+{
+	// The second matrix is converted by horizontal panels, each panel is multiplied while it's still in cache
+	const int tileHeight = std::min( secondHeight,
+		std::max( HalfPrecisionMinTileHeight, HalfPrecisionTileSize / firstWidth ) );
+	CFloatHandleStackVar buffer( *this, static_cast<size_t>( tileHeight ) * firstWidth );
+	float* const bufferPtr = GetRaw( buffer.GetHandle() );
+
+	for( int row = 0; row < secondHeight; row += tileHeight ) {
+		const int height = std::min( tileHeight, secondHeight - row );
+		vectorConvert( second + row * firstWidth, bufferPtr, height * firstWidth );
+		multiplyMatrixByTransposedMatrix( first, firstHeight, firstWidth, firstWidth,
+			bufferPtr, height, firstWidth, result + row, secondHeight );
+	}
+}
+
+void CCpuMathEngine::MultiplyMatrixByTransposedMatrix( const CConstFloatHandle& firstHandle, int firstHeight,
+	int firstWidth, const CConstFloat16Handle& secondHandle, int secondHeight, const CFloatHandle& resultHandle )
+{
+	ASSERT_EXPR( firstHandle.GetMathEngine() == this );
+	ASSERT_EXPR( secondHandle.GetMathEngine() == this );
+	ASSERT_EXPR( resultHandle.GetMathEngine() == this );
+	CCpuExecutionScope scope;
+
+	multiplyMatrixByTransposedHalfMatrix( GetRaw( firstHandle ), firstHeight, firstWidth,
+		GetRaw( secondHandle ), secondHeight, GetRaw( resultHandle ) );
+}
+
+void CCpuMathEngine::MultiplyMatrixByTransposedMatrix( const CConstFloatHandle& firstHandle, int firstHeight,
+	int firstWidth, const CConstBFloat16Handle& secondHandle, int secondHeight, const CFloatHandle& resultHandle )
+{
+	ASSERT_EXPR( firstHandle.GetMathEngine() == this );
+	ASSERT_EXPR( secondHandle.GetMathEngine() == this );
+	ASSERT_EXPR( resultHandle.GetMathEngine() == this );
+	CCpuExecutionScope scope;
+
+	multiplyMatrixByTransposedHalfMatrix( GetRaw( firstHandle ), firstHeight, firstWidth,
+		GetRaw( secondHandle ), secondHeight, GetRaw( resultHandle ) );
+}
+
 void CCpuMathEngine::batchMultiplyTransposedMatrixByMatrix( int batchSize,
 	const float* first, int firstHeight, int firstWidth,
 	const float* second, int secondWidth,
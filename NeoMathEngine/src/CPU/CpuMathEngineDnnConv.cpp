@@ -26,6 +26,8 @@ limitations under the License.
 #include <CpuMathEngineDnnConv.h>
 #include <NeoMathEngine/SimdMathEngine.h>
 #include <CpuMathEngineDnnChannelwiseConv.h>
+#include <chrono>
+#include <algorithm>
 
 namespace NeoML {
 
@@ -69,6 +71,8 @@ CConvolutionDesc* CCpuMathEngine::InitBlobConvolution( const CBlobDesc& source,
 		desc->SimdConvolutionDesc.reset( simdMathEngine->InitBlobConvolution( source, paddingHeight, paddingWidth,
 			strideHeight, strideWidth, dilationHeight, dilationWidth, filter, result ) );
 	}
+	desc->ForwardKernel = desc->GetDefaultForwardKernel();
+	desc->ForwardGemm = getGemmBackend();
 	return desc;
 }
 
@@ -303,7 +307,8 @@ void CCpuMathEngine::fillTempData( const float* sourceData, float* tempData, con
 }
 
 void CCpuMathEngine::blobConvolutionForwardAlgo0( const CCpuConvolutionDesc& desc, const float* sourceData,
-	const float* filterData, const CConstFloatHandle* freeTermData, float* resultData )
+	const float* filterData, const CConstFloatHandle* freeTermData, const CActivationDesc* activation,
+	const float* residualData, float* resultData )
 {
 	const int filterObjectSize = desc.Filter.ObjectSize();
 	const int filterObjectCount = desc.Filter.ObjectCount();
@@ -334,12 +339,17 @@ void CCpuMathEngine::blobConvolutionForwardAlgo0( const CCpuConvolutionDesc& des
 			addVectorToMatrixRows( resultDataPtr, resultDataPtr, size,
 				resultWidth, resultWidth, resultWidth, GetRaw( *freeTermData ) );
 		}
+		if( activation != nullptr ) {
+			applyEpilogue( *activation, residualData == nullptr ? nullptr : residualData + index * resultWidth,
+				resultDataPtr, size * resultWidth );
+		}
 		index += size;
 	}
 }
 
 void CCpuMathEngine::blobConvolutionForwardAlgo1( const CCpuConvolutionDesc& desc, const float* sourceData,
-	const float* filterData, const CConstFloatHandle* freeTermData, float* resultData )
+	const float* filterData, const CConstFloatHandle* freeTermData, const CActivationDesc* activation,
+	const float* residualData, float* resultData )
 {
 	const float* freeTermDataRaw = ( freeTermData == nullptr ) ? nullptr : GetRaw( *freeTermData );
 
@@ -385,46 +395,176 @@ void CCpuMathEngine::blobConvolutionForwardAlgo1( const CCpuConvolutionDesc& des
 		}
 		// Transpose the result
 		transposeResult( desc, outputTransposedPtr, batch, /*resultStart*/0, resultCount, resultData );
+		if( activation != nullptr ) {
+			const int offset = batch * result.ObjectSize();
+			applyEpilogue( *activation, residualData == nullptr ? nullptr : residualData + offset,
+				resultData + offset, result.ObjectSize() );
+		}
 	}
 }
 
 void CCpuMathEngine::BlobConvolution( const CConvolutionDesc& convDesc, const CConstFloatHandle& source,
 	const CConstFloatHandle& filter, const CConstFloatHandle* freeTerm, const CFloatHandle& result )
 {
-	const CCpuConvolutionDesc& desc = static_cast<const CCpuConvolutionDesc&>( convDesc );
 	CCpuExecutionScope scope;
+	blobConvolution( static_cast<const CCpuConvolutionDesc&>( convDesc ), GetRaw( source ), GetRaw( filter ),
+		freeTerm, /*activation*/nullptr, /*residual*/nullptr, GetRaw( result ) );
+}
 
-	const float* sourceRaw = GetRaw( source );
-	const float* filterRaw = GetRaw( filter );
-	const float* freeTermRaw = ( freeTerm != nullptr ) ? GetRaw( *freeTerm ) : nullptr;
-	float* resultRaw = GetRaw( result );
+void CCpuMathEngine::BlobConvolutionWithEpilogue( const CConvolutionDesc& convDesc, const CConstFloatHandle& source,
+	const CConstFloatHandle& filter, const CConstFloatHandle* freeTerm, const CActivationDesc& activation,
+	const CConstFloatHandle* residual, const CFloatHandle& result )
+{
+	CCpuExecutionScope scope;
+	blobConvolution( static_cast<const CCpuConvolutionDesc&>( convDesc ), GetRaw( source ), GetRaw( filter ),
+		freeTerm, &activation, residual == nullptr ? nullptr : GetRaw( *residual ), GetRaw( result ) );
+}
 
-	if( desc.SimdConvolutionDesc != nullptr ) {
-		simdMathEngine->BlobConvolution( *desc.SimdConvolutionDesc, sourceRaw, filterRaw, freeTermRaw, resultRaw );
-		return;
+// The activation (if not null) and the residual are applied to the parts of the result when they're ready
+void CCpuMathEngine::blobConvolution( const CCpuConvolutionDesc& desc, const float* sourceRaw, const float* filterRaw,
+	const CConstFloatHandle* freeTerm, const CActivationDesc* activation, const float* residualRaw, float* resultRaw )
+{
+	if( !desc.IsForwardKernelTuned
+		&& ( isAutoTuningMode || desc.AutoTuningGeneration != autoTuningCache.Generation() ) )
+	{
+		tuneBlobConvolution( desc, sourceRaw, filterRaw, freeTerm, activation, residualRaw, resultRaw );
 	}
+	runBlobConvolutionKernel( desc, desc.ForwardKernel, desc.ForwardGemm, sourceRaw, filterRaw, freeTerm,
+		activation, residualRaw, resultRaw );
+}
 
-	switch( desc.ForwardAlgo ) {
-		case CA_1:
-		case CA_2:
+// The shape of the convolution for the autotuning cache
+// The kernels except the SIMD one are built on the matrix multiplication, so its implementation is a part of the shape
+static std::vector<int> getBlobConvolutionShape( const CCpuConvolutionDesc& desc, TAutoTuningGemm gemm )
+{
+	return std::vector<int>{ desc.Source.ObjectCount(), desc.Source.Height(), desc.Source.Width(),
+		desc.Source.Depth(), desc.Source.Channels(), desc.Filter.ObjectCount(), desc.Filter.Height(),
+		desc.Filter.Width(), desc.PaddingHeight, desc.PaddingWidth, desc.StrideHeight, desc.StrideWidth,
+		desc.DilationHeight, desc.DilationWidth, static_cast<int>( gemm ) };
+}
+
+// The number of the measured runs of each kernel; the fastest one is taken to filter out the noise
+static constexpr int AutoTuningRunCount = 5;
+
+// The cached algorithm of the convolution is the kernel and the matrix multiplication used by it
+static int packBlobConvolutionAlgo( TConvForwardKernel kernel, TAutoTuningGemm gemm )
+{
+	return static_cast<int>( kernel ) + CFK_Count * static_cast<int>( gemm );
+}
+
+// Chooses the forward kernel and its matrix multiplication: they're taken from the autotuning cache
+// If the shape isn't there and the autotuning mode is on, all the suitable pairs are measured on the actual data
+// and the fastest one is stored in the cache
+// The engine doesn't have the threads of its own, so there are no threading parameters to choose
+void CCpuMathEngine::tuneBlobConvolution( const CCpuConvolutionDesc& desc, const float* sourceRaw,
+	const float* filterRaw, const CConstFloatHandle* freeTerm, const CActivationDesc* activation,
+	const float* residualRaw, float* resultRaw )
+{
+	desc.AutoTuningGeneration = autoTuningCache.Generation();
+
+	std::vector<TAutoTuningGemm> gemms;
+	getGemmBackends( gemms );
+
+	const std::vector<int> shape = getBlobConvolutionShape( desc, gemms[0] );
+	int cachedAlgo = 0;
+	if( autoTuningCache.Find( ATO_BlobConvolution, shape, cachedAlgo ) ) {
+		const TConvForwardKernel cachedKernel = static_cast<TConvForwardKernel>( cachedAlgo % CFK_Count );
+		const TAutoTuningGemm cachedGemm = static_cast<TAutoTuningGemm>( cachedAlgo / CFK_Count );
+		if( cachedAlgo >= 0 && desc.IsForwardKernelAvailable( cachedKernel )
+			&& std::find( gemms.begin(), gemms.end(), cachedGemm ) != gemms.end() )
 		{
-			const int64_t algo1DataSize = static_cast<int64_t>( desc.Result.Width() )
-				* desc.Result.Height() * desc.Filter.ObjectSize() + desc.Result.ObjectSize();
+			desc.ForwardKernel = cachedKernel;
+			desc.ForwardGemm = cachedGemm;
+		}
+		desc.IsForwardKernelTuned = true;
+		return;
+	}
+	// Every measured run overwrites the result, so it can't be used as the residual
+	if( !isAutoTuningMode || ( residualRaw != nullptr && residualRaw == resultRaw ) ) {
+		return;
+	}
 
-			if( algo1DataSize <= BlobConvolutionCacheSize ) {
-				blobConvolutionForwardAlgo1( desc, sourceRaw, filterRaw, freeTerm, resultRaw );
-			} else {
-				blobConvolutionForwardAlgo0( desc, sourceRaw, filterRaw, freeTerm, resultRaw );
+	TConvForwardKernel bestKernel = desc.ForwardKernel;
+	TAutoTuningGemm bestGemm = desc.ForwardGemm;
+	double bestTime = DBL_MAX;
+	for( int i = 0; i < CFK_Count; ++i ) {
+		const TConvForwardKernel kernel = static_cast<TConvForwardKernel>( i );
+		if( !desc.IsForwardKernelAvailable( kernel ) ) {
+			continue;
+		}
+		// The SIMD kernel doesn't use the matrix multiplication, so it's measured only once
+		const size_t gemmCount = ( kernel == CFK_Simd ) ? 1 : gemms.size();
+		for( size_t j = 0; j < gemmCount; ++j ) {
+			const TAutoTuningGemm gemm = gemms[j];
+			// The first run prepares the data of the kernel (e.g. the transformed filter) and warms up the caches
+			runBlobConvolutionKernel( desc, kernel, gemm, sourceRaw, filterRaw, freeTerm, activation,
+				residualRaw, resultRaw );
+			double time = DBL_MAX;
+			for( int run = 0; run < AutoTuningRunCount; ++run ) {
+				const auto start = std::chrono::steady_clock::now();
+				runBlobConvolutionKernel( desc, kernel, gemm, sourceRaw, filterRaw, freeTerm, activation,
+					residualRaw, resultRaw );
+				time = std::min( time,
+					std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count() );
+			}
+			if( time < bestTime ) {
+				bestTime = time;
+				bestKernel = kernel;
+				bestGemm = gemm;
 			}
-			break;
 		}
-		case CA_1x1:
+	}
+
+	desc.ForwardKernel = bestKernel;
+	desc.ForwardGemm = bestGemm;
+	desc.IsForwardKernelTuned = true;
+	if( bestKernel != CFK_Winograd ) {
+		desc.WinogradFilter.reset();
+	}
+	autoTuningCache.Add( ATO_BlobConvolution, shape, packBlobConvolutionAlgo( bestKernel, bestGemm ) );
+}
+
+void CCpuMathEngine::runBlobConvolutionKernel( const CCpuConvolutionDesc& desc, TConvForwardKernel kernel,
+	TAutoTuningGemm gemm, const float* sourceRaw, const float* filterRaw, const CConstFloatHandle* freeTerm,
+	const CActivationDesc* activation, const float* residualRaw, float* resultRaw )
+{
+	CGemmBackendScope gemmScope( gemm );
+	const float* freeTermRaw = ( freeTerm != nullptr ) ? GetRaw( *freeTerm ) : nullptr;
+
+	switch( kernel ) {
+		case CFK_Simd:
+			// The kernels of the convolution don't have the epilogue, so it's applied to the whole result
+			simdMathEngine->BlobConvolution( *desc.SimdConvolutionDesc, sourceRaw, filterRaw, freeTermRaw, resultRaw );
+			if( activation != nullptr ) {
+				applyEpilogue( *activation, residualRaw, resultRaw, desc.Result.BlobSize() );
+			}
+			break;
+		case CFK_Algo0:
+			blobConvolutionForwardAlgo0( desc, sourceRaw, filterRaw, freeTerm, activation, residualRaw, resultRaw );
+			break;
+		case CFK_Algo1:
+			blobConvolutionForwardAlgo1( desc, sourceRaw, filterRaw, freeTerm, activation, residualRaw, resultRaw );
+			break;
+		case CFK_1x1:
 		{
 			const bool needsFlatten = ( desc.Source.Depth() != 1 );
+			if( activation != nullptr && desc.StrideHeight == 1 && desc.StrideWidth == 1 ) {
+				// The convolution is the matrix multiplication
+				multiplyMatrixByTransposedWithEpilogue( sourceRaw,
+					desc.Result.ObjectCount() * desc.Result.GeometricalSize(), desc.Source.Depth() * desc.Source.Channels(),
+					filterRaw, desc.Result.Channels(), freeTermRaw, *activation, residualRaw, resultRaw );
+				break;
+			}
 			blob3dConvolution1x1x1( needsFlatten ? flatten( desc.Source ) : desc.Source, desc.Result,
 				desc.StrideHeight, desc.StrideWidth, /*StrideDepth*/1, sourceRaw, filterRaw, freeTermRaw, resultRaw );
+			if( activation != nullptr ) {
+				applyEpilogue( *activation, residualRaw, resultRaw, desc.Result.BlobSize() );
+			}
 			break;
 		}
+		case CFK_Winograd:
+			blobConvolutionWinograd( desc, sourceRaw, filterRaw, freeTermRaw, activation, residualRaw, resultRaw );
+			break;
 		default:
 			ASSERT_EXPR( false );
 	}
@@ -963,6 +1103,8 @@ void CCpuMathEngine::BlobConvolutionLearnAdd( const CConvolutionDesc& convDesc,
 {
 	CCpuExecutionScope scope;
 	const CCpuConvolutionDesc& desc = static_cast<const CCpuConvolutionDesc&>( convDesc );
+	// The filter will be changed by the learning step
+	desc.WinogradFilter.reset();
 
 	switch( desc.BackwardAlgo ) {
 		case CA_1:
@@ -27,6 +27,18 @@ enum TConvAlgo {
 	CA_1x1		// for convolution with a 1*1 filter, no padding and dilation (both 2D and 3D)
 };
 
+// The implementations of the forward convolution
+// The values are stored in the autotuning cache, so they must not be changed
+enum TConvForwardKernel : int {
+	CFK_Simd = 0,		// the specialized SIMD kernel
+	CFK_Algo0 = 1,		// the temporary matrix is built for a part of the result at a time
+	CFK_Algo1 = 2,		// the temporary matrix is built for the whole object
+	CFK_1x1 = 3,		// the matrix multiplication (CA_1x1 only)
+	CFK_Winograd = 4,	// Winograd F(2x2, 3x3) algorithm (only for 3*3 filter, stride = 1 and no dilation)
+
+	CFK_Count
+};
+
 constexpr int BlobConvolutionCacheSize = 256 * 1024;
 
 // Convolution descriptor
@@ -34,6 +46,16 @@ struct CCpuConvolutionDesc : public CCommonConvolutionDesc {
 	TConvAlgo ForwardAlgo;
 	TConvAlgo BackwardAlgo;
 	std::unique_ptr<CConvolutionDesc> SimdConvolutionDesc{};
+	// The filter transformed for the Winograd algorithm, calculated on the first call
+	// BlobConvolutionLearnAdd resets it because the filter is going to be updated
+	mutable std::unique_ptr<CFloatHandleVar> WinogradFilter{};
+	// The forward kernel; it's replaced by the autotuning results when they're available
+	mutable TConvForwardKernel ForwardKernel = CFK_Algo0;
+	// The matrix multiplication used by the forward kernel; it's also replaced by the autotuning results
+	mutable TAutoTuningGemm ForwardGemm = ATG_Own;
+	mutable bool IsForwardKernelTuned = false;
+	// The generation of the autotuning cache that has been checked for this shape
+	mutable int AutoTuningGeneration = -1;
 
 	CCpuConvolutionDesc(
 			const CBlobDesc& source, const CBlobDesc& result, const CBlobDesc& filter,
@@ -45,6 +67,11 @@ struct CCpuConvolutionDesc : public CCommonConvolutionDesc {
 		BackwardAlgo( getActualBackwardAlgo() )
 	{}
 
+	// Checks if the kernel may be used for this convolution
+	bool IsForwardKernelAvailable( TConvForwardKernel kernel ) const;
+	// Gets the kernel chosen by the shape heuristics
+	TConvForwardKernel GetDefaultForwardKernel() const;
+
 private:
 	TConvAlgo getActualForwardAlgo() const;
 	TConvAlgo getActualBackwardAlgo() const;
@@ -78,6 +105,53 @@ inline TConvAlgo CCpuConvolutionDesc::getActualForwardAlgo() const
 	return CA_1;
 }
 
+inline bool CCpuConvolutionDesc::IsForwardKernelAvailable( TConvForwardKernel kernel ) const
+{
+	switch( kernel ) {
+		case CFK_Simd:
+			return SimdConvolutionDesc != nullptr;
+		case CFK_Algo0:
+			return true;
+		case CFK_Algo1:
+			// The temporary matrix may be too large
+			return static_cast<int64_t>( Result.Width() ) * Result.Height() * Filter.ObjectSize()
+				+ Result.ObjectSize() <= 16 * BlobConvolutionCacheSize;
+		case CFK_1x1:
+			return ForwardAlgo == CA_1x1;
+		case CFK_Winograd:
+			return Filter.Height() == 3 && Filter.Width() == 3
+				&& StrideHeight == 1 && StrideWidth == 1
+				&& DilationHeight == 1 && DilationWidth == 1
+				&& Source.Depth() == 1;
+		default:
+			return false;
+	}
+}
+
+// The specialized SIMD kernels are preferred
+// Winograd algorithm is used when the number of channels is large enough
+// for the matrix multiplications of the transformed data to be efficient
+// and the image is large enough for the transformations to pay off
+inline TConvForwardKernel CCpuConvolutionDesc::GetDefaultForwardKernel() const
+{
+	if( SimdConvolutionDesc != nullptr ) {
+		return CFK_Simd;
+	}
+	if( ForwardAlgo == CA_1x1 ) {
+		return CFK_1x1;
+	}
+	if( IsForwardKernelAvailable( CFK_Winograd )
+		&& Source.Channels() >= 16 && Filter.ObjectCount() >= 16
+		&& Result.Height() >= 2 && Result.Width() >= 2
+		&& Result.Height() * Result.Width() >= 256 )
+	{
+		return CFK_Winograd;
+	}
+	const int64_t algo1DataSize = static_cast<int64_t>( Result.Width() ) * Result.Height() * Filter.ObjectSize()
+		+ Result.ObjectSize();
+	return algo1DataSize <= BlobConvolutionCacheSize ? CFK_Algo1 : CFK_Algo0;
+}
+
 inline TConvAlgo CCpuConvolutionDesc::getActualBackwardAlgo() const
 {
 	TConvAlgo ret = getActualForwardAlgo();
@@ -0,0 +1,146 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#include <common.h>
+#pragma hdrstop
+
+#include <CpuMathEngine.h>
+#include <CpuMathEnginePrivate.h>
+#include <CpuExecutionScope.h>
+#include <MemoryHandleInternal.h>
+#include <cmath>
+
+#ifdef NEOML_USE_MLAS
+#include "mlas/inc/mlas.h"
+#endif
+
+namespace NeoML {
+
+#ifdef NEOML_USE_MLAS
+// The number of the result elements which are calculated before the epilogue is applied (they stay in L2 cache)
+static constexpr int EpilogueTileSize = 64 * 1024;
+// The minimal number of the result rows in the tile of matrix multiplication
+static constexpr int EpilogueMinTileHeight = 16;
+#endif
+
+void CCpuMathEngine::applyEpilogue( const CActivationDesc& activation, const float* residual,
+	float* data, int dataSize )
+{
+	switch( activation.GetType() ) {
+		case AF_ELU:
+			vectorELU( data, data, activation.GetParam<CELUActivationParam>().Alpha, dataSize );
+			break;
+		case AF_GELU:
+			vectorGelu( data, data, dataSize, activation.GetParam<CGELUActivationParam>().Mode );
+			break;
+		case AF_HardSigmoid:
+			vectorHardSigmoid( data, data, activation.GetParam<CHardSigmoidActivationParam>().Slope,
+				activation.GetParam<CHardSigmoidActivationParam>().Bias, dataSize );
+			break;
+		case AF_HardTanh:
+			vectorMinMax( data, data, -1.f, 1.f, dataSize );
+			break;
+		case AF_HSwish:
+			vectorHSwish( data, data, dataSize );
+			break;
+		case AF_LeakyReLU:
+			vectorLeakyReLU( data, data, activation.GetParam<CLeakyReLUActivationParam>().Alpha, dataSize );
+			break;
+		case AF_Linear:
+			if( activation.GetParam<CLinearActivationParam>().Multiplier != 1.f ) {
+				vectorMultiply( data, data, dataSize, activation.GetParam<CLinearActivationParam>().Multiplier );
+			}
+			if( activation.GetParam<CLinearActivationParam>().FreeTerm != 0.f ) {
+				vectorAddValue( data, data, dataSize, activation.GetParam<CLinearActivationParam>().FreeTerm );
+			}
+			break;
+		case AF_ReLU:
+			if( activation.GetParam<CReLUActivationParam>().UpperThreshold <= 0 ) {
+				vectorReLU( data, data, dataSize );
+			} else {
+				vectorReLU( data, data, dataSize, activation.GetParam<CReLUActivationParam>().UpperThreshold );
+			}
+			break;
+		case AF_Sigmoid:
+			vectorSigmoid( data, data, dataSize );
+			break;
+		case AF_Tanh:
+			vectorTanh( data, data, dataSize );
+			break;
+		default:
+			ASSERT_EXPR( false );
+	}
+
+	if( residual != nullptr ) {
+		vectorAdd( data, residual, data, dataSize );
+	}
+}
+
+void CCpuMathEngine::multiplyMatrixByTransposedWithEpilogue( const float* first, int firstHeight, int firstWidth,
+	const float* second, int secondHeight, const float* freeTerm, const CActivationDesc& activation,
+	const float* residual, float* result )
+{
+#ifdef NEOML_USE_MLAS
+	const int tileHeight = std::max( EpilogueMinTileHeight, EpilogueTileSize / secondHeight );
+	if( firstHeight > tileHeight && getGemmBackend() == ATG_Mlas ) {
+		// The second matrix is packed once, then the result is calculated by horizontal tiles
+		// and the epilogue is applied to each tile right after it
+		// The packed matrix is read by aligned loads
+		const size_t alignment = MlasGetPreferredBufferAlignment();
+		const size_t packedSize = MlasGemmPackBSize( static_cast<size_t>( secondHeight ),
+			static_cast<size_t>( firstWidth ) ) + alignment;
+		CFloatHandleStackVar packed( mathEngine(), ( packedSize + sizeof( float ) - 1 ) / sizeof( float ) );
+		const size_t packedAddress = reinterpret_cast<size_t>( GetRaw( packed.GetHandle() ) );
+		void* packedRaw = reinterpret_cast<void*>( ( packedAddress + alignment - 1 ) / alignment * alignment );
+		MlasGemmPackB( MlasTrans, static_cast<size_t>( secondHeight ), static_cast<size_t>( firstWidth ),
+			second, static_cast<size_t>( firstWidth ), packedRaw );
+
+		for( int row = 0; row < firstHeight; row += tileHeight ) {
+			const int height = std::min( tileHeight, firstHeight - row );
+			const int offset = row * secondHeight;
+			MlasGemm( MlasNoTrans, static_cast<size_t>( height ), static_cast<size_t>( secondHeight ),
+				static_cast<size_t>( firstWidth ), 1.f, first + row * firstWidth, static_cast<size_t>( firstWidth ),
+				packedRaw, 0.f, result + offset, static_cast<size_t>( secondHeight ), nullptr );
+			if( freeTerm != nullptr ) {
+				addVectorToMatrixRows( result + offset, result + offset, height, secondHeight, secondHeight,
+					secondHeight, freeTerm );
+			}
+			applyEpilogue( activation, residual == nullptr ? nullptr : residual + offset, result + offset,
+				height * secondHeight );
+		}
+		return;
+	}
+#endif
+	// The result fits into one tile or the GEMM backend packs the second matrix on each call:
+	// the product is calculated at once and the epilogue is applied in a separate pass
+	multiplyMatrixByTransposedWithFreeTerm( first, firstHeight, firstWidth, second, secondHeight, freeTerm, result );
+	applyEpilogue( activation, residual, result, firstHeight * secondHeight );
+}
+
+void CCpuMathEngine::MultiplyMatrixByTransposedMatrixWithEpilogue( const CConstFloatHandle& first, int firstHeight,
+	int firstWidth, const CConstFloatHandle& second, int secondHeight, const CConstFloatHandle* freeTerm,
+	const CActivationDesc& activation, const CConstFloatHandle* residual, const CFloatHandle& result )
+{
+	ASSERT_EXPR( first.GetMathEngine() == this );
+	ASSERT_EXPR( second.GetMathEngine() == this );
+	ASSERT_EXPR( result.GetMathEngine() == this );
+	CCpuExecutionScope scope;
+
+	multiplyMatrixByTransposedWithEpilogue( GetRaw( first ), firstHeight, firstWidth, GetRaw( second ), secondHeight,
+		freeTerm == nullptr ? nullptr : GetRaw( *freeTerm ), activation,
+		residual == nullptr ? nullptr : GetRaw( *residual ), GetRaw( result ) );
+}
+
+} // namespace NeoML
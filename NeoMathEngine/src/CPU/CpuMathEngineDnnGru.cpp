@@ -0,0 +1,454 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#include <common.h>
+#pragma hdrstop
+
+#include <algorithm>
+
+#include <CpuMathEngine.h>
+#include <CpuExecutionScope.h>
+#include <CpuMathEnginePrivate.h>
+#include <MemoryHandleInternal.h>
+#include <NeoMathEngine/NeoMathEngineException.h>
+
+namespace NeoML {
+
+// The GRU weights rearranged for the calculation:
+// the input parts of both fully-connected layers are merged into a single matrix
+// so that the input projection of all the gates is calculated by one multiplication
+struct CCpuGruDesc : public CGruDesc {
+	CCpuGruDesc( IMathEngine& mathEngine, int hiddenSize, int objectSize,
+		const float* gateWeights, const float* gateFreeTerm, const float* mainWeights, const float* mainFreeTerm );
+
+	const int HiddenSize;
+	const int ObjectSize;
+	// (3 * HiddenSize) x ObjectSize: the update, the reset and the main rows
+	CFloatHandleVar InputWeights;
+	// 3 * HiddenSize free terms of the same rows
+	CFloatHandleVar FreeTerm;
+	// (2 * HiddenSize) x HiddenSize: the update and the reset rows
+	CFloatHandleVar RecurGateWeights;
+	// HiddenSize x HiddenSize
+	CFloatHandleVar RecurMainWeights;
+};
+
+// Copies the columns [firstColumn, firstColumn + resultWidth) of the matrix
+static void copyGruWeightsColumns( const float* weights, int height, int width, int firstColumn,
+	int resultWidth, float* result )
+{
+	for( int row = 0; row < height; ++row ) {
+		dataCopy( result, weights + firstColumn, resultWidth );
+		weights += width;
+		result += resultWidth;
+	}
+}
+
+CCpuGruDesc::CCpuGruDesc( IMathEngine& mathEngine, int hiddenSize, int objectSize,
+		const float* gateWeights, const float* gateFreeTerm, const float* mainWeights, const float* mainFreeTerm ) :
+	HiddenSize( hiddenSize ),
+	ObjectSize( objectSize ),
+	InputWeights( mathEngine, 3 * hiddenSize * objectSize ),
+	FreeTerm( mathEngine, 3 * hiddenSize ),
+	RecurGateWeights( mathEngine, 2 * hiddenSize * hiddenSize ),
+	RecurMainWeights( mathEngine, hiddenSize * hiddenSize )
+{
+	const int width = objectSize + hiddenSize;
+	float* inputWeights = GetRaw( InputWeights.GetHandle() );
+	copyGruWeightsColumns( gateWeights, 2 * hiddenSize, width, 0, objectSize, inputWeights );
+	copyGruWeightsColumns( mainWeights, hiddenSize, width, 0, objectSize, inputWeights + 2 * hiddenSize * objectSize );
+	copyGruWeightsColumns( gateWeights, 2 * hiddenSize, width, objectSize, hiddenSize,
+		GetRaw( RecurGateWeights.GetHandle() ) );
+	copyGruWeightsColumns( mainWeights, hiddenSize, width, objectSize, hiddenSize,
+		GetRaw( RecurMainWeights.GetHandle() ) );
+
+	float* freeTerm = GetRaw( FreeTerm.GetHandle() );
+	if( gateFreeTerm == nullptr ) {
+		vectorFill0( freeTerm, 2 * hiddenSize );
+	} else {
+		dataCopy( freeTerm, gateFreeTerm, 2 * hiddenSize );
+	}
+	if( mainFreeTerm == nullptr ) {
+		vectorFill0( freeTerm + 2 * hiddenSize, hiddenSize );
+	} else {
+		dataCopy( freeTerm + 2 * hiddenSize, mainFreeTerm, hiddenSize );
+	}
+}
+
+// The per-step epilogue of one sequence: the gates nonlinearities are applied in the same pass as the products
+// Applies sigmoid to the update and the reset gates and multiplies the previous state by the reset gate
+static void gruGates( float* gates, const float* prevState, float* resetState, int hiddenSize )
+{
+#ifdef NEOML_USE_SSE
+	if( CCPUInfo::HasAvxAndFma ) {
+		NeoML::Avx2::gruGates( gates, prevState, resetState, hiddenSize );
+		return;
+	}
+#endif
+	vectorSigmoid( gates, gates, 2 * hiddenSize );
+	vectorEltwiseMultiply( gates + hiddenSize, prevState, resetState, hiddenSize );
+}
+
+// Applies tanh to the candidate and calculates the new state
+static void gruState( const float* update, float* candidate, const float* prevState, float* newState, int hiddenSize )
+{
+#ifdef NEOML_USE_SSE
+	if( CCPUInfo::HasAvxAndFma ) {
+		NeoML::Avx2::gruState( update, candidate, prevState, newState, hiddenSize );
+		return;
+	}
+#endif
+	vectorTanh( candidate, candidate, hiddenSize );
+	// newState = ( 1 - update ) * candidate + update * prevState
+	for( int j = 0; j < hiddenSize; ++j ) {
+		newState[j] = candidate[j] + update[j] * ( prevState[j] - candidate[j] );
+	}
+}
+
+CGruDesc* CCpuMathEngine::InitGru( int hiddenSize, int objectSize,
+	const CConstFloatHandle& gateWeights, const CConstFloatHandle& gateFreeTerm,
+	const CConstFloatHandle& mainWeights, const CConstFloatHandle& mainFreeTerm )
+{
+	ASSERT_EXPR( hiddenSize > 0 && objectSize > 0 );
+	ASSERT_EXPR( gateWeights.GetMathEngine() == this );
+	ASSERT_EXPR( mainWeights.GetMathEngine() == this );
+	ASSERT_EXPR( gateFreeTerm.IsNull() || gateFreeTerm.GetMathEngine() == this );
+	ASSERT_EXPR( mainFreeTerm.IsNull() || mainFreeTerm.GetMathEngine() == this );
+
+	return new CCpuGruDesc( *this, hiddenSize, objectSize, GetRaw( gateWeights ),
+		gateFreeTerm.IsNull() ? nullptr : GetRaw( gateFreeTerm ), GetRaw( mainWeights ),
+		mainFreeTerm.IsNull() ? nullptr : GetRaw( mainFreeTerm ) );
+}
+
+// The input projections are calculated for the blocks of at least 64 rows
+static int gruBlockLength( int sequenceLength, int sequenceCount )
+{
+	return std::min( sequenceLength, ( 64 + sequenceCount - 1 ) / sequenceCount );
+}
+
+void CCpuMathEngine::Gru( CGruDesc& desc, bool reverse, int sequenceLength, int sequenceCount,
+	const CConstFloatHandle& inputStateHandle, const CConstFloatHandle& inputHandle, const CFloatHandle& outputHandle,
+	const CFloatHandle& gatesHandle )
+{
+	ASSERT_EXPR( inputStateHandle.IsNull() || inputStateHandle.GetMathEngine() == this );
+	ASSERT_EXPR( inputHandle.GetMathEngine() == this );
+	ASSERT_EXPR( outputHandle.GetMathEngine() == this );
+	ASSERT_EXPR( gatesHandle.IsNull() || gatesHandle.GetMathEngine() == this );
+	ASSERT_EXPR( sequenceLength > 0 && sequenceCount > 0 );
+	CCpuExecutionScope scope;
+
+	const CCpuGruDesc& gruDesc = dynamic_cast<const CCpuGruDesc&>( desc );
+	const int hiddenSize = gruDesc.HiddenSize;
+
+	// If the gates are needed for backward the projections of the whole sequences are calculated in their place
+	const int blockLength = gatesHandle.IsNull() ? gruBlockLength( sequenceLength, sequenceCount ) : sequenceLength;
+	CFloatHandleStackVar projectionVar( *this, gatesHandle.IsNull() ? blockLength * sequenceCount * 3 * hiddenSize : 1 );
+	CFloatHandleStackVar stateVar( *this, 2 * sequenceCount * hiddenSize );
+
+	gru( gruDesc, reverse, sequenceLength, sequenceCount,
+		inputStateHandle.IsNull() ? nullptr : GetRaw( inputStateHandle ), GetRaw( inputHandle ),
+		GetRaw( outputHandle ), blockLength, GetRaw( gatesHandle.IsNull() ? projectionVar.GetHandle() : gatesHandle ),
+		GetRaw( stateVar.GetHandle() ) );
+}
+
+void CCpuMathEngine::BidirectionalGru( CGruDesc& directDesc, CGruDesc& reverseDesc, int sequenceLength,
+	int sequenceCount, const CConstFloatHandle& inputHandle, const CFloatHandle& directOutputHandle,
+	const CFloatHandle& reverseOutputHandle, IThreadPool* threadPool )
+{
+	ASSERT_EXPR( inputHandle.GetMathEngine() == this );
+	ASSERT_EXPR( directOutputHandle.GetMathEngine() == this );
+	ASSERT_EXPR( reverseOutputHandle.GetMathEngine() == this );
+	ASSERT_EXPR( sequenceLength > 0 && sequenceCount > 0 );
+	CCpuExecutionScope scope;
+
+	struct CDirectionParams {
+		const CCpuGruDesc* Desc;
+		bool Reverse;
+		float* Output;
+		float* Projection;
+		float* State;
+	};
+	struct CParams {
+		CCpuMathEngine* Engine;
+		int SequenceLength;
+		int SequenceCount;
+		int BlockLength;
+		const float* Input;
+		CDirectionParams Directions[2];
+	};
+
+	const CCpuGruDesc* descs[2] = { &dynamic_cast<const CCpuGruDesc&>( directDesc ),
+		&dynamic_cast<const CCpuGruDesc&>( reverseDesc ) };
+	const int blockLength = gruBlockLength( sequenceLength, sequenceCount );
+	const int projectionSizes[2] = { blockLength * sequenceCount * 3 * descs[0]->HiddenSize,
+		blockLength * sequenceCount * 3 * descs[1]->HiddenSize };
+	const int stateSizes[2] = { 2 * sequenceCount * descs[0]->HiddenSize, 2 * sequenceCount * descs[1]->HiddenSize };
+
+	// The buffers of both directions are allocated here as the stack allocator is separate for each thread
+	CFloatHandleStackVar buffer( *this, projectionSizes[0] + stateSizes[0] + projectionSizes[1] + stateSizes[1] );
+	float* directBuffer = GetRaw( buffer.GetHandle() );
+	float* reverseBuffer = directBuffer + projectionSizes[0] + stateSizes[0];
+
+	CParams params{ this, sequenceLength, sequenceCount, blockLength, GetRaw( inputHandle ), {
+		{ descs[0], false, GetRaw( directOutputHandle ), directBuffer, directBuffer + projectionSizes[0] },
+		{ descs[1], true, GetRaw( reverseOutputHandle ), reverseBuffer, reverseBuffer + projectionSizes[1] } } };
+
+	// The directions are independent so each of them is calculated by its own thread
+	auto task = []( int threadIndex, void* paramsPtr )
+	{
+		CParams& taskParams = *static_cast<CParams*>( paramsPtr );
+		CCpuExecutionScope taskScope;
+		if( threadIndex >= 2 ) {
+			return;
+		}
+		const CDirectionParams& direction = taskParams.Directions[threadIndex];
+		taskParams.Engine->gru( *direction.Desc, direction.Reverse, taskParams.SequenceLength,
+			taskParams.SequenceCount, nullptr, taskParams.Input, direction.Output, taskParams.BlockLength,
+			direction.Projection, direction.State );
+	};
+	if( threadPool == nullptr || threadPool->Size() == 1 ) {
+		task( 0, &params );
+		task( 1, &params );
+	} else {
+		NEOML_NUM_THREADS( *threadPool, &params, task );
+	}
+}
+
+// Calculates GRU over the whole sequences using the given buffers:
+// the projection buffer of blockLength x sequenceCount x 3 * HiddenSize
+// and the state buffer of 2 x sequenceCount x HiddenSize
+void CCpuMathEngine::gru( const CGruDesc& desc, bool reverse, int sequenceLength, int sequenceCount,
+	const float* inputState, const float* input, float* output, int blockLength, float* projection, float* stateBuffer )
+{
+	const CCpuGruDesc& gruDesc = static_cast<const CCpuGruDesc&>( desc );
+	const int hiddenSize = gruDesc.HiddenSize;
+	const int objectSize = gruDesc.ObjectSize;
+	const int projectionWidth = 3 * hiddenSize;
+	const float* inputWeights = GetRaw( gruDesc.InputWeights.GetHandle() );
+	const float* freeTerm = GetRaw( gruDesc.FreeTerm.GetHandle() );
+	const float* recurGateWeights = GetRaw( gruDesc.RecurGateWeights.GetHandle() );
+	const float* recurMainWeights = GetRaw( gruDesc.RecurMainWeights.GetHandle() );
+
+	// The initial state and the reset state multiplied by the reset gate
+	float* initialState = stateBuffer;
+	float* resetState = initialState + sequenceCount * hiddenSize;
+	if( inputState == nullptr ) {
+		vectorFill0( initialState, sequenceCount * hiddenSize );
+	} else {
+		dataCopy( initialState, inputState, sequenceCount * hiddenSize );
+	}
+
+	const float* prevState = initialState;
+	int blockFirstStep = 0;
+	for( int i = 0; i < sequenceLength; ++i ) {
+		const int step = reverse ? sequenceLength - 1 - i : i;
+		if( i % blockLength == 0 ) {
+			// Project the input of the next block of steps (the free terms of all the gates are added here too)
+			const int blockSteps = std::min( blockLength, sequenceLength - i );
+			blockFirstStep = reverse ? step - blockSteps + 1 : step;
+			multiplyMatrixByTransposedMatrix( input + blockFirstStep * sequenceCount * objectSize,
+				blockSteps * sequenceCount, objectSize, objectSize, inputWeights, projectionWidth, objectSize,
+				projection, projectionWidth );
+			addVectorToMatrixRows( projection, projection, blockSteps * sequenceCount, projectionWidth,
+				projectionWidth, projectionWidth, freeTerm );
+		}
+
+		float* stepProjection = projection + ( step - blockFirstStep ) * sequenceCount * projectionWidth;
+		float* state = output + step * sequenceCount * hiddenSize;
+
+		// The update and the reset gates
+		multiplyMatrixByTransposedMatrixAndAdd( prevState, sequenceCount, hiddenSize, hiddenSize,
+			recurGateWeights, 2 * hiddenSize, hiddenSize, stepProjection, projectionWidth );
+		for( int seq = 0; seq < sequenceCount; ++seq ) {
+			gruGates( stepProjection + seq * projectionWidth, prevState + seq * hiddenSize,
+				resetState + seq * hiddenSize, hiddenSize );
+		}
+
+		// The candidate state and the new state
+		multiplyMatrixByTransposedMatrixAndAdd( resetState, sequenceCount, hiddenSize, hiddenSize,
+			recurMainWeights, hiddenSize, hiddenSize, stepProjection + 2 * hiddenSize, projectionWidth );
+		for( int seq = 0; seq < sequenceCount; ++seq ) {
+			float* gates = stepProjection + seq * projectionWidth;
+			gruState( gates, gates + 2 * hiddenSize, prevState + seq * hiddenSize, state + seq * hiddenSize,
+				hiddenSize );
+		}
+		prevState = state;
+	}
+}
+
+// Calculates the diffs of the update gate and the candidate before their nonlinearities for one sequence
+// The stateDiff is replaced with its part passed to the previous state directly
+static void gruUpdateAndCandidateDiff( const float* gates, const float* prevState, float* stateDiff,
+	float* gatesDiff, float* resetState, int hiddenSize )
+{
+	const float* update = gates;
+	const float* reset = gates + hiddenSize;
+	const float* candidate = gates + 2 * hiddenSize;
+	float* updateDiff = gatesDiff;
+	float* candidateDiff = gatesDiff + 2 * hiddenSize;
+	for( int j = 0; j < hiddenSize; ++j ) {
+		const float diff = stateDiff[j];
+		updateDiff[j] = diff * ( prevState[j] - candidate[j] ) * update[j] * ( 1.f - update[j] );
+		candidateDiff[j] = diff * ( 1.f - update[j] ) * ( 1.f - candidate[j] * candidate[j] );
+		stateDiff[j] = diff * update[j];
+		resetState[j] = reset[j] * prevState[j];
+	}
+}
+
+// Calculates the diff of the reset gate before the sigmoid from the diff of the reset state for one sequence
+// The part of the reset state diff passed to the previous state is added to the stateDiff
+static void gruResetDiff( const float* gates, const float* prevState, const float* resetStateDiff,
+	float* stateDiff, float* gatesDiff, int hiddenSize )
+{
+	const float* reset = gates + hiddenSize;
+	float* resetDiff = gatesDiff + hiddenSize;
+	for( int j = 0; j < hiddenSize; ++j ) {
+		resetDiff[j] = resetStateDiff[j] * prevState[j] * reset[j] * ( 1.f - reset[j] );
+		stateDiff[j] += resetStateDiff[j] * reset[j];
+	}
+}
+
+void CCpuMathEngine::GruBackward( CGruDesc& desc, bool reverse, int sequenceLength, int sequenceCount,
+	const CConstFloatHandle& inputStateHandle, const CConstFloatHandle& inputHandle,
+	const CConstFloatHandle& outputHandle, const CConstFloatHandle& gatesHandle,
+	const CConstFloatHandle& outputDiffHandle, const CFloatHandle& inputStateDiffHandle,
+	const CFloatHandle& inputDiffHandle, const CFloatHandle& gateWeightsDiffHandle,
+	const CFloatHandle& gateFreeTermDiffHandle, const CFloatHandle& mainWeightsDiffHandle,
+	const CFloatHandle& mainFreeTermDiffHandle )
+{
+	ASSERT_EXPR( inputStateHandle.IsNull() || inputStateHandle.GetMathEngine() == this );
+	ASSERT_EXPR( inputHandle.GetMathEngine() == this );
+	ASSERT_EXPR( outputHandle.GetMathEngine() == this );
+	ASSERT_EXPR( gatesHandle.GetMathEngine() == this );
+	ASSERT_EXPR( outputDiffHandle.GetMathEngine() == this );
+	ASSERT_EXPR( inputStateDiffHandle.IsNull() || inputStateDiffHandle.GetMathEngine() == this );
+	ASSERT_EXPR( inputDiffHandle.IsNull() || inputDiffHandle.GetMathEngine() == this );
+	ASSERT_EXPR( gateWeightsDiffHandle.IsNull() || gateWeightsDiffHandle.GetMathEngine() == this );
+	ASSERT_EXPR( gateFreeTermDiffHandle.IsNull() || gateFreeTermDiffHandle.GetMathEngine() == this );
+	ASSERT_EXPR( mainWeightsDiffHandle.IsNull() || mainWeightsDiffHandle.GetMathEngine() == this );
+	ASSERT_EXPR( mainFreeTermDiffHandle.IsNull() || mainFreeTermDiffHandle.GetMathEngine() == this );
+	ASSERT_EXPR( sequenceLength > 0 && sequenceCount > 0 );
+	CCpuExecutionScope scope;
+
+	const CCpuGruDesc& gruDesc = dynamic_cast<const CCpuGruDesc&>( desc );
+	const int hiddenSize = gruDesc.HiddenSize;
+	const int objectSize = gruDesc.ObjectSize;
+	const int projectionWidth = 3 * hiddenSize;
+	const int stateSize = sequenceCount * hiddenSize;
+	const int rowCount = sequenceLength * sequenceCount;
+	const float* recurGateWeights = GetRaw( gruDesc.RecurGateWeights.GetHandle() );
+	const float* recurMainWeights = GetRaw( gruDesc.RecurMainWeights.GetHandle() );
+
+	// The diffs of all the gates before the nonlinearities
+	CFloatHandleStackVar gatesDiffVar( *this, rowCount * projectionWidth );
+	float* gatesDiff = GetRaw( gatesDiffVar.GetHandle() );
+	// The previous states multiplied by the reset gate
+	CFloatHandleStackVar resetStatesVar( *this, rowCount * hiddenSize );
+	float* resetStates = GetRaw( resetStatesVar.GetHandle() );
+	// The diff of the state passed to the previous step, the diff of the reset state of the step
+	// and the zero initial state
+	CFloatHandleStackVar stateVar( *this, 3 * stateSize );
+	float* stateDiff = GetRaw( stateVar.GetHandle() );
+	float* resetStateDiff = stateDiff + stateSize;
+	float* zeroState = resetStateDiff + stateSize;
+	vectorFill0( stateDiff, stateSize );
+	vectorFill0( zeroState, stateSize );
+
+	const float* initialState = inputStateHandle.IsNull() ? zeroState : GetRaw( inputStateHandle );
+	const float* output = GetRaw( outputHandle );
+	const float* gates = GetRaw( gatesHandle );
+	const float* outputDiff = GetRaw( outputDiffHandle );
+	for( int i = sequenceLength - 1; i >= 0; --i ) {
+		const int step = reverse ? sequenceLength - 1 - i : i;
+		const float* prevState = i == 0 ? initialState : output + ( reverse ? step + 1 : step - 1 ) * stateSize;
+		const float* stepGates = gates + step * sequenceCount * projectionWidth;
+		float* stepGatesDiff = gatesDiff + step * sequenceCount * projectionWidth;
+		float* stepResetState = resetStates + step * stateSize;
+
+		// The state diff consists of the output diff and the diff passed from the next step
+		vectorAdd( stateDiff, outputDiff + step * stateSize, stateDiff, stateSize );
+		for( int seq = 0; seq < sequenceCount; ++seq ) {
+			gruUpdateAndCandidateDiff( stepGates + seq * projectionWidth, prevState + seq * hiddenSize,
+				stateDiff + seq * hiddenSize, stepGatesDiff + seq * projectionWidth,
+				stepResetState + seq * hiddenSize, hiddenSize );
+		}
+
+		// The candidate depends on the previous state multiplied by the reset gate
+		multiplyMatrixByMatrix( stepGatesDiff + 2 * hiddenSize, sequenceCount, hiddenSize, projectionWidth,
+			recurMainWeights, hiddenSize, hiddenSize, resetStateDiff, hiddenSize );
+		for( int seq = 0; seq < sequenceCount; ++seq ) {
+			gruResetDiff( stepGates + seq * projectionWidth, prevState + seq * hiddenSize,
+				resetStateDiff + seq * hiddenSize, stateDiff + seq * hiddenSize,
+				stepGatesDiff + seq * projectionWidth, hiddenSize );
+		}
+
+		// The update and the reset gates depend on the previous state
+		multiplyMatrixByMatrixAndAdd( stepGatesDiff, sequenceCount, 2 * hiddenSize, projectionWidth,
+			recurGateWeights, hiddenSize, hiddenSize, stateDiff, hiddenSize );
+	}
+
+	if( !inputStateDiffHandle.IsNull() ) {
+		dataCopy( GetRaw( inputStateDiffHandle ), stateDiff, stateSize );
+	}
+	if( !inputDiffHandle.IsNull() ) {
+		multiplyMatrixByMatrix( gatesDiff, rowCount, projectionWidth, projectionWidth,
+			GetRaw( gruDesc.InputWeights.GetHandle() ), objectSize, objectSize, GetRaw( inputDiffHandle ), objectSize );
+	}
+
+	// The weights diffs: the input columns, then the hidden state columns
+	// The previous states are the outputs shifted by one step and the initial state of the first calculated step
+	const float* input = GetRaw( inputHandle );
+	const int weightsWidth = objectSize + hiddenSize;
+	const int firstStep = reverse ? sequenceLength - 1 : 0;
+	const float* shiftedGatesDiff = gatesDiff + ( reverse ? 0 : sequenceCount * projectionWidth );
+	const float* shiftedOutput = output + ( reverse ? stateSize : 0 );
+	if( !gateWeightsDiffHandle.IsNull() ) {
+		float* gateWeightsDiff = GetRaw( gateWeightsDiffHandle );
+		multiplyTransposedMatrixByMatrixAndAdd( gatesDiff, rowCount, 2 * hiddenSize, projectionWidth,
+			input, objectSize, objectSize, gateWeightsDiff, weightsWidth );
+		if( sequenceLength > 1 ) {
+			multiplyTransposedMatrixByMatrixAndAdd( shiftedGatesDiff, rowCount - sequenceCount, 2 * hiddenSize,
+				projectionWidth, shiftedOutput, hiddenSize, hiddenSize, gateWeightsDiff + objectSize, weightsWidth );
+		}
+		if( !inputStateHandle.IsNull() ) {
+			multiplyTransposedMatrixByMatrixAndAdd( gatesDiff + firstStep * sequenceCount * projectionWidth,
+				sequenceCount, 2 * hiddenSize, projectionWidth, initialState, hiddenSize, hiddenSize,
+				gateWeightsDiff + objectSize, weightsWidth );
+		}
+	}
+	if( !mainWeightsDiffHandle.IsNull() ) {
+		float* mainWeightsDiff = GetRaw( mainWeightsDiffHandle );
+		multiplyTransposedMatrixByMatrixAndAdd( gatesDiff + 2 * hiddenSize, rowCount, hiddenSize, projectionWidth,
+			input, objectSize, objectSize, mainWeightsDiff, weightsWidth );
+		multiplyTransposedMatrixByMatrixAndAdd( gatesDiff + 2 * hiddenSize, rowCount, hiddenSize, projectionWidth,
+			resetStates, hiddenSize, hiddenSize, mainWeightsDiff + objectSize, weightsWidth );
+	}
+	if( !gateFreeTermDiffHandle.IsNull() || !mainFreeTermDiffHandle.IsNull() ) {
+		CFloatHandleStackVar freeTermDiffVar( *this, projectionWidth );
+		float* freeTermDiff = GetRaw( freeTermDiffVar.GetHandle() );
+		vectorFill0( freeTermDiff, projectionWidth );
+		sumMatrixRowsAdd( freeTermDiff, gatesDiff, rowCount, projectionWidth );
+		if( !gateFreeTermDiffHandle.IsNull() ) {
+			float* gateFreeTermDiff = GetRaw( gateFreeTermDiffHandle );
+			vectorAdd( gateFreeTermDiff, freeTermDiff, gateFreeTermDiff, 2 * hiddenSize );
+		}
+		if( !mainFreeTermDiffHandle.IsNull() ) {
+			float* mainFreeTermDiff = GetRaw( mainFreeTermDiffHandle );
+			vectorAdd( mainFreeTermDiff, freeTermDiff + 2 * hiddenSize, mainFreeTermDiff, hiddenSize );
+		}
+	}
+}
+
+} // namespace NeoML
@@ -0,0 +1,146 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#include <common.h>
+#pragma hdrstop
+
+#include <CpuMathEngine.h>
+#include <CpuExecutionScope.h>
+#include <CpuMathEnginePrivate.h>
+#include <MemoryHandleInternal.h>
+#include <NeoMathEngine/NeoMathEngineException.h>
+#include <cmath>
+
+namespace NeoML {
+
+// Normalizes one row: the statistics are calculated in a single pass with Welford's algorithm
+static void layerNormRow( const float* input, const float* residual, int width, float epsilon,
+	const float* scale, const float* bias, float* result, float* normalized, float& invStdDev )
+{
+#ifdef NEOML_USE_SSE
+	if( CCPUInfo::HasAvxAndFma && width >= NeoML::Avx2::VectorMathMinSize ) {
+		NeoML::Avx2::layerNormRow( input, residual, width, epsilon, scale, bias, result, normalized, invStdDev );
+		return;
+	}
+#endif
+
+	float mean = 0;
+	float m2 = 0;
+	for( int i = 0; i < width; ++i ) {
+		const float data = residual == nullptr ? input[i] : input[i] + residual[i];
+		const float delta = data - mean;
+		mean += delta / ( i + 1 );
+		m2 += delta * ( data - mean );
+	}
+	invStdDev = 1.f / std::sqrt( m2 / width + epsilon );
+
+	for( int i = 0; i < width; ++i ) {
+		const float norm = ( ( residual == nullptr ? input[i] : input[i] + residual[i] ) - mean ) * invStdDev;
+		if( normalized != nullptr ) {
+			normalized[i] = norm;
+		}
+		result[i] = norm * scale[i] + bias[i];
+	}
+}
+
+// inputDiff = invStdDev * ( diff - mean( diff ) - normalized * mean( diff * normalized ) ), diff = outputDiff * scale
+static void layerNormBackwardRow( const float* normalized, float invStdDev, const float* outputDiff, int width,
+	const float* scale, float* inputDiff )
+{
+#ifdef NEOML_USE_SSE
+	if( CCPUInfo::HasAvxAndFma && width >= NeoML::Avx2::VectorMathMinSize ) {
+		NeoML::Avx2::layerNormBackwardRow( normalized, invStdDev, outputDiff, width, scale, inputDiff );
+		return;
+	}
+#endif
+
+	float diffSum = 0;
+	float normDiffSum = 0;
+	for( int i = 0; i < width; ++i ) {
+		const float diff = outputDiff[i] * scale[i];
+		diffSum += diff;
+		normDiffSum += diff * normalized[i];
+	}
+
+	const float diffMean = diffSum / width;
+	const float normDiffMean = normDiffSum / width;
+	for( int i = 0; i < width; ++i ) {
+		inputDiff[i] = ( outputDiff[i] * scale[i] - diffMean - normalized[i] * normDiffMean ) * invStdDev;
+	}
+}
+
+void CCpuMathEngine::LayerNorm( const CConstFloatHandle& input, const CConstFloatHandle* residual, int height,
+	int width, float epsilon, const CConstFloatHandle& scale, const CConstFloatHandle& bias,
+	const CFloatHandle& result, const CFloatHandle* normalized, const CFloatHandle* invStdDev )
+{
+	ASSERT_EXPR( input.GetMathEngine() == this );
+	ASSERT_EXPR( residual == nullptr || residual->GetMathEngine() == this );
+	ASSERT_EXPR( scale.GetMathEngine() == this );
+	ASSERT_EXPR( bias.GetMathEngine() == this );
+	ASSERT_EXPR( result.GetMathEngine() == this );
+	ASSERT_EXPR( ( normalized == nullptr ) == ( invStdDev == nullptr ) );
+	ASSERT_EXPR( height >= 0 && width > 0 && epsilon > 0 );
+	CCpuExecutionScope scope;
+
+	const float* inputPtr = GetRaw( input );
+	const float* residualPtr = residual == nullptr ? nullptr : GetRaw( *residual );
+	const float* scalePtr = GetRaw( scale );
+	const float* biasPtr = GetRaw( bias );
+	float* resultPtr = GetRaw( result );
+	float* normalizedPtr = normalized == nullptr ? nullptr : GetRaw( *normalized );
+	float* invStdDevPtr = invStdDev == nullptr ? nullptr : GetRaw( *invStdDev );
+
+	for( int row = 0; row < height; ++row ) {
+		float rowInvStdDev = 0;
+		layerNormRow( inputPtr, residualPtr, width, epsilon, scalePtr, biasPtr, resultPtr, normalizedPtr, rowInvStdDev );
+		inputPtr += width;
+		resultPtr += width;
+		if( residualPtr != nullptr ) {
+			residualPtr += width;
+		}
+		if( normalizedPtr != nullptr ) {
+			normalizedPtr += width;
+			invStdDevPtr[row] = rowInvStdDev;
+		}
+	}
+}
+
+void CCpuMathEngine::LayerNormBackward( const CConstFloatHandle& normalized, const CConstFloatHandle& invStdDev,
+	const CConstFloatHandle& outputDiff, int height, int width, const CConstFloatHandle& scale,
+	const CFloatHandle& inputDiff )
+{
+	ASSERT_EXPR( normalized.GetMathEngine() == this );
+	ASSERT_EXPR( invStdDev.GetMathEngine() == this );
+	ASSERT_EXPR( outputDiff.GetMathEngine() == this );
+	ASSERT_EXPR( scale.GetMathEngine() == this );
+	ASSERT_EXPR( inputDiff.GetMathEngine() == this );
+	ASSERT_EXPR( height >= 0 && width > 0 );
+	CCpuExecutionScope scope;
+
+	const float* normalizedPtr = GetRaw( normalized );
+	const float* invStdDevPtr = GetRaw( invStdDev );
+	const float* outputDiffPtr = GetRaw( outputDiff );
+	const float* scalePtr = GetRaw( scale );
+	float* inputDiffPtr = GetRaw( inputDiff );
+
+	for( int row = 0; row < height; ++row ) {
+		layerNormBackwardRow( normalizedPtr, invStdDevPtr[row], outputDiffPtr, width, scalePtr, inputDiffPtr );
+		normalizedPtr += width;
+		outputDiffPtr += width;
+		inputDiffPtr += width;
+	}
+}
+
+} // namespace NeoML
@@ -181,6 +181,11 @@ void CCpuMathEngine::Lstm( CLstmDesc& desc, bool reverse, int sequenceLength, in
 				/*first*/input[bufferIdx * fullyConnectedResult.SequenceLength()], firstHeight, firstWidth, firstWidth,
 				/*second*/lstmDesc.InputWeights, secondHeight, /*secondWidth*/firstWidth,
 				/*result*/fullyConnectedResult[0], resultWidth );
+			// The free terms are added to the whole block at once
+			if( lstmDesc.FreeTerm != nullptr ) {
+				addVectorToMatrixRows( fullyConnectedResult[0], fullyConnectedResult[0],
+					firstHeight, resultWidth, resultWidth, resultWidth, lstmDesc.FreeTerm );
+			}
 		}
 
 		{
@@ -192,10 +197,6 @@ void CCpuMathEngine::Lstm( CLstmDesc& desc, bool reverse, int sequenceLength, in
 				/*second*/lstmDesc.RecurWeights, /*secondWidth*/resultWidth, /*secondWidth*/resultWidth,
 				/*result*/fullyConnectedResult[outputPos], resultWidth );
 		}
-		if( lstmDesc.FreeTerm != nullptr ) {
-			addVectorToMatrixRows( fullyConnectedResult[outputPos], fullyConnectedResult[outputPos],
-				sequenceCount, resultWidth, resultWidth, resultWidth, lstmDesc.FreeTerm );
-		}
 
 		// if outputMainBackLink != output then we are in compatibility mode
 		if( simdMathEngine != nullptr ) {
@@ -26,10 +26,12 @@ limitations under the License.
 #include <MemoryHandleInternal.h>
 
 #include <Rowwise/CpuRowwiseActivation.h>
+#include <Rowwise/CpuRowwiseBatchNorm.h>
 #include <Rowwise/CpuRowwiseBuffer.h>
 #include <Rowwise/CpuRowwiseChConv.h>
 #include <Rowwise/CpuRowwiseChConvWith1x1.h>
 #include <Rowwise/CpuRowwiseConv.h>
+#include <Rowwise/CpuRowwiseEltwiseSum.h>
 #include <Rowwise/CpuRowwiseMobileNetV2.h>
 #include <Rowwise/CpuRowwisePooling.h>
 #include <Rowwise/CpuRowwiseResizeImage.h>
@@ -41,6 +43,10 @@ CBlobDesc CCpuMathEngine::RowwiseReshape( CRowwiseOperationDesc** operations, in
 {
 	CBlobDesc output = input;
 	for( int i = 0; i < operationCount; ++i ) {
+		if( dynamic_cast<CCpuRowwiseEltwiseSum*>( *operations ) != nullptr ) {
+			// The chain input is added to the input of this operation
+			ASSERT_EXPR( output.HasEqualDimensions( input ) );
+		}
 		output = dynamic_cast<ICpuRowwiseImpl*>( *operations )->Reshape( output );
 		++operations;
 	}
@@ -48,6 +54,9 @@ CBlobDesc CCpuMathEngine::RowwiseReshape( CRowwiseOperationDesc** operations, in
 }
 
 static constexpr int RowwiseMaxBuffSize = 32 * 1024;
+// The minimum number of output rows calculated by one thread
+// (the threads recalculate the overlapping rows of the intermediate buffers)
+static constexpr int RowwiseMinRowsPerThread = 8;
 
 typedef std::vector<std::vector<ICpuRowwiseImpl*>> CRowwiseSubchains;
 typedef std::vector<std::unique_ptr<ICpuRowwiseBuffer>> CRowwiseBuffers;
@@ -77,15 +86,51 @@ static int splitIntoSubchains( CRowwiseOperationDesc** operationDescs, int opera
 	return inOperationBufferSize;
 }
 
+// The ranges of rows [FirstRows[i]; EndRows[i]) of each buffer used for calculation
+// (buffer 0 is the chain input, the last one is the chain output)
+struct CRowwiseRowRanges {
+	std::vector<int> FirstRows;
+	std::vector<int> EndRows;
+};
+
+// Calculates the ranges of rows of all the buffers required to calculate the rows [firstRow; endRow) of the output
+// Returns false if some of the operations can't calculate a part of its output independently
+static bool getRowwiseRowRanges( const CRowwiseSubchains& operations, int firstRow, int endRow,
+	CRowwiseRowRanges& ranges )
+{
+	ranges.FirstRows.resize( operations.size() + 1 );
+	ranges.EndRows.resize( operations.size() + 1 );
+	ranges.FirstRows.back() = firstRow;
+	ranges.EndRows.back() = endRow;
+	for( size_t i = operations.size(); i > 0; --i ) {
+		// The trivial operations calculate the same rows
+		for( size_t j = 1; j < operations[i - 1].size(); ++j ) {
+			int trivialFirstRow = 0;
+			int trivialEndRow = 0;
+			if( !operations[i - 1][j]->GetRequiredInputRows( ranges.FirstRows[i], ranges.EndRows[i],
+				trivialFirstRow, trivialEndRow ) )
+			{
+				return false;
+			}
+		}
+		if( !operations[i - 1][0]->GetRequiredInputRows( ranges.FirstRows[i], ranges.EndRows[i],
+			ranges.FirstRows[i - 1], ranges.EndRows[i - 1] ) )
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
 // Allocates rowwise buffers for the current set of operations
 static void allocateRowwiseBuffers( const CBlobDesc& inputDesc, const CRowwiseSubchains& operations,
-	const CFloatHandle& input, const CFloatHandle& output, CRowwiseBuffers& buffers )
+	const CRowwiseRowRanges& ranges, const CFloatHandle& input, const CFloatHandle& output, CRowwiseBuffers& buffers )
 {
 	buffers.reserve( operations.size() + 1 );
 
-	const int inputRowsCount = inputDesc.ObjectCount() * inputDesc.Height();
-	buffers.emplace_back( new CCpuRowwiseWrapper( GetRaw( input ), inputRowsCount,
-		inputDesc.Width() * inputDesc.Channels() ) );
+	const int inputRowSize = inputDesc.Width() * inputDesc.Channels();
+	buffers.emplace_back( new CCpuRowwiseWrapper( GetRaw( input ) + ranges.FirstRows[0] * inputRowSize,
+		ranges.EndRows[0] - ranges.FirstRows[0], inputRowSize, ranges.FirstRows[0] ) );
 	// Each time we try to allocate buffer which meets the output requirement of latest operator
 	// and the input requirement of next operator (skipping operators which don't have such requirements)
 	int prevOutputRequirement = 1;
@@ -111,17 +156,19 @@ static void allocateRowwiseBuffers( const CBlobDesc& inputDesc, const CRowwiseSu
 		}
 
 		const int rowSize = operations[i][0]->OutputRowSize();
-		const int maxRowCount = std::min( operations[i][0]->OutputRowCount(),
+		const int maxRowCount = std::min( ranges.EndRows[i + 1] - ranges.FirstRows[i + 1],
 			std::max( { prevOutputRequirement, nextInputRequirement, RowwiseMaxBuffSize / rowSize } ) );
 		buffers.emplace_back( new CCpuRowwiseBuffer( *input.GetMathEngine(),
-			maxRowCount, rowSize, operations[i][0]->OutputRowCount() ) );
+			maxRowCount, rowSize, ranges.EndRows[i + 1], ranges.FirstRows[i + 1] ) );
 	}
-	buffers.emplace_back( new CCpuRowwiseWrapper( GetRaw( output ), operations.back().back()->OutputRowCount(),
-		operations.back().back()->OutputRowSize() ) );
+	const int outputRowSize = operations.back().back()->OutputRowSize();
+	buffers.emplace_back( new CCpuRowwiseWrapper( GetRaw( output ) + ranges.FirstRows.back() * outputRowSize,
+		ranges.EndRows.back() - ranges.FirstRows.back(), outputRowSize, ranges.FirstRows.back() ) );
 }
 
 // Processes corner case: single subchain which has multiple operations
-void executeSingleSubchain( std::vector<ICpuRowwiseImpl*>& subchain, CRowwiseBuffers& buffers, float* inOperationBuffer )
+static void executeSingleSubchain( std::vector<ICpuRowwiseImpl*>& subchain, CRowwiseBuffers& buffers,
+	float* inOperationBuffer )
 {
 	const int maxOutputRowsPerStep = std::max( 1, RowwiseMaxBuffSize / subchain.back()->OutputRowSize() );
 	while( buffers.back()->EmptyRowCount() > 0 ) {
@@ -149,28 +196,14 @@ void executeSingleSubchain( std::vector<ICpuRowwiseImpl*>& subchain, CRowwiseBuf
 	return;
 }
 
-void CCpuMathEngine::RowwiseExecute( const CBlobDesc& inputDesc, CRowwiseOperationDesc** operationDescs,
-	int operationCount, const CFloatHandle& input, const CFloatHandle& output )
+// Calculates the given ranges of rows of the chain
+static void executeRowwiseRanges( const CBlobDesc& inputDesc, CRowwiseSubchains& operations,
+	float* inOperationBuffer, const CRowwiseRowRanges& ranges, const CFloatHandle& input, const CFloatHandle& output )
 {
-	PRESUME_EXPR( operationCount > 1 );
-	PRESUME_EXPR( inputDesc.Depth() == 1 );
-
-	CCpuExecutionScope scope;
-
-	CRowwiseSubchains operations;
-	int inOperationBufferSize = splitIntoSubchains( operationDescs, operationCount, operations );
-
 	CRowwiseBuffers buffers;
-	allocateRowwiseBuffers( inputDesc, operations, input, output, buffers );
-
-	std::unique_ptr<CFloatHandleStackVar> inOperationBufferVar;
-	float* inOperationBuffer = nullptr;
-	if( inOperationBufferSize > 0 ) {
-		inOperationBufferVar.reset( new CFloatHandleStackVar( *this, static_cast<size_t>( inOperationBufferSize ) ) );
-		inOperationBuffer = GetRaw( inOperationBufferVar->GetHandle() );
-	}
+	allocateRowwiseBuffers( inputDesc, operations, ranges, input, output, buffers );
 
-	buffers.front()->AddRows( inputDesc.ObjectCount() * inputDesc.Height() );
+	buffers.front()->AddRows( ranges.EndRows.front() - ranges.FirstRows.front() );
 
 	if( operations.size() == 1 && operations[0].size() > 1 ) {
 		executeSingleSubchain( operations[0], buffers, inOperationBuffer );
@@ -205,7 +238,7 @@ void CCpuMathEngine::RowwiseExecute( const CBlobDesc& inputDesc, CRowwiseOperati
 			// Significanlty reduces a number of calls with report.OutputRowsCalculated == 0
 			if( buffers[i + 1]->EmptyRowCount() > 0
 				&& ( ( i == 0 && buffers[i]->DataRowCount() > 0 )
-					|| ( i > 0 && buffers[i]->DataRowProcessed() < operations[i - 1][0]->OutputRowCount() ) ) )
+					|| ( i > 0 && buffers[i]->DataRowProcessed() < ranges.EndRows[i] ) ) )
 			{
 				break;
 			}
@@ -213,6 +246,97 @@ void CCpuMathEngine::RowwiseExecute( const CBlobDesc& inputDesc, CRowwiseOperati
 	}
 }
 
+namespace {
+
+// The parameters of the multithreaded rowwise calculation
+struct CRowwiseThreadParams {
+	const CBlobDesc& InputDesc;
+	CRowwiseSubchains& Operations;
+	// The buffers for the operations, InOperationBufferSize for each thread
+	// (allocated by the calling thread because the stack allocator memory of the other threads isn't cleaned up)
+	float* InOperationBuffers;
+	int InOperationBufferSize;
+	int ThreadCount;
+	const CFloatHandle& Input;
+	const CFloatHandle& Output;
+};
+
+} // namespace
+
+// Each thread calculates its own part of the output rows with its own buffers
+// The rows of the intermediate buffers required by several threads are calculated by each of them
+static void rowwiseThreadTask( int threadIndex, void* paramsPtr )
+{
+	CRowwiseThreadParams& params = *static_cast<CRowwiseThreadParams*>( paramsPtr );
+	CCpuExecutionScope scope;
+
+	int firstRow = 0;
+	int rowCount = 0;
+	if( threadIndex >= params.ThreadCount || !GetTaskIndexAndCount( params.ThreadCount, threadIndex,
+		params.Operations.back().back()->OutputRowCount(), firstRow, rowCount ) )
+	{
+		return;
+	}
+
+	CRowwiseRowRanges ranges;
+	const bool isSplittable = getRowwiseRowRanges( params.Operations, firstRow, firstRow + rowCount, ranges );
+	PRESUME_EXPR( isSplittable );
+	( void ) isSplittable;
+	executeRowwiseRanges( params.InputDesc, params.Operations,
+		params.InOperationBuffers + threadIndex * params.InOperationBufferSize, ranges, params.Input, params.Output );
+}
+
+void CCpuMathEngine::RowwiseExecute( const CBlobDesc& inputDesc, CRowwiseOperationDesc** operationDescs,
+	int operationCount, const CFloatHandle& input, const CFloatHandle& output, IThreadPool* threadPool )
+{
+	PRESUME_EXPR( operationCount > 1 );
+	PRESUME_EXPR( inputDesc.Depth() == 1 );
+
+	CCpuExecutionScope scope;
+
+	for( int i = 0; i < operationCount; ++i ) {
+		CCpuRowwiseEltwiseSum* sum = dynamic_cast<CCpuRowwiseEltwiseSum*>( operationDescs[i] );
+		if( sum != nullptr ) {
+			sum->SetSavedBranch( GetRaw( input ) );
+		}
+	}
+
+	CRowwiseSubchains operations;
+	const int inOperationBufferSize = splitIntoSubchains( operationDescs, operationCount, operations );
+
+	const int outputRowCount = operations.back().back()->OutputRowCount();
+	int threadCount = threadPool == nullptr ? 1
+		: std::min( threadPool->Size(), outputRowCount / RowwiseMinRowsPerThread );
+	CRowwiseRowRanges ranges;
+	if( threadCount > 1 && !getRowwiseRowRanges( operations, 0, outputRowCount, ranges ) ) {
+		threadCount = 1;
+	}
+
+	std::unique_ptr<CFloatHandleStackVar> inOperationBufferVar;
+	float* inOperationBuffers = nullptr;
+	if( inOperationBufferSize > 0 ) {
+		inOperationBufferVar.reset( new CFloatHandleStackVar( mathEngine(),
+			static_cast<size_t>( inOperationBufferSize ) * threadCount ) );
+		inOperationBuffers = GetRaw( inOperationBufferVar->GetHandle() );
+	}
+
+	if( threadCount <= 1 ) {
+		// The whole blobs are processed
+		ranges.FirstRows.assign( operations.size() + 1, 0 );
+		ranges.EndRows.resize( operations.size() + 1 );
+		ranges.EndRows.front() = inputDesc.ObjectCount() * inputDesc.Height();
+		for( size_t i = 1; i < ranges.EndRows.size(); ++i ) {
+			ranges.EndRows[i] = operations[i - 1][0]->OutputRowCount();
+		}
+		executeRowwiseRanges( inputDesc, operations, inOperationBuffers, ranges, input, output );
+		return;
+	}
+
+	CRowwiseThreadParams params{ inputDesc, operations, inOperationBuffers, inOperationBufferSize, threadCount,
+		input, output };
+	NEOML_NUM_THREADS( *threadPool, &params, rowwiseThreadTask );
+}
+
 //------------------------------------------------------------------------------------------------------------
 
 CRowwiseOperationDesc* CCpuMathEngine::InitRowwiseActivation( const CActivationDesc& desc )
@@ -334,6 +458,20 @@ CRowwiseOperationDesc* CCpuMathEngine::InitRowwise2DPooling( bool isMax, int fil
 
 //------------------------------------------------------------------------------------------------------------
 
+CRowwiseOperationDesc* CCpuMathEngine::InitRowwiseBatchNormalization( int channels,
+	const CConstFloatHandle& multiplier, const CConstFloatHandle& freeTerm )
+{
+	ASSERT_EXPR( channels > 0 );
+	return new CCpuRowwiseBatchNorm( channels, GetRaw( multiplier ), GetRaw( freeTerm ) );
+}
+
+CRowwiseOperationDesc* CCpuMathEngine::InitRowwiseEltwiseSum()
+{
+	return new CCpuRowwiseEltwiseSum();
+}
+
+//------------------------------------------------------------------------------------------------------------
+
 void CCpuMathEngine::BlobResizeImage( const CBlobDesc& from, const CFloatHandle& fromData, int deltaLeft, int deltaRight,
 	int deltaTop, int deltaBottom, TBlobResizePadding padding, float defaultValue,
 	const CBlobDesc& to, const CFloatHandle& toData )
@@ -0,0 +1,244 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#include <common.h>
+#pragma hdrstop
+
+#include <algorithm>
+
+#include <CpuMathEngine.h>
+#include <CpuMathEnginePrivate.h>
+#include <CpuMathEngineDnnConv.h>
+#include <CpuExecutionScope.h>
+#include <MemoryHandleInternal.h>
+#include <NeoMathEngine/NeoMathEngineException.h>
+
+namespace NeoML {
+
+// The sparse weights in CSR format
+struct CCpuSparseWeightsDesc : public CSparseWeightsDesc {
+	CCpuSparseWeightsDesc( IMathEngine& mathEngine, int height, int width, int elementCount ) :
+		Height( height ),
+		Width( width ),
+		ElementCount( elementCount ),
+		Rows( mathEngine, height + 1 ),
+		Columns( mathEngine, std::max( 1, elementCount ) ),
+		Values( mathEngine, std::max( 1, elementCount ) )
+	{}
+
+	const int Height;
+	const int Width;
+	const int ElementCount;
+	// The non-zero elements of the i-th row are [Rows[i], Rows[i + 1])
+	CIntHandleVar Rows;
+	CIntHandleVar Columns;
+	CFloatHandleVar Values;
+};
+
+// The rows of the first matrix are multiplied by tiles of SparseWeightsTileHeight rows
+// The tile is transposed so that the same column of all its rows is processed by one vector instruction
+static constexpr int SparseWeightsTileHeight = 8;
+// The number of the result elements which are calculated before the epilogue is applied
+static constexpr int SparseWeightsEpilogueSize = 64 * 1024;
+
+// Multiplies the tile (transposed, SparseWeightsTileHeight values for each column) by the transposed sparse matrix
+static void multiplySparseWeightsTile( const float* tile, const CCpuSparseWeightsDesc& desc, const float* freeTerm,
+	float* result )
+{
+	const int* rows = GetRaw( desc.Rows.GetHandle() );
+	const int* columns = GetRaw( desc.Columns.GetHandle() );
+	const float* values = GetRaw( desc.Values.GetHandle() );
+
+#ifdef NEOML_USE_SSE
+	if( CCPUInfo::HasAvxAndFma ) {
+		NeoML::Avx2::sparseWeightsMultiplyTile( tile, desc.Height, rows, columns, values, freeTerm, result );
+		return;
+	}
+#endif
+
+	float acc[SparseWeightsTileHeight];
+	for( int i = 0; i < desc.Height; ++i ) {
+		const float start = freeTerm == nullptr ? 0.f : freeTerm[i];
+		for( int r = 0; r < SparseWeightsTileHeight; ++r ) {
+			acc[r] = start;
+		}
+		for( int k = rows[i]; k < rows[i + 1]; ++k ) {
+			const float* column = tile + columns[k] * SparseWeightsTileHeight;
+			for( int r = 0; r < SparseWeightsTileHeight; ++r ) {
+				acc[r] += values[k] * column[r];
+			}
+		}
+		for( int r = 0; r < SparseWeightsTileHeight; ++r ) {
+			result[r * desc.Height + i] = acc[r];
+		}
+	}
+}
+
+// Multiplies a single row of the first matrix by the transposed sparse matrix
+static void multiplySparseWeightsRow( const float* first, const CCpuSparseWeightsDesc& desc, const float* freeTerm,
+	float* result )
+{
+	const int* rows = GetRaw( desc.Rows.GetHandle() );
+	const int* columns = GetRaw( desc.Columns.GetHandle() );
+	const float* values = GetRaw( desc.Values.GetHandle() );
+
+#ifdef NEOML_USE_SSE
+	if( CCPUInfo::HasAvxAndFma ) {
+		NeoML::Avx2::sparseWeightsMultiplyRow( first, desc.Height, rows, columns, values, freeTerm, result );
+		return;
+	}
+#endif
+
+	for( int i = 0; i < desc.Height; ++i ) {
+		// Several partial sums so that the additions don't wait for each other
+		float sum[4] = { freeTerm == nullptr ? 0.f : freeTerm[i], 0.f, 0.f, 0.f };
+		int k = rows[i];
+		for( ; k + 4 <= rows[i + 1]; k += 4 ) {
+			sum[0] += values[k] * first[columns[k]];
+			sum[1] += values[k + 1] * first[columns[k + 1]];
+			sum[2] += values[k + 2] * first[columns[k + 2]];
+			sum[3] += values[k + 3] * first[columns[k + 3]];
+		}
+		for( ; k < rows[i + 1]; ++k ) {
+			sum[0] += values[k] * first[columns[k]];
+		}
+		result[i] = ( sum[0] + sum[1] ) + ( sum[2] + sum[3] );
+	}
+}
+
+// result = first * T(weights) + freeTerm; tile is the buffer of SparseWeightsTileHeight * (weights width) size
+static void multiplyMatrixBySparseWeights( const float* first, int firstHeight, const CCpuSparseWeightsDesc& desc,
+	const float* freeTerm, float* tile, float* result )
+{
+	int row = 0;
+	for( ; row + SparseWeightsTileHeight <= firstHeight; row += SparseWeightsTileHeight ) {
+		const float* firstTile = first + row * desc.Width;
+		for( int j = 0; j < desc.Width; ++j ) {
+			for( int r = 0; r < SparseWeightsTileHeight; ++r ) {
+				tile[j * SparseWeightsTileHeight + r] = firstTile[r * desc.Width + j];
+			}
+		}
+		multiplySparseWeightsTile( tile, desc, freeTerm, result + row * desc.Height );
+	}
+	for( ; row < firstHeight; ++row ) {
+		multiplySparseWeightsRow( first + row * desc.Width, desc, freeTerm, result + row * desc.Height );
+	}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+CSparseWeightsDesc* CCpuMathEngine::InitSparseWeights( int height, int width, const CConstFloatHandle& weightsHandle )
+{
+	ASSERT_EXPR( height > 0 && width > 0 );
+	ASSERT_EXPR( weightsHandle.GetMathEngine() == this );
+
+	const float* weights = GetRaw( weightsHandle );
+	const int size = height * width;
+	const int elementCount = static_cast<int>( size - std::count( weights, weights + size, 0.f ) );
+
+	CCpuSparseWeightsDesc* desc = new CCpuSparseWeightsDesc( *this, height, width, elementCount );
+	int* rows = GetRaw( desc->Rows.GetHandle() );
+	int* columns = GetRaw( desc->Columns.GetHandle() );
+	float* values = GetRaw( desc->Values.GetHandle() );
+	int index = 0;
+	for( int i = 0; i < height; ++i ) {
+		rows[i] = index;
+		for( int j = 0; j < width; ++j ) {
+			if( weights[i * width + j] != 0.f ) {
+				columns[index] = j;
+				values[index] = weights[i * width + j];
+				++index;
+			}
+		}
+	}
+	rows[height] = index;
+	return desc;
+}
+
+void CCpuMathEngine::MultiplyMatrixBySparseWeightsWithEpilogue( const CConstFloatHandle& firstHandle, int firstHeight,
+	const CSparseWeightsDesc& weights, const CConstFloatHandle* freeTermHandle, const CActivationDesc& activation,
+	const CConstFloatHandle* residualHandle, const CFloatHandle& resultHandle )
+{
+	ASSERT_EXPR( firstHandle.GetMathEngine() == this );
+	ASSERT_EXPR( resultHandle.GetMathEngine() == this );
+	CCpuExecutionScope scope;
+
+	const CCpuSparseWeightsDesc& desc = static_cast<const CCpuSparseWeightsDesc&>( weights );
+	const float* first = GetRaw( firstHandle );
+	const float* freeTerm = freeTermHandle == nullptr ? nullptr : GetRaw( *freeTermHandle );
+	const float* residual = residualHandle == nullptr ? nullptr : GetRaw( *residualHandle );
+	float* result = GetRaw( resultHandle );
+
+	CFloatHandleStackVar tile( mathEngine(), SparseWeightsTileHeight * desc.Width );
+
+	// The epilogue is applied to the horizontal parts of the result
+	const int partHeight = std::max( SparseWeightsTileHeight,
+		SparseWeightsEpilogueSize / desc.Height / SparseWeightsTileHeight * SparseWeightsTileHeight );
+	for( int row = 0; row < firstHeight; row += partHeight ) {
+		const int height = std::min( partHeight, firstHeight - row );
+		const int offset = row * desc.Height;
+		multiplyMatrixBySparseWeights( first + row * desc.Width, height, desc, freeTerm,
+			GetRaw( tile.GetHandle() ), result + offset );
+		applyEpilogue( activation, residual == nullptr ? nullptr : residual + offset, result + offset,
+			height * desc.Height );
+	}
+}
+
+void CCpuMathEngine::BlobConvolutionWithSparseFilter( const CConvolutionDesc& convDesc,
+	const CConstFloatHandle& sourceHandle, const CSparseWeightsDesc& filter, const CConstFloatHandle* freeTermHandle,
+	const CActivationDesc& activation, const CConstFloatHandle* residualHandle, const CFloatHandle& resultHandle )
+{
+	ASSERT_EXPR( sourceHandle.GetMathEngine() == this );
+	ASSERT_EXPR( resultHandle.GetMathEngine() == this );
+	CCpuExecutionScope scope;
+
+	const CCpuConvolutionDesc& desc = static_cast<const CCpuConvolutionDesc&>( convDesc );
+	const CCpuSparseWeightsDesc& filterDesc = static_cast<const CCpuSparseWeightsDesc&>( filter );
+	ASSERT_EXPR( filterDesc.Height == desc.Filter.ObjectCount() );
+	ASSERT_EXPR( filterDesc.Width == desc.Filter.ObjectSize() );
+
+	const float* source = GetRaw( sourceHandle );
+	const float* freeTerm = freeTermHandle == nullptr ? nullptr : GetRaw( *freeTermHandle );
+	const float* residual = residualHandle == nullptr ? nullptr : GetRaw( *residualHandle );
+	float* result = GetRaw( resultHandle );
+
+	// The source pixels are the rows of the temporary matrix if the filter is 1x1 and the stride is 1
+	const bool isSourceMatrix = desc.ForwardAlgo == CA_1x1 && desc.StrideHeight == 1 && desc.StrideWidth == 1;
+	const int resultItemCount = desc.Result.ObjectCount() * desc.Result.Height() * desc.Result.Width();
+	const int filterObjectSize = desc.Filter.ObjectSize();
+	const int filterCount = desc.Filter.ObjectCount();
+	const int cacheItemCount = std::max( SparseWeightsTileHeight, std::min( resultItemCount,
+		ceilTo( BlobConvolutionCacheSize / filterObjectSize, SparseWeightsTileHeight ) ) );
+
+	CFloatHandleStackVar buffer( mathEngine(),
+		( isSourceMatrix ? 0 : cacheItemCount * filterObjectSize ) + SparseWeightsTileHeight * filterObjectSize );
+	float* tile = GetRaw( buffer.GetHandle() );
+	float* tempData = tile + SparseWeightsTileHeight * filterObjectSize;
+
+	for( int index = 0; index < resultItemCount; index += cacheItemCount ) {
+		const int size = std::min( resultItemCount - index, cacheItemCount );
+		const float* first = source + index * filterObjectSize;
+		if( !isSourceMatrix ) {
+			fillTempData( source, tempData, desc, index, size );
+			first = tempData;
+		}
+		const int offset = index * filterCount;
+		multiplyMatrixBySparseWeights( first, size, filterDesc, freeTerm, tile, result + offset );
+		applyEpilogue( activation, residual == nullptr ? nullptr : residual + offset, result + offset,
+			size * filterCount );
+	}
+}
+
+} // namespace NeoML
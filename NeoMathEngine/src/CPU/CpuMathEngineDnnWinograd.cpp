@@ -0,0 +1,230 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#include <common.h>
+#pragma hdrstop
+
+#include <algorithm>
+
+#include <CpuMathEngine.h>
+#include <CpuMathEnginePrivate.h>
+#include <CpuMathEngineDnnConv.h>
+#include <MemoryHandleInternal.h>
+#include <NeoMathEngine/NeoMathEngineException.h>
+
+namespace NeoML {
+
+// Winograd F(2x2, 3x3): each 4x4 tile of the input gives 2x2 tile of the result
+// The convolution becomes 16 independent matrix multiplications of the transformed input by the transformed filter
+//     result = A^T * [ ( G * filter * G^T ) .* ( B^T * input * B ) ] * A
+static constexpr int WinogradTileSize = 4;
+static constexpr int WinogradOutputTileSize = 2;
+static constexpr int WinogradTileArea = WinogradTileSize * WinogradTileSize;
+
+// The 1d transforms of the filter (G), the input (B^T) and the output (A^T)
+static inline void winogradFilterTransform1d( const float* g, int step, float* result, int resultStep )
+{
+	result[0] = g[0];
+	result[resultStep] = ( g[0] + g[step] + g[2 * step] ) / 2;
+	result[2 * resultStep] = ( g[0] - g[step] + g[2 * step] ) / 2;
+	result[3 * resultStep] = g[2 * step];
+}
+
+static inline void winogradInputTransform1d( const float* d, int step, float* result, int resultStep )
+{
+	result[0] = d[0] - d[2 * step];
+	result[resultStep] = d[step] + d[2 * step];
+	result[2 * resultStep] = d[2 * step] - d[step];
+	result[3 * resultStep] = d[step] - d[3 * step];
+}
+
+static inline void winogradOutputTransform1d( const float* m, int step, float* result, int resultStep )
+{
+	result[0] = m[0] + m[step] + m[2 * step];
+	result[resultStep] = m[step] - m[2 * step] - m[3 * step];
+}
+
+// Transforms the filter: the result contains WinogradTileArea matrices of filterCount x channels size
+static void winogradTransformFilter( const float* filter, int filterCount, int channels, float* result )
+{
+	float g[9];
+	float temp[3 * WinogradTileSize];
+	float transformed[WinogradTileArea];
+	for( int f = 0; f < filterCount; ++f ) {
+		for( int c = 0; c < channels; ++c ) {
+			for( int i = 0; i < 9; ++i ) {
+				g[i] = filter[( f * 9 + i ) * channels + c];
+			}
+			for( int col = 0; col < 3; ++col ) {
+				winogradFilterTransform1d( g + col, 3, temp + col, 3 );
+			}
+			for( int row = 0; row < WinogradTileSize; ++row ) {
+				winogradFilterTransform1d( temp + row * 3, 1, transformed + row * WinogradTileSize, 1 );
+			}
+			for( int i = 0; i < WinogradTileArea; ++i ) {
+				result[( i * filterCount + f ) * channels + c] = transformed[i];
+			}
+		}
+	}
+}
+
+// Transforms a single tile of the input; input contains the pointers to WinogradTileArea pixels
+static void winogradTransformInputTile( const float* const* input, int channels, float* result, int resultStride )
+{
+	int start = 0;
+#ifdef NEOML_USE_SSE
+	if( CCPUInfo::HasAvxAndFma && channels >= 8 ) {
+		start = channels - channels % 8;
+		NeoML::Avx2::winogradInputTransform( input, start, result, resultStride );
+	}
+#endif
+
+	float d[WinogradTileArea];
+	float temp[WinogradTileArea];
+	float transformed[WinogradTileArea];
+	for( int c = start; c < channels; ++c ) {
+		for( int i = 0; i < WinogradTileArea; ++i ) {
+			d[i] = input[i][c];
+		}
+		for( int col = 0; col < WinogradTileSize; ++col ) {
+			winogradInputTransform1d( d + col, WinogradTileSize, temp + col, WinogradTileSize );
+		}
+		for( int row = 0; row < WinogradTileSize; ++row ) {
+			winogradInputTransform1d( temp + row * WinogradTileSize, 1, transformed + row * WinogradTileSize, 1 );
+		}
+		for( int i = 0; i < WinogradTileArea; ++i ) {
+			result[i * resultStride + c] = transformed[i];
+		}
+	}
+}
+
+// Transforms a single tile of the result; result contains the pointers to the pixels of the output tile
+static void winogradTransformOutputTile( const float* input, int inputStride, int channels, const float* freeTerm,
+	float* const* result )
+{
+	int start = 0;
+#ifdef NEOML_USE_SSE
+	if( CCPUInfo::HasAvxAndFma && channels >= 8 ) {
+		start = channels - channels % 8;
+		NeoML::Avx2::winogradOutputTransform( input, inputStride, start, freeTerm, result );
+	}
+#endif
+
+	const int outputArea = WinogradOutputTileSize * WinogradOutputTileSize;
+	float m[WinogradTileArea];
+	float temp[WinogradOutputTileSize * WinogradTileSize];
+	float transformed[outputArea];
+	for( int c = start; c < channels; ++c ) {
+		for( int i = 0; i < WinogradTileArea; ++i ) {
+			m[i] = input[i * inputStride + c];
+		}
+		for( int col = 0; col < WinogradTileSize; ++col ) {
+			winogradOutputTransform1d( m + col, WinogradTileSize, temp + col, WinogradTileSize );
+		}
+		for( int row = 0; row < WinogradOutputTileSize; ++row ) {
+			winogradOutputTransform1d( temp + row * WinogradTileSize, 1, transformed + row * WinogradOutputTileSize, 1 );
+		}
+		const float bias = freeTerm == nullptr ? 0.f : freeTerm[c];
+		for( int i = 0; i < outputArea; ++i ) {
+			result[i][c] = transformed[i] + bias;
+		}
+	}
+}
+
+void CCpuMathEngine::blobConvolutionWinograd( const CCpuConvolutionDesc& desc, const float* sourceData,
+	const float* filterData, const float* freeTermData, const CActivationDesc* activation,
+	const float* residualData, float* resultData )
+{
+	const CBlobDesc& source = desc.Source;
+	const CBlobDesc& result = desc.Result;
+	const int channels = source.Channels();
+	const int filterCount = desc.Filter.ObjectCount();
+
+	// The filter is transformed on the first call (the descriptor is recreated when the filter is replaced)
+	if( desc.WinogradFilter == nullptr ) {
+		desc.WinogradFilter.reset( new CFloatHandleVar( mathEngine(), WinogradTileArea * filterCount * channels ) );
+		winogradTransformFilter( filterData, filterCount, channels, GetRaw( desc.WinogradFilter->GetHandle() ) );
+	}
+	const float* transformedFilter = GetRaw( desc.WinogradFilter->GetHandle() );
+
+	const int tileRows = ( result.Height() + WinogradOutputTileSize - 1 ) / WinogradOutputTileSize;
+	const int tileColumns = ( result.Width() + WinogradOutputTileSize - 1 ) / WinogradOutputTileSize;
+	const int imageTileCount = tileRows * tileColumns;
+	const int tileCount = result.ObjectCount() * imageTileCount;
+	// The tiles are processed in blocks so that the transformed data fits into the cache
+	const int blockTileCount = std::max( 1, std::min( tileCount,
+		BlobConvolutionCacheSize / ( WinogradTileArea * ( channels + filterCount ) ) ) );
+
+	// The transformed input and result, the zero pixel for the padding and the pixel for the cropped part of the result
+	CFloatHandleStackVar buffer( mathEngine(),
+		WinogradTileArea * blockTileCount * ( channels + filterCount ) + channels + filterCount );
+	float* transformedInput = GetRaw( buffer.GetHandle() );
+	float* transformedResult = transformedInput + WinogradTileArea * blockTileCount * channels;
+	float* zeroPixel = transformedResult + WinogradTileArea * blockTileCount * filterCount;
+	float* croppedPixel = zeroPixel + channels;
+	vectorFill0( zeroPixel, channels );
+
+	const float* inputPixels[WinogradTileArea];
+	float* resultPixels[WinogradOutputTileSize * WinogradOutputTileSize];
+	for( int blockStart = 0; blockStart < tileCount; blockStart += blockTileCount ) {
+		const int blockSize = std::min( blockTileCount, tileCount - blockStart );
+
+		for( int tile = 0; tile < blockSize; ++tile ) {
+			const int object = ( blockStart + tile ) / imageTileCount;
+			const int tileRow = ( ( blockStart + tile ) % imageTileCount ) / tileColumns;
+			const int tileColumn = ( blockStart + tile ) % tileColumns;
+			const float* image = sourceData + object * source.ObjectSize();
+			for( int i = 0; i < WinogradTileSize; ++i ) {
+				const int y = tileRow * WinogradOutputTileSize - desc.PaddingHeight + i;
+				for( int j = 0; j < WinogradTileSize; ++j ) {
+					const int x = tileColumn * WinogradOutputTileSize - desc.PaddingWidth + j;
+					inputPixels[i * WinogradTileSize + j] = ( y < 0 || y >= source.Height() || x < 0 || x >= source.Width() )
+						? zeroPixel : image + ( y * source.Width() + x ) * channels;
+				}
+			}
+			winogradTransformInputTile( inputPixels, channels, transformedInput + tile * channels,
+				blockTileCount * channels );
+		}
+
+		for( int i = 0; i < WinogradTileArea; ++i ) {
+			multiplyMatrixByTransposedMatrix( transformedInput + i * blockTileCount * channels, blockSize,
+				channels, channels, transformedFilter + i * filterCount * channels, filterCount, channels,
+				transformedResult + i * blockTileCount * filterCount, filterCount );
+		}
+
+		for( int tile = 0; tile < blockSize; ++tile ) {
+			const int object = ( blockStart + tile ) / imageTileCount;
+			const int tileRow = ( ( blockStart + tile ) % imageTileCount ) / tileColumns;
+			const int tileColumn = ( blockStart + tile ) % tileColumns;
+			float* image = resultData + object * result.ObjectSize();
+			for( int i = 0; i < WinogradOutputTileSize; ++i ) {
+				const int y = tileRow * WinogradOutputTileSize + i;
+				for( int j = 0; j < WinogradOutputTileSize; ++j ) {
+					const int x = tileColumn * WinogradOutputTileSize + j;
+					resultPixels[i * WinogradOutputTileSize + j] = ( y >= result.Height() || x >= result.Width() )
+						? croppedPixel : image + ( y * result.Width() + x ) * filterCount;
+				}
+			}
+			winogradTransformOutputTile( transformedResult + tile * filterCount, blockTileCount * filterCount,
+				filterCount, freeTermData, resultPixels );
+		}
+	}
+
+	if( activation != nullptr ) {
+		applyEpilogue( *activation, residualData, resultData, result.BlobSize() );
+	}
+}
+
+} // namespace NeoML
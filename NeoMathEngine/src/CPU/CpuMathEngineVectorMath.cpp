@@ -63,6 +63,66 @@ void CCpuMathEngine::VectorCopy( const CIntHandle& firstHandle, const CConstIntH
 	dataCopy( GetRaw( firstHandle ), GetRaw( secondHandle ), vectorSize );
 }
 
+void CCpuMathEngine::VectorCopy( const CFloat16Handle& firstHandle, const CConstFloat16Handle& secondHandle,
+	int vectorSize )
+{
+	ASSERT_EXPR( firstHandle.GetMathEngine() == this );
+	ASSERT_EXPR( secondHandle.GetMathEngine() == this );
+	CCpuExecutionScope scope;
+
+	::memcpy( GetRaw( firstHandle ), GetRaw( secondHandle ), vectorSize * sizeof( CFloat16 ) );
+}
+
+void CCpuMathEngine::VectorCopy( const CBFloat16Handle& firstHandle, const CConstBFloat16Handle& secondHandle,
+	int vectorSize )
+{
+	ASSERT_EXPR( firstHandle.GetMathEngine() == this );
+	ASSERT_EXPR( secondHandle.GetMathEngine() == this );
+	CCpuExecutionScope scope;
+
+	::memcpy( GetRaw( firstHandle ), GetRaw( secondHandle ), vectorSize * sizeof( CBFloat16 ) );
+}
+
+void CCpuMathEngine::VectorConvert( const CConstFloatHandle& from, const CFloat16Handle& to, int vectorSize )
+{
+	ASSERT_EXPR( from.GetMathEngine() == this );
+	ASSERT_EXPR( to.GetMathEngine() == this );
+	ASSERT_EXPR( vectorSize >= 0 );
+	CCpuExecutionScope scope;
+
+	vectorConvert( GetRaw( from ), GetRaw( to ), vectorSize );
+}
+
+void CCpuMathEngine::VectorConvert( const CConstFloat16Handle& from, const CFloatHandle& to, int vectorSize )
+{
+	ASSERT_EXPR( from.GetMathEngine() == this );
+	ASSERT_EXPR( to.GetMathEngine() == this );
+	ASSERT_EXPR( vectorSize >= 0 );
+	CCpuExecutionScope scope;
+
+	vectorConvert( GetRaw( from ), GetRaw( to ), vectorSize );
+}
+
+void CCpuMathEngine::VectorConvert( const CConstFloatHandle& from, const CBFloat16Handle& to, int vectorSize )
+{
+	ASSERT_EXPR( from.GetMathEngine() == this );
+	ASSERT_EXPR( to.GetMathEngine() == this );
+	ASSERT_EXPR( vectorSize >= 0 );
+	CCpuExecutionScope scope;
+
+	vectorConvert( GetRaw( from ), GetRaw( to ), vectorSize );
+}
+
+void CCpuMathEngine::VectorConvert( const CConstBFloat16Handle& from, const CFloatHandle& to, int vectorSize )
+{
+	ASSERT_EXPR( from.GetMathEngine() == this );
+	ASSERT_EXPR( to.GetMathEngine() == this );
+	ASSERT_EXPR( vectorSize >= 0 );
+	CCpuExecutionScope scope;
+
+	vectorConvert( GetRaw( from ), GetRaw( to ), vectorSize );
+}
+
 //------------------------------------------------------------------------------------------------------------
 
 template<class T>
@@ -875,6 +935,54 @@ void CCpuMathEngine::VectorELU( const CConstFloatHandle& firstHandle, const CFlo
 	vectorELU( GetRaw( firstHandle ), GetRaw( resultHandle ), *GetRaw( alphaHandle ), vectorSize );
 }
 
+void CCpuMathEngine::VectorGELU( const CConstFloatHandle& firstHandle, const CFloatHandle& resultHandle,
+	int vectorSize, CGELUActivationParam::TCalculationMode mode )
+{
+	ASSERT_EXPR( firstHandle.GetMathEngine() == this );
+	ASSERT_EXPR( resultHandle.GetMathEngine() == this );
+	ASSERT_EXPR( mode == CGELUActivationParam::TCalculationMode::CM_Precise
+		|| mode == CGELUActivationParam::TCalculationMode::CM_SigmoidApproximate
+		|| mode == CGELUActivationParam::TCalculationMode::CM_TanhApproximate );
+	CCpuExecutionScope scope;
+
+	vectorGelu( GetRaw( firstHandle ), GetRaw( resultHandle ), vectorSize, mode );
+}
+
+void CCpuMathEngine::VectorGELUDiff( const CConstFloatHandle& firstHandle, const CConstFloatHandle& secondHandle,
+	const CFloatHandle& resultHandle, int vectorSize, CGELUActivationParam::TCalculationMode mode )
+{
+	ASSERT_EXPR( firstHandle.GetMathEngine() == this );
+	ASSERT_EXPR( secondHandle.GetMathEngine() == this );
+	ASSERT_EXPR( resultHandle.GetMathEngine() == this );
+	ASSERT_EXPR( mode == CGELUActivationParam::TCalculationMode::CM_Precise
+		|| mode == CGELUActivationParam::TCalculationMode::CM_SigmoidApproximate
+		|| mode == CGELUActivationParam::TCalculationMode::CM_TanhApproximate );
+	CCpuExecutionScope scope;
+
+	vectorGeluDiff( GetRaw( firstHandle ), GetRaw( secondHandle ), GetRaw( resultHandle ), vectorSize, mode );
+}
+
+void CCpuMathEngine::VectorSiLU( const CConstFloatHandle& firstHandle, const CFloatHandle& resultHandle,
+	int vectorSize )
+{
+	ASSERT_EXPR( firstHandle.GetMathEngine() == this );
+	ASSERT_EXPR( resultHandle.GetMathEngine() == this );
+	CCpuExecutionScope scope;
+
+	vectorSilu( GetRaw( firstHandle ), GetRaw( resultHandle ), vectorSize );
+}
+
+void CCpuMathEngine::VectorSiLUDiff( const CConstFloatHandle& firstHandle, const CConstFloatHandle& secondHandle,
+	const CFloatHandle& resultHandle, int vectorSize )
+{
+	ASSERT_EXPR( firstHandle.GetMathEngine() == this );
+	ASSERT_EXPR( secondHandle.GetMathEngine() == this );
+	ASSERT_EXPR( resultHandle.GetMathEngine() == this );
+	CCpuExecutionScope scope;
+
+	vectorSiluDiff( GetRaw( firstHandle ), GetRaw( secondHandle ), GetRaw( resultHandle ), vectorSize );
+}
+
 void CCpuMathEngine::VectorHardTanh(const CConstFloatHandle& firstHandle, const CFloatHandle& resultHandle, int vectorSize)
 {
 	ASSERT_EXPR( firstHandle.GetMathEngine() == this );
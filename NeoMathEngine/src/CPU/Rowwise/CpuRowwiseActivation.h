@@ -34,6 +34,8 @@ public:
 	int OutputRowCount() const override { return rowCount; }
 	int OutputRowSize() const override { return rowSize; }
 	bool IsTrivial() const override { return true; }
+	bool GetRequiredInputRows( int outputRowIndex, int outputEndRow, int& firstRow, int& endRow ) const override
+		{ firstRow = outputRowIndex; endRow = outputEndRow; return true; }
 	CProcessingReport Process( const float* input, int inputRowIndex, int inputRowsAvailable,
 		float* output, int outputRowIndex, int outputRowsAvailable, float* buffer ) const override;
 
@@ -0,0 +1,81 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <CpuMathEnginePrivate.h>
+#include "CpuRowwiseInterface.h"
+
+namespace NeoML {
+
+// Channel-based batch normalization in inference mode: output = input * multiplier + freeTerm (for every channel)
+class CCpuRowwiseBatchNorm : public ICpuRowwiseImpl, public CRowwiseOperationDesc {
+public:
+	CCpuRowwiseBatchNorm( int channels, const float* multiplier, const float* freeTerm ) :
+		channels( channels ), multiplier( multiplier ), freeTerm( freeTerm ), rowCount( 0 ), rowSize( 0 ) {}
+
+	// ICpuRowwiseImpl
+	CBlobDesc Reshape( const CBlobDesc& inputSize ) override;
+	int InputRowRequirement() const override { return 0; }
+	int OutputRowRequirement() const override { return 0; }
+	int InOperationBufferSize() const override { return 0; }
+	int OutputRowCount() const override { return rowCount; }
+	int OutputRowSize() const override { return rowSize; }
+	bool IsTrivial() const override { return true; }
+	bool GetRequiredInputRows( int outputRowIndex, int outputEndRow, int& firstRow, int& endRow ) const override
+		{ firstRow = outputRowIndex; endRow = outputEndRow; return true; }
+	CProcessingReport Process( const float* input, int inputRowIndex, int inputRowsAvailable,
+		float* output, int outputRowIndex, int outputRowsAvailable, float* buffer ) const override;
+
+private:
+	const int channels;
+	const float* const multiplier;
+	const float* const freeTerm;
+	int rowCount;
+	int rowSize;
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+
+inline CBlobDesc CCpuRowwiseBatchNorm::Reshape( const CBlobDesc& inputSize )
+{
+	ASSERT_EXPR( inputSize.Channels() == channels );
+	rowCount = inputSize.ObjectCount() * inputSize.Height();
+	rowSize = inputSize.Width() * inputSize.Channels();
+	return inputSize;
+}
+
+inline ICpuRowwiseImpl::CProcessingReport CCpuRowwiseBatchNorm::Process( const float* input, int inputRowIndex,
+	int inputRowsAvailable, float* output, int outputRowIndex, int outputRowsAvailable, float* ) const
+{
+	CProcessingReport result;
+	result.OutputRowsCalculated = std::min( outputRowsAvailable, inputRowIndex + inputRowsAvailable - outputRowIndex );
+	result.InputRowsMayBeRemoved = outputRowIndex + result.OutputRowsCalculated - inputRowIndex;
+
+	if( inputRowIndex < outputRowIndex ) {
+		input += ( outputRowIndex - inputRowIndex ) * rowSize;
+	}
+
+	const int pixelCount = result.OutputRowsCalculated * rowSize / channels;
+	for( int i = 0; i < pixelCount; ++i ) {
+		vectorEltwiseMultiply( input, multiplier, output, channels );
+		vectorAdd( output, freeTerm, output, channels );
+		input += channels;
+		output += channels;
+	}
+	return result;
+}
+
+} // namespace NeoML
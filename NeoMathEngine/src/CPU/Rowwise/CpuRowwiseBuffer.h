@@ -65,14 +65,15 @@ public:
 	// data - pointer to the beginning of the buffer
 	// rowCount - number of rows in the buffer
 	// rowSize - size of one row
+	// firstRow - index of the full blob row which is stored at the beginning of the buffer
 	// After the construction it considers itself as a buffer without data
 	// which means DataRowCount() is 0 and EmptyRowCount() is rowCount
 	// It may allocate more than rowCount in order to reduce number of ::memmove calls
-	CCpuRowwiseWrapper( float* data, int rowCount, int rowSize );
+	CCpuRowwiseWrapper( float* data, int rowCount, int rowSize, int firstRow = 0 );
 
 	// ICpuRowwiseBuffer implementation
 	int RowSize() const override { return rowSize; }
-	int DataRowIndex() const override { return removedRows; }
+	int DataRowIndex() const override { return firstRow + removedRows; }
 	int DataRowCount() const override;
 	const float* DataRows() const override;
 	int EmptyRowCount() const override { return rowCount - addedRows; }
@@ -88,6 +89,8 @@ private:
 	const int rowCount;
 	// The size of a signle row
 	const int rowSize;
+	// Index of the full blob row which is stored at the beginning of the buffer
+	const int firstRow;
 	// Number of data rows added to buffer during whole lifetime (never decreases)
 	int addedRows;
 	// Number of data rows removed from buffer during whole lifetime
@@ -99,8 +102,10 @@ private:
 // Allocates and manages memory by itself
 class CCpuRowwiseBuffer : public ICpuRowwiseBuffer {
 public:
-	// It guarantees to allocate at least rowCount rows and at most fullHeight rows
-	CCpuRowwiseBuffer( IMathEngine& mathEngine, int rowCount, int rowSize, int fullHeight );
+	// It guarantees to allocate at least rowCount rows and at most fullHeight - firstRow rows
+	// Only the rows [firstRow; fullHeight) of the full blob pass through the buffer
+	// (used when the blob is split between several threads)
+	CCpuRowwiseBuffer( IMathEngine& mathEngine, int rowCount, int rowSize, int fullHeight, int firstRow = 0 );
 
 	// ICpuRowwiseBuffer implementation
 	int DataRowIndex() const override { return dataRowIndex; }
@@ -119,9 +124,11 @@ private:
 	const int rowCount;
 	// Size of a single row
 	const int rowSize;
-	// Number of rows in full blob (ObjectCount() * Height())
+	// Index of the row after the last one passing through the buffer (ObjectCount() * Height() for the full blob)
 	const int fullHeight;
-	// Number of rows actually allocated for this buffer, somewhere in [rowCount; fullHeight]
+	// Index of the first row passing through the buffer
+	const int firstRow;
+	// Number of rows actually allocated for this buffer, somewhere in [rowCount; fullHeight - firstRow]
 	const int realHeight;
 	// MathEngine variable which contains the allocated memory
 	std::unique_ptr<CFloatHandleVar> bufferVar;
@@ -134,16 +141,17 @@ private:
 	int dataPtrIndex;
 	// Number of data rows in buffer
 	int dataRowsCount;
-	// Index of first data row relative to the full blob [0; fullHeight)
+	// Index of first data row relative to the full blob [firstRow; fullHeight)
 	int dataRowIndex;
 };
 
 //---------------------------------------------------------------------------------------------------------------------
 
-inline CCpuRowwiseWrapper::CCpuRowwiseWrapper( float* data, int rowCount, int rowSize ) :
+inline CCpuRowwiseWrapper::CCpuRowwiseWrapper( float* data, int rowCount, int rowSize, int firstRow ) :
 	firstDataRow( data ),
 	rowCount( rowCount ),
 	rowSize( rowSize ),
+	firstRow( firstRow ),
 	addedRows( 0 ),
 	removedRows( 0 )
 {}
@@ -184,18 +192,21 @@ inline void CCpuRowwiseWrapper::RemoveRows( int count )
 
 //---------------------------------------------------------------------------------------------------------------------
 
-CCpuRowwiseBuffer::CCpuRowwiseBuffer( IMathEngine& mathEngine, int rowCount, int rowSize, int fullHeight ) :
+CCpuRowwiseBuffer::CCpuRowwiseBuffer( IMathEngine& mathEngine, int rowCount, int rowSize, int fullHeight,
+		int firstRow ) :
 	mathEngine( mathEngine ),
 	rowCount( rowCount ),
 	rowSize( rowSize ),
 	fullHeight( fullHeight ),
-	realHeight( std::min( fullHeight, 2 * rowCount ) ),
+	firstRow( firstRow ),
+	realHeight( std::min( fullHeight - firstRow, 2 * rowCount ) ),
 	bufferPtr( nullptr ),
 	dataPtr( nullptr ),
 	dataPtrIndex( 0 ),
 	dataRowsCount( 0 ),
-	dataRowIndex( 0 )
+	dataRowIndex( firstRow )
 {
+	PRESUME_EXPR( firstRow >= 0 && firstRow < fullHeight );
 }
 
 const float* CCpuRowwiseBuffer::DataRows() const
@@ -217,7 +228,7 @@ float* CCpuRowwiseBuffer::EmptyRows()
 		PRESUME_EXPR( bufferVar == nullptr );
 		PRESUME_EXPR( dataRowsCount == 0 );
 		PRESUME_EXPR( dataPtrIndex == 0 );
-		PRESUME_EXPR( dataRowIndex == 0 );
+		PRESUME_EXPR( dataRowIndex == firstRow );
 		bufferVar.reset( new CFloatHandleVar( mathEngine, realHeight * rowSize ) );
 		bufferPtr = GetRaw( bufferVar->GetHandle() );
 		dataPtr = bufferPtr;
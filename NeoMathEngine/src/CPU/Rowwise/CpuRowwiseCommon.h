@@ -33,6 +33,30 @@ inline int RowwiseConvFirstInputRow( int outputRowIndex, int inputImageHeight, i
 		currOutputRowInImage * strideHeight - paddingHeight );
 }
 
+// Index of the input row after the last one needed to calculate first outputRowCount rows of output
+inline int RowwiseConvInputRowEnd( int outputRowCount, int inputImageHeight, int outputImageHeight,
+	int filterHeight, int paddingHeight, int strideHeight, int dilationHeight )
+{
+	const int effectiveFilterSize = 1 + ( filterHeight - 1 ) * dilationHeight;
+	const int lastOutputRowIndex = outputRowCount - 1;
+	const int imageIndex = lastOutputRowIndex / outputImageHeight;
+	const int lastOutputRowInImage = lastOutputRowIndex % outputImageHeight;
+	return imageIndex * inputImageHeight + std::min( inputImageHeight,
+		lastOutputRowInImage * strideHeight - paddingHeight + effectiveFilterSize );
+}
+
+// Calculates the range [firstRow; endRow) of input rows required to calculate [outputRowIndex; outputEndRow) rows
+inline void RowwiseConvRequiredInputRows( int outputRowIndex, int outputEndRow, int inputImageHeight,
+	int outputImageHeight, int filterHeight, int paddingHeight, int strideHeight, int dilationHeight,
+	int& firstRow, int& endRow )
+{
+	PRESUME_EXPR( outputRowIndex < outputEndRow );
+	firstRow = RowwiseConvFirstInputRow( outputRowIndex, inputImageHeight, outputImageHeight,
+		strideHeight, paddingHeight );
+	endRow = RowwiseConvInputRowEnd( outputEndRow, inputImageHeight, outputImageHeight,
+		filterHeight, paddingHeight, strideHeight, dilationHeight );
+}
+
 // Calculates how many output rows can be calculated with the given data
 // and how many input rows can be released after that
 inline ICpuRowwiseImpl::CProcessingReport RowwiseConvProcessingReport( int inputRowIndex, int inputRowsAvailable,
@@ -40,15 +64,11 @@ inline ICpuRowwiseImpl::CProcessingReport RowwiseConvProcessingReport( int input
 	int filterHeight, int paddingHeight, int strideHeight, int dilationHeight )
 {
 	const int inputRowCount = inputRowIndex + inputRowsAvailable;
-	const int effectiveFilterSize = 1 + ( filterHeight - 1 ) * dilationHeight;
 
 	// Number of input rows required to calculate given number of outputRows
 	auto getRequiredInputRows = [&] ( int outputRowCount ) -> int {
-		const int lastOutputRowIndex = outputRowCount - 1;
-		const int imageIndex = lastOutputRowIndex / outputImageHeight;
-		const int lastOutputRowInImage = lastOutputRowIndex % outputImageHeight;
-		return imageIndex * inputImageHeight + std::min( inputImageHeight,
-			lastOutputRowInImage * strideHeight - paddingHeight + effectiveFilterSize );
+		return RowwiseConvInputRowEnd( outputRowCount, inputImageHeight, outputImageHeight,
+			filterHeight, paddingHeight, strideHeight, dilationHeight );
 	};
 
 	// Binary search for number of output rows which can be calculated during this call
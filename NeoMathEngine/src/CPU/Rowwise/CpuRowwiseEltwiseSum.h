@@ -0,0 +1,76 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <CpuMathEnginePrivate.h>
+#include "CpuRowwiseInterface.h"
+
+namespace NeoML {
+
+// Adds the input of the whole chain to the rows (the saved branch of the residual connection)
+// The chain input must be of the same size as the input of this operation
+class CCpuRowwiseEltwiseSum : public ICpuRowwiseImpl, public CRowwiseOperationDesc {
+public:
+	CCpuRowwiseEltwiseSum() : savedBranch( nullptr ), rowCount( 0 ), rowSize( 0 ) {}
+
+	// Sets the input of the chain (is called by RowwiseExecute before the calculation)
+	void SetSavedBranch( const float* data ) { savedBranch = data; }
+
+	// ICpuRowwiseImpl
+	CBlobDesc Reshape( const CBlobDesc& inputSize ) override;
+	int InputRowRequirement() const override { return 0; }
+	int OutputRowRequirement() const override { return 0; }
+	int InOperationBufferSize() const override { return 0; }
+	int OutputRowCount() const override { return rowCount; }
+	int OutputRowSize() const override { return rowSize; }
+	bool IsTrivial() const override { return true; }
+	bool GetRequiredInputRows( int outputRowIndex, int outputEndRow, int& firstRow, int& endRow ) const override
+		{ firstRow = outputRowIndex; endRow = outputEndRow; return true; }
+	CProcessingReport Process( const float* input, int inputRowIndex, int inputRowsAvailable,
+		float* output, int outputRowIndex, int outputRowsAvailable, float* buffer ) const override;
+
+private:
+	const float* savedBranch;
+	int rowCount;
+	int rowSize;
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+
+inline CBlobDesc CCpuRowwiseEltwiseSum::Reshape( const CBlobDesc& inputSize )
+{
+	rowCount = inputSize.ObjectCount() * inputSize.Height();
+	rowSize = inputSize.Width() * inputSize.Channels();
+	return inputSize;
+}
+
+inline ICpuRowwiseImpl::CProcessingReport CCpuRowwiseEltwiseSum::Process( const float* input, int inputRowIndex,
+	int inputRowsAvailable, float* output, int outputRowIndex, int outputRowsAvailable, float* ) const
+{
+	PRESUME_EXPR( savedBranch != nullptr );
+	CProcessingReport result;
+	result.OutputRowsCalculated = std::min( outputRowsAvailable, inputRowIndex + inputRowsAvailable - outputRowIndex );
+	result.InputRowsMayBeRemoved = outputRowIndex + result.OutputRowsCalculated - inputRowIndex;
+
+	if( inputRowIndex < outputRowIndex ) {
+		input += ( outputRowIndex - inputRowIndex ) * rowSize;
+	}
+
+	vectorAdd( input, savedBranch + outputRowIndex * rowSize, output, result.OutputRowsCalculated * rowSize );
+	return result;
+}
+
+} // namespace NeoML
@@ -63,6 +63,13 @@ public:
 	// E.g. most of the activation functions
 	virtual bool IsTrivial() const = 0;
 
+	// Calculates the range [firstRow; endRow) of input rows required to calculate
+	// [outputRowIndex; outputEndRow) rows of output
+	// Returns false if the operation can't calculate an arbitrary part of the output independently
+	// (e.g. it keeps some data between Process calls)
+	// Used for splitting the output between the threads
+	virtual bool GetRequiredInputRows( int outputRowIndex, int outputEndRow, int& firstRow, int& endRow ) const = 0;
+
 	// The result of single rowwise processing
 	struct CProcessingReport {
 		int OutputRowsCalculated = 0; // number of output rows calculated during this call
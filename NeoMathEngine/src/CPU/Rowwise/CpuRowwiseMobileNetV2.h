@@ -59,6 +59,8 @@ public:
 	int OutputRowCount() const override { return desc.Result.ObjectCount() * desc.Result.Height(); }
 	int OutputRowSize() const override { return desc.Result.Width() * outputChannels; }
 	bool IsTrivial() const override { return false; }
+	// The expanded input is kept between the calls so the output can't be split
+	bool GetRequiredInputRows( int, int, int&, int& ) const override { return false; }
 	CProcessingReport Process( const float* input, int inputRowIndex, int inputRowsAvailable,
 		float* output, int outputRowIndex, int outputRowsAvailable, float* buffer ) const override;
 
@@ -39,6 +39,12 @@ public:
 	int OutputRowCount() const override { return desc.Result.ObjectCount() * desc.Result.Height(); }
 	int OutputRowSize() const override { return desc.Result.Width() * desc.Result.Depth() * desc.Result.Channels(); }
 	bool IsTrivial() const override { return false; }
+	bool GetRequiredInputRows( int outputRowIndex, int outputEndRow, int& firstRow, int& endRow ) const override
+	{
+		RowwiseConvRequiredInputRows( outputRowIndex, outputEndRow, desc.Source.Height(), desc.Result.Height(),
+			desc.FilterHeight, 0, desc.StrideHeight, 1, firstRow, endRow );
+		return true;
+	}
 	CProcessingReport Process( const float* input, int inputRowIndex, int inputRowsAvailable,
 		float* output, int outputRowIndex, int outputRowsAvailable, float* buffer ) const override;
 
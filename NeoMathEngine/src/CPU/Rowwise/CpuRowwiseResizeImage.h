@@ -40,6 +40,8 @@ public:
 	int OutputRowCount() const override { return to.ObjectCount() * to.Height(); }
 	int OutputRowSize() const override { return to.Width() * to.Depth() * to.Channels(); }
 	bool IsTrivial() const override { return false; }
+	// The padding makes the mapping between the input and the output rows irregular
+	bool GetRequiredInputRows( int, int, int&, int& ) const override { return false; }
 	CProcessingReport Process( const float* input, int inputRowIndex, int inputRowsAvailable,
 		float* output, int outputRowIndex, int outputRowsAvailable, float* buffer ) const override;
 
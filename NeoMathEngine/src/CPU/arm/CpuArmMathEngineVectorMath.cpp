@@ -1859,11 +1859,7 @@ void CCpuMathEngine::VectorErf( const CConstFloatHandle& firstHandle, const CFlo
 	ASSERT_EXPR( resultHandle.GetMathEngine() == this );
 	CCpuExecutionScope scope;
 
-	const float* first = GetRaw( firstHandle );
-	float* result = GetRaw( resultHandle );
-	for( int i = 0; i < vectorSize; ++i ) {
-		*result++ = std::erff( *first++ );
-	}
+	vectorErf( GetRaw( firstHandle ), GetRaw( resultHandle ), vectorSize );
 }
 
 } // namespace NeoML
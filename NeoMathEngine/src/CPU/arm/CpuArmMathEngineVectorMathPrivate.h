@@ -1005,6 +1005,252 @@ inline void vectorELU( const float* first, float* result, float alpha, int vecto
 	}
 }
 
+//------------------------------------------------------------------------------------------------------------
+
+// Error function
+// The Taylor series is used for |x| < 1 and the Abramowitz and Stegun 7.1.26 approximation otherwise
+inline float32x4_t vectorErfWorker( const float32x4_t& x, const float32x4_t& one, const CExpNeon& expObj )
+{
+	const float32x4_t absX = vabsq_f32( x );
+	const float32x4_t x2 = vmulq_f32( x, x );
+
+	// 2 / sqrt(pi) * sum( (-1)^k * x^(2k + 1) / ( k! * ( 2k + 1 ) ) )
+	float32x4_t series = vdupq_n_f32( -1.2290555301717926e-9f );
+	series = MultiplyAndAddNeon( vdupq_n_f32( 1.4807192815879218e-8f ), series, x2 );
+	series = MultiplyAndAddNeon( vdupq_n_f32( -1.6365844691234924e-7f ), series, x2 );
+	series = MultiplyAndAddNeon( vdupq_n_f32( 1.6462114365889246e-6f ), series, x2 );
+	series = MultiplyAndAddNeon( vdupq_n_f32( -1.4925650358406250e-5f ), series, x2 );
+	series = MultiplyAndAddNeon( vdupq_n_f32( 1.2055332981789664e-4f ), series, x2 );
+	series = MultiplyAndAddNeon( vdupq_n_f32( -8.5483270234508522e-4f ), series, x2 );
+	series = MultiplyAndAddNeon( vdupq_n_f32( 5.2239776254421879e-3f ), series, x2 );
+	series = MultiplyAndAddNeon( vdupq_n_f32( -2.6866170645131252e-2f ), series, x2 );
+	series = MultiplyAndAddNeon( vdupq_n_f32( 1.1283791670955126e-1f ), series, x2 );
+	series = MultiplyAndAddNeon( vdupq_n_f32( -3.7612638903183754e-1f ), series, x2 );
+	series = MultiplyAndAddNeon( vdupq_n_f32( 1.1283791670955126f ), series, x2 );
+	series = vmulq_f32( series, x );
+
+	// 1 - t * ( a1 + t * ( a2 + t * ( a3 + t * ( a4 + t * a5 ) ) ) ) * exp(-x^2), where t = 1 / ( 1 + p * |x| )
+	const float32x4_t t = InvNeon( MultiplyAndAddNeon( one, absX, vdupq_n_f32( 0.3275911f ) ) );
+	float32x4_t poly = vdupq_n_f32( 1.061405429f );
+	poly = MultiplyAndAddNeon( vdupq_n_f32( -1.453152027f ), poly, t );
+	poly = MultiplyAndAddNeon( vdupq_n_f32( 1.421413741f ), poly, t );
+	poly = MultiplyAndAddNeon( vdupq_n_f32( -0.284496736f ), poly, t );
+	poly = MultiplyAndAddNeon( vdupq_n_f32( 0.254829592f ), poly, t );
+	poly = vmulq_f32( poly, t );
+	float32x4_t approximation = vmlsq_f32( one, poly, expObj.Execute( vnegq_f32( x2 ) ) );
+	// Copy the sign of x
+	approximation = vbslq_f32( vdupq_n_u32( 0x80000000 ), x, approximation );
+
+	return ConditionNeon( vcltq_f32( absX, one ), series, approximation );
+}
+
+inline void vectorErf( const float* first, float* result, int vectorSize )
+{
+	const float32x4_t one = vdupq_n_f32( 1.f );
+	const CExpNeon expObj;
+
+	while( vectorSize >= 4 ) {
+		StoreNeon4( vectorErfWorker( LoadNeon4( first ), one, expObj ), result );
+
+		first += 4;
+		result += 4;
+		vectorSize -= 4;
+	}
+
+	if( vectorSize > 0 ) {
+		StoreNeon( vectorErfWorker( LoadNeon( first, vectorSize ), one, expObj ), result, vectorSize );
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------
+
+// The constants for GELU
+static constexpr float GeluSqrt2Inv = 0.707106781186547524f;
+static constexpr float GeluSqrt2PiInv = 0.398942280401432678f;
+static constexpr float GeluApproximationMultiplier = 1.702f;
+static constexpr float GeluSqrt2PiScale = 0.797884560802865356f; // sqrt(2/pi)
+static constexpr float GeluTanhCubicCoeff = 0.044715f;
+
+// x * 0.5( 1 + erf( x / sqrt(2) ) ), x * sigmoid(1.702x) or x * 0.5( 1 + tanh( sqrt(2/pi)( x + 0.044715x^3 ) ) )
+inline float32x4_t vectorGeluWorker( const float32x4_t& x, CGELUActivationParam::TCalculationMode mode,
+	const float32x4_t& half, const float32x4_t& one, const CExpNeon& expObj )
+{
+	switch( mode ) {
+		case CGELUActivationParam::TCalculationMode::CM_Precise:
+		{
+			const float32x4_t erf = vectorErfWorker( vmulq_n_f32( x, GeluSqrt2Inv ), one, expObj );
+			return vmulq_f32( x, MultiplyAndAddNeon( half, erf, half ) );
+		}
+		case CGELUActivationParam::TCalculationMode::CM_TanhApproximate:
+		{
+			const float32x4_t inner = vmulq_f32( x, MultiplyAndAddNeon( vdupq_n_f32( GeluSqrt2PiScale ),
+				vmulq_f32( x, x ), vdupq_n_f32( GeluSqrt2PiScale * GeluTanhCubicCoeff ) ) );
+			return vmulq_f32( x, MultiplyAndAddNeon( half, vectorTanhWorker( inner, one, expObj ), half ) );
+		}
+		default:
+			return vmulq_f32( x, vectorSigmoidWorker( vmulq_n_f32( x, GeluApproximationMultiplier ), one, expObj ) );
+	}
+}
+
+inline void vectorGelu( const float* first, float* result, int vectorSize, CGELUActivationParam::TCalculationMode mode )
+{
+	const float32x4_t half = vdupq_n_f32( 0.5f );
+	const float32x4_t one = vdupq_n_f32( 1.f );
+	const CExpNeon expObj;
+
+	while( vectorSize >= 4 ) {
+		StoreNeon4( vectorGeluWorker( LoadNeon4( first ), mode, half, one, expObj ), result );
+
+		first += 4;
+		result += 4;
+		vectorSize -= 4;
+	}
+
+	if( vectorSize > 0 ) {
+		StoreNeon( vectorGeluWorker( LoadNeon( first, vectorSize ), mode, half, one, expObj ), result, vectorSize );
+	}
+}
+
+// GELU'(x): 0.5( 1 + erf( x / sqrt(2) ) ) + x / sqrt(2pi) * e^( -x^2 / 2 ),
+// sigmoid(1.702x) + 1.702x * sigmoid(1.702x) * ( 1 - sigmoid(1.702x) )
+// or 0.5( 1 + tanh(u) ) + 0.5x * ( 1 - tanh(u)^2 ) * u', where u = sqrt(2/pi)( x + 0.044715x^3 )
+inline float32x4_t vectorGeluDiffWorker( const float32x4_t& x, CGELUActivationParam::TCalculationMode mode,
+	const float32x4_t& half, const float32x4_t& one, const CExpNeon& expObj )
+{
+	switch( mode ) {
+		case CGELUActivationParam::TCalculationMode::CM_Precise:
+		{
+			const float32x4_t erf = vectorErfWorker( vmulq_n_f32( x, GeluSqrt2Inv ), one, expObj );
+			const float32x4_t pdf = vmulq_n_f32( expObj.Execute( vmulq_f32( vmulq_f32( x, x ), vnegq_f32( half ) ) ),
+				GeluSqrt2PiInv );
+			return MultiplyAndAddNeon( MultiplyAndAddNeon( half, erf, half ), x, pdf );
+		}
+		case CGELUActivationParam::TCalculationMode::CM_TanhApproximate:
+		{
+			const float32x4_t x2 = vmulq_f32( x, x );
+			const float32x4_t inner = vmulq_f32( x, MultiplyAndAddNeon( vdupq_n_f32( GeluSqrt2PiScale ),
+				x2, vdupq_n_f32( GeluSqrt2PiScale * GeluTanhCubicCoeff ) ) );
+			const float32x4_t innerDiff = MultiplyAndAddNeon( vdupq_n_f32( GeluSqrt2PiScale ),
+				x2, vdupq_n_f32( 3.f * GeluSqrt2PiScale * GeluTanhCubicCoeff ) );
+			// 1 - tanh(u)^2 = 4 * sigmoid(2u) * e^(-2u) * sigmoid(2u) has no cancellation near +-1
+			const float32x4_t exp = expObj.Execute( vmulq_n_f32( inner, -2.f ) );
+			const float32x4_t sigmoid = InvNeon( vaddq_f32( one, exp ) );
+			const float32x4_t tanhDiff = vmulq_f32( vmulq_f32( vmulq_n_f32( sigmoid, 4.f ), sigmoid ), exp );
+			return MultiplyAndAddNeon( sigmoid, vmulq_f32( x, half ), vmulq_f32( tanhDiff, innerDiff ) );
+		}
+		default:
+		{
+			const float32x4_t scaled = vmulq_n_f32( x, GeluApproximationMultiplier );
+			const float32x4_t sigmoid = vectorSigmoidWorker( scaled, one, expObj );
+			return MultiplyAndAddNeon( sigmoid, scaled, vmlsq_f32( sigmoid, sigmoid, sigmoid ) );
+		}
+	}
+}
+
+// outputDiff * GELU'(x)
+inline void vectorGeluDiff( const float* first, const float* outputDiff, float* result, int vectorSize,
+	CGELUActivationParam::TCalculationMode mode )
+{
+	const float32x4_t half = vdupq_n_f32( 0.5f );
+	const float32x4_t one = vdupq_n_f32( 1.f );
+	const CExpNeon expObj;
+
+	while( vectorSize >= 4 ) {
+		const float32x4_t diff = vectorGeluDiffWorker( LoadNeon4( first ), mode, half, one, expObj );
+		StoreNeon4( vmulq_f32( diff, LoadNeon4( outputDiff ) ), result );
+
+		first += 4;
+		outputDiff += 4;
+		result += 4;
+		vectorSize -= 4;
+	}
+
+	if( vectorSize > 0 ) {
+		const float32x4_t diff = vectorGeluDiffWorker( LoadNeon( first, vectorSize ), mode, half, one, expObj );
+		StoreNeon( vmulq_f32( diff, LoadNeon( outputDiff, vectorSize ) ), result, vectorSize );
+	}
+}
+
+// x * sigmoid(x)
+inline void vectorSilu( const float* first, float* result, int vectorSize )
+{
+	const float32x4_t one = vdupq_n_f32( 1.f );
+	const CExpNeon expObj;
+
+	while( vectorSize >= 4 ) {
+		const float32x4_t x = LoadNeon4( first );
+		StoreNeon4( vmulq_f32( x, vectorSigmoidWorker( x, one, expObj ) ), result );
+
+		first += 4;
+		result += 4;
+		vectorSize -= 4;
+	}
+
+	if( vectorSize > 0 ) {
+		const float32x4_t x = LoadNeon( first, vectorSize );
+		StoreNeon( vmulq_f32( x, vectorSigmoidWorker( x, one, expObj ) ), result, vectorSize );
+	}
+}
+
+// SiLU'(x) = sigmoid(x) + x * sigmoid(x) * ( 1 - sigmoid(x) )
+inline float32x4_t vectorSiluDiffWorker( const float32x4_t& x, const float32x4_t& one, const CExpNeon& expObj )
+{
+	const float32x4_t sigmoid = vectorSigmoidWorker( x, one, expObj );
+	return MultiplyAndAddNeon( sigmoid, x, vmlsq_f32( sigmoid, sigmoid, sigmoid ) );
+}
+
+// outputDiff * SiLU'(x)
+inline void vectorSiluDiff( const float* first, const float* outputDiff, float* result, int vectorSize )
+{
+	const float32x4_t one = vdupq_n_f32( 1.f );
+	const CExpNeon expObj;
+
+	while( vectorSize >= 4 ) {
+		StoreNeon4( vmulq_f32( vectorSiluDiffWorker( LoadNeon4( first ), one, expObj ), LoadNeon4( outputDiff ) ),
+			result );
+
+		first += 4;
+		outputDiff += 4;
+		result += 4;
+		vectorSize -= 4;
+	}
+
+	if( vectorSize > 0 ) {
+		StoreNeon( vmulq_f32( vectorSiluDiffWorker( LoadNeon( first, vectorSize ), one, expObj ),
+			LoadNeon( outputDiff, vectorSize ) ), result, vectorSize );
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------
+
+inline void vectorConvert( const float* from, CFloat16* to, int vectorSize )
+{
+	for( int i = 0; i < vectorSize; ++i ) {
+		to[i] = CFloat16::FromFloat( from[i] );
+	}
+}
+
+inline void vectorConvert( const CFloat16* from, float* to, int vectorSize )
+{
+	for( int i = 0; i < vectorSize; ++i ) {
+		to[i] = from[i].ToFloat();
+	}
+}
+
+inline void vectorConvert( const float* from, CBFloat16* to, int vectorSize )
+{
+	for( int i = 0; i < vectorSize; ++i ) {
+		to[i] = CBFloat16::FromFloat( from[i] );
+	}
+}
+
+inline void vectorConvert( const CBFloat16* from, float* to, int vectorSize )
+{
+	for( int i = 0; i < vectorSize; ++i ) {
+		to[i] = from[i].ToFloat();
+	}
+}
+
 } // namespace NeoML
 
 #endif // NEOML_USE_NEON
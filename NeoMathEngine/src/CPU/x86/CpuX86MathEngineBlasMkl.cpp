@@ -51,6 +51,55 @@ static constexpr CCPUInfo CpuInfo( 0x60000, 0x180000, 0x900000 );
 
 namespace NeoML {
 
+// Calculates the product of the firstHeight x firstWidth matrix and the firstWidth x secondWidth matrix
+// (or the transposed secondWidth x firstWidth one) by the given implementation
+// The product is added to the result if add is true
+static void sgemm( TAutoTuningGemm backend, SgemmFunc jitSgemm, CCpuMathEngine* engine, bool transposeSecond,
+	bool add, const float* first, int firstRowSize, const float* second, int secondRowSize,
+	float* result, int resultRowSize, int firstHeight, int firstWidth, int secondWidth )
+{
+	switch( backend ) {
+		case ATG_Jit:
+			if( !add ) {
+				nullify( result, firstHeight, secondWidth, resultRowSize );
+			}
+			jitSgemm( false, transposeSecond, engine, first, firstRowSize, second, secondRowSize,
+				result, resultRowSize, firstHeight, secondWidth, firstWidth );
+			return;
+#ifdef NEOML_USE_MKL
+		case ATG_Mkl:
+			cblas_sgemm( CblasRowMajor, CblasNoTrans, transposeSecond ? CblasTrans : CblasNoTrans,
+				firstHeight, secondWidth, firstWidth, 1.f, first, firstRowSize, second, secondRowSize,
+				add ? 1.f : 0.f, result, resultRowSize );
+			return;
+#endif // NEOML_USE_MKL
+#ifdef NEOML_USE_MLAS
+		case ATG_Mlas:
+			MlasGemm( MlasNoTrans, transposeSecond ? MlasTrans : MlasNoTrans, static_cast<size_t>( firstHeight ),
+				static_cast<size_t>( secondWidth ), static_cast<size_t>( firstWidth ), 1, first,
+				static_cast<size_t>( firstRowSize ), second, static_cast<size_t>( secondRowSize ), add ? 1.f : 0.f,
+				result, static_cast<size_t>( resultRowSize ), nullptr );
+			return;
+#endif // NEOML_USE_MLAS
+#ifndef NEOML_USE_MKL
+		case ATG_Own:
+			if( !add ) {
+				nullify( result, firstHeight, secondWidth, resultRowSize );
+			}
+			if( transposeSecond ) {
+				MultiplyMatrix<false, true, CTmpMemoryHandler>( engine, CpuInfo, first, firstRowSize, second,
+					secondRowSize, result, resultRowSize, firstHeight, secondWidth, firstWidth );
+			} else {
+				MultiplyMatrix<false, false, CTmpMemoryHandler>( engine, CpuInfo, first, firstRowSize, second,
+					secondRowSize, result, resultRowSize, firstHeight, secondWidth, firstWidth );
+			}
+			return;
+#endif // !NEOML_USE_MKL
+		default:
+			ASSERT_EXPR( false );
+	}
+}
+
 void CCpuMathEngine::multiplyMatrixByMatrix( const float* first, int firstHeight,
 	int firstWidth, int firstRowSize, const float* second, int secondWidth, int secondRowSize,
 	float* result, int resultRowSize )
@@ -59,33 +108,8 @@ void CCpuMathEngine::multiplyMatrixByMatrix( const float* first, int firstHeight
 	ASSERT_EXPR( secondWidth <= secondRowSize );
 	ASSERT_EXPR( secondWidth <= resultRowSize );
 
-	if( customSgemmFunction != nullptr ) {
-		nullify( result, firstHeight, secondWidth, resultRowSize );
-		customSgemmFunction( false, false, this, first, firstRowSize, second, secondRowSize,
-			result, resultRowSize, firstHeight, secondWidth, firstWidth );
-	} else {
-#if defined( NEOML_USE_MKL ) && defined( NEOML_USE_MLAS )
-		if( CCPUInfo::IsNotIntel ) {
-			MlasGemm( MlasNoTrans, MlasNoTrans, static_cast<size_t>( firstHeight ), static_cast<size_t>( secondWidth ),
-				static_cast<size_t>( firstWidth ), 1, first, static_cast<size_t>( firstRowSize ), second,
-				static_cast<size_t>( secondRowSize ), 0, result, static_cast<size_t>( resultRowSize ), nullptr );
-		} else {
-			cblas_sgemm( CblasRowMajor, CblasNoTrans, CblasNoTrans, firstHeight, secondWidth, firstWidth,
-				1.f, first, firstRowSize, second, secondRowSize, 0.f, result, resultRowSize );
-		}
-#elif defined( NEOML_USE_MKL )
-			cblas_sgemm( CblasRowMajor, CblasNoTrans, CblasNoTrans, firstHeight, secondWidth, firstWidth,
-				1.f, first, firstRowSize, second, secondRowSize, 0.f, result, resultRowSize );
-#elif defined( NEOML_USE_MLAS )
-		MlasGemm( MlasNoTrans, MlasNoTrans, static_cast<size_t>( firstHeight ), static_cast<size_t>( secondWidth ),
-			static_cast<size_t>( firstWidth ), 1, first, static_cast<size_t>( firstRowSize ), second,
-			static_cast<size_t>( secondRowSize ), 0, result, static_cast<size_t>( resultRowSize ), nullptr );
-#else // !NEOML_USE_MKL && !NEOML_USE_MLAS
-		nullify( result, firstHeight, secondWidth, resultRowSize );
-		MultiplyMatrix<false, false, CTmpMemoryHandler>( this, CpuInfo, first, firstRowSize, second, secondRowSize,
-			result, resultRowSize, firstHeight, secondWidth, firstWidth );
-#endif // !NEOML_USE_MKL && !NEOML_USE_MLAS
-	}
+	sgemm( getGemmBackend(), customSgemmFunction, this, /*transposeSecond*/false, /*add*/false, first, firstRowSize,
+		second, secondRowSize, result, resultRowSize, firstHeight, firstWidth, secondWidth );
 }
 
 void CCpuMathEngine::multiplyMatrixByMatrixAndAdd( const float* first, int firstHeight,
@@ -95,31 +119,8 @@ void CCpuMathEngine::multiplyMatrixByMatrixAndAdd( const float* first, int first
 	ASSERT_EXPR( firstWidth <= firstRowSize );
 	ASSERT_EXPR( secondWidth <= resultRowSize );
 
-	if( customSgemmFunction != nullptr ) {
-		customSgemmFunction( false, false, this, first, firstRowSize, second, secondRowSize,
-			result, resultRowSize, firstHeight, secondWidth, firstWidth );
-	} else {
-#if defined( NEOML_USE_MKL ) && defined( NEOML_USE_MLAS )
-		if( CCPUInfo::IsNotIntel ) {
-			MlasGemm( MlasNoTrans, MlasNoTrans, static_cast<size_t>( firstHeight ), static_cast<size_t>( secondWidth ),
-				static_cast<size_t>( firstWidth ), 1, first, static_cast<size_t>( firstRowSize ), second,
-				static_cast<size_t>( secondRowSize ), 1, result, static_cast<size_t>( resultRowSize ), nullptr );
-		} else {
-			cblas_sgemm( CblasRowMajor, CblasNoTrans, CblasNoTrans, firstHeight, secondWidth, firstWidth,
-				1.f, first, firstRowSize, second, secondRowSize, 1.f, result, resultRowSize );
-		}
-#elif defined( NEOML_USE_MKL )
-			cblas_sgemm( CblasRowMajor, CblasNoTrans, CblasNoTrans, firstHeight, secondWidth, firstWidth,
-				1.f, first, firstRowSize, second, secondRowSize, 1.f, result, resultRowSize );
-#elif defined( NEOML_USE_MLAS )
-		MlasGemm( MlasNoTrans, MlasNoTrans, static_cast<size_t>( firstHeight ), static_cast<size_t>( secondWidth ),
-			static_cast<size_t>( firstWidth ), 1, first, static_cast<size_t>( firstRowSize ), second,
-			static_cast<size_t>( secondRowSize ), 1, result, static_cast<size_t>( resultRowSize ), nullptr );
-#else // !NEOML_USE_MKL && !NEOML_USE_MLAS
-		MultiplyMatrix<false, false, CTmpMemoryHandler>( this, CpuInfo, first, firstRowSize, second, secondRowSize,
-			result, resultRowSize, firstHeight, secondWidth, firstWidth );
-#endif // !NEOML_USE_MKL && !NEOML_USE_MLAS
-	}
+	sgemm( getGemmBackend(), customSgemmFunction, this, /*transposeSecond*/false, /*add*/true, first, firstRowSize,
+		second, secondRowSize, result, resultRowSize, firstHeight, firstWidth, secondWidth );
 }
 
 void CCpuMathEngine::multiplyMatrixByTransposedMatrix( const float* first, int firstHeight,
@@ -129,64 +130,16 @@ void CCpuMathEngine::multiplyMatrixByTransposedMatrix( const float* first, int f
 	ASSERT_EXPR(firstWidth <= firstRowSize);
 	ASSERT_EXPR(firstWidth <= secondRowSize);
 
-	if( customSgemmFunction != nullptr ) {
-		nullify( result, firstHeight, secondHeight, resultRowSize );
-		customSgemmFunction( false, true, this, first, firstRowSize, second, secondRowSize,
-			result, resultRowSize, firstHeight, secondHeight, firstWidth );
-	} else {
-#if defined( NEOML_USE_MKL ) && defined( NEOML_USE_MLAS )
-		if( CCPUInfo::IsNotIntel ) {
-			MlasGemm( MlasNoTrans, MlasTrans, static_cast<size_t>( firstHeight ), static_cast<size_t>( secondHeight ),
-				static_cast<size_t>( firstWidth ), 1, first, static_cast<size_t>( firstRowSize ), second,
-				static_cast<size_t>( secondRowSize ), 0, result, static_cast<size_t>( resultRowSize ), nullptr );
-		} else {
-			cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasTrans, firstHeight, secondHeight, firstWidth,
-				1.f, first, firstRowSize, second, secondRowSize, 0.f, result, resultRowSize);
-		}
-#elif defined( NEOML_USE_MKL )
-			cblas_sgemm( CblasRowMajor, CblasNoTrans, CblasTrans, firstHeight, secondHeight, firstWidth,
-				1.f, first, firstRowSize, second, secondRowSize, 0.f, result, resultRowSize );
-#elif defined( NEOML_USE_MLAS )
-		MlasGemm( MlasNoTrans, MlasTrans, static_cast<size_t>( firstHeight ), static_cast<size_t>( secondHeight ),
-			static_cast<size_t>( firstWidth ), 1, first, static_cast<size_t>( firstRowSize ), second,
-			static_cast<size_t>( secondRowSize ), 0, result, static_cast<size_t>( resultRowSize ), nullptr );
-#else // !NEOML_USE_MKL && !NEOML_USE_MLAS
-		nullify( result, firstHeight, secondHeight, resultRowSize );
-		MultiplyMatrix<false, true, CTmpMemoryHandler>( this, CpuInfo, first, firstRowSize, second, secondRowSize,
-			result, resultRowSize, firstHeight, secondHeight, firstWidth );
-#endif // !NEOML_USE_MKL && !NEOML_USE_MLAS
-	}
+	sgemm( getGemmBackend(), customSgemmFunction, this, /*transposeSecond*/true, /*add*/false, first, firstRowSize,
+		second, secondRowSize, result, resultRowSize, firstHeight, firstWidth, secondHeight );
 }
 
 void CCpuMathEngine::multiplyMatrixByTransposedMatrixAndAdd( const float* first, int firstHeight,
 	int firstWidth, int firstRowSize, const float* second, int secondHeight, int secondRowSize,
 	float* result, int resultRowSize )
 {
-	if( customSgemmFunction != nullptr ) {
-		customSgemmFunction( false, true, this, first, firstRowSize, second, secondRowSize,
-			result, resultRowSize, firstHeight, secondHeight, firstWidth );
-	} else {
-#if defined( NEOML_USE_MKL ) && defined( NEOML_USE_MLAS )
-		if( CCPUInfo::IsNotIntel ) {
-			MlasGemm( MlasNoTrans, MlasTrans, static_cast<size_t>( firstHeight ), static_cast<size_t>( secondHeight ),
-				static_cast<size_t>( firstWidth ), 1, first, static_cast<size_t>( firstRowSize ), second,
-				static_cast<size_t>( secondRowSize ), 1, result, static_cast<size_t>( resultRowSize ), nullptr );
-		} else {
-			cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasTrans, firstHeight, secondHeight, firstWidth,
-				1.f, first, firstRowSize, second, secondRowSize, 1.f, result, resultRowSize);
-		}
-#elif defined( NEOML_USE_MKL )
-			cblas_sgemm( CblasRowMajor, CblasNoTrans, CblasTrans, firstHeight, secondHeight, firstWidth,
-				1.f, first, firstRowSize, second, secondRowSize, 1.f, result, resultRowSize );
-#elif defined( NEOML_USE_MLAS )
-		MlasGemm( MlasNoTrans, MlasTrans, static_cast<size_t>( firstHeight ), static_cast<size_t>( secondHeight ),
-			static_cast<size_t>( firstWidth ), 1, first, static_cast<size_t>( firstRowSize ), second,
-			static_cast<size_t>( secondRowSize ), 1, result, static_cast<size_t>( resultRowSize ), nullptr );
-#else  // !NEOML_USE_MKL && !NEOML_USE_MLAS
-		MultiplyMatrix<false, true, CTmpMemoryHandler>( this, CpuInfo, first, firstRowSize, second, secondRowSize,
-			result, resultRowSize, firstHeight, secondHeight, firstWidth );
-#endif // !NEOML_USE_MKL && !NEOML_USE_MLAS
-	}
+	sgemm( getGemmBackend(), customSgemmFunction, this, /*transposeSecond*/true, /*add*/true, first, firstRowSize,
+		second, secondRowSize, result, resultRowSize, firstHeight, firstWidth, secondHeight );
 }
 
 // result = first * T(second). The result size is firstHeight * secondHeight:
@@ -555,7 +508,7 @@ void CCpuMathEngine::multiplyTransposedMatrixByMatrix( const float* first, int f
 	int firstWidth, const float* second, int secondWidth,
 	float* result )
 {
-	if( customSgemmFunction != nullptr ) {
+	if( getGemmBackend() == ATG_Jit ) {
 		auto firstRowSize = firstWidth;
 		auto secondRowSize = secondWidth;
 		auto resultRowSize = secondWidth;
@@ -586,7 +539,7 @@ void CCpuMathEngine::multiplyTransposedMatrixByMatrixAndAdd( const float* first,
 	ASSERT_EXPR(secondWidth <= secondRowSize);
 	ASSERT_EXPR(secondWidth <= resultRowSize);
 
-	if( customSgemmFunction != nullptr ) {
+	if( getGemmBackend() == ATG_Jit ) {
 		customSgemmFunction( true, false, this, first, firstRowSize, second, secondRowSize,
 			result, resultRowSize, firstWidth, secondWidth, firstHeight );
 	} else {
@@ -69,6 +69,11 @@ void CCpuMathEngine::VectorLog(const CConstFloatHandle& firstHandle, const CFloa
 #else  // !NEOML_USE_MKL
 	const float* first = GetRaw(firstHandle);
 	float* result = GetRaw(resultHandle);
+	if( CCPUInfo::HasAvxAndFma ) {
+		NeoML::Avx2::vectorLog( first, result, vectorSize );
+		return;
+	}
+
 	for(int i = 0; i < vectorSize; ++i) {
 		*result++ = std::log( std::min(std::max(*first, FLT_MIN), FLT_MAX));
 		first++;
@@ -147,6 +152,11 @@ void CCpuMathEngine::VectorPower( float exponent, const CConstFloatHandle& first
 	}
 #endif // NEOML_USE_MKL
 
+	if( CCPUInfo::HasAvxAndFma ) {
+		NeoML::Avx2::vectorPower( exponent, first, result, vectorSize );
+		return;
+	}
+
 	for( int i = 0; i < vectorSize; ++i ) {
 		*result++ = powf( *first++, exponent );
 	}
@@ -232,6 +242,11 @@ void CCpuMathEngine::VectorErf( const CConstFloatHandle& firstHandle, const CFlo
 #elif defined( NEOML_USE_MLAS )
 	MlasComputeErf( first, result, static_cast<size_t>( vectorSize ) );
 #else
+	if( CCPUInfo::HasAvxAndFma ) {
+		NeoML::Avx2::vectorErf( first, result, vectorSize );
+		return;
+	}
+
 	for( int i = 0; i < vectorSize; ++i ) {
 		*result++ = std::erff( *first++ );
 	}
@@ -22,6 +22,7 @@ limitations under the License.
 #ifdef NEOML_USE_SSE
 
 #include <algorithm>
+#include <cmath>
 
 #include "CpuX86.h"
 
@@ -1180,6 +1181,11 @@ inline void vectorTanh( const float* first, float* result, int vectorSize )
 #ifdef NEOML_USE_MLAS
 	MlasComputeTanh( first, result, static_cast<size_t>( vectorSize ) );
 #else
+	if( CCPUInfo::HasAvxAndFma ) {
+		NeoML::Avx2::vectorTanh( first, result, vectorSize );
+		return;
+	}
+
 	for( int i = 0; i < vectorSize; ++i ) {
 		result[i] = -1.f + 2 / ( 1.f + ExponentFunc( -2 * first[i] ) );
 	}
@@ -1191,6 +1197,11 @@ inline void vectorExp( const float* first, float* result, int vectorSize )
 #ifdef NEOML_USE_MLAS
 	MlasComputeExp( first, result, static_cast<size_t>( vectorSize ) );
 #else
+	if( CCPUInfo::HasAvxAndFma ) {
+		NeoML::Avx2::vectorExp( first, result, vectorSize );
+		return;
+	}
+
 	for( int i = 0; i < vectorSize; ++i ) {
 		result[i] = ExponentFunc( first[i] );
 	}
@@ -1202,6 +1213,11 @@ inline void vectorSigmoid( const float* first, float* result, int vectorSize )
 #ifdef NEOML_USE_MLAS
 	MlasComputeLogistic( first, result, static_cast<size_t>( vectorSize ) );
 #else
+	if( CCPUInfo::HasAvxAndFma ) {
+		NeoML::Avx2::vectorSigmoid( first, result, vectorSize );
+		return;
+	}
+
 	int sseSize;
 	int nonSseSize;
 	checkSse( vectorSize, sseSize, nonSseSize );
@@ -1317,6 +1333,11 @@ inline void vectorLeakyReLU( const float* first, float* result, float alpha, int
 
 inline void vectorELU( const float* first, float* result, float alpha, int vectorSize )
 {
+	if( CCPUInfo::HasAvxAndFma ) {
+		NeoML::Avx2::vectorELU( first, result, vectorSize, alpha );
+		return;
+	}
+
 	for( int i = 0; i < vectorSize; ++i ) {
 		*result = *first >= 0 ? *first : alpha * ( ExponentFunc( *first ) - 1.f );
 		++result;
@@ -1324,6 +1345,164 @@ inline void vectorELU( const float* first, float* result, float alpha, int vecto
 	}
 }
 
+//------------------------------------------------------------------------------------------------------------
+
+// The constants for GELU
+static constexpr float GeluSqrt2Inv = 0.707106781186547524f;
+static constexpr float GeluSqrt2PiInv = 0.398942280401432678f;
+static constexpr float GeluApproximationMultiplier = 1.702f;
+static constexpr float GeluSqrt2PiScale = 0.797884560802865356f; // sqrt(2/pi)
+static constexpr float GeluTanhCubicCoeff = 0.044715f;
+
+// x * 0.5( 1 + erf( x / sqrt(2) ) ), x * sigmoid(1.702x) or x * 0.5( 1 + tanh( sqrt(2/pi)( x + 0.044715x^3 ) ) )
+// Unlike exp, tanh, sigmoid and erf, the AVX2 kernel is used even with MLAS or MKL:
+// their erf and logistic are less precise in the tails, where the error is multiplied by x
+inline void vectorGelu( const float* first, float* result, int vectorSize, CGELUActivationParam::TCalculationMode mode )
+{
+	if( CCPUInfo::HasAvxAndFma ) {
+		NeoML::Avx2::vectorGelu( first, result, vectorSize, mode );
+		return;
+	}
+
+	for( int i = 0; i < vectorSize; ++i ) {
+		const float x = *first++;
+		switch( mode ) {
+			case CGELUActivationParam::TCalculationMode::CM_Precise:
+				*result++ = x * 0.5f * ( 1.f + std::erff( x * GeluSqrt2Inv ) );
+				break;
+			case CGELUActivationParam::TCalculationMode::CM_SigmoidApproximate:
+				*result++ = x / ( 1.f + ExponentFunc( -GeluApproximationMultiplier * x ) );
+				break;
+			case CGELUActivationParam::TCalculationMode::CM_TanhApproximate:
+				*result++ = x * 0.5f * ( 1.f + std::tanh( GeluSqrt2PiScale * x * ( 1.f + GeluTanhCubicCoeff * x * x ) ) );
+				break;
+			default:
+				ASSERT_EXPR( false );
+		}
+	}
+}
+
+// outputDiff * GELU'(x)
+inline void vectorGeluDiff( const float* first, const float* outputDiff, float* result, int vectorSize,
+	CGELUActivationParam::TCalculationMode mode )
+{
+	if( CCPUInfo::HasAvxAndFma ) {
+		NeoML::Avx2::vectorGeluDiff( first, outputDiff, result, vectorSize, mode );
+		return;
+	}
+
+	for( int i = 0; i < vectorSize; ++i ) {
+		const float x = *first++;
+		float diff = 0;
+		switch( mode ) {
+			case CGELUActivationParam::TCalculationMode::CM_Precise:
+				diff = 0.5f * ( 1.f + std::erff( x * GeluSqrt2Inv ) ) + x * GeluSqrt2PiInv * ExponentFunc( -0.5f * x * x );
+				break;
+			case CGELUActivationParam::TCalculationMode::CM_SigmoidApproximate:
+			{
+				const float sigmoid = 1.f / ( 1.f + ExponentFunc( -GeluApproximationMultiplier * x ) );
+				diff = sigmoid + GeluApproximationMultiplier * x * sigmoid * ( 1.f - sigmoid );
+				break;
+			}
+			case CGELUActivationParam::TCalculationMode::CM_TanhApproximate:
+			{
+				// 1 - tanh(u)^2 = 4 * sigmoid(2u) * e^(-2u) * sigmoid(2u) has no cancellation near +-1
+				const float exp = ExponentFunc( -2.f * GeluSqrt2PiScale * x * ( 1.f + GeluTanhCubicCoeff * x * x ) );
+				const float sigmoid = 1.f / ( 1.f + exp );
+				const float innerDiff = GeluSqrt2PiScale * ( 1.f + 3.f * GeluTanhCubicCoeff * x * x );
+				diff = sigmoid + 0.5f * x * ( 4.f * sigmoid * sigmoid * exp * innerDiff );
+				break;
+			}
+			default:
+				ASSERT_EXPR( false );
+		}
+		*result++ = *outputDiff++ * diff;
+	}
+}
+
+// x * sigmoid(x)
+inline void vectorSilu( const float* first, float* result, int vectorSize )
+{
+	if( CCPUInfo::HasAvxAndFma ) {
+		NeoML::Avx2::vectorSilu( first, result, vectorSize );
+		return;
+	}
+
+	for( int i = 0; i < vectorSize; ++i ) {
+		const float x = *first++;
+		*result++ = x / ( 1.f + ExponentFunc( -x ) );
+	}
+}
+
+// outputDiff * SiLU'(x)
+inline void vectorSiluDiff( const float* first, const float* outputDiff, float* result, int vectorSize )
+{
+	if( CCPUInfo::HasAvxAndFma ) {
+		NeoML::Avx2::vectorSiluDiff( first, outputDiff, result, vectorSize );
+		return;
+	}
+
+	for( int i = 0; i < vectorSize; ++i ) {
+		const float x = *first++;
+		const float sigmoid = 1.f / ( 1.f + ExponentFunc( -x ) );
+		*result++ = *outputDiff++ * ( sigmoid + x * sigmoid * ( 1.f - sigmoid ) );
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------
+
+inline void vectorConvert( const float* from, CFloat16* to, int vectorSize )
+{
+	if( CCPUInfo::HasAvxAndFma && CCPUInfo::HasF16c ) {
+		NeoML::Avx2::vectorConvert( from, to, vectorSize );
+		return;
+	}
+
+	for( int i = 0; i < vectorSize; ++i ) {
+		to[i] = CFloat16::FromFloat( from[i] );
+	}
+}
+
+inline void vectorConvert( const CFloat16* from, float* to, int vectorSize )
+{
+	if( CCPUInfo::HasAvxAndFma && CCPUInfo::HasF16c ) {
+		NeoML::Avx2::vectorConvert( from, to, vectorSize );
+		return;
+	}
+
+	for( int i = 0; i < vectorSize; ++i ) {
+		to[i] = from[i].ToFloat();
+	}
+}
+
+inline void vectorConvert( const float* from, CBFloat16* to, int vectorSize )
+{
+	if( CCPUInfo::HasAvxAndFma && CCPUInfo::HasAvx512Bf16 ) {
+		NeoML::Avx2::vectorConvertAvx512Bf16( from, to, vectorSize );
+		return;
+	}
+	if( CCPUInfo::HasAvxAndFma ) {
+		NeoML::Avx2::vectorConvert( from, to, vectorSize );
+		return;
+	}
+
+	for( int i = 0; i < vectorSize; ++i ) {
+		to[i] = CBFloat16::FromFloat( from[i] );
+	}
+}
+
+inline void vectorConvert( const CBFloat16* from, float* to, int vectorSize )
+{
+	if( CCPUInfo::HasAvxAndFma ) {
+		NeoML::Avx2::vectorConvert( from, to, vectorSize );
+		return;
+	}
+
+	for( int i = 0; i < vectorSize; ++i ) {
+		to[i] = from[i].ToFloat();
+	}
+}
+
 } // namespace NeoML
 
 #endif // NEOML_USE_SSE
@@ -17,6 +17,14 @@ limitations under the License.
 
 #include <immintrin.h>
 
+// The functions using 512-bit registers are compiled for AVX-512F regardless of the project flags
+// They may be called only if CCPUInfo::IsAvx512Available()
+#if defined( __GNUC__ ) || defined( __clang__ )
+#define AVX512_TARGET __attribute__( ( target( "avx512f" ) ) )
+#else
+#define AVX512_TARGET
+#endif
+
 #define PERMUTE2( p1, p0 ) ( ( p0 << 0 ) + ( p1 << 4 ) )
 #define PERMUTE4( p3, p2, p1, p0 ) ( ( p0 << 0 ) + ( p1 << 2 ) + ( p2 << 4 ) + ( p3 << 6 ) )
 #define PERMUTE8( p7, p6, p5, p4, p3, p2, p1, p0 ) _mm256_set_epi32( p7, p6, p5, p4, p3, p2, p1, p0 )
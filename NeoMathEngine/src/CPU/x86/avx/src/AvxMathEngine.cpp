@@ -79,7 +79,9 @@ CConvolutionDesc* CAvxMathEngine::InitBlobConvolution( const CBlobDesc& source,
 	int strideHeight, int strideWidth, int dilationHeight, int dilationWidth, const CBlobDesc& filter,
 	const CBlobDesc& result ) const
 {
-	if( !CCPUInfo::IsAvx512Available()
+	// Only the AVX-512 kernels are used on the CPUs with AVX-512
+	if( ( !CCPUInfo::IsAvx512Available()
+			|| CBlobConvolutionFabric::IsAvx512ConvolutionAvailable( filter.BatchWidth(), filter.Height(), filter.Width() ) )
 		&& CBlobConvolutionFabric::IsBlobConvolutionAvailable( source.ObjectCount() * source.Height() * source.Width(),
 			filter.BatchWidth() , filter.Height(), filter.Width() ) )
 	{
@@ -21,9 +21,11 @@ limitations under the License.
 #include <cstring>
 #include <functional>
 #include <memory>
+#include <mutex>
 
 #include <NeoMathEngine/NeoMathEngine.h>
 #include <JitCommon.h>
+#include <CPUInfo.h>
 
 namespace NeoML {
 
@@ -101,6 +103,9 @@ private:
 
         void fillBatchProcessingKernel( const CBlobConvolution<FltCnt>& bc, bool useNarrowProcessing, size_t windowIndex );
         void fillSingleProcessingKernel( const CBlobConvolution<FltCnt>& bc, bool useNarrowProcessing, size_t windowIndex );
+        // AVX-512 kernels, the same for all FltCnt multiple of 16
+        void fillBatchProcessingKernelAvx512( const CBlobConvolution<FltCnt>& bc, size_t windowIndex );
+        void fillSingleProcessingKernelAvx512( const CBlobConvolution<FltCnt>& bc, size_t windowIndex );
 
         // Initialize result registers with data from freeTerm (if it isn't nullptr)
         void initResRegs( size_t stepCount, size_t stepSize );
@@ -108,6 +113,9 @@ private:
         // 'fillKernel' will be called for filling of kernel in main loop
         // 'callBeforeFlush' will be called before flushing of result registers. It can be captured labda function.
         void flushResRegs( const CBlobConvolution<FltCnt>& bc, size_t stepCount, size_t stepSize, bool useNarrowProcessing );
+        // The same for zmm registers, the result registers are zmm0, zmm1, ...
+        void initResRegsAvx512( size_t stepCount, size_t stepSize );
+        void flushResRegsAvx512( size_t stepCount, size_t stepSize );
         void initProcessingMainLoop( const CBlobConvolution<FltCnt>& bc,
             size_t stepCount, size_t stepSize, int batchChannelSize, const std::function<void( int )>& fillKernel,
             size_t windowIndex, bool useNarrowProcessing = false, const std::function<void()>* callBeforeFlush = nullptr );
@@ -131,18 +139,23 @@ private:
     const int ResH;
     const int ResW;
     const int ResObjCnt;
+    // Use AVX-512 kernels instead of the specialized AVX ones
+    const bool UseAvx512;
     bool jitIsInited;
 
     // For some cases we will use FltCnt, rounded up to nearest integer multiple of 8
     static constexpr int FltCntM8 = ( FltCnt + 8 - 1 ) / 8 * 8;
     static constexpr size_t AvxAlignment = 32;
+    // AVX-512 kernels: one pixel takes FltCnt / 16 zmm registers, the batch kernel processes several pixels in a row
+    static constexpr int Avx512RegsPerPixel = FltCnt / 16;
+    static constexpr int Avx512BatchKernelWidth = FltCnt <= 16 ? 12 : 8;
 
-    const float* src;
     const float* flt;
     const float* freeTerm;
     std::unique_ptr<CFloatHandleVar> rowwiseFlt;
     std::unique_ptr<CFloatHandleVar> rowwiseFreeTerm;
-    float* res;
+    // Guards the lazy initialization in ProcessConvolutionRowwise (the rowwise chains may be split between threads)
+    std::mutex rowwiseInitMutex;
 
     // !!! SrcXStep, SrcYStep and ResLineStride are read from JIT as 8-byte values, hence they must have 8 byte length.
     // Length of one source line.
@@ -186,7 +199,8 @@ private:
 
     void initJitCodes();
 
-    void processConvolutionRowwise( int rowIdx, int rowCount );
+    // src and res point to the beginning of the whole source and result blobs
+    void processConvolutionRowwise( const float* src, float* res, int rowIdx, int rowCount );
 
     // Rearrange filter and fill 'Filter' and 'FreeTerm' members.
     const float* rearrangeFilter( const float* filterData, CMemoryHandleVarBase<float>& Filter );
@@ -209,6 +223,10 @@ const int CBlobConvolution<FltCnt>::NarrowBatchKernelWidth = INT_MAX;
 class CBlobConvolutionFabric : public CCrtAllocatedObject {
 public:
     static bool IsBlobConvolutionAvailable( int SrcPixelCnt, int FltCnt, int FltH, int FltW );
+    // Checks if the convolution has AVX-512 kernels
+    // 1x1 convolution isn't faster than the matrix multiplication with AVX-512 so it isn't supported
+    static bool IsAvx512ConvolutionAvailable( int FltCnt, int FltH, int FltW )
+        { return ( FltCnt == 16 || FltCnt == 32 ) && FltH * FltW > 1; }
     static std::unique_ptr<CBlobConvolutionBase> GetProperInstance(
         IMathEngine* mathEngine, int FltCnt,
         int channelCount, int filterHeight, int filterWidth, int sourceHeight, int sourceWidth,
@@ -227,4 +245,5 @@ public:
 #include <BlobConvolution_jit_FltCnt_16.inl>
 #include <BlobConvolution_jit_FltCnt_18.inl>
 #include <BlobConvolution_jit_FltCnt_24.inl>
-#include <BlobConvolution_jit_FltCnt_32.inl>
\ No newline at end of file
+#include <BlobConvolution_jit_FltCnt_32.inl>
+#include <BlobConvolution_jit_Avx512.inl>
\ No newline at end of file
@@ -112,11 +112,10 @@ CBlobConvolution<FltCnt>::CBlobConvolution(
     ResH( resultHeight ),
     ResW( resultWidth ),
     ResObjCnt( resObjCnt ),
+    UseAvx512( FltCnt % 16 == 0 && CCPUInfo::IsAvx512Available() ),
     jitIsInited( false ),
-    src( nullptr ),
     flt( nullptr ),
     freeTerm( nullptr ),
-    res( nullptr ),
     SrcLineStride( SrcW* ChCnt ),
     SrcXStep( StrideW* ChCnt ),
     SrcYStep( StrideH* SrcLineStride ),
@@ -141,8 +140,6 @@ void CBlobConvolution<FltCnt>::ProcessConvolution(
     // Filter offset also are calculated from center
     flt = rearrangeFilter( filterData, filterTempBuffer ) + ( FltW * FltH ) / 2 * ChCnt * FltCntM8;
     freeTerm = rearrangeFreeTerm( freeTermData, freeTermTempBuffer );
-    src = sourceData;
-    res = resultData;
 
     if( !jitIsInited ) {
         initJitCodes();
@@ -150,34 +147,35 @@ void CBlobConvolution<FltCnt>::ProcessConvolution(
     }
 
     const int resRowCount = ResObjCnt * ResH;
-    processConvolutionRowwise( /*resRowStartIndex*/0, resRowCount );
+    processConvolutionRowwise( sourceData, resultData, /*resRowStartIndex*/0, resRowCount );
 }
 
 template<int FltCnt>
 void CBlobConvolution<FltCnt>::ProcessConvolutionRowwise( const float* sourceData, int sourceRowIndex,
     const float* filterData, const float* freeTermData, float* resultData, int resultRowIndex, int resultRowCount )
 {
-    // Filter offset also are calculated from center
-    if( rowwiseFlt == nullptr ) {
-        rowwiseFlt.reset( new CFloatHandleVar( *mathEngine, FltW * FltH * FltCntM8 * ChCnt ) );
-        rowwiseFreeTerm.reset( new CFloatHandleVar( *mathEngine, FltCntM8 ) );
-        flt = rearrangeFilter( filterData, *rowwiseFlt ) + ( FltW * FltH ) / 2 * ChCnt * FltCntM8;
-        freeTerm = rearrangeFreeTerm( freeTermData, *rowwiseFreeTerm );
-    }
-
-    src = sourceData - sourceRowIndex * SrcLineStride;
-    res = resultData - resultRowIndex * ResLineStride;
+    {
+        std::lock_guard<std::mutex> lock( rowwiseInitMutex );
+        // Filter offset also are calculated from center
+        if( rowwiseFlt == nullptr ) {
+            rowwiseFlt.reset( new CFloatHandleVar( *mathEngine, FltW * FltH * FltCntM8 * ChCnt ) );
+            rowwiseFreeTerm.reset( new CFloatHandleVar( *mathEngine, FltCntM8 ) );
+            flt = rearrangeFilter( filterData, *rowwiseFlt ) + ( FltW * FltH ) / 2 * ChCnt * FltCntM8;
+            freeTerm = rearrangeFreeTerm( freeTermData, *rowwiseFreeTerm );
+        }
 
-    if( !jitIsInited ) {
-        initJitCodes();
-        jitIsInited = true;
+        if( !jitIsInited ) {
+            initJitCodes();
+            jitIsInited = true;
+        }
     }
 
-    processConvolutionRowwise( resultRowIndex, resultRowCount );
+    processConvolutionRowwise( sourceData - sourceRowIndex * SrcLineStride,
+        resultData - resultRowIndex * ResLineStride, resultRowIndex, resultRowCount );
 }
 
 template<int FltCnt>
-void CBlobConvolution<FltCnt>::processConvolutionRowwise( int rowIdx, int rowCount )
+void CBlobConvolution<FltCnt>::processConvolutionRowwise( const float* src, float* res, int rowIdx, int rowCount )
 {
     const int SrcObjSize = SrcW * SrcH * ChCnt;
     const int ResObjSize = ResW * ResH * FltCnt;
@@ -228,6 +226,9 @@ void CBlobConvolution<FltCnt>::processConvolutionRowwise( int rowIdx, int rowCou
 template<int FltCnt>
 inline typename CBlobConvolution<FltCnt>::CSize CBlobConvolution<FltCnt>::getWideBatchProcessSize()
 {
+    if( UseAvx512 ) {
+        return { 1, Avx512BatchKernelWidth };
+    }
     return { WideBatchKernelHeight, WideBatchKernelWidth };
 }
 
@@ -235,6 +236,9 @@ template<int FltCnt>
 inline typename CBlobConvolution<FltCnt>::CSize CBlobConvolution<FltCnt>::getNarrowBatchProcessSize()
 {
     // Disable narrow processing by default
+    if( UseAvx512 ) {
+        return { INT_MAX, INT_MAX };
+    }
     return { NarrowBatchKernelHeight, NarrowBatchKernelWidth };
 }
 
@@ -44,7 +44,13 @@ CBlobConvolution<FltCnt>::CJitConvolution::CJitConvolution( const CBlobConvoluti
 
         // Do we have any batch step at all?
         if( numSteps > 0 ) {
-            if( stepSize == 1 ) {
+            if( bc.UseAvx512 ) {
+                if( stepSize == 1 ) {
+                    fillSingleProcessingKernelAvx512( bc, windowIndex );
+                } else {
+                    fillBatchProcessingKernelAvx512( bc, windowIndex );
+                }
+            } else if( stepSize == 1 ) {
                 fillSingleProcessingKernel( bc, useNarrowProcessing, windowIndex );
             } else {
                 fillBatchProcessingKernel( bc, useNarrowProcessing, windowIndex );
@@ -299,7 +305,11 @@ inline void CBlobConvolution<FltCnt>::CJitConvolution::initProcessingMainLoop(
     Label labelProcessingKernel, labelProcessingKernelStart, labelProcessingKernelEnd;
 
     // Initialize result registers with freeTerm
-    initResRegs( stepCount, stepSize );
+    if( bc.UseAvx512 ) {
+        initResRegsAvx512( stepCount, stepSize );
+    } else {
+        initResRegs( stepCount, stepSize );
+    }
 
     // Process convolution
     auto srcIt = bc.SrcPixelsOffset[windowIndex].cbegin();
@@ -316,7 +326,11 @@ inline void CBlobConvolution<FltCnt>::CJitConvolution::initProcessingMainLoop(
     }
 
     // Flush result registers
-    flushResRegs( bc, stepCount, stepSize, useNarrowProcessing );
+    if( bc.UseAvx512 ) {
+        flushResRegsAvx512( stepCount, stepSize );
+    } else {
+        flushResRegs( bc, stepCount, stepSize, useNarrowProcessing );
+    }
 
     // return from function
     jmp( labelFillProcessingKernelEnd, T_NEAR );
@@ -0,0 +1,161 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+// AVX-512 kernels of CBlobConvolution
+// They are used instead of the specialized kernels if FltCnt is a multiple of 16 and the CPU supports AVX-512.
+// One pixel of the result takes FltCnt / 16 zmm registers, so the tails are never stored by mask.
+
+namespace NeoML {
+
+template<int FltCnt>
+inline void CBlobConvolution<FltCnt>::CJitConvolution::initResRegsAvx512( size_t stepCount, size_t stepSize )
+{
+    using namespace Xbyak;
+
+    Label labelFillWithZeroes, labelEnd;
+    test( regFreeTermPtr, regFreeTermPtr );
+    jz( labelFillWithZeroes, T_NEAR );
+
+    // Load the free terms for the first pixel and copy them to the others
+    for( int i = 0; i < static_cast<int>( stepSize ); i++ ) {
+        vmovups( Zmm( i ), ptr[regFreeTermPtr + i * SizeOfZmm] );
+    }
+    for( int i = static_cast<int>( stepSize ); i < static_cast<int>( stepCount * stepSize ); i++ ) {
+        vmovaps( Zmm( i ), Zmm( i % stepSize ) );
+    }
+    jmp( labelEnd, T_NEAR );
+
+    L( labelFillWithZeroes );
+    for( int i = 0; i < static_cast<int>( stepCount * stepSize ); i++ ) {
+        vpxord( Zmm( i ), Zmm( i ), Zmm( i ) );
+    }
+    L( labelEnd );
+}
+
+template<int FltCnt>
+inline void CBlobConvolution<FltCnt>::CJitConvolution::flushResRegsAvx512( size_t stepCount, size_t stepSize )
+{
+    using namespace Xbyak;
+
+    // The pixels of the result are stored one after another
+    for( int i = 0; i < static_cast<int>( stepCount * stepSize ); i++ ) {
+        vmovups( ptr[regResPtr + i * SizeOfZmm], Zmm( i ) );
+    }
+}
+
+template<int FltCnt>
+inline void CBlobConvolution<FltCnt>::CJitConvolution::fillBatchProcessingKernelAvx512( const CBlobConvolution<FltCnt>& bc,
+    size_t windowIndex )
+{
+    using namespace Xbyak;
+
+    const int StepCount = Avx512BatchKernelWidth;
+    const int StepSize = Avx512RegsPerPixel;
+    const int BatchChannelSize = 8;
+
+    // Result: zmm0 .. zmm23, filters: zmm24 .. zmm27, source: zmm28 .. zmm31
+    const int FirstFltReg = 24;
+    const int FirstSrcReg = 28;
+    const int SrcRegCount = 4;
+    static_assert( Avx512BatchKernelWidth * Avx512RegsPerPixel <= 24 && Avx512RegsPerPixel <= 4,
+        "Too many registers for AVX-512 batch kernel" );
+
+    std::function<void( int )> fillKernel( [&]( int channelCount ) {
+        for( int c = 0; c < channelCount; c++ ) {
+            const size_t fltOffset = c * FltCntM8 * sizeof( float );
+            const size_t srcOffset = c * sizeof( float );
+            // Load one channel for the same pixel as in source for all filters.
+            for( int r = 0; r < StepSize; r++ ) {
+                vmovups( Zmm( FirstFltReg + r ), ptr[regTempFltPtr + fltOffset + r * SizeOfZmm] );
+            }
+            // Load one channel from one pixels in sequenced windows and multiply it by all filters
+            for( int p = 0; p < StepCount; p++ ) {
+                if( StepSize == 1 ) {
+                    // Broadcast from memory right in the instruction
+                    vfmadd231ps( Zmm( p ), Zmm( FirstFltReg ),
+                        ptr_b[regTempSrcPtr + srcOffset + p * bc.SrcXStep * sizeof( float )] );
+                    continue;
+                }
+                const Zmm src( FirstSrcReg + p % SrcRegCount );
+                vbroadcastss( src, ptr[regTempSrcPtr + srcOffset + p * bc.SrcXStep * sizeof( float )] );
+                for( int r = 0; r < StepSize; r++ ) {
+                    vfmadd231ps( Zmm( p * StepSize + r ), Zmm( FirstFltReg + r ), src );
+                }
+            }
+        }
+        } );
+
+    initProcessingMainLoop( bc, StepCount, StepSize, BatchChannelSize, fillKernel, windowIndex );
+}
+
+template<int FltCnt>
+inline void CBlobConvolution<FltCnt>::CJitConvolution::fillSingleProcessingKernelAvx512( const CBlobConvolution<FltCnt>& bc,
+    size_t windowIndex )
+{
+    using namespace Xbyak;
+
+    const int StepCount = 1;
+    const int StepSize = Avx512RegsPerPixel;
+    const int BatchChannelSize = 4;
+
+    // The channels are accumulated in 4 independent sets of registers which are merged before the flush.
+    // The first set is the result registers.
+    // Sets: zmm0 .. zmm15, filters: zmm16 .. zmm27, source: zmm28 .. zmm31
+    const int SetCount = 4;
+    const int FirstFltReg = 16;
+    const int FirstSrcReg = 28;
+    static_assert( Avx512RegsPerPixel <= 3, "Too many registers for AVX-512 single kernel" );
+    auto setReg = [StepSize]( int set, int r ) { return Zmm( set * StepSize + r ); };
+
+    for( int set = 1; set < SetCount; set++ ) {
+        for( int r = 0; r < StepSize; r++ ) {
+            vpxord( setReg( set, r ), setReg( set, r ), setReg( set, r ) );
+        }
+    }
+    std::function<void()> mergeResRegs( [&]() {
+        for( int r = 0; r < StepSize; r++ ) {
+            vaddps( setReg( 0, r ), setReg( 0, r ), setReg( 1, r ) );
+            vaddps( setReg( 2, r ), setReg( 2, r ), setReg( 3, r ) );
+            vaddps( setReg( 0, r ), setReg( 0, r ), setReg( 2, r ) );
+        }
+    } );
+
+    std::function<void( int )> fillKernel( [&]( int channelCount ) {
+        PRESUME_EXPR( channelCount <= BatchChannelSize );
+        // Load channels
+        for( int c = 0; c < channelCount; c++ ) {
+            vbroadcastss( Zmm( FirstSrcReg + c ), ptr[regTempSrcPtr + c * sizeof( float )] );
+        }
+
+        // Load filters
+        for( int c = 0; c < channelCount; c++ ) {
+            for( int r = 0; r < StepSize; r++ ) {
+                vmovups( Zmm( FirstFltReg + c * StepSize + r ),
+                    ptr[regTempFltPtr + c * FltCntM8 * sizeof( float ) + r * SizeOfZmm] );
+            }
+        }
+
+        // Each channel goes to its own set
+        for( int c = 0; c < channelCount; c++ ) {
+            for( int r = 0; r < StepSize; r++ ) {
+                vfmadd231ps( setReg( c, r ), Zmm( FirstFltReg + c * StepSize + r ), Zmm( FirstSrcReg + c ) );
+            }
+        }
+        } );
+    initProcessingMainLoop( bc, StepCount, StepSize, BatchChannelSize, fillKernel,
+        windowIndex, false, &mergeResRegs );
+}
+
+} // namespace NeoML
@@ -59,6 +59,8 @@ constexpr unsigned int NumFloatInYmm = 8;
 constexpr unsigned int SizeOfYmm = NumFloatInYmm * sizeof( float );
 constexpr unsigned int SizeofReg64 = 8;
 constexpr unsigned int MaxYmmCount = 16;
+constexpr unsigned int NumFloatInZmm = 16;
+constexpr unsigned int SizeOfZmm = NumFloatInZmm * sizeof( float );
 
 class CJitCommon : public Xbyak::CodeGenerator {
 public:
@@ -28,6 +28,7 @@ limitations under the License.
 #include <Kernel_AVX_6x4.h>
 #include <Kernel_AVX_6x2.h>
 #include <Kernel_AVX_6x1.h>
+#include <Kernel_AVX512_6x32.h>
 
 namespace NeoML {
 
@@ -36,6 +37,15 @@ using CKernelCombi_8 = CKernelCombineHorizontal<CMicroKernel_6x16, CMicroKernel_
 using CKernelCombi_4 = CKernelCombineHorizontal<CMicroKernel_6x16, CMicroKernel_6x8, CMicroKernel_6x4>;
 using CKernelCombi_full = CKernelCombineHorizontal<CMicroKernel_6x16, CMicroKernel_6x8, CMicroKernel_6x4, CMicroKernel_6x2, CMicroKernel_6x1>;
 
+// The tails narrower than 32 columns are processed by the AVX kernels
+using CKernelCombiAvx512_32 = CKernelCombineHorizontal<CMicroKernel_AVX512_6x32>;
+using CKernelCombiAvx512_16 = CKernelCombineHorizontal<CMicroKernel_AVX512_6x32, CMicroKernel_6x16>;
+using CKernelCombiAvx512_8 = CKernelCombineHorizontal<CMicroKernel_AVX512_6x32, CMicroKernel_6x16, CMicroKernel_6x8>;
+using CKernelCombiAvx512_4 = CKernelCombineHorizontal<CMicroKernel_AVX512_6x32, CMicroKernel_6x16, CMicroKernel_6x8,
+	CMicroKernel_6x4>;
+using CKernelCombiAvx512_full = CKernelCombineHorizontal<CMicroKernel_AVX512_6x32, CMicroKernel_6x16, CMicroKernel_6x8,
+	CMicroKernel_6x4, CMicroKernel_6x2, CMicroKernel_6x1>;
+
 template< class Kernel>
 void AvxMultiplyMatrixSelected( bool transA, bool transB,
 	IMathEngine *engine,
@@ -67,6 +77,39 @@ void AvxMultiplyMatrixSelected( bool transA, bool transB,
 	}
 }
 
+static void avx512MultiplyMatrix( bool transA, bool transB,
+	IMathEngine *engine,
+	const float* aPtr, size_t aRowSize,
+	const float* bPtr, size_t bRowSize,
+	float* cPtr, size_t cRowSize,
+	size_t m, size_t n, size_t k )
+{
+	// The same choice as for AVX, but the widest kernel processes 32 columns
+	const size_t tail = n % 32;
+	if( tail == 0 || tail >= 29 ) {
+		AvxMultiplyMatrixSelected<CKernelCombiAvx512_32>( transA, transB, engine, aPtr, aRowSize, bPtr, bRowSize, cPtr, cRowSize, m, n, k );
+		return;
+	}
+	switch( tail % 16 ) {
+	case 3:
+	case 11:
+		AvxMultiplyMatrixSelected<CKernelCombiAvx512_4>( transA, transB, engine, aPtr, aRowSize, bPtr, bRowSize, cPtr, cRowSize, m, n, k );
+		break;
+	case 5:
+	case 6:
+	case 7:
+		AvxMultiplyMatrixSelected<CKernelCombiAvx512_8>( transA, transB, engine, aPtr, aRowSize, bPtr, bRowSize, cPtr, cRowSize, m, n, k );
+		break;
+	case 13:
+	case 14:
+	case 15:
+		AvxMultiplyMatrixSelected<CKernelCombiAvx512_16>( transA, transB, engine, aPtr, aRowSize, bPtr, bRowSize, cPtr, cRowSize, m, n, k );
+		break;
+	default:
+		AvxMultiplyMatrixSelected<CKernelCombiAvx512_full>( transA, transB, engine, aPtr, aRowSize, bPtr, bRowSize, cPtr, cRowSize, m, n, k );
+	}
+}
+
 void AvxMultiplyMatrix( bool transA, bool transB,
 	IMathEngine *engine,
 	const float* aPtr, size_t aRowSize,
@@ -74,6 +117,12 @@ void AvxMultiplyMatrix( bool transA, bool transB,
 	float* cPtr, size_t cRowSize,
 	size_t m, size_t n, size_t k )
 {
+	static const bool isAvx512Available = CCPUInfo::IsAvx512Available();
+	if( isAvx512Available && n >= 32 ) {
+		avx512MultiplyMatrix( transA, transB, engine, aPtr, aRowSize, bPtr, bRowSize, cPtr, cRowSize, m, n, k );
+		return;
+	}
+
 	// In some cases it is better choice to calculate matrix with big kernel in one or two steps rather than iterate over all
 	// available kernels. It helps us to save time on preparing.
 	switch( n % 16 ) {
@@ -0,0 +1,108 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <AvxCommon.h>
+#include <MicroKernels/MicroKernelBase.h>
+
+// The same layout as CMicroKernel_6x16 but each row of the result is kept in two zmm registers
+// Must be called only if CCPUInfo::IsAvx512Available()
+struct CMicroKernel_AVX512_6x32 : public CMicroKernelBase<6, 32> {
+	static AVX512_TARGET void Calculate( const float* aPtr, const float* bPtr, float* cPtr, size_t cRowSize, size_t k ) {
+		for( int i = 0; i < 6; i++ ) {
+			_mm_prefetch( reinterpret_cast<const char*>( cPtr + i * cRowSize ), _MM_HINT_T0 );
+			_mm_prefetch( reinterpret_cast<const char*>( cPtr + i * cRowSize + 16 ), _MM_HINT_T0 );
+		}
+		__m512 c00 = _mm512_setzero_ps();
+		__m512 c01 = _mm512_setzero_ps();
+		__m512 c10 = _mm512_setzero_ps();
+		__m512 c11 = _mm512_setzero_ps();
+		__m512 c20 = _mm512_setzero_ps();
+		__m512 c21 = _mm512_setzero_ps();
+		__m512 c30 = _mm512_setzero_ps();
+		__m512 c31 = _mm512_setzero_ps();
+		__m512 c40 = _mm512_setzero_ps();
+		__m512 c41 = _mm512_setzero_ps();
+		__m512 c50 = _mm512_setzero_ps();
+		__m512 c51 = _mm512_setzero_ps();
+
+		for( ; k >= 4; k -= 4 ) {
+			_mm_prefetch( reinterpret_cast<const char*>( aPtr + 48 ), _MM_HINT_T0 );
+			_mm_prefetch( reinterpret_cast<const char*>( bPtr + 256 ), _MM_HINT_T0 );
+			_mm_prefetch( reinterpret_cast<const char*>( bPtr + 272 ), _MM_HINT_T0 );
+			step( aPtr, bPtr, c00, c01, c10, c11, c20, c21, c30, c31, c40, c41, c50, c51 );
+			step( aPtr + 6, bPtr + 32, c00, c01, c10, c11, c20, c21, c30, c31, c40, c41, c50, c51 );
+			_mm_prefetch( reinterpret_cast<const char*>( bPtr + 288 ), _MM_HINT_T0 );
+			_mm_prefetch( reinterpret_cast<const char*>( bPtr + 304 ), _MM_HINT_T0 );
+			step( aPtr + 12, bPtr + 64, c00, c01, c10, c11, c20, c21, c30, c31, c40, c41, c50, c51 );
+			step( aPtr + 18, bPtr + 96, c00, c01, c10, c11, c20, c21, c30, c31, c40, c41, c50, c51 );
+			bPtr += 128; aPtr += 24;
+		}
+
+		for( ; k > 0; k-- ) {
+			step( aPtr, bPtr, c00, c01, c10, c11, c20, c21, c30, c31, c40, c41, c50, c51 );
+			bPtr += 32; aPtr += 6;
+		}
+
+		_mm512_storeu_ps( cPtr, _mm512_add_ps( c00, _mm512_loadu_ps( cPtr ) ) );
+		_mm512_storeu_ps( cPtr + 16, _mm512_add_ps( c01, _mm512_loadu_ps( cPtr + 16 ) ) );
+		cPtr += cRowSize;
+		_mm512_storeu_ps( cPtr, _mm512_add_ps( c10, _mm512_loadu_ps( cPtr ) ) );
+		_mm512_storeu_ps( cPtr + 16, _mm512_add_ps( c11, _mm512_loadu_ps( cPtr + 16 ) ) );
+		cPtr += cRowSize;
+		_mm512_storeu_ps( cPtr, _mm512_add_ps( c20, _mm512_loadu_ps( cPtr ) ) );
+		_mm512_storeu_ps( cPtr + 16, _mm512_add_ps( c21, _mm512_loadu_ps( cPtr + 16 ) ) );
+		cPtr += cRowSize;
+		_mm512_storeu_ps( cPtr, _mm512_add_ps( c30, _mm512_loadu_ps( cPtr ) ) );
+		_mm512_storeu_ps( cPtr + 16, _mm512_add_ps( c31, _mm512_loadu_ps( cPtr + 16 ) ) );
+		cPtr += cRowSize;
+		_mm512_storeu_ps( cPtr, _mm512_add_ps( c40, _mm512_loadu_ps( cPtr ) ) );
+		_mm512_storeu_ps( cPtr + 16, _mm512_add_ps( c41, _mm512_loadu_ps( cPtr + 16 ) ) );
+		cPtr += cRowSize;
+		_mm512_storeu_ps( cPtr, _mm512_add_ps( c50, _mm512_loadu_ps( cPtr ) ) );
+		_mm512_storeu_ps( cPtr + 16, _mm512_add_ps( c51, _mm512_loadu_ps( cPtr + 16 ) ) );
+	}
+
+private:
+	// One step over k: the column of a (6 floats) multiplied by the row of b (32 floats)
+	static inline AVX512_TARGET void step( const float* aPtr, const float* bPtr,
+		__m512& c00, __m512& c01, __m512& c10, __m512& c11, __m512& c20, __m512& c21,
+		__m512& c30, __m512& c31, __m512& c40, __m512& c41, __m512& c50, __m512& c51 )
+	{
+		const __m512 b0 = _mm512_loadu_ps( bPtr );
+		const __m512 b1 = _mm512_loadu_ps( bPtr + 16 );
+
+		__m512 a0 = _mm512_set1_ps( aPtr[0] );
+		__m512 a1 = _mm512_set1_ps( aPtr[1] );
+		c00 = _mm512_fmadd_ps( a0, b0, c00 );
+		c01 = _mm512_fmadd_ps( a0, b1, c01 );
+		c10 = _mm512_fmadd_ps( a1, b0, c10 );
+		c11 = _mm512_fmadd_ps( a1, b1, c11 );
+
+		a0 = _mm512_set1_ps( aPtr[2] );
+		a1 = _mm512_set1_ps( aPtr[3] );
+		c20 = _mm512_fmadd_ps( a0, b0, c20 );
+		c21 = _mm512_fmadd_ps( a0, b1, c21 );
+		c30 = _mm512_fmadd_ps( a1, b0, c30 );
+		c31 = _mm512_fmadd_ps( a1, b1, c31 );
+
+		a0 = _mm512_set1_ps( aPtr[4] );
+		a1 = _mm512_set1_ps( aPtr[5] );
+		c40 = _mm512_fmadd_ps( a0, b0, c40 );
+		c41 = _mm512_fmadd_ps( a0, b1, c41 );
+		c50 = _mm512_fmadd_ps( a1, b0, c50 );
+		c51 = _mm512_fmadd_ps( a1, b1, c51 );
+	}
+};
@@ -0,0 +1,154 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#include <NeoMathEngine/NeoMathEngineDefs.h>
+
+#ifdef NEOML_USE_SSE
+
+#include "Avx2Functions.h"
+
+#include <immintrin.h>
+#include <cstring>
+
+// The file is compiled for AVX2, the extensions beyond it are enabled per function
+#if defined( __GNUC__ ) || defined( __clang__ )
+#define F16C_TARGET __attribute__( ( target( "f16c" ) ) )
+#define AVX512_BF16_TARGET __attribute__( ( target( "avx512f,avx512bf16" ) ) )
+#else
+#define F16C_TARGET
+#define AVX512_BF16_TARGET
+#endif
+
+// AVX-512 BF16 intrinsics are supported since GCC 10, Clang 9 and MSVC 2019
+#if defined( __clang__ )
+#define NEOML_AVX512_BF16 ( __clang_major__ >= 9 )
+#elif defined( __GNUC__ )
+#define NEOML_AVX512_BF16 ( __GNUC__ >= 10 )
+#elif defined( _MSC_VER )
+#define NEOML_AVX512_BF16 ( _MSC_VER >= 1924 )
+#else
+#define NEOML_AVX512_BF16 0
+#endif
+
+static constexpr int ConvertBlockSize = 8;
+
+namespace NeoML {
+
+namespace Avx2 {
+
+F16C_TARGET void vectorConvert( const float* from, CFloat16* to, int vectorSize )
+{
+	while( vectorSize >= ConvertBlockSize ) {
+		const __m128i result = _mm256_cvtps_ph( _mm256_loadu_ps( from ), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC );
+		_mm_storeu_si128( reinterpret_cast<__m128i*>( to ), result );
+		from += ConvertBlockSize;
+		to += ConvertBlockSize;
+		vectorSize -= ConvertBlockSize;
+	}
+
+	for( int i = 0; i < vectorSize; ++i ) {
+		to[i] = CFloat16::FromFloat( from[i] );
+	}
+}
+
+F16C_TARGET void vectorConvert( const CFloat16* from, float* to, int vectorSize )
+{
+	while( vectorSize >= ConvertBlockSize ) {
+		_mm256_storeu_ps( to, _mm256_cvtph_ps( _mm_loadu_si128( reinterpret_cast<const __m128i*>( from ) ) ) );
+		from += ConvertBlockSize;
+		to += ConvertBlockSize;
+		vectorSize -= ConvertBlockSize;
+	}
+
+	for( int i = 0; i < vectorSize; ++i ) {
+		to[i] = from[i].ToFloat();
+	}
+}
+
+void vectorConvert( const float* from, CBFloat16* to, int vectorSize )
+{
+	const __m256i roundingBias = _mm256_set1_epi32( 0x7fff );
+	const __m256i one = _mm256_set1_epi32( 1 );
+	const __m256i quietNanBit = _mm256_set1_epi32( 0x40 );
+
+	while( vectorSize >= ConvertBlockSize ) {
+		const __m256 value = _mm256_loadu_ps( from );
+		const __m256i bits = _mm256_castps_si256( value );
+		// Round to the nearest even
+		const __m256i lowestBit = _mm256_and_si256( _mm256_srli_epi32( bits, 16 ), one );
+		const __m256i rounded = _mm256_srli_epi32(
+			_mm256_add_epi32( bits, _mm256_add_epi32( roundingBias, lowestBit ) ), 16 );
+		// NaN stays quiet NaN
+		const __m256i nan = _mm256_or_si256( _mm256_srli_epi32( bits, 16 ), quietNanBit );
+		const __m256i isNan = _mm256_castps_si256( _mm256_cmp_ps( value, value, _CMP_UNORD_Q ) );
+		const __m256i result = _mm256_blendv_epi8( rounded, nan, isNan );
+		// Pack 8 32-bit values into 8 16-bit values
+		const __m256i packed = _mm256_permute4x64_epi64( _mm256_packus_epi32( result, result ), 0xd8 );
+		_mm_storeu_si128( reinterpret_cast<__m128i*>( to ), _mm256_castsi256_si128( packed ) );
+		from += ConvertBlockSize;
+		to += ConvertBlockSize;
+		vectorSize -= ConvertBlockSize;
+	}
+
+	for( int i = 0; i < vectorSize; ++i ) {
+		to[i] = CBFloat16::FromFloat( from[i] );
+	}
+}
+
+void vectorConvert( const CBFloat16* from, float* to, int vectorSize )
+{
+	while( vectorSize >= ConvertBlockSize ) {
+		const __m256i bits = _mm256_cvtepu16_epi32( _mm_loadu_si128( reinterpret_cast<const __m128i*>( from ) ) );
+		_mm256_storeu_ps( to, _mm256_castsi256_ps( _mm256_slli_epi32( bits, 16 ) ) );
+		from += ConvertBlockSize;
+		to += ConvertBlockSize;
+		vectorSize -= ConvertBlockSize;
+	}
+
+	for( int i = 0; i < vectorSize; ++i ) {
+		to[i] = from[i].ToFloat();
+	}
+}
+
+#if NEOML_AVX512_BF16
+
+AVX512_BF16_TARGET void vectorConvertAvx512Bf16( const float* from, CBFloat16* to, int vectorSize )
+{
+	static constexpr int Avx512BlockSize = 16;
+	while( vectorSize >= Avx512BlockSize ) {
+		const __m256bh result = _mm512_cvtneps_pbh( _mm512_loadu_ps( from ) );
+		::memcpy( to, &result, sizeof( result ) );
+		from += Avx512BlockSize;
+		to += Avx512BlockSize;
+		vectorSize -= Avx512BlockSize;
+	}
+
+	vectorConvert( from, to, vectorSize );
+}
+
+#else
+
+void vectorConvertAvx512Bf16( const float* from, CBFloat16* to, int vectorSize )
+{
+	vectorConvert( from, to, vectorSize );
+}
+
+#endif // NEOML_AVX512_BF16
+
+} // namespace Avx2
+
+} // namespace NeoML
+
+#endif // NEOML_USE_SSE
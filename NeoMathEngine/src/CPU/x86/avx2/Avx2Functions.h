@@ -16,6 +16,8 @@ limitations under the License.
 #pragma once
 
 #include <NeoMathEngine/NeoMathEngineDefs.h>
+#include <NeoMathEngine/BlobType.h>
+#include <NeoMathEngine/ActivationDesc.h>
 
 #ifdef NEOML_USE_SSE
 
@@ -46,6 +48,62 @@ void vectorReLU( const float* first, float* result, int vectorSize, float thresh
 
 void vectorHSwish( const float* first, float* result, int vectorSize );
 
+// Transcendental functions (polynomial approximations, the accuracy is about 1e-7 for the values of order of 1)
+// The exponent returns 0 below FLT_MIN_LOG and FLT_MAX above FLT_MAX_LOG (the same as ExponentFunc)
+void vectorExp( const float* first, float* result, int vectorSize );
+// The argument is clamped to [FLT_MIN, FLT_MAX]
+void vectorLog( const float* first, float* result, int vectorSize );
+void vectorPower( float exponent, const float* first, float* result, int vectorSize );
+void vectorTanh( const float* first, float* result, int vectorSize );
+void vectorSigmoid( const float* first, float* result, int vectorSize );
+void vectorErf( const float* first, float* result, int vectorSize );
+void vectorELU( const float* first, float* result, int vectorSize, float alpha );
+// GELU and its derivative multiplied by outputDiff (see IMathEngine::VectorGELU)
+void vectorGelu( const float* first, float* result, int vectorSize, CGELUActivationParam::TCalculationMode mode );
+void vectorGeluDiff( const float* first, const float* outputDiff, float* result, int vectorSize,
+	CGELUActivationParam::TCalculationMode mode );
+// SiLU and its derivative multiplied by outputDiff (see IMathEngine::VectorSiLU)
+void vectorSilu( const float* first, float* result, int vectorSize );
+void vectorSiluDiff( const float* first, const float* outputDiff, float* result, int vectorSize );
+
+// The per-step epilogue of GRU for one sequence (see CCpuMathEngine::Gru)
+// Applies sigmoid to the update and the reset gates (2 * hiddenSize) and multiplies the previous state by the reset gate
+void gruGates( float* gates, const float* prevState, float* resetState, int hiddenSize );
+// Applies tanh to the candidate and blends it with the previous state:
+//     newState = ( 1 - update ) * candidate + update * prevState
+void gruState( const float* update, float* candidate, const float* prevState, float* newState, int hiddenSize );
+
+// Conversions between float and 16-bit floats
+// The float to IEEE half precision conversions may be called only if CCPUInfo::HasF16c
+void vectorConvert( const float* from, CFloat16* to, int vectorSize );
+void vectorConvert( const CFloat16* from, float* to, int vectorSize );
+void vectorConvert( const float* from, CBFloat16* to, int vectorSize );
+void vectorConvert( const CBFloat16* from, float* to, int vectorSize );
+// Uses the AVX-512 BF16 instructions (the denormals are flushed to zero)
+// May be called only if CCPUInfo::HasAvx512Bf16
+void vectorConvertAvx512Bf16( const float* from, CBFloat16* to, int vectorSize );
+
+// Layer normalization of a single row (see IDnnEngine::LayerNorm)
+// The residual and normalized may be null
+void layerNormRow( const float* input, const float* residual, int width, float epsilon,
+	const float* scale, const float* bias, float* result, float* normalized, float& invStdDev );
+void layerNormBackwardRow( const float* normalized, float invStdDev, const float* outputDiff, int width,
+	const float* scale, float* inputDiff );
+
+// Winograd F(2x2, 3x3) transforms of a single tile (see CCpuMathEngine::blobConvolutionWinograd)
+// The channels must be a multiple of 8
+void winogradInputTransform( const float* const* input, int channels, float* result, int resultStride );
+void winogradOutputTransform( const float* input, int inputStride, int channels, const float* freeTerm,
+	float* const* result );
+
+// Multiplies the tile of 8 rows (transposed: 8 values for each column) by the transposed sparse matrix in CSR format
+// The freeTerm may be null; the result is 8 rows of the given height
+void sparseWeightsMultiplyTile( const float* tile, int height, const int* rows, const int* columns,
+	const float* values, const float* freeTerm, float* result );
+// Multiplies a single row by the transposed sparse matrix in CSR format, gathering the row elements by the columns
+void sparseWeightsMultiplyRow( const float* first, int height, const int* rows, const int* columns,
+	const float* values, const float* freeTerm, float* result );
+
 } // namespace Avx2
 
 } // namespace NeoML
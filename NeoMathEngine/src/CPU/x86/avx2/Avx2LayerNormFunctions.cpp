@@ -0,0 +1,155 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#include <NeoMathEngine/NeoMathEngineDefs.h>
+
+#ifdef NEOML_USE_SSE
+
+#include "Avx2Functions.h"
+
+#include <immintrin.h>
+#include <cmath>
+
+static constexpr int LayerNormBlockSize = 8;
+
+namespace NeoML {
+
+namespace Avx2 {
+
+static inline __m256 loadLayerNormInput( const float* input, const float* residual, int index )
+{
+	const __m256 data = _mm256_loadu_ps( input + index );
+	return residual == nullptr ? data : _mm256_add_ps( data, _mm256_loadu_ps( residual + index ) );
+}
+
+static inline float horizontalSum( __m256 data )
+{
+	const __m128 sum = _mm_add_ps( _mm256_castps256_ps128( data ), _mm256_extractf128_ps( data, 1 ) );
+	const __m128 pairs = _mm_add_ps( sum, _mm_movehl_ps( sum, sum ) );
+	return _mm_cvtss_f32( _mm_add_ss( pairs, _mm_shuffle_ps( pairs, pairs, 1 ) ) );
+}
+
+// Merges the Welford's statistics of two parts of the data (Chan's formula)
+static inline void mergeWelford( float& count, float& mean, float& m2, float otherCount, float otherMean, float otherM2 )
+{
+	const float total = count + otherCount;
+	const float delta = otherMean - mean;
+	mean += delta * otherCount / total;
+	m2 += otherM2 + delta * delta * count * otherCount / total;
+	count = total;
+}
+
+void layerNormRow( const float* input, const float* residual, int width, float epsilon,
+	const float* scale, const float* bias, float* result, float* normalized, float& invStdDev )
+{
+	const int blockCount = width / LayerNormBlockSize;
+	const int tailStart = blockCount * LayerNormBlockSize;
+
+	// Each lane accumulates the statistics of every LayerNormBlockSize'th element
+	float count = 0;
+	float mean = 0;
+	float m2 = 0;
+	if( blockCount > 0 ) {
+		__m256 meanVec = _mm256_setzero_ps();
+		__m256 m2Vec = _mm256_setzero_ps();
+		for( int i = 0; i < blockCount; ++i ) {
+			const __m256 data = loadLayerNormInput( input, residual, i * LayerNormBlockSize );
+			const __m256 delta = _mm256_sub_ps( data, meanVec );
+			meanVec = _mm256_fmadd_ps( delta, _mm256_set1_ps( 1.f / ( i + 1 ) ), meanVec );
+			m2Vec = _mm256_fmadd_ps( delta, _mm256_sub_ps( data, meanVec ), m2Vec );
+		}
+
+		float laneMeans[LayerNormBlockSize];
+		float laneM2s[LayerNormBlockSize];
+		_mm256_storeu_ps( laneMeans, meanVec );
+		_mm256_storeu_ps( laneM2s, m2Vec );
+		count = static_cast<float>( blockCount );
+		mean = laneMeans[0];
+		m2 = laneM2s[0];
+		for( int lane = 1; lane < LayerNormBlockSize; ++lane ) {
+			mergeWelford( count, mean, m2, static_cast<float>( blockCount ), laneMeans[lane], laneM2s[lane] );
+		}
+	}
+	for( int i = tailStart; i < width; ++i ) {
+		const float data = residual == nullptr ? input[i] : input[i] + residual[i];
+		count += 1;
+		const float delta = data - mean;
+		mean += delta / count;
+		m2 += delta * ( data - mean );
+	}
+	invStdDev = 1.f / std::sqrt( m2 / width + epsilon );
+
+	const __m256 meanVec = _mm256_set1_ps( mean );
+	const __m256 invStdDevVec = _mm256_set1_ps( invStdDev );
+	for( int i = 0; i < tailStart; i += LayerNormBlockSize ) {
+		const __m256 norm = _mm256_mul_ps( _mm256_sub_ps( loadLayerNormInput( input, residual, i ), meanVec ),
+			invStdDevVec );
+		if( normalized != nullptr ) {
+			_mm256_storeu_ps( normalized + i, norm );
+		}
+		_mm256_storeu_ps( result + i, _mm256_fmadd_ps( norm, _mm256_loadu_ps( scale + i ),
+			_mm256_loadu_ps( bias + i ) ) );
+	}
+	for( int i = tailStart; i < width; ++i ) {
+		const float norm = ( ( residual == nullptr ? input[i] : input[i] + residual[i] ) - mean ) * invStdDev;
+		if( normalized != nullptr ) {
+			normalized[i] = norm;
+		}
+		result[i] = norm * scale[i] + bias[i];
+	}
+}
+
+void layerNormBackwardRow( const float* normalized, float invStdDev, const float* outputDiff, int width,
+	const float* scale, float* inputDiff )
+{
+	const int tailStart = ( width / LayerNormBlockSize ) * LayerNormBlockSize;
+
+	__m256 diffSumVec = _mm256_setzero_ps();
+	__m256 normDiffSumVec = _mm256_setzero_ps();
+	for( int i = 0; i < tailStart; i += LayerNormBlockSize ) {
+		const __m256 diff = _mm256_mul_ps( _mm256_loadu_ps( outputDiff + i ), _mm256_loadu_ps( scale + i ) );
+		diffSumVec = _mm256_add_ps( diffSumVec, diff );
+		normDiffSumVec = _mm256_fmadd_ps( diff, _mm256_loadu_ps( normalized + i ), normDiffSumVec );
+	}
+	float diffSum = horizontalSum( diffSumVec );
+	float normDiffSum = horizontalSum( normDiffSumVec );
+	for( int i = tailStart; i < width; ++i ) {
+		const float diff = outputDiff[i] * scale[i];
+		diffSum += diff;
+		normDiffSum += diff * normalized[i];
+	}
+
+	const float diffMean = diffSum / width;
+	const float normDiffMean = normDiffSum / width;
+	const __m256 diffMeanVec = _mm256_set1_ps( diffMean );
+	const __m256 normDiffMeanVec = _mm256_set1_ps( normDiffMean );
+	const __m256 invStdDevVec = _mm256_set1_ps( invStdDev );
+	for( int i = 0; i < tailStart; i += LayerNormBlockSize ) {
+		const __m256 diff = _mm256_mul_ps( _mm256_loadu_ps( outputDiff + i ), _mm256_loadu_ps( scale + i ) );
+		const __m256 centered = _mm256_fnmadd_ps( _mm256_loadu_ps( normalized + i ), normDiffMeanVec,
+			_mm256_sub_ps( diff, diffMeanVec ) );
+		_mm256_storeu_ps( inputDiff + i, _mm256_mul_ps( centered, invStdDevVec ) );
+	}
+	for( int i = tailStart; i < width; ++i ) {
+		const float diff = outputDiff[i] * scale[i];
+		inputDiff[i] = ( diff - diffMean - normalized[i] * normDiffMean ) * invStdDev;
+	}
+}
+
+} // namespace Avx2
+
+} // namespace NeoML
+
+#endif // NEOML_USE_SSE
@@ -0,0 +1,427 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#include <NeoMathEngine/NeoMathEngineDefs.h>
+
+#ifdef NEOML_USE_SSE
+
+#include "Avx2Functions.h"
+
+#include <immintrin.h>
+#include <cfloat>
+#include <cmath>
+
+static constexpr int MathBlockSize = 8;
+
+static constexpr int mathIOMask[2 * MathBlockSize - 2] = { -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0 };
+
+#define MATH_IO_MASK( N ) \
+	_mm256_lddqu_si256( reinterpret_cast<const __m256i*>( mathIOMask + MathBlockSize - 1 - N ) )
+
+// The same limits as in ExponentFunc
+static constexpr float MathMinLog = -87.336544f;
+static constexpr float MathMaxLog = 88.f;
+
+namespace NeoML {
+
+namespace Avx2 {
+
+// Applies the function to every element of the vector
+template<class TFunction>
+static inline void transform( const float* first, float* result, int vectorSize, const TFunction& function )
+{
+	for( ; vectorSize >= MathBlockSize; vectorSize -= MathBlockSize ) {
+		_mm256_storeu_ps( result, function( _mm256_loadu_ps( first ) ) );
+		first += MathBlockSize;
+		result += MathBlockSize;
+	}
+
+	if( vectorSize > 0 ) {
+		const __m256i mask = MATH_IO_MASK( vectorSize );
+		_mm256_maskstore_ps( result, mask, function( _mm256_maskload_ps( first, mask ) ) );
+	}
+}
+
+// Applies the function to every pair of elements of the vectors
+template<class TFunction>
+static inline void transform( const float* first, const float* second, float* result, int vectorSize,
+	const TFunction& function )
+{
+	for( ; vectorSize >= MathBlockSize; vectorSize -= MathBlockSize ) {
+		_mm256_storeu_ps( result, function( _mm256_loadu_ps( first ), _mm256_loadu_ps( second ) ) );
+		first += MathBlockSize;
+		second += MathBlockSize;
+		result += MathBlockSize;
+	}
+
+	if( vectorSize > 0 ) {
+		const __m256i mask = MATH_IO_MASK( vectorSize );
+		_mm256_maskstore_ps( result, mask,
+			function( _mm256_maskload_ps( first, mask ), _mm256_maskload_ps( second, mask ) ) );
+	}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+// Exponent based on the Cephes library expf
+// Returns 0 below MathMinLog and FLT_MAX above MathMaxLog (the same as ExponentFunc)
+static inline __m256 expAvx( const __m256& x )
+{
+	const __m256 clamped = _mm256_min_ps( _mm256_max_ps( x, _mm256_set1_ps( MathMinLog ) ),
+		_mm256_set1_ps( MathMaxLog ) );
+
+	// exp(x) = 2^n * exp(r), where n = round(x / ln(2)), r = x - n * ln(2)
+	const __m256 n = _mm256_round_ps( _mm256_mul_ps( clamped, _mm256_set1_ps( 1.44269504088896341f ) ),
+		_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC );
+	// ln(2) is split into two parts for better precision
+	__m256 r = _mm256_fnmadd_ps( n, _mm256_set1_ps( 0.693359375f ), clamped );
+	r = _mm256_fnmadd_ps( n, _mm256_set1_ps( -2.12194440e-4f ), r );
+
+	__m256 poly = _mm256_set1_ps( 1.9875691500E-4f );
+	poly = _mm256_fmadd_ps( poly, r, _mm256_set1_ps( 1.3981999507E-3f ) );
+	poly = _mm256_fmadd_ps( poly, r, _mm256_set1_ps( 8.3334519073E-3f ) );
+	poly = _mm256_fmadd_ps( poly, r, _mm256_set1_ps( 4.1665795894E-2f ) );
+	poly = _mm256_fmadd_ps( poly, r, _mm256_set1_ps( 1.6666665459E-1f ) );
+	poly = _mm256_fmadd_ps( poly, r, _mm256_set1_ps( 5.0000001201E-1f ) );
+	poly = _mm256_fmadd_ps( poly, _mm256_mul_ps( r, r ), _mm256_add_ps( r, _mm256_set1_ps( 1.f ) ) );
+
+	// The binary exponent of n is in [-126, 127] so 2^n is a normalized number
+	const __m256i pow2n = _mm256_slli_epi32( _mm256_add_epi32( _mm256_cvtps_epi32( n ),
+		_mm256_set1_epi32( 127 ) ), 23 );
+	__m256 result = _mm256_mul_ps( poly, _mm256_castsi256_ps( pow2n ) );
+
+	result = _mm256_andnot_ps( _mm256_cmp_ps( x, _mm256_set1_ps( MathMinLog ), _CMP_LT_OQ ), result );
+	return _mm256_blendv_ps( result, _mm256_set1_ps( FLT_MAX ),
+		_mm256_cmp_ps( x, _mm256_set1_ps( MathMaxLog ), _CMP_GT_OQ ) );
+}
+
+// Natural logarithm based on the Cephes library logf
+// The argument is clamped to [FLT_MIN, FLT_MAX]
+static inline __m256 logAvx( const __m256& x )
+{
+	const __m256 one = _mm256_set1_ps( 1.f );
+	const __m256 clamped = _mm256_min_ps( _mm256_max_ps( x, _mm256_set1_ps( FLT_MIN ) ), _mm256_set1_ps( FLT_MAX ) );
+
+	// x = m * 2^e, where m is in [0.5, 1)
+	const __m256i bits = _mm256_castps_si256( clamped );
+	__m256 e = _mm256_cvtepi32_ps( _mm256_sub_epi32( _mm256_srli_epi32( bits, 23 ), _mm256_set1_epi32( 126 ) ) );
+	__m256 m = _mm256_castsi256_ps( _mm256_or_si256( _mm256_and_si256( bits, _mm256_set1_epi32( 0x007fffff ) ),
+		_mm256_castps_si256( _mm256_set1_ps( 0.5f ) ) ) );
+
+	// Move m to [sqrt(0.5), sqrt(2)) and take m - 1
+	const __m256 isSmall = _mm256_cmp_ps( m, _mm256_set1_ps( 0.707106781186547524f ), _CMP_LT_OQ );
+	e = _mm256_sub_ps( e, _mm256_and_ps( isSmall, one ) );
+	m = _mm256_sub_ps( _mm256_add_ps( m, _mm256_and_ps( isSmall, m ) ), one );
+
+	const __m256 m2 = _mm256_mul_ps( m, m );
+	__m256 poly = _mm256_set1_ps( 7.0376836292E-2f );
+	poly = _mm256_fmadd_ps( poly, m, _mm256_set1_ps( -1.1514610310E-1f ) );
+	poly = _mm256_fmadd_ps( poly, m, _mm256_set1_ps( 1.1676998740E-1f ) );
+	poly = _mm256_fmadd_ps( poly, m, _mm256_set1_ps( -1.2420140846E-1f ) );
+	poly = _mm256_fmadd_ps( poly, m, _mm256_set1_ps( 1.4249322787E-1f ) );
+	poly = _mm256_fmadd_ps( poly, m, _mm256_set1_ps( -1.6668057665E-1f ) );
+	poly = _mm256_fmadd_ps( poly, m, _mm256_set1_ps( 2.0000714765E-1f ) );
+	poly = _mm256_fmadd_ps( poly, m, _mm256_set1_ps( -2.4999993993E-1f ) );
+	poly = _mm256_fmadd_ps( poly, m, _mm256_set1_ps( 3.3333331174E-1f ) );
+	poly = _mm256_mul_ps( _mm256_mul_ps( poly, m ), m2 );
+
+	// ln(2) is split into two parts for better precision
+	poly = _mm256_fmadd_ps( e, _mm256_set1_ps( -2.12194440e-4f ), poly );
+	poly = _mm256_fnmadd_ps( m2, _mm256_set1_ps( 0.5f ), poly );
+	return _mm256_fmadd_ps( e, _mm256_set1_ps( 0.693359375f ), _mm256_add_ps( m, poly ) );
+}
+
+// Error function
+// The Taylor series is used for |x| < 1 and the Abramowitz and Stegun 7.1.26 approximation otherwise
+// The absolute error is below 2e-7
+static inline __m256 erfAvx( const __m256& x )
+{
+	const __m256 signMask = _mm256_set1_ps( -0.f );
+	const __m256 absX = _mm256_andnot_ps( signMask, x );
+	const __m256 x2 = _mm256_mul_ps( x, x );
+
+	// 2 / sqrt(pi) * sum( (-1)^k * x^(2k + 1) / ( k! * ( 2k + 1 ) ) )
+	__m256 series = _mm256_set1_ps( -1.2290555301717926e-9f );
+	series = _mm256_fmadd_ps( series, x2, _mm256_set1_ps( 1.4807192815879218e-8f ) );
+	series = _mm256_fmadd_ps( series, x2, _mm256_set1_ps( -1.6365844691234924e-7f ) );
+	series = _mm256_fmadd_ps( series, x2, _mm256_set1_ps( 1.6462114365889246e-6f ) );
+	series = _mm256_fmadd_ps( series, x2, _mm256_set1_ps( -1.4925650358406250e-5f ) );
+	series = _mm256_fmadd_ps( series, x2, _mm256_set1_ps( 1.2055332981789664e-4f ) );
+	series = _mm256_fmadd_ps( series, x2, _mm256_set1_ps( -8.5483270234508522e-4f ) );
+	series = _mm256_fmadd_ps( series, x2, _mm256_set1_ps( 5.2239776254421879e-3f ) );
+	series = _mm256_fmadd_ps( series, x2, _mm256_set1_ps( -2.6866170645131252e-2f ) );
+	series = _mm256_fmadd_ps( series, x2, _mm256_set1_ps( 1.1283791670955126e-1f ) );
+	series = _mm256_fmadd_ps( series, x2, _mm256_set1_ps( -3.7612638903183754e-1f ) );
+	series = _mm256_fmadd_ps( series, x2, _mm256_set1_ps( 1.1283791670955126f ) );
+	series = _mm256_mul_ps( series, x );
+
+	// 1 - t * ( a1 + t * ( a2 + t * ( a3 + t * ( a4 + t * a5 ) ) ) ) * exp(-x^2), where t = 1 / ( 1 + p * |x| )
+	const __m256 t = _mm256_div_ps( _mm256_set1_ps( 1.f ),
+		_mm256_fmadd_ps( absX, _mm256_set1_ps( 0.3275911f ), _mm256_set1_ps( 1.f ) ) );
+	__m256 poly = _mm256_set1_ps( 1.061405429f );
+	poly = _mm256_fmadd_ps( poly, t, _mm256_set1_ps( -1.453152027f ) );
+	poly = _mm256_fmadd_ps( poly, t, _mm256_set1_ps( 1.421413741f ) );
+	poly = _mm256_fmadd_ps( poly, t, _mm256_set1_ps( -0.284496736f ) );
+	poly = _mm256_fmadd_ps( poly, t, _mm256_set1_ps( 0.254829592f ) );
+	poly = _mm256_mul_ps( poly, t );
+	__m256 approximation = _mm256_fnmadd_ps( poly, expAvx( _mm256_xor_ps( x2, signMask ) ), _mm256_set1_ps( 1.f ) );
+	approximation = _mm256_or_ps( approximation, _mm256_and_ps( x, signMask ) );
+
+	return _mm256_blendv_ps( approximation, series, _mm256_cmp_ps( absX, _mm256_set1_ps( 1.f ), _CMP_LT_OQ ) );
+}
+
+static inline __m256 sigmoidAvx( const __m256& x )
+{
+	const __m256 one = _mm256_set1_ps( 1.f );
+	return _mm256_div_ps( one, _mm256_add_ps( one, expAvx( _mm256_xor_ps( x, _mm256_set1_ps( -0.f ) ) ) ) );
+}
+
+// tanh(x) = 2 * sigmoid(2x) - 1
+static inline __m256 tanhAvx( const __m256& x )
+{
+	const __m256 sigmoid = sigmoidAvx( _mm256_add_ps( x, x ) );
+	return _mm256_sub_ps( _mm256_add_ps( sigmoid, sigmoid ), _mm256_set1_ps( 1.f ) );
+}
+
+// Calculates x^n for the integer n
+static inline __m256 integerPowerAvx( const __m256& x, int exponent )
+{
+	unsigned int n = static_cast<unsigned int>( exponent < 0 ? -static_cast<long long>( exponent ) : exponent );
+	__m256 result = _mm256_set1_ps( 1.f );
+	__m256 power = x;
+	while( n != 0 ) {
+		if( ( n & 1 ) != 0 ) {
+			result = _mm256_mul_ps( result, power );
+		}
+		power = _mm256_mul_ps( power, power );
+		n >>= 1;
+	}
+	return exponent < 0 ? _mm256_div_ps( _mm256_set1_ps( 1.f ), result ) : result;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+// The constants for GELU
+static constexpr float GeluSqrt2Inv = 0.707106781186547524f;
+static constexpr float GeluSqrt2PiInv = 0.398942280401432678f;
+static constexpr float GeluApproximationMultiplier = 1.702f;
+static constexpr float GeluSqrt2PiScale = 0.797884560802865356f; // sqrt(2/pi)
+static constexpr float GeluTanhCubicCoeff = 0.044715f;
+
+void vectorExp( const float* first, float* result, int vectorSize )
+{
+	transform( first, result, vectorSize, []( const __m256& x ) { return expAvx( x ); } );
+}
+
+void vectorLog( const float* first, float* result, int vectorSize )
+{
+	transform( first, result, vectorSize, []( const __m256& x ) { return logAvx( x ); } );
+}
+
+void vectorPower( float exponent, const float* first, float* result, int vectorSize )
+{
+	// The floats above 2^24 are even integers
+	if( std::fabs( exponent ) < 16777216.f && std::roundf( exponent ) == exponent ) {
+		const int intExponent = static_cast<int>( exponent );
+		transform( first, result, vectorSize,
+			[intExponent]( const __m256& x ) { return integerPowerAvx( x, intExponent ); } );
+		return;
+	}
+
+	const bool isInteger = std::roundf( exponent ) == exponent;
+	const __m256 exponentSimd = _mm256_set1_ps( exponent );
+	// The value for zero: 0^e == 0 if e > 0, +inf if e < 0
+	const __m256 zeroPower = _mm256_set1_ps( exponent > 0 ? 0.f : INFINITY );
+	transform( first, result, vectorSize, [&]( const __m256& x ) {
+		const __m256 absX = _mm256_andnot_ps( _mm256_set1_ps( -0.f ), x );
+		__m256 res = expAvx( _mm256_mul_ps( exponentSimd, logAvx( absX ) ) );
+		// The result for the negative values is defined only for the integer exponent
+		if( !isInteger ) {
+			res = _mm256_blendv_ps( res, _mm256_set1_ps( NAN ), _mm256_cmp_ps( x, _mm256_setzero_ps(), _CMP_LT_OQ ) );
+		}
+		return _mm256_blendv_ps( res, zeroPower, _mm256_cmp_ps( x, _mm256_setzero_ps(), _CMP_EQ_OQ ) );
+	} );
+}
+
+void vectorTanh( const float* first, float* result, int vectorSize )
+{
+	transform( first, result, vectorSize, []( const __m256& x ) { return tanhAvx( x ); } );
+}
+
+void vectorSigmoid( const float* first, float* result, int vectorSize )
+{
+	transform( first, result, vectorSize, []( const __m256& x ) { return sigmoidAvx( x ); } );
+}
+
+void vectorErf( const float* first, float* result, int vectorSize )
+{
+	transform( first, result, vectorSize, []( const __m256& x ) { return erfAvx( x ); } );
+}
+
+void vectorELU( const float* first, float* result, int vectorSize, float alpha )
+{
+	const __m256 alphaSimd = _mm256_set1_ps( alpha );
+	transform( first, result, vectorSize, [&alphaSimd]( const __m256& x ) {
+		const __m256 negative = _mm256_mul_ps( alphaSimd, _mm256_sub_ps( expAvx( x ), _mm256_set1_ps( 1.f ) ) );
+		return _mm256_blendv_ps( x, negative, _mm256_cmp_ps( x, _mm256_setzero_ps(), _CMP_LT_OQ ) );
+	} );
+}
+
+void vectorGelu( const float* first, float* result, int vectorSize, CGELUActivationParam::TCalculationMode mode )
+{
+	switch( mode ) {
+		case CGELUActivationParam::TCalculationMode::CM_Precise:
+			// x * 0.5( 1 + erf( x / sqrt(2) ) )
+			transform( first, result, vectorSize, []( const __m256& x ) {
+				const __m256 half = _mm256_set1_ps( 0.5f );
+				const __m256 erf = erfAvx( _mm256_mul_ps( x, _mm256_set1_ps( GeluSqrt2Inv ) ) );
+				return _mm256_mul_ps( x, _mm256_fmadd_ps( erf, half, half ) );
+			} );
+			break;
+		case CGELUActivationParam::TCalculationMode::CM_SigmoidApproximate:
+			// x * sigmoid(1.702x)
+			transform( first, result, vectorSize, []( const __m256& x ) {
+				return _mm256_mul_ps( x, sigmoidAvx( _mm256_mul_ps( x, _mm256_set1_ps( GeluApproximationMultiplier ) ) ) );
+			} );
+			break;
+		case CGELUActivationParam::TCalculationMode::CM_TanhApproximate:
+			// x * 0.5( 1 + tanh( sqrt(2/pi)( x + 0.044715x^3 ) ) )
+			transform( first, result, vectorSize, []( const __m256& x ) {
+				const __m256 half = _mm256_set1_ps( 0.5f );
+				const __m256 inner = _mm256_mul_ps( x, _mm256_fmadd_ps( _mm256_mul_ps( x, x ),
+					_mm256_set1_ps( GeluSqrt2PiScale * GeluTanhCubicCoeff ), _mm256_set1_ps( GeluSqrt2PiScale ) ) );
+				return _mm256_mul_ps( x, _mm256_fmadd_ps( tanhAvx( inner ), half, half ) );
+			} );
+			break;
+		default:
+			ASSERT_EXPR( false );
+	}
+}
+
+void vectorGeluDiff( const float* first, const float* outputDiff, float* result, int vectorSize,
+	CGELUActivationParam::TCalculationMode mode )
+{
+	switch( mode ) {
+		case CGELUActivationParam::TCalculationMode::CM_Precise:
+			// 0.5( 1 + erf( x / sqrt(2) ) ) + x / sqrt(2pi) * e^( -x^2 / 2 )
+			transform( first, outputDiff, result, vectorSize, []( const __m256& x, const __m256& diff ) {
+				const __m256 half = _mm256_set1_ps( 0.5f );
+				const __m256 cdf = _mm256_fmadd_ps( erfAvx( _mm256_mul_ps( x, _mm256_set1_ps( GeluSqrt2Inv ) ) ),
+					half, half );
+				const __m256 pdf = _mm256_mul_ps( _mm256_set1_ps( GeluSqrt2PiInv ),
+					expAvx( _mm256_mul_ps( _mm256_mul_ps( x, x ), _mm256_set1_ps( -0.5f ) ) ) );
+				return _mm256_mul_ps( diff, _mm256_fmadd_ps( x, pdf, cdf ) );
+			} );
+			break;
+		case CGELUActivationParam::TCalculationMode::CM_SigmoidApproximate:
+			// sigmoid(1.702x) + 1.702x * sigmoid(1.702x) * ( 1 - sigmoid(1.702x) )
+			transform( first, outputDiff, result, vectorSize, []( const __m256& x, const __m256& diff ) {
+				const __m256 scaled = _mm256_mul_ps( x, _mm256_set1_ps( GeluApproximationMultiplier ) );
+				const __m256 sigmoid = sigmoidAvx( scaled );
+				const __m256 sigmoidDiff = _mm256_fnmadd_ps( sigmoid, sigmoid, sigmoid );
+				return _mm256_mul_ps( diff, _mm256_fmadd_ps( scaled, sigmoidDiff, sigmoid ) );
+			} );
+			break;
+		case CGELUActivationParam::TCalculationMode::CM_TanhApproximate:
+			// 0.5( 1 + tanh(u) ) + 0.5x * ( 1 - tanh(u)^2 ) * u', where u = sqrt(2/pi)( x + 0.044715x^3 )
+			transform( first, outputDiff, result, vectorSize, []( const __m256& x, const __m256& diff ) {
+				const __m256 half = _mm256_set1_ps( 0.5f );
+				const __m256 x2 = _mm256_mul_ps( x, x );
+				const __m256 inner = _mm256_mul_ps( x, _mm256_fmadd_ps( x2,
+					_mm256_set1_ps( GeluSqrt2PiScale * GeluTanhCubicCoeff ), _mm256_set1_ps( GeluSqrt2PiScale ) ) );
+				const __m256 innerDiff = _mm256_fmadd_ps( x2,
+					_mm256_set1_ps( 3.f * GeluSqrt2PiScale * GeluTanhCubicCoeff ), _mm256_set1_ps( GeluSqrt2PiScale ) );
+				// 0.5( 1 + tanh(u) ) = sigmoid(2u)
+				// 1 - tanh(u)^2 = 4 * sigmoid(2u) * e^(-2u) * sigmoid(2u) has no cancellation near +-1
+				const __m256 one = _mm256_set1_ps( 1.f );
+				const __m256 exp = expAvx( _mm256_mul_ps( inner, _mm256_set1_ps( -2.f ) ) );
+				const __m256 sigmoid = _mm256_div_ps( one, _mm256_add_ps( one, exp ) );
+				const __m256 tanhDiff = _mm256_mul_ps( _mm256_mul_ps( _mm256_mul_ps( sigmoid, _mm256_set1_ps( 4.f ) ),
+					sigmoid ), exp );
+				return _mm256_mul_ps( diff, _mm256_fmadd_ps( _mm256_mul_ps( x, half ), _mm256_mul_ps( tanhDiff, innerDiff ),
+					sigmoid ) );
+			} );
+			break;
+		default:
+			ASSERT_EXPR( false );
+	}
+}
+
+void vectorSilu( const float* first, float* result, int vectorSize )
+{
+	transform( first, result, vectorSize, []( const __m256& x ) { return _mm256_mul_ps( x, sigmoidAvx( x ) ); } );
+}
+
+void vectorSiluDiff( const float* first, const float* outputDiff, float* result, int vectorSize )
+{
+	// sigmoid(x) + x * sigmoid(x) * ( 1 - sigmoid(x) )
+	transform( first, outputDiff, result, vectorSize, []( const __m256& x, const __m256& diff ) {
+		const __m256 sigmoid = sigmoidAvx( x );
+		const __m256 sigmoidDiff = _mm256_fnmadd_ps( sigmoid, sigmoid, sigmoid );
+		return _mm256_mul_ps( diff, _mm256_fmadd_ps( x, sigmoidDiff, sigmoid ) );
+	} );
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+void gruGates( float* gates, const float* prevState, float* resetState, int hiddenSize )
+{
+	float* update = gates;
+	float* reset = gates + hiddenSize;
+	int j = 0;
+	for( ; j + MathBlockSize <= hiddenSize; j += MathBlockSize ) {
+		_mm256_storeu_ps( update + j, sigmoidAvx( _mm256_loadu_ps( update + j ) ) );
+		const __m256 resetGate = sigmoidAvx( _mm256_loadu_ps( reset + j ) );
+		_mm256_storeu_ps( reset + j, resetGate );
+		_mm256_storeu_ps( resetState + j, _mm256_mul_ps( resetGate, _mm256_loadu_ps( prevState + j ) ) );
+	}
+
+	const int rest = hiddenSize - j;
+	if( rest > 0 ) {
+		const __m256i mask = MATH_IO_MASK( rest );
+		_mm256_maskstore_ps( update + j, mask, sigmoidAvx( _mm256_maskload_ps( update + j, mask ) ) );
+		const __m256 resetGate = sigmoidAvx( _mm256_maskload_ps( reset + j, mask ) );
+		_mm256_maskstore_ps( reset + j, mask, resetGate );
+		_mm256_maskstore_ps( resetState + j, mask,
+			_mm256_mul_ps( resetGate, _mm256_maskload_ps( prevState + j, mask ) ) );
+	}
+}
+
+void gruState( const float* update, float* candidate, const float* prevState, float* newState, int hiddenSize )
+{
+	// newState = candidate + update * ( prevState - candidate )
+	int j = 0;
+	for( ; j + MathBlockSize <= hiddenSize; j += MathBlockSize ) {
+		const __m256 candidateValue = tanhAvx( _mm256_loadu_ps( candidate + j ) );
+		_mm256_storeu_ps( candidate + j, candidateValue );
+		_mm256_storeu_ps( newState + j, _mm256_fmadd_ps( _mm256_loadu_ps( update + j ),
+			_mm256_sub_ps( _mm256_loadu_ps( prevState + j ), candidateValue ), candidateValue ) );
+	}
+
+	const int rest = hiddenSize - j;
+	if( rest > 0 ) {
+		const __m256i mask = MATH_IO_MASK( rest );
+		const __m256 candidateValue = tanhAvx( _mm256_maskload_ps( candidate + j, mask ) );
+		_mm256_maskstore_ps( candidate + j, mask, candidateValue );
+		_mm256_maskstore_ps( newState + j, mask, _mm256_fmadd_ps( _mm256_maskload_ps( update + j, mask ),
+			_mm256_sub_ps( _mm256_maskload_ps( prevState + j, mask ), candidateValue ), candidateValue ) );
+	}
+}
+
+} // namespace Avx2
+
+} // namespace NeoML
+
+#endif // NEOML_USE_SSE
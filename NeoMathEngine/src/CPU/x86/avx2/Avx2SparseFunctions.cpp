@@ -0,0 +1,89 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#include <NeoMathEngine/NeoMathEngineDefs.h>
+
+#ifdef NEOML_USE_SSE
+
+#include "Avx2Functions.h"
+
+#include <immintrin.h>
+
+namespace NeoML {
+
+namespace Avx2 {
+
+void sparseWeightsMultiplyTile( const float* tile, int height, const int* rows, const int* columns,
+	const float* values, const float* freeTerm, float* result )
+{
+	alignas( 32 ) float stored[8];
+	for( int i = 0; i < height; ++i ) {
+		// Two accumulators so that the multiply-adds don't wait for each other
+		__m256 acc0 = freeTerm == nullptr ? _mm256_setzero_ps() : _mm256_set1_ps( freeTerm[i] );
+		__m256 acc1 = _mm256_setzero_ps();
+		int k = rows[i];
+		const int end = rows[i + 1];
+		for( ; k + 2 <= end; k += 2 ) {
+			acc0 = _mm256_fmadd_ps( _mm256_set1_ps( values[k] ), _mm256_loadu_ps( tile + columns[k] * 8 ), acc0 );
+			acc1 = _mm256_fmadd_ps( _mm256_set1_ps( values[k + 1] ),
+				_mm256_loadu_ps( tile + columns[k + 1] * 8 ), acc1 );
+		}
+		if( k < end ) {
+			acc0 = _mm256_fmadd_ps( _mm256_set1_ps( values[k] ), _mm256_loadu_ps( tile + columns[k] * 8 ), acc0 );
+		}
+		_mm256_store_ps( stored, _mm256_add_ps( acc0, acc1 ) );
+		for( int r = 0; r < 8; ++r ) {
+			result[r * height + i] = stored[r];
+		}
+	}
+}
+
+void sparseWeightsMultiplyRow( const float* first, int height, const int* rows, const int* columns,
+	const float* values, const float* freeTerm, float* result )
+{
+	for( int i = 0; i < height; ++i ) {
+		// The elements of the row are gathered by the columns of 8 non-zero weights at once
+		__m256 acc0 = _mm256_setzero_ps();
+		__m256 acc1 = _mm256_setzero_ps();
+		int k = rows[i];
+		const int end = rows[i + 1];
+		for( ; k + 16 <= end; k += 16 ) {
+			acc0 = _mm256_fmadd_ps( _mm256_loadu_ps( values + k ), _mm256_i32gather_ps( first,
+				_mm256_loadu_si256( reinterpret_cast<const __m256i*>( columns + k ) ), 4 ), acc0 );
+			acc1 = _mm256_fmadd_ps( _mm256_loadu_ps( values + k + 8 ), _mm256_i32gather_ps( first,
+				_mm256_loadu_si256( reinterpret_cast<const __m256i*>( columns + k + 8 ) ), 4 ), acc1 );
+		}
+		if( k + 8 <= end ) {
+			acc0 = _mm256_fmadd_ps( _mm256_loadu_ps( values + k ), _mm256_i32gather_ps( first,
+				_mm256_loadu_si256( reinterpret_cast<const __m256i*>( columns + k ) ), 4 ), acc0 );
+			k += 8;
+		}
+		acc0 = _mm256_add_ps( acc0, acc1 );
+		__m128 sum = _mm_add_ps( _mm256_castps256_ps128( acc0 ), _mm256_extractf128_ps( acc0, 1 ) );
+		sum = _mm_add_ps( sum, _mm_movehl_ps( sum, sum ) );
+		sum = _mm_add_ss( sum, _mm_shuffle_ps( sum, sum, 1 ) );
+		float value = _mm_cvtss_f32( sum ) + ( freeTerm == nullptr ? 0.f : freeTerm[i] );
+		for( ; k < end; ++k ) {
+			value += values[k] * first[columns[k]];
+		}
+		result[i] = value;
+	}
+}
+
+} // namespace Avx2
+
+} // namespace NeoML
+
+#endif // NEOML_USE_SSE
@@ -0,0 +1,91 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#include <NeoMathEngine/NeoMathEngineDefs.h>
+
+#ifdef NEOML_USE_SSE
+
+#include "Avx2Functions.h"
+
+#include <immintrin.h>
+
+namespace NeoML {
+
+namespace Avx2 {
+
+// The 1d transforms of the input (B^T) and the output (A^T) of Winograd F(2x2, 3x3) for 8 channels at once
+static inline void winogradInputRow( const __m256* d, int step, __m256* result, int resultStep )
+{
+	result[0] = _mm256_sub_ps( d[0], d[2 * step] );
+	result[resultStep] = _mm256_add_ps( d[step], d[2 * step] );
+	result[2 * resultStep] = _mm256_sub_ps( d[2 * step], d[step] );
+	result[3 * resultStep] = _mm256_sub_ps( d[step], d[3 * step] );
+}
+
+static inline void winogradOutputRow( const __m256* m, int step, __m256* result, int resultStep )
+{
+	result[0] = _mm256_add_ps( _mm256_add_ps( m[0], m[step] ), m[2 * step] );
+	result[resultStep] = _mm256_sub_ps( _mm256_sub_ps( m[step], m[2 * step] ), m[3 * step] );
+}
+
+void winogradInputTransform( const float* const* input, int channels, float* result, int resultStride )
+{
+	__m256 d[16];
+	__m256 temp[16];
+	__m256 transformed[16];
+	for( int c = 0; c < channels; c += 8 ) {
+		for( int i = 0; i < 16; ++i ) {
+			d[i] = _mm256_loadu_ps( input[i] + c );
+		}
+		for( int col = 0; col < 4; ++col ) {
+			winogradInputRow( d + col, 4, temp + col, 4 );
+		}
+		for( int row = 0; row < 4; ++row ) {
+			winogradInputRow( temp + row * 4, 1, transformed + row * 4, 1 );
+		}
+		for( int i = 0; i < 16; ++i ) {
+			_mm256_storeu_ps( result + i * resultStride + c, transformed[i] );
+		}
+	}
+}
+
+void winogradOutputTransform( const float* input, int inputStride, int channels, const float* freeTerm,
+	float* const* result )
+{
+	__m256 m[16];
+	__m256 temp[8];
+	__m256 transformed[4];
+	for( int c = 0; c < channels; c += 8 ) {
+		for( int i = 0; i < 16; ++i ) {
+			m[i] = _mm256_loadu_ps( input + i * inputStride + c );
+		}
+		for( int col = 0; col < 4; ++col ) {
+			winogradOutputRow( m + col, 4, temp + col, 4 );
+		}
+		for( int row = 0; row < 2; ++row ) {
+			winogradOutputRow( temp + row * 4, 1, transformed + row * 2, 1 );
+		}
+		const __m256 bias = freeTerm == nullptr ? _mm256_setzero_ps() : _mm256_loadu_ps( freeTerm + c );
+		for( int i = 0; i < 4; ++i ) {
+			_mm256_storeu_ps( result[i] + c, _mm256_add_ps( transformed[i], bias ) );
+		}
+	}
+}
+
+} // namespace Avx2
+
+} // namespace NeoML
+
+#endif // NEOML_USE_SSE
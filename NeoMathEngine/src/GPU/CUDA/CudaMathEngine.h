@@ -58,10 +58,16 @@ public:
 	void VectorFill( const CIntHandle& result, int vectorSize, const CConstIntHandle& value ) override;
 	void VectorConvert( const CConstFloatHandle& from, const CIntHandle& to, int vectorSize ) override;
 	void VectorConvert( const CConstIntHandle& from, const CFloatHandle& to, int vectorSize ) override;
+	void VectorConvert( const CConstFloatHandle& from, const CFloat16Handle& to, int vectorSize ) override;
+	void VectorConvert( const CConstFloat16Handle& from, const CFloatHandle& to, int vectorSize ) override;
+	void VectorConvert( const CConstFloatHandle& from, const CBFloat16Handle& to, int vectorSize ) override;
+	void VectorConvert( const CConstBFloat16Handle& from, const CFloatHandle& to, int vectorSize ) override;
 	void VectorFillBernoulli( const CFloatHandle& result, float p, int vectorSize, float value, int seed ) override;
 	void FilterSmallValues( const CFloatHandle& data, int dataSize, float threshold ) override;
 	void VectorCopy( const CFloatHandle& first, const CConstFloatHandle& second, int vectorSize ) override;
 	void VectorCopy( const CIntHandle& first, const CConstIntHandle& second, int vectorSize ) override;
+	void VectorCopy( const CFloat16Handle& first, const CConstFloat16Handle& second, int vectorSize ) override;
+	void VectorCopy( const CBFloat16Handle& first, const CConstBFloat16Handle& second, int vectorSize ) override;
 	void BroadcastCopy( const CIntHandle& toHandle, const CConstIntHandle& fromHandle,
 		const CBlobDesc& toDesc, const CBlobDesc& fromDesc, int additionalWidth ) override;
 	void BroadcastCopy( const CFloatHandle& toHandle, const CConstFloatHandle& fromHandle,
@@ -110,6 +116,14 @@ public:
 		int vectorSize ) override;
 	void VectorHSwishDiff( const CConstFloatHandle& firstHandle, const CConstFloatHandle& secondHandle,
 		const CFloatHandle& resultHandle, int vectorSize ) override;
+	void VectorGELU( const CConstFloatHandle& firstHandle, const CFloatHandle& resultHandle,
+		int vectorSize, CGELUActivationParam::TCalculationMode mode ) override;
+	void VectorGELUDiff( const CConstFloatHandle& firstHandle, const CConstFloatHandle& secondHandle,
+		const CFloatHandle& resultHandle, int vectorSize, CGELUActivationParam::TCalculationMode mode ) override;
+	void VectorSiLU( const CConstFloatHandle& firstHandle, const CFloatHandle& resultHandle,
+		int vectorSize ) override;
+	void VectorSiLUDiff( const CConstFloatHandle& firstHandle, const CConstFloatHandle& secondHandle,
+		const CFloatHandle& resultHandle, int vectorSize ) override;
 	void VectorEltwiseMax( const CConstFloatHandle& firstHandle,
 		const CConstFloatHandle& secondHandle, const CFloatHandle& resultHandle, int vectorSize ) override;
 	void VectorEltwiseMin( const CConstFloatHandle& firstHandle,
@@ -333,6 +347,10 @@ public:
 	void MultiplyMatrixByTransposedMatrix( int batchSize, const CConstFloatHandle& firstHandle,
 		int firstHeight, int firstWidth, const CConstFloatHandle& secondHandle, int secondHeight,
 		const CFloatHandle& resultHandle, int resultBufferSize ) override;
+	void MultiplyMatrixByTransposedMatrix( const CConstFloatHandle& firstHandle, int firstHeight, int firstWidth,
+		const CConstFloat16Handle& secondHandle, int secondHeight, const CFloatHandle& resultHandle ) override;
+	void MultiplyMatrixByTransposedMatrix( const CConstFloatHandle& firstHandle, int firstHeight, int firstWidth,
+		const CConstBFloat16Handle& secondHandle, int secondHeight, const CFloatHandle& resultHandle ) override;
 	void MultiplySparseMatrixByTransposedMatrix( int firstHeight, int firstWidth, int secondHeight,
 		const CSparseMatrixDesc& firstDesc, const CConstFloatHandle& secondHandle, const CFloatHandle& resultHandle ) override;
 	void MultiplyTransposedMatrixBySparseMatrix( int firstHeight, int firstWidth, int secondWidth,
@@ -427,6 +445,19 @@ public:
 	void BlobConvolutionLearnAdd( const CConvolutionDesc& desc,
 		const CConstFloatHandle& input, const CConstFloatHandle& outputDiff, const CFloatHandle& filterDiff,
 		const CFloatHandle* freeTermDiff, bool isFreeTermDiffFromInput ) override;
+	void BlobConvolutionWithEpilogue( const CConvolutionDesc& desc, const CConstFloatHandle& source,
+		const CConstFloatHandle& filter, const CConstFloatHandle* freeTerm, const CActivationDesc& activation,
+		const CConstFloatHandle* residual, const CFloatHandle& result ) override;
+	void MultiplyMatrixByTransposedMatrixWithEpilogue( const CConstFloatHandle& first, int firstHeight,
+		int firstWidth, const CConstFloatHandle& second, int secondHeight, const CConstFloatHandle* freeTerm,
+		const CActivationDesc& activation, const CConstFloatHandle* residual, const CFloatHandle& result ) override;
+	CSparseWeightsDesc* InitSparseWeights( int height, int width, const CConstFloatHandle& weights ) override;
+	void MultiplyMatrixBySparseWeightsWithEpilogue( const CConstFloatHandle& first, int firstHeight,
+		const CSparseWeightsDesc& weights, const CConstFloatHandle* freeTerm, const CActivationDesc& activation,
+		const CConstFloatHandle* residual, const CFloatHandle& result ) override;
+	void BlobConvolutionWithSparseFilter( const CConvolutionDesc& desc, const CConstFloatHandle& source,
+		const CSparseWeightsDesc& filter, const CConstFloatHandle* freeTerm, const CActivationDesc& activation,
+		const CConstFloatHandle* residual, const CFloatHandle& result ) override;
 	CChannelwiseConvolutionDesc* InitBlobChannelwiseConvolution( const CBlobDesc& input,
 		int paddingHeight, int paddingWidth, int strideHeight, int strideWidth,
 		const CBlobDesc& filter, const CBlobDesc* freeTerm, const CBlobDesc& output ) override;
@@ -542,6 +573,12 @@ public:
 	void LrnBackward( const CLrnDesc& desc, const CConstFloatHandle& input, const CConstFloatHandle& output,
 		const CConstFloatHandle& outputDiff, const CConstFloatHandle& invSum, const CConstFloatHandle& invSumBeta,
 		const CFloatHandle& inputDiff ) override;
+	void LayerNorm( const CConstFloatHandle& input, const CConstFloatHandle* residual, int height, int width,
+		float epsilon, const CConstFloatHandle& scale, const CConstFloatHandle& bias, const CFloatHandle& result,
+		const CFloatHandle* normalized, const CFloatHandle* invStdDev ) override;
+	void LayerNormBackward( const CConstFloatHandle& normalized, const CConstFloatHandle& invStdDev,
+		const CConstFloatHandle& outputDiff, int height, int width, const CConstFloatHandle& scale,
+		const CFloatHandle& inputDiff ) override;
 	void CtcLossForward( int resultLen, int batchSize, int classCount, int labelLen, int blankLabel, bool skipBlanks,
 		const CConstFloatHandle& result, const CConstIntHandle& labels,
 		const CConstIntHandle& labelLens, const CConstIntHandle& resultLens, const CConstFloatHandle& labelWeights,
@@ -558,6 +595,21 @@ public:
 		const CConstFloatHandle& inputStateBackLink, const CConstFloatHandle& inputMainBackLink,
 		const CConstFloatHandle& input, const CFloatHandle& outputStateBackLink,
 		const CFloatHandle& outputMainBackLink ) override;
+	CGruDesc* InitGru( int hiddenSize, int objectSize,
+		const CConstFloatHandle& gateWeights, const CConstFloatHandle& gateFreeTerm,
+		const CConstFloatHandle& mainWeights, const CConstFloatHandle& mainFreeTerm ) override;
+	void Gru( CGruDesc& desc, bool reverse, int sequenceLength, int sequenceCount,
+		const CConstFloatHandle& inputState, const CConstFloatHandle& input, const CFloatHandle& output,
+		const CFloatHandle& gates ) override;
+	void GruBackward( CGruDesc& desc, bool reverse, int sequenceLength, int sequenceCount,
+		const CConstFloatHandle& inputState, const CConstFloatHandle& input, const CConstFloatHandle& output,
+		const CConstFloatHandle& gates, const CConstFloatHandle& outputDiff,
+		const CFloatHandle& inputStateDiff, const CFloatHandle& inputDiff,
+		const CFloatHandle& gateWeightsDiff, const CFloatHandle& gateFreeTermDiff,
+		const CFloatHandle& mainWeightsDiff, const CFloatHandle& mainFreeTermDiff ) override;
+	void BidirectionalGru( CGruDesc& directDesc, CGruDesc& reverseDesc, int sequenceLength, int sequenceCount,
+		const CConstFloatHandle& input, const CFloatHandle& directOutput, const CFloatHandle& reverseOutput,
+		IThreadPool* threadPool ) override;
 	void LinearInterpolation( const CConstFloatHandle& dataHandle, const CFloatHandle& resultHandle,
 		TInterpolationCoords coords, TInterpolationRound round, int objectCount, int scaledAxis,
 		int objectSize, float scale ) override;
@@ -605,10 +657,13 @@ public:
 		int outputChannels, bool residual ) override;
 	CRowwiseOperationDesc* InitRowwise2DPooling( bool isMax, int filterHeight, int filterWidth,
 		int strideHeight, int strideWidth ) override;
+	CRowwiseOperationDesc* InitRowwiseBatchNormalization( int channels, const CConstFloatHandle& multiplier,
+		const CConstFloatHandle& freeTerm ) override;
+	CRowwiseOperationDesc* InitRowwiseEltwiseSum() override;
 	CBlobDesc RowwiseReshape( CRowwiseOperationDesc** operations, int operationCount,
 		const CBlobDesc& input ) override;
 	void RowwiseExecute( const CBlobDesc& inputDesc, CRowwiseOperationDesc** operations, int operationCount,
-		const CFloatHandle& input, const CFloatHandle& output ) override;
+		const CFloatHandle& input, const CFloatHandle& output, IThreadPool* threadPool ) override;
 
 	IPerformanceCounters* CreatePerformanceCounters( bool ) const override { return new CPerformanceCountersDefault(); }
 	// For Distributed only
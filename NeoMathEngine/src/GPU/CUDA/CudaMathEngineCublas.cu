@@ -90,6 +90,18 @@ void CCudaMathEngine::MultiplyMatrixByTransposedMatrix( int batchSize, const CCo
 		secondHeight, secondHeight * firstHeight, batchSize ) );
 }
 
+void CCudaMathEngine::MultiplyMatrixByTransposedMatrix( const CConstFloatHandle&, int, int,
+	const CConstFloat16Handle&, int, const CFloatHandle& )
+{
+	ASSERT_EXPR( false );
+}
+
+void CCudaMathEngine::MultiplyMatrixByTransposedMatrix( const CConstFloatHandle&, int, int,
+	const CConstBFloat16Handle&, int, const CFloatHandle& )
+{
+	ASSERT_EXPR( false );
+}
+
 void CCudaMathEngine::MultiplyTransposedMatrixByMatrixAndAdd( const CConstFloatHandle& firstHandle, int firstHeight,
 	int firstWidth, int firstRowSize, const CConstFloatHandle& secondHandle, int secondWidth, int secondRowSize,
 	const CFloatHandle& resultHandle, int resultRowSize, int )
@@ -0,0 +1,106 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#include <NeoMathEngine/NeoMathEngineDefs.h>
+
+#ifdef NEOML_USE_CUDA
+
+#include <CudaMathEngine.h>
+#include <CudaMathEngineDnnConvs.h>
+#include "Rowwise/CudaRowwiseActivation.h"
+
+namespace NeoML {
+
+// Applies the activation and adds the residual to the result
+// There is no fused kernel for it on GPU: the whole result is processed after the operation
+static void cudaEpilogue( IMathEngine& mathEngine, const CActivationDesc& activation,
+	const CConstFloatHandle* residual, const CFloatHandle& data, int dataSize )
+{
+	if( activation.GetType() == AF_GELU ) {
+		// GELU is not supported by the rowwise activation
+		mathEngine.VectorGELU( data, data, dataSize, activation.GetParam<CGELUActivationParam>().Mode );
+	} else {
+		CBlobDesc dataDesc( CT_Float );
+		dataDesc.SetDimSize( BD_Channels, dataSize );
+		CCudaRowwiseActivation impl( activation );
+		impl.Reshape( dataDesc );
+		impl.Process( data, data );
+	}
+
+	if( residual != nullptr ) {
+		mathEngine.VectorAdd( data, *residual, data, dataSize );
+	}
+}
+
+void CCudaMathEngine::BlobConvolutionWithEpilogue( const CConvolutionDesc& convDesc, const CConstFloatHandle& source,
+	const CConstFloatHandle& filter, const CConstFloatHandle* freeTerm, const CActivationDesc& activation,
+	const CConstFloatHandle* residual, const CFloatHandle& result )
+{
+	BlobConvolution( convDesc, source, filter, freeTerm, result );
+	const CCudaConvolutionDescInternal& desc = static_cast<const CCudaConvolutionDesc&>( convDesc ).Internal;
+	cudaEpilogue( *this, activation, residual, result, desc.Result.BlobSize() );
+}
+
+void CCudaMathEngine::MultiplyMatrixByTransposedMatrixWithEpilogue( const CConstFloatHandle& first, int firstHeight,
+	int firstWidth, const CConstFloatHandle& second, int secondHeight, const CConstFloatHandle* freeTerm,
+	const CActivationDesc& activation, const CConstFloatHandle* residual, const CFloatHandle& result )
+{
+	MultiplyMatrixByTransposedMatrix( first, firstHeight, firstWidth, firstWidth,
+		second, secondHeight, firstWidth, result, secondHeight, firstHeight * secondHeight );
+	if( freeTerm != nullptr ) {
+		AddVectorToMatrixRows( 1, result, result, firstHeight, secondHeight, *freeTerm );
+	}
+	cudaEpilogue( *this, activation, residual, result, firstHeight * secondHeight );
+}
+
+// There are no sparse kernels on GPU: the weights are kept dense and the dense operations are used
+struct CCudaSparseWeightsDesc : public CSparseWeightsDesc {
+	CCudaSparseWeightsDesc( IMathEngine& mathEngine, int height, int width ) :
+		Height( height ), Width( width ), Weights( mathEngine, height * width ) {}
+
+	const int Height;
+	const int Width;
+	CFloatHandleVar Weights;
+};
+
+CSparseWeightsDesc* CCudaMathEngine::InitSparseWeights( int height, int width, const CConstFloatHandle& weights )
+{
+	ASSERT_EXPR( height > 0 && width > 0 );
+	ASSERT_EXPR( weights.GetMathEngine() == this );
+	CCudaSparseWeightsDesc* desc = new CCudaSparseWeightsDesc( *this, height, width );
+	VectorCopy( desc->Weights.GetHandle(), weights, height * width );
+	return desc;
+}
+
+void CCudaMathEngine::MultiplyMatrixBySparseWeightsWithEpilogue( const CConstFloatHandle& first, int firstHeight,
+	const CSparseWeightsDesc& weights, const CConstFloatHandle* freeTerm, const CActivationDesc& activation,
+	const CConstFloatHandle* residual, const CFloatHandle& result )
+{
+	const CCudaSparseWeightsDesc& desc = static_cast<const CCudaSparseWeightsDesc&>( weights );
+	MultiplyMatrixByTransposedMatrixWithEpilogue( first, firstHeight, desc.Width, desc.Weights.GetHandle(),
+		desc.Height, freeTerm, activation, residual, result );
+}
+
+void CCudaMathEngine::BlobConvolutionWithSparseFilter( const CConvolutionDesc& convDesc,
+	const CConstFloatHandle& source, const CSparseWeightsDesc& filter, const CConstFloatHandle* freeTerm,
+	const CActivationDesc& activation, const CConstFloatHandle* residual, const CFloatHandle& result )
+{
+	BlobConvolutionWithEpilogue( convDesc, source, static_cast<const CCudaSparseWeightsDesc&>( filter ).Weights.GetHandle(),
+		freeTerm, activation, residual, result );
+}
+
+} // namespace NeoML
+
+#endif // NEOML_USE_CUDA
@@ -91,6 +91,18 @@ void CCudaMathEngine::LrnBackward( const CLrnDesc& lrnDesc, const CConstFloatHan
 		inputDiffPtr, vectorCount, vectorSize, desc.WindowSize, desc.Alpha, desc.Beta ); 
 }
 
+void CCudaMathEngine::LayerNorm( const CConstFloatHandle&, const CConstFloatHandle*, int, int, float,
+	const CConstFloatHandle&, const CConstFloatHandle&, const CFloatHandle&, const CFloatHandle*, const CFloatHandle* )
+{
+	ASSERT_EXPR( false );
+}
+
+void CCudaMathEngine::LayerNormBackward( const CConstFloatHandle&, const CConstFloatHandle&, const CConstFloatHandle&,
+	int, int, const CConstFloatHandle&, const CFloatHandle& )
+{
+	ASSERT_EXPR( false );
+}
+
 } // namespace NeoML
 
 #endif // NEOML_USE_CUDA
@@ -26,9 +26,11 @@ limitations under the License.
 #include "Rowwise/CudaRowwiseInterface.h"
 
 #include "Rowwise/CudaRowwiseActivation.h"
+#include "Rowwise/CudaRowwiseBatchNorm.h"
 #include "Rowwise/CudaRowwiseChConv.h"
 #include "Rowwise/CudaRowwiseChConvWith1x1.h"
 #include "Rowwise/CudaRowwiseConv.h"
+#include "Rowwise/CudaRowwiseEltwiseSum.h"
 #include "Rowwise/CudaRowwiseMobileNetV2.h"
 #include "Rowwise/CudaRowwisePooling.h"
 #include "Rowwise/CudaRowwiseResizeImage.h"
@@ -40,6 +42,10 @@ CBlobDesc CCudaMathEngine::RowwiseReshape( CRowwiseOperationDesc** operations, i
 {
 	CBlobDesc output = input;
 	for( int i = 0; i < operationCount; ++i ) {
+		if( dynamic_cast<CCudaRowwiseEltwiseSum*>( *operations ) != nullptr ) {
+			// The chain input is added to the input of this operation
+			ASSERT_EXPR( output.HasEqualDimensions( input ) );
+		}
 		output = dynamic_cast<ICudaRowwiseImpl*>( *operations )->Reshape( output );
 		++operations;
 	}
@@ -47,7 +53,7 @@ CBlobDesc CCudaMathEngine::RowwiseReshape( CRowwiseOperationDesc** operations, i
 }
 
 void CCudaMathEngine::RowwiseExecute( const CBlobDesc&, CRowwiseOperationDesc** operationDescs,
-	int operationCount, const CFloatHandle& input, const CFloatHandle& output )
+	int operationCount, const CFloatHandle& input, const CFloatHandle& output, IThreadPool* /*threadPool*/ )
 {
 	std::vector<std::vector<ICudaRowwiseImpl*>> operations;
 	for( int i = 0; i < operationCount; ++i ) {
@@ -56,6 +62,10 @@ void CCudaMathEngine::RowwiseExecute( const CBlobDesc&, CRowwiseOperationDesc**
 			operations.emplace_back();
 		}
 		operations.back().push_back( operation );
+		CCudaRowwiseEltwiseSum* sum = dynamic_cast<CCudaRowwiseEltwiseSum*>( operation );
+		if( sum != nullptr ) {
+			sum->SetSavedBranch( input );
+		}
 	}
 
 	std::unique_ptr<CFloatHandleVar> inputBuff;
@@ -140,6 +150,17 @@ CRowwiseOperationDesc* CCudaMathEngine::InitRowwise2DPooling( bool isMax, int fi
 	return new CCudaRowwise2DPooling( *this, isMax, filterHeight, filterWidth, strideHeight, strideWidth );
 }
 
+CRowwiseOperationDesc* CCudaMathEngine::InitRowwiseBatchNormalization( int channels,
+	const CConstFloatHandle& multiplier, const CConstFloatHandle& freeTerm )
+{
+	return new CCudaRowwiseBatchNorm( channels, multiplier, freeTerm );
+}
+
+CRowwiseOperationDesc* CCudaMathEngine::InitRowwiseEltwiseSum()
+{
+	return new CCudaRowwiseEltwiseSum();
+}
+
 } // namespace NeoML
 
 #endif // NEOML_USE_CUDA
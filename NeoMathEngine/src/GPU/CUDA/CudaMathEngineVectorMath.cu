@@ -156,6 +156,36 @@ void CCudaMathEngine::VectorConvert(const CConstIntHandle& from, const CFloatHan
 	VectorConvertKernel<<<blockCount, threadCount>>>(GetRaw(from), GetRaw(to), vectorSize);
 }
 
+void CCudaMathEngine::VectorConvert( const CConstFloatHandle&, const CFloat16Handle&, int )
+{
+	ASSERT_EXPR( false );
+}
+
+void CCudaMathEngine::VectorConvert( const CConstFloat16Handle&, const CFloatHandle&, int )
+{
+	ASSERT_EXPR( false );
+}
+
+void CCudaMathEngine::VectorConvert( const CConstFloatHandle&, const CBFloat16Handle&, int )
+{
+	ASSERT_EXPR( false );
+}
+
+void CCudaMathEngine::VectorConvert( const CConstBFloat16Handle&, const CFloatHandle&, int )
+{
+	ASSERT_EXPR( false );
+}
+
+void CCudaMathEngine::VectorCopy( const CFloat16Handle&, const CConstFloat16Handle&, int )
+{
+	ASSERT_EXPR( false );
+}
+
+void CCudaMathEngine::VectorCopy( const CBFloat16Handle&, const CConstBFloat16Handle&, int )
+{
+	ASSERT_EXPR( false );
+}
+
 void CCudaMathEngine::VectorFillBernoulli( const CFloatHandle& result, float p, int vectorSize, float valueHandle, int seed )
 {
 	ASSERT_EXPR(result.GetMathEngine() == this);
@@ -514,6 +544,72 @@ void CCudaMathEngine::VectorHSwishDiff( const CConstFloatHandle& firstHandle, co
 		( GetRaw( firstHandle ), GetRaw( secondHandle ), GetRaw( resultHandle ), vectorSize );
 }
 
+void CCudaMathEngine::VectorGELU( const CConstFloatHandle& firstHandle, const CFloatHandle& resultHandle,
+	int vectorSize, CGELUActivationParam::TCalculationMode mode )
+{
+	ASSERT_EXPR( firstHandle.GetMathEngine() == this );
+	ASSERT_EXPR( resultHandle.GetMathEngine() == this );
+	ASSERT_EXPR( mode == CGELUActivationParam::TCalculationMode::CM_Precise
+		|| mode == CGELUActivationParam::TCalculationMode::CM_SigmoidApproximate
+		|| mode == CGELUActivationParam::TCalculationMode::CM_TanhApproximate );
+	SetCudaDevice( device->DeviceNumber );
+
+	int blockCount = 0;
+	int threadCount = 0;
+	getCudaTaskGrid( blockCount, threadCount, vectorSize );
+
+	VectorGeluKernel<<<blockCount, threadCount>>>( GetRaw( firstHandle ), GetRaw( resultHandle ), vectorSize, mode );
+}
+
+void CCudaMathEngine::VectorGELUDiff( const CConstFloatHandle& firstHandle, const CConstFloatHandle& secondHandle,
+	const CFloatHandle& resultHandle, int vectorSize, CGELUActivationParam::TCalculationMode mode )
+{
+	ASSERT_EXPR( firstHandle.GetMathEngine() == this );
+	ASSERT_EXPR( secondHandle.GetMathEngine() == this );
+	ASSERT_EXPR( resultHandle.GetMathEngine() == this );
+	ASSERT_EXPR( mode == CGELUActivationParam::TCalculationMode::CM_Precise
+		|| mode == CGELUActivationParam::TCalculationMode::CM_SigmoidApproximate
+		|| mode == CGELUActivationParam::TCalculationMode::CM_TanhApproximate );
+	SetCudaDevice( device->DeviceNumber );
+
+	int blockCount = 0;
+	int threadCount = 0;
+	getCudaTaskGrid( blockCount, threadCount, vectorSize );
+
+	VectorGeluDiffKernel<<<blockCount, threadCount>>>( GetRaw( firstHandle ), GetRaw( secondHandle ),
+		GetRaw( resultHandle ), vectorSize, mode );
+}
+
+void CCudaMathEngine::VectorSiLU( const CConstFloatHandle& firstHandle, const CFloatHandle& resultHandle,
+	int vectorSize )
+{
+	ASSERT_EXPR( firstHandle.GetMathEngine() == this );
+	ASSERT_EXPR( resultHandle.GetMathEngine() == this );
+	SetCudaDevice( device->DeviceNumber );
+
+	int blockCount = 0;
+	int threadCount = 0;
+	getCudaTaskGrid( blockCount, threadCount, vectorSize );
+
+	VectorSiluKernel<<<blockCount, threadCount>>>( GetRaw( firstHandle ), GetRaw( resultHandle ), vectorSize );
+}
+
+void CCudaMathEngine::VectorSiLUDiff( const CConstFloatHandle& firstHandle, const CConstFloatHandle& secondHandle,
+	const CFloatHandle& resultHandle, int vectorSize )
+{
+	ASSERT_EXPR( firstHandle.GetMathEngine() == this );
+	ASSERT_EXPR( secondHandle.GetMathEngine() == this );
+	ASSERT_EXPR( resultHandle.GetMathEngine() == this );
+	SetCudaDevice( device->DeviceNumber );
+
+	int blockCount = 0;
+	int threadCount = 0;
+	getCudaTaskGrid( blockCount, threadCount, vectorSize );
+
+	VectorSiluDiffKernel<<<blockCount, threadCount>>>( GetRaw( firstHandle ), GetRaw( secondHandle ),
+		GetRaw( resultHandle ), vectorSize );
+}
+
 void CCudaMathEngine::VectorEltwiseMax(const CConstFloatHandle& firstHandle, const CConstFloatHandle& secondHandle,
 	const CFloatHandle& resultHandle, int vectorSize)
 {
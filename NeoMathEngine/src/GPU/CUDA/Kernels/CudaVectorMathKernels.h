@@ -487,6 +487,86 @@ __global__ void VectorHSwishDiffKernel( const float* __restrict__ first, const f
 		result += step;
 	}
 }
+// The constants for GELU
+const float GeluSqrt2Inv = 0.707106781186547524f;
+const float GeluSqrt2PiInv = 0.398942280401432678f;
+const float GeluApproximationMultiplier = 1.702f;
+const float GeluSqrt2PiScale = 0.797884560802865356f; // sqrt(2/pi)
+const float GeluTanhCubicCoeff = 0.044715f;
+
+// x * 0.5( 1 + erf( x / sqrt(2) ) ), x * sigmoid(1.702x) or x * 0.5( 1 + tanh( sqrt(2/pi)( x + 0.044715x^3 ) ) )
+__global__ void VectorGeluKernel( const float* __restrict__ first, float* result, int count,
+	CGELUActivationParam::TCalculationMode mode )
+{
+	int index = 0;
+	if( GetCudaTaskIndex( count, index ) ) {
+		const float x = first[index];
+		switch( mode ) {
+			case CGELUActivationParam::TCalculationMode::CM_Precise:
+				result[index] = x * 0.5f * ( 1.f + erff( x * GeluSqrt2Inv ) );
+				break;
+			case CGELUActivationParam::TCalculationMode::CM_TanhApproximate:
+				result[index] = x * 0.5f * ( 1.f + tanhf( GeluSqrt2PiScale * x * ( 1.f + GeluTanhCubicCoeff * x * x ) ) );
+				break;
+			default:
+				result[index] = x / ( 1.f + ExponentFunc( -GeluApproximationMultiplier * x ) );
+		}
+	}
+}
+
+// second * GELU'(x)
+__global__ void VectorGeluDiffKernel( const float* __restrict__ first, const float* __restrict__ second,
+	float* result, int count, CGELUActivationParam::TCalculationMode mode )
+{
+	int index = 0;
+	if( GetCudaTaskIndex( count, index ) ) {
+		const float x = first[index];
+		float diff;
+		switch( mode ) {
+			case CGELUActivationParam::TCalculationMode::CM_Precise:
+				diff = 0.5f * ( 1.f + erff( x * GeluSqrt2Inv ) ) + x * GeluSqrt2PiInv * ExponentFunc( -0.5f * x * x );
+				break;
+			case CGELUActivationParam::TCalculationMode::CM_TanhApproximate:
+			{
+				// 1 - tanh(u)^2 = 4 * sigmoid(2u) * e^(-2u) * sigmoid(2u) has no cancellation near +-1
+				const float exp = ExponentFunc( -2.f * GeluSqrt2PiScale * x * ( 1.f + GeluTanhCubicCoeff * x * x ) );
+				const float sigmoid = 1.f / ( 1.f + exp );
+				const float innerDiff = GeluSqrt2PiScale * ( 1.f + 3.f * GeluTanhCubicCoeff * x * x );
+				diff = sigmoid + 0.5f * x * ( 4.f * sigmoid * sigmoid * exp * innerDiff );
+				break;
+			}
+			default:
+			{
+				const float sigmoid = 1.f / ( 1.f + ExponentFunc( -GeluApproximationMultiplier * x ) );
+				diff = sigmoid + GeluApproximationMultiplier * x * sigmoid * ( 1.f - sigmoid );
+			}
+		}
+		result[index] = second[index] * diff;
+	}
+}
+
+// x * sigmoid(x)
+__global__ void VectorSiluKernel( const float* __restrict__ first, float* result, int count )
+{
+	int index = 0;
+	if( GetCudaTaskIndex( count, index ) ) {
+		const float x = first[index];
+		result[index] = x / ( 1.f + ExponentFunc( -x ) );
+	}
+}
+
+// second * SiLU'(x)
+__global__ void VectorSiluDiffKernel( const float* __restrict__ first, const float* __restrict__ second,
+	float* result, int count )
+{
+	int index = 0;
+	if( GetCudaTaskIndex( count, index ) ) {
+		const float x = first[index];
+		const float sigmoid = 1.f / ( 1.f + ExponentFunc( -x ) );
+		result[index] = second[index] * ( sigmoid + x * sigmoid * ( 1.f - sigmoid ) );
+	}
+}
+
 const int VectorEltwiseMaxCombineCount = 8;
 __global__ void VectorEltwiseMaxKernel(const float* first, const float* second,
 	float* result, int count)
@@ -0,0 +1,58 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include "CudaRowwiseInterface.h"
+#include "../CudaMathEngine.h"
+
+namespace NeoML {
+
+class CCudaRowwiseBatchNorm : public ICudaRowwiseImpl, public CRowwiseOperationDesc {
+public:
+	CCudaRowwiseBatchNorm( int channels, const CConstFloatHandle& multiplier, const CConstFloatHandle& freeTerm ) :
+		channels( channels ), multiplier( multiplier ), freeTerm( freeTerm ), dataSize( 0 ) {}
+
+	// ICudaRowwiseImpl
+	CBlobDesc Reshape( const CBlobDesc& inputSize ) override;
+	int OutputSize() const override { return dataSize; }
+	bool IsInPlace() const override { return true; }
+	void Process( const CFloatHandle& input, const CFloatHandle& output ) const override;
+
+private:
+	const int channels;
+	const CConstFloatHandle multiplier;
+	const CConstFloatHandle freeTerm;
+	int dataSize;
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+
+inline CBlobDesc CCudaRowwiseBatchNorm::Reshape( const CBlobDesc& inputSize )
+{
+	ASSERT_EXPR( inputSize.Channels() == channels );
+	dataSize = inputSize.BlobSize();
+	return inputSize;
+}
+
+inline void CCudaRowwiseBatchNorm::Process( const CFloatHandle& input, const CFloatHandle& output ) const
+{
+	IMathEngine& mathEngine = *input.GetMathEngine();
+	const int pixelCount = dataSize / channels;
+	mathEngine.MultiplyMatrixByDiagMatrix( input, pixelCount, channels, multiplier, output, dataSize );
+	mathEngine.AddVectorToMatrixRows( 1, output, output, pixelCount, channels, freeTerm );
+}
+
+} // namespace NeoML
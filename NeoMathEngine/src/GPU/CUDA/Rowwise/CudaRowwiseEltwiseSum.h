@@ -0,0 +1,56 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include "CudaRowwiseInterface.h"
+#include "../CudaMathEngine.h"
+
+namespace NeoML {
+
+// Adds the input of the whole chain to the result of the previous operations
+class CCudaRowwiseEltwiseSum : public ICudaRowwiseImpl, public CRowwiseOperationDesc {
+public:
+	CCudaRowwiseEltwiseSum() : dataSize( 0 ) {}
+
+	// Sets the input of the chain (is called by RowwiseExecute before the calculation)
+	void SetSavedBranch( const CConstFloatHandle& data ) { savedBranch = data; }
+
+	// ICudaRowwiseImpl
+	CBlobDesc Reshape( const CBlobDesc& inputSize ) override;
+	int OutputSize() const override { return dataSize; }
+	bool IsInPlace() const override { return true; }
+	void Process( const CFloatHandle& input, const CFloatHandle& output ) const override;
+
+private:
+	CConstFloatHandle savedBranch;
+	int dataSize;
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+
+inline CBlobDesc CCudaRowwiseEltwiseSum::Reshape( const CBlobDesc& inputSize )
+{
+	dataSize = inputSize.BlobSize();
+	return inputSize;
+}
+
+inline void CCudaRowwiseEltwiseSum::Process( const CFloatHandle& input, const CFloatHandle& output ) const
+{
+	ASSERT_EXPR( !savedBranch.IsNull() );
+	input.GetMathEngine()->VectorAdd( input, savedBranch, output, dataSize );
+}
+
+} // namespace NeoML
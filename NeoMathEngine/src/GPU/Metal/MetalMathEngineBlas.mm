@@ -695,6 +695,18 @@ void CMetalMathEngine::MultiplyMatrixByTransposedMatrix( int batchSize, const CC
 	kernel.Run();
 }
 
+void CMetalMathEngine::MultiplyMatrixByTransposedMatrix( const CConstFloatHandle&, int, int,
+	const CConstFloat16Handle&, int, const CFloatHandle& )
+{
+	ASSERT_EXPR( false );
+}
+
+void CMetalMathEngine::MultiplyMatrixByTransposedMatrix( const CConstFloatHandle&, int, int,
+	const CConstBFloat16Handle&, int, const CFloatHandle& )
+{
+	ASSERT_EXPR( false );
+}
+
 // result = first * T(second). The result size is firstHeight * secondHeight:
 void CMetalMathEngine::MultiplySparseMatrixByTransposedMatrix( int firstHeight, int firstWidth, int secondHeight,
 	const CSparseMatrixDesc& firstDesc, const CConstFloatHandle& secondHandle, const CFloatHandle& resultHandle )
@@ -688,6 +688,39 @@ void CMetalMathEngine::ScatterND( const CConstIntHandle&, const CConstIntHandle&
 	ASSERT_EXPR( false );
 }
 
+void CMetalMathEngine::BlobConvolutionWithEpilogue( const CConvolutionDesc&, const CConstFloatHandle&,
+	const CConstFloatHandle&, const CConstFloatHandle*, const CActivationDesc&, const CConstFloatHandle*,
+	const CFloatHandle& )
+{
+	ASSERT_EXPR( false );
+}
+
+void CMetalMathEngine::MultiplyMatrixByTransposedMatrixWithEpilogue( const CConstFloatHandle&, int, int,
+	const CConstFloatHandle&, int, const CConstFloatHandle*, const CActivationDesc&, const CConstFloatHandle*,
+	const CFloatHandle& )
+{
+	ASSERT_EXPR( false );
+}
+
+CSparseWeightsDesc* CMetalMathEngine::InitSparseWeights( int, int, const CConstFloatHandle& )
+{
+	ASSERT_EXPR( false );
+	return nullptr;
+}
+
+void CMetalMathEngine::MultiplyMatrixBySparseWeightsWithEpilogue( const CConstFloatHandle&, int, const CSparseWeightsDesc&,
+	const CConstFloatHandle*, const CActivationDesc&, const CConstFloatHandle*, const CFloatHandle& )
+{
+	ASSERT_EXPR( false );
+}
+
+void CMetalMathEngine::BlobConvolutionWithSparseFilter( const CConvolutionDesc&, const CConstFloatHandle&,
+	const CSparseWeightsDesc&, const CConstFloatHandle*, const CActivationDesc&, const CConstFloatHandle*,
+	const CFloatHandle& )
+{
+	ASSERT_EXPR( false );
+}
+
 void CMetalMathEngine::ChannelwiseWith1x1( const CBlobDesc&, const CBlobDesc&,
 	const CRowwiseOperationDesc&, const CChannelwiseConvolutionDesc&,
 	const CConstFloatHandle&, const CFloatHandle& )
@@ -59,6 +59,18 @@ void CMetalMathEngine::LrnBackward( const CLrnDesc& /* desc */, const CConstFloa
 	ASSERT_EXPR( false );
 }
 
+void CMetalMathEngine::LayerNorm( const CConstFloatHandle&, const CConstFloatHandle*, int, int, float,
+	const CConstFloatHandle&, const CConstFloatHandle&, const CFloatHandle&, const CFloatHandle*, const CFloatHandle* )
+{
+	ASSERT_EXPR( false );
+}
+
+void CMetalMathEngine::LayerNormBackward( const CConstFloatHandle&, const CConstFloatHandle&, const CConstFloatHandle&,
+	int, int, const CConstFloatHandle&, const CFloatHandle& )
+{
+	ASSERT_EXPR( false );
+}
+
 } // namespace NeoML
 
 #endif // NEOML_USE_METAL
@@ -170,6 +170,18 @@ void CVulkanMathEngine::MultiplyMatrixByTransposedMatrix( int batchSize, const C
 	}
 }
 
+void CVulkanMathEngine::MultiplyMatrixByTransposedMatrix( const CConstFloatHandle&, int, int,
+	const CConstFloat16Handle&, int, const CFloatHandle& )
+{
+	ASSERT_EXPR( false );
+}
+
+void CVulkanMathEngine::MultiplyMatrixByTransposedMatrix( const CConstFloatHandle&, int, int,
+	const CConstBFloat16Handle&, int, const CFloatHandle& )
+{
+	ASSERT_EXPR( false );
+}
+
 void CVulkanMathEngine::MultiplySparseMatrixByTransposedMatrix( int firstHeight, int firstWidth, int secondHeight,
 	const CSparseMatrixDesc& firstDesc, const CConstFloatHandle& secondHandle, const CFloatHandle& resultHandle )
 {
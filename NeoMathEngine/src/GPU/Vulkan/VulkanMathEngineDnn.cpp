@@ -661,6 +661,39 @@ void CVulkanMathEngine::ScatterND( const CConstIntHandle&, const CConstIntHandle
 	ASSERT_EXPR( false );
 }
 
+void CVulkanMathEngine::BlobConvolutionWithEpilogue( const CConvolutionDesc&, const CConstFloatHandle&,
+	const CConstFloatHandle&, const CConstFloatHandle*, const CActivationDesc&, const CConstFloatHandle*,
+	const CFloatHandle& )
+{
+	ASSERT_EXPR( false );
+}
+
+void CVulkanMathEngine::MultiplyMatrixByTransposedMatrixWithEpilogue( const CConstFloatHandle&, int, int,
+	const CConstFloatHandle&, int, const CConstFloatHandle*, const CActivationDesc&, const CConstFloatHandle*,
+	const CFloatHandle& )
+{
+	ASSERT_EXPR( false );
+}
+
+CSparseWeightsDesc* CVulkanMathEngine::InitSparseWeights( int, int, const CConstFloatHandle& )
+{
+	ASSERT_EXPR( false );
+	return nullptr;
+}
+
+void CVulkanMathEngine::MultiplyMatrixBySparseWeightsWithEpilogue( const CConstFloatHandle&, int, const CSparseWeightsDesc&,
+	const CConstFloatHandle*, const CActivationDesc&, const CConstFloatHandle*, const CFloatHandle& )
+{
+	ASSERT_EXPR( false );
+}
+
+void CVulkanMathEngine::BlobConvolutionWithSparseFilter( const CConvolutionDesc&, const CConstFloatHandle&,
+	const CSparseWeightsDesc&, const CConstFloatHandle*, const CActivationDesc&, const CConstFloatHandle*,
+	const CFloatHandle& )
+{
+	ASSERT_EXPR( false );
+}
+
 void CVulkanMathEngine::ChannelwiseWith1x1( const CBlobDesc&, const CBlobDesc&,
 	const CRowwiseOperationDesc&, const CChannelwiseConvolutionDesc&,
 	const CConstFloatHandle&, const CFloatHandle& )
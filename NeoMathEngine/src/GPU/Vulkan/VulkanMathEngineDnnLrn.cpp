@@ -63,6 +63,18 @@ void CVulkanMathEngine::LrnBackward( const CLrnDesc& /* desc */, const CConstFlo
 	ASSERT_EXPR( false );
 }
 
+void CVulkanMathEngine::LayerNorm( const CConstFloatHandle&, const CConstFloatHandle*, int, int, float,
+	const CConstFloatHandle&, const CConstFloatHandle&, const CFloatHandle&, const CFloatHandle*, const CFloatHandle* )
+{
+	ASSERT_EXPR( false );
+}
+
+void CVulkanMathEngine::LayerNormBackward( const CConstFloatHandle&, const CConstFloatHandle&, const CConstFloatHandle&,
+	int, int, const CConstFloatHandle&, const CFloatHandle& )
+{
+	ASSERT_EXPR( false );
+}
+
 } // namespace NeoML
 
 #endif  // NEOML_USE_VULKAN
@@ -35,6 +35,32 @@ void CVulkanMathEngine::Lstm( CLstmDesc&, bool, int, int, const CConstFloatHandl
 	ASSERT_EXPR( false );
 }
 
+CGruDesc* CVulkanMathEngine::InitGru( int, int, const CConstFloatHandle&, const CConstFloatHandle&,
+	const CConstFloatHandle&, const CConstFloatHandle& )
+{
+	ASSERT_EXPR( false );
+	return nullptr;
+}
+
+void CVulkanMathEngine::Gru( CGruDesc&, bool, int, int, const CConstFloatHandle&, const CConstFloatHandle&,
+	const CFloatHandle&, const CFloatHandle& )
+{
+	ASSERT_EXPR( false );
+}
+
+void CVulkanMathEngine::GruBackward( CGruDesc&, bool, int, int, const CConstFloatHandle&, const CConstFloatHandle&,
+	const CConstFloatHandle&, const CConstFloatHandle&, const CConstFloatHandle&, const CFloatHandle&,
+	const CFloatHandle&, const CFloatHandle&, const CFloatHandle&, const CFloatHandle&, const CFloatHandle& )
+{
+	ASSERT_EXPR( false );
+}
+
+void CVulkanMathEngine::BidirectionalGru( CGruDesc&, CGruDesc&, int, int, const CConstFloatHandle&, const CFloatHandle&,
+	const CFloatHandle&, IThreadPool* )
+{
+	ASSERT_EXPR( false );
+}
+
 } // namespace NeoML
 
 #endif // NEOML_USE_VULKAN
@@ -159,6 +159,36 @@ void CVulkanMathEngine::VectorConvert( const CConstIntHandle& from, const CFloat
 		0, 0, 0, 0, 0, 0, bufs, sizes, 2, Ceil(vectorSize, VectorCombine) );
 }
 
+void CVulkanMathEngine::VectorConvert( const CConstFloatHandle&, const CFloat16Handle&, int )
+{
+	ASSERT_EXPR( false );
+}
+
+void CVulkanMathEngine::VectorConvert( const CConstFloat16Handle&, const CFloatHandle&, int )
+{
+	ASSERT_EXPR( false );
+}
+
+void CVulkanMathEngine::VectorConvert( const CConstFloatHandle&, const CBFloat16Handle&, int )
+{
+	ASSERT_EXPR( false );
+}
+
+void CVulkanMathEngine::VectorConvert( const CConstBFloat16Handle&, const CFloatHandle&, int )
+{
+	ASSERT_EXPR( false );
+}
+
+void CVulkanMathEngine::VectorCopy( const CFloat16Handle&, const CConstFloat16Handle&, int )
+{
+	ASSERT_EXPR( false );
+}
+
+void CVulkanMathEngine::VectorCopy( const CBFloat16Handle&, const CConstBFloat16Handle&, int )
+{
+	ASSERT_EXPR( false );
+}
+
 void CVulkanMathEngine::VectorFillBernoulli( const CFloatHandle& result, float p, int vectorSize, float value, int seed )
 {
 	CMemoryHandle bufs[1] = { result };
@@ -322,6 +352,158 @@ void CVulkanMathEngine::VectorHSwishDiff( const CConstFloatHandle& firstHandle,
 		0, 0, 0, 0, 0, 0, bufs, sizes, 3, Ceil( vectorSize, VectorCombine ) );
 }
 
+// The constants for GELU
+static constexpr float GeluSqrt2Inv = 0.707106781186547524f;
+static constexpr float GeluSqrt2PiInv = 0.398942280401432678f;
+static constexpr float GeluApproximationMultiplier = 1.702f;
+static constexpr float GeluSqrt2PiScale = 0.797884560802865356f; // sqrt(2/pi)
+static constexpr float GeluTanhCubicCoeff = 0.044715f;
+
+// The GELU is calculated by several vector operations (the precise mode requires VectorErf)
+void CVulkanMathEngine::VectorGELU( const CConstFloatHandle& firstHandle, const CFloatHandle& resultHandle,
+	int vectorSize, CGELUActivationParam::TCalculationMode mode )
+{
+	ASSERT_EXPR( firstHandle.GetMathEngine() == this );
+	ASSERT_EXPR( resultHandle.GetMathEngine() == this );
+
+	CFloatHandleStackVar buffer( *this, vectorSize );
+	CFloatHandleStackVar value( *this );
+	switch( mode ) {
+		case CGELUActivationParam::TCalculationMode::CM_Precise:
+			// buffer = 0.5( 1 + erf( x / sqrt(2) ) )
+			value.SetValue( GeluSqrt2Inv );
+			VectorMultiply( firstHandle, buffer, vectorSize, value );
+			VectorErf( buffer, buffer, vectorSize );
+			value.SetValue( 1.f );
+			VectorAddValue( buffer, buffer, vectorSize, value );
+			value.SetValue( 0.5f );
+			VectorMultiply( buffer, buffer, vectorSize, value );
+			break;
+		case CGELUActivationParam::TCalculationMode::CM_SigmoidApproximate:
+			// buffer = sigmoid(1.702x)
+			value.SetValue( GeluApproximationMultiplier );
+			VectorMultiply( firstHandle, buffer, vectorSize, value );
+			VectorSigmoid( buffer, buffer, vectorSize );
+			break;
+		case CGELUActivationParam::TCalculationMode::CM_TanhApproximate:
+			// buffer = sqrt(2/pi)( x + 0.044715x^3 )
+			VectorEltwiseMultiply( firstHandle, firstHandle, buffer, vectorSize );
+			value.SetValue( GeluSqrt2PiScale * GeluTanhCubicCoeff );
+			VectorMultiply( buffer, buffer, vectorSize, value );
+			value.SetValue( GeluSqrt2PiScale );
+			VectorAddValue( buffer, buffer, vectorSize, value );
+			VectorEltwiseMultiply( buffer, firstHandle, buffer, vectorSize );
+			// buffer = 0.5( 1 + tanh( buffer ) )
+			VectorTanh( buffer, buffer, vectorSize );
+			value.SetValue( 1.f );
+			VectorAddValue( buffer, buffer, vectorSize, value );
+			value.SetValue( 0.5f );
+			VectorMultiply( buffer, buffer, vectorSize, value );
+			break;
+		default:
+			ASSERT_EXPR( false );
+	}
+	VectorEltwiseMultiply( firstHandle, buffer, resultHandle, vectorSize );
+}
+
+void CVulkanMathEngine::VectorGELUDiff( const CConstFloatHandle& firstHandle, const CConstFloatHandle& secondHandle,
+	const CFloatHandle& resultHandle, int vectorSize, CGELUActivationParam::TCalculationMode mode )
+{
+	ASSERT_EXPR( firstHandle.GetMathEngine() == this );
+	ASSERT_EXPR( secondHandle.GetMathEngine() == this );
+	ASSERT_EXPR( resultHandle.GetMathEngine() == this );
+
+	CFloatHandleStackVar buffer( *this, 2 * vectorSize );
+	CFloatHandle function = buffer.GetHandle();
+	CFloatHandle derivative = buffer.GetHandle() + vectorSize;
+	CFloatHandleStackVar value( *this );
+	switch( mode ) {
+		case CGELUActivationParam::TCalculationMode::CM_Precise:
+			// derivative = x / sqrt(2pi) * e^( -x^2 / 2 )
+			value.SetValue( GeluSqrt2Inv );
+			VectorMultiply( firstHandle, function, vectorSize, value );
+			VectorEltwiseNegMultiply( function, function, derivative, vectorSize );
+			VectorExp( derivative, derivative, vectorSize );
+			value.SetValue( GeluSqrt2PiInv );
+			VectorMultiply( derivative, derivative, vectorSize, value );
+			VectorEltwiseMultiply( derivative, firstHandle, derivative, vectorSize );
+			// function = 0.5( 1 + erf( x / sqrt(2) ) )
+			VectorErf( function, function, vectorSize );
+			value.SetValue( 1.f );
+			VectorAddValue( function, function, vectorSize, value );
+			value.SetValue( 0.5f );
+			VectorMultiply( function, function, vectorSize, value );
+			break;
+		case CGELUActivationParam::TCalculationMode::CM_SigmoidApproximate:
+			// derivative = 1.702x * sigmoid'(1.702x)
+			value.SetValue( GeluApproximationMultiplier );
+			VectorMultiply( firstHandle, function, vectorSize, value );
+			VectorSigmoidDiff( function, firstHandle, derivative, vectorSize );
+			VectorMultiply( derivative, derivative, vectorSize, value );
+			// function = sigmoid(1.702x)
+			VectorSigmoid( function, function, vectorSize );
+			break;
+		case CGELUActivationParam::TCalculationMode::CM_TanhApproximate:
+			// derivative = 0.5x * u', where u = sqrt(2/pi)( x + 0.044715x^3 )
+			VectorEltwiseMultiply( firstHandle, firstHandle, function, vectorSize );
+			value.SetValue( 3.f * GeluSqrt2PiScale * GeluTanhCubicCoeff );
+			VectorMultiply( function, derivative, vectorSize, value );
+			value.SetValue( GeluSqrt2PiScale );
+			VectorAddValue( derivative, derivative, vectorSize, value );
+			VectorEltwiseMultiply( derivative, firstHandle, derivative, vectorSize );
+			value.SetValue( 0.5f );
+			VectorMultiply( derivative, derivative, vectorSize, value );
+			// function = u
+			value.SetValue( GeluSqrt2PiScale * GeluTanhCubicCoeff );
+			VectorMultiply( function, function, vectorSize, value );
+			value.SetValue( GeluSqrt2PiScale );
+			VectorAddValue( function, function, vectorSize, value );
+			VectorEltwiseMultiply( function, firstHandle, function, vectorSize );
+			// derivative = 0.5x * u' * tanh'(u)
+			VectorTanhDiff( function, derivative, derivative, vectorSize );
+			// function = 0.5( 1 + tanh(u) )
+			VectorTanh( function, function, vectorSize );
+			value.SetValue( 1.f );
+			VectorAddValue( function, function, vectorSize, value );
+			value.SetValue( 0.5f );
+			VectorMultiply( function, function, vectorSize, value );
+			break;
+		default:
+			ASSERT_EXPR( false );
+	}
+	VectorAdd( function, derivative, function, vectorSize );
+	VectorEltwiseMultiply( function, secondHandle, resultHandle, vectorSize );
+}
+
+// The SiLU is calculated by several vector operations
+void CVulkanMathEngine::VectorSiLU( const CConstFloatHandle& firstHandle, const CFloatHandle& resultHandle,
+	int vectorSize )
+{
+	ASSERT_EXPR( firstHandle.GetMathEngine() == this );
+	ASSERT_EXPR( resultHandle.GetMathEngine() == this );
+
+	CFloatHandleStackVar buffer( *this, vectorSize );
+	VectorSigmoid( firstHandle, buffer, vectorSize );
+	VectorEltwiseMultiply( firstHandle, buffer, resultHandle, vectorSize );
+}
+
+void CVulkanMathEngine::VectorSiLUDiff( const CConstFloatHandle& firstHandle, const CConstFloatHandle& secondHandle,
+	const CFloatHandle& resultHandle, int vectorSize )
+{
+	ASSERT_EXPR( firstHandle.GetMathEngine() == this );
+	ASSERT_EXPR( secondHandle.GetMathEngine() == this );
+	ASSERT_EXPR( resultHandle.GetMathEngine() == this );
+
+	CFloatHandleStackVar buffer( *this, 2 * vectorSize );
+	CFloatHandle function = buffer.GetHandle();
+	CFloatHandle derivative = buffer.GetHandle() + vectorSize;
+	// sigmoid(x) + x * sigmoid'(x)
+	VectorSigmoidDiff( firstHandle, firstHandle, derivative, vectorSize );
+	VectorSigmoid( firstHandle, function, vectorSize );
+	VectorAdd( function, derivative, function, vectorSize );
+	VectorEltwiseMultiply( function, secondHandle, resultHandle, vectorSize );
+}
+
 void CVulkanMathEngine::VectorEltwiseMax(const CConstFloatHandle& firstHandle,
 	const CConstFloatHandle& secondHandle, const CFloatHandle& resultHandle, int vectorSize)
 {
@@ -69,7 +69,9 @@ CGlobalMaxOverTimePoolingDesc::~CGlobalMaxOverTimePoolingDesc() = default;
 CMaxOverTimePoolingDesc::~CMaxOverTimePoolingDesc() = default;
 CLrnDesc::~CLrnDesc() = default;
 CLstmDesc::~CLstmDesc() = default;
+CGruDesc::~CGruDesc() = default;
 CRowwiseOperationDesc::~CRowwiseOperationDesc() = default;
+CSparseWeightsDesc::~CSparseWeightsDesc() = default;
 
 //------------------------------------------------------------------------------------------------------------
 
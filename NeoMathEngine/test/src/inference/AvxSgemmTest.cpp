@@ -0,0 +1,163 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#include <TestFixture.h>
+#include <MeTestCommon.h>
+#include <NeoMathEngine/SimdMathEngine.h>
+
+#include <memory>
+
+#if defined( _WIN32 )
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <intrin.h>
+#else
+#include <dlfcn.h>
+#endif
+
+using namespace NeoML;
+using namespace NeoMLTest;
+
+// Checks that the CPU has AVX-512 and the OS keeps the zmm registers
+static bool isAvx512Available()
+{
+#if defined( _MSC_VER ) && ( defined( _M_X64 ) || defined( _M_IX86 ) )
+	int regs[4];
+	__cpuidex( regs, 7, 0 );
+	if( ( regs[1] & ( 1 << 16 ) ) == 0 ) {
+		return false;
+	}
+	__cpuid( regs, 1 );
+	if( ( regs[2] & ( 1 << 27 ) ) == 0 ) {
+		return false;
+	}
+	return ( _xgetbv( 0 ) & 0xe6 ) == 0xe6;
+#elif defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+	return __builtin_cpu_supports( "avx512f" ) != 0;
+#else
+	return false;
+#endif
+}
+
+using CCreateSimdMathEngineFunc = ISimdMathEngine*( * )( IMathEngine* );
+
+// Finds the entry point of the AVX library loaded by the CPU math engine
+static CCreateSimdMathEngineFunc getCreateSimdMathEngine()
+{
+#if defined( _WIN32 )
+	HMODULE handle = ::GetModuleHandleA( "NeoMathEngineAvx.dll" );
+	if( handle == nullptr ) {
+		return nullptr;
+	}
+	return reinterpret_cast<CCreateSimdMathEngineFunc>(
+		reinterpret_cast<uintptr_t>( ::GetProcAddress( handle, "CreateSimdMathEngine" ) ) );
+#else
+#if defined( __APPLE__ )
+	void* handle = ::dlopen( "libNeoMathEngineAvx.dylib", RTLD_LAZY | RTLD_NOLOAD );
+#else
+	void* handle = ::dlopen( "libNeoMathEngineAvx.so", RTLD_LAZY | RTLD_NOLOAD );
+#endif
+	if( handle == nullptr ) {
+		return nullptr;
+	}
+	// The library stays loaded by the math engine, so the handle may be released at once
+	void* function = ::dlsym( handle, "CreateSimdMathEngine" );
+	::dlclose( handle );
+	return reinterpret_cast<CCreateSimdMathEngineFunc>( reinterpret_cast<uintptr_t>( function ) );
+#endif
+}
+
+// result += op( first ) * op( second ), the row sizes are greater than the widths
+static void avxSgemmTestImpl( SgemmFunc sgemm, bool transFirst, bool transSecond, int m, int n, int k, int seed )
+{
+	CRandom random( seed );
+	const int rowPadding = 3;
+	const int firstRowSize = ( transFirst ? m : k ) + rowPadding;
+	const int secondRowSize = ( transSecond ? k : n ) + rowPadding;
+	const int resultRowSize = n + rowPadding;
+
+	CREATE_FILL_FLOAT_ARRAY( first, -1.f, 1.f, ( transFirst ? k : m ) * firstRowSize, random )
+	CREATE_FILL_FLOAT_ARRAY( second, -1.f, 1.f, ( transSecond ? n : k ) * secondRowSize, random )
+	CREATE_FILL_FLOAT_ARRAY( result, -1.f, 1.f, m * resultRowSize, random )
+
+	std::vector<float> expected = result;
+	for( int i = 0; i < m; ++i ) {
+		for( int j = 0; j < n; ++j ) {
+			double sum = 0;
+			for( int l = 0; l < k; ++l ) {
+				const float a = transFirst ? first[l * firstRowSize + i] : first[i * firstRowSize + l];
+				const float b = transSecond ? second[j * secondRowSize + l] : second[l * secondRowSize + j];
+				sum += static_cast<double>( a ) * b;
+			}
+			expected[i * resultRowSize + j] += static_cast<float>( sum );
+		}
+	}
+
+	sgemm( transFirst, transSecond, &MathEngine(), first.data(), firstRowSize, second.data(), secondRowSize,
+		result.data(), resultRowSize, m, n, k );
+
+	for( int i = 0; i < m; ++i ) {
+		for( int j = 0; j < resultRowSize; ++j ) {
+			// The padding of the result rows must stay intact
+			ASSERT_NEAR( expected[i * resultRowSize + j], result[i * resultRowSize + j], 1e-3 )
+				<< "trans " << transFirst << transSecond << ", m " << m << ", n " << n << ", k " << k
+				<< ", row " << i << ", column " << j;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------
+
+class CMathEngineAvxSgemmTest : public CTestFixture {
+};
+
+// The sgemm of the AVX library uses the AVX-512 6x32 kernel when n >= 32
+// The widths cover every combination of the kernels for the tail
+TEST_F( CMathEngineAvxSgemmTest, Avx512 )
+{
+	const auto met = MathEngine().GetType();
+	if( met != MET_Cpu ) {
+		NEOML_HILIGHT( GTEST_LOG_( INFO ) ) << "Skipped rest of test for MathEngine type=" << met << " because no implementation.\n";
+		return;
+	}
+	if( !isAvx512Available() ) {
+		NEOML_HILIGHT( GTEST_LOG_( INFO ) ) << "Skipped rest of test because AVX-512 isn't available.\n";
+		return;
+	}
+	const CCreateSimdMathEngineFunc createSimdMathEngine = getCreateSimdMathEngine();
+	if( createSimdMathEngine == nullptr ) {
+		NEOML_HILIGHT( GTEST_LOG_( INFO ) ) << "Skipped rest of test because the AVX library isn't loaded.\n";
+		return;
+	}
+	std::unique_ptr<ISimdMathEngine> simdMathEngine( createSimdMathEngine( &MathEngine() ) );
+	ASSERT_TRUE( simdMathEngine != nullptr );
+	const SgemmFunc sgemm = simdMathEngine->GetSgemmFunction();
+	ASSERT_TRUE( sgemm != nullptr );
+
+	int seed = 0x51a7;
+	for( bool transFirst : { false, true } ) {
+		for( bool transSecond : { false, true } ) {
+			for( int n : { 32, 35, 38, 45, 50, 61, 64, 96 } ) {
+				for( int m : { 1, 6, 13 } ) {
+					avxSgemmTestImpl( sgemm, transFirst, transSecond, m, n, /*k*/37, seed++ );
+				}
+			}
+			// The sizes larger than the blocks of the interleaving
+			avxSgemmTestImpl( sgemm, transFirst, transSecond, 301, 263, 517, seed++ );
+		}
+	}
+}
@@ -43,6 +43,7 @@ static void blobConvolutionJitTestImpl( const CTestParams& params, int seed )
     const int paddingHeight = convParams[8];
     const int inputWidth = convParams[9];
     const int inputHeight = convParams[10];
+    // FT = 1 means the zero free term, FT = 0 means the random one
     const bool isZeroFreeTerm = convParams[11] == 0 ? false : true;
     
     const int inputLength = 1;
@@ -170,6 +171,10 @@ CTestParams JitTestParams[] = {
     CTestParams( "MainParams = {  32,  3,  3,  1,  1,  1,  1,  1,  1,   4,   3, 1 }; ChCount = (1..17); TestCount = 1;" ),
     CTestParams( "MainParams = {  32,  3,  3,  1,  1,  1,  1,  1,  1,   3,   3, 1 }; ChCount = (1..15); TestCount = 1;" ),
     CTestParams( "MainParams = {  32,  9,  9,  1,  1,  1,  1,  4,  1,  97,  37, 1 }; ChCount = (1..17); TestCount = 1;" ),
+    // AVX-512 kernels (FC = 16 and FC = 32): stride/dilation and non-zero free term (FT = 0)
+    //                            FC  FW  FH  DW  DH  SW  SH  PW  PH SrcW SrcH FT
+    CTestParams( "MainParams = {  16,  3,  3,  2,  1,  2,  1,  1,  1,  29,   7, 0 }; ChCount = (1..9); TestCount = 1;" ),
+    CTestParams( "MainParams = {  32,  3,  3,  2,  1,  2,  1,  1,  1,  29,   7, 0 }; ChCount = (1..9); TestCount = 1;" ),
     // Huge JIT
     CTestParams( "MainParams = {  24, 13, 19,  2,  4,  5,  3,  1,  1, 311, 313, 1 }; ChCount = (25..25); TestCount = 1;" ),
     // Test fillPixelOffset() function
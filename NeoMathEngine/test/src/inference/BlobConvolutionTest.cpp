@@ -19,7 +19,8 @@ limitations under the License.
 using namespace NeoML;
 using namespace NeoMLTest;
 
-static void blobConvolutionTestImpl( const CTestParams& params, int seed )
+// If isSparseFilter most of the filter elements are zeros and the sparse filter is used
+static void blobConvolutionTestImpl( const CTestParams& params, int seed, bool isSparseFilter = false )
 {
 	CRandom random( seed );
 
@@ -67,6 +68,13 @@ static void blobConvolutionTestImpl( const CTestParams& params, int seed )
 
 	CREATE_FILL_FLOAT_ARRAY( filterData, valuesInterval.Begin, valuesInterval.End,
 		filterCount * filterHeight * filterWidth * inputDepth * inputChannels, random )
+	if( isSparseFilter ) {
+		for( float& value : filterData ) {
+			if( random.Uniform( 0, 1 ) < 0.8 ) {
+				value = 0.f;
+			}
+		}
+	}
 	CFloatBlob filterBlob( MathEngine(), filterCount, filterHeight, filterWidth, inputDepth, inputChannels );
 	filterBlob.CopyFrom( filterData.data() );
 
@@ -86,8 +94,16 @@ static void blobConvolutionTestImpl( const CTestParams& params, int seed )
 
 	CConstFloatHandle freeTermDataPtr = freeTermBlob.GetData();
 
-	MathEngine().BlobConvolution( *convDesc, inputBlob.GetData(), filterBlob.GetData(),
-		isZeroFreeTerm ? 0 : &freeTermDataPtr, outputBlob.GetData() );
+	if( isSparseFilter ) {
+		std::unique_ptr<CSparseWeightsDesc> sparseFilter( MathEngine().InitSparseWeights( filterCount,
+			filterBlob.GetDesc().ObjectSize(), filterBlob.GetData() ) );
+		MathEngine().BlobConvolutionWithSparseFilter( *convDesc, inputBlob.GetData(), *sparseFilter,
+			isZeroFreeTerm ? 0 : &freeTermDataPtr, CActivationDesc( AF_Linear, CLinearActivationParam() ),
+			nullptr, outputBlob.GetData() );
+	} else {
+		MathEngine().BlobConvolution( *convDesc, inputBlob.GetData(), filterBlob.GetData(),
+			isZeroFreeTerm ? 0 : &freeTermDataPtr, outputBlob.GetData() );
+	}
 	delete convDesc;
 
 	const int outputSize = inputLength * inputBatch * outputHeight * outputWidth * 1 * filterCount;
@@ -105,6 +121,11 @@ static void blobConvolutionTestImpl( const CTestParams& params, int seed )
 	}
 }
 
+static void blobSparseFilterConvolutionTestImpl( const CTestParams& params, int seed )
+{
+	blobConvolutionTestImpl( params, seed, /*isSparseFilter*/true );
+}
+
 //------------------------------------------------------------------------------------------------------------
 
 class CMathEngineBlobConvolutionTest : public CTestFixtureWithParams {
@@ -631,6 +652,46 @@ INSTANTIATE_TEST_CASE_P( CMathEngineBlobConvolutionTestInstantiation, CMathEngin
 			"IsZeroFreeTerm = 0;"
 			"Values = (-10..10);"
 			"TestCount = 1;"
+		),
+		CTestParams(
+			"InputLength = (1..2);"
+			"InputBatch = (1..3);"
+			"InputHeight = (18..25);"
+			"InputWidth = (18..25);"
+			"InputDepth = 1;"
+			"InputChannels = (16..21);"
+			"FilterCount = (19..23);"
+			"FilterHeight = 3;"
+			"FilterWidth = 3;"
+			"PaddingHeight = (0..1);"
+			"PaddingWidth = (0..1);"
+			"DilationHeight = 1;"
+			"DilationWidth = 1;"
+			"StrideHeight = 1;"
+			"StrideWidth = 1;"
+			"IsZeroFreeTerm = (0..1);"
+			"Values = (-10..10);"
+			"TestCount = 10;"
+		),
+		CTestParams(
+			"InputLength = 1;"
+			"InputBatch = 2;"
+			"InputHeight = 34;"
+			"InputWidth = 30;"
+			"InputDepth = 1;"
+			"InputChannels = 40;"
+			"FilterCount = 48;"
+			"FilterHeight = 3;"
+			"FilterWidth = 3;"
+			"PaddingHeight = 1;"
+			"PaddingWidth = 1;"
+			"DilationHeight = 1;"
+			"DilationWidth = 1;"
+			"StrideHeight = 1;"
+			"StrideWidth = 1;"
+			"IsZeroFreeTerm = 0;"
+			"Values = (-10..10);"
+			"TestCount = 1;"
 		)
 	)
 );
@@ -639,3 +700,39 @@ TEST_P( CMathEngineBlobConvolutionTest, Random )
 {
 	RUN_TEST_IMPL( blobConvolutionTestImpl );
 }
+
+TEST_P( CMathEngineBlobConvolutionTest, SparseFilter )
+{
+	const auto met = MathEngine().GetType();
+	if( met != MET_Cpu && met != MET_Cuda ) {
+		NEOML_HILIGHT( GTEST_LOG_( INFO ) ) << "Skipped rest of test for MathEngine type=" << met << " because no implementation.\n";
+		return;
+	}
+
+	RUN_TEST_IMPL( blobSparseFilterConvolutionTestImpl );
+}
+
+TEST_P( CMathEngineBlobConvolutionTest, AutoTuning )
+{
+	const auto met = MathEngine().GetType();
+	if( met != MET_Cpu ) {
+		NEOML_HILIGHT( GTEST_LOG_( INFO ) ) << "Skipped rest of test for MathEngine type=" << met << " because no implementation.\n";
+		return;
+	}
+
+	// Every available algorithm is measured and the fastest one must give the same result
+	const bool wasAutoTuningMode = MathEngine().GetAutoTuningMode();
+	MathEngine().SetAutoTuningMode( true );
+	RUN_TEST_IMPL( blobConvolutionTestImpl );
+	MathEngine().SetAutoTuningMode( wasAutoTuningMode );
+
+	const size_t size = MathEngine().SaveAutoTuningCache( nullptr, 0 );
+	ASSERT_LT( 2 * sizeof( int ), size );
+	std::vector<char> buffer( size );
+	ASSERT_EQ( size, MathEngine().SaveAutoTuningCache( buffer.data(), buffer.size() ) );
+	MathEngine().LoadAutoTuningCache( buffer.data(), buffer.size() );
+	ASSERT_EQ( size, MathEngine().SaveAutoTuningCache( nullptr, 0 ) );
+
+	// The algorithms are taken from the cache now
+	RUN_TEST_IMPL( blobConvolutionTestImpl );
+}
@@ -0,0 +1,140 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#include <TestFixture.h>
+
+using namespace NeoML;
+using namespace NeoMLTest;
+
+static void naiveLayerNorm( const float* input, const float* residual, int height, int width, float epsilon,
+	const float* scale, const float* bias, float* result, float* invStdDev )
+{
+	for( int row = 0; row < height; ++row ) {
+		double mean = 0;
+		for( int i = 0; i < width; ++i ) {
+			mean += input[i] + ( residual == nullptr ? 0.f : residual[i] );
+		}
+		mean /= width;
+		double var = 0;
+		for( int i = 0; i < width; ++i ) {
+			const double diff = input[i] + ( residual == nullptr ? 0.f : residual[i] ) - mean;
+			var += diff * diff;
+		}
+		var /= width;
+		invStdDev[row] = static_cast<float>( 1. / sqrt( var + epsilon ) );
+		for( int i = 0; i < width; ++i ) {
+			const double norm = ( input[i] + ( residual == nullptr ? 0.f : residual[i] ) - mean ) * invStdDev[row];
+			*result++ = static_cast<float>( norm * scale[i] + bias[i] );
+		}
+		input += width;
+		if( residual != nullptr ) {
+			residual += width;
+		}
+	}
+}
+
+static void layerNormTestImpl( const CTestParams& params, int seed )
+{
+	CRandom random( seed );
+
+	const CInterval heightInterval = params.GetInterval( "Height" );
+	const CInterval widthInterval = params.GetInterval( "Width" );
+	const CInterval valuesInterval = params.GetInterval( "Values" );
+
+	const int height = random.UniformInt( heightInterval.Begin, heightInterval.End );
+	const int width = random.UniformInt( widthInterval.Begin, widthInterval.End );
+	const bool hasResidual = random.Next() % 2 == 1;
+	// The large shift checks the stability of the single pass variance
+	const float shift = static_cast<float>( random.Uniform( -100, 100 ) );
+	const float epsilon = 1e-5f;
+
+	CREATE_FILL_FLOAT_ARRAY( input, valuesInterval.Begin, valuesInterval.End, height * width, random );
+	CREATE_FILL_FLOAT_ARRAY( residual, valuesInterval.Begin, valuesInterval.End, height * width, random );
+	CREATE_FILL_FLOAT_ARRAY( scale, -2.f, 2.f, width, random );
+	CREATE_FILL_FLOAT_ARRAY( bias, -2.f, 2.f, width, random );
+	for( float& value : input ) {
+		value += shift;
+	}
+
+	std::vector<float> expected( height * width );
+	std::vector<float> expectedInvStdDev( height );
+	naiveLayerNorm( input.data(), hasResidual ? residual.data() : nullptr, height, width, epsilon,
+		scale.data(), bias.data(), expected.data(), expectedInvStdDev.data() );
+
+	CFloatBlob inputBlob( MathEngine(), 1, height, 1, 1, 1, 1, width );
+	inputBlob.CopyFrom( input.data() );
+	CFloatBlob residualBlob( MathEngine(), 1, height, 1, 1, 1, 1, width );
+	residualBlob.CopyFrom( residual.data() );
+	CFloatBlob resultBlob( MathEngine(), 1, height, 1, 1, 1, 1, width );
+	CFloatBlob normalizedBlob( MathEngine(), 1, height, 1, 1, 1, 1, width );
+	CFloatBlob invStdDevBlob( MathEngine(), 1, height, 1, 1, 1, 1, 1 );
+	const CConstFloatHandle residualHandle = residualBlob.GetData();
+	const CFloatHandle normalizedHandle = normalizedBlob.GetData();
+	const CFloatHandle invStdDevHandle = invStdDevBlob.GetData();
+
+	MathEngine().LayerNorm( inputBlob.GetData(), hasResidual ? &residualHandle : nullptr, height, width, epsilon,
+		CARRAY_FLOAT_WRAPPER( scale ), CARRAY_FLOAT_WRAPPER( bias ), resultBlob.GetData(),
+		&normalizedHandle, &invStdDevHandle );
+
+	std::vector<float> result( height * width );
+	resultBlob.CopyTo( result.data() );
+	for( int i = 0; i < height * width; ++i ) {
+		ASSERT_NEAR( expected[i], result[i], 1e-3f ) << " at " << i;
+	}
+	std::vector<float> invStdDev( height );
+	invStdDevBlob.CopyTo( invStdDev.data() );
+	for( int i = 0; i < height; ++i ) {
+		ASSERT_NEAR( expectedInvStdDev[i], invStdDev[i], 1e-3f * expectedInvStdDev[i] ) << " at " << i;
+	}
+
+	// The calculation in-place without the saved values
+	MathEngine().LayerNorm( inputBlob.GetData(), hasResidual ? &residualHandle : nullptr, height, width, epsilon,
+		CARRAY_FLOAT_WRAPPER( scale ), CARRAY_FLOAT_WRAPPER( bias ), inputBlob.GetData(), nullptr, nullptr );
+	inputBlob.CopyTo( result.data() );
+	for( int i = 0; i < height * width; ++i ) {
+		ASSERT_NEAR( expected[i], result[i], 1e-3f ) << " at " << i;
+	}
+}
+
+class CMathEngineLayerNormTest : public CTestFixtureWithParams {
+};
+
+INSTANTIATE_TEST_CASE_P( CMathEngineLayerNormTestInstantiation, CMathEngineLayerNormTest,
+	::testing::Values(
+		CTestParams(
+			"Height = (1..20);"
+			"Width = (1..300);"
+			"Values = (-10..10);"
+			"TestCount = 200;"
+		),
+		CTestParams(
+			"Height = (1..3);"
+			"Width = (1000..5000);"
+			"Values = (-1..1);"
+			"TestCount = 20;"
+		)
+	)
+);
+
+TEST_P( CMathEngineLayerNormTest, Random )
+{
+	const auto met = MathEngine().GetType();
+	if( met != MET_Cpu ) {
+		NEOML_HILIGHT( GTEST_LOG_( INFO ) ) << "Skipped rest of test for MathEngine type=" << met << " because no implementation.\n";
+		return;
+	}
+
+	RUN_TEST_IMPL( layerNormTestImpl );
+}
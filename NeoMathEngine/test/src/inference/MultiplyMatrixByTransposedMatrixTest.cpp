@@ -96,6 +96,83 @@ static void batchMultiplyMatrixByTransposedMatrixTestImpl( const CTestParams& pa
 	}
 }
 
+template<class T>
+static void multiplyMatrixByTransposedHalfMatrixTestImpl( const CTestParams& params, int seed )
+{
+	CRandom random( seed );
+
+	const CInterval heightInterval = params.GetInterval( "Height" );
+	const CInterval widthInterval = params.GetInterval( "Width" );
+	const CInterval valuesInterval = params.GetInterval( "Values" );
+
+	const int secondHeight = random.UniformInt( heightInterval.Begin, heightInterval.End );
+	const int firstHeight = random.UniformInt( heightInterval.Begin, heightInterval.End );
+	const int firstWidth = random.UniformInt( widthInterval.Begin, widthInterval.End );
+
+	CREATE_FILL_FLOAT_ARRAY( a, valuesInterval.Begin, valuesInterval.End, firstHeight * firstWidth, random )
+	CREATE_FILL_FLOAT_ARRAY( b, valuesInterval.Begin, valuesInterval.End, firstWidth * secondHeight, random )
+	std::vector<T> halfB;
+	for( float& value : b ) {
+		halfB.push_back( T::FromFloat( value ) );
+		value = halfB.back().ToFloat();
+	}
+
+	std::vector<float> exp;
+	exp.insert( exp.begin(), firstHeight * secondHeight, 0.f );
+	multiplyMatrixByTransposedMatrixAndAddNaive( 1, a, b, firstHeight, firstWidth, secondHeight, exp );
+
+	std::vector<float> result;
+	result.resize( firstHeight * secondHeight );
+	MathEngine().MultiplyMatrixByTransposedMatrix( CARRAY_FLOAT_WRAPPER( a ), firstHeight, firstWidth,
+		CARRAY_WRAPPER( T, halfB ), secondHeight, CARRAY_FLOAT_WRAPPER( result ) );
+
+	for( int i = 0; i < firstHeight * secondHeight; ++i ) {
+		ASSERT_NEAR( exp[i], result[i], 1e-3 );
+	}
+}
+
+static void multiplyMatrixBySparseWeightsTestImpl( const CTestParams& params, int seed )
+{
+	CRandom random( seed );
+
+	const CInterval heightInterval = params.GetInterval( "Height" );
+	const CInterval widthInterval = params.GetInterval( "Width" );
+	const CInterval valuesInterval = params.GetInterval( "Values" );
+
+	const int secondHeight = random.UniformInt( heightInterval.Begin, heightInterval.End );
+	const int firstHeight = random.UniformInt( heightInterval.Begin, heightInterval.End );
+	const int firstWidth = random.UniformInt( widthInterval.Begin, widthInterval.End );
+
+	CREATE_FILL_FLOAT_ARRAY( a, valuesInterval.Begin, valuesInterval.End, firstHeight * firstWidth, random )
+	CREATE_FILL_FLOAT_ARRAY( b, valuesInterval.Begin, valuesInterval.End, firstWidth * secondHeight, random )
+	CREATE_FILL_FLOAT_ARRAY( freeTerm, valuesInterval.Begin, valuesInterval.End, secondHeight, random )
+	// Most of the weights are pruned
+	for( float& value : b ) {
+		if( random.Uniform( 0, 1 ) < 0.8 ) {
+			value = 0.f;
+		}
+	}
+
+	std::vector<float> exp;
+	exp.insert( exp.begin(), firstHeight * secondHeight, 0.f );
+	multiplyMatrixByTransposedMatrixAndAddNaive( 1, a, b, firstHeight, firstWidth, secondHeight, exp );
+	for( int i = 0; i < firstHeight * secondHeight; ++i ) {
+		exp[i] = std::max( 0.f, exp[i] + freeTerm[i % secondHeight] );
+	}
+
+	std::vector<float> result;
+	result.resize( firstHeight * secondHeight );
+	std::unique_ptr<CSparseWeightsDesc> weights( MathEngine().InitSparseWeights( secondHeight, firstWidth,
+		CARRAY_FLOAT_WRAPPER( b ) ) );
+	CBufferWrapper<float> freeTermWrapper( MathEngine(), freeTerm.data(), secondHeight );
+	CConstFloatHandle freeTermHandle = freeTermWrapper;
+	MathEngine().MultiplyMatrixBySparseWeightsWithEpilogue( CARRAY_FLOAT_WRAPPER( a ), firstHeight, *weights,
+		&freeTermHandle, CActivationDesc( AF_ReLU, CReLUActivationParam() ), nullptr, CARRAY_FLOAT_WRAPPER( result ) );
+
+	for( int i = 0; i < firstHeight * secondHeight; ++i ) {
+		ASSERT_NEAR( exp[i], result[i], 1e-3 );
+	}
+}
 
 //---------------------------------------------------------------------------------------------------------------------
 
@@ -124,6 +201,39 @@ TEST_P( CMultiplyMatrixByTransposedMatrixTest, Random )
 	RUN_TEST_IMPL( multiplyMatrixByTransposedMatrixTestImpl )
 }
 
+TEST_P( CMultiplyMatrixByTransposedMatrixTest, Float16Random )
+{
+	const auto met = MathEngine().GetType();
+	if( met != MET_Cpu ) {
+		NEOML_HILIGHT( GTEST_LOG_( INFO ) ) << "Skipped rest of test for MathEngine type=" << met << " because no implementation.\n";
+		return;
+	}
+
+	RUN_TEST_IMPL( multiplyMatrixByTransposedHalfMatrixTestImpl<CFloat16> )
+}
+
+TEST_P( CMultiplyMatrixByTransposedMatrixTest, BFloat16Random )
+{
+	const auto met = MathEngine().GetType();
+	if( met != MET_Cpu ) {
+		NEOML_HILIGHT( GTEST_LOG_( INFO ) ) << "Skipped rest of test for MathEngine type=" << met << " because no implementation.\n";
+		return;
+	}
+
+	RUN_TEST_IMPL( multiplyMatrixByTransposedHalfMatrixTestImpl<CBFloat16> )
+}
+
+TEST_P( CMultiplyMatrixByTransposedMatrixTest, SparseWeightsRandom )
+{
+	const auto met = MathEngine().GetType();
+	if( met != MET_Cpu && met != MET_Cuda ) {
+		NEOML_HILIGHT( GTEST_LOG_( INFO ) ) << "Skipped rest of test for MathEngine type=" << met << " because no implementation.\n";
+		return;
+	}
+
+	RUN_TEST_IMPL( multiplyMatrixBySparseWeightsTestImpl )
+}
+
 class CBatchMultiplyMatrixByTransposedMatrixTest : public CTestFixtureWithParams {
 };
 
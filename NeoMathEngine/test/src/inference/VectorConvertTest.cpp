@@ -52,6 +52,62 @@ static void vectorConvertIntToFloatTestImpl( const CTestParams& params, int seed
 	}
 }
 
+// Checks the conversion to 16-bit floats and back against the scalar conversion
+template<class T>
+static void vectorConvertHalfTestImpl( const CTestParams& params, int seed )
+{
+	CRandom random( seed );
+
+	const CInterval vectorSizeInterval = params.GetInterval( "VectorSize" );
+	const int vectorSize = random.UniformInt( vectorSizeInterval.Begin, vectorSizeInterval.End );
+
+	CREATE_FILL_FLOAT_ARRAY( fromArr, -1000.f, 1000.f, vectorSize, random );
+	// The values which need the special handling
+	const float specialValues[] = { 0.f, -0.f, 1e-7f, -3e-6f, 6e-5f, 65504.f, 65520.f, -1e6f, 1e38f, 3.4e38f,
+		std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+		std::numeric_limits<float>::quiet_NaN() };
+	for( int i = 0; i < vectorSize && i < static_cast<int>( sizeof( specialValues ) / sizeof( float ) ); ++i ) {
+		fromArr[random.UniformInt( 0, vectorSize - 1 )] = specialValues[i];
+	}
+
+	std::vector<T> halfArr;
+	halfArr.resize( vectorSize );
+	std::vector<float> toArr;
+	toArr.resize( vectorSize );
+
+	MathEngine().VectorConvert( CARRAY_FLOAT_WRAPPER( fromArr ), CARRAY_WRAPPER( T, halfArr ), vectorSize );
+	MathEngine().VectorConvert( CARRAY_WRAPPER( T, halfArr ), CARRAY_FLOAT_WRAPPER( toArr ), vectorSize );
+	for( int i = 0; i < vectorSize; ++i ) {
+		const float expected = T::FromFloat( fromArr[i] ).ToFloat();
+		if( std::isnan( expected ) ) {
+			ASSERT_TRUE( std::isnan( toArr[i] ) ) << fromArr[i];
+		} else {
+			ASSERT_EQ( expected, toArr[i] ) << fromArr[i];
+		}
+	}
+}
+
+TEST( CMathEngineHalfTest, ScalarConversion )
+{
+	EXPECT_EQ( 0x3c00, CFloat16::FromFloat( 1.f ).Bits );
+	EXPECT_EQ( 0xc000, CFloat16::FromFloat( -2.f ).Bits );
+	EXPECT_EQ( 0x7bff, CFloat16::FromFloat( 65504.f ).Bits );
+	EXPECT_EQ( 0x7c00, CFloat16::FromFloat( 65520.f ).Bits );
+	EXPECT_EQ( 0x0001, CFloat16::FromFloat( 5.9604644775390625e-8f ).Bits );
+	// Rounds to the nearest even
+	EXPECT_EQ( 0x3c00, CFloat16::FromFloat( 1.f + 1.f / 2048 ).Bits );
+	EXPECT_EQ( 0x3c02, CFloat16::FromFloat( 1.f + 3.f / 2048 ).Bits );
+	EXPECT_EQ( 0.333251953125f, CFloat16{ 0x3555 }.ToFloat() );
+
+	EXPECT_EQ( 0x3f80, CBFloat16::FromFloat( 1.f ).Bits );
+	EXPECT_EQ( 0xc000, CBFloat16::FromFloat( -2.f ).Bits );
+	EXPECT_EQ( 0x3f80, CBFloat16::FromFloat( 1.f + 1.f / 256 ).Bits );
+	EXPECT_EQ( 0x3f82, CBFloat16::FromFloat( 1.f + 3.f / 256 ).Bits );
+	EXPECT_EQ( 0x7f80, CBFloat16::FromFloat( std::numeric_limits<float>::max() ).Bits );
+	EXPECT_TRUE( std::isnan( CBFloat16::FromFloat( std::numeric_limits<float>::quiet_NaN() ).ToFloat() ) );
+	EXPECT_EQ( 1.5f, CBFloat16{ 0x3fc0 }.ToFloat() );
+}
+
 //------------------------------------------------------------------------------------------------------------
 
 class CMathEngineVectorConvertTest : public CTestFixtureWithParams {
@@ -83,3 +139,25 @@ TEST_P( CMathEngineVectorConvertTest, IntToFloatRandom )
 {
 	RUN_TEST_IMPL( vectorConvertIntToFloatTestImpl );
 }
+
+TEST_P( CMathEngineVectorConvertTest, Float16Random )
+{
+	const auto met = MathEngine().GetType();
+	if( met != MET_Cpu ) {
+		NEOML_HILIGHT( GTEST_LOG_( INFO ) ) << "Skipped rest of test for MathEngine type=" << met << " because no implementation.\n";
+		return;
+	}
+
+	RUN_TEST_IMPL( vectorConvertHalfTestImpl<CFloat16> );
+}
+
+TEST_P( CMathEngineVectorConvertTest, BFloat16Random )
+{
+	const auto met = MathEngine().GetType();
+	if( met != MET_Cpu ) {
+		NEOML_HILIGHT( GTEST_LOG_( INFO ) ) << "Skipped rest of test for MathEngine type=" << met << " because no implementation.\n";
+		return;
+	}
+
+	RUN_TEST_IMPL( vectorConvertHalfTestImpl<CBFloat16> );
+}
@@ -0,0 +1,92 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#include <TestFixture.h>
+#include <cmath>
+
+using namespace NeoML;
+using namespace NeoMLTest;
+
+static double geluNaive( double x, CGELUActivationParam::TCalculationMode mode )
+{
+	if( mode == CGELUActivationParam::TCalculationMode::CM_Precise ) {
+		return x * 0.5 * ( 1 + std::erf( x / std::sqrt( 2. ) ) );
+	}
+	if( mode == CGELUActivationParam::TCalculationMode::CM_TanhApproximate ) {
+		const double pi = 3.14159265358979323846;
+		return x * 0.5 * ( 1 + std::tanh( std::sqrt( 2 / pi ) * ( x + 0.044715 * x * x * x ) ) );
+	}
+	return x / ( 1 + std::exp( -1.702 * x ) );
+}
+
+static void vectorGELUTestImpl( const CTestParams& params, int seed )
+{
+	CRandom random( seed );
+	const CInterval vectorSizeInterval = params.GetInterval( "VectorSize" );
+	const CInterval vectorValuesInterval = params.GetInterval( "VectorValues" );
+	const int vectorSize = random.UniformInt( vectorSizeInterval.Begin, vectorSizeInterval.End );
+
+	CREATE_FILL_FLOAT_ARRAY( a, vectorValuesInterval.Begin, vectorValuesInterval.End, vectorSize, random )
+
+	std::vector<float> result;
+	result.resize( vectorSize );
+	for( auto mode : { CGELUActivationParam::TCalculationMode::CM_Precise,
+		CGELUActivationParam::TCalculationMode::CM_SigmoidApproximate,
+		CGELUActivationParam::TCalculationMode::CM_TanhApproximate } )
+	{
+		MathEngine().VectorGELU( CARRAY_FLOAT_WRAPPER( a ), CARRAY_FLOAT_WRAPPER( result ), vectorSize, mode );
+
+		for( int i = 0; i < vectorSize; i++ ) {
+			const double expected = geluNaive( a[i], mode );
+			ASSERT_NEAR( expected, result[i], 1e-6 * std::max( 1., std::fabs( expected ) ) ) << a[i];
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------
+
+class CMathEngineVectorGELUTest : public CTestFixtureWithParams {
+};
+
+INSTANTIATE_TEST_CASE_P( CMathEngineVectorGELUTestInstantiation, CMathEngineVectorGELUTest,
+	::testing::Values(
+		CTestParams(
+			"VectorSize = (1..10000);"
+			"VectorValues = (-50..50);"
+			"TestCount = 100;"
+		),
+		CTestParams(
+			"VectorSize = (1..1000);"
+			"VectorValues = (-5..5);"
+			"TestCount = 100;"
+		),
+		CTestParams(
+			"VectorSize = (1179648..1179648);"
+			"VectorValues = (-1..1);"
+			"TestCount = 10;"
+		)
+	)
+);
+
+TEST_P( CMathEngineVectorGELUTest, Random )
+{
+	const auto met = MathEngine().GetType();
+	if( met != MET_Cpu && met != MET_Cuda ) {
+		NEOML_HILIGHT( GTEST_LOG_( INFO ) ) << "Skipped rest of test for MathEngine type=" << met << " because no implementation.\n";
+		return;
+	}
+
+	RUN_TEST_IMPL( vectorGELUTestImpl );
+}
@@ -0,0 +1,70 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#include <TestFixture.h>
+#include <cmath>
+
+using namespace NeoML;
+using namespace NeoMLTest;
+
+static void vectorSiLUTestImpl( const CTestParams& params, int seed )
+{
+	CRandom random( seed );
+	const CInterval vectorSizeInterval = params.GetInterval( "VectorSize" );
+	const CInterval vectorValuesInterval = params.GetInterval( "VectorValues" );
+	const int vectorSize = random.UniformInt( vectorSizeInterval.Begin, vectorSizeInterval.End );
+
+	CREATE_FILL_FLOAT_ARRAY( a, vectorValuesInterval.Begin, vectorValuesInterval.End, vectorSize, random )
+
+	std::vector<float> result;
+	result.resize( vectorSize );
+	MathEngine().VectorSiLU( CARRAY_FLOAT_WRAPPER( a ), CARRAY_FLOAT_WRAPPER( result ), vectorSize );
+
+	for( int i = 0; i < vectorSize; i++ ) {
+		const double expected = a[i] / ( 1 + std::exp( -static_cast<double>( a[i] ) ) );
+		ASSERT_NEAR( expected, result[i], 1e-6 * std::max( 1., std::fabs( expected ) ) ) << a[i];
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------
+
+class CMathEngineVectorSiLUTest : public CTestFixtureWithParams {
+};
+
+INSTANTIATE_TEST_CASE_P( CMathEngineVectorSiLUTestInstantiation, CMathEngineVectorSiLUTest,
+	::testing::Values(
+		CTestParams(
+			"VectorSize = (1..10000);"
+			"VectorValues = (-50..50);"
+			"TestCount = 100;"
+		),
+		CTestParams(
+			"VectorSize = (1..1000);"
+			"VectorValues = (-5..5);"
+			"TestCount = 100;"
+		)
+	)
+);
+
+TEST_P( CMathEngineVectorSiLUTest, Random )
+{
+	const auto met = MathEngine().GetType();
+	if( met != MET_Cpu && met != MET_Cuda ) {
+		NEOML_HILIGHT( GTEST_LOG_( INFO ) ) << "Skipped rest of test for MathEngine type=" << met << " because no implementation.\n";
+		return;
+	}
+
+	RUN_TEST_IMPL( vectorSiLUTestImpl );
+}
@@ -0,0 +1,123 @@
+/* Copyright © 2024 ABBYY
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+	http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+--------------------------------------------------------------------------------------------------------------*/
+
+#include <TestFixture.h>
+
+using namespace NeoML;
+using namespace NeoMLTest;
+
+// Calculates the input diff by the definition of the normalization
+static void naiveLayerNormBackward( const float* input, const float* outputDiff, int height, int width,
+	float epsilon, const float* scale, float* inputDiff )
+{
+	std::vector<double> norm( width );
+	std::vector<double> diff( width );
+	for( int row = 0; row < height; ++row ) {
+		double mean = 0;
+		for( int i = 0; i < width; ++i ) {
+			mean += input[i];
+		}
+		mean /= width;
+		double var = 0;
+		for( int i = 0; i < width; ++i ) {
+			var += ( input[i] - mean ) * ( input[i] - mean );
+		}
+		var /= width;
+		const double invStdDev = 1. / sqrt( var + epsilon );
+
+		double diffMean = 0;
+		double normDiffMean = 0;
+		for( int i = 0; i < width; ++i ) {
+			norm[i] = ( input[i] - mean ) * invStdDev;
+			diff[i] = outputDiff[i] * scale[i];
+			diffMean += diff[i];
+			normDiffMean += diff[i] * norm[i];
+		}
+		diffMean /= width;
+		normDiffMean /= width;
+		for( int i = 0; i < width; ++i ) {
+			*inputDiff++ = static_cast<float>( ( diff[i] - diffMean - norm[i] * normDiffMean ) * invStdDev );
+		}
+		input += width;
+		outputDiff += width;
+	}
+}
+
+static void layerNormBackwardTestImpl( const CTestParams& params, int seed )
+{
+	CRandom random( seed );
+
+	const CInterval heightInterval = params.GetInterval( "Height" );
+	const CInterval widthInterval = params.GetInterval( "Width" );
+	const CInterval valuesInterval = params.GetInterval( "Values" );
+
+	const int height = random.UniformInt( heightInterval.Begin, heightInterval.End );
+	const int width = random.UniformInt( widthInterval.Begin, widthInterval.End );
+	const float epsilon = 1e-5f;
+
+	CREATE_FILL_FLOAT_ARRAY( input, valuesInterval.Begin, valuesInterval.End, height * width, random );
+	CREATE_FILL_FLOAT_ARRAY( outputDiff, -1.f, 1.f, height * width, random );
+	CREATE_FILL_FLOAT_ARRAY( scale, -2.f, 2.f, width, random );
+	CREATE_FILL_FLOAT_ARRAY( bias, -2.f, 2.f, width, random );
+
+	std::vector<float> expected( height * width );
+	naiveLayerNormBackward( input.data(), outputDiff.data(), height, width, epsilon, scale.data(), expected.data() );
+
+	CFloatBlob resultBlob( MathEngine(), 1, height, 1, 1, 1, 1, width );
+	CFloatBlob normalizedBlob( MathEngine(), 1, height, 1, 1, 1, 1, width );
+	CFloatBlob invStdDevBlob( MathEngine(), 1, height, 1, 1, 1, 1, 1 );
+	const CFloatHandle normalizedHandle = normalizedBlob.GetData();
+	const CFloatHandle invStdDevHandle = invStdDevBlob.GetData();
+	MathEngine().LayerNorm( CARRAY_FLOAT_WRAPPER( input ), nullptr, height, width, epsilon,
+		CARRAY_FLOAT_WRAPPER( scale ), CARRAY_FLOAT_WRAPPER( bias ), resultBlob.GetData(),
+		&normalizedHandle, &invStdDevHandle );
+
+	// The input diff overwrites the output diff
+	CFloatBlob diffBlob( MathEngine(), 1, height, 1, 1, 1, 1, width );
+	diffBlob.CopyFrom( outputDiff.data() );
+	MathEngine().LayerNormBackward( normalizedBlob.GetData(), invStdDevBlob.GetData(), diffBlob.GetData(),
+		height, width, CARRAY_FLOAT_WRAPPER( scale ), diffBlob.GetData() );
+
+	std::vector<float> result( height * width );
+	diffBlob.CopyTo( result.data() );
+	for( int i = 0; i < height * width; ++i ) {
+		ASSERT_NEAR( expected[i], result[i], 1e-3f ) << " at " << i;
+	}
+}
+
+class CMathEngineLayerNormBackwardTest : public CTestFixtureWithParams {
+};
+
+INSTANTIATE_TEST_CASE_P( CMathEngineLayerNormBackwardTestInstantiation, CMathEngineLayerNormBackwardTest,
+	::testing::Values(
+		CTestParams(
+			"Height = (1..20);"
+			"Width = (2..300);"
+			"Values = (-10..10);"
+			"TestCount = 200;"
+		)
+	)
+);
+
+TEST_P( CMathEngineLayerNormBackwardTest, Random )
+{
+	const auto met = MathEngine().GetType();
+	if( met != MET_Cpu ) {
+		NEOML_HILIGHT( GTEST_LOG_( INFO ) ) << "Skipped rest of test for MathEngine type=" << met << " because no implementation.\n";
+		return;
+	}
+
+	RUN_TEST_IMPL( layerNormBackwardTestImpl );
+}